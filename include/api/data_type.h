@@ -40,6 +40,7 @@ enum class DataType : int {
   kNumberTypeFloat64 = 44,
   kNumberTypeEnd = 46,
   // add new enum here
+  kNumberTypeBFloat16 = 58,
   kInvalidType = INT32_MAX,
 };
 }  // namespace mindspore
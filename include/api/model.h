@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_INCLUDE_API_MODEL_H
 #define MINDSPORE_INCLUDE_API_MODEL_H
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
@@ -40,6 +41,9 @@ class Expr;
 namespace dataset {
 class Dataset;
 }  // namespace dataset
+
+/// \brief PipelineCallBack defined the function pointer for feeding or fetching the index-th micro-batch.
+using MSPipelineCallBack = std::function<Status(size_t /* index */)>;
 /// \brief The Model class is used to define a MindSpore model, facilitating computational graph management.
 class MS_API Model {
  public:
@@ -170,6 +174,20 @@ class MS_API Model {
   /// \return Status.
   Status Predict(const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
+  /// \brief Inference model with a stream of micro-batches. With the config section [pipeline] stage_num set, the
+  /// model is cut into stages and a micro-batch enters the model before the former one leaves it.
+  ///
+  /// \param[in] micro_batch_num The number of micro-batches.
+  /// \param[in] feed CallBack to write the index-th micro-batch into the tensors got by GetInputs().
+  /// \param[in] fetch CallBack to read the outputs of the index-th micro-batch from the tensors got by GetOutputs(),
+  /// which is called in the order of micro-batches.
+  /// \param[in] before CallBack before predict.
+  /// \param[in] after CallBack after predict.
+  ///
+  /// \return Status.
+  Status PredictPipeline(size_t micro_batch_num, const MSPipelineCallBack &feed, const MSPipelineCallBack &fetch,
+                         const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
+
   /// \brief Train model by step.
   ///
   /// \param[in] before CallBack before predict.
@@ -104,7 +104,7 @@ bool MetaServerNode::Finalize(bool force) {
 
 bool MetaServerNode::InitTCPServer() {
   bool enable_ssl = ps::PSContext::instance()->enable_ssl();
-  tcp_server_ = std::make_unique<rpc::TCPServer>(enable_ssl);
+  tcp_server_ = std::make_unique<rpc::TCPServer>(enable_ssl, ps::PSContext::instance()->rpc_event_loop_num());
   MS_EXCEPTION_IF_NULL(tcp_server_);
   RETURN_IF_FALSE_WITH_LOG(tcp_server_->Initialize(meta_server_addr_.GetUrl()), "Failed to init the tcp server.");
   tcp_server_->SetMessageHandler(std::bind(&MetaServerNode::HandleMessage, this, std::placeholders::_1));
@@ -38,6 +38,11 @@ constexpr char kEnvRoleOfScheduler[] = "MS_SCHED";
 const std::set<std::string> kValidRoleName = {kEnvRoleOfServer, kEnvRoleOfPServer, kEnvRoleOfWorker,
                                               kEnvRoleOfScheduler};
 
+// The gradient compression of the cpu collective AllReduce: none, fp16, bf16, topk or onebit, and the ratio of the
+// elements kept by topk.
+constexpr char kEnvGradientCompression[] = "MS_GRADIENT_COMPRESSION";
+constexpr char kEnvGradientCompressionRatio[] = "MS_GRADIENT_COMPRESSION_RATIO";
+
 // Used in parameter server embedding cache scenarios to identify the same Parameter between Worker and Server.
 constexpr char kParameterKey[] = "parameter_key";
 // Embedding cache lookup operation.
@@ -30,24 +30,56 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
     return hash_index;
   }
 
+  bool pinned = pinned_ids_.count(id) > 0;
+  if (pinned) {
+    pinned_count_++;
+  }
   if (!need_swap) {
     hash_count_++;
     (void)hash_id_to_index_.emplace(id, hash_index);
     hash_map_elements_[hash_index].set_id(id);
     hash_map_elements_[hash_index].set_step(data_step);
+    hash_map_elements_[hash_index].pinned_ = pinned;
     return hash_index;
   }
 
   swap_out_index[*swap_out_size] = hash_index;
   swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
   (*swap_out_size)++;
+  // The pinned elements are not expired, but keep the count right if one of them is evicted anyway.
+  if (hash_map_elements_[hash_index].pinned_ && pinned_count_ > 0) {
+    pinned_count_--;
+  }
   (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
   (void)hash_id_to_index_.emplace(id, hash_index);
   hash_map_elements_[hash_index].set_id(id);
   hash_map_elements_[hash_index].set_step(data_step);
+  hash_map_elements_[hash_index].pinned_ = pinned;
   return hash_index;
 }
 
+void EmbeddingHashMap::PinIds(const mindspore::HashSet<int> &hot_ids) {
+  if (hot_ids.size() > hash_capacity_ / 2) {
+    MS_LOG(EXCEPTION) << "The hot id number " << hot_ids.size() << " exceeds half of the hash map capacity "
+                      << hash_capacity_;
+  }
+  for (const auto &id : pinned_ids_) {
+    auto iter = hash_id_to_index_.find(id);
+    if (iter != hash_id_to_index_.end()) {
+      hash_map_elements_[IntToSize(iter->second)].pinned_ = false;
+    }
+  }
+  pinned_ids_ = hot_ids;
+  pinned_count_ = 0;
+  for (const auto &id : pinned_ids_) {
+    auto iter = hash_id_to_index_.find(id);
+    if (iter != hash_id_to_index_.end()) {
+      hash_map_elements_[IntToSize(iter->second)].pinned_ = true;
+      pinned_count_++;
+    }
+  }
+}
+
 int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_step, bool *const need_swap,
                                        bool *const need_wait_graph) {
   MS_EXCEPTION_IF_NULL(need_swap);
@@ -22,6 +22,7 @@
 #include <memory>
 #include <vector>
 #include "utils/hash_map.h"
+#include "utils/hash_set.h"
 #include "utils/convert_utils_base.h"
 
 namespace mindspore {
@@ -35,10 +36,12 @@ struct HashMapElement {
   int id_{INVALID_INDEX_VALUE};
   // The current global step of cache prefetching operation.
   size_t step_{INVALID_STEP_VALUE};
+  // The element of a hot id is pinned and never swapped out.
+  bool pinned_{false};
 
   bool IsEmpty() const { return step_ == INVALID_STEP_VALUE; }
-  bool IsExpired(size_t graph_running_step) const { return graph_running_step > step_; }
-  bool StepEqual(size_t step) const { return step_ == step; }
+  bool IsExpired(size_t graph_running_step) const { return !pinned_ && graph_running_step > step_; }
+  bool StepEqual(size_t step) const { return !pinned_ && step_ == step; }
   void set_id(int id) { id_ = id; }
   void set_step(size_t step) { step_ = step; }
 };
@@ -87,6 +90,17 @@ class EmbeddingHashMap {
   // Reset the hash map.
   void Reset();
 
+  // Pin the elements of the hot ids so that they stay resident in the cache, and unpin the elements of the previous
+  // hot ids which are not hot any more. The hot ids which are not in the hash map are pinned once they are inserted.
+  // At most half of the capacity can be pinned, so that the other ids can still be swapped in.
+  void PinIds(const mindspore::HashSet<int> &hot_ids);
+
+  // Get the number of the pinned elements.
+  size_t pinned_count() const { return pinned_count_; }
+
+  // Get the hot ids whose elements are pinned.
+  const mindspore::HashSet<int> &pinned_ids() const { return pinned_ids_; }
+
   void DumpHashMap();
 
  private:
@@ -123,6 +137,11 @@ class EmbeddingHashMap {
 
   // The flag indicates hash map is full.
   bool expired_element_full_;
+
+  // The hot ids whose elements are pinned.
+  mindspore::HashSet<int> pinned_ids_;
+  // The number of the pinned elements.
+  size_t pinned_count_{0};
 };
 }  // namespace distributed
 }  // namespace mindspore
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/embedding_cache/hot_id_tracker.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+// An id accessed only once in a rebalance interval is never hot.
+constexpr size_t kMinHotAccessCount = 2;
+}  // namespace
+
+HotIdTracker::HotIdTracker(size_t max_hot_num, size_t rebalance_interval)
+    : max_hot_num_(max_hot_num), rebalance_interval_(rebalance_interval) {
+  if (max_hot_num == 0 || rebalance_interval == 0) {
+    MS_LOG(EXCEPTION) << "The max hot id number and the rebalance interval should be positive, but got " << max_hot_num
+                      << " and " << rebalance_interval;
+  }
+}
+
+bool HotIdTracker::Record(const int *ids, size_t ids_num) {
+  MS_EXCEPTION_IF_NULL(ids);
+  for (size_t i = 0; i < ids_num; ++i) {
+    ++access_counts_[ids[i]];
+    if (IsHot(ids[i])) {
+      ++interval_hot_access_num_;
+    }
+  }
+  interval_access_num_ += ids_num;
+
+  if (++batch_num_ % rebalance_interval_ != 0) {
+    return false;
+  }
+  Rebalance();
+  return true;
+}
+
+void HotIdTracker::Rebalance() {
+  hot_access_ratio_ =
+    interval_access_num_ == 0 ? 0 : static_cast<double>(interval_hot_access_num_) / interval_access_num_;
+  interval_access_num_ = 0;
+  interval_hot_access_num_ = 0;
+
+  std::vector<std::pair<size_t, int>> candidates;
+  for (const auto &item : access_counts_) {
+    if (item.second >= kMinHotAccessCount) {
+      (void)candidates.emplace_back(item.second, item.first);
+    }
+  }
+  if (candidates.size() > max_hot_num_) {
+    std::nth_element(candidates.begin(), candidates.begin() + max_hot_num_, candidates.end(),
+                     [](const auto &a, const auto &b) { return a.first > b.first; });
+    candidates.resize(max_hot_num_);
+  }
+  hot_ids_.clear();
+  for (const auto &candidate : candidates) {
+    (void)hot_ids_.insert(candidate.second);
+  }
+
+  for (auto iter = access_counts_.begin(); iter != access_counts_.end();) {
+    iter->second >>= 1;
+    if (iter->second == 0) {
+      iter = access_counts_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+}  // namespace distributed
+}  // namespace mindspore
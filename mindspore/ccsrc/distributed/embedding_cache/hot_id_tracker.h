@@ -0,0 +1,64 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_HOT_ID_TRACKER_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_HOT_ID_TRACKER_H_
+
+#include "utils/hash_map.h"
+#include "utils/hash_set.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace distributed {
+// HotIdTracker counts the accesses of feature ids and reselects the most frequently accessed ids as the hot ids every
+// 'rebalance_interval' batches. With the power-law id distribution of recommendation models, a few hot ids take most of
+// the accesses, keeping them resident in the local cache takes their traffic off the servers owning them. The counts
+// are halved at every reselection so the hot ids follow the drift of the distribution, and the ids whose counts fall
+// to zero are dropped to bound the memory.
+class BACKEND_EXPORT HotIdTracker {
+ public:
+  HotIdTracker(size_t max_hot_num, size_t rebalance_interval);
+  ~HotIdTracker() = default;
+
+  // Count the accesses of a batch of ids, returns true if the hot ids are reselected after this batch.
+  bool Record(const int *ids, size_t ids_num);
+
+  bool IsHot(int id) const { return hot_ids_.count(id) > 0; }
+  const mindspore::HashSet<int> &hot_ids() const { return hot_ids_; }
+
+  // The ratio of the accesses of the hot ids to all the accesses in the last rebalance interval.
+  double hot_access_ratio() const { return hot_access_ratio_; }
+  // The number of the ids whose accesses are being counted.
+  size_t tracked_id_num() const { return access_counts_.size(); }
+
+ private:
+  // Select the ids with the largest counts as the hot ids and decay the counts.
+  void Rebalance();
+
+  size_t max_hot_num_;
+  size_t rebalance_interval_;
+  size_t batch_num_{0};
+
+  mindspore::HashMap<int, size_t> access_counts_;
+  mindspore::HashSet<int> hot_ids_;
+
+  size_t interval_access_num_{0};
+  size_t interval_hot_access_num_{0};
+  double hot_access_ratio_{0};
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_HOT_ID_TRACKER_H_
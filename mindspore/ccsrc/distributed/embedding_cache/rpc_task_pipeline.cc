@@ -0,0 +1,115 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/embedding_cache/rpc_task_pipeline.h"
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+void RpcTaskPipeline::Start(size_t depth) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  if (running_) {
+    return;
+  }
+  depth_ = depth;
+  if (depth_ == 0) {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread(&RpcTaskPipeline::ThreadFunc, this);
+}
+
+void RpcTaskPipeline::Stop() {
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    running_ = false;
+  }
+  cond_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool RpcTaskPipeline::SubmitTask(const std::function<bool()> &task, size_t *task_id) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  if (!running_) {
+    // Run the task in place when the pipeline is disabled.
+    locker.unlock();
+    bool ret = task();
+    locker.lock();
+    ++submitted_num_;
+    ++finished_num_;
+    failed_ = failed_ || !ret;
+  } else {
+    cond_.wait(locker, [this] { return (submitted_num_ - finished_num_ < depth_) || failed_ || !running_; });
+    if (failed_ || !running_) {
+      return false;
+    }
+    tasks_.push_back(task);
+    ++submitted_num_;
+    cond_.notify_all();
+  }
+  if (task_id != nullptr) {
+    *task_id = submitted_num_;
+  }
+  return !failed_;
+}
+
+bool RpcTaskPipeline::WaitTask(size_t task_id) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  cond_.wait(locker, [this, task_id] { return finished_num_ >= task_id || failed_; });
+  return !failed_;
+}
+
+bool RpcTaskPipeline::WaitAllTasks() {
+  size_t task_id = 0;
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    task_id = submitted_num_;
+  }
+  return WaitTask(task_id);
+}
+
+void RpcTaskPipeline::ThreadFunc() {
+  MS_LOG(INFO) << "Begin running rpc tasks with remote.";
+  while (true) {
+    std::function<bool()> task;
+    bool failed = false;
+    {
+      std::unique_lock<std::mutex> locker(mutex_);
+      cond_.wait(locker, [this] { return !tasks_.empty() || !running_; });
+      if (tasks_.empty()) {
+        break;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+      failed = failed_;
+    }
+
+    // The tasks behind a failed one are dropped, the remote would miss the embeddings pushed before them.
+    bool ret = !failed && task();
+    {
+      std::lock_guard<std::mutex> locker(mutex_);
+      failed_ = failed_ || !ret;
+      ++finished_num_;
+    }
+    cond_.notify_all();
+  }
+  MS_LOG(INFO) << "End running rpc tasks with remote.";
+}
+}  // namespace distributed
+}  // namespace mindspore
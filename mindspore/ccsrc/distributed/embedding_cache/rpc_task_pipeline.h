@@ -0,0 +1,67 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_RPC_TASK_PIPELINE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_RPC_TASK_PIPELINE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace distributed {
+// RpcTaskPipeline runs the rpc tasks with remote(push and pull embeddings) in order on its own thread, so that they
+// overlap the cache hit analysis of the next batch and the swaps between local host and device cache. At most 'depth'
+// tasks are in flight, and with a depth of 0 the tasks run in place. Once a task fails, the tasks behind it are dropped
+// and all the waiters get the failure.
+class BACKEND_EXPORT RpcTaskPipeline {
+ public:
+  RpcTaskPipeline() = default;
+  ~RpcTaskPipeline() { Stop(); }
+
+  void Start(size_t depth);
+  // Stop the rpc thread after the tasks submitted are finished.
+  void Stop();
+
+  // Add a rpc task, blocks while the pipeline is full. The 'task_id' is used to wait for the task.
+  bool SubmitTask(const std::function<bool()> &task, size_t *task_id = nullptr);
+  // Wait until the rpc task 'task_id' and all tasks before it finish, returns false if any of them failed.
+  bool WaitTask(size_t task_id);
+  bool WaitAllTasks();
+
+  size_t depth() const { return depth_; }
+
+ private:
+  void ThreadFunc();
+
+  // The max number of rpc tasks in flight.
+  size_t depth_{0};
+  std::thread thread_;
+  std::deque<std::function<bool()>> tasks_;
+  // The number of submitted and finished rpc tasks, a task id is the submitted number after it is added.
+  size_t submitted_num_{0};
+  size_t finished_num_{0};
+  bool failed_{false};
+  bool running_{false};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+};
+}  // namespace distributed
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DISTRIBUTED_EMBEDDING_CACHE_RPC_TASK_PIPELINE_H_
@@ -17,6 +17,7 @@
 #ifndef MIINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_DATA_H_
 #define MIINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_DATA_H_
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -26,6 +27,7 @@
 
 #include "distributed/persistent/storage/local_file.h"
 #include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
 
 namespace mindspore {
 namespace distributed {
@@ -60,6 +62,20 @@ class Data {
   std::shared_ptr<std::vector<int>> shape_;
 };
 
+// The snapshot of the dirty rows of persistent data. The rows are copied when the snapshot is taken, so the data can be
+// modified while the snapshot is being written to storage.
+template <typename T>
+struct DataSnapshot {
+  // The shape of the data in the snapshot, whose first dimension is the number of the dirty rows.
+  std::vector<int> shape;
+  // The row numbers of the dirty rows in ascending order.
+  storage::DirtyInfo rows;
+  // The copy of the dirty rows.
+  std::vector<T> data;
+};
+template <typename T>
+using DataSnapshotPtr = std::shared_ptr<DataSnapshot<T>>;
+
 // Implementation of the class Data to complete the function of persistence and disaster tolerance.
 template <typename T>
 class PersistentData : public Data<T> {
@@ -79,6 +95,12 @@ class PersistentData : public Data<T> {
   // In disaster recovery mode, memory of tensor need to be saved into disk file periodically.
   void Persist(const storage::DirtyInfo &dirty_info) const;
 
+  // The following two methods are used to persist the dirty rows incrementally without blocking the modification of
+  // data for long: the snapshot only copies the dirty rows and should be taken with the lock of data held, and then it
+  // can be persisted in other thread without the lock. The entire data should have been persisted before.
+  DataSnapshotPtr<T> TakeSnapshot(const storage::DirtyInfo &dirty_info) const;
+  void PersistSnapshot(const DataSnapshotPtr<T> &snapshot) const;
+
   // In disaster recovery mode, server node or worker node need to restore persistent data when restart.
   void Restore() const;
 
@@ -103,6 +125,41 @@ void PersistentData<T>::Persist(const storage::DirtyInfo &dirty_info) const {
   storage_->Write(input, dirty_info);
 }
 
+template <typename T>
+DataSnapshotPtr<T> PersistentData<T>::TakeSnapshot(const storage::DirtyInfo &dirty_info) const {
+  MS_EXCEPTION_IF_NULL(Data<T>::shape_);
+  const std::vector<int> &shape = *Data<T>::shape_;
+  if (shape.empty() || shape[0] <= 0) {
+    MS_LOG(EXCEPTION) << "The first dimension of the persistent data should be positive.";
+  }
+  size_t row_size = Data<T>::size() / IntToSize(shape[0]);
+
+  auto snapshot = std::make_shared<DataSnapshot<T>>();
+  snapshot->rows = dirty_info;
+  std::sort(snapshot->rows.begin(), snapshot->rows.end());
+  snapshot->rows.erase(std::unique(snapshot->rows.begin(), snapshot->rows.end()), snapshot->rows.end());
+  if (!snapshot->rows.empty() && (snapshot->rows.front() < 0 || snapshot->rows.back() >= shape[0])) {
+    MS_LOG(EXCEPTION) << "The dirty row is out of range [0, " << shape[0] << ")";
+  }
+
+  snapshot->shape = shape;
+  snapshot->shape[0] = SizeToInt(snapshot->rows.size());
+  snapshot->data.resize(snapshot->rows.size() * row_size);
+  T *dst = snapshot->data.data();
+  for (const auto &row : snapshot->rows) {
+    dst = std::copy_n(Data<T>::data() + IntToSize(row) * row_size, row_size, dst);
+  }
+  return snapshot;
+}
+
+template <typename T>
+void PersistentData<T>::PersistSnapshot(const DataSnapshotPtr<T> &snapshot) const {
+  MS_EXCEPTION_IF_NULL(snapshot);
+  MS_EXCEPTION_IF_NULL(storage_);
+  storage::InputData input = std::make_tuple(snapshot->shape, snapshot->data.data(), snapshot->data.size() * sizeof(T));
+  storage_->WriteIncremental(input, snapshot->rows);
+}
+
 template <typename T>
 void PersistentData<T>::Restore() const {
   storage::OutputData output = std::make_pair(Data<T>::data(), Data<T>::size() * sizeof(T));
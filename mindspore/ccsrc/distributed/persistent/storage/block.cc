@@ -31,12 +31,26 @@ void Block::GenSha256Seq() const {
 bool Block::CheckSha256Seq() const {
   MS_EXCEPTION_IF_NULL(block_meta_);
   std::string sha256_gen = block_meta_->Get<std::string>(kHashSeq);
-  if (sha256_gen != system::sha256::GetHashFromFile(block_file_name_)) {
+  std::string sha256_cal = system::sha256::GetHashFromFile(block_file_name_);
+  if (sha256_gen != sha256_cal &&
+      (!block_meta_->Exists(kPendingHashSeq) || block_meta_->Get<std::string>(kPendingHashSeq) != sha256_cal)) {
     MS_LOG(ERROR) << "The block file has been modified, file name: " << block_file_name_;
     return false;
   }
   return true;
 }
+
+void Block::GenPendingSha256Seq(const std::string &file_name) const {
+  std::string sha256_cal = system::sha256::GetHashFromFile(file_name);
+  MS_EXCEPTION_IF_NULL(block_meta_);
+  block_meta_->Insert(kPendingHashSeq, sha256_cal, true);
+}
+
+void Block::CommitPendingSha256Seq() const {
+  MS_EXCEPTION_IF_NULL(block_meta_);
+  block_meta_->Insert(kHashSeq, block_meta_->Get<std::string>(kPendingHashSeq), true);
+  block_meta_->Erase(kPendingHashSeq, true);
+}
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
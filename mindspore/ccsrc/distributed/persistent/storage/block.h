@@ -42,9 +42,18 @@ class Block {
   // Generate sha256 hash sequence.
   void GenSha256Seq() const;
 
-  // Check sha256 hash sequence.
+  // Check sha256 hash sequence, the block file matching the pending hash sequence is also accepted.
   bool CheckSha256Seq() const;
 
+  // The following two methods are used to replace the block file by 'file_name'.
+  // Generate the sha256 hash sequence of 'file_name' as the pending one and flush the block meta to disk, so that
+  // either the current or the new block file is accepted while the new one is being renamed to the block file.
+  void GenPendingSha256Seq(const std::string &file_name) const;
+
+  // Replace the hash sequence by the pending one and flush the block meta to disk, after the new block file has
+  // replaced the current one.
+  void CommitPendingSha256Seq() const;
+
   // Set the block meta pointer associated with the block file.
   void set_block_meta(const std::shared_ptr<BlockMeta> &block_meta) { block_meta_ = block_meta; }
 
@@ -27,15 +27,26 @@ constexpr char kShardShape[] = "shard_shape";
 constexpr char kShardRangeLowerBound[] = "shard_range_lower_bound";
 constexpr char kShardRangeUpperBound[] = "shard_range_upper_bound";
 constexpr char kHashSeq[] = "hash_seq";
+// The hash sequence of the block file which is replacing the current one.
+constexpr char kPendingHashSeq[] = "pending_hash_seq";
+
+// Delta file and delta meta related.
+constexpr char kRowNum[] = "row_num";
+constexpr char kRowLength[] = "row_length";
+constexpr char kTensorNum[] = "tensor_num";
 
 constexpr char kBlockFilePrefix[] = "block_";
 constexpr char kBlockMetaFilePrefix[] = "block_meta_";
+constexpr char kDeltaFilePrefix[] = "delta_";
+constexpr char kDeltaMetaFilePrefix[] = "delta_meta_";
+constexpr char kTmpFilePrefix[] = "tmp_";
 constexpr char kJsonSuffix[] = ".json";
 constexpr size_t JSON_SUFFIX_LENS = 5;
 
 // Storage config related.
 constexpr char kFileStoragePath[] = "file_storage_path";
 constexpr char kMaxBlockLength[] = "max_block_length";
+constexpr char kMaxDeltaNum[] = "max_delta_num";
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
@@ -17,6 +17,7 @@
 #include "distributed/persistent/storage/file_io_utils.h"
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <fstream>
 
@@ -118,6 +119,24 @@ bool FileIOUtils::Read(const std::string &file_name, const std::vector<std::pair
   return true;
 }
 
+bool FileIOUtils::Sync(const std::string &path) {
+#if defined(_WIN32) || defined(_WIN64)
+  return true;
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file failed, file name: " << path << ", errno: " << errno;
+    return false;
+  }
+  int ret = fsync(fd);
+  if (ret != 0) {
+    MS_LOG(ERROR) << "Fsync file failed, file name: " << path << ", errno: " << errno;
+  }
+  (void)close(fd);
+  return ret == 0;
+#endif
+}
+
 bool FileIOUtils::IsFileOrDirExist(const std::string &path) {
   if (path.empty()) {
     MS_LOG(EXCEPTION) << "The path name is empty";
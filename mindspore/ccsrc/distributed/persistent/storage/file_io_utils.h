@@ -34,6 +34,9 @@ class FileIOUtils {
   // Read file and load the context into memory buffer, return false if the file is not exist.
   static bool Read(const std::string &file_name, const std::vector<std::pair<void *, size_t>> &outputs);
 
+  // Flush the content of the file or the entries of the directory to disk.
+  static bool Sync(const std::string &path);
+
   // Judeg whether a file exists.
   static bool IsFileOrDirExist(const std::string &file);
 
@@ -15,7 +15,9 @@
  */
 
 #include "distributed/persistent/storage/json_utils.h"
+#include <cstdio>
 #include "distributed/persistent/storage/file_io_utils.h"
+#include "distributed/persistent/storage/constants.h"
 #include "include/common/utils/utils.h"
 
 namespace mindspore {
@@ -40,6 +42,32 @@ bool JsonUtils::Initialize() {
   return true;
 }
 
+void JsonUtils::Erase(const std::string &key, bool sync) {
+  if (js_.erase(key) != 0) {
+    Dump(sync);
+  }
+}
+
+void JsonUtils::Dump(bool sync) const {
+  // The temporary file is in the same directory, and its prefix keeps it out of the file lists of the directory.
+  size_t pos = file_name_.find_last_of('/');
+  std::string dir_name = pos == std::string::npos ? "." : file_name_.substr(0, pos);
+  std::string tmp_file_name = dir_name + "/" + kTmpFilePrefix + file_name_.substr(pos + 1);
+  std::string content = js_.dump();
+  if (!FileIOUtils::Write(tmp_file_name, {std::make_pair(content.data(), content.size())})) {
+    MS_LOG(EXCEPTION) << "Write json file[" << tmp_file_name << "] failed.";
+  }
+  if (sync && !FileIOUtils::Sync(tmp_file_name)) {
+    MS_LOG(EXCEPTION) << "Sync json file[" << tmp_file_name << "] failed.";
+  }
+  if (rename(tmp_file_name.c_str(), file_name_.c_str()) != 0) {
+    MS_LOG(EXCEPTION) << "Rename file[" << tmp_file_name << "] to [" << file_name_ << "] failed, errno: " << errno;
+  }
+  if (sync && !FileIOUtils::Sync(dir_name)) {
+    MS_LOG(EXCEPTION) << "Sync directory[" << dir_name << "] failed.";
+  }
+}
+
 bool JsonUtils::Exists(const std::string &key) const {
   if (!js_.contains(key)) {
     return false;
@@ -40,14 +40,22 @@ class JsonUtils {
   template <typename T>
   T Get(const std::string &key) const;
 
-  // Insert a key-value pair into json or change the value corresponding to the key in json.
+  // Insert a key-value pair into json or change the value corresponding to the key in json. The json file is replaced
+  // by renaming a temporary file, so it is never partially written. If 'sync' is true, the file and the rename are also
+  // flushed to disk before returning.
   template <typename T>
-  void Insert(const std::string &key, const T &value);
+  void Insert(const std::string &key, const T &value, bool sync = false);
+
+  // Remove the key from json if it exists.
+  void Erase(const std::string &key, bool sync = false);
 
   // Check whether key exists in json or not.
   bool Exists(const std::string &key) const;
 
  private:
+  // Write the json object to the json file.
+  void Dump(bool sync) const;
+
   // Json object.
   nlohmann::json js_;
 
@@ -65,11 +73,9 @@ T JsonUtils::Get(const std::string &key) const {
 }
 
 template <typename T>
-void JsonUtils::Insert(const std::string &key, const T &value) {
-  std::ofstream output_file(file_name_);
+void JsonUtils::Insert(const std::string &key, const T &value, bool sync) {
   js_[key] = value;
-  output_file << js_.dump();
-  output_file.close();
+  Dump(sync);
 }
 }  // namespace storage
 }  // namespace distributed
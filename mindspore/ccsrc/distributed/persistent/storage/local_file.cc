@@ -17,6 +17,7 @@
 #include "distributed/persistent/storage/local_file.h"
 
 #include <dirent.h>
+#include <cctype>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
@@ -42,14 +43,40 @@ void LocalFile::Write(const std::vector<InputData> &inputs, const DirtyInfo &dir
     MS_LOG(EXCEPTION) << "The inputs is empty";
   }
 
-  // The block file has been created, only the blocks related to the dirty information need to be rewritten.
+  // The block file has been created, only the rows related to the dirty information need to be written to delta file.
   if (finish_create_block_files_) {
-    std::vector<int> block_indices;
-    TransformDirtyInfoToBlockIndices(dirty_info, &block_indices);
+    DirtyInfo rows = dirty_info;
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if (rows.empty()) {
+      return;
+    }
 
-    for (const auto &block_index : block_indices) {
-      WriteOneBlockFile(IntToSize(block_index), inputs);
+    const std::vector<int> &shape = std::get<0>(inputs.front());
+    if (shape.empty() || shape[0] <= 0) {
+      MS_LOG(EXCEPTION) << "The dimension of input shape contain zero.";
+    }
+    if (rows.front() < 0 || rows.back() >= shape[0]) {
+      MS_LOG(EXCEPTION) << "The dirty row is out of range [0, " << shape[0] << ")";
+    }
+    size_t row_length = std::get<2>(inputs.front()) / IntToSize(shape[0]);
+
+    // Gather the dirty rows of every tensor into contiguous memory.
+    std::vector<char> rows_data(inputs.size() * rows.size() * row_length);
+    char *dst = rows_data.data();
+    for (const auto &input : inputs) {
+      const char *src = reinterpret_cast<const char *>(std::get<1>(input));
+      MS_EXCEPTION_IF_NULL(src);
+      for (const auto &row : rows) {
+        (void)std::copy_n(src + IntToSize(row) * row_length, row_length, dst);
+        dst += row_length;
+      }
+    }
+    std::vector<std::pair<const void *, size_t>> tensors_rows_data;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      (void)tensors_rows_data.emplace_back(rows_data.data() + i * rows.size() * row_length, rows.size() * row_length);
     }
+    WriteDeltaFile(rows, tensors_rows_data);
     return;
   }
 
@@ -57,42 +84,197 @@ void LocalFile::Write(const std::vector<InputData> &inputs, const DirtyInfo &dir
   WriteBlockFiles(inputs);
 }
 
-void LocalFile::TransformDirtyInfoToBlockIndices(const DirtyInfo &dirty_info, std::vector<int> *block_indices) const {
-  MS_EXCEPTION_IF_NULL(block_indices);
-  if (block_meta_list_.empty()) {
-    MS_LOG(EXCEPTION) << "The block meta list is empty";
+void LocalFile::WriteIncremental(const InputData &input, const DirtyInfo &rows) {
+  if (!finish_create_block_files_) {
+    MS_LOG(EXCEPTION) << "The block files have not been created, file path: " << file_path_;
   }
+  if (rows.empty()) {
+    return;
+  }
+  if (!std::is_sorted(rows.begin(), rows.end()) || rows.front() < 0) {
+    MS_LOG(EXCEPTION) << "The rows of incremental data should be non-negative and in ascending order.";
+  }
+  if (std::get<2>(input) % rows.size() != 0) {
+    MS_LOG(EXCEPTION) << "The size of incremental data " << std::get<2>(input)
+                      << " is not divisible by the row number " << rows.size();
+  }
+  WriteDeltaFile(rows, {std::make_pair(std::get<1>(input), std::get<2>(input))});
+}
 
-  size_t block_index = 0;
-  bool block_index_alread_insert_vec = false;
-  auto block_meta_ptr = block_meta_list_.at(block_index);
-  MS_EXCEPTION_IF_NULL(block_meta_ptr);
-  int cur_lower_bound = block_meta_ptr->Get<int>(kShardRangeLowerBound);
-  int cur_upper_bound = block_meta_ptr->Get<int>(kShardRangeUpperBound);
-
-  for (const auto &dirty_value : dirty_info) {
-    if (dirty_value >= cur_lower_bound && dirty_value < cur_upper_bound) {
-      if (!block_index_alread_insert_vec) {
-        block_index_alread_insert_vec = true;
-        block_indices->push_back(block_index);
+void LocalFile::WriteDeltaFile(const DirtyInfo &rows, const std::vector<std::pair<const void *, size_t>> &rows_data) {
+  size_t delta_seq = next_delta_seq_++;
+  std::string delta_file_name = DeltaFileName(delta_seq);
+  std::vector<std::pair<const void *, size_t>> delta_data = {std::make_pair(rows.data(), rows.size() * sizeof(int))};
+  (void)delta_data.insert(delta_data.end(), rows_data.begin(), rows_data.end());
+  if (!FileIOUtils::Write(delta_file_name, delta_data)) {
+    MS_LOG(EXCEPTION) << "Write to delta file[" << delta_file_name << "] failed.";
+  }
+  ChangeFileMode(delta_file_name, S_IRWXU | S_IRWXG | S_IRWXO);
+
+  // The sha256 sequence is inserted last, so the delta file without it is incomplete.
+  auto delta_meta_ptr = std::make_shared<BlockMeta>(DeltaMetaFileName(delta_seq));
+  if (!delta_meta_ptr->Initialize()) {
+    MS_LOG(EXCEPTION) << "Initialize delta meta failed, file name [" << DeltaMetaFileName(delta_seq) << "]";
+  }
+  delta_meta_ptr->Insert(kRowNum, rows.size());
+  delta_meta_ptr->Insert(kRowLength, rows_data.front().second / rows.size());
+  delta_meta_ptr->Insert(kTensorNum, rows_data.size());
+  Block delta_block(delta_file_name);
+  delta_block.set_block_meta(delta_meta_ptr);
+  delta_block.GenSha256Seq();
+  delta_seqs_.push_back(delta_seq);
+
+  if (delta_seqs_.size() >= max_delta_num_) {
+    MergeDeltaFiles();
+  }
+}
+
+bool LocalFile::LoadDeltaFile(size_t delta_seq, DeltaFile *delta_file) const {
+  MS_EXCEPTION_IF_NULL(delta_file);
+  auto delta_meta_ptr = std::make_shared<BlockMeta>(DeltaMetaFileName(delta_seq));
+  if (!delta_meta_ptr->Initialize() || !delta_meta_ptr->Exists(kHashSeq)) {
+    return false;
+  }
+  Block delta_block(DeltaFileName(delta_seq));
+  delta_block.set_block_meta(delta_meta_ptr);
+  if (!delta_block.CheckSha256Seq()) {
+    return false;
+  }
+
+  size_t row_num = delta_meta_ptr->Get<size_t>(kRowNum);
+  delta_file->row_length = delta_meta_ptr->Get<size_t>(kRowLength);
+  delta_file->tensor_num = delta_meta_ptr->Get<size_t>(kTensorNum);
+  delta_file->rows.resize(row_num);
+  delta_file->rows_data.resize(delta_file->tensor_num * row_num * delta_file->row_length);
+  std::vector<std::pair<void *, size_t>> delta_data = {
+    std::make_pair(delta_file->rows.data(), row_num * sizeof(int)),
+    std::make_pair(delta_file->rows_data.data(), delta_file->rows_data.size())};
+  return FileIOUtils::Read(delta_block.block_file_name(), delta_data);
+}
+
+void LocalFile::ApplyDeltaFiles(const std::vector<OutputData> &outputs) {
+  for (size_t i = 0; i < delta_seqs_.size(); ++i) {
+    DeltaFile delta_file;
+    if (!LoadDeltaFile(delta_seqs_[i], &delta_file)) {
+      // Only the last delta file could be incomplete if the process exited while writing it, so the rows before the
+      // incomplete one are restored and it and the ones after it are discarded.
+      MS_LOG(WARNING) << "The delta file is incomplete and discarded, file name [" << DeltaFileName(delta_seqs_[i])
+                      << "], the following delta file number: " << (delta_seqs_.size() - i - 1);
+      RemoveDeltaFiles(i);
+      return;
+    }
+    if (delta_file.tensor_num != outputs.size()) {
+      MS_LOG(EXCEPTION) << "The tensor number of delta file[" << DeltaFileName(delta_seqs_[i]) << "] is "
+                        << delta_file.tensor_num << ", but the output number is " << outputs.size();
+    }
+
+    size_t row_num = delta_file.rows.size();
+    size_t row_length = delta_file.row_length;
+    for (size_t output_index = 0; output_index < outputs.size(); ++output_index) {
+      char *dst = reinterpret_cast<char *>(std::get<0>(outputs[output_index]));
+      MS_EXCEPTION_IF_NULL(dst);
+      size_t output_size = std::get<1>(outputs[output_index]);
+      const char *src = delta_file.rows_data.data() + output_index * row_num * row_length;
+      for (size_t j = 0; j < row_num; ++j) {
+        size_t row_offset = IntToSize(delta_file.rows[j]) * row_length;
+        if (row_offset + row_length > output_size) {
+          MS_LOG(EXCEPTION) << "The row " << delta_file.rows[j] << " of delta file[" << DeltaFileName(delta_seqs_[i])
+                            << "] is out of range of the output size " << output_size;
+        }
+        (void)std::copy_n(src + j * row_length, row_length, dst + row_offset);
       }
-      continue;
     }
+  }
+}
+
+void LocalFile::MergeDeltaFiles() {
+  std::vector<DeltaFile> delta_files(delta_seqs_.size());
+  for (size_t i = 0; i < delta_seqs_.size(); ++i) {
+    if (!LoadDeltaFile(delta_seqs_[i], &delta_files[i])) {
+      MS_LOG(EXCEPTION) << "Load delta file failed, file name [" << DeltaFileName(delta_seqs_[i]) << "]";
+    }
+  }
+
+  // Only rewrite the block files which contain the rows in delta files.
+  for (size_t block_index = 0; block_index < block_list_.size(); ++block_index) {
+    const auto &block_meta_ptr = block_meta_list_[block_index];
+    MS_EXCEPTION_IF_NULL(block_meta_ptr);
+    int lower_bound = block_meta_ptr->Get<int>(kShardRangeLowerBound);
+    int upper_bound = block_meta_ptr->Get<int>(kShardRangeUpperBound);
+    size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
+    const auto &block_ptr = block_list_[block_index];
+    MS_EXCEPTION_IF_NULL(block_ptr);
+
+    std::vector<char> block_data;
+    for (const auto &delta_file : delta_files) {
+      auto begin = std::lower_bound(delta_file.rows.begin(), delta_file.rows.end(), lower_bound);
+      auto end = std::lower_bound(begin, delta_file.rows.end(), upper_bound);
+      if (begin == end) {
+        continue;
+      }
+      if (block_data.empty()) {
+        block_data.resize(delta_file.tensor_num * field_size);
+        if (!block_ptr->CheckSha256Seq() ||
+            !FileIOUtils::Read(block_ptr->block_file_name(), {std::make_pair(block_data.data(), block_data.size())})) {
+          MS_LOG(EXCEPTION) << "Read block file failed, file name [" << block_ptr->block_file_name() << "]";
+        }
+      }
 
-    while (!(dirty_value >= cur_lower_bound && dirty_value < cur_upper_bound)) {
-      if (++block_index >= block_meta_list_.size()) {
-        break;
+      size_t row_num = delta_file.rows.size();
+      size_t row_length = delta_file.row_length;
+      for (size_t tensor_index = 0; tensor_index < delta_file.tensor_num; ++tensor_index) {
+        char *dst = block_data.data() + tensor_index * field_size;
+        const char *src = delta_file.rows_data.data() + tensor_index * row_num * row_length;
+        for (auto iter = begin; iter != end; ++iter) {
+          size_t j = LongToSize(iter - delta_file.rows.begin());
+          (void)std::copy_n(src + j * row_length, row_length, dst + IntToSize(*iter - lower_bound) * row_length);
+        }
       }
-      block_meta_ptr = block_meta_list_[block_index];
-      MS_EXCEPTION_IF_NULL(block_meta_ptr);
-      cur_lower_bound = block_meta_ptr->Get<int>(kShardRangeLowerBound);
-      cur_upper_bound = block_meta_ptr->Get<int>(kShardRangeUpperBound);
+    }
+    if (block_data.empty()) {
+      continue;
     }
 
-    if (block_index < block_meta_list_.size()) {
-      block_indices->push_back(block_index);
+    // Write to a temporary file and rename it, so that the block file is never partially written. The block meta accepts
+    // both the old and the new block file until the rename is on disk, and the delta files are kept until all the
+    // block files are replaced. Applying the delta files again to the new block files yields the same rows, so the
+    // tensor is restored correctly whenever the process exits.
+    std::string tmp_file_name = file_path_ + "/" + kTmpFilePrefix + kBlockFilePrefix + std::to_string(block_index);
+    if (!FileIOUtils::Write(tmp_file_name, {std::make_pair(block_data.data(), block_data.size())}) ||
+        !FileIOUtils::Sync(tmp_file_name)) {
+      MS_LOG(EXCEPTION) << "Write to block file[" << tmp_file_name << "] failed.";
+    }
+    ChangeFileMode(tmp_file_name, S_IRWXU | S_IRWXG | S_IRWXO);
+    block_ptr->GenPendingSha256Seq(tmp_file_name);
+    if (rename(tmp_file_name.c_str(), block_ptr->block_file_name().c_str()) != 0) {
+      MS_LOG(EXCEPTION) << "Rename file[" << tmp_file_name << "] to [" << block_ptr->block_file_name()
+                        << "] failed, errno: " << errno;
+    }
+    if (!FileIOUtils::Sync(file_path_)) {
+      MS_LOG(EXCEPTION) << "Sync directory[" << file_path_ << "] failed.";
     }
+    block_ptr->CommitPendingSha256Seq();
   }
+
+  MS_LOG(INFO) << "Merge " << delta_seqs_.size() << " delta files into block files, file path: " << file_path_;
+  RemoveDeltaFiles(0);
+}
+
+void LocalFile::RemoveDeltaFiles(size_t begin) {
+  // Remove the delta meta file first, so a delta file without meta file is discarded if the process exits here.
+  for (size_t i = begin; i < delta_seqs_.size(); ++i) {
+    (void)remove(DeltaMetaFileName(delta_seqs_[i]).c_str());
+    (void)remove(DeltaFileName(delta_seqs_[i]).c_str());
+  }
+  delta_seqs_.resize(std::min(begin, delta_seqs_.size()));
+}
+
+std::string LocalFile::DeltaFileName(size_t delta_seq) const {
+  return file_path_ + "/" + kDeltaFilePrefix + std::to_string(delta_seq);
+}
+
+std::string LocalFile::DeltaMetaFileName(size_t delta_seq) const {
+  return file_path_ + "/" + kDeltaMetaFilePrefix + std::to_string(delta_seq) + kJsonSuffix;
 }
 
 void LocalFile::WriteBlockFiles(const std::vector<InputData> &inputs) {
@@ -123,6 +305,11 @@ void LocalFile::WriteBlockFiles(const std::vector<InputData> &inputs) {
 
   size_t block_num = static_cast<size_t>(std::ceil(static_cast<float>(first_dim) / slice_size));
 
+  // The delta files left in the folder are based on the old block files.
+  LoadDeltaFilesInfo();
+  RemoveDeltaFiles(0);
+  next_delta_seq_ = 0;
+
   size_t offset = 0;
   for (size_t block_index = 0; block_index < block_num; ++block_index) {
     // Create block meta.
@@ -221,6 +408,8 @@ void LocalFile::Read(const std::vector<OutputData> &outputs) {
       MS_LOG(EXCEPTION) << "Read block file failed, file name [" << block_ptr->block_file_name() << "]";
     }
   }
+
+  ApplyDeltaFiles(outputs);
 }
 
 bool LocalFile::LoadBlocksInfo() {
@@ -233,18 +422,13 @@ bool LocalFile::LoadBlocksInfo() {
   std::vector<std::string> block_meta_file_name_list;
   struct dirent *entry;
 
-  // Get file names of all block file and block meta file in the current folder.
+  // Get file names of all block file and block meta file in the current folder, the delta files are loaded separately.
   while ((entry = readdir(dir)) != nullptr) {
     std::string file_name = entry->d_name;
-    if (file_name.length() <= JSON_SUFFIX_LENS) {
-      continue;
-    }
-
     std::string real_storage_file_path = file_path_ + "/" + file_name;
-    auto suffix = file_name.substr(file_name.length() - JSON_SUFFIX_LENS);
-    if (suffix == kJsonSuffix) {
+    if (file_name.find(kBlockMetaFilePrefix) == 0) {
       block_meta_file_name_list.push_back(real_storage_file_path);
-    } else {
+    } else if (file_name.find(kBlockFilePrefix) == 0) {
       block_file_name_list.push_back(real_storage_file_path);
     }
   }
@@ -270,8 +454,37 @@ bool LocalFile::LoadBlocksInfo() {
     block_ptr->set_block_meta(block_meta_ptr);
     block_list_.push_back(block_ptr);
   }
+
+  // The following writes are based on the loaded block files.
+  finish_create_block_files_ = !block_list_.empty();
+  LoadDeltaFilesInfo();
   return true;
 }
+
+void LocalFile::LoadDeltaFilesInfo() {
+  delta_seqs_.clear();
+  DIR *dir = opendir(file_path_.c_str());
+  if (dir == nullptr) {
+    MS_LOG(EXCEPTION) << "The file path [" << file_path_ << "] is not exist";
+  }
+  struct dirent *entry;
+  const std::string delta_meta_prefix = kDeltaMetaFilePrefix;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string file_name = entry->d_name;
+    if (file_name.find(delta_meta_prefix) != 0 || file_name.length() <= delta_meta_prefix.length() + JSON_SUFFIX_LENS) {
+      continue;
+    }
+    std::string seq =
+      file_name.substr(delta_meta_prefix.length(), file_name.length() - delta_meta_prefix.length() - JSON_SUFFIX_LENS);
+    if (std::all_of(seq.begin(), seq.end(), [](char c) { return std::isdigit(c) != 0; })) {
+      delta_seqs_.push_back(std::stoul(seq));
+    }
+  }
+  (void)closedir(dir);
+
+  std::sort(delta_seqs_.begin(), delta_seqs_.end());
+  next_delta_seq_ = delta_seqs_.empty() ? 0 : delta_seqs_.back() + 1;
+}
 }  // namespace storage
 }  // namespace distributed
 }  // namespace mindspore
@@ -31,8 +31,13 @@ namespace distributed {
 namespace storage {
 // The default maximum block length : 128MB.
 constexpr size_t DEFAULT_MAX_BLOCK_LENGTH = 128 << 20;
+// The default maximum number of delta files, the delta files are merged into block files when the number is reached.
+constexpr size_t DEFAULT_MAX_DELTA_NUM = 16;
 
 // File type persistence storage implementation class.
+// The block files are the base snapshot of the tensor. After that, only the dirty rows are written to the delta files
+// in order, and the delta files are merged into the changed block files once there are too many of them. The tensor is
+// restored from the base snapshot and the delta files.
 class LocalFile : public StorageBase {
  public:
   explicit LocalFile(const std::map<std::string, std::string> &storage_config) {
@@ -47,6 +52,13 @@ class LocalFile : public StorageBase {
     } else {
       max_block_length_ = DEFAULT_MAX_BLOCK_LENGTH;
     }
+
+    auto delta_num_iter = storage_config.find(kMaxDeltaNum);
+    if (delta_num_iter != storage_config.end() && !(delta_num_iter->second).empty()) {
+      max_delta_num_ = std::stoul(delta_num_iter->second);
+    } else {
+      max_delta_num_ = DEFAULT_MAX_DELTA_NUM;
+    }
   }
 
   ~LocalFile() override = default;
@@ -54,14 +66,19 @@ class LocalFile : public StorageBase {
   // The following two methods are override version function for Write:
   // 1. Create blocks and block metas.
   // 2. Write input data to block files and Generate sha256 sequence for every block file.
+  // If the block files have been created, only the rows in dirty info are written to a new delta file.
   // Write the entire blob data of tensor to the block files on disk:
   void Write(const InputData &input, const DirtyInfo &dirty_info) override;
   // Write the entire blob data composed of multiple tensors to the block files on disk:
   void Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) override;
 
+  // Write the data of the dirty rows to a new delta file, the block files should have been created.
+  void WriteIncremental(const InputData &input, const DirtyInfo &rows) override;
+
   // The following two methods are override version function for Read:
   // 1.Tamper proof check.
   // 2.Read all block files and merge them into contiguous memory.
+  // 3.Apply the delta files to the memory in the order they are written.
   // Read data from all block files in file_path_(dir):
   void Read(const OutputData &output) override;
   // Read data from all block files in file_path_(dir) for multiple tensors.
@@ -74,9 +91,36 @@ class LocalFile : public StorageBase {
   // Write shardding data to one specific block file by block index and generate sha256.
   void WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const;
 
-  // Obtain the corresponding file block index according to dirty info, only need to rewrite these file blocks, and
-  // dirty info needs to be sorted in ascending order.
-  void TransformDirtyInfoToBlockIndices(const DirtyInfo &dirty_info, std::vector<int> *block_indices) const;
+  // The rows and the data of the rows in a delta file, the data of the rows of every tensor are stored one after
+  // another.
+  struct DeltaFile {
+    DirtyInfo rows;
+    std::vector<char> rows_data;
+    size_t row_length{0};
+    size_t tensor_num{0};
+  };
+
+  // Write the data of the rows to a new delta file, 'rows_data' contains the data of the rows for every tensor.
+  void WriteDeltaFile(const DirtyInfo &rows, const std::vector<std::pair<const void *, size_t>> &rows_data);
+
+  // Load the delta file with sequence number 'delta_seq', return false if the delta file is incomplete, which means the
+  // process exited while writing it.
+  bool LoadDeltaFile(size_t delta_seq, DeltaFile *delta_file) const;
+
+  // Apply all the delta files to outputs in the order they are written.
+  void ApplyDeltaFiles(const std::vector<OutputData> &outputs);
+
+  // Merge all the delta files into the block files which contain the changed rows, and remove the delta files.
+  void MergeDeltaFiles();
+
+  // Remove the delta files from the 'begin' one in 'delta_seqs_'.
+  void RemoveDeltaFiles(size_t begin);
+
+  // Find the sequence numbers of the delta files in the 'file_path_'.
+  void LoadDeltaFilesInfo();
+
+  std::string DeltaFileName(size_t delta_seq) const;
+  std::string DeltaMetaFileName(size_t delta_seq) const;
 
   // Load file list info of block files and block meta files in the 'file_path_' to block list and block meta list.
   bool LoadBlocksInfo();
@@ -96,6 +140,15 @@ class LocalFile : public StorageBase {
 
   // Indicates whether block files has been created.
   bool finish_create_block_files_{false};
+
+  // Maximum number of the delta files before they are merged into the block files.
+  size_t max_delta_num_;
+
+  // The sequence numbers of the delta files written after the block files in ascending order.
+  std::vector<size_t> delta_seqs_;
+
+  // The sequence number of the next delta file.
+  size_t next_delta_seq_{0};
 };
 }  // namespace storage
 }  // namespace distributed
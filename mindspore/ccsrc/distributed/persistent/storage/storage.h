@@ -53,6 +53,11 @@ class StorageBase {
   // The parameter dirty_info indicates that the part of the Tensor that needs to be rewritten to storage.
   virtual void Write(const std::vector<InputData> &input, const DirtyInfo &dirty_info) {}
 
+  // Write the dirty rows of the tensor to storage incrementally, the storage medium should already hold the entire
+  // tensor. The input only contains the data of the dirty rows, and the parameter rows indicates the row numbers of
+  // them in the entire tensor in ascending order.
+  virtual void WriteIncremental(const InputData &input, const DirtyInfo &rows) {}
+
   // Read data from the storage medium or memory buffer and merge them into contiguous memory.
   virtual void Read(const OutputData &output) {}
 
@@ -99,6 +99,14 @@ void RecoveryContext::Initialize() {
     recovery_interval_ = std::stoi(env_recovery_interval);
   }
 
+  auto env_max_delta_num = common::GetEnv(kEnvRecoveryMaxDeltaNum);
+  if (!env_max_delta_num.empty()) {
+    max_delta_num_ = std::stoul(env_max_delta_num);
+    if (max_delta_num_ == 0) {
+      MS_LOG(EXCEPTION) << "The environment variable '" << kEnvRecoveryMaxDeltaNum << "' should be positive.";
+    }
+  }
+
   node_role_ = common::GetEnv(distributed::kEnvRole);
   if (distributed::kValidRoleName.count(node_role_) == 0) {
     MS_LOG(EXCEPTION) << "Role name '" << node_role_ << "' is invalid. ";
@@ -23,6 +23,7 @@
 #include "utils/ms_utils.h"
 #include "distributed/persistent/storage/file_io_utils.h"
 #include "distributed/persistent/storage/json_utils.h"
+#include "distributed/persistent/storage/local_file.h"
 #include "runtime/collective/collective_communication_lib.h"
 #include "include/backend/visible.h"
 
@@ -32,6 +33,7 @@ namespace recovery {
 constexpr char kEnvEnableRecovery[] = "MS_ENABLE_RECOVERY";
 constexpr char kEnvRecoveryPath[] = "MS_RECOVERY_PATH";
 constexpr char kEnvRecoveryInterval[] = "MS_RECOVERY_INTERVAL";
+constexpr char kEnvRecoveryMaxDeltaNum[] = "MS_RECOVERY_MAX_DELTA_NUM";
 
 __attribute__((unused)) static bool IsEnableRecovery() {
   return common::GetEnv(kEnvEnableRecovery) == std::string("1");
@@ -64,6 +66,9 @@ class BACKEND_EXPORT RecoveryContext {
   // Get interval to persist model.
   int recovery_interval() const { return recovery_interval_; }
 
+  // Get the maximum number of incremental checkpoints of a parameter before they are merged into the base snapshot.
+  size_t max_delta_num() const { return max_delta_num_; }
+
   // Set the path used to save checkpoint.
   void SetCkptPath(const std::string &path);
   // Get the path used to save checkpoint.
@@ -133,6 +138,10 @@ class BACKEND_EXPORT RecoveryContext {
   // The interval to persist model, default value: 30 second. set by environment variable 'MS_RECOVERY_INTERVAL'.
   int recovery_interval_{30};
 
+  // The maximum number of incremental checkpoints of a parameter, which are restored on the base snapshot in order. Set
+  // by environment variable 'MS_RECOVERY_MAX_DELTA_NUM'.
+  size_t max_delta_num_{storage::DEFAULT_MAX_DELTA_NUM};
+
   // Local checkpoint file list.
   std::vector<std::string> ckpt_files_;
   // The file name of latest checkpoint.
@@ -359,17 +359,27 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       send_io_vec[index].iov_base = const_cast<char *>(send_from.data());
       send_io_vec[index].iov_len = send_from.size();
       ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
-      send_io_vec[index].iov_len = msg->body.size();
-      ++index;
-      send_kernel_msg.msg_iov = send_io_vec;
-      send_kernel_msg.msg_iovlen = index;
+      auto gather_message = dynamic_cast<GatherMessage *>(msg);
+      if (gather_message != nullptr) {
+        // The body pieces follow the header buffers, the external ones are sent from where they are.
+        send_gather_io_vec.assign(send_io_vec, send_io_vec + index);
+        gather_message->FillIoVec(&send_gather_io_vec);
+        send_kernel_msg.msg_iov = send_gather_io_vec.data();
+        send_kernel_msg.msg_iovlen = send_gather_io_vec.size();
+      } else {
+        send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
+        send_io_vec[index].iov_len = msg->body.size();
+        ++index;
+        send_kernel_msg.msg_iov = send_io_vec;
+        send_kernel_msg.msg_iovlen = index;
+      }
+      size_t body_size = GetMessageBodySize(*msg);
       total_send_len =
-        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + msg->body.size();
+        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + body_size;
       send_message = msg;
 
       // update metrics
-      send_metrics->UpdateMax(msg->body.size());
+      send_metrics->UpdateMax(body_size);
       send_metrics->last_send_msg_name = msg->name;
       return;
     } else {
@@ -411,13 +421,23 @@ void Connection::FillRecvMessage() {
   }
 
   int i = 0;
-  MessageBase *msg = new (std::nothrow) MessageBase();
+  MessageBase *msg = nullptr;
+  if (message_allocator != nullptr) {
+    msg = message_allocator(recvBodyLen);
+  }
+  // Receive the body into the allocated buffer directly if any.
+  bool recv_into_data = msg != nullptr && msg->data != nullptr && msg->size == recvBodyLen;
+  if (msg == nullptr) {
+    msg = new (std::nothrow) MessageBase();
+  }
   MS_EXCEPTION_IF_NULL(msg);
 
   msg->name.resize(recvNameLen);
   recv_to.resize(recvToLen);
   recv_from.resize(recvFromLen);
-  msg->body.resize(recvBodyLen);
+  if (!recv_into_data) {
+    msg->body.resize(recvBodyLen);
+  }
 
   recv_io_vec[i].iov_base = const_cast<char *>(msg->name.data());
   recv_io_vec[i].iov_len = msg->name.size();
@@ -428,13 +448,13 @@ void Connection::FillRecvMessage() {
   recv_io_vec[i].iov_base = const_cast<char *>(recv_from.data());
   recv_io_vec[i].iov_len = recv_from.size();
   ++i;
-  recv_io_vec[i].iov_base = const_cast<char *>(msg->body.data());
-  recv_io_vec[i].iov_len = msg->body.size();
+  recv_io_vec[i].iov_base = recv_into_data ? msg->data : const_cast<char *>(msg->body.data());
+  recv_io_vec[i].iov_len = recvBodyLen;
   ++i;
 
   recv_kernel_msg.msg_iov = recv_io_vec;
   recv_kernel_msg.msg_iovlen = IntToSize(i);
-  total_recv_len = msg->name.size() + recv_to.size() + recv_from.size() + msg->body.size();
+  total_recv_len = msg->name.size() + recv_to.size() + recv_from.size() + recvBodyLen;
 
   // There is no need to delete recv_message first because the recv_message has already been returned to the caller and
   // it's the caller's responsibility to release the received message after using it.
@@ -456,8 +476,9 @@ int Connection::Flush() {
         // update metrics
         send_metrics->UpdateError(false);
 
-        output_buffer_size -= send_message->body.size();
-        total_send_bytes += send_message->body.size();
+        size_t body_size = GetMessageBodySize(*send_message);
+        output_buffer_size -= body_size;
+        total_send_bytes += body_size;
         delete send_message;
         send_message = nullptr;
         break;
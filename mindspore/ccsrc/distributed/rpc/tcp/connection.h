@@ -21,11 +21,13 @@
 #include <string>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/event_loop.h"
 #include "distributed/rpc/tcp/socket_operation.h"
+#include "distributed/rpc/tcp/gather_message.h"
 
 namespace mindspore {
 namespace distributed {
@@ -182,6 +184,8 @@ struct Connection {
 
   struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
   struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
+  // The io vectors of the message header and the body pieces of a GatherMessage.
+  std::vector<struct iovec> send_gather_io_vec;
 
   ParseType recv_message_type{kTcpMsg};
 
@@ -194,6 +198,9 @@ struct Connection {
   // Function for handling received messages.
   MessageHandler message_handler;
 
+  // Function for allocating the buffer to receive a message body into.
+  MessageAllocator message_allocator;
+
   // Buffer for messages to be sent.
   std::queue<MessageBase *> send_message_queue;
 
@@ -26,6 +26,7 @@
 
 #include "actor/log.h"
 #include "actor/msg.h"
+#include "distributed/rpc/tcp/gather_message.h"
 
 namespace mindspore {
 namespace distributed {
@@ -122,14 +123,15 @@ __attribute__((unused)) static void FillMessageHeader(const MessageBase &message
   header->name_len = htonl(static_cast<uint32_t>(message.name.size()));
   header->to_len = htonl(static_cast<uint32_t>(send_to.size()));
   header->from_len = htonl(static_cast<uint32_t>(send_from.size()));
-  header->body_len = htonl(static_cast<uint32_t>(message.body.size()));
+  header->body_len = htonl(static_cast<uint32_t>(GetMessageBodySize(message)));
 }
 
 // Compute and return the byte size of the whole message.
 __attribute__((unused)) static size_t GetMessageSize(const MessageBase &message) {
   std::string send_to = message.to;
   std::string send_from = message.from;
-  size_t size = message.name.size() + send_to.size() + send_from.size() + message.body.size() + sizeof(MessageHeader);
+  size_t size =
+    message.name.size() + send_to.size() + send_from.size() + GetMessageBodySize(message) + sizeof(MessageHeader);
   return size;
 }
 
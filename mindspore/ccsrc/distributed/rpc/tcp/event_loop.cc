@@ -25,6 +25,7 @@
 #include <unistd.h>
 #include <utility>
 #include <atomic>
+#include <chrono>
 #include <string>
 #include <thread>
 
@@ -64,7 +65,11 @@ int EventLoopRun(EventLoop *evloop, int timeout) {
       }
     } else if (nevent > 0) {
       /* save the epoll modify in "stop" while dispatching handlers */
+      auto start_time = std::chrono::steady_clock::now();
       evloop->HandleEvent(events, nevent);
+      auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+      evloop->handled_event_num_.fetch_add(static_cast<size_t>(nevent), std::memory_order_relaxed);
+      evloop->busy_time_us_.fetch_add(static_cast<uint64_t>(cost.count()), std::memory_order_relaxed);
     } else {
       MS_LOG(ERROR) << "Failed to call epoll_wait, epoll_fd_: " << evloop->epoll_fd_ << ", ret: 0,errno: " << errno;
       evloop->is_stop_ = true;
@@ -107,6 +112,7 @@ void QueueReadyCallback(int fd, uint32_t events, void *arg) {
     evloop->task_queue_mutex_.unlock();
 
     // invoke functions in the queue
+    evloop->executed_task_num_.fetch_add(q.size(), std::memory_order_relaxed);
     while (!q.empty()) {
       q.front()();
       q.pop();
@@ -156,6 +162,18 @@ size_t EventLoop::RemainingTaskNum() {
   return task_num;
 }
 
+EventLoopMetrics EventLoop::GetMetrics() {
+  EventLoopMetrics metrics;
+  {
+    std::lock_guard<std::mutex> lock(event_lock_);
+    metrics.fd_num = events_.size();
+  }
+  metrics.handled_event_num = handled_event_num_.load(std::memory_order_relaxed);
+  metrics.executed_task_num = executed_task_num_.load(std::memory_order_relaxed);
+  metrics.busy_time_us = busy_time_us_.load(std::memory_order_relaxed);
+  return metrics;
+}
+
 bool EventLoop::Initialize(const std::string &threadName) {
   int retval = InitResource();
   if (retval != RPC_OK) {
@@ -21,6 +21,7 @@
 #include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <semaphore.h>
+#include <atomic>
 #include <functional>
 #include <list>
 #include <mutex>
@@ -52,6 +53,20 @@ typedef struct {
   EventHandler handler;
 } Event;
 
+/*
+ * The metrics of an event loop.
+ */
+struct EventLoopMetrics {
+  // The number of file descriptors monitored.
+  size_t fd_num{0};
+  // The number of events handled on the file descriptors.
+  size_t handled_event_num{0};
+  // The number of tasks executed.
+  size_t executed_task_num{0};
+  // The time spent on handling the events and executing the tasks in microseconds.
+  uint64_t busy_time_us{0};
+};
+
 /*
  * The class EventLoop monitors a certain file descriptor created by eventfd function call,
  * and triggers tasks when any event occurred on the file descriptor.
@@ -80,6 +95,9 @@ class EventLoop {
   int UpdateEpollEvent(int fd, uint32_t events);
   int DeleteEpollEvent(int fd);
 
+  // Get the metrics of this event loop.
+  EventLoopMetrics GetMetrics();
+
  private:
   void AddEvent(Event *event);
 
@@ -129,6 +147,11 @@ class EventLoop {
   // delete events on the same fd twice in once epoll_wait.
   std::map<int, std::list<Event *>> deleted_events_;
 
+  // The metrics, which are updated by the loop thread only.
+  std::atomic<size_t> handled_event_num_{0};
+  std::atomic<size_t> executed_task_num_{0};
+  std::atomic<uint64_t> busy_time_us_{0};
+
   friend int EventLoopRun(EventLoop *evloop, int timeout);
   friend void QueueReadyCallback(int fd, uint32_t events, void *arg);
 };
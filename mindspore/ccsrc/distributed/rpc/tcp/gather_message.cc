@@ -0,0 +1,76 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/tcp/gather_message.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+GatherMessage::~GatherMessage() {
+  for (const auto &release : release_callbacks_) {
+    release();
+  }
+}
+
+void GatherMessage::Append(const void *data, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  // Merge with the previous piece if it is in the body too.
+  if (!pieces_.empty() && pieces_.back().in_body_) {
+    pieces_.back().size_ += size;
+  } else {
+    pieces_.push_back({true, body.size(), nullptr, size});
+  }
+  (void)body.append(static_cast<const char *>(data), size);
+  body_size_ += size;
+}
+
+void GatherMessage::AppendExternal(const void *data, size_t size, const std::function<void()> &release) {
+  if (release != nullptr) {
+    release_callbacks_.push_back(release);
+  }
+  if (size == 0) {
+    return;
+  }
+  // Past the piece limit the data is copied, it saves no syscall to send it alone anyway.
+  if (pieces_.size() + 1 >= kMaxGatherMessagePieces) {
+    Append(data, size);
+    return;
+  }
+  pieces_.push_back({false, 0, data, size});
+  body_size_ += size;
+}
+
+void GatherMessage::FillIoVec(std::vector<struct iovec> *io_vec) const {
+  for (const auto &piece : pieces_) {
+    struct iovec vec;
+    vec.iov_base = piece.in_body_ ? const_cast<char *>(body.data() + piece.offset_) : const_cast<void *>(piece.data_);
+    vec.iov_len = piece.size_;
+    io_vec->push_back(vec);
+  }
+}
+
+size_t GetMessageBodySize(const MessageBase &message) {
+  auto gather_message = dynamic_cast<const GatherMessage *>(&message);
+  if (gather_message != nullptr) {
+    return gather_message->body_size();
+  }
+  return message.body.size();
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
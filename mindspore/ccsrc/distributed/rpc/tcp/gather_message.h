@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_GATHER_MESSAGE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_GATHER_MESSAGE_H_
+
+#include <sys/uio.h>
+#include <functional>
+#include <vector>
+
+#include "actor/msg.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+// The max number of pieces of a GatherMessage, the pieces and the 4 message header buffers go in one sendmsg.
+constexpr size_t kMaxGatherMessagePieces = 64;
+
+/*
+ * GatherMessage is a message whose body is gathered from several buffers: small ones such as serialized headers are
+ * copied into the body, large ones such as tensors are referred by address and sent by scatter-gather io without being
+ * copied. On the wire it is a normal message whose body is the concatenation of the pieces.
+ */
+class GatherMessage : public MessageBase {
+ public:
+  GatherMessage() = default;
+  ~GatherMessage() override;
+
+  // Append a piece copied into the body.
+  void Append(const void *data, size_t size);
+  // Append a piece referring to external memory, which must stay valid until the message is destroyed after being
+  // sent or dropped, then the release callback is called if set.
+  void AppendExternal(const void *data, size_t size, const std::function<void()> &release = nullptr);
+
+  // The byte size of the body on the wire.
+  size_t body_size() const { return body_size_; }
+
+  // Append the io vectors of the body pieces in order.
+  void FillIoVec(std::vector<struct iovec> *io_vec) const;
+
+ private:
+  struct Piece {
+    // Pieces copied into the body are located by the offset, as the body buffer moves while it grows.
+    bool in_body_;
+    size_t offset_;
+    const void *data_;
+    size_t size_;
+  };
+
+  std::vector<Piece> pieces_;
+  std::vector<std::function<void()>> release_callbacks_;
+  size_t body_size_{0};
+};
+
+// The byte size of the message body on the wire.
+size_t GetMessageBodySize(const MessageBase &message);
+
+/*
+ * The allocator of a received message, it is called with the body size after the message header arrives. It returns a
+ * message whose 'data' and 'size' are a buffer of the body size to receive the body into directly, or nullptr to
+ * receive the body into the 'body' string of a normal message.
+ */
+using MessageAllocator = std::function<MessageBase *(size_t body_size)>;
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif
@@ -30,7 +30,8 @@ namespace distributed {
 namespace rpc {
 class TCPClient {
  public:
-  explicit TCPClient(bool enable_ssl = false) : enable_ssl_(enable_ssl) {}
+  explicit TCPClient(bool enable_ssl = false, size_t event_loop_num = 1)
+      : enable_ssl_(enable_ssl), event_loop_num_(event_loop_num) {}
   ~TCPClient() = default;
 
   // Build or destroy the TCP client.
@@ -73,6 +74,9 @@ class TCPClient {
 
   bool enable_ssl_;
 
+  // The number of the event loop shards which the connections are handled by.
+  size_t event_loop_num_;
+
   DISABLE_COPY_AND_ASSIGN(TCPClient);
 };
 }  // namespace rpc
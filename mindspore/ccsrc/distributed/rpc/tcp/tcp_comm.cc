@@ -19,6 +19,7 @@
 #include <mutex>
 #include <utility>
 #include <memory>
+#include <functional>
 
 #include "actor/aid.h"
 #include "distributed/rpc/tcp/constants.h"
@@ -27,6 +28,20 @@
 namespace mindspore {
 namespace distributed {
 namespace rpc {
+namespace {
+// The max length of a thread name, excluding the terminating null byte.
+constexpr size_t kMaxThreadNameLen = 15;
+
+// The thread name of the event loop of the shard, the first shard keeps the name as is.
+std::string GetEventLoopThreadName(const std::string &name, size_t index) {
+  if (index == 0) {
+    return name;
+  }
+  std::string suffix = "_" + std::to_string(index);
+  return name.substr(0, kMaxThreadNameLen - suffix.size()) + suffix;
+}
+}  // namespace
+
 void DoDisconnect(int fd, Connection *conn, uint32_t error, int soError) {
   if (LOG_CHECK_EVERY_N()) {
     MS_LOG(INFO) << "Failed to call connect, fd: " << fd << ", to: " << conn->destination.c_str()
@@ -67,7 +82,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
     return;
   }
   TCPComm *tcpmgr = reinterpret_cast<TCPComm *>(arg);
-  if (tcpmgr->recv_event_loop_ == nullptr) {
+  if (tcpmgr->recv_event_loops_.empty()) {
     MS_LOG(ERROR) << "EventLoop is null, server fd: " << server << ", events: " << events;
     return;
   }
@@ -108,11 +123,10 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->peer = conn->destination;
 
   conn->is_remote = true;
-  conn->recv_event_loop = tcpmgr->recv_event_loop_;
-  conn->send_event_loop = tcpmgr->send_event_loop_;
+  tcpmgr->BindEventLoop(conn, tcpmgr->GetEventLoopIndex(conn->destination));
 
-  conn->conn_mutex = tcpmgr->conn_mutex_;
   conn->message_handler = tcpmgr->message_handler_;
+  conn->message_allocator = tcpmgr->message_allocator_;
 
   conn->event_callback = std::bind(&TCPComm::EventCallBack, tcpmgr, std::placeholders::_1);
   conn->write_callback = std::bind(&TCPComm::WriteCallBack, tcpmgr, std::placeholders::_1);
@@ -135,6 +149,8 @@ void OnAccept(int server, uint32_t events, void *arg) {
 
 void TCPComm::SetMessageHandler(const MessageHandler &handler) { message_handler_ = handler; }
 
+void TCPComm::SetMessageAllocator(const MessageAllocator &allocator) { message_allocator_ = allocator; }
+
 bool TCPComm::Initialize() {
   conn_pool_ = std::make_shared<ConnectionPool>();
   MS_EXCEPTION_IF_NULL(conn_pool_);
@@ -142,38 +158,63 @@ bool TCPComm::Initialize() {
   conn_mutex_ = std::make_shared<std::mutex>();
   MS_EXCEPTION_IF_NULL(conn_mutex_);
 
-  recv_event_loop_ = new (std::nothrow) EventLoop();
-  if (recv_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create recv evLoop.";
-    return false;
-  }
+  for (size_t i = 0; i < event_loop_num_; ++i) {
+    auto recv_event_loop = new (std::nothrow) EventLoop();
+    if (recv_event_loop == nullptr) {
+      MS_LOG(ERROR) << "Failed to create recv evLoop.";
+      ReleaseEventLoops();
+      return false;
+    }
+    if (!recv_event_loop->Initialize(GetEventLoopThreadName(TCP_RECV_EVLOOP_THREADNAME, i))) {
+      MS_LOG(ERROR) << "Failed to init recv evLoop";
+      delete recv_event_loop;
+      ReleaseEventLoops();
+      return false;
+    }
+    recv_event_loops_.push_back(recv_event_loop);
 
-  bool ok = recv_event_loop_->Initialize(TCP_RECV_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init recv evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
+    auto send_event_loop = new (std::nothrow) EventLoop();
+    if (send_event_loop == nullptr) {
+      MS_LOG(ERROR) << "Failed to create send evLoop.";
+      ReleaseEventLoops();
+      return false;
+    }
+    if (!send_event_loop->Initialize(GetEventLoopThreadName(TCP_SEND_EVLOOP_THREADNAME, i))) {
+      MS_LOG(ERROR) << "Failed to init send evLoop";
+      delete send_event_loop;
+      ReleaseEventLoops();
+      return false;
+    }
+    send_event_loops_.push_back(send_event_loop);
+
+    auto shard_mutex = std::make_shared<std::mutex>();
+    MS_EXCEPTION_IF_NULL(shard_mutex);
+    shard_mutexes_.push_back(shard_mutex);
   }
+  MS_LOG(INFO) << "The number of the event loop shards is " << event_loop_num_;
+  return true;
+}
 
-  send_event_loop_ = new (std::nothrow) EventLoop();
-  if (send_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create send evLoop.";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
+size_t TCPComm::GetEventLoopIndex(const std::string &url) const { return std::hash<std::string>()(url) % event_loop_num_; }
+
+void TCPComm::BindEventLoop(Connection *conn, size_t index) {
+  conn->recv_event_loop = recv_event_loops_[index];
+  conn->send_event_loop = send_event_loops_[index];
+  conn->conn_mutex = shard_mutexes_[index];
+}
+
+void TCPComm::GetEventLoopMetrics(std::vector<EventLoopMetrics> *recv_metrics,
+                                  std::vector<EventLoopMetrics> *send_metrics) const {
+  MS_EXCEPTION_IF_NULL(recv_metrics);
+  MS_EXCEPTION_IF_NULL(send_metrics);
+  recv_metrics->clear();
+  send_metrics->clear();
+  for (auto recv_event_loop : recv_event_loops_) {
+    recv_metrics->push_back(recv_event_loop->GetMetrics());
   }
-  ok = send_event_loop_->Initialize(TCP_SEND_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init send evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-    return false;
+  for (auto send_event_loop : send_event_loops_) {
+    send_metrics->push_back(send_event_loop->GetMetrics());
   }
-
-  return true;
 }
 
 bool TCPComm::StartServerSocket(const std::string &url) {
@@ -189,7 +230,7 @@ bool TCPComm::StartServerSocket(const std::string &url) {
   }
 
   // Register read event callback for server socket
-  int retval = recv_event_loop_->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
+  int retval = recv_event_loops_[0]->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
                                                  reinterpret_cast<void *>(this));
   if (retval != RPC_OK) {
     MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str();
@@ -230,6 +271,7 @@ void TCPComm::EventCallBack(void *connection) {
     conn->conn_mutex->unlock();
   } else if (conn->state == ConnectionState::kDisconnecting) {
     std::lock_guard<std::mutex> lock(*conn_mutex_);
+    std::lock_guard<std::mutex> shard_lock(*conn->conn_mutex);
     conn_pool_->DeleteConnection(conn->destination);
   }
 }
@@ -301,10 +343,12 @@ void TCPComm::DropMessage(MessageBase *msg) {
 }
 
 ssize_t TCPComm::Send(MessageBase *msg, bool sync) {
-  auto task = [msg, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+  // The message is sent by the event loop of the shard the destination belongs to.
+  std::string destination = msg->to.Url();
+  size_t index = GetEventLoopIndex(destination);
+  auto task = [msg, destination, index, this] {
+    std::lock_guard<std::mutex> lock(*shard_mutexes_[index]);
     // Search connection by the target address
-    std::string destination = msg->to.Url();
     Connection *conn = conn_pool_->FindConnection(destination);
     if (conn == nullptr) {
       MS_LOG(ERROR) << "Can not found remote link and send fail name: " << msg->name.c_str()
@@ -342,7 +386,7 @@ ssize_t TCPComm::Send(MessageBase *msg, bool sync) {
   if (sync) {
     return task();
   } else {
-    send_event_loop_->AddTask(task);
+    send_event_loops_[index]->AddTask(task);
     return true;
   }
 }
@@ -354,7 +398,10 @@ bool TCPComm::Flush(const std::string &dst_url) {
     return false;
   } else {
     std::lock_guard<std::mutex> lock(*(conn->conn_mutex));
-    return conn->Flush();
+    // The pending data may have been sent by the send event loop already, in which case nothing is flushed here, so
+    // the result depends on whether the connection is still available.
+    (void)conn->Flush();
+    return conn->state == ConnectionState::kConnected;
   }
 }
 
@@ -372,10 +419,9 @@ bool TCPComm::Connect(const std::string &dst_url) {
       return false;
     }
     conn->enable_ssl = enable_ssl_;
-    conn->recv_event_loop = this->recv_event_loop_;
-    conn->send_event_loop = this->send_event_loop_;
-    conn->conn_mutex = conn_mutex_;
+    BindEventLoop(conn, GetEventLoopIndex(dst_url));
     conn->message_handler = message_handler_;
+    conn->message_allocator = message_allocator_;
     conn->InitSocketOperation();
 
     // Create the client socket.
@@ -436,16 +482,20 @@ bool TCPComm::IsConnected(const std::string &dst_url) {
 bool TCPComm::Disconnect(const std::string &dst_url) {
   int interval = 100000;
   size_t retry = 30;
-  while (recv_event_loop_->RemainingTaskNum() != 0 && send_event_loop_->RemainingTaskNum() != 0 && retry > 0) {
+  size_t index = GetEventLoopIndex(dst_url);
+  EventLoop *recv_event_loop = recv_event_loops_[index];
+  EventLoop *send_event_loop = send_event_loops_[index];
+  while (recv_event_loop->RemainingTaskNum() != 0 && send_event_loop->RemainingTaskNum() != 0 && retry > 0) {
     usleep(interval);
     retry--;
   }
-  if (recv_event_loop_->RemainingTaskNum() > 0 || send_event_loop_->RemainingTaskNum() > 0) {
+  if (recv_event_loop->RemainingTaskNum() > 0 || send_event_loop->RemainingTaskNum() > 0) {
     MS_LOG(ERROR) << "Failed to disconnect from url " << dst_url
                   << ", because there are still pending tasks to be executed, please try later.";
     return false;
   }
   std::lock_guard<std::mutex> lock(*conn_mutex_);
+  std::lock_guard<std::mutex> shard_lock(*shard_mutexes_[index]);
   auto conn = conn_pool_->FindConnection(dst_url);
   if (conn != nullptr) {
     std::lock_guard<std::mutex> conn_lock(conn->conn_owned_mutex_);
@@ -463,28 +513,34 @@ Connection *TCPComm::CreateDefaultConn(const std::string &to) {
   conn->enable_ssl = enable_ssl_;
   conn->source = url_.data();
   conn->destination = to;
-  conn->recv_event_loop = this->recv_event_loop_;
-  conn->send_event_loop = this->send_event_loop_;
-  conn->conn_mutex = conn_mutex_;
+  BindEventLoop(conn, GetEventLoopIndex(to));
   conn->message_handler = message_handler_;
+  conn->message_allocator = message_allocator_;
   conn->InitSocketOperation();
   return conn;
 }
 
-void TCPComm::Finalize() {
-  if (send_event_loop_ != nullptr) {
+void TCPComm::ReleaseEventLoops() {
+  for (auto &send_event_loop : send_event_loops_) {
     MS_LOG(INFO) << "Delete send event loop";
-    send_event_loop_->Finalize();
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
+    send_event_loop->Finalize();
+    delete send_event_loop;
+    send_event_loop = nullptr;
   }
+  send_event_loops_.clear();
 
-  if (recv_event_loop_ != nullptr) {
+  for (auto &recv_event_loop : recv_event_loops_) {
     MS_LOG(INFO) << "Delete recv event loop";
-    recv_event_loop_->Finalize();
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
+    recv_event_loop->Finalize();
+    delete recv_event_loop;
+    recv_event_loop = nullptr;
   }
+  recv_event_loops_.clear();
+  shard_mutexes_.clear();
+}
+
+void TCPComm::Finalize() {
+  ReleaseEventLoops();
 
   if (server_fd_ > 0) {
     if (close(server_fd_) != 0) {
@@ -39,8 +39,8 @@ void ConnectedEventHandler(int fd, uint32_t events, void *context);
 
 class TCPComm {
  public:
-  explicit TCPComm(bool enable_ssl = false)
-      : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr), enable_ssl_(enable_ssl) {}
+  explicit TCPComm(bool enable_ssl = false, size_t event_loop_num = 1)
+      : server_fd_(-1), event_loop_num_(event_loop_num == 0 ? 1 : event_loop_num), enable_ssl_(enable_ssl) {}
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm() = default;
@@ -72,13 +72,29 @@ class TCPComm {
   // Set the message processing handler.
   void SetMessageHandler(const MessageHandler &handler);
 
+  // Set the allocator of the buffers which received message bodies go into.
+  void SetMessageAllocator(const MessageAllocator &allocator);
+
   // Get the file descriptor of server socket.
   int GetServerFd() const;
 
+  // Get the metrics of the receive and send event loops, one for each shard of connections.
+  void GetEventLoopMetrics(std::vector<EventLoopMetrics> *recv_metrics,
+                           std::vector<EventLoopMetrics> *send_metrics) const;
+
  private:
   // Build the connection.
   Connection *CreateDefaultConn(const std::string &to);
 
+  // Get the index of the shard which the connection to the url belongs to.
+  size_t GetEventLoopIndex(const std::string &url) const;
+
+  // Bind the connection to the event loops and the mutex of the shard.
+  void BindEventLoop(Connection *conn, size_t index);
+
+  // Release the event loops created.
+  void ReleaseEventLoops();
+
   // Send a message.
   static void SendExitMsg(const std::string &from, const std::string &to);
 
@@ -106,14 +122,21 @@ class TCPComm {
   // User defined handler for Handling received messages.
   MessageHandler message_handler_;
 
-  // All the connections share the same read and write event loop objects.
-  EventLoop *recv_event_loop_;
-  EventLoop *send_event_loop_;
+  // User defined allocator for the buffers of received messages.
+  MessageAllocator message_allocator_;
+
+  // The connections are sharded by the hash of their destination urls, each shard has its own read and write event
+  // loop threads and the mutex for the connections in it, so that the messages on different connections are sent,
+  // received and parsed in parallel. The server socket is handled by the read event loop of the first shard.
+  size_t event_loop_num_;
+  std::vector<EventLoop *> recv_event_loops_;
+  std::vector<EventLoop *> send_event_loops_;
+  std::vector<std::shared_ptr<std::mutex>> shard_mutexes_;
 
   // The connection pool used to store new connections.
   std::shared_ptr<ConnectionPool> conn_pool_;
 
-  // The mutex for connection operations.
+  // The mutex for connection operations like connecting and disconnecting, it is locked before the shard mutexes.
   std::shared_ptr<std::mutex> conn_mutex_;
 
   bool enable_ssl_;
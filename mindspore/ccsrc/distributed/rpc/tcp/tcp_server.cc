@@ -33,13 +33,21 @@ void TCPServer::Finalize() {
 
 void TCPServer::SetMessageHandler(const MessageHandler &handler) { tcp_comm_->SetMessageHandler(handler); }
 
+void TCPServer::SetMessageAllocator(const MessageAllocator &allocator) { tcp_comm_->SetMessageAllocator(allocator); }
+
+void TCPServer::GetEventLoopMetrics(std::vector<EventLoopMetrics> *recv_metrics,
+                                    std::vector<EventLoopMetrics> *send_metrics) const {
+  MS_EXCEPTION_IF_NULL(tcp_comm_);
+  tcp_comm_->GetEventLoopMetrics(recv_metrics, send_metrics);
+}
+
 std::string TCPServer::GetIP() const { return ip_; }
 
 uint32_t TCPServer::GetPort() const { return port_; }
 
 bool TCPServer::InitializeImpl(const std::string &url) {
   if (tcp_comm_ == nullptr) {
-    tcp_comm_ = std::make_unique<TCPComm>(enable_ssl_);
+    tcp_comm_ = std::make_unique<TCPComm>(enable_ssl_, event_loop_num_);
     MS_EXCEPTION_IF_NULL(tcp_comm_);
     bool rt = tcp_comm_->Initialize();
     if (!rt) {
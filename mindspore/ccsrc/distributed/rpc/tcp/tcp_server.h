@@ -19,6 +19,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "distributed/rpc/tcp/tcp_comm.h"
 #include "utils/ms_utils.h"
@@ -28,7 +29,8 @@ namespace distributed {
 namespace rpc {
 class TCPServer {
  public:
-  explicit TCPServer(bool enable_ssl = false) : enable_ssl_(enable_ssl) {}
+  explicit TCPServer(bool enable_ssl = false, size_t event_loop_num = 1)
+      : enable_ssl_(enable_ssl), event_loop_num_(event_loop_num) {}
   ~TCPServer() = default;
 
   // Init the tcp server using the specified url.
@@ -43,6 +45,13 @@ class TCPServer {
   // Set the message processing handler.
   void SetMessageHandler(const MessageHandler &handler);
 
+  // Set the allocator of the buffers which received message bodies go into.
+  void SetMessageAllocator(const MessageAllocator &allocator);
+
+  // Get the metrics of the receive and send event loops of the server.
+  void GetEventLoopMetrics(std::vector<EventLoopMetrics> *recv_metrics,
+                           std::vector<EventLoopMetrics> *send_metrics) const;
+
   // Return the IP and port binded by this server.
   std::string GetIP() const;
   uint32_t GetPort() const;
@@ -58,6 +67,9 @@ class TCPServer {
 
   bool enable_ssl_;
 
+  // The number of the event loop shards which the connections are handled by.
+  size_t event_loop_num_;
+
   DISABLE_COPY_AND_ASSIGN(TCPServer);
 };
 }  // namespace rpc
@@ -525,6 +525,10 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("replay_attack_time_diff", &PSContext::replay_attack_time_diff, "Get replay attack time diff.")
     .def("set_enable_ssl", &PSContext::set_enable_ssl, "Set PS SSL mode enabled or disabled.")
     .def("enable_ssl", &PSContext::enable_ssl, "Get PS SSL mode enabled or disabled.")
+    .def("set_rpc_event_loop_num", &PSContext::set_rpc_event_loop_num,
+         "Set the number of event loop threads of the rpc servers.")
+    .def("rpc_event_loop_num", &PSContext::rpc_event_loop_num,
+         "Get the number of event loop threads of the rpc servers.")
     .def("set_client_password", &PSContext::set_client_password, "Set the client password to decode the p12 file.")
     .def("client_password", &PSContext::client_password, "Get the client password to decode the p12 file.")
     .def("set_server_password", &PSContext::set_server_password, "Set the server password to decode the p12 file.")
@@ -19,6 +19,8 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include <string>
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace device {
@@ -42,6 +44,19 @@ bool AllReduceLauncher::Initialize() {
   MS_EXCEPTION_IF_NULL(cluster_ctx);
   node_role_ = cluster_ctx->node_role();
   rank_size_ = IntToSize(cluster_ctx->node_num(cluster_ctx->node_role()));
+
+  std::string compression = common::GetEnv(distributed::kEnvGradientCompression);
+  std::string ratio = common::GetEnv(distributed::kEnvGradientCompressionRatio);
+  float topk_ratio = kDefaultTopKRatio;
+  if (!ratio.empty()) {
+    TRY_AND_CATCH_WITH_EXCEPTION((topk_ratio = std::stof(ratio)),
+                                 "The environment variable " + std::string(distributed::kEnvGradientCompressionRatio) +
+                                   " is invalid: " + ratio);
+  }
+  compressor_ = GradientCompressor::Create(compression, topk_ratio);
+  if (compressor_ != nullptr) {
+    MS_LOG(INFO) << "The gradients of AllReduce are compressed by " << compression;
+  }
   return true;
 }
 
@@ -57,7 +72,8 @@ bool AllReduceLauncher::Finalize() {
   return true;
 }
 
-bool AllReduceLauncher::Execute(const void *input_data, void *const output_data, size_t data_size) const {
+bool AllReduceLauncher::Execute(const void *input_data, void *const output_data, size_t data_size,
+                                const std::string &data_name) const {
   MS_EXCEPTION_IF_NULL(input_data);
   MS_EXCEPTION_IF_NULL(output_data);
   // If node is scheduler, don't need to participate in the reduction.
@@ -69,6 +85,14 @@ bool AllReduceLauncher::Execute(const void *input_data, void *const output_data,
     MS_LOG(DEBUG) << "AllReduceLauncher executes ReduceBroadcastAllReduce algorithm on the rank " << rank_id_;
     return ReduceBroadcastAllReduce(input_data, output_data, data_size);
   }
+  if (compressor_ != nullptr && compressor_->elementwise()) {
+    MS_LOG(DEBUG) << "AllReduceLauncher executes CompressedRingAllReduce algorithm on the rank " << rank_id_;
+    return CompressedRingAllReduce(input_data, output_data, data_size);
+  }
+  if (compressor_ != nullptr) {
+    MS_LOG(DEBUG) << "AllReduceLauncher executes CompressedAllGatherAllReduce algorithm on the rank " << rank_id_;
+    return CompressedAllGatherAllReduce(input_data, output_data, data_size, data_name);
+  }
   // If the data number is not less than the node number, the RingAllReduce algorithm is used.
   MS_LOG(DEBUG) << "AllReduceLauncher executes RingAllReduce algorithm on the rank " << rank_id_;
   return RingAllReduce(input_data, output_data, data_size);
@@ -172,6 +196,142 @@ bool AllReduceLauncher::RingAllReduce(const void *input_data, void *const output
   return true;
 }
 
+bool AllReduceLauncher::CompressedRingAllReduce(const void *input_data, void *const output_data,
+                                                size_t data_size) const {
+  int memcpy_ret = memcpy_s(output_data, data_size, input_data, data_size);
+  if (memcpy_ret != EOK) {
+    MS_LOG(ERROR) << "CompressedRingAllReduce memcpy_s input_data error, errorno(" << memcpy_ret << ")";
+    return false;
+  }
+  size_t data_num = data_size / sizeof(float);
+  std::vector<size_t> chunk_sizes(rank_size_, data_num / rank_size_);
+  for (size_t i = 0; i < data_num % rank_size_; i++) {
+    chunk_sizes[i]++;
+  }
+  std::vector<size_t> chunk_offset(rank_size_, 0);
+  for (size_t i = 1; i < rank_size_; i++) {
+    chunk_offset[i] = chunk_offset[i - 1] + chunk_sizes[i - 1];
+  }
+
+  auto *output_buff = reinterpret_cast<float *>(output_data);
+  uint32_t send_to_rank = SizeToUint((rank_id_ + 1) % rank_size_);
+  uint32_t rec_from_rank = SizeToUint((rank_id_ - 1 + rank_size_) % rank_size_);
+  std::vector<uint8_t> send_buff;
+  // Compress the chunk and send it to the next rank, then receive the compressed chunk from the previous rank, which is
+  // decompressed and added into or copied to the chunk.
+  auto send_recv_chunk = [&](size_t send_chunk_index, size_t rec_chunk_index, bool reduce) -> bool {
+    size_t send_num = chunk_sizes[send_chunk_index];
+    send_buff.resize(compressor_->CompressedSize(send_num));
+    if (!compressor_->Compress(output_buff + chunk_offset[send_chunk_index], send_num, send_buff.data(),
+                               send_buff.size())) {
+      return false;
+    }
+    auto send_req_id =
+      abs_node_->CollectiveSendAsync(ps::core::NodeRole::WORKER, send_to_rank, send_buff.data(), send_buff.size());
+    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
+    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
+      MS_LOG(ERROR) << "CompressedRingAllReduce wait receiving " << rec_req_id << " failed.";
+      return false;
+    }
+    float *rec_chunk = output_buff + chunk_offset[rec_chunk_index];
+    size_t rec_num = chunk_sizes[rec_chunk_index];
+    bool ret = reduce ? compressor_->DecompressAdd(rec_ptr->data(), rec_ptr->size(), rec_num, rec_chunk)
+                      : compressor_->Decompress(rec_ptr->data(), rec_ptr->size(), rec_num, rec_chunk);
+    if (!ret) {
+      MS_LOG(ERROR) << "CompressedRingAllReduce decompresses the data from rank " << rec_from_rank << " failed.";
+      return false;
+    }
+    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
+      MS_LOG(ERROR) << "CompressedRingAllReduce wait sending " << send_req_id << " failed.";
+      return false;
+    }
+    return true;
+  };
+
+  // Ring ReduceScatter, after which the chunk 'rank_id_ + 1' is reduced on this rank.
+  for (size_t i = 0; i < rank_size_ - 1; i++) {
+    if (!send_recv_chunk((rank_id_ - i + rank_size_) % rank_size_, (rank_id_ - i - 1 + rank_size_) % rank_size_,
+                         true)) {
+      return false;
+    }
+  }
+
+  // The reduced chunk is rounded the same as the other ranks will get, so the results of all the ranks are identical.
+  size_t reduced_chunk_index = (rank_id_ + 1) % rank_size_;
+  float *reduced_chunk = output_buff + chunk_offset[reduced_chunk_index];
+  size_t reduced_num = chunk_sizes[reduced_chunk_index];
+  send_buff.resize(compressor_->CompressedSize(reduced_num));
+  if (!compressor_->Compress(reduced_chunk, reduced_num, send_buff.data(), send_buff.size()) ||
+      !compressor_->Decompress(send_buff.data(), send_buff.size(), reduced_num, reduced_chunk)) {
+    return false;
+  }
+
+  // Ring AllGather.
+  for (size_t i = 0; i < rank_size_ - 1; i++) {
+    if (!send_recv_chunk((rank_id_ - i + 1 + rank_size_) % rank_size_, (rank_id_ - i + rank_size_) % rank_size_,
+                         false)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AllReduceLauncher::CompressedAllGatherAllReduce(const void *input_data, void *const output_data,
+                                                     size_t data_size, const std::string &data_name) const {
+  size_t data_num = data_size / sizeof(float);
+  size_t compressed_size = compressor_->CompressedSize(data_num);
+  std::vector<uint8_t> gathered_data(compressed_size * rank_size_);
+  auto *input_buff = reinterpret_cast<const float *>(input_data);
+  auto *compressed_buff = gathered_data.data() + rank_id_ * compressed_size;
+  bool compressed = data_name.empty()
+                      ? compressor_->Compress(input_buff, data_num, compressed_buff, compressed_size)
+                      : compressor_->CompressWithErrorFeedback(data_name, input_buff, data_num, compressed_buff,
+                                                               compressed_size);
+  if (!compressed) {
+    MS_LOG(ERROR) << "CompressedAllGatherAllReduce compresses the input data failed.";
+    return false;
+  }
+
+  // Ring AllGather of the compressed data, the size of which is the same on all the ranks.
+  uint32_t send_to_rank = SizeToUint((rank_id_ + 1) % rank_size_);
+  uint32_t rec_from_rank = SizeToUint((rank_id_ - 1 + rank_size_) % rank_size_);
+  for (size_t i = 0; i < rank_size_ - 1; i++) {
+    size_t send_index = (rank_id_ - i + rank_size_) % rank_size_;
+    auto send_req_id = abs_node_->CollectiveSendAsync(
+      ps::core::NodeRole::WORKER, send_to_rank, gathered_data.data() + send_index * compressed_size, compressed_size);
+    std::shared_ptr<std::vector<unsigned char>> rec_ptr = nullptr;
+    auto rec_req_id = abs_node_->CollectiveReceiveAsync(ps::core::NodeRole::WORKER, rec_from_rank, &rec_ptr);
+    if (!abs_node_->CollectiveWait(rec_req_id, kWaitTimeout)) {
+      MS_LOG(ERROR) << "CompressedAllGatherAllReduce wait receiving " << rec_req_id << " failed.";
+      return false;
+    }
+    size_t rec_index = (rank_id_ - i - 1 + rank_size_) % rank_size_;
+    int memcpy_ret = memcpy_s(gathered_data.data() + rec_index * compressed_size, compressed_size, rec_ptr->data(),
+                              rec_ptr->size());
+    if (memcpy_ret != EOK) {
+      MS_LOG(ERROR) << "CompressedAllGatherAllReduce memcpy_s received data error, errorno(" << memcpy_ret << ")";
+      return false;
+    }
+    if (!abs_node_->Wait(send_req_id, kWaitTimeout)) {
+      MS_LOG(ERROR) << "CompressedAllGatherAllReduce wait sending " << send_req_id << " failed.";
+      return false;
+    }
+  }
+
+  // Decompress and accumulate in the order of the ranks, so the results of all the ranks are identical.
+  auto *output_buff = reinterpret_cast<float *>(output_data);
+  std::fill_n(output_buff, data_num, 0.0f);
+  for (size_t rank = 0; rank < rank_size_; rank++) {
+    if (!compressor_->DecompressAdd(gathered_data.data() + rank * compressed_size, compressed_size, data_num,
+                                    output_buff)) {
+      MS_LOG(ERROR) << "CompressedAllGatherAllReduce decompresses the data of rank " << rank << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 std::shared_ptr<ps::core::CollectiveNode> AllReduceLauncher::collective_node() { return abs_node_; }
 
 bool AllReduceLauncher::ReduceBroadcastAllReduce(const void *input_data, void *const output_data,
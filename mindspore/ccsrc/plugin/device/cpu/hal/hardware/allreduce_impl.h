@@ -21,6 +21,7 @@
 #include <memory>
 #include "distributed/cluster/cluster_context.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
+#include "plugin/device/cpu/hal/hardware/gradient_compressor.h"
 
 namespace mindspore {
 namespace device {
@@ -35,18 +36,34 @@ class AllReduceLauncher {
   bool Initialize();
   bool Finalize();
 
-  bool Execute(const void *input_data, void *const output_data, size_t data_size) const;
+  // The 'data_name' identifies the data across steps, such as the name of the AllReduce node, which keys the error
+  // feedback of the gradient compression. The error feedback is disabled if it is empty.
+  bool Execute(const void *input_data, void *const output_data, size_t data_size,
+               const std::string &data_name = "") const;
 
   std::shared_ptr<ps::core::CollectiveNode> collective_node();
 
+  // Whether the gradients of AllReduce are compressed.
+  bool compressed() const { return compressor_ != nullptr; }
+
  private:
   size_t rank_id_{0};
   size_t rank_size_{0};
   std::string node_role_{distributed::kEnvRoleOfWorker};
   std::shared_ptr<ps::core::CollectiveNode> abs_node_{nullptr};
+  // The compressor of the gradients, which is created by the environment variable MS_GRADIENT_COMPRESSION.
+  std::unique_ptr<GradientCompressor> compressor_{nullptr};
 
   bool RingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
   bool ReduceBroadcastAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+
+  // The RingAllReduce which sends every chunk compressed by an element-wise compressor and accumulates the received
+  // chunks in float32.
+  bool CompressedRingAllReduce(const void *input_data, void *const output_data, size_t data_size) const;
+  // Compress the whole data with error feedback, gather the compressed data of all the ranks along the ring, and then
+  // decompress and accumulate them on every rank.
+  bool CompressedAllGatherAllReduce(const void *input_data, void *const output_data, size_t data_size,
+                                    const std::string &data_name) const;
 };
 }  // namespace cpu
 }  // namespace device
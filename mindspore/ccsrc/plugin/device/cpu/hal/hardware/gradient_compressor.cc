@@ -0,0 +1,267 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/gradient_compressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kBitsPerByte = 8;
+constexpr uint32_t kBf16Shift = 16;
+
+uint16_t FloatToBf16(float value) {
+  uint32_t bits = 0;
+  (void)std::copy_n(reinterpret_cast<const char *>(&value), sizeof(bits), reinterpret_cast<char *>(&bits));
+  if (std::isnan(value)) {
+    // Keep NaN a quiet NaN after the mantissa is truncated.
+    constexpr uint32_t kQuietNaNBit = 0x40;
+    return static_cast<uint16_t>((bits >> kBf16Shift) | kQuietNaNBit);
+  }
+  // Round to the nearest even.
+  constexpr uint32_t kRoundingBias = 0x7FFF;
+  bits += kRoundingBias + ((bits >> kBf16Shift) & 1);
+  return static_cast<uint16_t>(bits >> kBf16Shift);
+}
+
+float Bf16ToFloat(uint16_t value) {
+  uint32_t bits = static_cast<uint32_t>(value) << kBf16Shift;
+  float result = 0;
+  (void)std::copy_n(reinterpret_cast<const char *>(&bits), sizeof(bits), reinterpret_cast<char *>(&result));
+  return result;
+}
+
+bool CheckSize(size_t expected, size_t size) {
+  if (expected != size) {
+    MS_LOG(ERROR) << "The size of the compressed data should be " << expected << ", but got " << size;
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+std::unique_ptr<GradientCompressor> GradientCompressor::Create(const std::string &type, float ratio) {
+  if (type.empty() || type == kGradientCompressionNone) {
+    return nullptr;
+  }
+  if (type == kGradientCompressionFp16) {
+    return std::make_unique<Fp16Compressor>();
+  }
+  if (type == kGradientCompressionBf16) {
+    return std::make_unique<Bf16Compressor>();
+  }
+  if (type == kGradientCompressionTopK) {
+    if (ratio <= 0 || ratio > 1) {
+      MS_LOG(EXCEPTION) << "The ratio of top-k gradient compression should be in (0, 1], but got " << ratio;
+    }
+    return std::make_unique<TopKCompressor>(ratio);
+  }
+  if (type == kGradientCompressionOneBit) {
+    return std::make_unique<OneBitCompressor>();
+  }
+  MS_LOG(EXCEPTION) << "Invalid gradient compression type: " << type << ", which should be one of "
+                    << kGradientCompressionNone << ", " << kGradientCompressionFp16 << ", " << kGradientCompressionBf16
+                    << ", " << kGradientCompressionTopK << " and " << kGradientCompressionOneBit;
+}
+
+bool GradientCompressor::Decompress(const void *input, size_t input_size, size_t count, float *output) const {
+  std::fill_n(output, count, 0.0f);
+  return DecompressAdd(input, input_size, count, output);
+}
+
+bool GradientCompressor::CompressWithErrorFeedback(const std::string &name, const float *input, size_t count,
+                                                   void *output, size_t output_size) {
+  std::lock_guard<std::mutex> lock(residuals_mutex_);
+  auto &residual = residuals_[name];
+  if (residual.size() != count) {
+    if (!residual.empty()) {
+      MS_LOG(INFO) << "The element number of the gradients " << name << " changes from " << residual.size() << " to "
+                   << count << ", the compression error of them is dropped.";
+    }
+    residual.assign(count, 0.0f);
+  }
+  // The residual is the gradient to be compressed, and then the compression error of it.
+  for (size_t i = 0; i < count; i++) {
+    residual[i] += input[i];
+  }
+  if (!Compress(residual.data(), count, output, output_size)) {
+    return false;
+  }
+  std::vector<float> decompressed(count, 0.0f);
+  if (!DecompressAdd(output, output_size, count, decompressed.data())) {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    residual[i] -= decompressed[i];
+  }
+  return true;
+}
+
+size_t Fp16Compressor::CompressedSize(size_t count) const { return count * sizeof(float16); }
+
+bool Fp16Compressor::Compress(const float *input, size_t count, void *output, size_t output_size) const {
+  if (!CheckSize(CompressedSize(count), output_size)) {
+    return false;
+  }
+  auto *data = reinterpret_cast<float16 *>(output);
+  for (size_t i = 0; i < count; i++) {
+    data[i] = float16(input[i]);
+  }
+  return true;
+}
+
+bool Fp16Compressor::DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const {
+  if (!CheckSize(CompressedSize(count), input_size)) {
+    return false;
+  }
+  const auto *data = reinterpret_cast<const float16 *>(input);
+  for (size_t i = 0; i < count; i++) {
+    output[i] += static_cast<float>(data[i]);
+  }
+  return true;
+}
+
+size_t Bf16Compressor::CompressedSize(size_t count) const { return count * sizeof(uint16_t); }
+
+bool Bf16Compressor::Compress(const float *input, size_t count, void *output, size_t output_size) const {
+  if (!CheckSize(CompressedSize(count), output_size)) {
+    return false;
+  }
+  auto *data = reinterpret_cast<uint16_t *>(output);
+  for (size_t i = 0; i < count; i++) {
+    data[i] = FloatToBf16(input[i]);
+  }
+  return true;
+}
+
+bool Bf16Compressor::DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const {
+  if (!CheckSize(CompressedSize(count), input_size)) {
+    return false;
+  }
+  const auto *data = reinterpret_cast<const uint16_t *>(input);
+  for (size_t i = 0; i < count; i++) {
+    output[i] += Bf16ToFloat(data[i]);
+  }
+  return true;
+}
+
+size_t TopKCompressor::TopKNum(size_t count) const {
+  if (count == 0) {
+    return 0;
+  }
+  auto k = static_cast<size_t>(std::ceil(static_cast<double>(count) * ratio_));
+  return std::min(count, std::max(static_cast<size_t>(1), k));
+}
+
+// The compressed data is the indices of the top-k elements followed by the values of them.
+size_t TopKCompressor::CompressedSize(size_t count) const {
+  return TopKNum(count) * (sizeof(uint32_t) + sizeof(float));
+}
+
+bool TopKCompressor::Compress(const float *input, size_t count, void *output, size_t output_size) const {
+  if (!CheckSize(CompressedSize(count), output_size)) {
+    return false;
+  }
+  if (count > UINT32_MAX) {
+    MS_LOG(ERROR) << "The element number " << count << " exceeds the max index of top-k compression.";
+    return false;
+  }
+  size_t k = TopKNum(count);
+  if (k == 0) {
+    return true;
+  }
+  std::vector<uint32_t> indices(count);
+  std::iota(indices.begin(), indices.end(), 0);
+  std::nth_element(indices.begin(), indices.begin() + SizeToLong(k) - 1, indices.end(),
+                   [input](uint32_t a, uint32_t b) { return std::fabs(input[a]) > std::fabs(input[b]); });
+  auto *index_data = reinterpret_cast<uint32_t *>(output);
+  auto *value_data = reinterpret_cast<float *>(index_data + k);
+  for (size_t i = 0; i < k; i++) {
+    index_data[i] = indices[i];
+    value_data[i] = input[indices[i]];
+  }
+  return true;
+}
+
+bool TopKCompressor::DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const {
+  if (!CheckSize(CompressedSize(count), input_size)) {
+    return false;
+  }
+  size_t k = TopKNum(count);
+  const auto *index_data = reinterpret_cast<const uint32_t *>(input);
+  const auto *value_data = reinterpret_cast<const float *>(index_data + k);
+  for (size_t i = 0; i < k; i++) {
+    if (index_data[i] >= count) {
+      MS_LOG(ERROR) << "The index " << index_data[i] << " of top-k compressed data is out of range " << count;
+      return false;
+    }
+    output[index_data[i]] += value_data[i];
+  }
+  return true;
+}
+
+// The compressed data is the scales of the blocks followed by the sign bits, 1 for non-negative.
+size_t OneBitCompressor::CompressedSize(size_t count) const {
+  size_t block_num = (count + kOneBitBlockSize - 1) / kOneBitBlockSize;
+  return block_num * sizeof(float) + (count + kBitsPerByte - 1) / kBitsPerByte;
+}
+
+bool OneBitCompressor::Compress(const float *input, size_t count, void *output, size_t output_size) const {
+  if (!CheckSize(CompressedSize(count), output_size)) {
+    return false;
+  }
+  size_t block_num = (count + kOneBitBlockSize - 1) / kOneBitBlockSize;
+  auto *scales = reinterpret_cast<float *>(output);
+  auto *bits = reinterpret_cast<uint8_t *>(scales + block_num);
+  std::fill_n(bits, (count + kBitsPerByte - 1) / kBitsPerByte, 0);
+  for (size_t block = 0; block < block_num; block++) {
+    size_t begin = block * kOneBitBlockSize;
+    size_t end = std::min(count, begin + kOneBitBlockSize);
+    float sum = 0;
+    for (size_t i = begin; i < end; i++) {
+      sum += std::fabs(input[i]);
+      if (input[i] >= 0) {
+        bits[i / kBitsPerByte] |= static_cast<uint8_t>(1 << (i % kBitsPerByte));
+      }
+    }
+    scales[block] = sum / static_cast<float>(end - begin);
+  }
+  return true;
+}
+
+bool OneBitCompressor::DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const {
+  if (!CheckSize(CompressedSize(count), input_size)) {
+    return false;
+  }
+  size_t block_num = (count + kOneBitBlockSize - 1) / kOneBitBlockSize;
+  const auto *scales = reinterpret_cast<const float *>(input);
+  const auto *bits = reinterpret_cast<const uint8_t *>(scales + block_num);
+  for (size_t i = 0; i < count; i++) {
+    float scale = scales[i / kOneBitBlockSize];
+    output[i] += ((bits[i / kBitsPerByte] >> (i % kBitsPerByte)) & 1) != 0 ? scale : -scale;
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
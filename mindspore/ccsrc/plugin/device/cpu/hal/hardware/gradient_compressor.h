@@ -0,0 +1,123 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_GRADIENT_COMPRESSOR_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_GRADIENT_COMPRESSOR_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The names of the gradient compression types, which are set by the environment variable MS_GRADIENT_COMPRESSION.
+constexpr char kGradientCompressionNone[] = "none";
+constexpr char kGradientCompressionFp16[] = "fp16";
+constexpr char kGradientCompressionBf16[] = "bf16";
+constexpr char kGradientCompressionTopK[] = "topk";
+constexpr char kGradientCompressionOneBit[] = "onebit";
+
+// The default ratio of the elements kept by top-k sparsification.
+constexpr float kDefaultTopKRatio = 0.01;
+// The number of elements sharing one scale in 1-bit quantization.
+constexpr size_t kOneBitBlockSize = 512;
+
+// GradientCompressor compresses the float32 gradients before they are sent by the cpu collective communication and
+// decompresses the received ones. The compressed data of different ranks can not be added, so it is decompressed and
+// accumulated in float32.
+class GradientCompressor {
+ public:
+  GradientCompressor() = default;
+  virtual ~GradientCompressor() = default;
+
+  // Create the compressor of the type, nullptr is returned for the type 'none' or empty.
+  static std::unique_ptr<GradientCompressor> Create(const std::string &type, float ratio = kDefaultTopKRatio);
+
+  // The byte size of the compressed data of 'count' elements.
+  virtual size_t CompressedSize(size_t count) const = 0;
+
+  // Compress 'count' elements of 'input' into 'output', the size of which should be 'CompressedSize(count)'.
+  virtual bool Compress(const float *input, size_t count, void *output, size_t output_size) const = 0;
+
+  // Decompress the data compressed from 'count' elements and add it into 'output'.
+  virtual bool DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const = 0;
+
+  // Whether the compression is element-wise, e.g. casting, so that the gradients can be compressed and reduced chunk by
+  // chunk along the ring. Otherwise the compressed gradients of all the ranks are gathered and reduced on every rank.
+  virtual bool elementwise() const { return false; }
+
+  // Decompress the data compressed from 'count' elements and overwrite 'output'.
+  bool Decompress(const void *input, size_t input_size, size_t count, float *output) const;
+
+  // Compress with error feedback: the compression error of the gradients named 'name' is kept and added to the
+  // gradients of the same name the next time, so the information dropped is delayed rather than lost. The error is
+  // dropped if the element number of the gradients changes.
+  bool CompressWithErrorFeedback(const std::string &name, const float *input, size_t count, void *output,
+                                 size_t output_size);
+
+ private:
+  // The compression errors of the gradients, keyed by the name of them, such as the name of the AllReduce node.
+  std::map<std::string, std::vector<float>> residuals_;
+  std::mutex residuals_mutex_;
+};
+
+// Cast float32 to float16, which halves the data size.
+class Fp16Compressor : public GradientCompressor {
+ public:
+  size_t CompressedSize(size_t count) const override;
+  bool Compress(const float *input, size_t count, void *output, size_t output_size) const override;
+  bool DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const override;
+  bool elementwise() const override { return true; }
+};
+
+// Cast float32 to bfloat16, which halves the data size and keeps the range of float32.
+class Bf16Compressor : public GradientCompressor {
+ public:
+  size_t CompressedSize(size_t count) const override;
+  bool Compress(const float *input, size_t count, void *output, size_t output_size) const override;
+  bool DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const override;
+  bool elementwise() const override { return true; }
+};
+
+// Keep the 'ratio' of the elements with the largest magnitudes as pairs of index and value.
+class TopKCompressor : public GradientCompressor {
+ public:
+  explicit TopKCompressor(float ratio) : ratio_(ratio) {}
+  size_t CompressedSize(size_t count) const override;
+  bool Compress(const float *input, size_t count, void *output, size_t output_size) const override;
+  bool DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const override;
+
+ private:
+  size_t TopKNum(size_t count) const;
+
+  float ratio_;
+};
+
+// Keep the sign of every element as one bit, and the mean magnitude of every block of kOneBitBlockSize elements as the
+// scale of the block.
+class OneBitCompressor : public GradientCompressor {
+ public:
+  size_t CompressedSize(size_t count) const override;
+  bool Compress(const float *input, size_t count, void *output, size_t output_size) const override;
+  bool DecompressAdd(const void *input, size_t input_size, size_t count, float *output) const override;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_GRADIENT_COMPRESSOR_H_
@@ -48,6 +48,17 @@ bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_
 
   cgn_ = std::dynamic_pointer_cast<distributed::cluster::topology::ComputeGraphNode>(
     ClusterContext::instance()->node_base());
+  // The scheduler does not participate in the collective operations.
+  if (cgn_ != nullptr) {
+    topo_node_ = std::make_shared<TopologyNode>(global_rank_size, cgn_);
+    if (!topo_node_->Initialize() || !topo_node_->Initialized()) {
+      MS_LOG(EXCEPTION) << "Failed to initialize the topology node of the cpu collective communication.";
+    }
+    collective_ops_impl_ = std::make_unique<MSCollectiveOpsImpl>(topo_node_);
+    if (!collective_ops_impl_->Initialize()) {
+      MS_LOG(EXCEPTION) << "Failed to initialize the cpu collective operations.";
+    }
+  }
 
   global_rank_id_ = global_rank;
   global_rank_size_ = global_rank_size;
@@ -57,6 +68,11 @@ bool MsCollectiveCommLib::Initialize(uint32_t global_rank, uint32_t global_rank_
 }
 
 bool MsCollectiveCommLib::Finalize() {
+  if (topo_node_ != nullptr && !topo_node_->Finalize()) {
+    MS_LOG(WARNING) << "Failed to finalize the topology node of the cpu collective communication.";
+  }
+  collective_ops_impl_.reset();
+  topo_node_.reset();
   if (launcher_ != nullptr) {
     return launcher_->Finalize();
   }
@@ -190,6 +206,12 @@ bool MsCollectiveCommLib::QueryUniqueID(const std::string &group_name, size_t ro
 
 bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
                                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  return AllReduce("", send_buff, recv_buff, send_count, data_type, reduce_op, group_name);
+}
+
+bool MsCollectiveCommLib::AllReduce(const std::string &data_name, const void *send_buff, void *recv_buff,
+                                    size_t send_count, TypeId data_type, CollectiveOpReduceType reduce_op,
+                                    const std::string &group_name) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
   CHECK_IF_NULL(node_);
@@ -199,8 +221,71 @@ bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size
   if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
     MS_LOG(EXCEPTION) << "AllReduce only support reduce sum.";
   }
-  bool ret = launcher_->Execute(send_buff, recv_buff, send_count);
-  return ret;
+  // The compression of the gradients is implemented by the launcher only.
+  if (collective_ops_impl_ == nullptr || launcher_->compressed()) {
+    return launcher_->Execute(send_buff, recv_buff, send_count, data_name);
+  }
+  if (group_name != global_group_name_) {
+    MS_LOG(ERROR) << "AllReduce only support the group " << global_group_name_ << ", but got " << group_name;
+    return false;
+  }
+  // The 'send_count' of AllReduce is the byte size of the data, as the launcher takes it.
+  return collective_ops_impl_->AllReduce<float>(data_name, const_cast<void *>(send_buff), recv_buff,
+                                                send_count / sizeof(float));
+}
+
+bool MsCollectiveCommLib::ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
+                                        CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(collective_ops_impl_);
+  if (reduce_op != CollectiveOpReduceType::Reduce_Sum) {
+    MS_LOG(ERROR) << "ReduceScatter only support reduce sum.";
+    return false;
+  }
+  if (group_name != global_group_name_) {
+    MS_LOG(ERROR) << "ReduceScatter only support the group " << global_group_name_ << ", but got " << group_name;
+    return false;
+  }
+
+  switch (data_type) {
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return collective_ops_impl_->ReduceScatter<int>(send_buff, recv_buff, recv_count);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return collective_ops_impl_->ReduceScatter<float>(send_buff, recv_buff, recv_count);
+    default:
+      MS_LOG(ERROR) << "ReduceScatter does not support the data type " << TypeIdLabel(data_type);
+      return false;
+  }
+}
+
+bool MsCollectiveCommLib::AllToAll(const void *send_buff, void *recv_buff, size_t count, TypeId data_type,
+                                   const std::string &group_name) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(collective_ops_impl_);
+  if (group_name != global_group_name_) {
+    MS_LOG(ERROR) << "AllToAll only support the group " << global_group_name_ << ", but got " << group_name;
+    return false;
+  }
+
+  switch (data_type) {
+    case TypeId::kNumberTypeInt8:
+      return collective_ops_impl_->AllToAll<char>(send_buff, recv_buff, count);
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return collective_ops_impl_->AllToAll<int>(send_buff, recv_buff, count);
+    case TypeId::kNumberTypeUInt64:
+      return collective_ops_impl_->AllToAll<uint64_t>(send_buff, recv_buff, count);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return collective_ops_impl_->AllToAll<float>(send_buff, recv_buff, count);
+    default:
+      MS_LOG(ERROR) << "AllToAll does not support the data type " << TypeIdLabel(data_type);
+      return false;
+  }
 }
 
 bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
@@ -238,7 +323,7 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   }
 
   auto group = groups_[group_name];
-  CommunicationGroupInfo group_info = {};
+  fl::server::CommunicationGroupInfo group_info = {};
   group_info.size = group->group_size();
   group_info.global_rank = global_rank_id_;
   group_info.group_ranks = group->group_ranks();
@@ -26,6 +26,8 @@
 #include "fl/server/collective_ops_impl.h"
 #include "plugin/device/cpu/hal/hardware/ms_collective_node.h"
 #include "plugin/device/cpu/hal/hardware/allreduce_impl.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_topo.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
 #include "distributed/cluster/topology/compute_graph_node.h"
 
 namespace mindspore {
@@ -34,7 +36,7 @@ namespace cpu {
 constexpr char kMCCLGlobalGroupName[] = "mccl_world_group";
 using ClusterContext = mindspore::distributed::cluster::ClusterContext;
 using CollectiveOpsImpl = mindspore::fl::server::CollectiveOpsImpl;
-using CommunicationGroupInfo = mindspore::fl::server::CommunicationGroupInfo;
+using MSCollectiveOpsImplPtr = std::unique_ptr<MSCollectiveOpsImpl>;
 using ps::core::NodeCommand;
 
 // The time interval for send info or query info between worker and scheduler.
@@ -64,13 +66,20 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
   bool AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
                  CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
 
+  // AllReduce the data named 'data_name', such as the name of the AllReduce node. The name identifies the data across
+  // steps, which keys the error feedback of the gradient compression.
+  bool AllReduce(const std::string &data_name, const void *send_buff, void *recv_buff, size_t send_count,
+                 TypeId data_type, CollectiveOpReduceType reduce_op, const std::string &group_name);
+
   bool Broadcast(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type, uint32_t root_rank,
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
-                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
+
+  // Every rank sends the i-th 'count' elements of the 'send_buff' to rank i, and receives the ones from rank i into the
+  // i-th 'count' elements of the 'recv_buff'.
+  bool AllToAll(const void *send_buff, void *recv_buff, size_t count, TypeId data_type, const std::string &group_name);
 
  private:
   MsCollectiveCommLib();
@@ -89,6 +98,11 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
 
   std::unique_ptr<AllReduceLauncher> launcher_;
 
+  // The topology node connects the ranks by tcp directly, on which the AllReduce, ReduceScatter and AllToAll run.
+  // The AllReduce algorithm is selected by the data size and the hosts of the ranks.
+  std::shared_ptr<TopologyNode> topo_node_;
+  MSCollectiveOpsImplPtr collective_ops_impl_;
+
   // Indicates whether the collective node has to synchronize the addresses of all the collective nodes.
   bool synchronized_{true};
 };
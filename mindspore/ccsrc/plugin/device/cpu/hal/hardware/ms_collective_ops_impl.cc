@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <numeric>
 #include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
 #include "distributed/cluster/cluster_context.h"
@@ -27,6 +28,27 @@ const char kCollectivePhaseRing[] = "ring";
 const char kCollectivePhaseGather[] = "gather";
 const char kCollectivePhaseReduce[] = "reduce";
 const char kCollectivePhaseBroadcast[] = "broadcast";
+
+// Split 'count' elements into 'chunk_num' chunks as evenly as possible.
+void SplitChunks(size_t count, size_t chunk_num, std::vector<size_t> *chunk_offsets, std::vector<size_t> *chunk_sizes) {
+  chunk_sizes->assign(chunk_num, count / chunk_num);
+  for (size_t i = 0; i < count % chunk_num; i++) {
+    (*chunk_sizes)[i]++;
+  }
+  chunk_offsets->assign(chunk_num, 0);
+  for (size_t i = 1; i < chunk_num; i++) {
+    (*chunk_offsets)[i] = (*chunk_offsets)[i - 1] + (*chunk_sizes)[i - 1];
+  }
+}
+
+// The largest power of two which is not greater than n.
+size_t FloorPowerOfTwo(size_t n) {
+  size_t pof2 = 1;
+  while (pof2 * 2 <= n) {
+    pof2 *= 2;
+  }
+  return pof2;
+}
 }  // namespace
 
 bool MSCollectiveOpsImpl::Initialize() {
@@ -35,6 +57,497 @@ bool MSCollectiveOpsImpl::Initialize() {
   return true;
 }
 
+uint32_t MSCollectiveOpsImpl::GetTimeout() const {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // If enable recovery, set timeout 300s to prevent networking flapping.
+  return context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::SendRecv(uint32_t send_to_rank, const T *send_data, size_t send_count,
+                                   uint32_t recv_from_rank, T *recv_data, size_t recv_count, bool reduce) {
+  if (!topo_node_->SendAsync(send_to_rank, const_cast<T *>(send_data), send_count * sizeof(T))) {
+    MS_LOG(ERROR) << "Failed to send data to rank " << send_to_rank;
+    return false;
+  }
+
+  MessageBase *message = nullptr;
+  if (!topo_node_->Receive(recv_from_rank, &message, GetTimeout())) {
+    MS_LOG(ERROR) << "Failed to receive data from rank " << recv_from_rank;
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(message);
+  std::unique_ptr<MessageBase> message_ptr(message);
+  if (message->body.length() != recv_count * sizeof(T)) {
+    MS_LOG(ERROR) << "The size of the data received from rank " << recv_from_rank << " is " << message->body.length()
+                  << ", but " << (recv_count * sizeof(T)) << " is expected.";
+    return false;
+  }
+  if (reduce) {
+    // The body of the message is not necessarily aligned.
+    std::vector<T> recv_buff(recv_count);
+    (void)std::copy(message->body.begin(), message->body.end(), reinterpret_cast<char *>(recv_buff.data()));
+    for (size_t i = 0; i < recv_count; i++) {
+      recv_data[i] += recv_buff[i];
+    }
+  } else if (recv_count > 0) {
+    (void)std::copy(message->body.begin(), message->body.end(), reinterpret_cast<char *>(recv_data));
+  }
+
+  if (!topo_node_->WaitForSend(send_to_rank)) {
+    MS_LOG(ERROR) << "Failed to send data to rank: " << send_to_rank;
+    return false;
+  }
+  return true;
+}
+
+void MSCollectiveOpsImpl::InitHostRanks() {
+  if (!host_ranks_.empty()) {
+    return;
+  }
+  std::vector<std::string> host_ips;
+  for (uint32_t rank = 0; rank < rank_size_; rank++) {
+    auto address = topo_node_->GetNodeAddress(rank);
+    auto ip = address.substr(0, address.rfind(':'));
+    auto iter = std::find(host_ips.begin(), host_ips.end(), ip);
+    size_t host_index = LongToSize(std::distance(host_ips.begin(), iter));
+    if (iter == host_ips.end()) {
+      host_ips.push_back(ip);
+      host_ranks_.emplace_back();
+    }
+    host_ranks_[host_index].push_back(rank);
+    if (rank == rank_id_) {
+      host_index_ = host_index;
+    }
+  }
+  MS_LOG(INFO) << "The " << rank_size_ << " ranks are on " << host_ranks_.size() << " hosts.";
+}
+
+AllReduceAlgo MSCollectiveOpsImpl::SelectAllReduceAlgo(size_t data_size) {
+  if (allreduce_algo_ != AllReduceAlgo::kAuto) {
+    return allreduce_algo_;
+  }
+  // Only the traffic among hosts goes through network if there are multiple ranks on a host.
+  InitHostRanks();
+  if (host_ranks_.size() > 1 && host_ranks_.size() < rank_size_) {
+    return AllReduceAlgo::kHierarchical;
+  }
+  if (data_size <= kRecursiveDoublingMaxSize) {
+    return AllReduceAlgo::kRecursiveDoubling;
+  }
+  if (FloorPowerOfTwo(rank_size_) == rank_size_ || data_size <= kHalvingDoublingMaxSize) {
+    return AllReduceAlgo::kHalvingDoubling;
+  }
+  return AllReduceAlgo::kRing;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  // Initialize collective communication parameters.
+  rank_id_ = topo_node_->rank_id();
+  rank_size_ = topo_node_->rank_size();
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  if (count == 0) {
+    return true;
+  }
+  if (recvbuff != sendbuff) {
+    size_t data_size = count * sizeof(T);
+    int ret = memcpy_s(recvbuff, data_size, sendbuff, data_size);
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (rank_size_ == 1) {
+    MS_LOG(INFO) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+
+  AllReduceAlgo algo = SelectAllReduceAlgo(count * sizeof(T));
+  MS_LOG(DEBUG) << "AllReduce " << data_name << " count:" << count << ", rank_size:" << rank_size_
+                << ", algorithm:" << static_cast<int>(algo);
+  T *buff = reinterpret_cast<T *>(recvbuff);
+  if (algo == AllReduceAlgo::kHierarchical) {
+    return HierarchicalAllReduce(buff, count);
+  }
+  std::vector<uint32_t> ranks(rank_size_);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  return FlatAllReduce(algo, buff, count, ranks, rank_id_);
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::FlatAllReduce(AllReduceAlgo algo, T *buff, size_t count, const std::vector<uint32_t> &ranks,
+                                        size_t index) {
+  if (ranks.size() <= 1) {
+    return true;
+  }
+  switch (algo) {
+    case AllReduceAlgo::kRing:
+      return RingAllReduce(buff, count, ranks, index);
+    case AllReduceAlgo::kRecursiveDoubling:
+      return RecursiveDoublingAllReduce(buff, count, ranks, index);
+    case AllReduceAlgo::kHalvingDoubling:
+      return HalvingDoublingAllReduce(buff, count, ranks, index);
+    default:
+      MS_LOG(ERROR) << "Invalid flat AllReduce algorithm " << static_cast<int>(algo);
+      return false;
+  }
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RingReduceScatter(T *buff, const std::vector<size_t> &chunk_offsets,
+                                            const std::vector<size_t> &chunk_sizes, const std::vector<uint32_t> &ranks,
+                                            size_t index) {
+  size_t size = ranks.size();
+  uint32_t send_to_rank = ranks[(index + 1) % size];
+  uint32_t recv_from_rank = ranks[(index - 1 + size) % size];
+  // In step i, the chunk 'index - i - 1' is sent and the chunk 'index - i - 2' is received and reduced, so that the
+  // chunk 'index' is the last one reduced on this process.
+  for (size_t i = 0; i < size - 1; i++) {
+    size_t send_chunk_index = (index - i - 1 + 2 * size) % size;
+    size_t recv_chunk_index = (index - i - 2 + 2 * size) % size;
+    if (!SendRecv(send_to_rank, buff + chunk_offsets[send_chunk_index], chunk_sizes[send_chunk_index], recv_from_rank,
+                  buff + chunk_offsets[recv_chunk_index], chunk_sizes[recv_chunk_index], true)) {
+      MS_LOG(ERROR) << "Ring ReduceScatter failed in step " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RingAllReduce(T *buff, size_t count, const std::vector<uint32_t> &ranks, size_t index) {
+  size_t size = ranks.size();
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(count, size, &chunk_offsets, &chunk_sizes);
+  if (!RingReduceScatter(buff, chunk_offsets, chunk_sizes, ranks, index)) {
+    return false;
+  }
+
+  // Ring AllGather, in step i the chunk 'index - i' is sent and the chunk 'index - i - 1' is received.
+  uint32_t send_to_rank = ranks[(index + 1) % size];
+  uint32_t recv_from_rank = ranks[(index - 1 + size) % size];
+  for (size_t i = 0; i < size - 1; i++) {
+    size_t send_chunk_index = (index - i + size) % size;
+    size_t recv_chunk_index = (index - i - 1 + size) % size;
+    if (!SendRecv(send_to_rank, buff + chunk_offsets[send_chunk_index], chunk_sizes[send_chunk_index], recv_from_rank,
+                  buff + chunk_offsets[recv_chunk_index], chunk_sizes[recv_chunk_index], false)) {
+      MS_LOG(ERROR) << "Ring AllGather failed in step " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::RecursiveDoublingAllReduce(T *buff, size_t count, const std::vector<uint32_t> &ranks,
+                                                     size_t index) {
+  // The ranks beyond the largest power of two are folded: the first '2 * rem' ranks are paired, the even one of each
+  // pair sends its data to the odd one and waits for the result.
+  size_t size = ranks.size();
+  size_t pof2 = FloorPowerOfTwo(size);
+  size_t rem = size - pof2;
+  if (index < 2 * rem && index % 2 == 0) {
+    return SendRecv(ranks[index + 1], buff, count, ranks[index + 1], buff, count, false);
+  }
+  std::vector<T> recv_buff;
+  if (index < 2 * rem) {
+    recv_buff.resize(count);
+    MessageBase *message = nullptr;
+    if (!topo_node_->Receive(ranks[index - 1], &message, GetTimeout())) {
+      MS_LOG(ERROR) << "Failed to receive data from rank " << ranks[index - 1];
+      return false;
+    }
+    MS_EXCEPTION_IF_NULL(message);
+    std::unique_ptr<MessageBase> message_ptr(message);
+    if (message->body.length() != count * sizeof(T)) {
+      MS_LOG(ERROR) << "The size of the received data is " << message->body.length() << ", but "
+                    << (count * sizeof(T)) << " is expected.";
+      return false;
+    }
+    (void)std::copy(message->body.begin(), message->body.end(), reinterpret_cast<char *>(recv_buff.data()));
+    for (size_t i = 0; i < count; i++) {
+      buff[i] += recv_buff[i];
+    }
+  }
+
+  // Map the index among the power of two ranks and back.
+  size_t new_index = index < 2 * rem ? index / 2 : index - rem;
+  auto real_index = [rem](size_t i) { return i < rem ? i * 2 + 1 : i + rem; };
+  for (size_t mask = 1; mask < pof2; mask <<= 1) {
+    uint32_t partner = ranks[real_index(new_index ^ mask)];
+    if (!SendRecv(partner, buff, count, partner, buff, count, true)) {
+      MS_LOG(ERROR) << "Recursive doubling AllReduce failed with the partner " << partner;
+      return false;
+    }
+  }
+
+  if (index < 2 * rem) {
+    if (!topo_node_->SendAsync(ranks[index - 1], buff, count * sizeof(T)) ||
+        !topo_node_->WaitForSend(ranks[index - 1])) {
+      MS_LOG(ERROR) << "Failed to send data to rank " << ranks[index - 1];
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::HalvingDoublingAllReduce(T *buff, size_t count, const std::vector<uint32_t> &ranks,
+                                                   size_t index) {
+  // Fold the ranks beyond the largest power of two the same as recursive doubling.
+  size_t size = ranks.size();
+  size_t pof2 = FloorPowerOfTwo(size);
+  size_t rem = size - pof2;
+  if (index < 2 * rem && index % 2 == 0) {
+    return SendRecv(ranks[index + 1], buff, count, ranks[index + 1], buff, count, false);
+  }
+  if (index < 2 * rem) {
+    std::vector<T> recv_buff(count);
+    MessageBase *message = nullptr;
+    if (!topo_node_->Receive(ranks[index - 1], &message, GetTimeout())) {
+      MS_LOG(ERROR) << "Failed to receive data from rank " << ranks[index - 1];
+      return false;
+    }
+    MS_EXCEPTION_IF_NULL(message);
+    std::unique_ptr<MessageBase> message_ptr(message);
+    if (message->body.length() != count * sizeof(T)) {
+      MS_LOG(ERROR) << "The size of the received data is " << message->body.length() << ", but "
+                    << (count * sizeof(T)) << " is expected.";
+      return false;
+    }
+    (void)std::copy(message->body.begin(), message->body.end(), reinterpret_cast<char *>(recv_buff.data()));
+    for (size_t i = 0; i < count; i++) {
+      buff[i] += recv_buff[i];
+    }
+  }
+
+  size_t new_index = index < 2 * rem ? index / 2 : index - rem;
+  auto real_index = [rem](size_t i) { return i < rem ? i * 2 + 1 : i + rem; };
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(count, pof2, &chunk_offsets, &chunk_sizes);
+  auto range_count = [&chunk_sizes](size_t begin, size_t end) {
+    return std::accumulate(chunk_sizes.begin() + SizeToLong(begin), chunk_sizes.begin() + SizeToLong(end),
+                           static_cast<size_t>(0));
+  };
+
+  // Reduce-scatter by recursive halving: the chunks kept are halved in each step, the lower half is kept by the process
+  // whose bit of the distance is 0. At last the chunk 'new_index' is reduced on this process.
+  size_t begin = 0;
+  size_t end = pof2;
+  for (size_t mask = pof2 >> 1; mask > 0; mask >>= 1) {
+    uint32_t partner = ranks[real_index(new_index ^ mask)];
+    size_t middle = begin + (end - begin) / 2;
+    size_t send_begin = (new_index & mask) == 0 ? middle : begin;
+    size_t send_end = (new_index & mask) == 0 ? end : middle;
+    size_t keep_begin = (new_index & mask) == 0 ? begin : middle;
+    size_t keep_end = (new_index & mask) == 0 ? middle : end;
+    if (!SendRecv(partner, buff + chunk_offsets[send_begin], range_count(send_begin, send_end), partner,
+                  buff + chunk_offsets[keep_begin], range_count(keep_begin, keep_end), true)) {
+      MS_LOG(ERROR) << "Recursive halving ReduceScatter failed with the partner " << partner;
+      return false;
+    }
+    begin = keep_begin;
+    end = keep_end;
+  }
+
+  // AllGather by recursive doubling: the chunks reduced are doubled in each step.
+  for (size_t mask = 1; mask < pof2; mask <<= 1) {
+    size_t partner_index = new_index ^ mask;
+    uint32_t partner = ranks[real_index(partner_index)];
+    size_t send_begin = new_index & ~(mask - 1);
+    size_t recv_begin = partner_index & ~(mask - 1);
+    if (!SendRecv(partner, buff + chunk_offsets[send_begin], range_count(send_begin, send_begin + mask), partner,
+                  buff + chunk_offsets[recv_begin], range_count(recv_begin, recv_begin + mask), false)) {
+      MS_LOG(ERROR) << "Recursive doubling AllGather failed with the partner " << partner;
+      return false;
+    }
+  }
+
+  if (index < 2 * rem) {
+    if (!topo_node_->SendAsync(ranks[index - 1], buff, count * sizeof(T)) ||
+        !topo_node_->WaitForSend(ranks[index - 1])) {
+      MS_LOG(ERROR) << "Failed to send data to rank " << ranks[index - 1];
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::HierarchicalAllReduce(T *buff, size_t count) {
+  InitHostRanks();
+  const auto &local_ranks = host_ranks_[host_index_];
+  uint32_t leader = local_ranks[0];
+  size_t data_size = count * sizeof(T);
+
+  // 1. Reduce to the leader of the host.
+  if (rank_id_ != leader) {
+    if (!topo_node_->SendAsync(leader, buff, data_size) || !topo_node_->WaitForSend(leader)) {
+      MS_LOG(ERROR) << "Failed to send data to the leader rank " << leader;
+      return false;
+    }
+  } else {
+    std::vector<T> recv_buff(count);
+    for (size_t i = 1; i < local_ranks.size(); i++) {
+      MessageBase *message = nullptr;
+      if (!topo_node_->Receive(local_ranks[i], &message, GetTimeout())) {
+        MS_LOG(ERROR) << "Failed to receive data from rank " << local_ranks[i];
+        return false;
+      }
+      MS_EXCEPTION_IF_NULL(message);
+      std::unique_ptr<MessageBase> message_ptr(message);
+      if (message->body.length() != data_size) {
+        MS_LOG(ERROR) << "The size of the received data is " << message->body.length() << ", but " << data_size
+                      << " is expected.";
+        return false;
+      }
+      (void)std::copy(message->body.begin(), message->body.end(), reinterpret_cast<char *>(recv_buff.data()));
+      for (size_t j = 0; j < count; j++) {
+        buff[j] += recv_buff[j];
+      }
+    }
+
+    // 2. AllReduce among the leaders.
+    std::vector<uint32_t> leaders;
+    size_t leader_index = 0;
+    for (size_t i = 0; i < host_ranks_.size(); i++) {
+      if (i == host_index_) {
+        leader_index = leaders.size();
+      }
+      leaders.push_back(host_ranks_[i][0]);
+    }
+    AllReduceAlgo algo = AllReduceAlgo::kRing;
+    if (data_size <= kRecursiveDoublingMaxSize) {
+      algo = AllReduceAlgo::kRecursiveDoubling;
+    } else if (FloorPowerOfTwo(leaders.size()) == leaders.size() || data_size <= kHalvingDoublingMaxSize) {
+      algo = AllReduceAlgo::kHalvingDoubling;
+    }
+    if (!FlatAllReduce(algo, buff, count, leaders, leader_index)) {
+      MS_LOG(ERROR) << "Failed to AllReduce among the leaders.";
+      return false;
+    }
+  }
+
+  // 3. Broadcast from the leader within the host.
+  if (rank_id_ == leader) {
+    for (size_t i = 1; i < local_ranks.size(); i++) {
+      if (!topo_node_->SendAsync(local_ranks[i], buff, data_size)) {
+        MS_LOG(ERROR) << "Failed to send data to rank " << local_ranks[i];
+        return false;
+      }
+    }
+    for (size_t i = 1; i < local_ranks.size(); i++) {
+      if (!topo_node_->WaitForSend(local_ranks[i])) {
+        MS_LOG(ERROR) << "Failed to send data to rank " << local_ranks[i];
+        return false;
+      }
+    }
+    return true;
+  }
+  MessageBase *message = nullptr;
+  if (!topo_node_->Receive(leader, &message, GetTimeout())) {
+    MS_LOG(ERROR) << "Failed to receive data from the leader rank " << leader;
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(message);
+  std::unique_ptr<MessageBase> message_ptr(message);
+  int ret = memcpy_s(buff, data_size, message->body.data(), message->body.length());
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")"
+                  << ", dest size is " << data_size << ", src size is " << message->body.length();
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  // Initialize collective communication parameters.
+  rank_id_ = topo_node_->rank_id();
+  rank_size_ = topo_node_->rank_size();
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  size_t data_size = recv_count * sizeof(T);
+  if (rank_size_ == 1) {
+    int ret = memcpy_s(recvbuff, data_size, sendbuff, data_size);
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+    return true;
+  }
+
+  // The input is reduced in a copy of it, chunk 'rank_id_' of which is the output.
+  std::vector<T> buff(reinterpret_cast<const T *>(sendbuff), reinterpret_cast<const T *>(sendbuff) + recv_count * rank_size_);
+  std::vector<size_t> chunk_offsets;
+  std::vector<size_t> chunk_sizes;
+  SplitChunks(recv_count * rank_size_, rank_size_, &chunk_offsets, &chunk_sizes);
+  std::vector<uint32_t> ranks(rank_size_);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  if (!RingReduceScatter(buff.data(), chunk_offsets, chunk_sizes, ranks, rank_id_)) {
+    return false;
+  }
+  int ret = memcpy_s(recvbuff, data_size, buff.data() + chunk_offsets[rank_id_], data_size);
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool MSCollectiveOpsImpl::AllToAll(const void *sendbuff, void *recvbuff, size_t count) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+
+  // Initialize collective communication parameters.
+  rank_id_ = topo_node_->rank_id();
+  rank_size_ = topo_node_->rank_size();
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  const T *send_data = reinterpret_cast<const T *>(sendbuff);
+  T *recv_data = reinterpret_cast<T *>(recvbuff);
+  size_t data_size = count * sizeof(T);
+  int ret = memcpy_s(recv_data + rank_id_ * count, data_size, send_data + rank_id_ * count, data_size);
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+
+  // Pairwise exchange: in step i, send to the rank 'rank_id_ + i' and receive from the rank 'rank_id_ - i', so that
+  // every process sends and receives one chunk in each step.
+  for (uint32_t i = 1; i < rank_size_; i++) {
+    uint32_t send_to_rank = (rank_id_ + i) % rank_size_;
+    uint32_t recv_from_rank = (rank_id_ - i + rank_size_) % rank_size_;
+    if (!SendRecv(send_to_rank, send_data + send_to_rank * count, count, recv_from_rank,
+                  recv_data + recv_from_rank * count, count, false)) {
+      MS_LOG(ERROR) << "AllToAll failed in step " << i;
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename T>
 bool MSCollectiveOpsImpl::RingAllGather(const void *sendbuff, void *recvbuff, size_t send_count) {
   MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
@@ -73,12 +586,7 @@ template <typename T>
 bool MSCollectiveOpsImpl::RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                                             const std::vector<size_t> &chunk_offset,
                                             const std::vector<size_t> &chunk_sizes) {
-  auto context_ptr = MsContext::GetInstance();
-  MS_EXCEPTION_IF_NULL(context_ptr);
-  // If enable recovery, set timeout 300s to prevent networking flapping.
-  uint32_t timeout =
-    context_ptr->get_param<bool>(MS_CTX_ENABLE_RECOVERY) ? kCollectiveCommMaxTimeout : kCollectiveCommTimeout;
-
+  uint32_t timeout = GetTimeout();
   for (size_t i = 0; i < rank_size_ - 1; i++) {
     size_t send_chunk_index = (rank_id_ - i + rank_size_) % rank_size_;
     T *send_chunk = output_buff + chunk_offset[send_chunk_index];
@@ -198,6 +706,38 @@ bool MSCollectiveOpsImpl::AllGather(const void *sendbuff, void *recvbuff, size_t
 
   return RingAllGather<T>(sendbuff, recvbuff, send_count);
 }
+
+template bool MSCollectiveOpsImpl::AllReduce<float>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                    size_t count);
+template bool MSCollectiveOpsImpl::AllReduce<int>(const std::string &data_name, void *sendbuff, void *recvbuff,
+                                                  size_t count);
+
+template bool MSCollectiveOpsImpl::ReduceScatter<float>(const void *sendbuff, void *recvbuff, size_t recv_count);
+template bool MSCollectiveOpsImpl::ReduceScatter<int>(const void *sendbuff, void *recvbuff, size_t recv_count);
+
+template bool MSCollectiveOpsImpl::AllToAll<float>(const void *sendbuff, void *recvbuff, size_t count);
+template bool MSCollectiveOpsImpl::AllToAll<uint64_t>(const void *sendbuff, void *recvbuff, size_t count);
+template bool MSCollectiveOpsImpl::AllToAll<int>(const void *sendbuff, void *recvbuff, size_t count);
+template bool MSCollectiveOpsImpl::AllToAll<char>(const void *sendbuff, void *recvbuff, size_t count);
+
+template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
+template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
+
+template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                    const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                       uint32_t root, const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                  const CommunicationGroupInfo &group_info);
+template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
+                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -32,6 +32,25 @@ constexpr uint32_t kCollectiveCommTimeout = 30;
 // The max timeout for server collective communication, used in disaster recovery to prevent networking flapping.
 constexpr uint32_t kCollectiveCommMaxTimeout = 300;
 
+// The AllReduce algorithms. kAuto selects one of the others by the data size and the topology of the ranks.
+enum class AllReduceAlgo {
+  kAuto = 0,
+  // Reduce-scatter and all-gather along a ring, 2*(p-1) steps, bandwidth optimal.
+  kRing,
+  // Exchange the whole data with the partner at distance 1, 2, 4..., log(p) steps, for small data.
+  kRecursiveDoubling,
+  // Reduce-scatter by recursive halving and all-gather by recursive doubling, 2*log(p) steps, bandwidth optimal.
+  kHalvingDoubling,
+  // Reduce to the leader rank of each host, AllReduce among the leaders and broadcast within each host.
+  kHierarchical
+};
+
+// The data size up to which recursive doubling is selected, the latency of which is the lowest.
+constexpr size_t kRecursiveDoublingMaxSize = 16 << 10;
+// The data size up to which halving-doubling is selected if the rank size is not a power of two. The ranks beyond the
+// largest power of two are folded into the others by sending the whole data, which costs more than ring for large data.
+constexpr size_t kHalvingDoublingMaxSize = 4 << 20;
+
 // The collective communication groups which are composed of multiple processes. Refer to MPI_Group.
 struct CommunicationGroupInfo {
   // This group's rank size.
@@ -49,8 +68,9 @@ struct CommunicationGroupInfo {
 };
 
 // MSCollectiveOpsImpl is the collective communication API of the server.
-// For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// It implements ring, recursive doubling, recursive halving-doubling and hierarchical AllReduce, the algorithm of which
+// is selected by the data size and the topology of the ranks, as well as ReduceScatter, AllGather, AllToAll and
+// Broadcast. The reduction is sum.
 class MSCollectiveOpsImpl {
  public:
   explicit MSCollectiveOpsImpl(std::shared_ptr<TopologyNode> topo_node)
@@ -62,15 +82,30 @@ class MSCollectiveOpsImpl {
   template <typename T>
   bool AllReduce(const std::string &data_name, void *sendbuff, void *recvbuff, size_t count);
 
+  // Every rank gets the sum of its own 'recv_count' elements of the 'sendbuff', which is 'recv_count * rank_size' long.
+  template <typename T>
+  bool ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count);
+
   template <typename T>
   bool AllGather(const void *sendbuff, void *recvbuff, size_t send_count);
 
+  // Every rank sends the i-th 'count' elements of the 'sendbuff' to rank i, and receives the ones from rank i into the
+  // i-th 'count' elements of the 'recvbuff'.
+  template <typename T>
+  bool AllToAll(const void *sendbuff, void *recvbuff, size_t count);
+
   // Collective broadcast within the specified group. The parameter "root" is the group rank of the root process.
   // Normally 0.
   template <typename T>
   bool Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                  const CommunicationGroupInfo &group_info);
 
+  // Select the AllReduce algorithm for the data of the byte size.
+  AllReduceAlgo SelectAllReduceAlgo(size_t data_size);
+
+  // Force an AllReduce algorithm, which is used for benchmark and test.
+  void set_allreduce_algo(AllReduceAlgo algo) { allreduce_algo_ = algo; }
+
  private:
   MSCollectiveOpsImpl(const MSCollectiveOpsImpl &) = delete;
   MSCollectiveOpsImpl &operator=(const MSCollectiveOpsImpl &) = delete;
@@ -83,33 +118,50 @@ class MSCollectiveOpsImpl {
   bool RingAllGatherImpl(uint32_t send_to_rank, uint32_t recv_from_rank, T *output_buff,
                          const std::vector<size_t> &chunk_offset, const std::vector<size_t> &chunk_sizes);
 
+  // The AllReduce algorithms among the 'ranks', the index of this process in which is 'index'. The data in 'buff' is
+  // reduced in place.
+  template <typename T>
+  bool RingAllReduce(T *buff, size_t count, const std::vector<uint32_t> &ranks, size_t index);
+  template <typename T>
+  bool RecursiveDoublingAllReduce(T *buff, size_t count, const std::vector<uint32_t> &ranks, size_t index);
+  template <typename T>
+  bool HalvingDoublingAllReduce(T *buff, size_t count, const std::vector<uint32_t> &ranks, size_t index);
+  template <typename T>
+  bool HierarchicalAllReduce(T *buff, size_t count);
+  template <typename T>
+  bool FlatAllReduce(AllReduceAlgo algo, T *buff, size_t count, const std::vector<uint32_t> &ranks, size_t index);
+
+  // Reduce-scatter along the ring of the 'ranks', after which the 'index'-th chunk is reduced on this process.
+  template <typename T>
+  bool RingReduceScatter(T *buff, const std::vector<size_t> &chunk_offsets, const std::vector<size_t> &chunk_sizes,
+                         const std::vector<uint32_t> &ranks, size_t index);
+
+  // Send 'send_count' elements to a rank and receive 'recv_count' elements from a rank, the received elements are
+  // added into or copied to 'recv_data'.
+  template <typename T>
+  bool SendRecv(uint32_t send_to_rank, const T *send_data, size_t send_count, uint32_t recv_from_rank, T *recv_data,
+                size_t recv_count, bool reduce);
+
+  // Group the ranks by the hosts with the ip addresses of them.
+  void InitHostRanks();
+
+  // The timeout of receiving data in seconds.
+  uint32_t GetTimeout() const;
+
   uint32_t rank_id_;
   uint32_t rank_size_;
 
   std::shared_ptr<TopologyNode> topo_node_{nullptr};
 
+  AllReduceAlgo allreduce_algo_{AllReduceAlgo::kAuto};
+
+  // The ranks on every host, and the index of the host of this process.
+  std::vector<std::vector<uint32_t>> host_ranks_;
+  size_t host_index_{0};
+
   // The mutex to ensure that collective communication is threadsafe.
   std::mutex mtx_;
 };
-
-template bool MSCollectiveOpsImpl::AllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::AllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::RingAllGather<float>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<uint64_t>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<int>(const void *sendbuff, void *recvbuff, size_t send_count);
-template bool MSCollectiveOpsImpl::RingAllGather<char>(const void *sendbuff, void *recvbuff, size_t send_count);
-
-template bool MSCollectiveOpsImpl::Broadcast<float>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                    const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
-                                                       uint32_t root, const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                  const CommunicationGroupInfo &group_info);
-template bool MSCollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
-                                                   const CommunicationGroupInfo &group_info);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -57,6 +57,7 @@ bool TopologyNode::Initialize() {
       std::string next_rank_addr = this->cgn_->GetMetadata(next_rank_name);
       if (next_rank_addr.length() > 0) {
         if (this->tcp_clients_[next_rank_id]->Connect(next_rank_addr)) {
+          std::lock_guard<std::mutex> lock(this->clients_mutex_);
           this->node_addresses_[next_rank_id] = next_rank_addr;
           this->initialized_ = true;
           break;
@@ -103,18 +104,17 @@ bool TopologyNode::Finalize() {
 }
 
 bool TopologyNode::SendAsync(size_t rank_id, void *data, size_t size) {
-  if (tcp_clients_.find(rank_id) == tcp_clients_.end()) {
+  auto tcp_client = GetTcpClient(rank_id);
+  if (tcp_client == nullptr) {
     MS_LOG(ERROR) << "Cann not find tcp client for rank id: " << rank_id << ", local rank: " << rank_id_;
     return false;
   }
-  auto &tcp_client = tcp_clients_[rank_id];
-  MS_EXCEPTION_IF_NULL(tcp_client);
 
   std::unique_ptr<MessageBase> message = std::make_unique<MessageBase>();
   MS_EXCEPTION_IF_NULL(message);
 
   message->name = std::to_string(rank_id_);
-  message->to = AID("", node_addresses_[rank_id]);
+  message->to = AID("", GetNodeAddress(rank_id));
   message->body.reserve(size);
   message->body.append(static_cast<char *>(data), size);
 
@@ -124,17 +124,67 @@ bool TopologyNode::SendAsync(size_t rank_id, void *data, size_t size) {
 
 bool TopologyNode::WaitForSend(size_t rank_id) {
   // Wait for all the pending data to be sent to the destination of specified rank id.
-  if (tcp_clients_.find(rank_id) == tcp_clients_.end()) {
-    MS_LOG(ERROR) << "Can not find tcp client for rank id: " << rank_id << ", local rank: " << rank_id_;
-    return false;
-  }
-  if (node_addresses_.find(rank_id) == node_addresses_.end()) {
-    MS_LOG(ERROR) << "Can not find the address for rank id: " << rank_id << ", local rank: " << rank_id_;
+  distributed::rpc::TCPClient *tcp_client = nullptr;
+  std::string address;
+  {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    if (tcp_clients_.find(rank_id) == tcp_clients_.end()) {
+      MS_LOG(ERROR) << "Can not find tcp client for rank id: " << rank_id << ", local rank: " << rank_id_;
+      return false;
+    }
+    if (node_addresses_.find(rank_id) == node_addresses_.end()) {
+      MS_LOG(ERROR) << "Can not find the address for rank id: " << rank_id << ", local rank: " << rank_id_;
+    }
+    tcp_client = tcp_clients_[rank_id];
+    address = node_addresses_[rank_id];
   }
-  auto &tcp_client = tcp_clients_[rank_id];
   MS_EXCEPTION_IF_NULL(tcp_client);
 
-  return tcp_client->Flush(node_addresses_[rank_id]);
+  return tcp_client->Flush(address);
+}
+
+std::string TopologyNode::GetNodeAddress(size_t rank_id) {
+  std::lock_guard<std::mutex> lock(clients_mutex_);
+  auto iter = node_addresses_.find(rank_id);
+  if (iter != node_addresses_.end()) {
+    return iter->second;
+  }
+  MS_EXCEPTION_IF_NULL(cgn_);
+  auto address = cgn_->GetMetadata("RNAK_ID_" + std::to_string(rank_id));
+  if (!address.empty()) {
+    node_addresses_[rank_id] = address;
+  }
+  return address;
+}
+
+distributed::rpc::TCPClient *TopologyNode::GetTcpClient(size_t rank_id) {
+  {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    auto iter = tcp_clients_.find(rank_id);
+    if (iter != tcp_clients_.end()) {
+      return iter->second;
+    }
+  }
+  if (rank_id >= total_node_num_) {
+    MS_LOG(ERROR) << "Invalid rank id: " << rank_id << ", the rank size is " << total_node_num_;
+    return nullptr;
+  }
+
+  // Connect to the rank on the first sending, the address of which has been registered during the initialization.
+  auto address = GetNodeAddress(rank_id);
+  if (address.empty()) {
+    MS_LOG(ERROR) << "Can not find the address for rank id: " << rank_id << ", local rank: " << rank_id_;
+    return nullptr;
+  }
+  auto tcp_client = std::make_unique<distributed::rpc::TCPClient>();
+  if (!tcp_client->Initialize() || !tcp_client->Connect(address)) {
+    MS_LOG(ERROR) << "Failed to connect to rank " << rank_id << " with address " << address;
+    tcp_client->Finalize();
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(clients_mutex_);
+  tcp_clients_[rank_id] = tcp_client.get();
+  return tcp_client.release();
 }
 
 bool TopologyNode::Receive(size_t rank_id, MessageBase **message, size_t timeout) {
@@ -171,6 +221,8 @@ MessageBase *const TopologyNode::HandleMessage(MessageBase *const message) {
   if (received_messages_.find(rank_id) == received_messages_.end()) {
     queue = new std::queue<MessageBase *>();
     received_messages_[rank_id] = queue;
+  } else {
+    queue = received_messages_[rank_id];
   }
   queue->push(message);
   cond_var_.notify_all();
@@ -47,7 +47,8 @@ class TopologyNode {
   // Destroy tcp clients and the tcp server.
   bool Finalize();
 
-  // Send data asynchronously to the specified rank node.
+  // Send data asynchronously to the specified rank node. The connection to a rank other than the next one is built on
+  // the first sending.
   bool SendAsync(size_t rank_id, void *data, size_t size);
 
   // Wait for all the pending sending tasks to the rank_id to be finished.
@@ -60,7 +61,13 @@ class TopologyNode {
 
   size_t rank_size();
 
+  // Get the address(ip:port) of the topo node of the specified rank, an empty string is returned if not found.
+  std::string GetNodeAddress(size_t rank_id);
+
  private:
+  // Get the tcp client which sends messages to the specified rank, create and connect it if it does not exist.
+  distributed::rpc::TCPClient *GetTcpClient(size_t rank_id);
+
   // Handle the message received by the tcp server.
   MessageBase *const HandleMessage(MessageBase *const message);
 
@@ -83,6 +90,9 @@ class TopologyNode {
   // Maintain the tcp addresses for other nodes if needed.
   std::map<size_t, std::string> node_addresses_;
 
+  // The mutex for the creation of the tcp clients and the lookup of the node addresses.
+  std::mutex clients_mutex_;
+
   // The tcp server which is responsible for receiving messages from other rank nodes.
   std::unique_ptr<distributed::rpc::TCPServer> tcp_server_;
 
@@ -40,6 +40,8 @@ void AllReduceCPUKernelMod::InitKernel(const CNodePtr &kernel_node) {
 #ifdef WITH_BACKEND
   MS_EXCEPTION_IF_NULL(kernel_node);
   kernel_name_ = common::AnfAlgo::GetCNodeName(kernel_node);
+  // The full name identifies the gradients reduced by this node across steps, which is fused into one node if they are.
+  full_name_ = kernel_node->fullname_with_scope();
   auto kernel_attr = GetKernelAttrFromNode(kernel_node);
   auto is_match = MatchKernelAttr(kernel_attr, GetOpSupport()).first;
   if (!is_match) {
@@ -75,7 +77,7 @@ bool AllReduceCPUKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs
   for (size_t i = 0; i < inputs.size(); ++i) {
     data_size += inputs[i]->size;
   }
-  bool ret = MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, data_size,
+  bool ret = MsCollectiveCommLib::GetInstance().AllReduce(full_name_, inputs[0]->addr, outputs[0]->addr, data_size,
                                                           kNumberTypeFloat32, Reduce_Sum, kMCCLGlobalGroupName);
   if (!ret) {
     MS_LOG(ERROR) << "AllReduceCPUKernelMod launch failed.";
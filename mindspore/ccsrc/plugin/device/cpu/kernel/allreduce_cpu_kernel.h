@@ -37,6 +37,9 @@ class AllReduceCPUKernelMod : public DeprecatedNativeCpuKernelMod {
 
  protected:
   std::vector<KernelAttr> GetOpSupport() override;
+
+ private:
+  std::string full_name_;
 };
 }  // namespace kernel
 }  // namespace mindspore
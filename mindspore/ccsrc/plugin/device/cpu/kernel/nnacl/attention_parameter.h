@@ -18,6 +18,24 @@
 
 #include "nnacl/op_base.h"
 
+typedef struct AttentionParameter {
+  // Primitive parameter
+  OpParameter op_parameter_;
+  int head_num_;   // number of heads of multi-head-attention
+  int head_size_;  // size of each head
+  float scale_;    // scale multiplied to q * k before softmax
+  // args for compute
+  int batch_;              // batch of query/key/value
+  int q_seq_;              // length of sequence of query of attention
+  int kv_seq_;             // length of sequence of key/value of attention
+  int d_model_;            // feature size of the query/key/value inputs
+  int hidden_;             // head_num_ * head_size_
+  int mask_batch_stride_;  // mask offset between two batches
+  int mask_row_stride_;    // mask offset between two query rows, 0 when mask is broadcast along query
+  int q_tile_;             // query rows computed together by one task
+  int kv_tile_;            // key/value rows visited in one online softmax step
+} AttentionParameter;
+
 typedef struct RelativePositionAttentionParameter {
   // Primitive parameter
   OpParameter op_parameter_;
@@ -37,6 +37,10 @@ inline void Uint8ToFloat32(const uint8_t *input, float *output, int number) {
 
 void Int32ToFloat32(const int32_t *input, float *output, int number);
 
+void Float32ToBFloat16(const float *input, uint16_t *output, int number);
+
+void BFloat16ToFloat32(const uint16_t *input, float *output, int number);
+
 inline void Int64ToFloat32(const int64_t *input, float *output, int number) {
   for (int i = 0; i < number; ++i) {
     output[i] = (float)input[i];
@@ -82,12 +82,34 @@ int SelectOutputUnit(const ConvParameter *conv_param) {
   return unit;
 }
 
-bool CheckIfUseWinograd(int *output_unit, const ConvParameter *conv_param) {
+bool CheckWinogradConvShape(const ConvParameter *conv_param) {
   if (conv_param->kernel_h_ == 1 && conv_param->kernel_w_ == 1) {
     return false;
   }
-  if (conv_param->kernel_w_ == conv_param->kernel_h_ && conv_param->dilation_h_ == 1 && conv_param->dilation_w_ == 1 &&
-      conv_param->stride_h_ == 1 && conv_param->stride_w_ == 1 && conv_param->input_channel_ != 1) {
+  return conv_param->kernel_w_ == conv_param->kernel_h_ && conv_param->dilation_h_ == 1 &&
+         conv_param->dilation_w_ == 1 && conv_param->stride_h_ == 1 && conv_param->stride_w_ == 1 &&
+         conv_param->input_channel_ != 1;
+}
+
+// Every output unit with an input transform for this kernel size, e.g. 3x3 kernels get 2 ~ 6 and 5x5 kernels 2 and 4.
+// Units larger than the output plane only add padding, so the smallest one is kept for tiny outputs.
+int GetWinogradOutputUnits(const ConvParameter *conv_param, int *output_units, int max_num) {
+  int max_out_hw = MSMAX(conv_param->output_h_, conv_param->output_w_);
+  int num = 0;
+  for (int i = MIN_UNIT; i < MAX_UNIT && num < max_num; ++i) {
+    if (!CheckWinogradInputOutputUnit(i + conv_param->kernel_w_ - 1, i)) {
+      continue;
+    }
+    if (num > 0 && i > max_out_hw) {
+      break;
+    }
+    output_units[num++] = i;
+  }
+  return num;
+}
+
+bool CheckIfUseWinograd(int *output_unit, const ConvParameter *conv_param) {
+  if (CheckWinogradConvShape(conv_param)) {
     *output_unit = SelectOutputUnit(conv_param);
     if (*output_unit > 1) {
       return true;
@@ -29,6 +29,10 @@ bool CheckConvDw1DWinograd(const ConvParameter *conv_param, int thread_num);
 
 bool CheckWinogradInputOutputUnit(int input_unit, int output_unit);
 
+bool CheckWinogradConvShape(const ConvParameter *conv_param);
+
+int GetWinogradOutputUnits(const ConvParameter *conv_param, int *output_units, int max_num);
+
 bool CheckIfUseWinograd(int *output_unit, const ConvParameter *conv_param);
 
 #ifdef __cplusplus
@@ -0,0 +1,267 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/base/tiled_transpose_base.h"
+#include <string.h>
+#include "nnacl/errorcode.h"
+#include "nnacl/fp32/pack_fp32.h"
+
+// elements of one unit of the plain copy.
+#define TILED_TRANSPOSE_COPY_UNIT 16384
+
+#if defined(ENABLE_ARM64) || defined(ENABLE_ARM32) || defined(ENABLE_AVX) || defined(ENABLE_SSE)
+#define TILED_TRANSPOSE_BLOCK8
+#endif
+
+int TiledTransposeInit(TiledTransposeInfo *info, const int *in_shape, const int *perm, int num_axes, int data_size) {
+  if (info == NULL || in_shape == NULL || perm == NULL || num_axes <= 0 || num_axes > MAX_TRANSPOSE_DIM_SIZE ||
+      data_size <= 0) {
+    return NNACL_PARAM_INVALID;
+  }
+  int64_t in_strides[MAX_TRANSPOSE_DIM_SIZE];
+  int64_t stride = 1;
+  for (int i = num_axes - 1; i >= 0; --i) {
+    if (in_shape[i] < 0) {
+      return NNACL_PARAM_INVALID;
+    }
+    in_strides[i] = stride;
+    stride *= in_shape[i];
+  }
+  int64_t total = stride;
+
+  // drop the axes of size 1, then merge every output axis into its predecessor when they are adjacent in the input.
+  int axes = 0;
+  for (int i = 0; i < num_axes; ++i) {
+    if (perm[i] < 0 || perm[i] >= num_axes) {
+      return NNACL_PARAM_INVALID;
+    }
+    int64_t size = in_shape[perm[i]];
+    if (size == 1) {
+      continue;
+    }
+    int64_t in_stride = in_strides[perm[i]];
+    if (axes > 0 && info->in_strides_[axes - 1] == in_stride * size) {
+      info->out_shape_[axes - 1] *= size;
+      info->in_strides_[axes - 1] = in_stride;
+      continue;
+    }
+    info->out_shape_[axes] = size;
+    info->in_strides_[axes] = in_stride;
+    ++axes;
+  }
+  if (axes == 0) {
+    info->out_shape_[0] = 1;
+    info->in_strides_[0] = 1;
+    axes = 1;
+  }
+  info->num_axes_ = axes;
+  info->data_size_ = data_size;
+  stride = 1;
+  for (int i = axes - 1; i >= 0; --i) {
+    info->out_strides_[i] = stride;
+    stride *= info->out_shape_[i];
+  }
+
+  info->tile_axis_ = -1;
+  info->tile_rows_ = 0;
+  info->tile_cols_ = 0;
+  if (axes == 1 || total == 0) {
+    info->mode_ = TiledTranspose_Copy;
+    info->unit_num_ = UP_DIV(total, TILED_TRANSPOSE_COPY_UNIT);
+    return NNACL_OK;
+  }
+  int64_t row_size = info->out_shape_[axes - 1];
+  if (info->in_strides_[axes - 1] == 1) {
+    info->mode_ = TiledTranspose_Rows;
+    info->unit_num_ = total / row_size;
+    return NNACL_OK;
+  }
+  for (int i = 0; i < axes - 1; ++i) {
+    if (info->in_strides_[i] == 1) {
+      info->tile_axis_ = i;
+    }
+  }
+  if (info->tile_axis_ < 0) {
+    return NNACL_ERR;
+  }
+  info->mode_ = TiledTranspose_Tiles;
+  info->tile_rows_ = UP_DIV(info->out_shape_[info->tile_axis_], TILED_TRANSPOSE_TILE);
+  info->tile_cols_ = UP_DIV(row_size, TILED_TRANSPOSE_TILE);
+  int64_t plane_num = total / (info->out_shape_[info->tile_axis_] * row_size);
+  info->unit_num_ = plane_num * info->tile_rows_ * info->tile_cols_;
+  return NNACL_OK;
+}
+
+// Input and output element offsets of the index-th entry over the output axes skip_a and skip_b excluded.
+static void OuterOffset(const TiledTransposeInfo *info, int64_t index, int skip_a, int skip_b, int64_t *in_offset,
+                        int64_t *out_offset) {
+  int64_t in = 0;
+  int64_t out = 0;
+  for (int i = info->num_axes_ - 1; i >= 0 && index > 0; --i) {
+    if (i == skip_a || i == skip_b) {
+      continue;
+    }
+    int64_t pos = index % info->out_shape_[i];
+    index /= info->out_shape_[i];
+    in += pos * info->in_strides_[i];
+    out += pos * info->out_strides_[i];
+  }
+  *in_offset = in;
+  *out_offset = out;
+}
+
+static void TiledTransposeRows(const uint8_t *in_data, uint8_t *out_data, const TiledTransposeInfo *info,
+                               int64_t unit_start, int64_t unit_end) {
+  int last = info->num_axes_ - 1;
+  size_t row_bytes = (size_t)(info->out_shape_[last] * info->data_size_);
+  int64_t in_offset = 0;
+  int64_t out_offset = 0;
+  OuterOffset(info, unit_start, last, last, &in_offset, &out_offset);
+  int64_t pos[MAX_TRANSPOSE_DIM_SIZE] = {0};
+  int64_t index = unit_start;
+  for (int i = last - 1; i >= 0; --i) {
+    pos[i] = index % info->out_shape_[i];
+    index /= info->out_shape_[i];
+  }
+  // rows are consecutive in the output, only the input offset has to follow the odometer.
+  out_offset *= info->data_size_;
+  for (int64_t row = unit_start; row < unit_end; ++row) {
+    memcpy(out_data + out_offset, in_data + in_offset * info->data_size_, row_bytes);
+    out_offset += (int64_t)row_bytes;
+    for (int i = last - 1; i >= 0; --i) {
+      in_offset += info->in_strides_[i];
+      if (++pos[i] < info->out_shape_[i]) {
+        break;
+      }
+      in_offset -= pos[i] * info->in_strides_[i];
+      pos[i] = 0;
+    }
+  }
+}
+
+// out[r * out_stride + c] = in[c * in_stride + r] over a rows x cols block.
+#define TILED_TRANSPOSE_BLOCK(type, in, out, rows, cols, in_stride, out_stride) \
+  do {                                                                          \
+    const type *src_ = (const type *)(in);                                      \
+    type *dst_ = (type *)(out);                                                 \
+    for (int64_t r_ = 0; r_ < (rows); ++r_) {                                   \
+      for (int64_t c_ = 0; c_ < (cols); ++c_) {                                 \
+        dst_[r_ * (out_stride) + c_] = src_[c_ * (in_stride) + r_];             \
+      }                                                                         \
+    }                                                                           \
+  } while (0)
+
+static void TransposeBlockFp32(const float *in, float *out, int64_t rows, int64_t cols, int64_t in_stride,
+                               int64_t out_stride) {
+#ifdef TILED_TRANSPOSE_BLOCK8
+#ifdef ENABLE_ARM64
+  Transpose8X8Fp32Func transpose8x8 = Transpose8X8Fp32Arm64;
+#elif defined(ENABLE_ARM32)
+  Transpose8X8Fp32Func transpose8x8 = Transpose8X8Fp32Arm32;
+#elif defined(ENABLE_AVX)
+  Transpose8X8Fp32Func transpose8x8 = Transpose8X8Fp32Avx;
+#else
+  Transpose8X8Fp32Func transpose8x8 = Transpose8X8Fp32Sse;
+#endif
+  // the 8x8 kernels take int strides.
+  if (in_stride <= INT32_MAX && out_stride <= INT32_MAX) {
+    int64_t rows8 = rows / C8NUM * C8NUM;
+    int64_t cols8 = cols / C8NUM * C8NUM;
+    for (int64_t r = 0; r < rows8; r += C8NUM) {
+      for (int64_t c = 0; c < cols8; c += C8NUM) {
+        transpose8x8(in + c * in_stride + r, out + r * out_stride + c, (int)in_stride, (int)out_stride);
+      }
+      TILED_TRANSPOSE_BLOCK(float, in + cols8 * in_stride + r, out + r * out_stride + cols8, C8NUM, cols - cols8,
+                            in_stride, out_stride);
+    }
+    TILED_TRANSPOSE_BLOCK(float, in + rows8, out + rows8 * out_stride, rows - rows8, cols, in_stride, out_stride);
+    return;
+  }
+#endif
+  TILED_TRANSPOSE_BLOCK(float, in, out, rows, cols, in_stride, out_stride);
+}
+
+static void TransposeBlock(const uint8_t *in, uint8_t *out, int64_t rows, int64_t cols, int64_t in_stride,
+                           int64_t out_stride, int data_size) {
+  switch (data_size) {
+    case sizeof(uint8_t):
+      TILED_TRANSPOSE_BLOCK(uint8_t, in, out, rows, cols, in_stride, out_stride);
+      break;
+    case sizeof(uint16_t):
+      TILED_TRANSPOSE_BLOCK(uint16_t, in, out, rows, cols, in_stride, out_stride);
+      break;
+    case sizeof(float):
+      TransposeBlockFp32((const float *)in, (float *)out, rows, cols, in_stride, out_stride);
+      break;
+    case sizeof(uint64_t):
+      TILED_TRANSPOSE_BLOCK(uint64_t, in, out, rows, cols, in_stride, out_stride);
+      break;
+    default:
+      for (int64_t r = 0; r < rows; ++r) {
+        for (int64_t c = 0; c < cols; ++c) {
+          memcpy(out + (r * out_stride + c) * data_size, in + (c * in_stride + r) * data_size, (size_t)data_size);
+        }
+      }
+      break;
+  }
+}
+
+static void TiledTransposeTiles(const uint8_t *in_data, uint8_t *out_data, const TiledTransposeInfo *info,
+                                int64_t unit_start, int64_t unit_end) {
+  int row_axis = info->tile_axis_;
+  int col_axis = info->num_axes_ - 1;
+  int64_t rows = info->out_shape_[row_axis];
+  int64_t cols = info->out_shape_[col_axis];
+  int64_t in_stride = info->in_strides_[col_axis];
+  int64_t out_stride = info->out_strides_[row_axis];
+  int64_t plane_tiles = info->tile_rows_ * info->tile_cols_;
+  int data_size = info->data_size_;
+  int64_t plane = -1;
+  int64_t in_offset = 0;
+  int64_t out_offset = 0;
+  for (int64_t unit = unit_start; unit < unit_end; ++unit) {
+    if (unit / plane_tiles != plane) {
+      plane = unit / plane_tiles;
+      OuterOffset(info, plane, row_axis, col_axis, &in_offset, &out_offset);
+    }
+    int64_t tile = unit % plane_tiles;
+    int64_t r0 = tile / info->tile_cols_ * TILED_TRANSPOSE_TILE;
+    int64_t c0 = tile % info->tile_cols_ * TILED_TRANSPOSE_TILE;
+    const uint8_t *in = in_data + (in_offset + c0 * in_stride + r0) * data_size;
+    uint8_t *out = out_data + (out_offset + r0 * out_stride + c0) * data_size;
+    TransposeBlock(in, out, MSMIN(TILED_TRANSPOSE_TILE, rows - r0), MSMIN(TILED_TRANSPOSE_TILE, cols - c0), in_stride,
+                   out_stride, data_size);
+  }
+}
+
+void TiledTranspose(const void *in_data, void *out_data, const TiledTransposeInfo *info, int64_t unit_start,
+                    int64_t unit_end) {
+  unit_end = MSMIN(unit_end, info->unit_num_);
+  if (unit_start >= unit_end) {
+    return;
+  }
+  const uint8_t *in = (const uint8_t *)in_data;
+  uint8_t *out = (uint8_t *)out_data;
+  if (info->mode_ == TiledTranspose_Copy) {
+    int64_t start = unit_start * TILED_TRANSPOSE_COPY_UNIT;
+    int64_t end = MSMIN(unit_end * TILED_TRANSPOSE_COPY_UNIT, info->out_shape_[0]);
+    memcpy(out + start * info->data_size_, in + start * info->data_size_, (size_t)((end - start) * info->data_size_));
+  } else if (info->mode_ == TiledTranspose_Rows) {
+    TiledTransposeRows(in, out, info, unit_start, unit_end);
+  } else {
+    TiledTransposeTiles(in, out, info, unit_start, unit_end);
+  }
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_BASE_TILED_TRANSPOSE_BASE_H_
+#define MINDSPORE_NNACL_BASE_TILED_TRANSPOSE_BASE_H_
+
+#include "nnacl/transpose.h"
+
+// side of the square tiles of the tiled mode, a tile of input plus a tile of output stays in L1.
+#define TILED_TRANSPOSE_TILE 32
+
+typedef enum TiledTransposeMode {
+  TiledTranspose_Copy = 0,  // the permutation keeps the memory order
+  TiledTranspose_Rows = 1,  // the innermost axis stays innermost, whole rows are copied
+  TiledTranspose_Tiles = 2  // the innermost axis moves, the plane of the two innermost axes is transposed in tiles
+} TiledTransposeMode;
+
+// A permutation reduced to its coalesced output axes: axes of size 1 are dropped and axes that stay neighbours in the
+// input are merged, so [2, 1, 3, 4, 5] with perm [0, 4, 2, 3, 1] becomes [2, 12, 5] with perm [0, 2, 1].
+typedef struct TiledTransposeInfo {
+  int mode_;
+  int data_size_;  // bytes of one element
+  int num_axes_;
+  int64_t out_shape_[MAX_TRANSPOSE_DIM_SIZE];
+  int64_t in_strides_[MAX_TRANSPOSE_DIM_SIZE];  // input stride of every output axis, in elements
+  int64_t out_strides_[MAX_TRANSPOSE_DIM_SIZE];
+  int tile_axis_;  // output axis that is innermost in the input, only in the tiled mode
+  int64_t tile_rows_;
+  int64_t tile_cols_;
+  // work is split in units: chunks of the copy, rows, or tiles.
+  int64_t unit_num_;
+} TiledTransposeInfo;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+int TiledTransposeInit(TiledTransposeInfo *info, const int *in_shape, const int *perm, int num_axes, int data_size);
+// Transposes the units [unit_start, unit_end), disjoint unit ranges write disjoint parts of out_data.
+void TiledTranspose(const void *in_data, void *out_data, const TiledTransposeInfo *info, int64_t unit_start,
+                    int64_t unit_end);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_BASE_TILED_TRANSPOSE_BASE_H_
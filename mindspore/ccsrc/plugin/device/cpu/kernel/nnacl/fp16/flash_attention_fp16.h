@@ -0,0 +1,33 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP16_FLASH_ATTENTION_FP16_H_
+#define MINDSPORE_NNACL_FP16_FLASH_ATTENTION_FP16_H_
+
+#include "nnacl/attention_parameter.h"
+#include "nnacl/intrinsics/ms_simd_instructions_fp16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// same as FlashAttentionTile with float16 q/k/v/out. Scores, softmax statistics and the accumulator are kept in
+// float, buffer holds FlashAttentionBufferSize(param) floats.
+void FlashAttentionTileFp16(const float16_t *q, const float16_t *k, const float16_t *v, const float *mask,
+                            float16_t *out, float *buffer, const AttentionParameter *param, int batch, int head,
+                            int q_start);
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP16_FLASH_ATTENTION_FP16_H_
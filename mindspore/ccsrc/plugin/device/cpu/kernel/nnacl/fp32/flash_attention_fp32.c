@@ -0,0 +1,143 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include <string.h>
+#include <float.h>
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+#include "nnacl/flash_attention_fp32_simd.h"
+
+size_t FlashAttentionBufferSize(const AttentionParameter *param) {
+  // scores, output accumulator, running max and running sum of each query row
+  return (size_t)param->q_tile_ * (param->kv_tile_ + param->head_size_ + C2NUM);
+}
+
+static void FlashAttentionScores(const float *q_row, const float *k, const float *mask_row, float *scores,
+                                 const AttentionParameter *param, int kv_rows) {
+  int head_size = param->head_size_;
+  for (int j = 0; j < kv_rows; j++) {
+    const float *k_row = k + (size_t)j * param->hidden_;
+    float dot = 0.0f;
+    int64_t index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionDot, index, q_row, k_row, &dot, head_size);
+    for (; index < head_size; index++) {
+      dot += q_row[index] * k_row[index];
+    }
+    scores[j] = dot;
+  }
+  int64_t index = 0;
+  if (mask_row == NULL) {
+    SIMD_RUN_NO_SCALAR(FlashAttentionScale, index, scores, param->scale_, scores, kv_rows);
+    for (; index < kv_rows; index++) {
+      scores[index] *= param->scale_;
+    }
+  } else {
+    SIMD_RUN_NO_SCALAR(FlashAttentionScaleMask, index, scores, mask_row, param->scale_, ATTENTION_MASK_VALUE, kv_rows);
+    for (; index < kv_rows; index++) {
+      scores[index] = scores[index] * param->scale_ + (1.0f - mask_row[index]) * ATTENTION_MASK_VALUE;
+    }
+  }
+}
+
+// folds one tile of scores into the running max/sum and the output accumulator of a query row.
+static void FlashAttentionOnlineSoftmax(float *scores, const float *v, float *acc, float *row_max, float *row_sum,
+                                        const AttentionParameter *param, int kv_rows) {
+  int head_size = param->head_size_;
+  float cur_max = *row_max;
+  int64_t index = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionMax, index, scores, &cur_max, kv_rows);
+  for (; index < kv_rows; index++) {
+    cur_max = MSMAX(cur_max, scores[index]);
+  }
+
+  float exp_sum = 0.0f;
+  index = 0;
+  SIMD_RUN_NO_SCALAR(FlashAttentionExpSum, index, scores, cur_max, &exp_sum, kv_rows);
+  for (; index < kv_rows; index++) {
+    scores[index] = simd_exp32_f32(scores[index] - cur_max);
+    exp_sum += scores[index];
+  }
+
+  if (cur_max > *row_max) {
+    // rescale what was accumulated against the old max.
+    float correction = simd_exp32_f32(*row_max - cur_max);
+    *row_sum *= correction;
+    index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionScale, index, acc, correction, acc, head_size);
+    for (; index < head_size; index++) {
+      acc[index] *= correction;
+    }
+    *row_max = cur_max;
+  }
+  *row_sum += exp_sum;
+
+  for (int j = 0; j < kv_rows; j++) {
+    const float *v_row = v + (size_t)j * param->hidden_;
+    float p = scores[j];
+    index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionAxpy, index, v_row, p, acc, head_size);
+    for (; index < head_size; index++) {
+      acc[index] += p * v_row[index];
+    }
+  }
+}
+
+void FlashAttentionTile(const float *q, const float *k, const float *v, const float *mask, float *out, float *buffer,
+                        const AttentionParameter *param, int batch, int head, int q_start) {
+  int hidden = param->hidden_;
+  int head_size = param->head_size_;
+  int q_rows = MSMIN(param->q_tile_, param->q_seq_ - q_start);
+  int kv_tile = param->kv_tile_;
+  float *scores = buffer;
+  float *acc = scores + param->q_tile_ * kv_tile;
+  float *row_max = acc + param->q_tile_ * head_size;
+  float *row_sum = row_max + param->q_tile_;
+
+  size_t head_offset = (size_t)head * head_size;
+  const float *q_ptr = q + ((size_t)batch * param->q_seq_ + q_start) * hidden + head_offset;
+  const float *k_ptr = k + (size_t)batch * param->kv_seq_ * hidden + head_offset;
+  const float *v_ptr = v + (size_t)batch * param->kv_seq_ * hidden + head_offset;
+  const float *mask_ptr =
+    mask == NULL ? NULL : mask + (size_t)batch * param->mask_batch_stride_ + (size_t)q_start * param->mask_row_stride_;
+
+  memset(acc, 0, q_rows * head_size * sizeof(float));
+  for (int i = 0; i < q_rows; i++) {
+    row_max[i] = -FLT_MAX;
+    row_sum[i] = 0.0f;
+  }
+  for (int kv_start = 0; kv_start < param->kv_seq_; kv_start += kv_tile) {
+    int kv_rows = MSMIN(kv_tile, param->kv_seq_ - kv_start);
+    const float *k_tile = k_ptr + (size_t)kv_start * hidden;
+    const float *v_tile = v_ptr + (size_t)kv_start * hidden;
+    for (int i = 0; i < q_rows; i++) {
+      float *score_row = scores + i * kv_tile;
+      const float *mask_row = mask_ptr == NULL ? NULL : mask_ptr + (size_t)i * param->mask_row_stride_ + kv_start;
+      FlashAttentionScores(q_ptr + (size_t)i * hidden, k_tile, mask_row, score_row, param, kv_rows);
+      FlashAttentionOnlineSoftmax(score_row, v_tile, acc + i * head_size, row_max + i, row_sum + i, param, kv_rows);
+    }
+  }
+
+  float *out_ptr = out + ((size_t)batch * param->q_seq_ + q_start) * hidden + head_offset;
+  for (int i = 0; i < q_rows; i++) {
+    const float *acc_row = acc + i * head_size;
+    float *out_row = out_ptr + (size_t)i * hidden;
+    float inv_sum = 1.0f / row_sum[i];
+    int64_t index = 0;
+    SIMD_RUN_NO_SCALAR(FlashAttentionScale, index, acc_row, inv_sum, out_row, head_size);
+    for (; index < head_size; index++) {
+      out_row[index] = acc_row[index] * inv_sum;
+    }
+  }
+}
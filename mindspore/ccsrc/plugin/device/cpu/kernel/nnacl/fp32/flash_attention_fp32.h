@@ -0,0 +1,39 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+#define MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
+
+#include "nnacl/attention_parameter.h"
+
+// value added to the scores of the masked positions, (1 - mask) * ATTENTION_MASK_VALUE
+#define ATTENTION_MASK_VALUE (-10000.0f)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// number of floats of the workspace needed by one FlashAttentionTile call
+size_t FlashAttentionBufferSize(const AttentionParameter *param);
+
+// q: [batch, q_seq, hidden], k/v: [batch, kv_seq, hidden], out: [batch, q_seq, hidden], head h is columns
+// [h * head_size, (h + 1) * head_size). Computes softmax(q * k^T * scale + mask) * v of one head for q_tile rows
+// starting at q_start. kv is visited kv_tile rows at a time with online softmax, so scores never exceed
+// q_tile * kv_tile.
+void FlashAttentionTile(const float *q, const float *k, const float *v, const float *mask, float *out, float *buffer,
+                        const AttentionParameter *param, int batch, int head, int q_start);
+#ifdef __cplusplus
+}
+#endif
+#endif  // MINDSPORE_NNACL_FP32_FLASH_ATTENTION_FP32_H_
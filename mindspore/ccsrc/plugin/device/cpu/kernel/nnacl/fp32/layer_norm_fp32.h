@@ -23,6 +23,9 @@
 extern "C" {
 #endif
 
+int LayerNormMeanAndSquare(const float *src, int num, float *mean, float *variance);
+void LayerNormGammaAndBeta(float *dst, const float *src, const float *gamma_data, const float *beta_data, int num,
+                           const float mean, const float deno);
 int LayerNorm(const float *src_data, const float *gamma_data, const float *beta_data, float *dst_data, float *out_mean,
               float *out_variance, const LayerNormParameter *param, size_t task_id);
 #ifdef __cplusplus
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32/matmul_bf16_fp32.h"
+#ifdef ENABLE_AVX512
+#include <immintrin.h>
+
+#define MATMUL_BF16_AVX512_STEP(a_value, b_lo, b_hi, acc_lo, acc_hi) \
+  do {                                                               \
+    __m512 a_broadcast = _mm512_set1_ps(a_value);                    \
+    acc_lo = _mm512_fmadd_ps(a_broadcast, b_lo, acc_lo);             \
+    acc_hi = _mm512_fmadd_ps(a_broadcast, b_hi, acc_hi);             \
+  } while (0)
+
+// a[i] is row i of the tile, b0/b1 are the blocks of columns [0, 16) and [16, 32), acc is 8 x 32 row-major.
+static void MatmulBf16Avx512Tile8x32(const float *const *a, const uint16_t *b0, const uint16_t *b1, float *acc,
+                                     int deep) {
+  const __m512i odd_mask = _mm512_set1_epi32((int)0xffff0000);
+  __m512 acc_lo[C8NUM];
+  __m512 acc_hi[C8NUM];
+  for (int i = 0; i < C8NUM; ++i) {
+    acc_lo[i] = _mm512_setzero_ps();
+    acc_hi[i] = _mm512_setzero_ps();
+  }
+  for (int d = 0; d < deep; d += C2NUM) {
+    __m512i b_lo = _mm512_loadu_si512(b0);
+    __m512i b_hi = _mm512_loadu_si512(b1);
+    b0 += C32NUM;
+    b1 += C32NUM;
+    __m512 b_lo_even = _mm512_castsi512_ps(_mm512_slli_epi32(b_lo, C16NUM));
+    __m512 b_hi_even = _mm512_castsi512_ps(_mm512_slli_epi32(b_hi, C16NUM));
+    for (int i = 0; i < C8NUM; ++i) {
+      MATMUL_BF16_AVX512_STEP(a[i][d], b_lo_even, b_hi_even, acc_lo[i], acc_hi[i]);
+    }
+    if (d + 1 == deep) {
+      break;
+    }
+    __m512 b_lo_odd = _mm512_castsi512_ps(_mm512_and_si512(b_lo, odd_mask));
+    __m512 b_hi_odd = _mm512_castsi512_ps(_mm512_and_si512(b_hi, odd_mask));
+    for (int i = 0; i < C8NUM; ++i) {
+      MATMUL_BF16_AVX512_STEP(a[i][d + 1], b_lo_odd, b_hi_odd, acc_lo[i], acc_hi[i]);
+    }
+  }
+  for (int i = 0; i < C8NUM; ++i) {
+    _mm512_storeu_ps(acc + i * C32NUM, acc_lo[i]);
+    _mm512_storeu_ps(acc + i * C32NUM + C16NUM, acc_hi[i]);
+  }
+}
+
+void MatmulBf16Avx512Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                          int row, int col, int stride, uint16_t *a_buffer) {
+  int deep_2 = UP_ROUND(deep, C2NUM);
+  float acc[C8NUM * C32NUM];
+  const float *a_rows[C8NUM];
+  for (int r = 0; r < row; r += C8NUM) {
+    int cur_row = MSMIN(C8NUM, row - r);
+    // rows past the end repeat the first row of the tile, their results are not written
+    for (int i = 0; i < C8NUM; ++i) {
+      a_rows[i] = a + (r + (i < cur_row ? i : 0)) * deep;
+    }
+    for (int j = 0; j < col; j += C32NUM) {
+      int cur_col = MSMIN(C32NUM, col - j);
+      const uint16_t *b0 = b + j * deep_2;
+      const uint16_t *b1 = cur_col > C16NUM ? b0 + C16NUM * deep_2 : b0;
+      MatmulBf16Avx512Tile8x32(a_rows, b0, b1, acc, deep);
+      MatmulBf16Post(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, cur_row, cur_col, C32NUM,
+                     stride);
+    }
+  }
+}
+#endif
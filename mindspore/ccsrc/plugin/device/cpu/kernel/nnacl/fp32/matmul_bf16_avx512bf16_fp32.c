@@ -0,0 +1,85 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32/matmul_bf16_fp32.h"
+#ifdef ENABLE_AVX512
+#include <immintrin.h>
+#include "nnacl/nnacl_common.h"
+
+// converts a row of A to bf16 with round to nearest even, deep is padded to even with a zero.
+static void MatmulBf16ConvertRowAvx512Bf16(const float *src, uint16_t *dst, int deep) {
+  int d = 0;
+  for (; d <= deep - C16NUM; d += C16NUM) {
+    __m256bh value = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + d));
+    _mm256_storeu_si256((__m256i *)(dst + d), (__m256i)value);
+  }
+  for (; d < deep; ++d) {
+    dst[d] = Float32ToBF16(src[d]);
+  }
+  if (deep % C2NUM != 0) {
+    dst[deep] = 0;
+  }
+}
+
+// a holds 8 bf16 rows of deep_2 values, b0/b1 are the blocks of columns [0, 16) and [16, 32), acc is 8 x 32.
+static void MatmulBf16Avx512Bf16Tile8x32(const uint16_t *a, const uint16_t *b0, const uint16_t *b1, float *acc,
+                                         int deep_2) {
+  __m512 acc_lo[C8NUM];
+  __m512 acc_hi[C8NUM];
+  for (int i = 0; i < C8NUM; ++i) {
+    acc_lo[i] = _mm512_setzero_ps();
+    acc_hi[i] = _mm512_setzero_ps();
+  }
+  for (int d = 0; d < deep_2; d += C2NUM) {
+    __m512bh b_lo = (__m512bh)_mm512_loadu_si512(b0);
+    __m512bh b_hi = (__m512bh)_mm512_loadu_si512(b1);
+    b0 += C32NUM;
+    b1 += C32NUM;
+    for (int i = 0; i < C8NUM; ++i) {
+      // the deep pair (d, d + 1) of row i is one 32-bit lane, broadcast to meet the pairs of the 16 columns
+      const uint16_t *a_i = a + i * deep_2 + d;
+      __m512bh a_pair = (__m512bh)_mm512_set1_epi32((int)((uint32_t)a_i[0] | ((uint32_t)a_i[1] << C16NUM)));
+      acc_lo[i] = _mm512_dpbf16_ps(acc_lo[i], a_pair, b_lo);
+      acc_hi[i] = _mm512_dpbf16_ps(acc_hi[i], a_pair, b_hi);
+    }
+  }
+  for (int i = 0; i < C8NUM; ++i) {
+    _mm512_storeu_ps(acc + i * C32NUM, acc_lo[i]);
+    _mm512_storeu_ps(acc + i * C32NUM + C16NUM, acc_hi[i]);
+  }
+}
+
+void MatmulBf16Avx512Bf16Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type,
+                              int deep, int row, int col, int stride, uint16_t *a_buffer) {
+  int deep_2 = UP_ROUND(deep, C2NUM);
+  float acc[C8NUM * C32NUM];
+  for (int r = 0; r < row; r += C8NUM) {
+    int cur_row = MSMIN(C8NUM, row - r);
+    // rows past the end repeat the first row of the tile, their results are not written
+    for (int i = 0; i < C8NUM; ++i) {
+      MatmulBf16ConvertRowAvx512Bf16(a + (r + (i < cur_row ? i : 0)) * deep, a_buffer + i * deep_2, deep);
+    }
+    for (int j = 0; j < col; j += C32NUM) {
+      int cur_col = MSMIN(C32NUM, col - j);
+      const uint16_t *b0 = b + j * deep_2;
+      const uint16_t *b1 = cur_col > C16NUM ? b0 + C16NUM * deep_2 : b0;
+      MatmulBf16Avx512Bf16Tile8x32(a_buffer, b0, b1, acc, deep_2);
+      MatmulBf16Post(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, cur_row, cur_col, C32NUM,
+                     stride);
+    }
+  }
+}
+#endif
@@ -0,0 +1,177 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32/matmul_bf16_fp32.h"
+#include <string.h>
+#include "nnacl/nnacl_common.h"
+#ifdef ENABLE_AVX
+#include <immintrin.h>
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+void PackMatrixBToCol16PairBf16(const void *src, uint16_t *dst, int deep, int col, bool src_is_bf16, bool transpose) {
+  int deep_2 = UP_ROUND(deep, C2NUM);
+  int col_16 = UP_ROUND(col, C16NUM);
+  memset(dst, 0, (size_t)deep_2 * col_16 * sizeof(uint16_t));
+  const float *src_fp32 = (const float *)src;
+  const uint16_t *src_bf16 = (const uint16_t *)src;
+  for (int c = 0; c < col; ++c) {
+    uint16_t *dst_c = dst + (c / C16NUM) * deep_2 * C16NUM + (c % C16NUM) * C2NUM;
+    for (int d = 0; d < deep; ++d) {
+      int src_index = transpose ? c * deep + d : d * col + c;
+      dst_c[(d / C2NUM) * C32NUM + (d % C2NUM)] =
+        src_is_bf16 ? src_bf16[src_index] : Float32ToBF16(src_fp32[src_index]);
+    }
+  }
+}
+
+void MatmulBf16Post(const float *acc, float *c, const float *bias, ActType act_type, int row, int col, int acc_stride,
+                    int stride) {
+  for (int r = 0; r < row; ++r) {
+    for (int j = 0; j < col; ++j) {
+      float value = acc[r * acc_stride + j];
+      if (bias != NULL) {
+        value += bias[j];
+      }
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        value = MSMAX(value, 0.0f);
+      }
+      if (act_type == ActType_Relu6) {
+        value = MSMIN(value, 6.0f);
+      }
+      c[r * stride + j] = value;
+    }
+  }
+}
+
+void MatmulBf16Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep, int row,
+                    int col, int stride, uint16_t *a_buffer) {
+  int deep_2 = UP_ROUND(deep, C2NUM);
+  float acc[C16NUM];
+  for (int r = 0; r < row; ++r) {
+    const float *a_r = a + r * deep;
+    for (int j = 0; j < col; j += C16NUM) {
+      const uint16_t *b_block = b + j * deep_2;
+      int cur_col = MSMIN(C16NUM, col - j);
+      for (int k = 0; k < cur_col; ++k) {
+        float value = 0.0f;
+        for (int d = 0; d < deep; ++d) {
+          value += a_r[d] * BF16ToFloat32(b_block[(d / C2NUM) * C32NUM + k * C2NUM + (d % C2NUM)]);
+        }
+        acc[k] = value;
+      }
+      MatmulBf16Post(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, 1, cur_col, C16NUM, stride);
+    }
+  }
+}
+
+#ifdef ENABLE_AVX
+static void MatmulBf16Avx2Tile4x16(const float *a0, const float *a1, const float *a2, const float *a3,
+                                   const uint16_t *b, float *acc, int deep) {
+  const __m256i odd_mask = _mm256_set1_epi32((int)0xffff0000);
+  __m256 acc00 = _mm256_setzero_ps();
+  __m256 acc01 = _mm256_setzero_ps();
+  __m256 acc10 = _mm256_setzero_ps();
+  __m256 acc11 = _mm256_setzero_ps();
+  __m256 acc20 = _mm256_setzero_ps();
+  __m256 acc21 = _mm256_setzero_ps();
+  __m256 acc30 = _mm256_setzero_ps();
+  __m256 acc31 = _mm256_setzero_ps();
+  int d = 0;
+  for (; d < deep; d += C2NUM) {
+    __m256i b0 = _mm256_loadu_si256((const __m256i *)b);
+    __m256i b1 = _mm256_loadu_si256((const __m256i *)(b + C16NUM));
+    b += C32NUM;
+    // the low half of a lane is deep d, the high half is deep d + 1, widening a bf16 is a 16 bit left shift
+    __m256 b0_even = _mm256_castsi256_ps(_mm256_slli_epi32(b0, C16NUM));
+    __m256 b1_even = _mm256_castsi256_ps(_mm256_slli_epi32(b1, C16NUM));
+    __m256 a_value = _mm256_set1_ps(a0[d]);
+    acc00 = _mm256_fmadd_ps(a_value, b0_even, acc00);
+    acc01 = _mm256_fmadd_ps(a_value, b1_even, acc01);
+    a_value = _mm256_set1_ps(a1[d]);
+    acc10 = _mm256_fmadd_ps(a_value, b0_even, acc10);
+    acc11 = _mm256_fmadd_ps(a_value, b1_even, acc11);
+    a_value = _mm256_set1_ps(a2[d]);
+    acc20 = _mm256_fmadd_ps(a_value, b0_even, acc20);
+    acc21 = _mm256_fmadd_ps(a_value, b1_even, acc21);
+    a_value = _mm256_set1_ps(a3[d]);
+    acc30 = _mm256_fmadd_ps(a_value, b0_even, acc30);
+    acc31 = _mm256_fmadd_ps(a_value, b1_even, acc31);
+    if (d + 1 == deep) {
+      break;
+    }
+    __m256 b0_odd = _mm256_castsi256_ps(_mm256_and_si256(b0, odd_mask));
+    __m256 b1_odd = _mm256_castsi256_ps(_mm256_and_si256(b1, odd_mask));
+    a_value = _mm256_set1_ps(a0[d + 1]);
+    acc00 = _mm256_fmadd_ps(a_value, b0_odd, acc00);
+    acc01 = _mm256_fmadd_ps(a_value, b1_odd, acc01);
+    a_value = _mm256_set1_ps(a1[d + 1]);
+    acc10 = _mm256_fmadd_ps(a_value, b0_odd, acc10);
+    acc11 = _mm256_fmadd_ps(a_value, b1_odd, acc11);
+    a_value = _mm256_set1_ps(a2[d + 1]);
+    acc20 = _mm256_fmadd_ps(a_value, b0_odd, acc20);
+    acc21 = _mm256_fmadd_ps(a_value, b1_odd, acc21);
+    a_value = _mm256_set1_ps(a3[d + 1]);
+    acc30 = _mm256_fmadd_ps(a_value, b0_odd, acc30);
+    acc31 = _mm256_fmadd_ps(a_value, b1_odd, acc31);
+  }
+  _mm256_storeu_ps(acc, acc00);
+  _mm256_storeu_ps(acc + C8NUM, acc01);
+  _mm256_storeu_ps(acc + C16NUM, acc10);
+  _mm256_storeu_ps(acc + C16NUM + C8NUM, acc11);
+  _mm256_storeu_ps(acc + C32NUM, acc20);
+  _mm256_storeu_ps(acc + C32NUM + C8NUM, acc21);
+  _mm256_storeu_ps(acc + C48NUM, acc30);
+  _mm256_storeu_ps(acc + C48NUM + C8NUM, acc31);
+}
+
+void MatmulBf16Avx2Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                        int row, int col, int stride, uint16_t *a_buffer) {
+  int deep_2 = UP_ROUND(deep, C2NUM);
+  float acc[C4NUM * C16NUM];
+  for (int r = 0; r < row; r += C4NUM) {
+    int cur_row = MSMIN(C4NUM, row - r);
+    // rows past the end repeat the first row of the tile, their results are not written
+    const float *a0 = a + r * deep;
+    const float *a1 = cur_row > 1 ? a0 + deep : a0;
+    const float *a2 = cur_row > 2 ? a0 + C2NUM * deep : a0;
+    const float *a3 = cur_row > 3 ? a0 + C3NUM * deep : a0;
+    for (int j = 0; j < col; j += C16NUM) {
+      int cur_col = MSMIN(C16NUM, col - j);
+      MatmulBf16Avx2Tile4x16(a0, a1, a2, a3, b + j * deep_2, acc, deep);
+      MatmulBf16Post(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, cur_row, cur_col, C16NUM,
+                     stride);
+    }
+  }
+}
+#endif
+
+MatmulBf16Func GetMatmulBf16Func(void) {
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Bf16_Support()) {
+    return MatmulBf16Avx512Bf16Fp32;
+  }
+  if (X86_Avx512_Support()) {
+    return MatmulBf16Avx512Fp32;
+  }
+#endif
+#ifdef ENABLE_AVX
+  if (X86_Avx_Support()) {
+    return MatmulBf16Avx2Fp32;
+  }
+#endif
+  return MatmulBf16Fp32;
+}
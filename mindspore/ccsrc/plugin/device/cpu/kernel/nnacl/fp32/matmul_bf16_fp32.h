@@ -0,0 +1,65 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_BF16_FP32_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_BF16_FP32_H_
+
+#include <stdbool.h>
+#include "nnacl/op_base.h"
+
+#define MATMUL_BF16_ROW_TILE C8NUM
+#define MATMUL_BF16_COL_TILE C16NUM
+
+/* fp32 row-major A * bf16 B => fp32 row-major C.
+ * B is packed in blocks of 16 columns. Inside a block, the two adjacent deep values 2k and 2k+1 of a column share one
+ * 32-bit lane (2k in the low half), which is the operand layout of vdpbf16ps, and an even/odd lane can be widened to
+ * fp32 with one shift or one and on cpus without avx512-bf16. Deep is padded to even and col to 16 with zeros.
+ * The block of column c (c % 16 == 0) starts at b + c * UP_ROUND(deep, 2).
+ * a_buffer holds MATMUL_BF16_ROW_TILE * UP_ROUND(deep, 2) bf16 values, it is only used by the avx512-bf16 kernel to
+ * convert a row tile of A. stride is the row stride of C in floats. */
+typedef void (*MatmulBf16Func)(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type,
+                               int deep, int row, int col, int stride, uint16_t *a_buffer);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* src is fp32 or bf16, [deep, col] when transpose is false, [col, deep] otherwise. */
+void PackMatrixBToCol16PairBf16(const void *src, uint16_t *dst, int deep, int col, bool src_is_bf16, bool transpose);
+
+/* adds bias, applies relu/relu6 and writes a row * col tile of acc (row stride acc_stride) to c. */
+void MatmulBf16Post(const float *acc, float *c, const float *bias, ActType act_type, int row, int col, int acc_stride,
+                    int stride);
+
+void MatmulBf16Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep, int row,
+                    int col, int stride, uint16_t *a_buffer);
+#ifdef ENABLE_AVX
+void MatmulBf16Avx2Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                        int row, int col, int stride, uint16_t *a_buffer);
+#endif
+#ifdef ENABLE_AVX512
+void MatmulBf16Avx512Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                          int row, int col, int stride, uint16_t *a_buffer);
+void MatmulBf16Avx512Bf16Fp32(const float *a, const uint16_t *b, float *c, const float *bias, ActType act_type,
+                              int deep, int row, int col, int stride, uint16_t *a_buffer);
+#endif
+
+/* pick the widest kernel the running cpu supports: avx512-bf16, avx512 emulation, avx2 emulation, then c. */
+MatmulBf16Func GetMatmulBf16Func(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_BF16_FP32_H_
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/matmul_epilogue_fp32.h"
+#include <math.h>
+#include "nnacl/errorcode.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/layer_norm_fp32.h"
+#include "nnacl/fp32/softmax_fp32.h"
+
+bool MatmulEpilogueHasRowwise(int epilogue) {
+  return (epilogue & (MatmulEpilogue_LayerNorm | MatmulEpilogue_Softmax)) != 0;
+}
+
+int MatmulEpilogueElementwise(float *c, const float *residual, int row, int col, int c_stride, int residual_stride,
+                              const MatMulParameter *param) {
+  if ((param->epilogue_ & MatmulEpilogue_ResidualAdd) && residual == NULL) {
+    return NNACL_NULL_PTR;
+  }
+  for (int r = 0; r < row; ++r) {
+    float *dst = c + r * c_stride;
+    if (param->epilogue_ & MatmulEpilogue_ResidualAdd) {
+      ElementAdd(dst, residual + r * residual_stride, dst, col);
+    }
+    if (param->epilogue_ & MatmulEpilogue_Gelu) {
+      Gelu(dst, col, dst, param->gelu_approximate_);
+    }
+  }
+  return NNACL_OK;
+}
+
+int MatmulEpilogueRowwise(float *c, const float *gamma, const float *beta, int row, int col, int c_stride,
+                          const MatMulParameter *param) {
+  if (param->epilogue_ & MatmulEpilogue_LayerNorm) {
+    if (gamma == NULL || beta == NULL) {
+      return NNACL_NULL_PTR;
+    }
+    for (int r = 0; r < row; ++r) {
+      float *dst = c + r * c_stride;
+      float mean = 0.0f;
+      float variance = 0.0f;
+      int ret = LayerNormMeanAndSquare(dst, col, &mean, &variance);
+      if (ret != NNACL_OK) {
+        return ret;
+      }
+      LayerNormGammaAndBeta(dst, dst, gamma, beta, col, mean, 1.0f / sqrtf(variance + param->epilogue_epsilon_));
+    }
+  } else if (param->epilogue_ & MatmulEpilogue_Softmax) {
+    for (int r = 0; r < row; ++r) {
+      int ret = SoftmaxLastAxis(c + r * c_stride, c + r * c_stride, 1, col);
+      if (ret != NNACL_OK) {
+        return ret;
+      }
+    }
+  }
+  return NNACL_OK;
+}
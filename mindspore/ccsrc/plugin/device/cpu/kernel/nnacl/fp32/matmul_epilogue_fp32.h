@@ -0,0 +1,38 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_EPILOGUE_FP32_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_EPILOGUE_FP32_H_
+
+#include "nnacl/op_base.h"
+#include "nnacl/matmul_parameter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+bool MatmulEpilogueHasRowwise(int epilogue);
+
+// residual add and gelu on a row x col block of a row-major output, residual has the layout of the output.
+int MatmulEpilogueElementwise(float *c, const float *residual, int row, int col, int c_stride, int residual_stride,
+                              const MatMulParameter *param);
+
+// layer norm or softmax on complete rows, col must be the whole last axis.
+int MatmulEpilogueRowwise(float *c, const float *gamma, const float *beta, int row, int col, int c_stride,
+                          const MatMulParameter *param);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_EPILOGUE_FP32_H_
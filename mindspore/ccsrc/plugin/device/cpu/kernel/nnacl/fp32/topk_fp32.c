@@ -38,6 +38,47 @@ int IndexSortCmp(const void *a, const void *b) {
   }
 }
 
+static void TopkSiftDown(TopkNode *heap, int size, int root) {
+  TopkNode node = heap[root];
+  while (root * C2NUM + 1 < size) {
+    int child = root * C2NUM + 1;
+    // the heap keeps the worst node on top, the worse one sorts later under DescendCmp.
+    if (child + 1 < size && DescendCmp(&heap[child + 1], &heap[child]) > 0) {
+      child++;
+    }
+    if (DescendCmp(&heap[child], &node) <= 0) {
+      break;
+    }
+    heap[root] = heap[child];
+    root = child;
+  }
+  heap[root] = node;
+}
+
+// Leaves the k first nodes of top_map under DescendCmp in top_map[0, k), sorted by DescendCmp, or by index when the
+// output is unsorted. A small k keeps a heap of the k best nodes instead of sorting the whole dimension.
+static void TopkSelect(TopkNode *top_map, int dim_size, int k, bool sorted) {
+  if (k > 0 && k <= dim_size / C2NUM) {
+    for (int i = k / C2NUM - 1; i >= 0; --i) {
+      TopkSiftDown(top_map, k, i);
+    }
+    for (int m = k; m < dim_size; m++) {
+      if (DescendCmp(&top_map[m], &top_map[0]) < 0) {
+        top_map[0] = top_map[m];
+        TopkSiftDown(top_map, k, 0);
+      }
+    }
+    if (sorted) {
+      qsort(top_map, k, sizeof(top_map[0]), DescendCmp);
+    }
+  } else {
+    qsort(top_map, dim_size, sizeof(top_map[0]), DescendCmp);
+  }
+  if (!sorted) {
+    qsort(top_map, k, sizeof(top_map[0]), IndexSortCmp);
+  }
+}
+
 void Topk(void *input_data, void *output_data, int32_t *output_index, TopkParameter *parameter) {
   int dim_size = parameter->dim_size_;
   int outer_loop_num = parameter->outer_loop_num_;
@@ -57,10 +98,7 @@ void Topk(void *input_data, void *output_data, int32_t *output_index, TopkParame
         top_map[m].element = *(cur_input_data + offset);
         top_map[m].index = m;
       }
-      qsort(top_map, dim_size, sizeof(top_map[0]), DescendCmp);
-      if (!parameter->sorted_) {
-        qsort(top_map, k, sizeof(top_map[0]), IndexSortCmp);
-      }
+      TopkSelect(top_map, dim_size, k, parameter->sorted_);
       for (int m = 0; m < k; m++) {
         int offset = out_offset + m * inner_loop_num + j;
         cur_output_data[offset] = top_map[m].element;
@@ -89,10 +127,7 @@ void TopkInt(void *input_data, void *output_data, int32_t *output_index, TopkPar
         top_map[m].element = *(cur_input_data + offset);
         top_map[m].index = m;
       }
-      qsort(top_map, dim_size, sizeof(top_map[0]), DescendCmp);
-      if (!parameter->sorted_) {
-        qsort(top_map, k, sizeof(top_map[0]), IndexSortCmp);
-      }
+      TopkSelect(top_map, dim_size, k, parameter->sorted_);
       for (int m = 0; m < k; m++) {
         int offset = out_offset + m * inner_loop_num + j;
         cur_output_data[offset] = top_map[m].element;
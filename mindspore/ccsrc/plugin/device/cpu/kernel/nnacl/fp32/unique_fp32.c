@@ -40,3 +40,32 @@ void Unique(const float *input, int input_len, float *output0, int *output0_len,
     }
   }
 }
+
+static inline uint32_t UniqueHash(float value) {
+  uint32_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  // -0.0 and 0.0 compare equal
+  bits = bits == 0x80000000u ? 0 : bits;
+  uint32_t hash = bits * 0x9E3779B1u;
+  return hash ^ (hash >> 16);
+}
+
+void UniqueByHash(const float *input, int input_len, float *output0, int *output0_len, int *output1, int *hash_table,
+                  int table_size) {
+  *output0_len = 0;
+  for (int i = 0; i < table_size; ++i) {
+    hash_table[i] = -1;
+  }
+  uint32_t mask = (uint32_t)table_size - 1;
+  for (int i = 0; i < input_len; i++) {
+    uint32_t slot = UniqueHash(input[i]) & mask;
+    while (hash_table[slot] != -1 && output0[hash_table[slot]] != input[i]) {
+      slot = (slot + 1) & mask;
+    }
+    if (hash_table[slot] == -1) {
+      hash_table[slot] = *output0_len;
+      output0[(*output0_len)++] = input[i];
+    }
+    output1[i] = hash_table[slot];
+  }
+}
@@ -28,6 +28,9 @@ typedef struct UniqueParameter {
 extern "C" {
 #endif
 void Unique(const float *input, int input_len, float *output0, int *output0_len, int *output1);
+// Same output as Unique in linear time, hash_table holds table_size ints, a power of two above 2 * input_len.
+void UniqueByHash(const float *input, int input_len, float *output0, int *output0_len, int *output1, int *hash_table,
+                  int table_size);
 #ifdef __cplusplus
 }
 #endif
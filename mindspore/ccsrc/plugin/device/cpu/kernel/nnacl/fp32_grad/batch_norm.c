@@ -16,6 +16,8 @@
 #include <math.h>
 #include <string.h>
 #include "nnacl/fp32_grad/batch_norm.h"
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+#include "nnacl/batch_norm_grad_simd.h"
 
 void var2Invar(float *save_var, int size, float eps) {
   for (int i = 0; i < size; i++) {
@@ -27,7 +29,10 @@ static void backwardComputeDx(const float *in, const float *yt, const float *mea
                               const float *scale, int size, int ch, const float *dbias, const float *dscale, float *dx,
                               float N, bool is_train) {
   for (int i = 0; i < size; i++) {
-    for (int c = 0; c < ch; c++) {
+    int c = 0;
+    SIMD_RUN_NO_SCALAR(BatchNormGradDx, c, in + i * ch, yt + i * ch, mean, invar, scale, dbias, dscale, ch, N, is_train,
+                       dx + i * ch);
+    for (; c < ch; c++) {
       // dx_2
       int ix = i * ch + c;
       dx[ix] = yt[ix];
@@ -50,7 +55,9 @@ void backwardAll(const float *restrict in, const float *restrict yt, const float
   NNACL_CHECK_ZERO_RETURN(size);
   float N = (float)size;
   for (int i = 0; i < size; i++) {
-    for (int c = 0; c < ch; c++) {
+    int c = 0;
+    SIMD_RUN_NO_SCALAR(BatchNormGradSum, c, in + i * ch, yt + i * ch, mean, ch, dbias, dscale);
+    for (; c < ch; c++) {
       int ix = i * ch + c;
       dbias[c] += yt[ix];
       // in fact, x_hat should also mul invar[c]. now put this step to the end.
@@ -73,7 +80,9 @@ void backwardP1(const float *restrict in, const float *restrict yt, const float
                 float *restrict dscale) {
 #endif
   for (int i = 0; i < size; i++) {
-    for (int c = 0; c < ch; c++) {
+    int c = 0;
+    SIMD_RUN_NO_SCALAR(BatchNormGradSum, c, in + i * ch, yt + i * ch, mean, ch, dbias, dscale);
+    for (; c < ch; c++) {
       int ix = i * ch + c;
       dbias[c] += yt[ix];
       // in fact, x_hat should also mul invar[c]. now put this step to the end.
@@ -16,16 +16,20 @@
 #include "nnacl/fp32_grad/layernorm_grad.h"
 #include <stddef.h>
 #include <math.h>
+#include <string.h>
 #include "nnacl/errorcode.h"
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+#include "nnacl/layernorm_grad_simd.h"
 
-int LayerNormGrad(const float *x, const float *dy, const float *var, const float *mean, const float *gamma,
-                  int param_num, int param_size, int block_num, int block_size, float *dx, float *dg, float *db) {
+static const float kLayerNormGradEps = 1e-12;
+
+// the gamma and beta of a block are params repeated block_size / param_num times, any other layout goes here.
+static void LayerNormGradGeneric(const float *x, const float *dy, const float *var, const float *mean,
+                                 const float *gamma, int param_num, int param_size, int block_num, int block_size,
+                                 float *dx, float *dg, float *db) {
   // var is actually layer_norm forward output var
-  const float eps = 1e-12;
+  const float eps = kLayerNormGradEps;
   const float *var_sqrt_rev = var;
-  if (block_size <= 0) {
-    return NNACL_ERRCODE_DIVISOR_ZERO;
-  }
   for (int i = 0; i < param_num; ++i) {
     float dgamma = 0.0f;
     float dbeta = 0.0f;
@@ -60,5 +64,66 @@ int LayerNormGrad(const float *x, const float *dy, const float *var, const float
       dx[index] = dx1 + dx2 + dx3;
     }
   }
+}
+
+int LayerNormGrad(const float *x, const float *dy, const float *var, const float *mean, const float *gamma,
+                  int param_num, int param_size, int block_num, int block_size, float *dx, float *dg, float *db) {
+  if (block_size <= 0) {
+    return NNACL_ERRCODE_DIVISOR_ZERO;
+  }
+  if (param_num <= 0 || block_size % param_num != 0) {
+    LayerNormGradGeneric(x, dy, var, mean, gamma, param_num, param_size, block_num, block_size, dx, dg, db);
+    return NNACL_OK;
+  }
+  // each row of param_num values lies in one block, dg and db are accumulated a row at a time.
+  memset(dg, 0, param_num * sizeof(float));
+  memset(db, 0, param_num * sizeof(float));
+  for (int r = 0; r < param_size; ++r) {
+    const float *x_row = x + r * param_num;
+    const float *dy_row = dy + r * param_num;
+    int norm_shift = r * param_num / block_size;
+    float row_mean = mean[norm_shift];
+    float rstd = 1.0f / sqrtf(var[norm_shift] + kLayerNormGradEps);
+    int i = 0;
+    SIMD_RUN_NO_SCALAR(LayerNormGradGammaBeta, i, x_row, dy_row, param_num, row_mean, rstd, dg, db);
+    for (; i < param_num; ++i) {
+      dg[i] += dy_row[i] * (x_row[i] - row_mean) * rstd;
+      db[i] += dy_row[i];
+    }
+  }
+  for (int i = 0; i < block_num; ++i) {
+    const float *x_block = x + i * block_size;
+    const float *dy_block = dy + i * block_size;
+    float block_mean = mean[i];
+    float rstd = 1.0f / sqrtf(var[i] + kLayerNormGradEps);
+    float sum_dyg_dxm = 0.0f;
+    float sum_dyg = 0.0f;
+    float sum_dxm = 0.0f;
+    for (int p = 0; p < block_size; p += param_num) {
+      int j = 0;
+      SIMD_RUN_NO_SCALAR(LayerNormGradSums, j, x_block + p, dy_block + p, gamma, param_num, block_mean, &sum_dyg_dxm,
+                         &sum_dyg, &sum_dxm);
+      for (; j < param_num; ++j) {
+        float dxm = x_block[p + j] - block_mean;
+        float dyg = dy_block[p + j] * gamma[j];
+        sum_dyg_dxm += dyg * dxm;
+        sum_dyg += dyg;
+        sum_dxm += dxm;
+      }
+    }
+    float sum1 = -0.5f * rstd * rstd * rstd * sum_dyg_dxm;
+    float sum3 = -2.0f * sum_dxm;
+    float dxm_coef = sum1 * 2.0f / block_size;
+    float dx_bias = (-1.0f * rstd * sum_dyg + (1.0f / block_size) * sum1 * sum3) * (1.0f / block_size);
+    for (int p = 0; p < block_size; p += param_num) {
+      int j = 0;
+      SIMD_RUN_NO_SCALAR(LayerNormGradDx, j, x_block + p, dy_block + p, gamma, param_num, block_mean, rstd, dxm_coef,
+                         dx_bias, dx + i * block_size + p);
+      for (; j < param_num; ++j) {
+        float dyg = dy_block[p + j] * gamma[j];
+        dx[i * block_size + p + j] = dyg * rstd + dxm_coef * (x_block[p + j] - block_mean) + dx_bias;
+      }
+    }
+  }
   return NNACL_OK;
 }
@@ -17,6 +17,8 @@
 #include <string.h>
 #include <float.h>
 #include "nnacl/fp32_grad/pooling_grad.h"
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+#include "nnacl/pooling_grad_simd.h"
 
 void AvgPoolingGrad(const float *input_ptr, float *output_ptr, int count, const PoolingParameter *pooling_param) {
   int stride_w = pooling_param->stride_w_;
@@ -32,9 +34,6 @@ void AvgPoolingGrad(const float *input_ptr, float *output_ptr, int count, const
   int output_h = pooling_param->output_h_;
 
   const float kk = 1.0f / (float)(win_h * win_w);
-#if ENABLE_ARM
-  const float32x4_t factor = vdupq_n_f32(kk);
-#endif
   for (int ib = 0; ib < count; ib++) {
     float *out = output_ptr + ib * in_h * in_w * channel;
     const float *inPtr = input_ptr + ib * output_h * output_w * channel;
@@ -48,33 +47,8 @@ void AvgPoolingGrad(const float *input_ptr, float *output_ptr, int count, const
         int kw_s = MSMAX(0, over_w);
         int kw_e = MSMIN(win_w, in_w + over_w);
         int ic = 0;
-        for (; ic < channel - 4; ic += 4) {
-          int idx = (yw + yh * output_w) * channel + ic;
-#ifdef ENABLE_ARM
-          float32x4_t in = vld1q_f32(inPtr + idx);
-          float32x4_t delta = vmulq_f32(in, factor);
-#else
-          float delta[4] = {inPtr[idx], inPtr[idx + 1], inPtr[idx + 2], inPtr[idx + 3]};
-          for (int i = 0; i < 4; i++) delta[i] *= kk;
-#endif
-          for (int kh = kh_s; kh < kh_e; kh++) {
-            int xh = yh * stride_h + kh - pad_h;
-            for (int kw = kw_s; kw < kw_e; kw++) {
-              int xw = yw * stride_w + kw - pad_w;
-#ifdef ENABLE_ARM
-              float *out_vec = out + (xw + in_w * xh) * channel + ic;
-              float32x4_t outr = vld1q_f32(out + (xw + in_w * xh) * channel + ic);
-              float32x4_t outs = vaddq_f32(outr, delta);
-              vst1q_f32(out_vec, outs);
-#else
-
-              for (int i = 0; i < 4; i++) {
-                out[(xw + in_w * xh) * channel + ic + i] += ((float *)&delta)[i];
-              }
-#endif
-            }
-          }
-        }
+        SIMD_RUN_NO_SCALAR(AvgPoolingGrad, ic, inPtr + (yw + yh * output_w) * channel, out, channel, kk, kh_s, kh_e,
+                           kw_s, kw_e, -over_h, -over_w, in_w);
         for (; ic < channel; ic++) {
           int idx = (yw + yh * output_w) * channel + ic;
           float delta = inPtr[idx] * kk;
@@ -91,15 +65,6 @@ void AvgPoolingGrad(const float *input_ptr, float *output_ptr, int count, const
   }
 }
 
-#ifdef ENABLE_ARM
-static int32x4_t MaxIndex(float32x4_t in, float32x4_t *max, int32x4_t index, int32x4_t prev_index) {
-  uint32x4_t res = vcgtq_f32(in, *max);
-  int32x4_t m_index = vbslq_s32(res, index, prev_index);
-  *max = vbslq_f32(res, in, *max);
-  return m_index;
-}
-#endif
-
 void MaxPoolingGrad(const float *input_ptr, const float *dy_ptr, float *output_ptr, int output_batch,
                     const PoolingParameter *pooling_param) {
   int stride_w = pooling_param->stride_w_;
@@ -126,42 +91,8 @@ void MaxPoolingGrad(const float *input_ptr, const float *dy_ptr, float *output_p
         int kw_s = MSMAX(0, over_w);
         int kw_e = MSMIN(win_w, in_w + over_w);
         int ic = 0;
-        for (; ic <= channel - 4; ic += 4) {
-          int idx = (yw + yh * output_w) * channel + ic;
-#ifdef ENABLE_ARM
-          uint32x4_t max_idx = vdupq_n_u32(0);
-          float32x4_t max_val = vdupq_n_f32(-FLT_MAX);
-          float32x4_t delta = vld1q_f32(dyPtr + idx);
-#else
-          float delta[4] = {dyPtr[idx], dyPtr[idx + 1], dyPtr[idx + 2], dyPtr[idx + 3]};
-          float max_val[4] = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
-          int max_idx[4] = {0};
-#endif
-          for (int kh = kh_s; kh < kh_e; kh++) {
-            int xh = yh * stride_h + kh - pad_h;
-            for (int kw = kw_s; kw < kw_e; kw++) {
-              int xw = yw * stride_w + kw - pad_w;
-              int val_idx = (xw + in_w * xh) * channel + ic;
-#ifdef ENABLE_ARM
-              uint32x4_t index = {val_idx, val_idx + 1, val_idx + 2, val_idx + 3};
-              float32x4_t in = vld1q_f32(inPtr + val_idx);
-              max_idx = vreinterpretq_u32_s32(
-                MaxIndex(in, &max_val, vreinterpretq_s32_u32(index), vreinterpretq_s32_u32(max_idx)));
-#else
-              float val[4] = {inPtr[val_idx], inPtr[val_idx + 1], inPtr[val_idx + 2], inPtr[val_idx + 3]};
-              for (int i = 0; i < 4; i++) {
-                if (val[i] > max_val[i]) {
-                  max_val[i] = val[i];
-                  max_idx[i] = val_idx + i;
-                }
-              }
-#endif
-            }
-          }
-          for (int i = 0; i < 4; i++) {
-            out[((int *)&max_idx)[i]] += ((float *)&delta)[i];
-          }
-        }
+        SIMD_RUN_NO_SCALAR(MaxPoolingGrad, ic, inPtr, dyPtr + (yw + yh * output_w) * channel, out, channel, kh_s, kh_e,
+                           kw_s, kw_e, -over_h, -over_w, in_w, win_w);
         for (; ic < channel; ic++) {
           float max_val = -FLT_MAX;
           int max_idx = 0;
@@ -0,0 +1,167 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_AVX512
+#include <immintrin.h>
+#include <string.h>
+#include "nnacl/fp32_sparse/matmul_sparse_x86_fp32.h"
+
+#define SPARSE_AVX512_ROW_TILE C8NUM
+
+static void MatmulBlockSparseAvx512Tile8x16(const float *a[SPARSE_AVX512_ROW_TILE], const int32_t *block_deep,
+                                            const float *value, int block_num, float *acc) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  __m512 acc2 = _mm512_setzero_ps();
+  __m512 acc3 = _mm512_setzero_ps();
+  __m512 acc4 = _mm512_setzero_ps();
+  __m512 acc5 = _mm512_setzero_ps();
+  __m512 acc6 = _mm512_setzero_ps();
+  __m512 acc7 = _mm512_setzero_ps();
+  for (int k = 0; k < block_num; ++k) {
+    int d = block_deep[k];
+    __m512 b = _mm512_loadu_ps(value + k * SPARSE_COL_TILE);
+    acc0 = _mm512_fmadd_ps(_mm512_set1_ps(a[0][d]), b, acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_set1_ps(a[1][d]), b, acc1);
+    acc2 = _mm512_fmadd_ps(_mm512_set1_ps(a[2][d]), b, acc2);
+    acc3 = _mm512_fmadd_ps(_mm512_set1_ps(a[3][d]), b, acc3);
+    acc4 = _mm512_fmadd_ps(_mm512_set1_ps(a[4][d]), b, acc4);
+    acc5 = _mm512_fmadd_ps(_mm512_set1_ps(a[5][d]), b, acc5);
+    acc6 = _mm512_fmadd_ps(_mm512_set1_ps(a[6][d]), b, acc6);
+    acc7 = _mm512_fmadd_ps(_mm512_set1_ps(a[7][d]), b, acc7);
+  }
+  _mm512_storeu_ps(acc, acc0);
+  _mm512_storeu_ps(acc + SPARSE_COL_TILE, acc1);
+  _mm512_storeu_ps(acc + C2NUM * SPARSE_COL_TILE, acc2);
+  _mm512_storeu_ps(acc + C3NUM * SPARSE_COL_TILE, acc3);
+  _mm512_storeu_ps(acc + C4NUM * SPARSE_COL_TILE, acc4);
+  _mm512_storeu_ps(acc + C5NUM * SPARSE_COL_TILE, acc5);
+  _mm512_storeu_ps(acc + C6NUM * SPARSE_COL_TILE, acc6);
+  _mm512_storeu_ps(acc + C7NUM * SPARSE_COL_TILE, acc7);
+}
+
+void MatmulBlockSparseAvx512Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type,
+                                 int deep, int row, int col, int start_col, int end_col, int stride) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  const int32_t *block_offset = (const int32_t *)b;
+  const int32_t *block_deep = block_offset + panel_num + 1;
+  const float *value = (const float *)(block_deep + block_offset[panel_num]);
+  float acc[SPARSE_AVX512_ROW_TILE * SPARSE_COL_TILE];
+  for (int r = 0; r < row; r += SPARSE_AVX512_ROW_TILE) {
+    int cur_row = MSMIN(SPARSE_AVX512_ROW_TILE, row - r);
+    // rows past the end repeat the first row of the tile, their results are not written
+    const float *a_tile[SPARSE_AVX512_ROW_TILE];
+    for (int i = 0; i < SPARSE_AVX512_ROW_TILE; ++i) {
+      a_tile[i] = a + (r + (i < cur_row ? i : 0)) * deep;
+    }
+    for (int j = start_col; j < end_col; j += SPARSE_COL_TILE) {
+      int p = j / SPARSE_COL_TILE;
+      int start_block = block_offset[p];
+      MatmulBlockSparseAvx512Tile8x16(a_tile, block_deep + start_block, value + start_block * SPARSE_COL_TILE,
+                                      block_offset[p + 1] - start_block, acc);
+      int cur_col = MSMIN(SPARSE_COL_TILE, end_col - j);
+      MatmulSparsePost(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, cur_row, cur_col,
+                       SPARSE_COL_TILE, stride);
+    }
+  }
+}
+
+// a[0 - 3] are the 4 deep values of one group, idx picks one of them for each of the 16 columns.
+#define SPARSE_2X4_AVX512_FMA(a, idx, b, acc) \
+  acc = _mm512_fmadd_ps(_mm512_permutexvar_ps(idx, _mm512_castps128_ps512(a)), b, acc)
+
+static void MatmulSparse2x4Avx512Tile8x16(const float *a[SPARSE_AVX512_ROW_TILE], const float *value,
+                                          const uint8_t *index, int deep, float *acc) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  __m512 acc2 = _mm512_setzero_ps();
+  __m512 acc3 = _mm512_setzero_ps();
+  __m512 acc4 = _mm512_setzero_ps();
+  __m512 acc5 = _mm512_setzero_ps();
+  __m512 acc6 = _mm512_setzero_ps();
+  __m512 acc7 = _mm512_setzero_ps();
+  int group_num = UP_DIV(deep, SPARSE_NM_GROUP);
+  float tail[SPARSE_AVX512_ROW_TILE][SPARSE_NM_GROUP] = {0};
+  const float *a_group[SPARSE_AVX512_ROW_TILE];
+  for (int g = 0; g < group_num; ++g) {
+    int d = g * SPARSE_NM_GROUP;
+    for (int r = 0; r < SPARSE_AVX512_ROW_TILE; ++r) {
+      a_group[r] = a[r] + d;
+    }
+    if (d + SPARSE_NM_GROUP > deep) {
+      // the last group is not complete, do not read past the end of the rows
+      for (int r = 0; r < SPARSE_AVX512_ROW_TILE; ++r) {
+        memcpy(tail[r], a[r] + d, (deep - d) * sizeof(float));
+        a_group[r] = tail[r];
+      }
+    }
+    __m128 a0 = _mm_loadu_ps(a_group[0]);
+    __m128 a1 = _mm_loadu_ps(a_group[1]);
+    __m128 a2 = _mm_loadu_ps(a_group[2]);
+    __m128 a3 = _mm_loadu_ps(a_group[3]);
+    __m128 a4 = _mm_loadu_ps(a_group[4]);
+    __m128 a5 = _mm_loadu_ps(a_group[5]);
+    __m128 a6 = _mm_loadu_ps(a_group[6]);
+    __m128 a7 = _mm_loadu_ps(a_group[7]);
+    for (int s = 0; s < SPARSE_NM_KEEP; ++s) {
+      __m512i idx = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)index));
+      __m512 b = _mm512_loadu_ps(value);
+      index += SPARSE_COL_TILE;
+      value += SPARSE_COL_TILE;
+      SPARSE_2X4_AVX512_FMA(a0, idx, b, acc0);
+      SPARSE_2X4_AVX512_FMA(a1, idx, b, acc1);
+      SPARSE_2X4_AVX512_FMA(a2, idx, b, acc2);
+      SPARSE_2X4_AVX512_FMA(a3, idx, b, acc3);
+      SPARSE_2X4_AVX512_FMA(a4, idx, b, acc4);
+      SPARSE_2X4_AVX512_FMA(a5, idx, b, acc5);
+      SPARSE_2X4_AVX512_FMA(a6, idx, b, acc6);
+      SPARSE_2X4_AVX512_FMA(a7, idx, b, acc7);
+    }
+  }
+  _mm512_storeu_ps(acc, acc0);
+  _mm512_storeu_ps(acc + SPARSE_COL_TILE, acc1);
+  _mm512_storeu_ps(acc + C2NUM * SPARSE_COL_TILE, acc2);
+  _mm512_storeu_ps(acc + C3NUM * SPARSE_COL_TILE, acc3);
+  _mm512_storeu_ps(acc + C4NUM * SPARSE_COL_TILE, acc4);
+  _mm512_storeu_ps(acc + C5NUM * SPARSE_COL_TILE, acc5);
+  _mm512_storeu_ps(acc + C6NUM * SPARSE_COL_TILE, acc6);
+  _mm512_storeu_ps(acc + C7NUM * SPARSE_COL_TILE, acc7);
+}
+
+void MatmulSparse2x4Avx512Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                               int row, int col, int start_col, int end_col, int stride) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  int group_num = UP_DIV(deep, SPARSE_NM_GROUP);
+  int panel_size = group_num * SPARSE_NM_KEEP * SPARSE_COL_TILE;
+  const float *value = (const float *)b;
+  const uint8_t *index = (const uint8_t *)(value + panel_num * panel_size);
+  float acc[SPARSE_AVX512_ROW_TILE * SPARSE_COL_TILE];
+  for (int r = 0; r < row; r += SPARSE_AVX512_ROW_TILE) {
+    int cur_row = MSMIN(SPARSE_AVX512_ROW_TILE, row - r);
+    const float *a_tile[SPARSE_AVX512_ROW_TILE];
+    for (int i = 0; i < SPARSE_AVX512_ROW_TILE; ++i) {
+      a_tile[i] = a + (r + (i < cur_row ? i : 0)) * deep;
+    }
+    for (int j = start_col; j < end_col; j += SPARSE_COL_TILE) {
+      int p = j / SPARSE_COL_TILE;
+      MatmulSparse2x4Avx512Tile8x16(a_tile, value + p * panel_size, index + p * panel_size, deep, acc);
+      int cur_col = MSMIN(SPARSE_COL_TILE, end_col - j);
+      MatmulSparsePost(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, cur_row, cur_col,
+                       SPARSE_COL_TILE, stride);
+    }
+  }
+}
+#endif
@@ -0,0 +1,375 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32_sparse/matmul_sparse_x86_fp32.h"
+#include <string.h>
+#ifdef ENABLE_AVX
+#include <immintrin.h>
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+static inline float SparseWeightAt(const float *src, int d, int c, int deep, int col, bool transpose) {
+  return transpose ? src[c * deep + d] : src[d * col + c];
+}
+
+int BlockSparseBlockNum(const float *src, int deep, int col, bool transpose) {
+  int block_num = 0;
+  for (int p = 0; p < col; p += SPARSE_COL_TILE) {
+    int cur_col = MSMIN(SPARSE_COL_TILE, col - p);
+    for (int d = 0; d < deep; ++d) {
+      for (int j = 0; j < cur_col; ++j) {
+        if (SparseWeightAt(src, d, p + j, deep, col, transpose) != 0.0f) {
+          ++block_num;
+          break;
+        }
+      }
+    }
+  }
+  return block_num;
+}
+
+size_t BlockSparsePackSize(int col, int block_num) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  return (size_t)(panel_num + 1 + block_num) * sizeof(int32_t) + (size_t)block_num * SPARSE_COL_TILE * sizeof(float);
+}
+
+void PackBlockSparseB(const float *src, void *dst, int deep, int col, bool transpose) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  int block_num = BlockSparseBlockNum(src, deep, col, transpose);
+  int32_t *block_offset = (int32_t *)dst;
+  int32_t *block_deep = block_offset + panel_num + 1;
+  float *value = (float *)(block_deep + block_num);
+  float block_value[SPARSE_COL_TILE];
+  int block = 0;
+  for (int p = 0; p < panel_num; ++p) {
+    block_offset[p] = block;
+    int cur_col = MSMIN(SPARSE_COL_TILE, col - p * SPARSE_COL_TILE);
+    for (int d = 0; d < deep; ++d) {
+      memset(block_value, 0, sizeof(block_value));
+      bool non_zero = false;
+      for (int j = 0; j < cur_col; ++j) {
+        block_value[j] = SparseWeightAt(src, d, p * SPARSE_COL_TILE + j, deep, col, transpose);
+        non_zero = non_zero || block_value[j] != 0.0f;
+      }
+      if (non_zero) {
+        memcpy(value + block * SPARSE_COL_TILE, block_value, sizeof(block_value));
+        block_deep[block++] = d;
+      }
+    }
+  }
+  block_offset[panel_num] = block;
+}
+
+bool IsSparse2x4(const float *src, int deep, int col, bool transpose) {
+  for (int c = 0; c < col; ++c) {
+    for (int g = 0; g < deep; g += SPARSE_NM_GROUP) {
+      int non_zero = 0;
+      for (int d = g; d < MSMIN(g + SPARSE_NM_GROUP, deep); ++d) {
+        non_zero += SparseWeightAt(src, d, c, deep, col, transpose) != 0.0f ? 1 : 0;
+      }
+      if (non_zero > SPARSE_NM_KEEP) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+size_t Sparse2x4PackSize(int deep, int col) {
+  size_t value_num = (size_t)UP_DIV(col, SPARSE_COL_TILE) * UP_DIV(deep, SPARSE_NM_GROUP) * SPARSE_NM_KEEP *
+                     SPARSE_COL_TILE;
+  return value_num * (sizeof(float) + sizeof(uint8_t));
+}
+
+void PackSparse2x4B(const float *src, void *dst, int deep, int col, bool transpose) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  int group_num = UP_DIV(deep, SPARSE_NM_GROUP);
+  int group_size = SPARSE_NM_KEEP * SPARSE_COL_TILE;
+  float *value = (float *)dst;
+  uint8_t *index = (uint8_t *)(value + panel_num * group_num * group_size);
+  memset(dst, 0, Sparse2x4PackSize(deep, col));
+  for (int c = 0; c < col; ++c) {
+    int p = c / SPARSE_COL_TILE;
+    int j = c % SPARSE_COL_TILE;
+    for (int g = 0; g < group_num; ++g) {
+      float *group_value = value + (p * group_num + g) * group_size + j;
+      uint8_t *group_index = index + (p * group_num + g) * group_size + j;
+      int slot = 0;
+      for (int k = 0; k < SPARSE_NM_GROUP && g * SPARSE_NM_GROUP + k < deep && slot < SPARSE_NM_KEEP; ++k) {
+        float weight = SparseWeightAt(src, g * SPARSE_NM_GROUP + k, c, deep, col, transpose);
+        if (weight != 0.0f) {
+          group_value[slot * SPARSE_COL_TILE] = weight;
+          group_index[slot * SPARSE_COL_TILE] = (uint8_t)k;
+          ++slot;
+        }
+      }
+    }
+  }
+}
+
+void MatmulSparsePost(const float *acc, float *c, const float *bias, ActType act_type, int row, int col,
+                      int acc_stride, int stride) {
+  for (int r = 0; r < row; ++r) {
+    for (int j = 0; j < col; ++j) {
+      float value = acc[r * acc_stride + j];
+      if (bias != NULL) {
+        value += bias[j];
+      }
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        value = MSMAX(value, 0.0f);
+      }
+      if (act_type == ActType_Relu6) {
+        value = MSMIN(value, 6.0f);
+      }
+      c[r * stride + j] = value;
+    }
+  }
+}
+
+void MatmulBlockSparseFp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                           int row, int col, int start_col, int end_col, int stride) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  const int32_t *block_offset = (const int32_t *)b;
+  const int32_t *block_deep = block_offset + panel_num + 1;
+  const float *value = (const float *)(block_deep + block_offset[panel_num]);
+  float acc[SPARSE_COL_TILE];
+  for (int r = 0; r < row; ++r) {
+    const float *a_r = a + r * deep;
+    for (int j = start_col; j < end_col; j += SPARSE_COL_TILE) {
+      int p = j / SPARSE_COL_TILE;
+      memset(acc, 0, sizeof(acc));
+      for (int k = block_offset[p]; k < block_offset[p + 1]; ++k) {
+        float a_value = a_r[block_deep[k]];
+        for (int i = 0; i < SPARSE_COL_TILE; ++i) {
+          acc[i] += a_value * value[k * SPARSE_COL_TILE + i];
+        }
+      }
+      int cur_col = MSMIN(SPARSE_COL_TILE, end_col - j);
+      MatmulSparsePost(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, 1, cur_col,
+                       SPARSE_COL_TILE, stride);
+    }
+  }
+}
+
+void MatmulSparse2x4Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                         int row, int col, int start_col, int end_col, int stride) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  int group_num = UP_DIV(deep, SPARSE_NM_GROUP);
+  int group_size = SPARSE_NM_KEEP * SPARSE_COL_TILE;
+  const float *value = (const float *)b;
+  const uint8_t *index = (const uint8_t *)(value + panel_num * group_num * group_size);
+  float acc[SPARSE_COL_TILE];
+  for (int r = 0; r < row; ++r) {
+    const float *a_r = a + r * deep;
+    for (int j = start_col; j < end_col; j += SPARSE_COL_TILE) {
+      int p = j / SPARSE_COL_TILE;
+      memset(acc, 0, sizeof(acc));
+      for (int g = 0; g < group_num; ++g) {
+        const float *group_value = value + (p * group_num + g) * group_size;
+        const uint8_t *group_index = index + (p * group_num + g) * group_size;
+        for (int i = 0; i < group_size; ++i) {
+          int d = g * SPARSE_NM_GROUP + group_index[i];
+          if (d < deep) {
+            acc[i % SPARSE_COL_TILE] += a_r[d] * group_value[i];
+          }
+        }
+      }
+      int cur_col = MSMIN(SPARSE_COL_TILE, end_col - j);
+      MatmulSparsePost(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, 1, cur_col,
+                       SPARSE_COL_TILE, stride);
+    }
+  }
+}
+
+#ifdef ENABLE_AVX
+static void MatmulBlockSparseAvx2Tile4x16(const float *a0, const float *a1, const float *a2, const float *a3,
+                                          const int32_t *block_deep, const float *value, int block_num, float *acc) {
+  __m256 acc00 = _mm256_setzero_ps();
+  __m256 acc01 = _mm256_setzero_ps();
+  __m256 acc10 = _mm256_setzero_ps();
+  __m256 acc11 = _mm256_setzero_ps();
+  __m256 acc20 = _mm256_setzero_ps();
+  __m256 acc21 = _mm256_setzero_ps();
+  __m256 acc30 = _mm256_setzero_ps();
+  __m256 acc31 = _mm256_setzero_ps();
+  for (int k = 0; k < block_num; ++k) {
+    int d = block_deep[k];
+    __m256 b0 = _mm256_loadu_ps(value + k * SPARSE_COL_TILE);
+    __m256 b1 = _mm256_loadu_ps(value + k * SPARSE_COL_TILE + C8NUM);
+    __m256 a_value = _mm256_broadcast_ss(a0 + d);
+    acc00 = _mm256_fmadd_ps(a_value, b0, acc00);
+    acc01 = _mm256_fmadd_ps(a_value, b1, acc01);
+    a_value = _mm256_broadcast_ss(a1 + d);
+    acc10 = _mm256_fmadd_ps(a_value, b0, acc10);
+    acc11 = _mm256_fmadd_ps(a_value, b1, acc11);
+    a_value = _mm256_broadcast_ss(a2 + d);
+    acc20 = _mm256_fmadd_ps(a_value, b0, acc20);
+    acc21 = _mm256_fmadd_ps(a_value, b1, acc21);
+    a_value = _mm256_broadcast_ss(a3 + d);
+    acc30 = _mm256_fmadd_ps(a_value, b0, acc30);
+    acc31 = _mm256_fmadd_ps(a_value, b1, acc31);
+  }
+  _mm256_storeu_ps(acc, acc00);
+  _mm256_storeu_ps(acc + C8NUM, acc01);
+  _mm256_storeu_ps(acc + C16NUM, acc10);
+  _mm256_storeu_ps(acc + C16NUM + C8NUM, acc11);
+  _mm256_storeu_ps(acc + C32NUM, acc20);
+  _mm256_storeu_ps(acc + C32NUM + C8NUM, acc21);
+  _mm256_storeu_ps(acc + C48NUM, acc30);
+  _mm256_storeu_ps(acc + C48NUM + C8NUM, acc31);
+}
+
+void MatmulBlockSparseAvx2Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                               int row, int col, int start_col, int end_col, int stride) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  const int32_t *block_offset = (const int32_t *)b;
+  const int32_t *block_deep = block_offset + panel_num + 1;
+  const float *value = (const float *)(block_deep + block_offset[panel_num]);
+  float acc[C4NUM * SPARSE_COL_TILE];
+  for (int r = 0; r < row; r += C4NUM) {
+    int cur_row = MSMIN(C4NUM, row - r);
+    // rows past the end repeat the first row of the tile, their results are not written
+    const float *a0 = a + r * deep;
+    const float *a1 = cur_row > 1 ? a0 + deep : a0;
+    const float *a2 = cur_row > 2 ? a0 + C2NUM * deep : a0;
+    const float *a3 = cur_row > 3 ? a0 + C3NUM * deep : a0;
+    for (int j = start_col; j < end_col; j += SPARSE_COL_TILE) {
+      int p = j / SPARSE_COL_TILE;
+      int start_block = block_offset[p];
+      MatmulBlockSparseAvx2Tile4x16(a0, a1, a2, a3, block_deep + start_block, value + start_block * SPARSE_COL_TILE,
+                                    block_offset[p + 1] - start_block, acc);
+      int cur_col = MSMIN(SPARSE_COL_TILE, end_col - j);
+      MatmulSparsePost(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, cur_row, cur_col,
+                       SPARSE_COL_TILE, stride);
+    }
+  }
+}
+
+// a[0 - 3] are the 4 deep values of one group, idx picks one of them for each of the 8 columns.
+#define SPARSE_2X4_AVX2_FMA(a, idx, b, acc) \
+  acc = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(_mm256_castps128_ps256(a), idx), b, acc)
+
+static void MatmulSparse2x4Avx2Tile4x16(const float *a[C4NUM], const float *value, const uint8_t *index, int deep,
+                                        float *acc) {
+  __m256 acc00 = _mm256_setzero_ps();
+  __m256 acc01 = _mm256_setzero_ps();
+  __m256 acc10 = _mm256_setzero_ps();
+  __m256 acc11 = _mm256_setzero_ps();
+  __m256 acc20 = _mm256_setzero_ps();
+  __m256 acc21 = _mm256_setzero_ps();
+  __m256 acc30 = _mm256_setzero_ps();
+  __m256 acc31 = _mm256_setzero_ps();
+  int group_num = UP_DIV(deep, SPARSE_NM_GROUP);
+  float tail[C4NUM][SPARSE_NM_GROUP] = {0};
+  for (int g = 0; g < group_num; ++g) {
+    int d = g * SPARSE_NM_GROUP;
+    __m128 a0, a1, a2, a3;
+    if (d + SPARSE_NM_GROUP <= deep) {
+      a0 = _mm_loadu_ps(a[0] + d);
+      a1 = _mm_loadu_ps(a[1] + d);
+      a2 = _mm_loadu_ps(a[2] + d);
+      a3 = _mm_loadu_ps(a[3] + d);
+    } else {
+      // the last group is not complete, do not read past the end of the rows
+      for (int r = 0; r < C4NUM; ++r) {
+        memcpy(tail[r], a[r] + d, (deep - d) * sizeof(float));
+      }
+      a0 = _mm_loadu_ps(tail[0]);
+      a1 = _mm_loadu_ps(tail[1]);
+      a2 = _mm_loadu_ps(tail[2]);
+      a3 = _mm_loadu_ps(tail[3]);
+    }
+    for (int s = 0; s < SPARSE_NM_KEEP; ++s) {
+      __m256i idx0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)index));
+      __m256i idx1 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(index + C8NUM)));
+      __m256 b0 = _mm256_loadu_ps(value);
+      __m256 b1 = _mm256_loadu_ps(value + C8NUM);
+      index += SPARSE_COL_TILE;
+      value += SPARSE_COL_TILE;
+      SPARSE_2X4_AVX2_FMA(a0, idx0, b0, acc00);
+      SPARSE_2X4_AVX2_FMA(a0, idx1, b1, acc01);
+      SPARSE_2X4_AVX2_FMA(a1, idx0, b0, acc10);
+      SPARSE_2X4_AVX2_FMA(a1, idx1, b1, acc11);
+      SPARSE_2X4_AVX2_FMA(a2, idx0, b0, acc20);
+      SPARSE_2X4_AVX2_FMA(a2, idx1, b1, acc21);
+      SPARSE_2X4_AVX2_FMA(a3, idx0, b0, acc30);
+      SPARSE_2X4_AVX2_FMA(a3, idx1, b1, acc31);
+    }
+  }
+  _mm256_storeu_ps(acc, acc00);
+  _mm256_storeu_ps(acc + C8NUM, acc01);
+  _mm256_storeu_ps(acc + C16NUM, acc10);
+  _mm256_storeu_ps(acc + C16NUM + C8NUM, acc11);
+  _mm256_storeu_ps(acc + C32NUM, acc20);
+  _mm256_storeu_ps(acc + C32NUM + C8NUM, acc21);
+  _mm256_storeu_ps(acc + C48NUM, acc30);
+  _mm256_storeu_ps(acc + C48NUM + C8NUM, acc31);
+}
+
+void MatmulSparse2x4Avx2Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                             int row, int col, int start_col, int end_col, int stride) {
+  int panel_num = UP_DIV(col, SPARSE_COL_TILE);
+  int group_num = UP_DIV(deep, SPARSE_NM_GROUP);
+  int panel_size = group_num * SPARSE_NM_KEEP * SPARSE_COL_TILE;
+  const float *value = (const float *)b;
+  const uint8_t *index = (const uint8_t *)(value + panel_num * panel_size);
+  float acc[C4NUM * SPARSE_COL_TILE];
+  for (int r = 0; r < row; r += C4NUM) {
+    int cur_row = MSMIN(C4NUM, row - r);
+    const float *a_tile[C4NUM];
+    for (int i = 0; i < C4NUM; ++i) {
+      a_tile[i] = a + (r + (i < cur_row ? i : 0)) * deep;
+    }
+    for (int j = start_col; j < end_col; j += SPARSE_COL_TILE) {
+      int p = j / SPARSE_COL_TILE;
+      MatmulSparse2x4Avx2Tile4x16(a_tile, value + p * panel_size, index + p * panel_size, deep, acc);
+      int cur_col = MSMIN(SPARSE_COL_TILE, end_col - j);
+      MatmulSparsePost(acc, c + r * stride + j, bias == NULL ? NULL : bias + j, act_type, cur_row, cur_col,
+                       SPARSE_COL_TILE, stride);
+    }
+  }
+}
+#endif
+
+MatmulSparseFunc GetMatmulSparseFunc(SparseWeightFormat format) {
+  if (format == SparseWeightFormat_Block) {
+#ifdef ENABLE_AVX512
+    if (X86_Avx512_Support()) {
+      return MatmulBlockSparseAvx512Fp32;
+    }
+#endif
+#ifdef ENABLE_AVX
+    if (X86_Avx_Support()) {
+      return MatmulBlockSparseAvx2Fp32;
+    }
+#endif
+    return MatmulBlockSparseFp32;
+  }
+  if (format == SparseWeightFormat_2x4) {
+#ifdef ENABLE_AVX512
+    if (X86_Avx512_Support()) {
+      return MatmulSparse2x4Avx512Fp32;
+    }
+#endif
+#ifdef ENABLE_AVX
+    if (X86_Avx_Support()) {
+      return MatmulSparse2x4Avx2Fp32;
+    }
+#endif
+    return MatmulSparse2x4Fp32;
+  }
+  return NULL;
+}
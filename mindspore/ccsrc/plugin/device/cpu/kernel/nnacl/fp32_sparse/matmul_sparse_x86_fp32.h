@@ -0,0 +1,89 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_X86_FP32_H_
+#define MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_X86_FP32_H_
+
+#include <stdbool.h>
+#include "nnacl/op_base.h"
+
+#define SPARSE_COL_TILE C16NUM
+#define SPARSE_NM_GROUP C4NUM
+#define SPARSE_NM_KEEP C2NUM
+
+typedef enum SparseWeightFormat {
+  SparseWeightFormat_None = 0,
+  SparseWeightFormat_Block = 1, /* zero rows of a 16 columns panel are skipped */
+  SparseWeightFormat_2x4 = 2,   /* at most 2 non zero values in every 4 deep values of a column */
+} SparseWeightFormat;
+
+/* Block-sparse B. B [deep, col] is cut into panels of 16 columns, a deep row of a panel is one block and blocks whose
+ * 16 values are all zero are dropped. The packed buffer holds
+ *   int32 block_offset[panel_num + 1]  first block of each panel, block_offset[panel_num] is the block count
+ *   int32 block_deep[block_num]        deep index of each block
+ *   float value[block_num * 16]
+ * with panel_num = UP_DIV(col, 16), the last panel is padded with zeros.
+ *
+ * 2:4 structured-sparse B. For each panel and each group of 4 deep values, 2 slots of 16 values are kept
+ *   float value[panel_num][group_num][2][16]
+ *   uint8 index[panel_num][group_num][2][16]   position (0 - 3) of the value inside its group
+ * with group_num = UP_DIV(deep, 4).
+ *
+ * A is row-major [row, deep]. The kernels compute the columns [start_col, end_col) of C, start_col is a multiple of 16,
+ * c and bias point to column 0 and stride is the row stride of C in floats. */
+typedef void (*MatmulSparseFunc)(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                                 int row, int col, int start_col, int end_col, int stride);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* src is [deep, col] when transpose is false, [col, deep] otherwise. */
+int BlockSparseBlockNum(const float *src, int deep, int col, bool transpose);
+size_t BlockSparsePackSize(int col, int block_num);
+void PackBlockSparseB(const float *src, void *dst, int deep, int col, bool transpose);
+
+bool IsSparse2x4(const float *src, int deep, int col, bool transpose);
+size_t Sparse2x4PackSize(int deep, int col);
+void PackSparse2x4B(const float *src, void *dst, int deep, int col, bool transpose);
+
+/* adds bias, applies relu/relu6 and writes a row * col tile of acc (row stride acc_stride) to c. */
+void MatmulSparsePost(const float *acc, float *c, const float *bias, ActType act_type, int row, int col,
+                      int acc_stride, int stride);
+
+void MatmulBlockSparseFp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                           int row, int col, int start_col, int end_col, int stride);
+void MatmulSparse2x4Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                         int row, int col, int start_col, int end_col, int stride);
+#ifdef ENABLE_AVX
+void MatmulBlockSparseAvx2Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                               int row, int col, int start_col, int end_col, int stride);
+void MatmulSparse2x4Avx2Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                             int row, int col, int start_col, int end_col, int stride);
+#endif
+#ifdef ENABLE_AVX512
+void MatmulBlockSparseAvx512Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type,
+                                 int deep, int row, int col, int start_col, int end_col, int stride);
+void MatmulSparse2x4Avx512Fp32(const float *a, const void *b, float *c, const float *bias, ActType act_type, int deep,
+                               int row, int col, int start_col, int end_col, int stride);
+#endif
+
+/* pick the widest kernel of the format the running cpu supports. */
+MatmulSparseFunc GetMatmulSparseFunc(SparseWeightFormat format);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_SPARSE_MATMUL_SPARSE_X86_FP32_H_
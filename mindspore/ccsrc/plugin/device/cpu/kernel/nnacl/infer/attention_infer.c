@@ -39,6 +39,15 @@ int AttentionInferShape(const TensorC *const *inputs, size_t inputs_size, Tensor
   int batch = (q_input->shape_size_ == 2) ? 1 : q_input->shape_[0];
   int f_seq = (q_input->shape_size_ == 2) ? q_input->shape_[0] : q_input->shape_[1];
   int d_model = q_weight->shape_[1];
+  if (inputs_size <= C12NUM) {
+    // q, k, v, weight_q, weight_k, weight_v, weight_o, bias_q, bias_k, bias_v, bias_o and mask, output is
+    // projected by weight_o.
+    const TensorC *o_weight = inputs[SIXTH_INPUT + 1];
+    if (o_weight->shape_size_ != 2) {
+      return NNACL_ERR;
+    }
+    d_model = o_weight->shape_[1];
+  }
 
   output->shape_[0] = batch;
   output->shape_[1] = f_seq;
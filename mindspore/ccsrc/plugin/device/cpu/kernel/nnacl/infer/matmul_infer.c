@@ -129,6 +129,10 @@ int SetShape(const TensorC *const *inputs, size_t inputs_size, TensorC **outputs
 
 int MatmulInferShape(const TensorC *const *inputs, size_t inputs_size, TensorC **outputs, size_t outputs_size,
                      OpParameter *parameter) {
+  // the fused epilogue inputs follow the bias and do not take part in the shape inference.
+  int epilogue_num = MatmulEpilogueInputNum(((MatMulParameter *)parameter)->epilogue_);
+  MS_CHECK_TRUE_RET(inputs_size > (size_t)epilogue_num, NNACL_INPUT_TENSOR_ERROR);
+  inputs_size -= epilogue_num;
   int check_ret = CheckAugmentNullSizeInputTwo(inputs, inputs_size, outputs, outputs_size, parameter, 2, 3, 1);
   if (check_ret != NNACL_OK) {
     return check_ret;
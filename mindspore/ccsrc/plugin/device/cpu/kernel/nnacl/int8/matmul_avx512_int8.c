@@ -0,0 +1,101 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/int8/matmul_avx_int8.h"
+#ifdef ENABLE_AVX512
+#include <immintrin.h>
+
+static inline __m256i MatmulInt8DpReduceAvx512(__m512i value) {
+  // every column holds two adjacent int32 partial sums, add them up into the low half of each 64-bit lane.
+  value = _mm512_add_epi32(value, _mm512_srli_epi64(value, 32));
+  return _mm512_cvtepi64_epi32(value);
+}
+
+static void MatmulInt8Dp4x16TileAvx512(const int8_t *a, const int8_t *b, int32_t *acc, size_t deep4) {
+  __m512i acc00 = _mm512_setzero_si512();
+  __m512i acc01 = _mm512_setzero_si512();
+  __m512i acc10 = _mm512_setzero_si512();
+  __m512i acc11 = _mm512_setzero_si512();
+  __m512i acc20 = _mm512_setzero_si512();
+  __m512i acc21 = _mm512_setzero_si512();
+  __m512i acc30 = _mm512_setzero_si512();
+  __m512i acc31 = _mm512_setzero_si512();
+  for (size_t d = 0; d < deep4; d += C4NUM) {
+    const int8_t *b_ptr = b + d * C16NUM;
+    __m512i b0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(b_ptr)));
+    __m512i b1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(b_ptr + C32NUM)));
+
+    const int8_t *a_ptr = a + d * C4NUM;
+    int32_t a_value[C4NUM];
+    memcpy(a_value, a_ptr, sizeof(a_value));
+    __m512i a0 = _mm512_cvtepi8_epi16(_mm256_set1_epi32(a_value[0]));
+    __m512i a1 = _mm512_cvtepi8_epi16(_mm256_set1_epi32(a_value[1]));
+    __m512i a2 = _mm512_cvtepi8_epi16(_mm256_set1_epi32(a_value[2]));
+    __m512i a3 = _mm512_cvtepi8_epi16(_mm256_set1_epi32(a_value[3]));
+
+    acc00 = _mm512_add_epi32(acc00, _mm512_madd_epi16(a0, b0));
+    acc01 = _mm512_add_epi32(acc01, _mm512_madd_epi16(a0, b1));
+    acc10 = _mm512_add_epi32(acc10, _mm512_madd_epi16(a1, b0));
+    acc11 = _mm512_add_epi32(acc11, _mm512_madd_epi16(a1, b1));
+    acc20 = _mm512_add_epi32(acc20, _mm512_madd_epi16(a2, b0));
+    acc21 = _mm512_add_epi32(acc21, _mm512_madd_epi16(a2, b1));
+    acc30 = _mm512_add_epi32(acc30, _mm512_madd_epi16(a3, b0));
+    acc31 = _mm512_add_epi32(acc31, _mm512_madd_epi16(a3, b1));
+  }
+  _mm256_storeu_si256((__m256i *)(acc), MatmulInt8DpReduceAvx512(acc00));
+  _mm256_storeu_si256((__m256i *)(acc + C8NUM), MatmulInt8DpReduceAvx512(acc01));
+  _mm256_storeu_si256((__m256i *)(acc + C16NUM), MatmulInt8DpReduceAvx512(acc10));
+  _mm256_storeu_si256((__m256i *)(acc + C24NUM), MatmulInt8DpReduceAvx512(acc11));
+  _mm256_storeu_si256((__m256i *)(acc + C32NUM), MatmulInt8DpReduceAvx512(acc20));
+  _mm256_storeu_si256((__m256i *)(acc + C40NUM), MatmulInt8DpReduceAvx512(acc21));
+  _mm256_storeu_si256((__m256i *)(acc + C48NUM), MatmulInt8DpReduceAvx512(acc30));
+  _mm256_storeu_si256((__m256i *)(acc + C56NUM), MatmulInt8DpReduceAvx512(acc31));
+}
+
+void MatmulInt8DpAvx512(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                        size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                        const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                        int32_t maxi, size_t per_channel, const int32_t *filter_zp) {
+  int32_t acc[C4NUM * C16NUM];
+  for (size_t r = 0; r < row; r += C4NUM) {
+    size_t cur_row = MSMIN(C4NUM, row - r);
+    for (size_t c = 0; c < col; c += C16NUM) {
+      size_t cur_col = MSMIN(C16NUM, col - c);
+      size_t oc_offset = per_channel ? c : 0;
+      MatmulInt8Dp4x16TileAvx512(a + r * deep_4, b + c * deep_4, acc, deep_4);
+      MatmulInt8DpPost4x16(acc, dst + r * stride + c, cur_row, cur_col, stride, input_sum + r, bias + c,
+                           left_shift + oc_offset, right_shift + oc_offset, multiplier + oc_offset, output_zp, mini,
+                           maxi, per_channel, filter_zp + oc_offset);
+    }
+  }
+}
+
+void DynamicMatmulAvx512_4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4, float *multi_scales,
+                                    float *bias, size_t row, size_t col, size_t stride, const int32_t *a_sums,
+                                    const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum) {
+  int32_t acc[C4NUM * C16NUM];
+  for (size_t r = 0; r < row; r += C4NUM) {
+    size_t cur_row = MSMIN(C4NUM, row - r);
+    for (size_t c = 0; c < col; c += C16NUM) {
+      size_t cur_col = MSMIN(C16NUM, col - c);
+      MatmulInt8Dp4x16TileAvx512(a + r * deep4, b + c * deep4, acc, deep4);
+      DynamicMatmulInt8DpPost4x16(acc, out + r * stride / sizeof(float) + c, cur_row, cur_col, stride,
+                                  multi_scales + c, bias == NULL ? NULL : bias + c, a_sums + r, b_sums + c, a_zp,
+                                  b_zp_sum);
+    }
+  }
+}
+#endif
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/int8/matmul_avx_int8.h"
+#ifdef ENABLE_AVX512
+#include <immintrin.h>
+
+#define INT8_TO_UINT8_OFFSET_SHIFT 7
+
+static void MatmulInt8Dp4x16TileAvx512Vnni(const int8_t *a, const int8_t *b, int32_t *acc, size_t deep4) {
+  /* vpdpbusd multiplies unsigned bytes of a by signed bytes of b. a is biased by 128 to be unsigned, and the
+   * bias is taken away at the end with the column sums of b: (a + 128) * b - 128 * b = a * b. */
+  const __m512i sign_flip = _mm512_set1_epi32((int32_t)0x80808080);
+  const __m512i ones = _mm512_set1_epi8(1);
+  __m512i acc0 = _mm512_setzero_si512();
+  __m512i acc1 = _mm512_setzero_si512();
+  __m512i acc2 = _mm512_setzero_si512();
+  __m512i acc3 = _mm512_setzero_si512();
+  __m512i b_sum = _mm512_setzero_si512();
+  for (size_t d = 0; d < deep4; d += C4NUM) {
+    __m512i b0 = _mm512_loadu_si512((const void *)(b + d * C16NUM));
+    b_sum = _mm512_dpbusd_epi32(b_sum, ones, b0);
+
+    const int8_t *a_ptr = a + d * C4NUM;
+    int32_t a_value[C4NUM];
+    memcpy(a_value, a_ptr, sizeof(a_value));
+    acc0 = _mm512_dpbusd_epi32(acc0, _mm512_xor_si512(_mm512_set1_epi32(a_value[0]), sign_flip), b0);
+    acc1 = _mm512_dpbusd_epi32(acc1, _mm512_xor_si512(_mm512_set1_epi32(a_value[1]), sign_flip), b0);
+    acc2 = _mm512_dpbusd_epi32(acc2, _mm512_xor_si512(_mm512_set1_epi32(a_value[2]), sign_flip), b0);
+    acc3 = _mm512_dpbusd_epi32(acc3, _mm512_xor_si512(_mm512_set1_epi32(a_value[3]), sign_flip), b0);
+  }
+  b_sum = _mm512_slli_epi32(b_sum, INT8_TO_UINT8_OFFSET_SHIFT);
+  _mm512_storeu_si512((void *)(acc), _mm512_sub_epi32(acc0, b_sum));
+  _mm512_storeu_si512((void *)(acc + C16NUM), _mm512_sub_epi32(acc1, b_sum));
+  _mm512_storeu_si512((void *)(acc + C32NUM), _mm512_sub_epi32(acc2, b_sum));
+  _mm512_storeu_si512((void *)(acc + C48NUM), _mm512_sub_epi32(acc3, b_sum));
+}
+
+void MatmulInt8DpAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                            size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                            const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                            int32_t maxi, size_t per_channel, const int32_t *filter_zp) {
+  int32_t acc[C4NUM * C16NUM];
+  for (size_t r = 0; r < row; r += C4NUM) {
+    size_t cur_row = MSMIN(C4NUM, row - r);
+    for (size_t c = 0; c < col; c += C16NUM) {
+      size_t cur_col = MSMIN(C16NUM, col - c);
+      size_t oc_offset = per_channel ? c : 0;
+      MatmulInt8Dp4x16TileAvx512Vnni(a + r * deep_4, b + c * deep_4, acc, deep_4);
+      MatmulInt8DpPost4x16(acc, dst + r * stride + c, cur_row, cur_col, stride, input_sum + r, bias + c,
+                           left_shift + oc_offset, right_shift + oc_offset, multiplier + oc_offset, output_zp, mini,
+                           maxi, per_channel, filter_zp + oc_offset);
+    }
+  }
+}
+
+void DynamicMatmulAvx512Vnni_4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4,
+                                        float *multi_scales, float *bias, size_t row, size_t col, size_t stride,
+                                        const int32_t *a_sums, const int32_t *b_sums, int64_t a_zp,
+                                        int64_t b_zp_sum) {
+  int32_t acc[C4NUM * C16NUM];
+  for (size_t r = 0; r < row; r += C4NUM) {
+    size_t cur_row = MSMIN(C4NUM, row - r);
+    for (size_t c = 0; c < col; c += C16NUM) {
+      size_t cur_col = MSMIN(C16NUM, col - c);
+      MatmulInt8Dp4x16TileAvx512Vnni(a + r * deep4, b + c * deep4, acc, deep4);
+      DynamicMatmulInt8DpPost4x16(acc, out + r * stride / sizeof(float) + c, cur_row, cur_col, stride,
+                                  multi_scales + c, bias == NULL ? NULL : bias + c, a_sums + r, b_sums + c, a_zp,
+                                  b_zp_sum);
+    }
+  }
+}
+#endif
@@ -0,0 +1,172 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/int8/matmul_avx_int8.h"
+#ifdef ENABLE_AVX
+#include <immintrin.h>
+#include "nnacl/int8/fixed_point.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+
+void MatmulInt8DpPost4x16(const int32_t *acc, int8_t *dst, size_t row, size_t col, size_t stride,
+                          const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel, const int32_t *filter_zp) {
+  for (size_t r = 0; r < row; r++) {
+    for (size_t c = 0; c < col; c++) {
+      int32_t value = acc[r * C16NUM + c];
+      value -= per_channel ? input_sum[r] * filter_zp[c] : input_sum[r];
+      value += bias[c];
+      int32_t cur_left_shift = per_channel ? left_shift[c] : left_shift[0];
+      int32_t cur_right_shift = per_channel ? right_shift[c] : right_shift[0];
+      int32_t cur_multiplier = per_channel ? multiplier[c] : multiplier[0];
+      value = MultiplyByQuantizedMultiplier(value, cur_multiplier, cur_left_shift, cur_right_shift) + output_zp;
+      value = MSMIN(maxi, value);
+      value = MSMAX(mini, value);
+      dst[r * stride + c] = (int8_t)value;
+    }
+  }
+}
+
+void DynamicMatmulInt8DpPost4x16(const int32_t *acc, float *out, size_t row, size_t col, size_t stride,
+                                 const float *multi_scales, const float *bias, const int32_t *a_sums,
+                                 const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum) {
+  int64_t s4 = a_zp * b_zp_sum;
+  for (size_t r = 0; r < row; r++) {
+    int64_t s2 = a_sums[r] * b_zp_sum;
+    float *out_r = out + r * stride / sizeof(float);
+    for (size_t c = 0; c < col; c++) {
+      int64_t s3 = b_sums[c] * a_zp;
+      out_r[c] = multi_scales[c] * (acc[r * C16NUM + c] - s2 - s3 + s4);
+      if (bias != NULL) {
+        out_r[c] += bias[c];
+      }
+    }
+  }
+}
+
+static inline __m256i MatmulInt8DpReduceAvx2(__m256i low, __m256i high) {
+  // every column holds two adjacent int32 partial sums, add them up and keep the columns in order.
+  const __m256i even_index = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  low = _mm256_add_epi32(low, _mm256_srli_epi64(low, 32));
+  high = _mm256_add_epi32(high, _mm256_srli_epi64(high, 32));
+  low = _mm256_permutevar8x32_epi32(low, even_index);
+  high = _mm256_permutevar8x32_epi32(high, even_index);
+  return _mm256_inserti128_si256(low, _mm256_castsi256_si128(high), 1);
+}
+
+static void MatmulInt8Dp4x16TileAvx2(const int8_t *a, const int8_t *b, int32_t *acc, size_t deep4) {
+  /* vpmaddubsw saturates on int16 when both operands span the full int8 range, so the operands are widened to
+   * int16 first and multiplied by vpmaddwd, which is exact. */
+  for (int r = 0; r < C4NUM; r += C2NUM) {
+    __m256i acc00 = _mm256_setzero_si256();
+    __m256i acc01 = _mm256_setzero_si256();
+    __m256i acc02 = _mm256_setzero_si256();
+    __m256i acc03 = _mm256_setzero_si256();
+    __m256i acc10 = _mm256_setzero_si256();
+    __m256i acc11 = _mm256_setzero_si256();
+    __m256i acc12 = _mm256_setzero_si256();
+    __m256i acc13 = _mm256_setzero_si256();
+    for (size_t d = 0; d < deep4; d += C4NUM) {
+      const int8_t *b_ptr = b + d * C16NUM;
+      __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr)));
+      __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C16NUM)));
+      __m256i b2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C32NUM)));
+      __m256i b3 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C48NUM)));
+
+      const int8_t *a_ptr = a + d * C4NUM + r * C4NUM;
+      int32_t a0_value;
+      int32_t a1_value;
+      memcpy(&a0_value, a_ptr, sizeof(int32_t));
+      memcpy(&a1_value, a_ptr + C4NUM, sizeof(int32_t));
+      __m256i a0 = _mm256_cvtepi8_epi16(_mm_set1_epi32(a0_value));
+      __m256i a1 = _mm256_cvtepi8_epi16(_mm_set1_epi32(a1_value));
+
+      acc00 = _mm256_add_epi32(acc00, _mm256_madd_epi16(a0, b0));
+      acc01 = _mm256_add_epi32(acc01, _mm256_madd_epi16(a0, b1));
+      acc02 = _mm256_add_epi32(acc02, _mm256_madd_epi16(a0, b2));
+      acc03 = _mm256_add_epi32(acc03, _mm256_madd_epi16(a0, b3));
+      acc10 = _mm256_add_epi32(acc10, _mm256_madd_epi16(a1, b0));
+      acc11 = _mm256_add_epi32(acc11, _mm256_madd_epi16(a1, b1));
+      acc12 = _mm256_add_epi32(acc12, _mm256_madd_epi16(a1, b2));
+      acc13 = _mm256_add_epi32(acc13, _mm256_madd_epi16(a1, b3));
+    }
+    int32_t *acc0 = acc + r * C16NUM;
+    int32_t *acc1 = acc0 + C16NUM;
+    _mm256_storeu_si256((__m256i *)(acc0), MatmulInt8DpReduceAvx2(acc00, acc01));
+    _mm256_storeu_si256((__m256i *)(acc0 + C8NUM), MatmulInt8DpReduceAvx2(acc02, acc03));
+    _mm256_storeu_si256((__m256i *)(acc1), MatmulInt8DpReduceAvx2(acc10, acc11));
+    _mm256_storeu_si256((__m256i *)(acc1 + C8NUM), MatmulInt8DpReduceAvx2(acc12, acc13));
+  }
+}
+
+void MatmulInt8DpAvx2(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                      size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                      const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                      int32_t maxi, size_t per_channel, const int32_t *filter_zp) {
+  int32_t acc[C4NUM * C16NUM];
+  for (size_t r = 0; r < row; r += C4NUM) {
+    size_t cur_row = MSMIN(C4NUM, row - r);
+    for (size_t c = 0; c < col; c += C16NUM) {
+      size_t cur_col = MSMIN(C16NUM, col - c);
+      size_t oc_offset = per_channel ? c : 0;
+      MatmulInt8Dp4x16TileAvx2(a + r * deep_4, b + c * deep_4, acc, deep_4);
+      MatmulInt8DpPost4x16(acc, dst + r * stride + c, cur_row, cur_col, stride, input_sum + r, bias + c,
+                           left_shift + oc_offset, right_shift + oc_offset, multiplier + oc_offset, output_zp, mini,
+                           maxi, per_channel, filter_zp + oc_offset);
+    }
+  }
+}
+
+void DynamicMatmulAvx2_4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4, float *multi_scales,
+                                  float *bias, size_t row, size_t col, size_t stride, const int32_t *a_sums,
+                                  const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum) {
+  int32_t acc[C4NUM * C16NUM];
+  for (size_t r = 0; r < row; r += C4NUM) {
+    size_t cur_row = MSMIN(C4NUM, row - r);
+    for (size_t c = 0; c < col; c += C16NUM) {
+      size_t cur_col = MSMIN(C16NUM, col - c);
+      MatmulInt8Dp4x16TileAvx2(a + r * deep4, b + c * deep4, acc, deep4);
+      DynamicMatmulInt8DpPost4x16(acc, out + r * stride / sizeof(float) + c, cur_row, cur_col, stride,
+                                  multi_scales + c, bias == NULL ? NULL : bias + c, a_sums + r, b_sums + c, a_zp,
+                                  b_zp_sum);
+    }
+  }
+}
+
+MatmulInt8DpFunc GetMatmulInt8DpAvxFunc(void) {
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Vnni_Support()) {
+    return MatmulInt8DpAvx512Vnni;
+  }
+  if (X86_Avx512Bw_Support()) {
+    return MatmulInt8DpAvx512;
+  }
+#endif
+  return MatmulInt8DpAvx2;
+}
+
+DynamicMatmulInt8DpFunc GetDynamicMatmulInt8DpAvxFunc(void) {
+#ifdef ENABLE_AVX512
+  if (X86_Avx512Vnni_Support()) {
+    return DynamicMatmulAvx512Vnni_4x4x16AIWI;
+  }
+  if (X86_Avx512Bw_Support()) {
+    return DynamicMatmulAvx512_4x4x16AIWI;
+  }
+#endif
+  return DynamicMatmulAvx2_4x4x16AIWI;
+}
+#endif
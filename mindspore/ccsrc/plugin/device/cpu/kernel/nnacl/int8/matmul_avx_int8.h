@@ -0,0 +1,82 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_INT8_MATMUL_AVX_INT8_H_
+#define MINDSPORE_NNACL_INT8_MATMUL_AVX_INT8_H_
+
+#include <stdbool.h>
+#include "nnacl/op_base.h"
+
+/* x86 int8 gemm in the dot product layout of arm64 sdot: row4x4-major * row4x16-major => row-major.
+ * Every 4 deep values of a row in A and of a column in B are adjacent, which is what one 32-bit lane of
+ * vpmaddwd(avx2/avx512bw) and vpdpbusd(avx512 vnni) consumes. */
+typedef void (*MatmulInt8DpFunc)(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                 size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                 const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                 int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel,
+                                 const int32_t *filter_zp);
+typedef void (*DynamicMatmulInt8DpFunc)(const int8_t *a, const int8_t *b, float *out, size_t deep4,
+                                        float *multi_scales, float *bias, size_t row, size_t col, size_t stride,
+                                        const int32_t *a_sums, const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef ENABLE_AVX
+/* the int32 results of a 4x16 tile are written to acc in row-major, the post functions requantize or dequantize it. */
+void MatmulInt8DpPost4x16(const int32_t *acc, int8_t *dst, size_t row, size_t col, size_t stride,
+                          const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel, const int32_t *filter_zp);
+void DynamicMatmulInt8DpPost4x16(const int32_t *acc, float *out, size_t row, size_t col, size_t stride,
+                                 const float *multi_scales, const float *bias, const int32_t *a_sums,
+                                 const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum);
+
+void MatmulInt8DpAvx2(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                      size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                      const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                      int32_t maxi, size_t per_channel, const int32_t *filter_zp);
+void DynamicMatmulAvx2_4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4, float *multi_scales,
+                                  float *bias, size_t row, size_t col, size_t stride, const int32_t *a_sums,
+                                  const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum);
+
+/* pick the widest kernel the running cpu supports. */
+MatmulInt8DpFunc GetMatmulInt8DpAvxFunc(void);
+DynamicMatmulInt8DpFunc GetDynamicMatmulInt8DpAvxFunc(void);
+#endif
+
+#ifdef ENABLE_AVX512
+void MatmulInt8DpAvx512(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                        size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                        const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                        int32_t maxi, size_t per_channel, const int32_t *filter_zp);
+void DynamicMatmulAvx512_4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4, float *multi_scales,
+                                    float *bias, size_t row, size_t col, size_t stride, const int32_t *a_sums,
+                                    const int32_t *b_sums, int64_t a_zp, int64_t b_zp_sum);
+void MatmulInt8DpAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                            size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                            const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                            int32_t maxi, size_t per_channel, const int32_t *filter_zp);
+void DynamicMatmulAvx512Vnni_4x4x16AIWI(const int8_t *a, const int8_t *b, float *out, size_t deep4,
+                                        float *multi_scales, float *bias, size_t row, size_t col, size_t stride,
+                                        const int32_t *a_sums, const int32_t *b_sums, int64_t a_zp,
+                                        int64_t b_zp_sum);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_INT8_MATMUL_AVX_INT8_H_
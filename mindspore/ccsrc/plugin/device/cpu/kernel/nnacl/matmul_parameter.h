@@ -35,6 +35,22 @@ typedef void (*MATMUL_OPT_DP_FUNC)(const int8_t *a, const int8_t *b, int8_t *dst
 
 typedef enum OutType { OutType_C8 = 0, OutType_Nhwc = 1, OutType_TileC8 = 2, OutType_NC4HW4 = 3 } OutType;
 
+// Post-ops fused into the fp32 matmul, applied in this order after bias and act_type_:
+// residual add (an extra input of the output shape), gelu, then layer norm (gamma and beta inputs of col_ values, over
+// the last axis) or softmax over the last axis. Extra inputs follow the bias in the same order.
+typedef enum MatmulEpilogueType {
+  MatmulEpilogue_None = 0,
+  MatmulEpilogue_ResidualAdd = 1,
+  MatmulEpilogue_Gelu = 2,
+  MatmulEpilogue_LayerNorm = 4,
+  MatmulEpilogue_Softmax = 8,
+} MatmulEpilogueType;
+
+// number of extra inputs after the bias: residual, then gamma and beta.
+static inline int MatmulEpilogueInputNum(int epilogue) {
+  return ((epilogue & MatmulEpilogue_ResidualAdd) ? 1 : 0) + ((epilogue & MatmulEpilogue_LayerNorm) ? 2 : 0);
+}
+
 typedef struct MatMulParameter {
   // Primitive parameter
   OpParameter op_parameter_;
@@ -63,6 +79,9 @@ typedef struct MatMulParameter {
   ActType act_type_;
   bool use_axis_;
   int axis_;
+  int epilogue_;  // MatmulEpilogueType flags
+  bool gelu_approximate_;
+  float epilogue_epsilon_;
 } MatMulParameter;
 
 typedef struct MatmulQuantParameter {
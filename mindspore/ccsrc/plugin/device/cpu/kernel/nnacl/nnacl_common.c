@@ -55,3 +55,20 @@ uint16_t Float32ToShort(float src_value) {
   res |= (src_value_bits.u & 0x80000000) >> 16;
   return res;
 }
+
+float BF16ToFloat32(uint16_t src_value) {
+  float32_bits o;
+  o.u = (unsigned int)src_value << 16;
+  return o.f;
+}
+
+uint16_t Float32ToBF16(float src_value) {
+  float32_bits src_value_bits;
+  src_value_bits.f = src_value;
+  if ((src_value_bits.u & 0x7fffffff) > 0x7f800000) {
+    // keep nan a quiet nan instead of rounding it to inf
+    return (uint16_t)((src_value_bits.u >> 16) | 0x40);
+  }
+  unsigned int rounding_bias = 0x7fff + ((src_value_bits.u >> 16) & 1);
+  return (uint16_t)((src_value_bits.u + rounding_bias) >> 16);
+}
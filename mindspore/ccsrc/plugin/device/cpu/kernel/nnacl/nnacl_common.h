@@ -53,6 +53,9 @@ static const int FP16_EXPONENT_MAX = 30;
 static const int FP16_EXPONENT_MIN = -10;
 float ShortToFloat32(uint16_t src_value);
 uint16_t Float32ToShort(float src_value);
+// bfloat16 is the high half of a float32, the conversion from float32 rounds to nearest even.
+float BF16ToFloat32(uint16_t src_value);
+uint16_t Float32ToBF16(float src_value);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,173 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_RADIX_SORT_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_RADIX_SORT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "include/common/thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+constexpr size_t kRadixBits = 8;
+constexpr size_t kRadixSize = 1 << kRadixBits;
+constexpr uint32_t kRadixMask = kRadixSize - 1;
+constexpr size_t kRadixPassNum = sizeof(uint32_t) * 8 / kRadixBits;
+// Below this a thread spends more time on its histogram than on its keys.
+constexpr size_t kRadixMinTaskSize = 16384;
+
+// Maps a float to an unsigned key of the same order. -0.0 and 0.0 compare equal, so they share a key.
+inline uint32_t RadixKey(float value) {
+  constexpr uint32_t kSignBit = 0x80000000u;
+  uint32_t bits = 0;
+  (void)memcpy(&bits, &value, sizeof(bits));
+  if (bits == kSignBit) {
+    bits = 0;
+  }
+  return (bits & kSignBit) != 0 ? ~bits : (bits | kSignBit);
+}
+
+template <typename T>
+uint32_t RadixKey(T value) {
+  return RadixKey(static_cast<float>(value));
+}
+
+inline size_t RadixTaskNum(size_t size, size_t thread_num) {
+  return std::max<size_t>(1, std::min(thread_num, size / kRadixMinTaskSize));
+}
+
+// Runs func(task_id) for every task, inline when there is a single one so it can be called from inside a task.
+template <typename Func>
+void RunRadixTasks(size_t task_num, const Func &func) {
+  if (task_num <= 1) {
+    func(0);
+    return;
+  }
+  std::vector<common::Task> tasks;
+  tasks.reserve(task_num);
+  for (size_t i = 0; i < task_num; ++i) {
+    (void)tasks.emplace_back([&func, i]() {
+      func(i);
+      return common::SUCCESS;
+    });
+  }
+  ParallelLaunch(tasks);
+}
+
+// Stable ascending LSD radix sort of keys together with their values. tmp_keys and tmp_values hold size elements each,
+// the result is left in keys and values. Every pass counts digits per thread chunk and scatters the chunks in order,
+// and passes whose digit is the same for all keys are skipped.
+template <typename V>
+void RadixSortPairs(uint32_t *keys, V *values, uint32_t *tmp_keys, V *tmp_values, size_t size, size_t thread_num) {
+  size_t task_num = RadixTaskNum(size, thread_num);
+  size_t chunk = (size + task_num - 1) / task_num;
+  std::vector<size_t> offsets(task_num * kRadixSize);
+  uint32_t *src_keys = keys;
+  V *src_values = values;
+  uint32_t *dst_keys = tmp_keys;
+  V *dst_values = tmp_values;
+  for (size_t pass = 0; pass < kRadixPassNum; ++pass) {
+    size_t shift = pass * kRadixBits;
+    std::fill(offsets.begin(), offsets.end(), 0);
+    RunRadixTasks(task_num, [&](size_t task_id) {
+      size_t *count = offsets.data() + task_id * kRadixSize;
+      size_t end = std::min(size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; ++i) {
+        count[(src_keys[i] >> shift) & kRadixMask]++;
+      }
+    });
+    // digit major, task minor, so equal digits keep their input order.
+    size_t offset = 0;
+    bool skip = false;
+    for (size_t digit = 0; digit < kRadixSize && !skip; ++digit) {
+      size_t digit_begin = offset;
+      for (size_t task_id = 0; task_id < task_num; ++task_id) {
+        size_t count = offsets[task_id * kRadixSize + digit];
+        offsets[task_id * kRadixSize + digit] = offset;
+        offset += count;
+      }
+      skip = offset - digit_begin == size;
+    }
+    if (skip) {
+      continue;
+    }
+    RunRadixTasks(task_num, [&](size_t task_id) {
+      size_t *offset_ptr = offsets.data() + task_id * kRadixSize;
+      size_t end = std::min(size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; ++i) {
+        size_t pos = offset_ptr[(src_keys[i] >> shift) & kRadixMask]++;
+        dst_keys[pos] = src_keys[i];
+        dst_values[pos] = src_values[i];
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+  if (src_keys != keys) {
+    (void)std::copy(src_keys, src_keys + size, keys);
+    (void)std::copy(src_values, src_values + size, values);
+  }
+}
+
+// Returns the key of the k-th largest of key(0) ... key(size - 1), 1 <= k <= size, and sets greater_num to the number
+// of keys strictly larger than it. Each pass fixes one more digit of the answer from the most significant one,
+// counting only the keys that match the digits fixed so far.
+template <typename KeyFunc>
+uint32_t RadixSelect(const KeyFunc &key, size_t size, size_t k, size_t thread_num, size_t *greater_num) {
+  size_t task_num = RadixTaskNum(size, thread_num);
+  size_t chunk = (size + task_num - 1) / task_num;
+  std::vector<size_t> counts(task_num * kRadixSize);
+  uint32_t prefix = 0;
+  uint32_t prefix_mask = 0;
+  size_t remain = k;
+  size_t greater = 0;
+  for (size_t pass = kRadixPassNum; pass-- > 0;) {
+    size_t shift = pass * kRadixBits;
+    std::fill(counts.begin(), counts.end(), 0);
+    RunRadixTasks(task_num, [&](size_t task_id) {
+      size_t *count = counts.data() + task_id * kRadixSize;
+      size_t end = std::min(size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; ++i) {
+        uint32_t value = key(i);
+        if ((value & prefix_mask) == prefix) {
+          count[(value >> shift) & kRadixMask]++;
+        }
+      }
+    });
+    for (size_t digit = kRadixSize; digit-- > 0;) {
+      size_t count = 0;
+      for (size_t task_id = 0; task_id < task_num; ++task_id) {
+        count += counts[task_id * kRadixSize + digit];
+      }
+      if (count >= remain) {
+        prefix |= static_cast<uint32_t>(digit) << shift;
+        prefix_mask |= kRadixMask << shift;
+        break;
+      }
+      remain -= count;
+      greater += count;
+    }
+  }
+  *greater_num = greater;
+  return prefix;
+}
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_RADIX_SORT_H_
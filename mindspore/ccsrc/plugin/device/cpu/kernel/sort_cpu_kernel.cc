@@ -17,9 +17,18 @@
 #include <algorithm>
 #include <utility>
 #include "include/common/thread_pool.h"
+#include "plugin/device/cpu/kernel/radix_sort.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Axes at least this long are radix sorted, shorter ones are not worth the key and ping-pong workspaces.
+constexpr size_t kRadixSortThreshold = 256;
+constexpr size_t kKeysIndex = 1;
+constexpr size_t kTmpKeysIndex = 2;
+constexpr size_t kTmpIdsIndex = 3;
+}  // namespace
+
 void SortCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   kernel_name_ = common::AnfAlgo::GetCNodeName(kernel_node);
@@ -45,6 +54,7 @@ void SortCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
   }
 
   axisIterator_.Init(input_shape, axis_t);
+  radix_sort_ = axisIterator_.AxisSize() >= kRadixSortThreshold;
 
   auto kernel_attr = GetKernelAttrFromNode(kernel_node);
   auto [is_match, index] = MatchKernelAttr(kernel_attr, GetOpSupport());
@@ -59,6 +69,60 @@ void SortCpuKernelMod::InitInputOutputSize(const CNodePtr &kernel_node) {
   size_t element_size = axisIterator_.OuterSize() * axisIterator_.InnerSize() * axisIterator_.AxisSize();
   // id
   (void)workspace_size_list_.emplace_back((sizeof(size_t) * element_size));
+  if (radix_sort_) {
+    // keys and the ping-pong buffers of the radix passes
+    (void)workspace_size_list_.emplace_back((sizeof(uint32_t) * element_size));
+    (void)workspace_size_list_.emplace_back((sizeof(uint32_t) * element_size));
+    (void)workspace_size_list_.emplace_back((sizeof(size_t) * element_size));
+  }
+}
+
+template <typename T>
+void SortCpuKernelMod::RadixSort(const T *input, const std::vector<AddressPtr> &workspace, T *output, int *indices) {
+  if (workspace.size() <= kTmpIdsIndex) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the number of workspaces must be " << (kTmpIdsIndex + 1)
+                      << ", but got " << workspace.size();
+  }
+  auto ids_addr = reinterpret_cast<size_t *>(workspace[0]->addr);
+  auto keys_addr = reinterpret_cast<uint32_t *>(workspace[kKeysIndex]->addr);
+  auto tmp_keys_addr = reinterpret_cast<uint32_t *>(workspace[kTmpKeysIndex]->addr);
+  auto tmp_ids_addr = reinterpret_cast<size_t *>(workspace[kTmpIdsIndex]->addr);
+  size_t axis_size = axisIterator_.AxisSize();
+  // the descending order is the ascending order of the inverted keys, equal keys keep their index order either way.
+  uint32_t key_mask = descending_ ? UINT32_MAX : 0;
+  auto sort_slice = [&, this](size_t index, size_t thread_num) {
+    AxisIterator iter(axisIterator_);
+    iter.SetOffset(index);
+    size_t offset = index * axis_size;
+    size_t *idx = ids_addr + offset;
+    uint32_t *keys = keys_addr + offset;
+    for (size_t k = 0; k < axis_size; ++k) {
+      idx[k] = iter.GetPos(k);
+      keys[k] = RadixKey(input[idx[k]]) ^ key_mask;
+    }
+    RadixSortPairs(keys, idx, tmp_keys_addr + offset, tmp_ids_addr + offset, axis_size, thread_num);
+    for (size_t k = 0; k < axis_size; ++k) {
+      const auto output_index = iter.GetPos(k);
+      indices[output_index] = SizeToInt(iter.RevertPos(idx[k]));
+      output[output_index] = input[idx[k]];
+    }
+  };
+
+  size_t slice_num = axisIterator_.OuterSize() * axisIterator_.InnerSize();
+  size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  if (slice_num >= thread_num) {
+    auto task = [&sort_slice](size_t start, size_t end) {
+      for (size_t index = start; index < end; index++) {
+        sort_slice(index, 1);
+      }
+    };
+    ParallelLaunchAutoSearch(task, slice_num, this, &parallel_search_info_);
+  } else {
+    // too few slices to go around, every slice is sorted by all threads.
+    for (size_t index = 0; index < slice_num; index++) {
+      sort_slice(index, thread_num);
+    }
+  }
 }
 
 template <typename T>
@@ -87,6 +151,11 @@ bool SortCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, const
                       << outputs[0]->size << " and the memory size of input " << inputs[0]->size;
   }
 
+  if (radix_sort_) {
+    RadixSort(input, workspace, output, indices);
+    return true;
+  }
+
   std::function<bool(size_t, size_t)> comparator;
   if (descending_) {
     comparator = [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; };
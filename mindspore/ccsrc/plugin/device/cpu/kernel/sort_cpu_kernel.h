@@ -44,6 +44,8 @@ class SortCpuKernelMod : public DeprecatedNativeCpuKernelMod {
   template <typename T>
   bool LaunchKernel(const std::vector<kernel::AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
                     const std::vector<kernel::AddressPtr> &outputs);
+  template <typename T>
+  void RadixSort(const T *input, const std::vector<AddressPtr> &workspace, T *output, int *indices);
   using SortFunc = std::function<bool(SortCpuKernelMod *, const std::vector<kernel::AddressPtr> &,
                                       const std::vector<AddressPtr> &, const std::vector<kernel::AddressPtr> &)>;
   static std::vector<std::pair<KernelAttr, SortFunc>> func_list_;
@@ -51,6 +53,7 @@ class SortCpuKernelMod : public DeprecatedNativeCpuKernelMod {
 
   AxisIterator axisIterator_{};
   bool descending_{false};
+  bool radix_sort_{false};
 };
 }  // namespace kernel
 }  // namespace mindspore
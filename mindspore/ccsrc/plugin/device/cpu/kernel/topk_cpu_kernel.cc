@@ -18,14 +18,79 @@
 #include <algorithm>
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "include/common/thread_pool.h"
+#include "plugin/device/cpu/kernel/radix_sort.h"
+#include "plugin/device/cpu/kernel/nnacl/op_base.h"
 
 namespace mindspore {
 namespace kernel {
 namespace {
 constexpr size_t kTopKInputsNum = 2;
 constexpr size_t kTopKOutputsNum = 2;
+// Rows at least this long are selected by radix when there are too few of them to keep every thread busy.
+constexpr size_t kRadixTopKThreshold = 32768;
 }  // namespace
 
+template <typename T>
+void TopKCpuKernelMod::RadixTopK(const T *input, size_t k_num, size_t *workspace, T *output, int *indices) {
+  size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  size_t task_num = RadixTaskNum(inner_size_, thread_num);
+  size_t chunk = UP_DIV(inner_size_, task_num);
+  std::vector<size_t> greater_offsets(task_num);
+  std::vector<size_t> tie_offsets(task_num);
+  for (size_t i = 0; i < outer_size_; ++i) {
+    const T *row = input + i * inner_size_;
+    size_t *idx = workspace + i * inner_size_;
+    auto key = [row](size_t j) { return RadixKey(row[j]); };
+    size_t greater_num = 0;
+    uint32_t threshold = RadixSelect(key, inner_size_, k_num, thread_num, &greater_num);
+
+    // the larger keys come first in index order, then the lowest indices of the keys equal to the k-th one.
+    RunRadixTasks(task_num, [&](size_t task_id) {
+      size_t greater = 0;
+      size_t tie = 0;
+      size_t end = std::min(inner_size_, (task_id + 1) * chunk);
+      for (size_t j = task_id * chunk; j < end; ++j) {
+        uint32_t value = key(j);
+        greater += value > threshold ? 1 : 0;
+        tie += value == threshold ? 1 : 0;
+      }
+      greater_offsets[task_id] = greater;
+      tie_offsets[task_id] = tie;
+    });
+    size_t greater_offset = 0;
+    size_t tie_offset = greater_num;
+    for (size_t task_id = 0; task_id < task_num; ++task_id) {
+      size_t greater = greater_offsets[task_id];
+      size_t tie = tie_offsets[task_id];
+      greater_offsets[task_id] = greater_offset;
+      tie_offsets[task_id] = tie_offset;
+      greater_offset += greater;
+      tie_offset += tie;
+    }
+    RunRadixTasks(task_num, [&](size_t task_id) {
+      size_t greater_pos = greater_offsets[task_id];
+      size_t tie_pos = tie_offsets[task_id];
+      size_t end = std::min(inner_size_, (task_id + 1) * chunk);
+      for (size_t j = task_id * chunk; j < end; ++j) {
+        uint32_t value = key(j);
+        if (value > threshold) {
+          idx[greater_pos++] = j;
+        } else if (value == threshold && tie_pos < k_num) {
+          idx[tie_pos++] = j;
+        }
+      }
+    });
+
+    if (sorted_) {
+      std::stable_sort(idx, idx + k_num, [row](size_t index_1, size_t index_2) { return row[index_1] > row[index_2]; });
+    }
+    for (size_t j = 0; j < k_num; ++j) {
+      indices[i * k_num + j] = SizeToInt(idx[j]);
+      output[i * k_num + j] = row[idx[j]];
+    }
+  }
+}
+
 template <typename T>
 void TopKCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspaces,
                                     const std::vector<AddressPtr> &outputs) {
@@ -52,6 +117,12 @@ void TopKCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, const
     MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', address size of output error.";
   }
 
+  if (inner_size_ >= kRadixTopKThreshold &&
+      outer_size_ < common::ThreadPool::GetInstance().GetSyncRunThreadNum()) {
+    RadixTopK(input, k_num, workspace, output, indices);
+    return;
+  }
+
   const std::function<bool(size_t, size_t)> comparator = [input](size_t index_1, size_t index_2) {
     return input[index_1] > input[index_2];
   };
@@ -41,6 +41,9 @@ class TopKCpuKernelMod : public DeprecatedNativeCpuKernelMod {
   template <typename T>
   void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspaces,
                     const std::vector<AddressPtr> &outputs);
+  // One row at a time with all threads, for a few long rows.
+  template <typename T>
+  void RadixTopK(const T *input, size_t k_num, size_t *workspace, T *output, int *indices);
   size_t outer_size_{1};
   size_t inner_size_{1};
   bool sorted_{false};
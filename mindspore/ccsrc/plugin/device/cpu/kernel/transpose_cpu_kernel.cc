@@ -14,10 +14,9 @@
  * limitations under the License.
  */
 
-#include <complex>
+#include <algorithm>
 #include <vector>
 #include "nnacl/errorcode.h"
-#include "include/common/thread_pool.h"
 #include "plugin/device/cpu/kernel/transpose_cpu_kernel.h"
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 
@@ -26,18 +25,6 @@ namespace kernel {
 namespace {
 constexpr size_t kTransposeInputsNum = 1;
 constexpr size_t kTransposeOutputsNum = 1;
-constexpr size_t kIndex0 = 0;
-constexpr size_t kIndex1 = 1;
-constexpr size_t kIndex2 = 2;
-constexpr size_t kIndex3 = 3;
-constexpr size_t kIndex4 = 4;
-constexpr size_t kIndex5 = 5;
-constexpr size_t kIndex6 = 6;
-constexpr size_t kIndex7 = 7;
-using complex64 = std::complex<float>;
-using complex128 = std::complex<double>;
-// kMaxTransposeSerialSize = 64 * 3 * 512 * 512
-constexpr size_t kMaxTransposeSerialSize = 50331648;
 }  // namespace
 
 void TransposeFwdCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
@@ -45,12 +32,12 @@ void TransposeFwdCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
   kernel_name_ = common::AnfAlgo::GetCNodeName(kernel_node);
   input_shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   output_shape_ = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  auto perm = common::AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, "perm");
-  for (auto p : perm) {
-    p = (p >= 0) ? p : (perm.size() + p);
+  auto perm_attr = common::AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, "perm");
+  for (auto p : perm_attr) {
+    p = (p >= 0) ? p : (perm_attr.size() + p);
     if (p < 0) {
-      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the perm value must be in [-" << perm.size() << ", "
-                        << (perm.size() - 1) << "], but got " << perm;
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the perm value must be in [-" << perm_attr.size() << ", "
+                        << (perm_attr.size() - 1) << "], but got " << perm_attr;
     }
     axes_.emplace_back(p);
   }
@@ -59,37 +46,21 @@ void TransposeFwdCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
     MS_LOG(EXCEPTION) << "Transpose support max dimension is " << MAX_TRANSPOSE_DIM_SIZE << "D, but got "
                       << axes_.size() << "D.";
   }
-  for (size_t i = 0; i < axes_.size(); ++i) {
-    transpose_param_.perm_[i] = SizeToInt(axes_[i]);
+  if (axes_.size() != input_shape_.size()) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the length of perm must be equal to the rank of input, but got "
+                      << axes_.size() << " and " << input_shape_.size() << ".";
   }
-  size_t num_axes = input_shape_.size();
-  transpose_param_.perm_size_ = axes_.size();
-  transpose_param_.num_axes_ = SizeToInt(num_axes);
-  transpose_param_.strides_[num_axes - 1] = 1;
-  transpose_param_.out_strides_[num_axes - 1] = 1;
-  for (size_t i = num_axes - 1; i >= 1; i--) {
-    transpose_param_.strides_[i - 1] = input_shape_[i] * transpose_param_.strides_[i];
-    transpose_param_.out_strides_[i - 1] = output_shape_[i] * transpose_param_.out_strides_[i];
+  int in_shape[MAX_TRANSPOSE_DIM_SIZE] = {1};
+  int perm[MAX_TRANSPOSE_DIM_SIZE] = {0};
+  for (size_t i = 0; i < axes_.size(); ++i) {
+    in_shape[i] = LongToInt(input_shape_[i]);
+    perm[i] = SizeToInt(axes_[i]);
   }
-  launch_map_[kNumberTypeBool] = &TransposeFwdCpuKernelMod::LaunchKernel<bool>;
-  launch_map_[kNumberTypeInt8] = &TransposeFwdCpuKernelMod::LaunchKernel<int8_t>;
-  launch_map_[kNumberTypeInt16] = &TransposeFwdCpuKernelMod::LaunchKernel<int16_t>;
-  launch_map_[kNumberTypeInt32] = &TransposeFwdCpuKernelMod::LaunchKernel<int32_t>;
-  launch_map_[kNumberTypeInt64] = &TransposeFwdCpuKernelMod::LaunchKernel<int64_t>;
-  launch_map_[kNumberTypeUInt8] = &TransposeFwdCpuKernelMod::LaunchKernel<uint8_t>;
-  launch_map_[kNumberTypeUInt16] = &TransposeFwdCpuKernelMod::LaunchKernel<uint16_t>;
-  launch_map_[kNumberTypeUInt32] = &TransposeFwdCpuKernelMod::LaunchKernel<uint32_t>;
-  launch_map_[kNumberTypeUInt64] = &TransposeFwdCpuKernelMod::LaunchKernel<uint64_t>;
-  launch_map_[kNumberTypeFloat16] = &TransposeFwdCpuKernelMod::LaunchKernel<float16>;
-  launch_map_[kNumberTypeFloat32] = &TransposeFwdCpuKernelMod::LaunchKernel<float>;
-  launch_map_[kNumberTypeFloat64] = &TransposeFwdCpuKernelMod::LaunchKernel<double>;
-  launch_map_[kNumberTypeComplex64] = &TransposeFwdCpuKernelMod::LaunchKernel<complex64>;
-  launch_map_[kNumberTypeComplex128] = &TransposeFwdCpuKernelMod::LaunchKernel<complex128>;
-  auto iter = launch_map_.find(dtype_);
-  if (iter != launch_map_.end()) {
-    launch_func_ = iter->second;
-  } else {
-    MS_LOG(EXCEPTION) << "Unsupported input data type: " << dtype_;
+  int num_axes = std::max(SizeToInt(axes_.size()), 1);
+  int data_size = SizeToInt(GetTypeByte(TypeIdToType(dtype_)));
+  if (TiledTransposeInit(&tiled_info_, in_shape, perm, num_axes, data_size) != NNACL_OK) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the perm " << perm_attr << " is invalid for input shape "
+                      << input_shape_ << ".";
   }
 }
 
@@ -98,343 +69,15 @@ bool TransposeFwdCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inp
                                       const std::vector<kernel::AddressPtr> &outputs) {
   CHECK_KERNEL_INPUTS_NUM(inputs.size(), kTransposeInputsNum, kernel_name_);
   CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kTransposeOutputsNum, kernel_name_);
-  launch_func_(this, inputs, outputs);
+  const auto *input_addr = inputs[0]->addr;
+  auto *output_addr = outputs[0]->addr;
+  auto task = [this, input_addr, output_addr](size_t start, size_t end) {
+    TiledTranspose(input_addr, output_addr, &tiled_info_, SizeToLong(start), SizeToLong(end));
+  };
+  ParallelLaunchAutoSearch(task, LongToSize(tiled_info_.unit_num_), this, &parallel_search_info_);
   return true;
 }
 
-template <typename T>
-void TransposeFwdCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs,
-                                            const std::vector<AddressPtr> &outputs) {
-  const auto *input_addr = reinterpret_cast<T *>(inputs[0]->addr);
-  auto *output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  transpose_param_.data_num_ = SizeToInt(inputs[0]->size / sizeof(T));
-  int output_shape[SizeToInt(output_shape_.size())];
-  for (size_t i = 0; i < output_shape_.size(); ++i) {
-    output_shape[i] = output_shape_[i];
-  }
-  size_t data_count = (inputs[0]->size) / sizeof(T);
-  if (axes_.size() > kIndex7 || data_count >= kMaxTransposeSerialSize) {
-    ParallelRun(input_addr, output_addr, output_shape, data_count, &transpose_param_);
-    return;
-  }
-  bool res{static_cast<bool>(NNACL_OK)};
-  res = DoTranspose(input_addr, output_addr, output_shape, &transpose_param_);
-  if (res != static_cast<bool>(NNACL_OK)) {
-    MS_LOG(EXCEPTION) << "Transpose run failed.";
-  }
-}
-
-template <typename T>
-int TransposeFwdCpuKernelMod::DoTranspose(const T *in_data, T *out_data, const int *output_shape,
-                                          const TransposeParameter *transpose_param) {
-  NNACL_CHECK_NULL_RETURN_ERR(in_data);
-  NNACL_CHECK_NULL_RETURN_ERR(out_data);
-  NNACL_CHECK_NULL_RETURN_ERR(output_shape);
-  NNACL_CHECK_NULL_RETURN_ERR(transpose_param);
-  const int *perm = transpose_param->perm_;
-  const int *strides = transpose_param->strides_;
-  const int *out_strides = transpose_param->out_strides_;
-  int data_size = transpose_param->data_num_ * sizeof(T);
-  int num_axes = transpose_param->num_axes_;
-  bool needTranspose = false;
-  for (size_t i = 1; i < (unsigned int)num_axes; ++i) {
-    if (perm[i] - perm[i - 1] != 1) {
-      needTranspose = true;
-      break;
-    }
-  }
-  if (!needTranspose) {
-    (void)memcpy(out_data, in_data, data_size);
-    return NNACL_OK;
-  }
-  for (size_t i = 0; i < (unsigned int)num_axes; ++i) {
-    if (perm[i] < 0) {
-      return NNACL_PARAM_INVALID;
-    }
-  }
-  if (num_axes == kIndex2) {
-    TransposeDim2(in_data, out_data, strides, out_strides, perm, output_shape);
-  } else if (num_axes == kIndex3) {
-    TransposeDim3(in_data, out_data, strides, out_strides, perm, output_shape);
-  } else if (num_axes == kIndex4) {
-    TransposeDim4(in_data, out_data, strides, out_strides, perm, output_shape);
-  } else if (num_axes == kIndex5) {
-    TransposeDim5(in_data, out_data, strides, out_strides, perm, output_shape);
-  } else if (num_axes == kIndex6) {
-    TransposeDim6(in_data, out_data, strides, out_strides, perm, output_shape);
-  } else if (num_axes == kIndex7) {
-    TransposeDim7(in_data, out_data, strides, out_strides, perm, output_shape);
-  } else {
-    return NNACL_ERR;
-  }
-  return NNACL_OK;
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::TransposeDim2(const T *in_data, T *out_data, const int *strides, const int *out_strides,
-                                             const int *perm, const int *output_shape) {
-  const int stride0 = strides[perm[kIndex0]];
-  const int stride1 = strides[perm[kIndex1]];
-  const int output0 = output_shape[kIndex0];
-  const int output1 = output_shape[kIndex1];
-  for (size_t i = 0; i < (unsigned int)output0; ++i) {
-    size_t out_stride0_i = i * output1;
-    size_t stride0_i = i * 1 * stride0;
-    for (size_t j = 0; j < (unsigned int)output1; ++j) {
-      out_data[out_stride0_i + j] = in_data[stride0_i + j * stride1];
-    }
-  }
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::TransposeDim3(const T *in_data, T *out_data, const int *strides, const int *out_strides,
-                                             const int *perm, const int *output_shape) {
-  const int stride0 = strides[perm[kIndex0]];
-  const int stride1 = strides[perm[kIndex1]];
-  const int stride2 = strides[perm[kIndex2]];
-  const int out_stride0 = out_strides[kIndex0];
-  const int out_stride1 = out_strides[kIndex1];
-  const int output0 = output_shape[kIndex0];
-  const int output1 = output_shape[kIndex1];
-  const int output2 = output_shape[kIndex2];
-  for (size_t i = 0; i < (unsigned int)output0; ++i) {
-    size_t out_stride0_i = i * out_stride0;
-    size_t stride0_i = i * stride0;
-    for (size_t j = 0; j < (unsigned int)output1; ++j) {
-      size_t out_stride1_j = j * out_stride1;
-      size_t stride1_j = j * stride1;
-      for (size_t k = 0; k < (unsigned int)output2; ++k) {
-        out_data[out_stride0_i + out_stride1_j + k] = in_data[stride0_i + stride1_j + k * stride2];
-      }
-    }
-  }
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::TransposeDim4(const T *in_data, T *out_data, const int *strides, const int *out_strides,
-                                             const int *perm, const int *output_shape) {
-  const int stride0 = strides[perm[kIndex0]];
-  const int stride1 = strides[perm[kIndex1]];
-  const int stride2 = strides[perm[kIndex2]];
-  const int stride3 = strides[perm[kIndex3]];
-  const int out_stride0 = out_strides[kIndex0];
-  const int out_stride1 = out_strides[kIndex1];
-  const int out_stride2 = out_strides[kIndex2];
-  const int output0 = output_shape[kIndex0];
-  const int output1 = output_shape[kIndex1];
-  const int output2 = output_shape[kIndex2];
-  const int output3 = output_shape[kIndex3];
-  for (size_t i = 0; i < (unsigned int)output0; ++i) {
-    size_t out_stride0_i = i * out_stride0;
-    size_t stride0_i = i * stride0;
-    for (size_t j = 0; j < (unsigned int)output1; ++j) {
-      size_t out_stride1_j = j * out_stride1;
-      size_t stride1_j = j * stride1;
-      for (size_t k = 0; k < (unsigned int)output2; ++k) {
-        size_t out_stride2_k = k * out_stride2;
-        size_t stride2_k = k * stride2;
-        for (size_t m = 0; m < (unsigned int)output3; ++m) {
-          out_data[out_stride0_i + out_stride1_j + out_stride2_k + m] =
-            in_data[stride0_i + stride1_j + stride2_k + m * stride3];
-        }
-      }
-    }
-  }
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::TransposeDim5(const T *in_data, T *out_data, const int *strides, const int *out_strides,
-                                             const int *perm, const int *output_shape) {
-  const int stride0 = strides[perm[kIndex0]];
-  const int stride1 = strides[perm[kIndex1]];
-  const int stride2 = strides[perm[kIndex2]];
-  const int stride3 = strides[perm[kIndex3]];
-  const int stride4 = strides[perm[kIndex4]];
-  const int out_stride0 = out_strides[kIndex0];
-  const int out_stride1 = out_strides[kIndex1];
-  const int out_stride2 = out_strides[kIndex2];
-  const int out_stride3 = out_strides[kIndex3];
-  const int output0 = output_shape[kIndex0];
-  const int output1 = output_shape[kIndex1];
-  const int output2 = output_shape[kIndex2];
-  const int output3 = output_shape[kIndex3];
-  const int output4 = output_shape[kIndex4];
-  for (size_t i = 0; i < (unsigned int)output0; ++i) {
-    size_t out_stride0_i = i * out_stride0;
-    size_t stride0_i = i * stride0;
-    for (size_t j = 0; j < (unsigned int)output1; ++j) {
-      size_t out_stride1_j = j * out_stride1;
-      size_t stride1_j = j * stride1;
-      for (size_t k = 0; k < (unsigned int)output2; ++k) {
-        size_t out_stride2_k = k * out_stride2;
-        size_t stride2_k = k * stride2;
-        for (size_t m = 0; m < (unsigned int)output3; ++m) {
-          size_t out_stride3_m = m * out_stride3;
-          size_t stride3_m = m * stride3;
-          for (size_t n = 0; n < (unsigned int)output4; ++n) {
-            out_data[out_stride0_i + out_stride1_j + out_stride2_k + out_stride3_m + n] =
-              in_data[stride0_i + stride1_j + stride2_k + stride3_m + n * stride4];
-          }
-        }
-      }
-    }
-  }
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::TransposeDim6(const T *in_data, T *out_data, const int *strides, const int *out_strides,
-                                             const int *perm, const int *output_shape) {
-  const int stride0 = strides[perm[kIndex0]];
-  const int stride1 = strides[perm[kIndex1]];
-  const int stride2 = strides[perm[kIndex2]];
-  const int stride3 = strides[perm[kIndex3]];
-  const int stride4 = strides[perm[kIndex4]];
-  const int stride5 = strides[perm[kIndex5]];
-  const int out_stride0 = out_strides[kIndex0];
-  const int out_stride1 = out_strides[kIndex1];
-  const int out_stride2 = out_strides[kIndex2];
-  const int out_stride3 = out_strides[kIndex3];
-  const int out_stride4 = out_strides[kIndex4];
-  const int output0 = output_shape[kIndex0];
-  const int output1 = output_shape[kIndex1];
-  const int output2 = output_shape[kIndex2];
-  const int output3 = output_shape[kIndex3];
-  const int output4 = output_shape[kIndex4];
-  const int output5 = output_shape[kIndex5];
-  for (size_t i = 0; i < (unsigned int)output0; ++i) {
-    size_t out_stride0_i = i * out_stride0;
-    size_t stride0_i = i * stride0;
-    for (size_t j = 0; j < (unsigned int)output1; ++j) {
-      size_t out_stride1_j = j * out_stride1;
-      size_t stride1_j = j * stride1;
-      for (size_t k = 0; k < (unsigned int)output2; ++k) {
-        size_t out_stride2_k = k * out_stride2;
-        size_t stride2_k = k * stride2;
-        for (size_t m = 0; m < (unsigned int)output3; ++m) {
-          size_t out_stride3_m = m * out_stride3;
-          size_t stride3_m = m * stride3;
-          for (size_t n = 0; n < (unsigned int)output4; ++n) {
-            size_t out_stride4_n = n * out_stride4;
-            size_t stride4_n = n * stride4;
-            for (size_t g = 0; g < (unsigned int)output5; ++g) {
-              out_data[out_stride0_i + out_stride1_j + out_stride2_k + out_stride3_m + out_stride4_n + g] =
-                in_data[stride0_i + stride1_j + stride2_k + stride3_m + stride4_n + g * stride5];
-            }
-          }
-        }
-      }
-    }
-  }
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::TransposeDim7(const T *in_data, T *out_data, const int *strides, const int *out_strides,
-                                             const int *perm, const int *output_shape) {
-  const int stride0 = strides[perm[kIndex0]];
-  const int stride1 = strides[perm[kIndex1]];
-  const int stride2 = strides[perm[kIndex2]];
-  const int stride3 = strides[perm[kIndex3]];
-  const int stride4 = strides[perm[kIndex4]];
-  const int stride5 = strides[perm[kIndex5]];
-  const int stride6 = strides[perm[kIndex6]];
-  const int out_stride0 = out_strides[kIndex0];
-  const int out_stride1 = out_strides[kIndex1];
-  const int out_stride2 = out_strides[kIndex2];
-  const int out_stride3 = out_strides[kIndex3];
-  const int out_stride4 = out_strides[kIndex4];
-  const int out_stride5 = out_strides[kIndex5];
-  const int output0 = output_shape[kIndex0];
-  const int output1 = output_shape[kIndex1];
-  const int output2 = output_shape[kIndex2];
-  const int output3 = output_shape[kIndex3];
-  const int output4 = output_shape[kIndex4];
-  const int output5 = output_shape[kIndex5];
-  const int output6 = output_shape[kIndex6];
-  for (size_t i = 0; i < (unsigned int)output0; ++i) {
-    size_t out_stride0_i = i * out_stride0;
-    size_t stride0_i = i * stride0;
-    for (size_t j = 0; j < (unsigned int)output1; ++j) {
-      size_t out_stride1_j = j * out_stride1;
-      size_t stride1_j = j * stride1;
-      for (size_t k = 0; k < (unsigned int)output2; ++k) {
-        size_t out_stride2_k = k * out_stride2;
-        size_t stride2_k = k * stride2;
-        for (size_t m = 0; m < (unsigned int)output3; ++m) {
-          size_t out_stride3_m = m * out_stride3;
-          size_t stride3_m = m * stride3;
-          for (size_t n = 0; n < (unsigned int)output4; ++n) {
-            size_t out_stride4_n = n * out_stride4;
-            size_t stride4_n = n * stride4;
-            for (size_t g = 0; g < (unsigned int)output5; ++g) {
-              size_t out_stride5_g = g * out_stride5;
-              size_t stride5_g = g * stride5;
-              for (size_t s = 0; s < (unsigned int)output6; ++s) {
-                out_data[out_stride0_i + out_stride1_j + out_stride2_k + out_stride3_m + out_stride4_n + out_stride5_g +
-                         s] =
-                  in_data[stride0_i + stride1_j + stride2_k + stride3_m + stride4_n + stride5_g + s * stride6];
-              }
-            }
-          }
-        }
-      }
-    }
-  }
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::ParallelRun(const T *input_addr, T *output_addr, const int *output_shape, size_t count,
-                                           const TransposeParameter *transpose_param) {
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  const float block_size = 128.0;
-  const size_t thread_num =
-    count < block_size * max_thread_num ? FloatToSize(std::ceil(count / block_size)) : max_thread_num;
-  std::vector<common::Task> tasks;
-  for (int task_id = 0; task_id < SizeToInt(thread_num); ++task_id) {
-    auto task = [this, &input_addr, &output_addr, &output_shape, &transpose_param, task_id, thread_num]() {
-      TransposeDims(input_addr, output_addr, output_shape, transpose_param, task_id, SizeToInt(thread_num));
-      return common::SUCCESS;
-    };
-    (void)tasks.emplace_back(task);
-  }
-  ParallelLaunch(tasks);
-}
-
-template <typename T>
-void TransposeFwdCpuKernelMod::TransposeDims(const T *in_data, T *out_data, const int *output_shape,
-                                             const TransposeParameter *transpose_param, int task_id, int thread_num) {
-  NNACL_CHECK_NULL_RETURN_VOID(in_data);
-  NNACL_CHECK_NULL_RETURN_VOID(out_data);
-  NNACL_CHECK_NULL_RETURN_VOID(output_shape);
-  NNACL_CHECK_NULL_RETURN_VOID(transpose_param);
-  NNACL_CHECK_ZERO_RETURN(thread_num);
-  const int *perm = transpose_param->perm_;
-  const int *strides = transpose_param->strides_;
-  const int *out_strides = transpose_param->out_strides_;
-  int num_axes = transpose_param->num_axes_;
-  size_t data_size = (*out_strides) * output_shape[0];
-  size_t offset_size = UP_DIV(data_size, thread_num);
-  size_t task_offset = offset_size * task_id;
-  int count = data_size - task_offset;
-  if (count <= 0) {
-    return;
-  }
-  count = MSMIN(offset_size, (unsigned int)count);
-  for (int idx = task_offset; (unsigned int)idx < task_offset + count; ++idx) {
-    int pos = idx;
-    int output_idx = 0;
-    int input_idx = 0;
-    for (int i = 0; i < num_axes; ++i) {
-      NNACL_CHECK_ZERO_RETURN(*(out_strides + i));
-      int position = pos / *(out_strides + i);
-      int out_stride = i < num_axes - 1 ? out_strides[i] : 1;
-      output_idx += (position * out_stride);
-      input_idx += (position * strides[perm[i]]);
-      pos -= position * (*(out_strides + i));
-    }
-    out_data[output_idx] = in_data[input_idx];
-  }
-}
-
 MS_KERNEL_FACTORY_REG(NativeCpuKernelMod, Transpose, TransposeFwdCpuKernelMod);
 }  // namespace kernel
 }  // namespace mindspore
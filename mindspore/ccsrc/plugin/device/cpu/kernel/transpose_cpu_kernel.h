@@ -18,12 +18,11 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TRANSPOSE_CPU_KERNEL_H_
 
 #include <vector>
-#include <unordered_map>
 #include <memory>
 #include <string>
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
 #include "plugin/factory/ms_factory.h"
-#include "nnacl/transpose.h"
+#include "nnacl/base/tiled_transpose_base.h"
 
 namespace mindspore {
 namespace kernel {
@@ -57,44 +56,12 @@ class TransposeFwdCpuKernelMod : public DeprecatedNativeCpuKernelMod {
   }
 
  private:
-  template <typename T>
-  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
-  template <typename T>
-  void ParallelRun(const T *input_addr, T *output_addr, const int *output_shape, size_t count,
-                   const TransposeParameter *transpose_param);
-  template <typename T>
-  int DoTranspose(const T *in_data, T *out_data, const int *output_shape, const TransposeParameter *transpose_param);
-  template <typename T>
-  void TransposeDim2(const T *in_data, T *out_data, const int *strides, const int *out_strides, const int *perm,
-                     const int *output_shape);
-  template <typename T>
-  void TransposeDim3(const T *in_data, T *out_data, const int *strides, const int *out_strides, const int *perm,
-                     const int *output_shape);
-  template <typename T>
-  void TransposeDim4(const T *in_data, T *out_data, const int *strides, const int *out_strides, const int *perm,
-                     const int *output_shape);
-  template <typename T>
-  void TransposeDim5(const T *in_data, T *out_data, const int *strides, const int *out_strides, const int *perm,
-                     const int *output_shape);
-  template <typename T>
-  void TransposeDim6(const T *in_data, T *out_data, const int *strides, const int *out_strides, const int *perm,
-                     const int *output_shape);
-  template <typename T>
-  void TransposeDim7(const T *in_data, T *out_data, const int *strides, const int *out_strides, const int *perm,
-                     const int *output_shape);
-  template <typename T>
-  void TransposeDims(const T *in_data, T *out_data, const int *output_shape, const TransposeParameter *transpose_param,
-                     int task_id, int thread_num);
-
-  TransposeParameter transpose_param_;
+  // the permutation only moves bytes, so every data type goes through the same engine with its element size.
+  TiledTransposeInfo tiled_info_{};
   std::vector<int64_t> input_shape_;
   std::vector<int64_t> output_shape_;
   std::vector<size_t> axes_;
   TypeId dtype_{kTypeUnknown};
-  using TypeKernel =
-    std::function<void(TransposeFwdCpuKernelMod *, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &)>;
-  std::unordered_map<TypeId, TypeKernel> launch_map_;
-  TypeKernel launch_func_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -21,6 +21,7 @@ namespace mindspore {
 namespace kernel {
 namespace {
 constexpr size_t kBucketSortThreshold = 100000;
+constexpr size_t kHashUniqueThreshold = 100000;
 constexpr size_t kWorkSpaceNum = 3;
 constexpr size_t kOutputNum = 2;
 constexpr size_t kWorkSpaceIndex = 2;
@@ -121,7 +122,11 @@ void UniqueCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, con
     }
   } else {
     params->need_sort_ = false;
-    Unique(params);
+    if (input_size_ < kHashUniqueThreshold) {
+      Unique(params);
+    } else {
+      HashUnique(params);
+    }
   }
   output_size_ = static_cast<size_t>(params->output_size_);
 }
@@ -18,6 +18,8 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_UNIQUE_CPU_KERNEL_H_
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <thread>
 #include <unordered_map>
@@ -28,6 +30,11 @@
 
 namespace mindspore {
 namespace kernel {
+constexpr size_t kUniquePartitionPerThread = 4;
+constexpr size_t kUniqueHashBlock = 256;
+constexpr uint32_t kUniquePartitionMultiplier = 0x9E3779B1u;
+constexpr uint64_t kUniqueSlotMultiplier = 0x9E3779B97F4A7C15ull;
+
 template <typename DataType, typename IndexType>
 struct UniqueParam {
   DataType *input_{nullptr};
@@ -100,6 +107,29 @@ size_t BucketId(DataType input, size_t bucket_num) {
   return data % bucket_num;
 }
 
+// Bits of a key for hashing, keys that compare equal have the same bits.
+template <typename DataType>
+uint64_t UniqueKeyBits(DataType input) {
+  return static_cast<uint64_t>(input);
+}
+
+template <>
+inline uint64_t UniqueKeyBits(float input) {
+  constexpr uint32_t kNegativeZero = 0x80000000u;
+  uint32_t bits = 0;
+  (void)memcpy(&bits, &input, sizeof(bits));
+  return bits == kNegativeZero ? 0 : bits;
+}
+
+// Partition ids of a block of keys, a plain 32 bit multiplicative hash so the loop vectorizes.
+template <typename DataType>
+void UniquePartitionIds(const DataType *input, size_t size, size_t shift, uint32_t *ids) {
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t bits = UniqueKeyBits(input[i]);
+    ids[i] = (static_cast<uint32_t>(bits ^ (bits >> 32)) * kUniquePartitionMultiplier) >> shift;
+  }
+}
+
 class UniqueCpuKernelMod : public DeprecatedNativeCpuKernelMod {
  public:
   UniqueCpuKernelMod() = default;
@@ -426,6 +456,163 @@ class UniqueCpuKernelMod : public DeprecatedNativeCpuKernelMod {
     MergeBuckets(buckets, params);
   }
 
+  template <typename Func>
+  static void LaunchUniqueTasks(size_t task_num, const Func &func) {
+    std::vector<common::Task> tasks;
+    tasks.reserve(task_num);
+    for (size_t i = 0; i < task_num; ++i) {
+      auto task = [&func, i]() {
+        func(i);
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+  }
+
+  // Deduplicates the keys of one partition with an open addressing table, first_idx of every key is set to the input
+  // index of its first occurrence. part_idx is increasing, so the first key that takes a slot is the first occurrence.
+  template <typename DataType, typename IndexType>
+  static void UniquePartition(const DataType *part_input, const IndexType *part_idx, size_t size,
+                              IndexType *first_idx) {
+    size_t table_bits = 1;
+    while ((static_cast<size_t>(1) << table_bits) < size * 2) {
+      table_bits++;
+    }
+    size_t table_mask = (static_cast<size_t>(1) << table_bits) - 1;
+    std::vector<IndexType> table(table_mask + 1, -1);
+    for (size_t i = 0; i < size; ++i) {
+      DataType key = part_input[i];
+      size_t slot = static_cast<size_t>((UniqueKeyBits(key) * kUniqueSlotMultiplier) >> (64 - table_bits));
+      while (true) {
+        IndexType entry = table[slot];
+        if (entry < 0) {
+          table[slot] = SizeTo<IndexType>(i);
+          first_idx[ToSize<IndexType>(part_idx[i])] = part_idx[i];
+          break;
+        }
+        if (part_input[ToSize<IndexType>(entry)] == key) {
+          first_idx[ToSize<IndexType>(part_idx[i])] = part_idx[ToSize<IndexType>(entry)];
+          break;
+        }
+        slot = (slot + 1) & table_mask;
+      }
+    }
+  }
+
+  // Unsorted Unique of a large input. The keys are scattered into hash partitions in input order, every partition is
+  // deduplicated by one task, then the unique keys are numbered by first occurrence, the same output as Unique.
+  template <typename DataType, typename IndexType>
+  static void HashUnique(const std::shared_ptr<UniqueParam<DataType, IndexType>> &params) {
+    MS_LOG(DEBUG) << "Start";
+    MS_EXCEPTION_IF_NULL(params);
+    DataType *input = params->input_;
+    IndexType *first_idx = params->input_idx_;
+    DataType *part_input = params->workspace_;
+    IndexType *part_idx = params->workspace_idx_;
+    DataType *output = params->output_;
+    IndexType *inverse_idx = params->inverse_idx_;
+    MS_EXCEPTION_IF_NULL(input);
+    MS_EXCEPTION_IF_NULL(first_idx);
+    MS_EXCEPTION_IF_NULL(part_input);
+    MS_EXCEPTION_IF_NULL(part_idx);
+    MS_EXCEPTION_IF_NULL(output);
+    MS_EXCEPTION_IF_NULL(inverse_idx);
+    size_t input_size = params->input_size_;
+    if (input_size < 1) {
+      return;
+    }
+    size_t task_num = std::max<size_t>(params->thread_num_, 1);
+    size_t part_bits = 1;
+    while ((static_cast<size_t>(1) << part_bits) < task_num * kUniquePartitionPerThread) {
+      part_bits++;
+    }
+    size_t part_num = static_cast<size_t>(1) << part_bits;
+    size_t shift = 32 - part_bits;
+    size_t chunk = (input_size + task_num - 1) / task_num;
+
+    // offsets[task][part], counted and then turned into the scatter position of every task in every partition.
+    std::vector<size_t> offsets(task_num * part_num, 0);
+    LaunchUniqueTasks(task_num, [&](size_t task_id) {
+      size_t *count = offsets.data() + task_id * part_num;
+      uint32_t ids[kUniqueHashBlock];
+      size_t end = std::min(input_size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; i += kUniqueHashBlock) {
+        size_t block = std::min(kUniqueHashBlock, end - i);
+        UniquePartitionIds(input + i, block, shift, ids);
+        for (size_t j = 0; j < block; ++j) {
+          count[ids[j]]++;
+        }
+      }
+    });
+    std::vector<size_t> part_offsets(part_num + 1, 0);
+    size_t offset = 0;
+    for (size_t part = 0; part < part_num; ++part) {
+      part_offsets[part] = offset;
+      for (size_t task_id = 0; task_id < task_num; ++task_id) {
+        size_t count = offsets[task_id * part_num + part];
+        offsets[task_id * part_num + part] = offset;
+        offset += count;
+      }
+    }
+    part_offsets[part_num] = offset;
+    LaunchUniqueTasks(task_num, [&](size_t task_id) {
+      size_t *pos = offsets.data() + task_id * part_num;
+      uint32_t ids[kUniqueHashBlock];
+      size_t end = std::min(input_size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; i += kUniqueHashBlock) {
+        size_t block = std::min(kUniqueHashBlock, end - i);
+        UniquePartitionIds(input + i, block, shift, ids);
+        for (size_t j = 0; j < block; ++j) {
+          size_t index = pos[ids[j]]++;
+          part_input[index] = input[i + j];
+          part_idx[index] = SizeTo<IndexType>(i + j);
+        }
+      }
+    });
+    LaunchUniqueTasks(part_num, [&](size_t part) {
+      size_t begin = part_offsets[part];
+      UniquePartition(part_input + begin, part_idx + begin, part_offsets[part + 1] - begin, first_idx);
+    });
+
+    // number the first occurrences in input order, then point every other key at its first occurrence.
+    std::vector<size_t> unique_offsets(task_num, 0);
+    LaunchUniqueTasks(task_num, [&](size_t task_id) {
+      size_t count = 0;
+      size_t end = std::min(input_size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; ++i) {
+        count += first_idx[i] == SizeTo<IndexType>(i) ? 1 : 0;
+      }
+      unique_offsets[task_id] = count;
+    });
+    size_t unique_num = 0;
+    for (size_t task_id = 0; task_id < task_num; ++task_id) {
+      size_t count = unique_offsets[task_id];
+      unique_offsets[task_id] = unique_num;
+      unique_num += count;
+    }
+    LaunchUniqueTasks(task_num, [&](size_t task_id) {
+      size_t unique_id = unique_offsets[task_id];
+      size_t end = std::min(input_size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; ++i) {
+        if (first_idx[i] == SizeTo<IndexType>(i)) {
+          output[unique_id] = input[i];
+          inverse_idx[i] = SizeTo<IndexType>(unique_id++);
+        }
+      }
+    });
+    LaunchUniqueTasks(task_num, [&](size_t task_id) {
+      size_t end = std::min(input_size, (task_id + 1) * chunk);
+      for (size_t i = task_id * chunk; i < end; ++i) {
+        if (first_idx[i] != SizeTo<IndexType>(i)) {
+          inverse_idx[i] = inverse_idx[ToSize<IndexType>(first_idx[i])];
+        }
+      }
+    });
+    params->output_size_ = unique_num;
+    MS_LOG(DEBUG) << "End";
+  }
+
   std::vector<KernelAttr> GetOpSupport() override {
     static std::vector<KernelAttr> support_list = {
       KernelAttr().AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
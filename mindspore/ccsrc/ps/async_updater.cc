@@ -0,0 +1,262 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/async_updater.h"
+
+#include <algorithm>
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The metrics are logged once every this number of the applied batches.
+constexpr uint64_t kMetricsLogInterval = 1000;
+
+void UpdateMax(std::atomic<size_t> *max_value, size_t value) {
+  size_t current = max_value->load();
+  while (value > current && !max_value->compare_exchange_weak(current, value)) {
+  }
+}
+
+std::vector<kernel::AddressPtr> ShardAddresses(const std::vector<kernel::AddressPtr> &addresses, size_t weight_size,
+                                               size_t begin, size_t shard_size) {
+  std::vector<kernel::AddressPtr> shard;
+  for (const auto &address : addresses) {
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->size == weight_size) {
+      shard.push_back(std::make_shared<kernel::Address>(static_cast<float *>(address->addr) + begin, shard_size));
+    } else {
+      shard.push_back(address);
+    }
+  }
+  return shard;
+}
+}  // namespace
+
+std::vector<OptimizerShard> SplitElementWiseOptimizer(const std::vector<kernel::AddressPtr> &inputs,
+                                                      const std::vector<kernel::AddressPtr> &workspaces,
+                                                      const std::vector<kernel::AddressPtr> &outputs,
+                                                      size_t shard_num) {
+  if (inputs.empty() || inputs[0] == nullptr || shard_num == 0) {
+    MS_LOG(EXCEPTION) << "The optimizer has no weight or the shard number is 0.";
+  }
+  size_t weight_size = inputs[0]->size;
+  size_t elem_num = weight_size / sizeof(float);
+  size_t shard_elem_num = std::max<size_t>((elem_num + shard_num - 1) / shard_num, 1);
+  std::vector<OptimizerShard> shards;
+  for (size_t begin = 0; begin < elem_num; begin += shard_elem_num) {
+    size_t shard_size = std::min(shard_elem_num, elem_num - begin) * sizeof(float);
+    OptimizerShard shard;
+    shard.inputs = ShardAddresses(inputs, weight_size, begin, shard_size);
+    shard.workspaces = ShardAddresses(workspaces, weight_size, begin, shard_size);
+    shard.outputs = ShardAddresses(outputs, weight_size, begin, shard_size);
+    shards.push_back(std::move(shard));
+  }
+  return shards;
+}
+
+StalenessController::KeyClocks &StalenessController::GetKeyClocks(const Key &key, uint32_t worker_rank) {
+  if (worker_rank >= worker_num_) {
+    MS_LOG(EXCEPTION) << "The worker rank " << worker_rank << " is out of range, the worker number is " << worker_num_;
+  }
+  auto &clocks = clocks_[key];
+  if (clocks.push_clocks.empty()) {
+    clocks.push_clocks.resize(worker_num_, 0);
+    clocks.applied_clocks.resize(worker_num_, 0);
+  }
+  return clocks;
+}
+
+bool StalenessController::ReadyForPush(const Key &key, uint32_t worker_rank) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto &clocks = GetKeyClocks(key, worker_rank);
+  size_t min_clock = *std::min_element(clocks.push_clocks.begin(), clocks.push_clocks.end());
+  return clocks.push_clocks[worker_rank] <= min_clock + staleness_threshold_;
+}
+
+bool StalenessController::ReadyForPull(const Key &key, uint32_t worker_rank) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto &clocks = GetKeyClocks(key, worker_rank);
+  size_t min_applied_clock = *std::min_element(clocks.applied_clocks.begin(), clocks.applied_clocks.end());
+  return clocks.push_clocks[worker_rank] <= min_applied_clock + staleness_threshold_;
+}
+
+size_t StalenessController::Push(const Key &key, uint32_t worker_rank) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto &clocks = GetKeyClocks(key, worker_rank);
+  size_t min_clock = *std::min_element(clocks.push_clocks.begin(), clocks.push_clocks.end());
+  size_t staleness = clocks.push_clocks[worker_rank] - min_clock;
+  clocks.push_clocks[worker_rank]++;
+  lock.unlock();
+
+  UpdateMax(&max_staleness_, staleness);
+  (void)staleness_sum_.fetch_add(staleness);
+  (void)push_num_.fetch_add(1);
+  return staleness;
+}
+
+void StalenessController::Applied(const Key &key, uint32_t worker_rank) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto &clocks = GetKeyClocks(key, worker_rank);
+  clocks.applied_clocks[worker_rank]++;
+}
+
+double StalenessController::average_staleness() const {
+  uint64_t push_num = push_num_.load();
+  return push_num == 0 ? 0 : static_cast<double>(staleness_sum_.load()) / push_num;
+}
+
+AsyncUpdater::AsyncUpdater(size_t worker_num, size_t staleness_threshold, size_t thread_num,
+                           const ApplyFunc &apply_func)
+    : worker_num_(worker_num), controller_(worker_num, staleness_threshold), apply_func_(apply_func) {
+  if (worker_num == 0 || thread_num == 0) {
+    MS_LOG(EXCEPTION) << "The worker number and thread number of the async updater should be positive, but got "
+                      << worker_num << " and " << thread_num;
+  }
+  for (size_t i = 0; i < thread_num; ++i) {
+    update_threads_.emplace_back(std::make_unique<UpdateThread>());
+  }
+}
+
+AsyncUpdater::~AsyncUpdater() { Stop(); }
+
+void AsyncUpdater::Start() {
+  if (running_.exchange(true)) {
+    return;
+  }
+  for (size_t i = 0; i < update_threads_.size(); ++i) {
+    update_threads_[i]->thread = std::thread(&AsyncUpdater::UpdateLoop, this, i);
+  }
+  MS_LOG(INFO) << "The async updater starts with " << update_threads_.size() << " update threads.";
+}
+
+void AsyncUpdater::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  for (auto &update_thread : update_threads_) {
+    {
+      std::lock_guard<std::mutex> lock(update_thread->mutex);
+    }
+    update_thread->cv.notify_all();
+  }
+  for (auto &update_thread : update_threads_) {
+    if (update_thread->thread.joinable()) {
+      update_thread->thread.join();
+    }
+  }
+  LogMetrics();
+}
+
+void AsyncUpdater::Push(const Key &key, const GradUpdatePtr &update) {
+  MS_EXCEPTION_IF_NULL(update);
+  (void)controller_.Push(key, update->worker_rank);
+  KeyState *state = GetKeyState(key);
+  state->updates.Push(update);
+  UpdateMax(&max_queue_depth_, queue_depth_.fetch_add(1) + 1);
+  Schedule(state);
+}
+
+std::mutex &AsyncUpdater::WeightMutex(const Key &key) { return GetKeyState(key)->weight_mutex; }
+
+AsyncUpdater::KeyState *AsyncUpdater::GetKeyState(const Key &key) {
+  {
+    std::shared_lock<std::shared_mutex> lock(key_states_mutex_);
+    auto iter = key_states_.find(key);
+    if (iter != key_states_.end()) {
+      return iter->second.get();
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(key_states_mutex_);
+  auto &state = key_states_[key];
+  if (state == nullptr) {
+    state = std::make_unique<KeyState>(key);
+  }
+  return state.get();
+}
+
+void AsyncUpdater::Schedule(KeyState *state) {
+  if (state->scheduled.exchange(true)) {
+    return;
+  }
+  auto &update_thread = update_threads_[state->key % update_threads_.size()];
+  update_thread->ready_keys.Push(state);
+  {
+    std::lock_guard<std::mutex> lock(update_thread->mutex);
+  }
+  update_thread->cv.notify_one();
+}
+
+void AsyncUpdater::UpdateLoop(size_t thread_index) {
+  auto &update_thread = update_threads_[thread_index];
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(update_thread->mutex);
+      update_thread->cv.wait(lock, [this, &update_thread] { return !update_thread->ready_keys.empty() || !running_; });
+    }
+    if (!running_ && update_thread->ready_keys.empty()) {
+      break;
+    }
+    KeyState *state = nullptr;
+    if (!update_thread->ready_keys.Pop(&state)) {
+      // The key being pushed is not linked into the queue yet.
+      std::this_thread::yield();
+      continue;
+    }
+    Drain(state);
+  }
+}
+
+void AsyncUpdater::Drain(KeyState *state) {
+  std::vector<GradUpdatePtr> batch;
+  GradUpdatePtr update = nullptr;
+  while (true) {
+    batch.clear();
+    while (batch.size() < worker_num_ && state->updates.Pop(&update)) {
+      batch.push_back(update);
+    }
+    if (batch.empty()) {
+      break;
+    }
+    {
+      std::unique_lock<std::mutex> lock(state->weight_mutex);
+      apply_func_(state->key, batch);
+    }
+    for (const auto &applied : batch) {
+      controller_.Applied(state->key, applied->worker_rank);
+    }
+    (void)queue_depth_.fetch_sub(batch.size());
+    if (applied_batch_num_.fetch_add(1) % kMetricsLogInterval == kMetricsLogInterval - 1) {
+      LogMetrics();
+    }
+  }
+
+  // The updates pushed after the queue is found empty and before the key is unscheduled would be missed, so check the
+  // queue again and schedule the key for them.
+  state->scheduled = false;
+  if (!state->updates.empty()) {
+    Schedule(state);
+  }
+}
+
+void AsyncUpdater::LogMetrics() const {
+  MS_LOG(INFO) << "Async updater metrics: applied batches " << applied_batch_num_.load() << ", queue depth "
+               << queue_depth() << ", max queue depth " << max_queue_depth() << ", max staleness " << max_staleness()
+               << ", average staleness " << average_staleness();
+}
+}  // namespace ps
+}  // namespace mindspore
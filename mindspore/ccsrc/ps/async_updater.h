@@ -0,0 +1,172 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_ASYNC_UPDATER_H_
+#define MINDSPORE_CCSRC_PS_ASYNC_UPDATER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "utils/hash_map.h"
+#include "kernel/kernel.h"
+#include "ps/constants.h"
+#include "ps/update_queue.h"
+
+namespace mindspore {
+namespace ps {
+// The gradients of one key pushed by one worker.
+struct GradUpdate {
+  uint32_t worker_rank{0};
+  Keys keys;
+  Values values;
+  Lengths lengths;
+};
+using GradUpdatePtr = std::shared_ptr<GradUpdate>;
+
+// The addresses of one shard of a dense element-wise optimizer, which is updated by one thread.
+struct OptimizerShard {
+  std::vector<kernel::AddressPtr> inputs;
+  std::vector<kernel::AddressPtr> workspaces;
+  std::vector<kernel::AddressPtr> outputs;
+};
+
+// Split the float inputs, workspaces and outputs of a dense element-wise optimizer into at most 'shard_num' shards.
+// The addresses of the same size as the weight, which is the first input, are split, and the others such as the
+// scalar inputs are shared by the shards.
+std::vector<OptimizerShard> SplitElementWiseOptimizer(const std::vector<kernel::AddressPtr> &inputs,
+                                                      const std::vector<kernel::AddressPtr> &workspaces,
+                                                      const std::vector<kernel::AddressPtr> &outputs,
+                                                      size_t shard_num);
+
+// StalenessController keeps the clocks of the Stale Synchronous Parallel(SSP) consistency model for every key. The
+// clock of a worker is the number of the pushes of it. A worker can push only if it is no more than
+// 'staleness_threshold' steps ahead of the slowest worker, and can pull only if the updates of all the workers older
+// than that are applied. The staleness threshold 0 is equivalent to the synchronous mode.
+class StalenessController {
+ public:
+  StalenessController(size_t worker_num, size_t staleness_threshold)
+      : worker_num_(worker_num), staleness_threshold_(staleness_threshold) {}
+  ~StalenessController() = default;
+
+  bool ReadyForPush(const Key &key, uint32_t worker_rank);
+  bool ReadyForPull(const Key &key, uint32_t worker_rank);
+
+  // Advance the push clock of the worker and return the staleness of the push, which is the number of steps the worker
+  // is ahead of the slowest one.
+  size_t Push(const Key &key, uint32_t worker_rank);
+
+  // Advance the applied clock of the worker after one push of it is applied to the weight.
+  void Applied(const Key &key, uint32_t worker_rank);
+
+  size_t max_staleness() const { return max_staleness_.load(); }
+  double average_staleness() const;
+
+ private:
+  struct KeyClocks {
+    std::vector<size_t> push_clocks;
+    std::vector<size_t> applied_clocks;
+  };
+  // Get the clocks of the key, which should be called with the mutex locked.
+  KeyClocks &GetKeyClocks(const Key &key, uint32_t worker_rank);
+
+  size_t worker_num_;
+  size_t staleness_threshold_;
+  std::mutex mutex_;
+  mindspore::HashMap<Key, KeyClocks> clocks_;
+
+  std::atomic<size_t> max_staleness_{0};
+  std::atomic<uint64_t> staleness_sum_{0};
+  std::atomic<uint64_t> push_num_{0};
+};
+
+// AsyncUpdater applies the gradients pushed by the workers asynchronously in the SSP mode. The pushes are put into the
+// lock-free update queue of the key and the request handling thread returns at once. Every key is owned by one of the
+// update threads, which drains the queue of the key and applies the updates in batches, so the updates of one key are
+// serialized and the different keys are updated in parallel.
+class AsyncUpdater {
+ public:
+  // Apply a batch of the updates of the key, which is called by the update thread owning the key with the weight lock
+  // of the key held.
+  using ApplyFunc = std::function<void(const Key &key, const std::vector<GradUpdatePtr> &updates)>;
+
+  AsyncUpdater(size_t worker_num, size_t staleness_threshold, size_t thread_num, const ApplyFunc &apply_func);
+  ~AsyncUpdater();
+
+  void Start();
+  // Stop the update threads after the updates in the queues are applied.
+  void Stop();
+
+  bool ReadyForPush(const Key &key, uint32_t worker_rank) { return controller_.ReadyForPush(key, worker_rank); }
+  bool ReadyForPull(const Key &key, uint32_t worker_rank) { return controller_.ReadyForPull(key, worker_rank); }
+
+  // Push the update of the key into the update queue, which is thread safe and never blocked by the updating.
+  void Push(const Key &key, const GradUpdatePtr &update);
+
+  // The lock of the weight of the key, which should be held when the weight is read or modified out of the updater.
+  std::mutex &WeightMutex(const Key &key);
+
+  // The number of the updates in all the queues which are not applied yet.
+  size_t queue_depth() const { return queue_depth_.load(); }
+  size_t max_queue_depth() const { return max_queue_depth_.load(); }
+  size_t max_staleness() const { return controller_.max_staleness(); }
+  double average_staleness() const { return controller_.average_staleness(); }
+
+ private:
+  struct KeyState {
+    explicit KeyState(const Key &k) : key(k) {}
+    Key key;
+    UpdateQueue<GradUpdatePtr> updates;
+    // Whether the key is in the ready queue of the owner thread.
+    std::atomic_bool scheduled{false};
+    std::mutex weight_mutex;
+  };
+
+  struct UpdateThread {
+    UpdateQueue<KeyState *> ready_keys;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+  };
+
+  KeyState *GetKeyState(const Key &key);
+  // Put the key into the ready queue of the owner thread if it is not there.
+  void Schedule(KeyState *state);
+  void UpdateLoop(size_t thread_index);
+  // Apply the updates in the queue of the key in batches of at most 'worker_num_' updates.
+  void Drain(KeyState *state);
+  void LogMetrics() const;
+
+  size_t worker_num_;
+  StalenessController controller_;
+  ApplyFunc apply_func_;
+  std::atomic_bool running_{false};
+
+  std::shared_mutex key_states_mutex_;
+  mindspore::HashMap<Key, std::unique_ptr<KeyState>> key_states_;
+  std::vector<std::unique_ptr<UpdateThread>> update_threads_;
+
+  std::atomic<size_t> queue_depth_{0};
+  std::atomic<size_t> max_queue_depth_{0};
+  std::atomic<uint64_t> applied_batch_num_{0};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_ASYNC_UPDATER_H_
@@ -36,6 +36,8 @@ constexpr char kEnvCommType[] = "MS_COMM_TYPE";
 constexpr char kEnvInterface[] = "MS_INTERFACE";
 constexpr char kEnvPServerNum[] = "MS_SERVER_NUM";
 constexpr char kEnvWorkerNum[] = "MS_WORKER_NUM";
+// The staleness threshold of the SSP mode of parameter server, which is in synchronous mode if it is not set.
+constexpr char kEnvStalenessThreshold[] = "MS_PS_STALENESS";
 constexpr char kEnvSchedulerHost[] = "MS_SCHED_HOST";
 constexpr char kEnvSchedulerPort[] = "MS_SCHED_PORT";
 constexpr char kEnvSchedulerManagePort[] = "MS_SCHED_MANAGE_PORT";
@@ -83,6 +85,13 @@ constexpr int64_t kFinalizeCmd = 40;
 constexpr int64_t kPushCmd = 50;
 constexpr int64_t kPullCmd = 51;
 
+// The wire formats of the KVMessage payloads between the workers and the servers. Every node registers the newest
+// format it supports to the scheduler, and the nodes use the oldest one of them, so the nodes of different versions can
+// still work together.
+constexpr uint32_t kProtobufWireFormat = 0;
+constexpr uint32_t kBinaryWireFormat = 1;
+constexpr uint32_t kLatestWireFormat = kBinaryWireFormat;
+
 constexpr size_t kInvalidKey = UINT64_MAX;
 constexpr int64_t kInvalidID = -1;
 
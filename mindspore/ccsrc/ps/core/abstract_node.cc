@@ -16,6 +16,8 @@
 
 #include "ps/core/abstract_node.h"
 
+#include <algorithm>
+
 #include "include/common/debug/common.h"
 #include "ps/core/communicator/http_communicator.h"
 #include "ps/core/communicator/tcp_communicator.h"
@@ -56,6 +58,7 @@ void AbstractNode::Register(const std::shared_ptr<TcpClient> &client) {
   register_message.set_port(node_info_.port_);
   register_message.set_is_recover(is_recover.load());
   register_message.set_fl_iteration_num(PSContext::instance()->fl_iteration_num());
+  register_message.set_wire_format_version(kLatestWireFormat);
 
   MS_LOG(INFO) << "The node role:" << CommUtil::NodeRoleToString(node_info_.node_role_)
                << " the node id:" << node_info_.node_id_ << " begin to register to the scheduler!";
@@ -606,6 +609,8 @@ uint32_t AbstractNode::worker_num() const { return worker_num_; }
 
 uint32_t AbstractNode::server_num() const { return server_num_; }
 
+uint32_t AbstractNode::wire_format_version() const { return wire_format_version_.load(); }
+
 void AbstractNode::set_worker_num(const uint32_t &worker_num) { worker_num_ = worker_num; }
 
 void AbstractNode::set_server_num(const uint32_t &server_num) { server_num_ = server_num; }
@@ -893,12 +898,18 @@ void AbstractNode::ProcessSendMetadata(const std::shared_ptr<TcpConnection> &con
 
   client_mutex_.lock();
   nodes_address_.clear();
+  uint32_t wire_format_version = kLatestWireFormat;
   for (const auto &it : send_meta_message.servers_meta()) {
     nodes_address_[std::make_pair(it.role(), it.rank_id())] = std::make_pair(it.ip(), it.port());
+    wire_format_version = std::min(wire_format_version, it.wire_format_version());
     MS_LOG(INFO) << "The node role:" << CommUtil::NodeRoleToString(it.role()) << ", node id:" << it.node_id()
-                 << ", rank id:" << it.rank_id() << ", ip:" << it.ip() << ", port:" << it.port();
+                 << ", rank id:" << it.rank_id() << ", ip:" << it.ip() << ", port:" << it.port()
+                 << ", wire format version:" << it.wire_format_version();
   }
   client_mutex_.unlock();
+  // The nodes registered by the older versions do not report the wire format, which is the protobuf format by default.
+  wire_format_version_ = wire_format_version;
+  MS_LOG(INFO) << "The negotiated wire format version is:" << wire_format_version;
   if (!server_->SendMessage(conn, meta, Protos::RAW, data, size)) {
     MS_LOG(WARNING) << "Sever response message failed.";
   }
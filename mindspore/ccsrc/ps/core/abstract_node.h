@@ -54,6 +54,7 @@ class BACKEND_EXPORT AbstractNode : public Node {
         server_num_(0),
         is_connected_to_scheduler_(false),
         is_current_node_scale_in_(false),
+        wire_format_version_(kProtobufWireFormat),
         follower_scaler_(nullptr),
         node_recovery_(nullptr),
         persistent_state_(PersistentState::NOT_ENABLE_PERSIST),
@@ -140,6 +141,10 @@ class BACKEND_EXPORT AbstractNode : public Node {
   void set_worker_num(const uint32_t &worker_num);
   void set_server_num(const uint32_t &server_num);
 
+  // The wire format of the KVMessage payloads negotiated with the other nodes, which is the oldest one of the newest
+  // formats supported by the nodes in the cluster.
+  uint32_t wire_format_version() const;
+
   std::string scheduler_ip() const;
   void set_scheduler_ip(const std::string &scheduler_ip);
 
@@ -310,6 +315,8 @@ class BACKEND_EXPORT AbstractNode : public Node {
   std::atomic<bool> is_connected_to_scheduler_;
   // Identify whether the current node is a scale in node.
   std::atomic<bool> is_current_node_scale_in_;
+  // The wire format negotiated when the metadata of the cluster is received from the scheduler.
+  std::atomic<uint32_t> wire_format_version_;
 
   // Each ClusterEvent corresponds to a EventCallback to process the event.
   std::map<ClusterEvent, EventCallback> event_to_callback_;
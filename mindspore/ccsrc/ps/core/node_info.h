@@ -40,7 +40,14 @@ enum class ClusterEvent {
 };
 
 struct NodeInfo {
-  NodeInfo() : ip_(""), port_(0), node_role_(NodeRole::SCHEDULER), rank_id_(UINT32_MAX), is_alive(false) {}
+  NodeInfo()
+      : ip_(""),
+        port_(0),
+        node_role_(NodeRole::SCHEDULER),
+        rank_id_(UINT32_MAX),
+        is_alive(false),
+        fl_iteration_num_(0),
+        wire_format_version_(0) {}
   // ip
   std::string ip_;
   // the port of this node
@@ -55,6 +62,8 @@ struct NodeInfo {
   bool is_alive;
   // the number of the fl job iteration
   size_t fl_iteration_num_;
+  // the newest wire format of the KVMessage payloads supported by this node
+  uint32_t wire_format_version_;
 };
 }  // namespace core
 }  // namespace ps
@@ -42,6 +42,7 @@ uint32_t NodeManager::checkIfRankIdExist(const RegisterMessage &register_message
     registered_nodes_info_[node_id].ip_ = new_ip;
     registered_nodes_info_[node_id].port_ = static_cast<uint16_t>(new_port);
     registered_nodes_info_[node_id].fl_iteration_num_ = new_fl_iteration_num;
+    registered_nodes_info_[node_id].wire_format_version_ = register_message.wire_format_version();
     MS_LOG(WARNING) << "The node id: " << node_id << " is already assigned!"
                     << ", ip: " << register_message.ip() << ", port: " << register_message.port()
                     << ", rank id: " << rank_id << ", alive: " << registered_nodes_info_[node_id].is_alive
@@ -66,6 +67,7 @@ uint32_t NodeManager::checkIfRankIdExist(const RegisterMessage &register_message
       recovery_node_infos[node_id].ip_ = new_ip;
       recovery_node_infos[node_id].port_ = static_cast<uint16_t>(new_port);
       recovery_node_infos[node_id].fl_iteration_num_ = new_fl_iteration_num;
+      recovery_node_infos[node_id].wire_format_version_ = register_message.wire_format_version();
 
       registered_nodes_info_[node_id] = recovery_node_infos[node_id];
       MS_LOG(INFO) << "The node id: " << node_id << " is recovery successful!"
@@ -74,8 +76,8 @@ uint32_t NodeManager::checkIfRankIdExist(const RegisterMessage &register_message
                    << ", the node_role:" << CommUtil::NodeRoleToString(recovery_node_infos[node_id].node_role_);
       return rank_id;
     }
-  } else {
-    (void)ReAddNodeIfNotExists(node_id, register_message.ip(), register_message.port(), &rank_id);
+  } else if (ReAddNodeIfNotExists(node_id, register_message.ip(), register_message.port(), &rank_id)) {
+    registered_nodes_info_[node_id].wire_format_version_ = register_message.wire_format_version();
   }
   return rank_id;
 }
@@ -143,6 +145,7 @@ uint32_t NodeManager::NextRankId(const RegisterMessage &register_message, const
     node_info.port_ = port;
     node_info.is_alive = true;
     node_info.fl_iteration_num_ = fl_iteration_num;
+    node_info.wire_format_version_ = register_message.wire_format_version();
     registered_nodes_info_[node_id] = node_info;
     MS_LOG(INFO) << "The server node id:" << node_id << ", node ip: " << node_info.ip_ << ", node port:" << port
                  << ", fl iteration num:" << fl_iteration_num << " assign rank id:" << rank_id << ", "
@@ -173,6 +176,7 @@ uint32_t NodeManager::NextRankId(const RegisterMessage &register_message, const
     node_info.port_ = port;
     node_info.is_alive = true;
     node_info.fl_iteration_num_ = fl_iteration_num;
+    node_info.wire_format_version_ = register_message.wire_format_version();
     registered_nodes_info_[node_id] = node_info;
     MS_LOG(INFO) << "The worker node id:" << node_id << ", node ip: " << node_info.ip_ << ", node port:" << port
                  << ", fl iteration num:" << fl_iteration_num << " assign rank id:" << rank_id << ", "
@@ -214,6 +218,7 @@ std::vector<ServersMeta> NodeManager::FetchAllNodesMeta() {
     servers_meta.set_is_alive(it->second.is_alive);
     servers_meta.set_role(it->second.node_role_);
     servers_meta.set_node_id(it->second.node_id_);
+    servers_meta.set_wire_format_version(it->second.wire_format_version_);
     servers_meta_list.push_back(servers_meta);
   }
   return servers_meta_list;
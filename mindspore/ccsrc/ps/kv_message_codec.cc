@@ -0,0 +1,185 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/kv_message_codec.h"
+
+#include <cstring>
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The magic bytes of the binary wire format, the first one is never the first byte of a valid protobuf message.
+constexpr char kBinaryMagic[] = {'\0', 'K', 'V', 'B'};
+
+struct BinaryKVHeader {
+  char magic[sizeof(kBinaryMagic)];
+  uint32_t version;
+  uint64_t keys_num;
+  uint64_t lens_num;
+  uint64_t values_num;
+};
+static_assert(sizeof(BinaryKVHeader) % sizeof(uint64_t) == 0, "The arrays after the header should be aligned.");
+
+size_t BinaryKVMessageSize(size_t keys_num, size_t lens_num, size_t values_num) {
+  return sizeof(BinaryKVHeader) + (keys_num + lens_num) * sizeof(uint64_t) + values_num * sizeof(float);
+}
+
+void CopyArray(const void *src, size_t size, uint8_t **dest, size_t *dest_size) {
+  if (size == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(src);
+  auto ret = memcpy_s(*dest, *dest_size, src, size);
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  }
+  *dest += size;
+  *dest_size -= size;
+}
+
+KVMessage ToProtobufMessage(const KVMessageArrays &arrays) {
+  KVMessage message;
+  if (arrays.keys_num > 0) {
+    *message.mutable_keys() = {arrays.keys, arrays.keys + arrays.keys_num};
+  }
+  if (arrays.values_num > 0) {
+    *message.mutable_values() = {arrays.values, arrays.values + arrays.values_num};
+  }
+  if (arrays.lens_num > 0) {
+    *message.mutable_len() = {arrays.lens, arrays.lens + arrays.lens_num};
+  }
+  return message;
+}
+}  // namespace
+
+size_t EncodedKVMessageSize(const KVMessageArrays &arrays, uint32_t wire_format) {
+  if (wire_format >= kBinaryWireFormat) {
+    return BinaryKVMessageSize(arrays.keys_num, arrays.lens_num, arrays.values_num);
+  }
+  return ToProtobufMessage(arrays).ByteSizeLong();
+}
+
+void EncodeKVMessage(const KVMessageArrays &arrays, uint32_t wire_format, void *buffer, size_t buffer_size) {
+  MS_EXCEPTION_IF_NULL(buffer);
+  if (wire_format < kBinaryWireFormat) {
+    auto message = ToProtobufMessage(arrays);
+    if (message.ByteSizeLong() != buffer_size || !message.SerializeToArray(buffer, SizeToInt(buffer_size))) {
+      MS_LOG(EXCEPTION) << "Serialize the KVMessage of size " << message.ByteSizeLong() << " to the buffer of size "
+                        << buffer_size << " failed.";
+    }
+    return;
+  }
+
+  if (BinaryKVMessageSize(arrays.keys_num, arrays.lens_num, arrays.values_num) != buffer_size) {
+    MS_LOG(EXCEPTION) << "The buffer size " << buffer_size << " is not the encoded size of the KVMessage.";
+  }
+  BinaryKVHeader header;
+  (void)std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+  header.version = kBinaryWireFormat;
+  header.keys_num = arrays.keys_num;
+  header.lens_num = arrays.lens_num;
+  header.values_num = arrays.values_num;
+
+  auto dest = static_cast<uint8_t *>(buffer);
+  CopyArray(&header, sizeof(header), &dest, &buffer_size);
+  CopyArray(arrays.keys, arrays.keys_num * sizeof(uint64_t), &dest, &buffer_size);
+  CopyArray(arrays.lens, arrays.lens_num * sizeof(uint64_t), &dest, &buffer_size);
+  CopyArray(arrays.values, arrays.values_num * sizeof(float), &dest, &buffer_size);
+}
+
+bool KVMessageView::Parse(const void *data, size_t size) {
+  arrays_ = KVMessageArrays();
+  aligned_copy_.reset();
+  message_.Clear();
+  if (size >= sizeof(kBinaryMagic)) {
+    MS_EXCEPTION_IF_NULL(data);
+    if (std::memcmp(data, kBinaryMagic, sizeof(kBinaryMagic)) == 0) {
+      wire_format_ = kBinaryWireFormat;
+      return ParseBinary(data, size);
+    }
+  }
+
+  wire_format_ = kProtobufWireFormat;
+  if (size > 0 && !message_.ParseFromArray(data, SizeToInt(size))) {
+    MS_LOG(ERROR) << "Parse the KVMessage of size " << size << " failed.";
+    return false;
+  }
+  arrays_ = KVMessageArrays(message_);
+  return true;
+}
+
+bool KVMessageView::ParseBinary(const void *data, size_t size) {
+  if (size < sizeof(BinaryKVHeader)) {
+    MS_LOG(ERROR) << "The size " << size << " of the binary KVMessage is less than the header size.";
+    return false;
+  }
+  BinaryKVHeader header;
+  (void)std::memcpy(&header, data, sizeof(header));
+  // A payload from the node of the other byte order is rejected here, as its version is not recognized.
+  if (header.version != kBinaryWireFormat) {
+    MS_LOG(ERROR) << "The version " << header.version << " of the binary KVMessage is not supported.";
+    return false;
+  }
+  // Check each number against the size first to avoid the overflow of the total size.
+  size_t max_num = size / sizeof(float);
+  if (header.keys_num > max_num || header.lens_num > max_num || header.values_num > max_num ||
+      BinaryKVMessageSize(header.keys_num, header.lens_num, header.values_num) != size) {
+    MS_LOG(ERROR) << "The size " << size << " of the binary KVMessage does not match the keys num " << header.keys_num
+                  << ", the lens num " << header.lens_num << " and the values num " << header.values_num;
+    return false;
+  }
+
+  auto payload = static_cast<const uint8_t *>(data);
+  if (reinterpret_cast<uintptr_t>(payload) % alignof(uint64_t) != 0) {
+    aligned_copy_ = std::make_unique<uint64_t[]>((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    (void)std::memcpy(aligned_copy_.get(), data, size);
+    payload = reinterpret_cast<const uint8_t *>(aligned_copy_.get());
+  }
+  payload += sizeof(BinaryKVHeader);
+  arrays_.keys_num = header.keys_num;
+  arrays_.keys = reinterpret_cast<const uint64_t *>(payload);
+  payload += header.keys_num * sizeof(uint64_t);
+  arrays_.lens_num = header.lens_num;
+  arrays_.lens = reinterpret_cast<const uint64_t *>(payload);
+  payload += header.lens_num * sizeof(uint64_t);
+  arrays_.values_num = header.values_num;
+  arrays_.values = reinterpret_cast<const float *>(payload);
+  return true;
+}
+
+uint64_t KVMessageView::keys(size_t index) const {
+  if (index >= arrays_.keys_num) {
+    MS_LOG(EXCEPTION) << "The key index " << index << " is out of range " << arrays_.keys_num;
+  }
+  return arrays_.keys[index];
+}
+
+float KVMessageView::values(size_t index) const {
+  if (index >= arrays_.values_num) {
+    MS_LOG(EXCEPTION) << "The value index " << index << " is out of range " << arrays_.values_num;
+  }
+  return arrays_.values[index];
+}
+
+uint64_t KVMessageView::len(size_t index) const {
+  if (index >= arrays_.lens_num) {
+    MS_LOG(EXCEPTION) << "The len index " << index << " is out of range " << arrays_.lens_num;
+  }
+  return arrays_.lens[index];
+}
+}  // namespace ps
+}  // namespace mindspore
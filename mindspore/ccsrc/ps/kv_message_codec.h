@@ -0,0 +1,128 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_KV_MESSAGE_CODEC_H_
+#define MINDSPORE_CCSRC_PS_KV_MESSAGE_CODEC_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "ps/constants.h"
+#include "proto/ps.pb.h"
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+#include "include/backend/visible.h"
+
+namespace mindspore {
+namespace ps {
+// The arrays of a KVMessage owned by vectors, such as the slice of a message partitioned for one server, which is
+// encoded directly without being filled into a protobuf KVMessage first.
+struct KVMessageSlice {
+  std::vector<uint64_t> keys;
+  std::vector<float> values;
+  std::vector<uint64_t> lens;
+};
+
+// The arrays of a KVMessage, which are referred instead of being copied.
+struct KVMessageArrays {
+  KVMessageArrays() = default;
+  explicit KVMessageArrays(const KVMessage &message)
+      : keys(message.keys().data()),
+        keys_num(IntToSize(message.keys_size())),
+        values(message.values().data()),
+        values_num(IntToSize(message.values_size())),
+        lens(message.len().data()),
+        lens_num(IntToSize(message.len_size())) {}
+  // The vectors must outlive the arrays.
+  KVMessageArrays(const std::vector<uint64_t> &keys_vec, const std::vector<float> &values_vec,
+                  const std::vector<uint64_t> &lens_vec)
+      : keys(keys_vec.data()),
+        keys_num(keys_vec.size()),
+        values(values_vec.data()),
+        values_num(values_vec.size()),
+        lens(lens_vec.data()),
+        lens_num(lens_vec.size()) {}
+  explicit KVMessageArrays(const KVMessageSlice &slice) : KVMessageArrays(slice.keys, slice.values, slice.lens) {}
+
+  const uint64_t *keys{nullptr};
+  size_t keys_num{0};
+  const float *values{nullptr};
+  size_t values_num{0};
+  const uint64_t *lens{nullptr};
+  size_t lens_num{0};
+};
+
+// The binary wire format of the KVMessage is a fixed header followed by the key, length and value arrays:
+//   | magic(4) | version(4) | keys num(8) | lens num(8) | values num(8) | keys | lens | values |
+// The arrays are in the host byte order and every array starts at an offset aligned to its element size, so the
+// receiver reads them in place. The first byte of the magic is 0, which never starts a valid protobuf message, so the
+// receiver tells the two formats apart without any flag.
+//
+// Get the size of the KVMessage encoded in the wire format.
+BACKEND_EXPORT size_t EncodedKVMessageSize(const KVMessageArrays &arrays, uint32_t wire_format);
+// Encode the KVMessage in the wire format into the buffer, whose size should be the encoded size.
+BACKEND_EXPORT void EncodeKVMessage(const KVMessageArrays &arrays, uint32_t wire_format, void *buffer,
+                                    size_t buffer_size);
+
+// Encode the KVMessage into a std::string or std::vector<unsigned char>, which is resized to the encoded size.
+template <typename Buffer>
+void EncodeKVMessage(const KVMessageArrays &arrays, uint32_t wire_format, Buffer *output) {
+  MS_EXCEPTION_IF_NULL(output);
+  output->resize(EncodedKVMessageSize(arrays, wire_format));
+  EncodeKVMessage(arrays, wire_format, output->data(), output->size());
+}
+
+// KVMessageView parses a KVMessage payload in either wire format. The arrays of the binary format are read in place
+// from the payload if it is aligned, so the payload must outlive the view. The protobuf format is parsed into the
+// view.
+class BACKEND_EXPORT KVMessageView {
+ public:
+  KVMessageView() = default;
+  ~KVMessageView() = default;
+
+  // Return false if the payload is in neither wire format.
+  bool Parse(const void *data, size_t size);
+
+  // The wire format of the parsed payload.
+  uint32_t wire_format() const { return wire_format_; }
+
+  const uint64_t *keys_data() const { return arrays_.keys; }
+  size_t keys_size() const { return arrays_.keys_num; }
+  uint64_t keys(size_t index) const;
+
+  const float *values_data() const { return arrays_.values; }
+  size_t values_size() const { return arrays_.values_num; }
+  float values(size_t index) const;
+
+  const uint64_t *len_data() const { return arrays_.lens; }
+  size_t len_size() const { return arrays_.lens_num; }
+  uint64_t len(size_t index) const;
+
+  const KVMessageArrays &arrays() const { return arrays_; }
+
+ private:
+  bool ParseBinary(const void *data, size_t size);
+
+  uint32_t wire_format_{kProtobufWireFormat};
+  KVMessageArrays arrays_;
+  // The message parsed from the protobuf format.
+  KVMessage message_;
+  // The copy of the binary payload which is not aligned.
+  std::unique_ptr<uint64_t[]> aligned_copy_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_KV_MESSAGE_CODEC_H_
@@ -79,7 +79,7 @@ void OptimizerInfo::UpdateOptimInputValue(const std::string &optim_type, const s
   return;
 }
 
-void DenseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
+void DenseOptimInfo::Accumulate(const float *values, const Lengths &lengths) {
   MS_EXCEPTION_IF_NULL(gradient()->addr);
   float *accum_grad_data = reinterpret_cast<float *>(gradient()->addr);
   size_t size = gradient()->size / sizeof(float);
@@ -88,7 +88,7 @@ void DenseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
   for (size_t i = 0; i < grad_index; i++) {
     grad_offset += IntToSize(lengths[i]);
   }
-  float *grad_data = const_cast<float *>(values.data()) + grad_offset;
+  float *grad_data = const_cast<float *>(values) + grad_offset;
   MS_EXCEPTION_IF_NULL(grad_data);
 #define google mindspore_private
   CHECK_EQ(size, IntToSize(lengths[grad_index]));
@@ -118,7 +118,7 @@ void DenseOptimInfo::Reset() {
   }
 }
 
-void SparseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
+void SparseOptimInfo::Accumulate(const float *values, const Lengths &lengths) {
   // Append grad data to the end
   MS_EXCEPTION_IF_NULL(gradient()->addr);
   float *accum_grad_data = reinterpret_cast<float *>(gradient()->addr);
@@ -128,7 +128,7 @@ void SparseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
   for (size_t i = 0; i < grad_index; i++) {
     grad_offset += IntToSize(lengths[i]);
   }
-  float *incr_grad_data = const_cast<float *>(values.data()) + grad_offset;
+  float *incr_grad_data = const_cast<float *>(values) + grad_offset;
   MS_EXCEPTION_IF_NULL(incr_grad_data);
 
   size_t incr_grad_size = IntToSize(lengths[grad_index]) * sizeof(float);
@@ -157,7 +157,7 @@ void SparseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
     indice_offset += IntToSize(lengths[i]);
   }
 
-  void *incr_indice_data_temp = const_cast<float *>(values.data()) + indice_offset;
+  void *incr_indice_data_temp = const_cast<float *>(values) + indice_offset;
   MS_EXCEPTION_IF_NULL(incr_indice_data_temp);
   int *incr_indice_data = reinterpret_cast<int *>(incr_indice_data_temp);
   MS_EXCEPTION_IF_NULL(incr_indice_data);
@@ -276,8 +276,8 @@ MomentumOptimInfo::MomentumOptimInfo(const AddressPtr &weight, const AddressPtr
   inputs_.push_back(momentum);
 }
 
-void MomentumOptimInfo::Update(const Values &values, const Lengths &lens) {
-  UpdateOptimInputValue<float>(kApplyMomentum, "lr", const_cast<float *>(values.data()), lens);
+void MomentumOptimInfo::Update(const float *values, const Lengths &lens) {
+  UpdateOptimInputValue<float>(kApplyMomentum, "lr", const_cast<float *>(values), lens);
 }
 
 const size_t SparseOptimInfo::indice_size() const { return indices_offset_; }
@@ -333,13 +333,13 @@ SparseAdamOptimInfo::SparseAdamOptimInfo(const AddressPtr &weight, const Address
   sharded_ = sharded;
 }
 
-void SparseAdamOptimInfo::Update(const Values &values, const Lengths &lens) {
-  UpdateOptimInputValue<float>(kSparseAdam, "beta1_power", const_cast<float *>(values.data()), lens);
-  UpdateOptimInputValue<float>(kSparseAdam, "beta2_power", const_cast<float *>(values.data()), lens);
-  UpdateOptimInputValue<float>(kSparseAdam, "lr", const_cast<float *>(values.data()), lens);
-  UpdateOptimInputValue<float>(kSparseAdam, "beta1", const_cast<float *>(values.data()), lens);
-  UpdateOptimInputValue<float>(kSparseAdam, "beta2", const_cast<float *>(values.data()), lens);
-  UpdateOptimInputValue<float>(kSparseAdam, "eps", const_cast<float *>(values.data()), lens);
+void SparseAdamOptimInfo::Update(const float *values, const Lengths &lens) {
+  UpdateOptimInputValue<float>(kSparseAdam, "beta1_power", const_cast<float *>(values), lens);
+  UpdateOptimInputValue<float>(kSparseAdam, "beta2_power", const_cast<float *>(values), lens);
+  UpdateOptimInputValue<float>(kSparseAdam, "lr", const_cast<float *>(values), lens);
+  UpdateOptimInputValue<float>(kSparseAdam, "beta1", const_cast<float *>(values), lens);
+  UpdateOptimInputValue<float>(kSparseAdam, "beta2", const_cast<float *>(values), lens);
+  UpdateOptimInputValue<float>(kSparseAdam, "eps", const_cast<float *>(values), lens);
 }
 
 const AddressPtr &SparseAdamOptimInfo::gradient() {
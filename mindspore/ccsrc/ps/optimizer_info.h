@@ -30,8 +30,8 @@ class OptimizerInfo {
   OptimizerInfo() = default;
   virtual ~OptimizerInfo() = default;
 
-  virtual void Update(const Values &values, const Lengths &lengths) {}
-  virtual void Accumulate(const Values &values, const Lengths &lengths) = 0;
+  virtual void Update(const float *values, const Lengths &lengths) {}
+  virtual void Accumulate(const float *values, const Lengths &lengths) = 0;
   virtual void ComputeMean(const std::vector<ShapeVector> &shapes, size_t n, size_t server_num, size_t rank_id) {}
   virtual void Reset() {}
   void AddWorkspace(const AddressPtr &workspace);
@@ -61,7 +61,7 @@ class DenseOptimInfo : public OptimizerInfo {
   DenseOptimInfo() = default;
   ~DenseOptimInfo() override = default;
 
-  void Accumulate(const Values &values, const Lengths &lens) override;
+  void Accumulate(const float *values, const Lengths &lens) override;
   void ComputeMean(const std::vector<ShapeVector> &shapes, size_t n, size_t server_num, size_t rank_id) override;
   void Reset() override;
 };
@@ -71,7 +71,7 @@ class SparseOptimInfo : public OptimizerInfo {
   SparseOptimInfo() = default;
   ~SparseOptimInfo() override = default;
 
-  void Accumulate(const Values &values, const Lengths &lens) override;
+  void Accumulate(const float *values, const Lengths &lens) override;
   void ComputeMean(const std::vector<ShapeVector> &shapes, size_t n, size_t server_num, size_t rank_id) override;
   void Reset() override;
   const size_t indice_size() const override;
@@ -88,7 +88,7 @@ class MomentumOptimInfo : public DenseOptimInfo {
                     const AddressPtr &gradient, const AddressPtr &momentum);
   ~MomentumOptimInfo() override = default;
 
-  void Update(const Values &values, const Lengths &lens) override;
+  void Update(const float *values, const Lengths &lens) override;
   const AddressPtr &gradient();
   const AddressPtr &indices();
   size_t grad_index() override;
@@ -102,7 +102,7 @@ class SparseAdamOptimInfo : public SparseOptimInfo {
                       const AddressPtr &indices, bool sharded);
   ~SparseAdamOptimInfo() override = default;
 
-  void Update(const Values &values, const Lengths &lens) override;
+  void Update(const float *values, const Lengths &lens) override;
   const AddressPtr &gradient();
   const AddressPtr &indices();
   bool IsSparse() const override;
@@ -24,14 +24,12 @@ namespace mindspore {
 namespace ps {
 using mindspore::kernel::ps::SparseApplyFtrlPSKernelMod;
 OptimizerInfo *OptimizerInfoBuilder::Build(const std::shared_ptr<PServerKernel> &pserver_kernel,
-                                           const WeightPtr &weight, const Keys &keys, const Values &values,
-                                           const Lengths &lens, const InputsShapePtr &inputs_shape, size_t worker_num,
-                                           bool sharded) {
+                                           const WeightPtr &weight, const float *values, const Lengths &lens,
+                                           const InputsShapePtr &inputs_shape, size_t worker_num, bool sharded) {
   MS_EXCEPTION_IF_NULL(pserver_kernel);
   MS_EXCEPTION_IF_NULL(weight);
   MS_EXCEPTION_IF_NULL(inputs_shape);
-  OptimizerInfo *optim_info =
-    BuildInputs(weight, keys, values, lens, inputs_shape, worker_num, pserver_kernel, sharded);
+  OptimizerInfo *optim_info = BuildInputs(weight, values, lens, inputs_shape, worker_num, pserver_kernel, sharded);
   MS_EXCEPTION_IF_NULL(optim_info);
   std::vector<size_t> ws_sizes = pserver_kernel->workspace_sizes();
   BuildWorkspaces(optim_info, ws_sizes, worker_num);
@@ -111,8 +109,8 @@ AddressPtr OptimizerInfoBuilder::GenInputAddrPtr(const std::string &optim_type,
   return addr_ptr;
 }
 
-OptimizerInfo *MomentumOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const Keys &, const Values &values,
-                                                     const Lengths &lens, const InputsShapePtr &, size_t,
+OptimizerInfo *MomentumOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const float *values, const Lengths &lens,
+                                                     const InputsShapePtr &, size_t,
                                                      const std::shared_ptr<PServerKernel> &, bool) {
   MS_EXCEPTION_IF_NULL(weight);
   AddressPtr weight_addr = std::make_shared<kernel::Address>();
@@ -134,16 +132,16 @@ OptimizerInfo *MomentumOptimInfoBuilder::BuildInputs(const WeightPtr &weight, co
     return nullptr;
   }
 
-  AddressPtr learning_rate = GenInputAddrPtr<float>(kApplyMomentum, "lr", const_cast<float *>(values.data()), lens);
+  AddressPtr learning_rate = GenInputAddrPtr<float>(kApplyMomentum, "lr", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(learning_rate);
-  AddressPtr gradient = GenInputAddrPtr<float>(kApplyMomentum, "grad", const_cast<float *>(values.data()), lens);
+  AddressPtr gradient = GenInputAddrPtr<float>(kApplyMomentum, "grad", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(gradient);
-  AddressPtr momentum = GenInputAddrPtr<float>(kApplyMomentum, "momentum", const_cast<float *>(values.data()), lens);
+  AddressPtr momentum = GenInputAddrPtr<float>(kApplyMomentum, "momentum", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(momentum);
   return new MomentumOptimInfo(weight_addr, accumulate, learning_rate, gradient, momentum);
 }
 
-OptimizerInfo *SparseAdamOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const Keys &, const Values &values,
+OptimizerInfo *SparseAdamOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const float *values,
                                                        const Lengths &lens, const InputsShapePtr &inputs_shape, size_t,
                                                        const std::shared_ptr<PServerKernel> &, bool sharded) {
   AddressPtr weight_addr = std::make_shared<kernel::Address>();
@@ -181,28 +179,27 @@ OptimizerInfo *SparseAdamOptimInfoBuilder::BuildInputs(const WeightPtr &weight,
     return nullptr;
   }
 
-  AddressPtr beta1_power = GenInputAddrPtr<float>(kSparseAdam, "beta1_power", const_cast<float *>(values.data()), lens);
+  AddressPtr beta1_power = GenInputAddrPtr<float>(kSparseAdam, "beta1_power", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(beta1_power);
-  AddressPtr beta2_power = GenInputAddrPtr<float>(kSparseAdam, "beta2_power", const_cast<float *>(values.data()), lens);
+  AddressPtr beta2_power = GenInputAddrPtr<float>(kSparseAdam, "beta2_power", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(beta2_power);
-  AddressPtr learning_rate = GenInputAddrPtr<float>(kSparseAdam, "lr", const_cast<float *>(values.data()), lens);
+  AddressPtr learning_rate = GenInputAddrPtr<float>(kSparseAdam, "lr", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(learning_rate);
-  AddressPtr beta1 = GenInputAddrPtr<float>(kSparseAdam, "beta1", const_cast<float *>(values.data()), lens);
+  AddressPtr beta1 = GenInputAddrPtr<float>(kSparseAdam, "beta1", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(beta1);
-  AddressPtr beta2 = GenInputAddrPtr<float>(kSparseAdam, "beta2", const_cast<float *>(values.data()), lens);
+  AddressPtr beta2 = GenInputAddrPtr<float>(kSparseAdam, "beta2", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(beta2);
-  AddressPtr epsilon = GenInputAddrPtr<float>(kSparseAdam, "eps", const_cast<float *>(values.data()), lens);
+  AddressPtr epsilon = GenInputAddrPtr<float>(kSparseAdam, "eps", const_cast<float *>(values), lens);
   MS_EXCEPTION_IF_NULL(epsilon);
-  AddressPtr grad = GenInputAddrPtr<float>(kSparseAdam, "grad", const_cast<float *>(values.data()), lens, inputs_shape);
+  AddressPtr grad = GenInputAddrPtr<float>(kSparseAdam, "grad", const_cast<float *>(values), lens, inputs_shape);
   MS_EXCEPTION_IF_NULL(grad);
-  AddressPtr indices =
-    GenInputAddrPtr<float>(kSparseAdam, "indices", const_cast<float *>(values.data()), lens, inputs_shape);
+  AddressPtr indices = GenInputAddrPtr<float>(kSparseAdam, "indices", const_cast<float *>(values), lens, inputs_shape);
   MS_EXCEPTION_IF_NULL(indices);
   return new SparseAdamOptimInfo(weight_addr, m, v, beta1_power, beta2_power, learning_rate, beta1, beta2, epsilon,
                                  grad, indices, sharded);
 }
 
-OptimizerInfo *SparseFtrlOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const Keys &, const Values &values,
+OptimizerInfo *SparseFtrlOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const float *values,
                                                        const Lengths &lens, const InputsShapePtr &inputs_shape, size_t,
                                                        const std::shared_ptr<PServerKernel> &pserver_kernel,
                                                        bool sharded) {
@@ -237,10 +234,9 @@ OptimizerInfo *SparseFtrlOptimInfoBuilder::BuildInputs(const WeightPtr &weight,
     return nullptr;
   }
 
-  AddressPtr grad = GenInputAddrPtr<float>(kSparseFtrl, "grad", const_cast<float *>(values.data()), lens, inputs_shape);
+  AddressPtr grad = GenInputAddrPtr<float>(kSparseFtrl, "grad", const_cast<float *>(values), lens, inputs_shape);
   MS_EXCEPTION_IF_NULL(grad);
-  AddressPtr indices =
-    GenInputAddrPtr<float>(kSparseFtrl, "indices", const_cast<float *>(values.data()), lens, inputs_shape);
+  AddressPtr indices = GenInputAddrPtr<float>(kSparseFtrl, "indices", const_cast<float *>(values), lens, inputs_shape);
   MS_EXCEPTION_IF_NULL(indices);
   return new SparseFtrlOptimInfo(weight_addr, accum, linear, grad, indices, sharded);
 }
@@ -20,11 +20,15 @@
 #include <set>
 
 #include "utils/file_utils.h"
+#include "include/common/thread_pool.h"
+#include "distributed/recovery/recovery_context.h"
 
 namespace mindspore {
 namespace ps {
 static const uint32_t kMaxThreadNum = 16;
 static const uint32_t kCPUCoreNum = std::thread::hardware_concurrency();
+// The dense weights larger than this are updated in shards by multiple threads.
+static const size_t kLargeWeightShardBytes = 1 << 20;
 
 ParameterServer &ParameterServer::GetInstance() {
   static ParameterServer instance{};
@@ -66,6 +70,7 @@ bool ParameterServer::Init(const FuncGraphPtr &func_graph) {
   pserver_num_ = std::strtol(mindspore::common::GetEnv(kEnvPServerNum).c_str(), nullptr, kBase);
   worker_num_ = std::strtol(mindspore::common::GetEnv(kEnvWorkerNum).c_str(), nullptr, kBase);
   func_graph_ = func_graph;
+  InitAsyncUpdater();
   handler_.reset(new ServerHandler(this));
   handler_->Init();
 
@@ -108,19 +113,23 @@ void ParameterServer::InitWeightKeyToOptims(const Key &key, const int64_t &optim
                << ", optimizer op name:" << weight_key_to_optim_op_[key];
 }
 
-void ParameterServer::InitOptimInputsShape(const Keys &keys, const Values &values, const Lengths &lengths) {
+void ParameterServer::InitOptimInputsShape(const KVMessageArrays &arrays) {
   InputsShapePtr inputs_shape = std::make_shared<InputsShape>();
   MS_EXCEPTION_IF_NULL(inputs_shape);
   InputsShapePtr original_inputs_shape = std::make_shared<InputsShape>();
   MS_EXCEPTION_IF_NULL(original_inputs_shape);
+  if (arrays.keys_num == 0 || arrays.lens_num < arrays.keys_num) {
+    MS_LOG(EXCEPTION) << "The keys num " << arrays.keys_num << " and lens num " << arrays.lens_num
+                      << " of the optimizer inputs shape are invalid.";
+  }
   size_t val_idx = 0;
-  const Key &key = keys[0];
+  const Key &key = arrays.keys[0];
   MS_LOG(INFO) << "Initializing optimizer inputs shape for key:" << key;
   if (optim_inputs_shape_.count(key) == 0) {
     original_optim_inputs_shape_[key] = original_inputs_shape;
     optim_inputs_shape_[key] = inputs_shape;
   }
-  for (size_t i = 0; i < keys.size(); i++) {
+  for (size_t i = 0; i < arrays.keys_num; i++) {
     auto shape = std::make_shared<ShapeVector>();
     MS_EXCEPTION_IF_NULL(shape);
     auto original_shape = std::make_shared<ShapeVector>();
@@ -128,9 +137,12 @@ void ParameterServer::InitOptimInputsShape(const Keys &keys, const Values &value
     inputs_shape->push_back(shape);
     original_inputs_shape->push_back(original_shape);
 
-    for (int64_t j = 0; j < lengths[i]; j++) {
-      shape->push_back(values[val_idx]);
-      original_shape->push_back(values[val_idx++]);
+    if (val_idx + arrays.lens[i] > arrays.values_num) {
+      MS_LOG(EXCEPTION) << "The values num " << arrays.values_num << " of the optimizer inputs shape is too small.";
+    }
+    for (uint64_t j = 0; j < arrays.lens[i]; j++) {
+      shape->push_back(arrays.values[val_idx]);
+      original_shape->push_back(arrays.values[val_idx++]);
     }
   }
   if (weight_key_to_optims_.count(key) > 0) {
@@ -312,6 +324,8 @@ void ParameterServer::PersistInitParameters(const Key &key, const WeightPtr &par
   MS_EXCEPTION_IF_NULL(persistent_weight);
   std::map<std::string, std::string> config_map;
   config_map[distributed::storage::kFileStoragePath] = real_storage_file_path;
+  config_map[distributed::storage::kMaxDeltaNum] =
+    std::to_string(distributed::recovery::RecoveryContext::GetInstance()->max_delta_num());
   persistent_weight->Initialize(config_map);
 
   (void)weights_dirty_info_.emplace(key, distributed::storage::DirtyInfo());
@@ -401,6 +415,15 @@ void ParameterServer::Finalize() {
 }
 
 void ParameterServer::UpdateWeights() {
+  if (EnableStaleness()) {
+    // The weights are updated by the update threads of the async updater, so just wait for finalizing.
+    std::unique_lock<std::mutex> lock(mutex_);
+    apply_grads_cv_.wait(lock, [this] { return !running_; });
+    lock.unlock();
+    async_updater_->Stop();
+    return;
+  }
+
   while (true) {
     MS_LOG(INFO) << "The running is:" << running_ << " the ready is:" << this->ReadyForUpdateWeights();
     std::unique_lock<std::mutex> lock(mutex_);
@@ -421,24 +444,9 @@ void ParameterServer::UpdateWeights() {
 
       std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
       if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-        std::vector<ShapeVector> shapes = {};
-        ShapeVector indices_shape = {};
-        indices_shape.emplace_back(SizeToLong(optim_info->indice_size()));
-        shapes.push_back(indices_shape);
-
-        if (original_optim_inputs_shape_.count(key) != 0) {
-          std::transform((*(original_optim_inputs_shape_[key])).begin(), (*(original_optim_inputs_shape_[key])).end(),
-                         std::back_inserter(shapes),
-                         [](const std::shared_ptr<ShapeVector> &input_shapes) -> ShapeVector { return *input_shapes; });
-        }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
+        InputsShapePtr original_inputs_shape =
+          original_optim_inputs_shape_.count(key) != 0 ? original_optim_inputs_shape_[key] : nullptr;
+        ApplyOptimizer(optimizer, optim_info, original_inputs_shape);
       }
       if (!is_embedding_[key]) {
         tokens_[key] = worker_num_;
@@ -448,29 +456,67 @@ void ParameterServer::UpdateWeights() {
   }
 }
 
-void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
+void ParameterServer::ApplyOptimizer(const std::shared_ptr<PServerKernel> &optimizer,
+                                     const std::shared_ptr<OptimizerInfo> &optim_info,
+                                     const InputsShapePtr &original_inputs_shape) {
+  MS_EXCEPTION_IF_NULL(optimizer);
+  MS_EXCEPTION_IF_NULL(optim_info);
+  std::vector<ShapeVector> shapes = {};
+  ShapeVector indices_shape = {};
+  indices_shape.emplace_back(SizeToLong(optim_info->indice_size()));
+  shapes.push_back(indices_shape);
+
+  if (original_inputs_shape != nullptr) {
+    std::transform(original_inputs_shape->begin(), original_inputs_shape->end(), std::back_inserter(shapes),
+                   [](const std::shared_ptr<ShapeVector> &input_shapes) -> ShapeVector { return *input_shapes; });
+  }
+  optimizer->ReInit(shapes);
+  // The accumulated gradients are always averaged by the worker number, so in the SSP mode every push contributes the
+  // same as it does in the synchronous mode however many pushes are applied in one batch.
+  optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
+  ExecuteOptimizer(optimizer, optim_info);
+  optim_info->Reset();
+}
+
+void ParameterServer::ExecuteOptimizer(const std::shared_ptr<PServerKernel> &optimizer,
+                                       const std::shared_ptr<OptimizerInfo> &optim_info) const {
+  const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+  const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+  const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+  // The weight is the first input, and the only dense optimizer ApplyMomentum is element-wise and keeps no state in the
+  // kernel, so one kernel can update the shards of the weight in parallel.
+  size_t weight_size = (inputs.empty() || inputs[0] == nullptr) ? 0 : inputs[0]->size;
+  size_t thread_num =
+    std::min(static_cast<size_t>(kMaxThreadNum), common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+  if (optim_info->IsSparse() || weight_size < kLargeWeightShardBytes || thread_num <= 1) {
+    optimizer->Execute(inputs, workspaces, outputs);
+    return;
+  }
+
+  // Every shard has its own workspaces and outputs, so the threads never write to the same memory.
+  auto shards = SplitElementWiseOptimizer(inputs, workspaces, outputs, thread_num);
+  std::vector<common::Task> tasks;
+  for (const auto &shard : shards) {
+    tasks.emplace_back([&optimizer, &shard]() {
+      return optimizer->Execute(shard.inputs, shard.workspaces, shard.outputs) ? common::SUCCESS : common::FAIL;
+    });
+  }
+  if (!common::ThreadPool::GetInstance().SyncRun(tasks)) {
+    MS_LOG(EXCEPTION) << "Failed to update the weight of size " << weight_size << " in shards.";
+  }
+}
+
+void ParameterServer::AccumGrad(const KVMessageArrays &arrays) {
   std::unique_lock<std::mutex> lock(mutex_);
-  const Key &key = keys[0];
-  bool no_sparse_grad = values.size() == 1 && values[0] == kGradValue;
+  if (arrays.keys_num == 0) {
+    MS_LOG(EXCEPTION) << "The keys of the pushed gradients are empty.";
+  }
+  const Key &key = arrays.keys[0];
+  bool no_sparse_grad = arrays.values_num == 1 && arrays.values[0] == kGradValue;
   if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-    // Create or update the optimizer info
-    if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
-      }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
-                                            optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
-      optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
-    } else {
-      optim_info->Update(values, lengths);
-      optim_info->Accumulate(values, lengths);
-    }
+    // Only the lengths, whose number is the number of the optimizer inputs, are converted.
+    Lengths lengths(arrays.lens, arrays.lens + arrays.lens_num);
+    (void)AccumOptimInfo(key, arrays.values, lengths);
   }
 
   grads_accum_counter_[key] += 1;
@@ -482,6 +528,93 @@ void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Le
   }
 }
 
+std::shared_ptr<OptimizerInfo> ParameterServer::AccumOptimInfo(const Key &key, const float *values,
+                                                               const Lengths &lengths) {
+  std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
+
+  // Create or update the optimizer info
+  if (optim_info == nullptr) {
+    const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
+    std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
+    if (pserver_kernel == nullptr) {
+      MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+    }
+    MS_EXCEPTION_IF_NULL(pserver_kernel);
+    OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], values, lengths, optim_inputs_shape_[key],
+                                          worker_num_, is_embedding_[key]);
+    optim_info.reset(optim);
+    optim_infos_[key] = optim_info;
+  } else {
+    optim_info->Update(values, lengths);
+    optim_info->Accumulate(values, lengths);
+  }
+  return optim_info;
+}
+
+void ParameterServer::InitAsyncUpdater() {
+  std::string staleness_env = mindspore::common::GetEnv(kEnvStalenessThreshold);
+  if (staleness_env.empty()) {
+    return;
+  }
+  auto staleness_threshold = std::strtol(staleness_env.c_str(), nullptr, kBase);
+  if (staleness_threshold < 0) {
+    MS_LOG(EXCEPTION) << "The staleness threshold " << kEnvStalenessThreshold << " should not be negative, but got "
+                      << staleness_env;
+  }
+  size_t thread_num = std::max(static_cast<uint32_t>(1), std::min(kMaxThreadNum, kCPUCoreNum));
+  async_updater_ = std::make_unique<AsyncUpdater>(
+    worker_num_, LongToSize(staleness_threshold), thread_num,
+    [this](const Key &key, const std::vector<GradUpdatePtr> &updates) { ApplyUpdates(key, updates); });
+  async_updater_->Start();
+  MS_LOG(INFO) << "The parameter server runs in SSP mode with the staleness threshold " << staleness_threshold;
+}
+
+void ParameterServer::AsyncAccumGrad(uint32_t worker_rank, const KVMessageArrays &arrays) {
+  MS_EXCEPTION_IF_NULL(async_updater_);
+  if (arrays.keys_num == 0) {
+    MS_LOG(EXCEPTION) << "The keys of the pushed gradients are empty.";
+  }
+  auto update = std::make_shared<GradUpdate>();
+  update->worker_rank = worker_rank;
+  update->keys.assign(arrays.keys, arrays.keys + arrays.keys_num);
+  update->values.assign(arrays.values, arrays.values + arrays.values_num);
+  update->lengths.assign(arrays.lens, arrays.lens + arrays.lens_num);
+  async_updater_->Push(arrays.keys[0], update);
+}
+
+void ParameterServer::ApplyUpdates(const Key &key, const std::vector<GradUpdatePtr> &updates) {
+  std::shared_ptr<PServerKernel> optimizer = nullptr;
+  std::shared_ptr<OptimizerInfo> optim_info = nullptr;
+  InputsShapePtr original_inputs_shape = nullptr;
+  {
+    // Only the shared maps are accessed with the mutex locked, and the weight of the key is protected by the weight
+    // lock held by the async updater, so the different keys are updated in parallel.
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto &update : updates) {
+      MS_EXCEPTION_IF_NULL(update);
+      bool no_sparse_grad = update->values.size() == 1 && update->values[0] == kGradValue;
+      if (!no_sparse_grad) {
+        optim_info = AccumOptimInfo(key, update->values.data(), update->lengths);
+      }
+    }
+    if (optim_info == nullptr) {
+      return;
+    }
+    optimizer = optimizers_[key];
+    if (original_optim_inputs_shape_.count(key) != 0) {
+      original_inputs_shape = original_optim_inputs_shape_[key];
+    }
+  }
+  ApplyOptimizer(optimizer, optim_info, original_inputs_shape);
+}
+
+std::unique_lock<std::mutex> ParameterServer::LockWeight(const Key &key) {
+  if (!EnableStaleness()) {
+    return std::unique_lock<std::mutex>();
+  }
+  return std::unique_lock<std::mutex>(async_updater_->WeightMutex(key));
+}
+
 WeightPtr ParameterServer::weight(const Key &key) {
   std::unique_lock<std::mutex> lock(mutex_);
   if (weights_.count(key) == 0) {
@@ -489,7 +622,9 @@ WeightPtr ParameterServer::weight(const Key &key) {
   }
   WeightPtr weight_ptr = weights_[key];
   MS_EXCEPTION_IF_NULL(weight_ptr);
-  tokens_[key] -= 1;
+  if (!EnableStaleness()) {
+    tokens_[key] -= 1;
+  }
   return weight_ptr;
 }
 
@@ -500,6 +635,7 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
     }
   }
 
+  auto weight_lock = LockWeight(key);
   std::unique_lock<std::mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
   if (weights_.count(key) == 0) {
@@ -557,13 +693,20 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
   res->add_len(res->values_size());
 }
 
-void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals) {
+void ParameterServer::UpdateEmbeddings(const KVMessageArrays &arrays) {
+  if (arrays.keys_num == 0) {
+    MS_LOG(EXCEPTION) << "The key of the embedding table to update is missing.";
+  }
+  const Key key = arrays.keys[0];
+  const Key *lookup_ids = arrays.keys + 1;
+  size_t ids_num = arrays.keys_num - 1;
   if (EnableRecovery()) {
     while (!finish_recovery_) {
       std::this_thread::yield();
     }
   }
 
+  auto weight_lock = LockWeight(key);
   std::unique_lock<std::mutex> locker(access_weight_mutex_);
 
   if (weights_.count(key) == 0) {
@@ -578,15 +721,15 @@ void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_i
   MS_EXCEPTION_IF_NULL(table_ptr);
   std::shared_ptr<PServerKernel> lookup_op = embedding_lookup_ops_[key];
   MS_EXCEPTION_IF_NULL(lookup_op);
-  lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids.data(), vals.data(), lookup_ids.size());
+  lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids, arrays.values, ids_num);
 
-  UpdateDirtyInfo(key, lookup_ids, lookup_op->offset());
+  UpdateDirtyInfo(key, lookup_ids, ids_num, lookup_op->offset());
 }
 
-void ParameterServer::UpdateDirtyInfo(const Key &key, const LookupIds &lookup_ids, int64_t offset) {
+void ParameterServer::UpdateDirtyInfo(const Key &key, const Key *lookup_ids, size_t ids_num, int64_t offset) {
   if (EnableRecovery()) {
     std::set<int> sorted_ids;
-    (void)std::for_each(lookup_ids.begin(), lookup_ids.end(), [&](uint64_t id) {
+    (void)std::for_each(lookup_ids, lookup_ids + ids_num, [&](uint64_t id) {
       int index = SizeToInt(id) - LongToInt(offset);
       (void)sorted_ids.insert(index);
     });
@@ -613,6 +756,33 @@ inline bool ParameterServer::ReadyForPush(const Key &key) {
   return grad_accum_count_ < weights_.size() && tokens_[key] == 0;
 }
 
+bool ParameterServer::ReadyForPush(const Key &key, uint32_t worker_rank) {
+  if (!EnableStaleness()) {
+    return ReadyForPush(key);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (weights_.empty()) {
+      MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
+                           "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
+    }
+  }
+  return async_updater_->ReadyForPush(key, worker_rank);
+}
+
+bool ParameterServer::ReadyForPull(const Key &key, uint32_t worker_rank) {
+  if (!EnableStaleness()) {
+    return ReadyForPull(key);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (weights_.count(key) == 0) {
+      MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+    }
+  }
+  return async_updater_->ReadyForPull(key, worker_rank);
+}
+
 inline bool ParameterServer::ReadyForPull(const Key &key) {
   std::unique_lock<std::mutex> lock(mutex_);
   if (tokens_.count(key) == 0 || weights_[key] == 0) {
@@ -767,6 +937,8 @@ void ParameterServer::RecoverParameters(const std::vector<Key> &keys) {
 
       std::map<std::string, std::string> config_map;
       config_map[distributed::storage::kFileStoragePath] = real_storage_file_path;
+      config_map[distributed::storage::kMaxDeltaNum] =
+        std::to_string(distributed::recovery::RecoveryContext::GetInstance()->max_delta_num());
       embedding->Initialize(config_map);
       embedding->Restore();
       weights_[key] = embedding;
@@ -810,30 +982,43 @@ void ParameterServer::PersistParameters() {
     persist_thread_->join();
   }
 
-  auto do_persist_task = [this]() {
-    std::unique_lock<std::mutex> locker(access_weight_mutex_);
-
-    set_persistent_state(core::PersistentState::PERSISTING);
+  set_persistent_state(core::PersistentState::PERSISTING);
 
-    for (const auto &weight_key_pair : weights_) {
-      const WeightPtr &weight = weight_key_pair.second;
-      auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weight);
-      MS_EXCEPTION_IF_NULL(persistent_weight);
+  // Only the dirty rows are copied with the weight locked, and the snapshots are written by the persist thread, so the
+  // training is not blocked by writing the files.
+  std::vector<Key> keys;
+  {
+    std::unique_lock<std::mutex> locker(access_weight_mutex_);
+    (void)std::transform(weights_.begin(), weights_.end(), std::back_inserter(keys),
+                         [](const auto &weight_key_pair) { return weight_key_pair.first; });
+  }
+  std::vector<std::pair<PersistentWeightPtr, distributed::persistent::DataSnapshotPtr<float>>> snapshots;
+  for (const auto &key : keys) {
+    auto weight_lock = LockWeight(key);
+    std::unique_lock<std::mutex> locker(access_weight_mutex_);
+    auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weights_[key]);
+    MS_EXCEPTION_IF_NULL(persistent_weight);
 
-      Key key = weight_key_pair.first;
-      auto iter = weights_dirty_info_.find(key);
-      if (iter == weights_dirty_info_.end()) {
-        MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
-      }
+    auto iter = weights_dirty_info_.find(key);
+    if (iter == weights_dirty_info_.end()) {
+      MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
+    }
 
-      distributed::storage::DirtyInfo &dirty_info = iter->second;
-      persistent_weight->Persist(dirty_info);
+    distributed::storage::DirtyInfo &dirty_info = iter->second;
+    if (dirty_info.empty()) {
+      continue;
+    }
+    (void)snapshots.emplace_back(persistent_weight, persistent_weight->TakeSnapshot(dirty_info));
+    dirty_info.clear();
+  }
 
-      dirty_info.clear();
+  auto do_persist_task = [this, snapshots]() {
+    for (const auto &snapshot : snapshots) {
+      snapshot.first->PersistSnapshot(snapshot.second);
     }
 
     set_persistent_state(core::PersistentState::FINISH_PERSIST);
-    MS_LOG(INFO) << "Finish persist weights in parameter server";
+    MS_LOG(INFO) << "Finish persist weights in parameter server, persisted weight number: " << snapshots.size();
   };
 
   persist_thread_ = std::make_unique<std::thread>(do_persist_task);
@@ -875,13 +1060,13 @@ void ParameterServer::ServerHandler::Init() {
   handlers_[kInitWeightToOptimIdCmd] = &ServerHandler::HandleInitWeightToOptimId;
   handlers_[kInitOptimInputsShapeCmd] = &ServerHandler::HandleInitInputsShape;
   handlers_[kInitEmbeddingsCmd] = &ServerHandler::HandleInitEmbeddings;
-  handlers_[kCheckReadyForPushCmd] = &ServerHandler::HandleCheckReadyForPush;
-  handlers_[kCheckReadyForPullCmd] = &ServerHandler::HandleCheckReadyForPull;
+  worker_handlers_[kCheckReadyForPushCmd] = &ServerHandler::HandleCheckReadyForPush;
+  worker_handlers_[kCheckReadyForPullCmd] = &ServerHandler::HandleCheckReadyForPull;
   handlers_[kEmbeddingLookupCmd] = &ServerHandler::HandleEmbeddingLookup;
   handlers_[kUpdateEmbeddingsCmd] = &ServerHandler::HandleUpdateEmbeddings;
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
-  handlers_[kPushCmd] = &ServerHandler::HandlePushReq;
-  handlers_[kPullCmd] = &ServerHandler::HandlePullReq;
+  worker_handlers_[kPushCmd] = &ServerHandler::HandlePushReq;
+  worker_handlers_[kPullCmd] = &ServerHandler::HandlePullReq;
   commands_[kInitWeightsCmd] = "kInitWeightsCmd";
   commands_[kInitWeightToOptimIdCmd] = "kInitWeightToOptimIdCmd";
   commands_[kInitOptimInputsShapeCmd] = "kInitOptimInputsShapeCmd";
@@ -905,8 +1090,13 @@ void ParameterServer::ServerHandler::operator()(const std::shared_ptr<core::TcpC
   }
   MS_LOG(INFO) << "The command is:" << commands_[meta->user_cmd()];
 
-  auto &handler_ptr = handlers_[meta->user_cmd()];
-  (this->*handler_ptr)(data, size, output);
+  if (worker_handlers_.count(meta->user_cmd()) > 0) {
+    auto &handler_ptr = worker_handlers_[meta->user_cmd()];
+    (this->*handler_ptr)(data, size, meta->rank_id(), output);
+  } else {
+    auto &handler_ptr = handlers_[meta->user_cmd()];
+    (this->*handler_ptr)(data, size, output);
+  }
   MS_LOG(DEBUG) << "The output size is:" << output->size();
 
   if (output->size() > 0) {
@@ -923,51 +1113,52 @@ void ParameterServer::ServerHandler::operator()(const std::shared_ptr<core::TcpC
                      .count();
 }
 
-void ParameterServer::ServerHandler::HandlePushReq(const void *data, size_t size, const VectorPtr &res) {
+void ParameterServer::ServerHandler::HandlePushReq(const void *data, size_t size, uint32_t worker_rank,
+                                                  const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  Keys keys = {input.keys().begin(), input.keys().end()};
-  Values values = {input.values().begin(), input.values().end()};
-  Lengths lens = {input.len().begin(), input.len().end()};
-  MS_LOG(DEBUG) << "The keys:" << keys << " the values:" << values << " the len:" << lens;
-  ps_->AccumGrad(keys, values, lens);
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  MS_LOG(DEBUG) << "The keys num:" << input.keys_size() << " the values num:" << input.values_size()
+                << " the lens num:" << input.len_size();
+  if (ps_->EnableStaleness()) {
+    ps_->AsyncAccumGrad(worker_rank, input.arrays());
+    return;
+  }
+  ps_->AccumGrad(input.arrays());
 }
 
-void ParameterServer::ServerHandler::HandlePullReq(const void *data, size_t size, const VectorPtr &res) {
+void ParameterServer::ServerHandler::HandlePullReq(const void *data, size_t size, uint32_t, const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  KVMessage res_data;
-  *res_data.mutable_keys() = input.keys();
-  Key key = input.keys()[0];
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  Key key = input.keys(0);
+  auto weight_lock = ps_->LockWeight(key);
   auto weight = ps_->weight(key);
   auto weight_data = weight->MutableData();
   MS_EXCEPTION_IF_NULL(weight_data);
-  *res_data.mutable_values() = {weight_data->begin(), weight_data->end()};
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  // The weight is serialized into the response directly instead of being copied into a message first.
+  KVMessageArrays res_data;
+  res_data.keys = input.keys_data();
+  res_data.keys_num = input.keys_size();
+  res_data.values = weight_data->data();
+  res_data.values_num = weight_data->size();
+  SerializeResponse(res_data, res);
 }
 
 void ParameterServer::ServerHandler::HandleInitWeights(const void *data, size_t size, const VectorPtr &res) {
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  int key_num = input.keys_size();
-  const float *data_ptr = input.values().data();
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  size_t key_num = input.keys_size();
+  const float *data_ptr = input.values_data();
   size_t pos = 0;
-  for (int i = 0; i < key_num; i++) {
-    Key key = input.keys()[i];
-    size_t data_len = input.len_size() != key_num ? input.values_size() / key_num : input.len()[i];
+  for (size_t i = 0; i < key_num; i++) {
+    Key key = input.keys(i);
+    size_t data_len = input.len_size() != key_num ? input.values_size() / key_num : input.len(i);
 
     if (!ps_->HasWeight(key)) {
       WeightPtr weight_ptr = Util::MakeWeightPtr(
@@ -987,12 +1178,12 @@ void ParameterServer::ServerHandler::HandleInitWeightToOptimId(const void *data,
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  int key_num = input.keys_size();
-  for (int i = 0; i < key_num; i++) {
-    Key key = input.keys()[i];
-    float val = input.values()[i];
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  size_t key_num = input.keys_size();
+  for (size_t i = 0; i < key_num; i++) {
+    Key key = input.keys(i);
+    float val = input.values(i);
     if (init_weight_to_optim_[key]) {
       continue;
     } else {
@@ -1006,18 +1197,15 @@ void ParameterServer::ServerHandler::HandleInitInputsShape(const void *data, siz
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  const Key &key = input.keys()[0];
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  const Key key = input.keys(0);
   if (init_optim_info_[key]) {
     return;
   } else {
     init_optim_info_[key] = true;
   }
-  Keys keys = {input.keys().begin(), input.keys().end()};
-  Values values = {input.values().begin(), input.values().end()};
-  Lengths lens = {input.len().begin(), input.len().end()};
-  ps_->InitOptimInputsShape(keys, values, lens);
+  ps_->InitOptimInputsShape(input.arrays());
 }
 
 void ParameterServer::ServerHandler::HandleInitEmbeddings(const void *data, size_t size, const VectorPtr &) {
@@ -1058,43 +1246,39 @@ void ParameterServer::ServerHandler::HandleInitEmbeddings(const void *data, size
   ps_->InitEmbeddingTable(key, shapes, param_init_info);
 }
 
-void ParameterServer::ServerHandler::HandleCheckReadyForPush(const void *data, size_t size, const VectorPtr &res) {
+void ParameterServer::ServerHandler::HandleCheckReadyForPush(const void *data, size_t size, uint32_t worker_rank,
+                                                            const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  const Key &key = input.keys()[0];
-  bool ready = ps_->ReadyForPush(key);
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  const Key key = input.keys(0);
+  bool ready = ps_->ReadyForPush(key, worker_rank);
   MS_LOG(INFO) << "The ready is:" << ready;
-  KVMessage res_data;
-  res_data.add_keys(key);
-  res_data.add_values(ready);
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  float ready_value = ready ? 1 : 0;
+  KVMessageArrays res_data;
+  res_data.keys = &key;
+  res_data.keys_num = 1;
+  res_data.values = &ready_value;
+  res_data.values_num = 1;
+  SerializeResponse(res_data, res);
 }
 
-void ParameterServer::ServerHandler::HandleCheckReadyForPull(const void *data, size_t size, const VectorPtr &res) {
+void ParameterServer::ServerHandler::HandleCheckReadyForPull(const void *data, size_t size, uint32_t worker_rank,
+                                                            const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  const Key &key = input.keys()[0];
-  bool ready = ps_->ReadyForPull(key);
-  KVMessage res_data;
-  res_data.add_keys(key);
-  res_data.add_values(ready);
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  const Key key = input.keys(0);
+  bool ready = ps_->ReadyForPull(key, worker_rank);
+  float ready_value = ready ? 1 : 0;
+  KVMessageArrays res_data;
+  res_data.keys = &key;
+  res_data.keys_num = 1;
+  res_data.values = &ready_value;
+  res_data.values_num = 1;
+  SerializeResponse(res_data, res);
 }
 
 void ParameterServer::ServerHandler::HandleEmbeddingLookup(const void *data, size_t size, const VectorPtr &res) {
@@ -1109,26 +1293,16 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(const void *data, siz
   *res_data.mutable_keys() = {input.keys().begin(), input.keys().end()};
 
   ps_->DoEmbeddingLookup(key, keys, &res_data);
-
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  SerializeResponse(KVMessageArrays(res_data), res);
 }
 
 void ParameterServer::ServerHandler::HandleUpdateEmbeddings(const void *data, size_t size, const VectorPtr &res) {
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(data);
   MS_EXCEPTION_IF_NULL(res);
-  KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data, SizeToInt(size)));
-  const Key &key = input.keys()[0];
-  const LookupIds &lookup_ids = {input.keys().begin() + 1, input.keys().end()};
-  const Values &update_vals = {input.values().begin(), input.values().end()};
-  ps_->UpdateEmbeddings(key, lookup_ids, update_vals);
+  KVMessageView input;
+  CHECK_RETURN_TYPE(input.Parse(data, size));
+  ps_->UpdateEmbeddings(input.arrays());
 }
 
 void ParameterServer::ServerHandler::HandleFinalize(const void *, size_t, const VectorPtr &res) {
@@ -1136,6 +1310,12 @@ void ParameterServer::ServerHandler::HandleFinalize(const void *, size_t, const
   ps_->Finalize();
 }
 
+void ParameterServer::ServerHandler::SerializeResponse(const KVMessageArrays &arrays, const VectorPtr &res) const {
+  MS_EXCEPTION_IF_NULL(res);
+  MS_EXCEPTION_IF_NULL(ps_->server_node_);
+  EncodeKVMessage(arrays, ps_->server_node_->wire_format_version(), res.get());
+}
+
 void ParameterServer::RecoverHandler::Init() {
   handlers_[kRecoverEmbedding] = &RecoverHandler::RecoverEmbedding;
 
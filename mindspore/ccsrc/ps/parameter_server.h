@@ -58,6 +58,8 @@
 #include "ps/constants.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/async_updater.h"
+#include "ps/kv_message_codec.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
@@ -95,22 +97,29 @@ class BACKEND_EXPORT ParameterServer {
     void Init();
     void operator()(const std::shared_ptr<core::TcpConnection> &conn, const std::shared_ptr<core::MessageMeta> &meta,
                     const void *data, size_t size);
-    void HandlePushReq(const void *data, size_t size, const VectorPtr &res);
-    void HandlePullReq(const void *data, size_t size, const VectorPtr &res);
+    void HandlePushReq(const void *data, size_t size, uint32_t worker_rank, const VectorPtr &res);
+    void HandlePullReq(const void *data, size_t size, uint32_t worker_rank, const VectorPtr &res);
     void HandleInitWeights(const void *data, size_t size, const VectorPtr &res);
     void HandleInitWeightToOptimId(const void *data, size_t size, const VectorPtr &res);
     void HandleInitInputsShape(const void *data, size_t size, const VectorPtr &res);
     void HandleInitEmbeddings(const void *data, size_t size, const VectorPtr &res);
-    void HandleCheckReadyForPush(const void *data, size_t size, const VectorPtr &res);
-    void HandleCheckReadyForPull(const void *data, size_t size, const VectorPtr &res);
+    void HandleCheckReadyForPush(const void *data, size_t size, uint32_t worker_rank, const VectorPtr &res);
+    void HandleCheckReadyForPull(const void *data, size_t size, uint32_t worker_rank, const VectorPtr &res);
     void HandleEmbeddingLookup(const void *data, size_t size, const VectorPtr &res);
     void HandleUpdateEmbeddings(const void *data, size_t size, const VectorPtr &res);
     void HandleFinalize(const void *data, size_t size, const VectorPtr &res);
 
    private:
+    // Serialize the response in the wire format negotiated with the workers.
+    void SerializeResponse(const KVMessageArrays &arrays, const VectorPtr &res) const;
+
     ParameterServer *ps_;
     typedef void (ServerHandler::*RequestHandler)(const void *data, size_t size, const VectorPtr &res);
+    // The handlers of the requests of the training steps, which depend on the rank of the worker in the SSP mode.
+    typedef void (ServerHandler::*WorkerRequestHandler)(const void *data, size_t size, uint32_t worker_rank,
+                                                        const VectorPtr &res);
     mindspore::HashMap<int, RequestHandler> handlers_;
+    mindspore::HashMap<int, WorkerRequestHandler> worker_handlers_;
     mindspore::HashMap<int, std::string> commands_;
     mindspore::HashMap<Key, bool> init_weights_;
     mindspore::HashMap<Key, bool> init_weight_to_optim_;
@@ -145,7 +154,7 @@ class BACKEND_EXPORT ParameterServer {
   bool Init(const FuncGraphPtr &func_graph);
   void InitOptimInfoBuilders();
   void InitWeightKeyToOptims(const Key &key, const int64_t &optim_id);
-  void InitOptimInputsShape(const Keys &keys, const Values &values, const Lengths &lengths);
+  void InitOptimInputsShape(const KVMessageArrays &arrays);
   void InitWeight(const Key &key, const WeightPtr &weight);
   void InitGrad(const Key &key, const GradPtr &grad);
   void InitEmbeddingTable(const Key &key, const std::shared_ptr<std::vector<std::shared_ptr<ShapeVector>>> &shapes,
@@ -153,14 +162,39 @@ class BACKEND_EXPORT ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
-  void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
+  // Accumulate the pushed gradients, whose arrays are referred from the received message without being copied.
+  void AccumGrad(const KVMessageArrays &arrays);
+  // Create or update the optimizer info of the key with the pushed gradients, which should be called with the mutex
+  // locked.
+  std::shared_ptr<OptimizerInfo> AccumOptimInfo(const Key &key, const float *values, const Lengths &lengths);
+  // Run the optimizer with the accumulated gradients and reset the optimizer info.
+  void ApplyOptimizer(const std::shared_ptr<PServerKernel> &optimizer, const std::shared_ptr<OptimizerInfo> &optim_info,
+                      const InputsShapePtr &original_inputs_shape);
+  // Run the element-wise optimizer of a large dense weight in shards by multiple threads.
+  void ExecuteOptimizer(const std::shared_ptr<PServerKernel> &optimizer,
+                        const std::shared_ptr<OptimizerInfo> &optim_info) const;
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res);
-  void UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals);
+  // The first key of the arrays is the key of the embedding table and the others are the lookup ids.
+  void UpdateEmbeddings(const KVMessageArrays &arrays);
   inline bool ReadyForUpdateWeights() const;
   inline bool ReadyForPush(const Key &key);
   inline bool ReadyForPull(const Key &key);
   inline void ResetGradAccumCount();
+
+  // Whether the server is in the bounded staleness (SSP) mode, in which the workers can run at most a number of steps
+  // ahead of the slowest one and the pushed gradients are applied asynchronously.
+  bool EnableStaleness() const { return async_updater_ != nullptr; }
+  void InitAsyncUpdater();
+  // Put the pushed gradients into the update queue of the key in the SSP mode, which is the only place the arrays of
+  // the received message are copied since the queue outlives the message.
+  void AsyncAccumGrad(uint32_t worker_rank, const KVMessageArrays &arrays);
+  // Apply a batch of the gradients of the key popped from the update queue in the SSP mode.
+  void ApplyUpdates(const Key &key, const std::vector<GradUpdatePtr> &updates);
+  bool ReadyForPush(const Key &key, uint32_t worker_rank);
+  bool ReadyForPull(const Key &key, uint32_t worker_rank);
+  // Lock the weight of the key against the asynchronous updates in the SSP mode, and the lock owns nothing otherwise.
+  std::unique_lock<std::mutex> LockWeight(const Key &key);
   const CNodePtr GetCNode(const std::string &name) const;
   inline std::mutex &mutex();
   void GetEmbeddingTableParamPtr();
@@ -193,7 +227,7 @@ class BACKEND_EXPORT ParameterServer {
   void RecoverParameters(const std::vector<Key> &keys);
 
   // Update the indices of modified part of the persistent parameter.
-  void UpdateDirtyInfo(const Key &key, const LookupIds &lookup_ids, int64_t offset);
+  void UpdateDirtyInfo(const Key &key, const Key *lookup_ids, size_t ids_num, int64_t offset);
 
   // Ser current persistent state to server node.
   void set_persistent_state(core::PersistentState persistent_state) const;
@@ -236,6 +270,8 @@ class BACKEND_EXPORT ParameterServer {
   std::unique_ptr<std::thread> persist_thread_;
   std::shared_ptr<core::PSServerNode> server_node_;
   std::map<Key, ParameterPtr> embedding_tables_;
+  // The updater of the SSP mode, which is destroyed first to stop the update threads using the members above.
+  std::unique_ptr<AsyncUpdater> async_updater_{nullptr};
 
   friend class ServerHandler;
 };
@@ -559,6 +559,16 @@ std::string PSContext::http_url_prefix() const { return http_url_prefix_; }
 
 void PSContext::set_http_url_prefix(const std::string &http_url_prefix) { http_url_prefix_ = http_url_prefix; }
 
+void PSContext::set_rpc_event_loop_num(size_t rpc_event_loop_num) {
+  if (rpc_event_loop_num == 0) {
+    MS_LOG(EXCEPTION) << "rpc_event_loop_num must be greater than 0.";
+    return;
+  }
+  rpc_event_loop_num_ = rpc_event_loop_num;
+}
+
+size_t PSContext::rpc_event_loop_num() const { return rpc_event_loop_num_; }
+
 void PSContext::set_global_iteration_time_window(const uint64_t &global_iteration_time_window) {
   global_iteration_time_window_ = global_iteration_time_window;
 }
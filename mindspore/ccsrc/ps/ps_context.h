@@ -230,6 +230,9 @@ class BACKEND_EXPORT PSContext {
   std::string http_url_prefix() const;
   void set_http_url_prefix(const std::string &http_url_prefix);
 
+  void set_rpc_event_loop_num(size_t rpc_event_loop_num);
+  size_t rpc_event_loop_num() const;
+
   void set_global_iteration_time_window(const uint64_t &global_iteration_time_window);
   uint64_t global_iteration_time_window() const;
 
@@ -309,6 +312,7 @@ class BACKEND_EXPORT PSContext {
         client_password_(""),
         server_password_(""),
         http_url_prefix_(""),
+        rpc_event_loop_num_(1),
         global_iteration_time_window_(3600000),
         upload_compress_type_(kNoCompressType),
         upload_sparse_rate_(0.4f),
@@ -446,6 +450,8 @@ class BACKEND_EXPORT PSContext {
   std::string server_password_;
   // http url prefix for http communication
   std::string http_url_prefix_;
+  // The number of event loop threads of the rpc servers, among which the connections are sharded.
+  size_t rpc_event_loop_num_;
 
   // The time window of startFLJob round in millisecond.
   uint64_t global_iteration_time_window_;
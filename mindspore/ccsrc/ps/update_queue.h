@@ -0,0 +1,85 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_UPDATE_QUEUE_H_
+#define MINDSPORE_CCSRC_PS_UPDATE_QUEUE_H_
+
+#include <atomic>
+#include <utility>
+
+namespace mindspore {
+namespace ps {
+// UpdateQueue is a lock-free unbounded queue with multiple producers and a single consumer. The request handling
+// threads of the server push the gradient updates without blocking each other, and the only consumer is the update
+// thread which owns the key.
+template <typename T>
+class UpdateQueue {
+ public:
+  UpdateQueue() : head_(new Node()), tail_(head_.load()) {}
+  ~UpdateQueue() {
+    T item;
+    while (Pop(&item)) {
+    }
+    delete tail_;
+  }
+  UpdateQueue(const UpdateQueue &) = delete;
+  UpdateQueue &operator=(const UpdateQueue &) = delete;
+
+  // Thread safe for any number of producers.
+  void Push(T item) {
+    Node *node = new Node(std::move(item));
+    (void)size_.fetch_add(1);
+    // Publish the node by swinging the head, then link it behind the previous one. The consumer does not see the node
+    // until the link is done.
+    Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Must only be called by the single consumer. Return false if the queue is empty or the item being pushed is not
+  // linked yet.
+  bool Pop(T *item) {
+    Node *next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+    *item = std::move(next->item);
+    delete tail_;
+    tail_ = next;
+    (void)size_.fetch_sub(1);
+    return true;
+  }
+
+  // The number of the items pushed but not popped yet.
+  size_t size() const { return size_.load(); }
+  bool empty() const { return size() == 0; }
+
+ private:
+  struct Node {
+    Node() = default;
+    explicit Node(T &&value) : item(std::move(value)) {}
+    T item{};
+    std::atomic<Node *> next{nullptr};
+  };
+
+  // The most recently pushed node, which is shared by the producers.
+  std::atomic<Node *> head_;
+  // The dummy node before the oldest item, which is only accessed by the consumer.
+  Node *tail_;
+  std::atomic<size_t> size_{0};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_UPDATE_QUEUE_H_
@@ -319,16 +319,11 @@ bool Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_
   std::shared_ptr<std::vector<float>> values = std::make_shared<std::vector<float>>();
   std::shared_ptr<std::vector<Key>> keys = std::make_shared<std::vector<Key>>();
   int64_t value_offset = 0;
+  KVMessageView message;
   for (size_t i = 0; i < resp.size(); ++i) {
-    KVMessage message;
-    CHECK_RETURN_TYPE(message.ParseFromArray(resp.at(i)->data(), resp.at(i)->size()));
-    for (auto j = 0; j < message.values_size(); j++) {
-      values->push_back(message.values(j));
-    }
-    for (auto k = 0; k < message.keys_size(); k++) {
-      const Key &message_key = message.keys(k);
-      keys->push_back(message_key);
-    }
+    CHECK_RETURN_TYPE(message.Parse(resp.at(i)->data(), resp.at(i)->size()));
+    (void)values->insert(values->end(), message.values_data(), message.values_data() + message.values_size());
+    (void)keys->insert(keys->end(), message.keys_data(), message.keys_data() + message.keys_size());
   }
 
   for (size_t i = 0; i < keys->size(); i++) {
@@ -371,18 +366,16 @@ bool Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_
 
 bool Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
                                   const std::vector<float> &vals) {
-  KVMessage kvs;
-  *kvs.mutable_keys() = {keys.begin(), keys.end()};
-  *kvs.mutable_len() = {lookup_ids.begin(), lookup_ids.end()};
-  *kvs.mutable_values() = {vals.begin(), vals.end()};
+  // The lookup ids are sent as the lengths, which are the only array converted.
+  std::vector<uint64_t> ids = {lookup_ids.begin(), lookup_ids.end()};
   PartitionKVMessages messages;
-  update_embedding_partitioner_(kvs, &messages, {});
+  update_embedding_partitioner_(KVMessageArrays(keys, vals, ids), &messages, {});
   std::vector<uint32_t> rank_ids;
   std::vector<std::string> data_strs;
   for (size_t i = 0; i < messages.size(); i++) {
     if (messages.at(i).first) {
       rank_ids.push_back(i);
-      data_strs.emplace_back(messages.at(i).second.SerializeAsString());
+      data_strs.emplace_back(SerializeKVMessage(KVMessageArrays(messages.at(i).second)));
     }
   }
   while (!worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, LongToInt(kUpdateEmbeddingsCmd))) {
@@ -628,16 +621,14 @@ void Worker::BuildSparseValue(const std::vector<int> &lengths, const size_t grad
 
 void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                       int cmd, int64_t) {
-  KVMessage kvs;
-  *kvs.mutable_keys() = {keys.begin(), keys.end()};
-  *kvs.mutable_values() = {vals.begin(), vals.end()};
-  *kvs.mutable_len() = {lens.begin(), lens.end()};
+  std::vector<uint64_t> send_lens = {lens.begin(), lens.end()};
+  KVMessageArrays kvs(keys, vals, send_lens);
   MS_LOG(INFO) << "the result is:" << embedding_table_ranges_.count(keys[0]);
   if (embedding_table_ranges_.count(keys[0])) {
     if (cmd == kInitWeightsCmd) {
       SendForPush(cmd, kvs, worker_init_embedding_partitioner_, {});
     } else {
-      const std::string &kv_data = kvs.SerializeAsString();
+      const std::string &kv_data = SerializeKVMessage(kvs);
       worker_node_.Broadcast(core::NodeRole::SERVER, kv_data, cmd);
     }
   } else {
@@ -647,10 +638,8 @@ void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &va
 
 void Worker::PushSparseData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                             size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size) {
-  KVMessage kvs;
-  *kvs.mutable_keys() = {keys.begin(), keys.end()};
-  *kvs.mutable_values() = {vals.begin(), vals.end()};
-  *kvs.mutable_len() = {lens.begin(), lens.end()};
+  std::vector<uint64_t> send_lens = {lens.begin(), lens.end()};
+  KVMessageArrays kvs(keys, vals, send_lens);
   if (embedding_table_ranges_.count(keys[0])) {
     std::map<int64_t, int64_t> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
     SendForPush(kPushCmd, kvs, sparse_partitioner_, attrs);
@@ -662,8 +651,9 @@ void Worker::PushSparseData(const std::vector<Key> &keys, const std::vector<floa
 void Worker::PullData(const std::vector<Key> &keys, std::vector<float> *const vals, std::vector<int> *lens, int cmd,
                       int64_t priority) {
   MS_EXCEPTION_IF_NULL(vals);
-  KVMessage kvs;
-  *kvs.mutable_keys() = {keys.begin(), keys.end()};
+  KVMessageArrays kvs;
+  kvs.keys = keys.data();
+  kvs.keys_num = keys.size();
   if (embedding_table_ranges_.count(keys[0])) {
     SendForPull(cmd, kvs, broadcast_partitioner_, {}, vals, lens);
   } else {
@@ -708,11 +698,11 @@ void Worker::LookupIdPartitioner(const EmbeddingTableLookup &send, PartitionEmbe
   }
 }
 
-void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *partition,
+void Worker::SparsePartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                                const std::map<int64_t, int64_t> &attrs) {
   MS_EXCEPTION_IF_NULL(partition);
   // Init variables
-  float *data = const_cast<float *>(send.values().data());
+  float *data = const_cast<float *>(send.values);
 
   if (attrs.count(kGradIndex) == 0 || attrs.count(kIndiceIndex) == 0 || attrs.count(kFirstDimSize) == 0 ||
       attrs.count(kOutDimSize) == 0) {
@@ -727,17 +717,21 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
   iter = attrs.find(kOutDimSize);
   size_t outer_dim_size = static_cast<size_t>(iter->second);
 
-  size_t grad_size = send.len()[SizeToInt(grad_index)];
-  size_t indice_size = send.len()[SizeToInt(indice_index)];
+  if (grad_index >= send.lens_num || indice_index >= send.lens_num) {
+    MS_LOG(EXCEPTION) << "The grad index " << grad_index << " or indice index " << indice_index
+                      << " is out of the lens num " << send.lens_num;
+  }
+  size_t grad_size = send.lens[grad_index];
+  size_t indice_size = send.lens[indice_index];
   size_t segment_size = grad_size / indice_size;
 
   size_t grad_offset = 0;
   size_t indice_offset = 0;
   for (size_t i = 0; i < grad_index; i++) {
-    grad_offset += send.len()[i];
+    grad_offset += send.lens[i];
   }
   for (size_t j = 0; j < indice_index; j++) {
-    indice_offset += send.len()[j];
+    indice_offset += send.lens[j];
   }
 
   float *grad_data = data + grad_offset;
@@ -752,7 +746,7 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
     indice_to_grads.push_back(std::make_pair(indice, grad));
   }
 
-  const Key &key = send.keys()[0];
+  const Key &key = send.keys[0];
   const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[key]);
   partition->resize(ranges.size());
 
@@ -762,8 +756,8 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
     const auto &begin = range.begin();
     const auto &end = range.end();
     auto &kvs = partition->at(i).second;
-    *kvs.mutable_keys() = {send.keys().begin(), send.keys().end()};
-    *kvs.mutable_len() = {send.len().begin(), send.len().end()};
+    kvs.keys.assign(send.keys, send.keys + send.keys_num);
+    kvs.lens.assign(send.lens, send.lens + send.lens_num);
 
     // Prepare the sparse gradient and indice
     std::vector<int> indice_ids;
@@ -791,7 +785,7 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
                                  first_dim_size, outer_dim_size, &unique_sparse_grad);
 
       // Update the length of reduce sparse gradient and indice
-      std::vector<int> reduced_lens = {kvs.len().begin(), kvs.len().end()};
+      std::vector<int> reduced_lens = {kvs.lens.begin(), kvs.lens.end()};
       reduced_lens[grad_index] = unique_sparse_grad.indices_size_ * segment_size;
       reduced_lens[indice_index] = unique_sparse_grad.indices_size_;
 
@@ -801,93 +795,83 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
       BuildSparseValue(reduced_lens, grad_index, indice_index, data, unique_sparse_grad.value_,
                        unique_sparse_grad.indices_, &reduced_data);
 
-      *kvs.mutable_len() = {reduced_lens.begin(), reduced_lens.end()};
-      *kvs.mutable_values() = {reduced_data.begin(), reduced_data.end()};
+      kvs.lens.assign(reduced_lens.begin(), reduced_lens.end());
+      kvs.values = std::move(reduced_data);
     }
 
     if (indices_size == 0) {
-      std::vector<float> no_keys;
-      std::vector<float> no_vals;
-      std::vector<float> no_lens;
-      no_keys.push_back(key);
-      no_vals.push_back(kGradValue);
-      *kvs.mutable_values() = {no_vals.begin(), no_vals.end()};
-      *kvs.mutable_len() = {no_lens.begin(), no_lens.end()};
+      kvs.values = {kGradValue};
+      kvs.lens.clear();
     }
     partition->at(i).first = true;
   }
 }
 
-void Worker::RoundRobinPartitioner(const KVMessage &send, PartitionKVMessages *partition,
+void Worker::RoundRobinPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                                    const std::map<int64_t, int64_t> &) {
   MS_EXCEPTION_IF_NULL(partition);
   partition->resize(LongToSize(server_num_));
-  auto keys = send.keys();
-  auto values = send.values();
-  auto lens = send.len();
-  MS_LOG(INFO) << "the key size is:" << send.keys_size() << " the values size is:" << send.values_size()
-               << " the lens:" << send.len_size();
+  MS_LOG(INFO) << "the key size is:" << send.keys_num << " the values size is:" << send.values_num
+               << " the lens:" << send.lens_num;
+  if (send.values_num > 0 && send.lens_num < send.keys_num) {
+    MS_LOG(EXCEPTION) << "The lens num " << send.lens_num << " is less than the keys num " << send.keys_num;
+  }
 
-  size_t len;
+  size_t offset = 0;
   Key param_key;
-  for (int i = 0; i < send.keys_size(); i++) {
-    param_key = keys[i];
+  for (size_t i = 0; i < send.keys_num; i++) {
+    param_key = send.keys[i];
     int64_t server_id = key_to_server_id_[param_key];
     if (!partition->at(LongToUlong(server_id)).first) {
       partition->at(LongToUlong(server_id)).first = true;
     }
 
-    KVMessage &server_kv_pairs = partition->at(LongToUlong(server_id)).second;
-    server_kv_pairs.add_keys(param_key);
-    if (values.empty()) {
+    KVMessageSlice &server_kv_pairs = partition->at(LongToUlong(server_id)).second;
+    server_kv_pairs.keys.push_back(param_key);
+    if (send.values_num == 0) {
       continue;
     }
-    len = lens[i];
-    int64_t offset = std::accumulate(lens.begin(), lens.begin() + i, 0);
-    auto val_begin = values.begin() + offset;
-    auto val_end = val_begin + len;
-    for (auto it = val_begin; it != val_end; ++it) {
-      server_kv_pairs.add_values(*it);
-    }
-    server_kv_pairs.add_len(len);
+    size_t len = send.lens[i];
+    (void)server_kv_pairs.values.insert(server_kv_pairs.values.end(), send.values + offset, send.values + offset + len);
+    server_kv_pairs.lens.push_back(len);
+    offset += len;
   }
 }
 
-void Worker::WorkerInitEmbeddingPartitioner(const KVMessage &send, std::vector<std::pair<bool, KVMessage>> *partition,
+void Worker::WorkerInitEmbeddingPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                                             const std::map<int64_t, int64_t> &) {
   MS_EXCEPTION_IF_NULL(partition);
   partition->resize(LongToSize(server_num_));
-  auto keys = send.keys();
-  auto values = send.values();
-  auto lens = send.len();
+  if (send.keys_num == 0 || send.lens_num == 0) {
+    MS_LOG(EXCEPTION) << "The keys or lens of the embedding table to init are empty.";
+  }
 
-  int32_t col_cnt = lens[0] / embedding_row_cnt_[keys[0]];
-  const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[keys[0]]);
+  int32_t col_cnt = send.lens[0] / embedding_row_cnt_[send.keys[0]];
+  const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[send.keys[0]]);
   for (size_t i = 0; i < ranges.size(); i++) {
     size_t offset_begin = ranges[i].begin() * col_cnt;
     size_t offset_end = (ranges[i].end() + 1) * col_cnt;
-    KVMessage kvs;
-    *kvs.mutable_keys() = keys;
-    *kvs.mutable_values() = {values.begin() + offset_begin, values.begin() + offset_end};
-    kvs.add_len(offset_end - offset_begin);
+    KVMessageSlice &kvs = partition->at(i).second;
+    kvs.keys.assign(send.keys, send.keys + send.keys_num);
+    kvs.values.assign(send.values + offset_begin, send.values + offset_end);
+    kvs.lens = {offset_end - offset_begin};
     partition->at(i).first = true;
-    partition->at(i).second = kvs;
   }
 }
-void Worker::UpdateEmbeddingPartitioner(const KVMessage &send, PartitionKVMessages *partition,
+void Worker::UpdateEmbeddingPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                                         const std::map<int64_t, int64_t> &) {
   MS_EXCEPTION_IF_NULL(partition);
-  const float *embedding_vals = send.values().data();
-  const uint64_t *lookup_ids = send.len().data();
-  size_t val_size = IntToSize(send.values_size());
-  size_t id_size = IntToSize(send.len_size());
+  const float *embedding_vals = send.values;
+  const uint64_t *lookup_ids = send.lens;
+  size_t val_size = send.values_num;
+  size_t id_size = send.lens_num;
   if (id_size == 0) {
     MS_LOG(EXCEPTION) << "The id size is 0.";
     return;
   }
   size_t embedding_dim = val_size / id_size;
 
-  const Key &key = send.keys()[0];
+  const Key &key = send.keys[0];
   const std::vector<EmbeddingTableShardMetadata> &ranges = *(embedding_table_ranges_[key]);
   partition->resize(ranges.size());
 
@@ -896,18 +880,17 @@ void Worker::UpdateEmbeddingPartitioner(const KVMessage &send, PartitionKVMessag
     const auto &begin = range.begin();
     const auto &end = range.end();
     auto &kvs = partition->at(i).second;
-    kvs.add_keys(key);
+    kvs.keys.push_back(key);
     for (size_t j = 0; j < id_size; j++) {
       auto lookup_id = lookup_ids[j];
       if (lookup_id >= begin && lookup_id <= end) {
-        kvs.add_keys(lookup_id);
-        for (size_t k = 0; k < embedding_dim; k++) {
-          kvs.add_values(embedding_vals[j * embedding_dim + k]);
-        }
+        kvs.keys.push_back(lookup_id);
+        const float *embedding = embedding_vals + j * embedding_dim;
+        (void)kvs.values.insert(kvs.values.end(), embedding, embedding + embedding_dim);
       }
     }
 
-    if (kvs.keys_size() <= 1) {
+    if (kvs.keys.size() <= 1) {
       partition->at(i).first = false;
     } else {
       partition->at(i).first = true;
@@ -915,17 +898,20 @@ void Worker::UpdateEmbeddingPartitioner(const KVMessage &send, PartitionKVMessag
   }
 }
 
-void Worker::BroadcastPartitioner(const KVMessage &send, PartitionKVMessages *partition,
+void Worker::BroadcastPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                                   const std::map<int64_t, int64_t> &) {
   MS_EXCEPTION_IF_NULL(partition);
   partition->resize(LongToSize(server_num_));
   for (size_t i = 0; i < LongToSize(server_num_); i++) {
     partition->at(i).first = true;
-    partition->at(i).second = send;
+    KVMessageSlice &kvs = partition->at(i).second;
+    kvs.keys.assign(send.keys, send.keys + send.keys_num);
+    kvs.values.assign(send.values, send.values + send.values_num);
+    kvs.lens.assign(send.lens, send.lens + send.lens_num);
   }
 }
 
-void Worker::SendForPush(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
+void Worker::SendForPush(int cmd, const KVMessageArrays &send, const KVPartitioner &partitioner,
                          const std::map<int64_t, int64_t> &attrs) {
   PartitionKVMessages messages;
   partitioner(send, &messages, attrs);
@@ -934,13 +920,13 @@ void Worker::SendForPush(int cmd, const KVMessage &send, const KVPartitioner &pa
   for (size_t i = 0; i < messages.size(); i++) {
     if (messages.at(i).first) {
       rank_ids.push_back(i);
-      data_strs.emplace_back(messages.at(i).second.SerializeAsString());
+      data_strs.emplace_back(SerializeKVMessage(KVMessageArrays(messages.at(i).second)));
     }
   }
   worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, cmd);
 }
 
-void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
+void Worker::SendForPull(int cmd, const KVMessageArrays &send, const KVPartitioner &partitioner,
                          const std::map<int64_t, int64_t> &, std::vector<float> *vals, std::vector<int> *lens) {
   MS_EXCEPTION_IF_NULL(vals);
   PartitionKVMessages messages;
@@ -950,22 +936,28 @@ void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &pa
   for (size_t i = 0; i < messages.size(); i++) {
     if (messages.at(i).first) {
       rank_ids.push_back(i);
-      data_strs.emplace_back(messages.at(i).second.SerializeAsString());
+      data_strs.emplace_back(SerializeKVMessage(KVMessageArrays(messages.at(i).second)));
     }
   }
   std::vector<VectorPtr> resp;
   worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, cmd, &resp);
   vals->clear();
+  KVMessageView message;
   for (size_t i = 0; i < resp.size(); ++i) {
-    KVMessage message;
-    CHECK_RETURN_TYPE(message.ParseFromArray(resp.at(i)->data(), SizeToInt(resp.at(i)->size())));
-    std::copy(message.values().begin(), message.values().end(), std::back_inserter(*vals));
+    CHECK_RETURN_TYPE(message.Parse(resp.at(i)->data(), resp.at(i)->size()));
+    (void)vals->insert(vals->end(), message.values_data(), message.values_data() + message.values_size());
 
     if (lens) {
       lens->clear();
-      std::copy(message.len().begin(), message.len().end(), std::back_inserter(*lens));
+      std::copy(message.len_data(), message.len_data() + message.len_size(), std::back_inserter(*lens));
     }
   }
 }
+
+std::string Worker::SerializeKVMessage(const KVMessageArrays &arrays) const {
+  std::string data;
+  EncodeKVMessage(arrays, worker_node_.wire_format_version(), &data);
+  return data;
+}
 }  // namespace ps
 }  // namespace mindspore
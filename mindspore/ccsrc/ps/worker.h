@@ -37,6 +37,7 @@
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/core/ps_worker_node.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/kv_message_codec.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/ps_context.h"
@@ -49,12 +50,12 @@ class BACKEND_EXPORT Worker {
   static Worker &GetInstance();
   using Callback = std::function<void()>;
   using PartitionEmbeddingMessages = std::vector<std::pair<bool, EmbeddingTableLookup>>;
-  using PartitionKVMessages = std::vector<std::pair<bool, KVMessage>>;
+  using PartitionKVMessages = std::vector<std::pair<bool, KVMessageSlice>>;
 
   using EmbeddingPartitioner = std::function<void(
     const EmbeddingTableLookup &send, PartitionEmbeddingMessages *partition, const std::map<int64_t, int64_t> &attrs)>;
-  using KVPartitioner =
-    std::function<void(const KVMessage &send, PartitionKVMessages *partition, const std::map<int64_t, int64_t> &attrs)>;
+  using KVPartitioner = std::function<void(const KVMessageArrays &send, PartitionKVMessages *partition,
+                                           const std::map<int64_t, int64_t> &attrs)>;
 
   void Run();
   void Push(const std::vector<size_t> &keys, std::vector<uintptr_t> addrs, const ShapeVector &sizes);
@@ -109,20 +110,23 @@ class BACKEND_EXPORT Worker {
   void LookupIdPartitioner(const EmbeddingTableLookup &send, PartitionEmbeddingMessages *partition,
                            const std::map<int64_t, int64_t> &attrs);
 
-  void SparsePartitioner(const KVMessage &send, PartitionKVMessages *partition,
+  // The partitioners read the arrays to send in place and fill the slice of each server, which is encoded directly.
+  void SparsePartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                          const std::map<int64_t, int64_t> &attrs);
-  void RoundRobinPartitioner(const KVMessage &send, PartitionKVMessages *partition,
+  void RoundRobinPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                              const std::map<int64_t, int64_t> &attrs);
-  void WorkerInitEmbeddingPartitioner(const KVMessage &send, std::vector<std::pair<bool, KVMessage>> *partition,
+  void WorkerInitEmbeddingPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                                       const std::map<int64_t, int64_t> &attrs);
-  void UpdateEmbeddingPartitioner(const KVMessage &send, PartitionKVMessages *partition,
+  void UpdateEmbeddingPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                                   const std::map<int64_t, int64_t> &attrs);
-  void BroadcastPartitioner(const KVMessage &send, PartitionKVMessages *partition,
+  void BroadcastPartitioner(const KVMessageArrays &send, PartitionKVMessages *partition,
                             const std::map<int64_t, int64_t> &attrs);
-  void SendForPush(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
+  void SendForPush(int cmd, const KVMessageArrays &send, const KVPartitioner &partitioner,
                    const std::map<int64_t, int64_t> &attrs);
-  void SendForPull(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
+  void SendForPull(int cmd, const KVMessageArrays &send, const KVPartitioner &partitioner,
                    const std::map<int64_t, int64_t> &attrs, std::vector<float> *vals, std::vector<int> *lens);
+  // Serialize the KVMessage arrays in the wire format negotiated with the servers.
+  std::string SerializeKVMessage(const KVMessageArrays &arrays) const;
 
   int64_t server_num_;
   bool running_;
@@ -16,11 +16,16 @@
 
 #include "runtime/graph_scheduler/actor/embedding_cache/embedding_cache_prefetch_actor.h"
 #include <limits>
+#include <algorithm>
+#include <cstring>
+#include <future>
 #include "backend/common/optimizer/dynamic_shape/dynamic_shape_helper.h"
 #include "kernel/common_utils.h"
 #include "runtime/graph_scheduler/actor/rpc/rpc_actor.h"
 #include "proto/topology.pb.h"
 #include "distributed/constants.h"
+#include "utils/ms_utils.h"
+#include "distributed/rpc/tcp/gather_message.h"
 
 namespace mindspore {
 namespace runtime {
@@ -40,7 +45,34 @@ constexpr size_t kMaxThreadNum = 16;
 // Maximum number of feature ids processed per thread.
 constexpr size_t kMaxIdsPerThread = 10000;
 
+// The default max number of rpc tasks with remote in flight.
+constexpr size_t kDefaultRpcPipelineDepth = 8;
+constexpr char kEnvRpcPipelineDepth[] = "MS_EMBEDDING_CACHE_RPC_PIPELINE_DEPTH";
+
+// The max number of hot ids pinned in the local host cache, 0 means the hot ids are not tracked.
+constexpr char kEnvHotIdNum[] = "MS_EMBEDDING_CACHE_HOT_ID_NUM";
+// The number of batches between the reselections of the hot ids.
+constexpr size_t kDefaultHotIdRebalanceInterval = 100;
+constexpr char kEnvHotIdRebalanceInterval[] = "MS_EMBEDDING_CACHE_HOT_ID_REBALANCE_INTERVAL";
+
+// The data sent by rpc operators is referred by the message instead of being copied into it from this size.
+constexpr size_t kMinZeroCopySendSize = 64 << 10;
+// The maximum time(300 seconds) to wait for a message to be sent or received by rpc operators.
+constexpr int64_t kRpcTimeoutInSec = 300;
+
 namespace {
+// The message received by a Receiver, whose body goes into the buffer directly.
+class RecvBufferMessage : public MessageBase {
+ public:
+  explicit RecvBufferMessage(size_t body_size) : buffer_(std::make_unique<std::vector<char>>(body_size)) {
+    data = buffer_->data();
+    size = body_size;
+  }
+  ~RecvBufferMessage() override = default;
+
+  std::unique_ptr<std::vector<char>> buffer_;
+};
+
 ParameterPtr NewParameter(const KernelGraphPtr &graph, TypePtr type, const ShapeVector &shape) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(type);
@@ -258,9 +290,82 @@ void EmbeddingCachePrefetchActor::Initialize() {
   BuildRpcOperators();
   LinkRpcOperators();
 
+  rpc_pipeline_depth_ = kDefaultRpcPipelineDepth;
+  if (!common::GetEnv(kEnvRpcPipelineDepth).empty()) {
+    TRY_AND_CATCH_WITH_EXCEPTION((rpc_pipeline_depth_ = std::stoul(common::GetEnv(kEnvRpcPipelineDepth))),
+                                 "The environment variable MS_EMBEDDING_CACHE_RPC_PIPELINE_DEPTH is invalid.");
+  }
+  MS_LOG(INFO) << "The embedding cache rpc pipeline depth is " << rpc_pipeline_depth_;
+
+  InitHotIdTracker();
+
   initialized_ = true;
 }
 
+void EmbeddingCachePrefetchActor::InitHotIdTracker() {
+  size_t hot_id_num = 0;
+  if (!common::GetEnv(kEnvHotIdNum).empty()) {
+    TRY_AND_CATCH_WITH_EXCEPTION((hot_id_num = std::stoul(common::GetEnv(kEnvHotIdNum))),
+                                 "The environment variable MS_EMBEDDING_CACHE_HOT_ID_NUM is invalid.");
+  }
+  if (hot_id_num == 0) {
+    return;
+  }
+  size_t rebalance_interval = kDefaultHotIdRebalanceInterval;
+  if (!common::GetEnv(kEnvHotIdRebalanceInterval).empty()) {
+    TRY_AND_CATCH_WITH_EXCEPTION((rebalance_interval = std::stoul(common::GetEnv(kEnvHotIdRebalanceInterval))),
+                                 "The environment variable MS_EMBEDDING_CACHE_HOT_ID_REBALANCE_INTERVAL is invalid.");
+  }
+  // At most half of the local host cache can be pinned, the other half is left for the swaps of the cold ids.
+  if (hot_id_num > local_host_cache_size_ / 2) {
+    MS_LOG(WARNING) << "The hot id number " << hot_id_num << " exceeds half of the local host cache size "
+                    << local_host_cache_size_ << ", and is reduced to " << local_host_cache_size_ / 2;
+    hot_id_num = local_host_cache_size_ / 2;
+  }
+  if (hot_id_num == 0) {
+    return;
+  }
+  hot_id_tracker_ = std::make_unique<distributed::HotIdTracker>(hot_id_num, rebalance_interval);
+  MS_LOG(INFO) << "Track at most " << hot_id_num << " hot ids, which are reselected every " << rebalance_interval
+               << " batches.";
+}
+
+bool EmbeddingCachePrefetchActor::RecordHotIds(const int *batch_ids, size_t batch_ids_num) {
+  if (hot_id_tracker_ == nullptr) {
+    return true;
+  }
+  MS_ERROR_IF_NULL(batch_ids);
+  MS_ERROR_IF_NULL(embedding_host_cache_);
+  auto &host_hash_map = embedding_host_cache_->host_hash_map_;
+  MS_ERROR_IF_NULL(host_hash_map);
+
+  // Only the ids of the local embedding slice are cached in the local host cache.
+  std::vector<int> local_ids;
+  local_ids.reserve(batch_ids_num);
+  for (size_t i = 0; i < batch_ids_num; ++i) {
+    if (batch_ids[i] >= local_embedding_slice_bounds_.first && batch_ids[i] < local_embedding_slice_bounds_.second) {
+      local_ids.push_back(batch_ids[i]);
+    }
+  }
+  interval_server_to_host_size_ += statistics_info_.server_to_host_size_;
+  if (!hot_id_tracker_->Record(local_ids.data(), local_ids.size())) {
+    return true;
+  }
+
+  // The pinned elements are not swapped out, so the hot ids are not pulled from and pushed to the remote servers
+  // at every swap. They are written back at every reselection before the pinned set changes, when they are unpinned
+  // and swapped out, and when the embedding table is synchronized.
+  RETURN_IF_FALSE_WITH_LOG(PushPinnedCacheToRemote(), "Push the pinned embeddings to remote failed.");
+  host_hash_map->PinIds(hot_id_tracker_->hot_ids());
+  MS_LOG(INFO) << "Reselect " << hot_id_tracker_->hot_ids().size() << " hot ids, " << host_hash_map->pinned_count()
+               << " of them are pinned in the local host cache. The hot id access ratio is "
+               << hot_id_tracker_->hot_access_ratio() << ", the number of the tracked ids is "
+               << hot_id_tracker_->tracked_id_num() << ", and " << interval_server_to_host_size_
+               << " ids are pulled from the remote servers in the last interval.";
+  interval_server_to_host_size_ = 0;
+  return true;
+}
+
 void EmbeddingCachePrefetchActor::Finalize() {
   if (!initialized_ || finalized_) {
     return;
@@ -268,6 +373,7 @@ void EmbeddingCachePrefetchActor::Finalize() {
   SyncEmbeddingTable();
 
   running_ = false;
+  rpc_task_pipeline_.Stop();
   FinalizeRemote();
 
   PsDataPrefetch::GetInstance().NotifyFinalize();
@@ -484,6 +590,7 @@ void EmbeddingCachePrefetchActor::Run() {
   // Wait data channel ready.
   WaitDataChannelInit();
 
+  rpc_task_pipeline_.Start(rpc_pipeline_depth_);
   MS_LOG(INFO) << "Begin prefetching cache.";
   while (running_) {
     if (!PrefetchCache()) {
@@ -497,6 +604,8 @@ void EmbeddingCachePrefetchActor::Run() {
 }
 
 bool EmbeddingCachePrefetchActor::PrefetchCache() {
+  // The data channel hands over one batch at a time and waits for its hash indices before reading the next batch, so
+  // the ids are analysed batch by batch. Only the rpc with remote overlaps the following stages and batches.
   // 1. Acquire batch ids
   void *data = nullptr;
   RETURN_IF_FALSE_WITH_LOG(PsDataPrefetch::GetInstance().QueryData(channel_name_, &data), "Query input data failed.");
@@ -536,6 +645,9 @@ bool EmbeddingCachePrefetchActor::PrefetchCache() {
   // 3. If the device cache does not reach 100% hit rate, the cache needs to be updated.
   RETURN_IF_FALSE_WITH_LOG(UpdateCache(), "Update local cache failed.");
 
+  // Count the accesses of the ids before they are replaced, and pin the hot ids in the local host cache.
+  RETURN_IF_FALSE_WITH_LOG(RecordHotIds(batch_ids, batch_ids_num), "Record hot ids failed.");
+
   // 4. Replace the batch_ids by hash index for GetNext operator to get hash index as input.
   size_t dest_len = data_size;
   ret = memcpy_s(data, dest_len, hash_index.get(), data_size);
@@ -846,12 +958,31 @@ bool EmbeddingCachePrefetchActor::WaitGraphRun() {
 }
 
 bool EmbeddingCachePrefetchActor::UpdateCache() {
+  // 1. Hand the rpc with remote of all tables to the rpc thread first, the pushes to remote of this batch are not
+  // waited, the remote receives them before the pulls of later batches.
+  std::vector<size_t> pull_task_ids;
+  std::vector<std::shared_ptr<std::vector<float>>> lookup_results;
   for (const auto &item : hash_tables_) {
-    auto hash_info = item.second;
+    const auto &hash_info = item.second;
     RETURN_IF_FALSE_WITH_LOG(PushCacheFromLocalHostToRemote(hash_info), "Push cache from local host to remote failed.");
+    size_t task_id = 0;
+    std::shared_ptr<std::vector<float>> lookup_result;
+    RETURN_IF_FALSE_WITH_LOG(PullCacheFromRemoteToLocalHost(hash_info, &task_id, &lookup_result),
+                             "Pull cache from remote to local host failed.");
+    pull_task_ids.push_back(task_id);
+    lookup_results.push_back(lookup_result);
+  }
+
+  // 2. Swap between device and local host cache table by table, while the pulls of the tables behind are in flight.
+  size_t table_index = 0;
+  for (const auto &item : hash_tables_) {
+    const auto &hash_info = item.second;
     RETURN_IF_FALSE_WITH_LOG(PushCacheFromDeviceToLocalHost(hash_info), "Push cache from device to local host failed.");
-    RETURN_IF_FALSE_WITH_LOG(PullCacheFromRemoteToLocalHost(hash_info), "Pull cache from remote to local host failed.");
+    RETURN_IF_FALSE_WITH_LOG(
+      InsertCacheFromRemoteToLocalHost(hash_info, pull_task_ids[table_index], lookup_results[table_index]),
+      "Insert cache from remote to local host failed.");
     RETURN_IF_FALSE_WITH_LOG(PullCacheFromLocalHostToDevice(hash_info), "Pull cache from local host to device failed.");
+    ++table_index;
   }
   return true;
 }
@@ -868,20 +999,65 @@ bool EmbeddingCachePrefetchActor::PushCacheFromLocalHostToRemote(const HashTable
   auto host_to_server_index = embedding_host_cache_->host_to_server_index.get();
   MS_ERROR_IF_NULL(host_to_server_index);
 
-  std::vector<float> swap_out_data;
+  // The evicted rows are copied out before the swaps of this batch overwrite them, the push itself runs on the rpc
+  // thread.
   auto embedding_size = hash_info.embedding_size;
-  swap_out_data.resize(swap_indices_size * embedding_size);
+  auto swap_out_data = std::make_shared<std::vector<float>>(swap_indices_size * embedding_size);
   auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
 
   RETURN_IF_FALSE_WITH_LOG(LookupLocalHostCache(embedding_size, swap_indices_size, host_hash_table_addr,
-                                                host_to_server_index, swap_out_data.data()),
+                                                host_to_server_index, swap_out_data->data()),
                            "Lookup local host cache failed.");
-  RETURN_IF_FALSE_WITH_LOG(PushEmbeddingsToRemote(hash_info.param_key_, host_to_server_ids, swap_indices_size,
-                                                  swap_out_data.data(), swap_out_data.size() * sizeof(float)),
+  auto swap_out_ids = std::make_shared<std::vector<int>>(host_to_server_ids, host_to_server_ids + swap_indices_size);
+  int32_t param_key = hash_info.param_key_;
+  RETURN_IF_FALSE_WITH_LOG(rpc_task_pipeline_.SubmitTask([this, param_key, swap_out_ids, swap_out_data]() {
+                             return PushEmbeddingsToRemote(param_key, swap_out_ids->data(), swap_out_ids->size(),
+                                                           swap_out_data->data(),
+                                                           swap_out_data->size() * sizeof(float));
+                           }),
                            "Push embeddings to remote failed.");
   return true;
 }
 
+bool EmbeddingCachePrefetchActor::PushPinnedCacheToRemote() {
+  MS_ERROR_IF_NULL(embedding_host_cache_);
+  auto &host_hash_map = embedding_host_cache_->host_hash_map_;
+  MS_ERROR_IF_NULL(host_hash_map);
+  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
+  auto pinned_ids = std::make_shared<std::vector<int>>();
+  std::vector<int> pinned_indices;
+  for (const auto &id : host_hash_map->pinned_ids()) {
+    auto iter = hash_id_to_index.find(id);
+    if (iter != hash_id_to_index.end()) {
+      pinned_ids->push_back(id);
+      pinned_indices.push_back(iter->second);
+    }
+  }
+  if (pinned_ids->empty()) {
+    return true;
+  }
+
+  // The pinned rows are copied out in the prefetch thread, the push itself runs on the rpc thread after the pushes of
+  // the previous batches.
+  for (const auto &item : hash_tables_) {
+    const auto &hash_info = item.second;
+    auto embedding_size = hash_info.embedding_size;
+    auto pinned_data = std::make_shared<std::vector<float>>(pinned_ids->size() * embedding_size);
+    auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
+    RETURN_IF_FALSE_WITH_LOG(LookupLocalHostCache(embedding_size, pinned_indices.size(), host_hash_table_addr,
+                                                  pinned_indices.data(), pinned_data->data()),
+                             "Lookup local host cache failed.");
+    int32_t param_key = hash_info.param_key_;
+    RETURN_IF_FALSE_WITH_LOG(rpc_task_pipeline_.SubmitTask([this, param_key, pinned_ids, pinned_data]() {
+                               return PushEmbeddingsToRemote(param_key, pinned_ids->data(), pinned_ids->size(),
+                                                             pinned_data->data(),
+                                                             pinned_data->size() * sizeof(float));
+                             }),
+                             "Push embeddings to remote failed.");
+  }
+  return true;
+}
+
 bool EmbeddingCachePrefetchActor::PushCacheFromDeviceToLocalHost(const HashTableInfo &hash_info) {
   auto swap_indices_size = statistics_info_.device_to_host_size_;
   if (swap_indices_size == 0) {
@@ -926,7 +1102,10 @@ bool EmbeddingCachePrefetchActor::PushCacheFromDeviceToLocalHost(const HashTable
   return true;
 }
 
-bool EmbeddingCachePrefetchActor::PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info) {
+bool EmbeddingCachePrefetchActor::PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info, size_t *task_id,
+                                                                 std::shared_ptr<std::vector<float>> *lookup_result) {
+  MS_ERROR_IF_NULL(task_id);
+  MS_ERROR_IF_NULL(lookup_result);
   auto swap_indices_size = statistics_info_.server_to_host_size_;
   if (swap_indices_size == 0) {
     return true;
@@ -935,19 +1114,39 @@ bool EmbeddingCachePrefetchActor::PullCacheFromRemoteToLocalHost(const HashTable
   MS_ERROR_IF_NULL(embedding_host_cache_);
   auto server_to_host_ids = embedding_host_cache_->server_to_host_ids.get();
   MS_ERROR_IF_NULL(server_to_host_ids);
+
+  auto embedding_size = hash_info.embedding_size;
+  auto pull_ids = std::make_shared<std::vector<int>>(server_to_host_ids, server_to_host_ids + swap_indices_size);
+  auto pull_result = std::make_shared<std::vector<float>>(swap_indices_size * embedding_size, 0);
+  int32_t param_key = hash_info.param_key_;
+  RETURN_IF_FALSE_WITH_LOG(rpc_task_pipeline_.SubmitTask(
+                             [this, param_key, pull_ids, pull_result]() {
+                               return PullEembeddingsFromRemote(param_key, pull_ids->data(), pull_ids->size(),
+                                                                pull_result.get());
+                             },
+                             task_id),
+                           "Pull embedding from remote failed.");
+  *lookup_result = pull_result;
+  return true;
+}
+
+bool EmbeddingCachePrefetchActor::InsertCacheFromRemoteToLocalHost(
+  const HashTableInfo &hash_info, size_t task_id, const std::shared_ptr<std::vector<float>> &lookup_result) {
+  auto swap_indices_size = statistics_info_.server_to_host_size_;
+  if (swap_indices_size == 0) {
+    return true;
+  }
+
+  MS_ERROR_IF_NULL(lookup_result);
+  MS_ERROR_IF_NULL(embedding_host_cache_);
   auto server_to_host_index = embedding_host_cache_->server_to_host_index.get();
   MS_ERROR_IF_NULL(server_to_host_index);
-
   auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
   MS_ERROR_IF_NULL(host_hash_table_addr);
-  auto embedding_size = hash_info.embedding_size;
-  std::vector<float> lookup_result(swap_indices_size * embedding_size, 0);
 
-  RETURN_IF_FALSE_WITH_LOG(
-    PullEembeddingsFromRemote(hash_info.param_key_, server_to_host_ids, swap_indices_size, &lookup_result),
-    "Pull embedding from remote failed.");
-  RETURN_IF_FALSE_WITH_LOG(InsertLocalHostCache(embedding_size, IntToSize(swap_indices_size), server_to_host_index,
-                                                lookup_result.data(), host_hash_table_addr),
+  RETURN_IF_FALSE_WITH_LOG(rpc_task_pipeline_.WaitTask(task_id), "Pull embedding from remote failed.");
+  RETURN_IF_FALSE_WITH_LOG(InsertLocalHostCache(hash_info.embedding_size, IntToSize(swap_indices_size),
+                                                server_to_host_index, lookup_result->data(), host_hash_table_addr),
                            "Insert local host cache failed.");
   return true;
 }
@@ -1140,7 +1339,7 @@ bool EmbeddingCachePrefetchActor::PullEembeddingsFromRemote(int32_t param_key, c
                              "Send ids to server failed.");
   }
 
-  std::vector<std::unique_ptr<std::vector<char>>> slice_embeddings_list(server_num_);
+  std::vector<ReceivedDataPtr> slice_embeddings_list(server_num_);
   for (size_t i = 0; i < server_num_; i++) {
     if (slice_ids_list[i].empty()) {
       continue;
@@ -1190,11 +1389,15 @@ bool EmbeddingCachePrefetchActor::PushEmbeddingsToRemote(int32_t param_key, cons
       continue;
     }
 
-    // 2. Send embeddings to remote.
-    auto &slice_embeddings = slice_embeddings_list[i];
+    // 2. Send embeddings to remote. The slice is handed over to the message, which sends it without copying.
+    auto slice_data = std::make_shared<std::pair<std::vector<int>, std::vector<float>>>(
+      std::move(slice_ids), std::move(slice_embeddings_list[i]));
+    const auto &ids_to_send = slice_data->first;
+    const auto &embeddings_to_send = slice_data->second;
     RETURN_IF_FALSE_WITH_LOG(
-      SendToRemote(distributed::kUpdateEmbeddingCache, param_key, i, embedding_dim, slice_ids.data(),
-                   slice_ids.size() * sizeof(int), slice_embeddings.data(), slice_embeddings.size() * sizeof(float)),
+      SendToRemote(distributed::kUpdateEmbeddingCache, param_key, i, embedding_dim, ids_to_send.data(),
+                   ids_to_send.size() * sizeof(int), embeddings_to_send.data(),
+                   embeddings_to_send.size() * sizeof(float), false, true, slice_data),
       "Send ids and embeddings to server failed.");
   }
 
@@ -1288,7 +1491,8 @@ bool EmbeddingCachePrefetchActor::PartitionIdsAndEmbeddings(const int *ids, size
 bool EmbeddingCachePrefetchActor::SendToRemote(const std::string &cache_operation, int32_t param_key,
                                                size_t server_rank_id, size_t embedding_dim, const void *keys,
                                                size_t keys_len, const void *values, size_t values_len,
-                                               bool finalize_remote, bool sync) {
+                                               bool finalize_remote, bool sync,
+                                               const std::shared_ptr<void> &data_owner) {
   MS_ERROR_IF_NULL(keys);
   // Find sender corresponding to cache operation and parameter key.
   auto iter = rpc_operators_.find(cache_operation);
@@ -1328,12 +1532,11 @@ bool EmbeddingCachePrefetchActor::SendToRemote(const std::string &cache_operatio
                               std::make_shared<Address>(&service_id, sizeof(int32_t))};
 
   // Send data.
-  return sender->Send(shapes, data_types, data_list, finalize_remote, sync);
+  return sender->Send(shapes, data_types, data_list, finalize_remote, sync, data_owner);
 }
 
-std::unique_ptr<std::vector<char>> EmbeddingCachePrefetchActor::ReceiveFromRemote(const std::string &cache_operation,
-                                                                                  int32_t param_key,
-                                                                                  size_t server_rank_id) {
+ReceivedDataPtr EmbeddingCachePrefetchActor::ReceiveFromRemote(const std::string &cache_operation, int32_t param_key,
+                                                               size_t server_rank_id) {
   // Find receiver corresponding to cache operation and parameter key.
   auto iter = rpc_operators_.find(cache_operation);
   if (iter == rpc_operators_.end()) {
@@ -1349,7 +1552,7 @@ std::unique_ptr<std::vector<char>> EmbeddingCachePrefetchActor::ReceiveFromRemot
 
 bool EmbeddingCachePrefetchActor::RetrieveEmbeddings(
   const int *ids, size_t ids_num, const std::vector<std::vector<int>> &slice_ids_list,
-  const std::vector<std::unique_ptr<std::vector<char>>> &slice_embeddings_list, std::vector<float> *outputs) {
+  const std::vector<ReceivedDataPtr> &slice_embeddings_list, std::vector<float> *outputs) {
   MS_ERROR_IF_NULL(ids);
   MS_ERROR_IF_NULL(outputs);
 
@@ -1358,8 +1561,9 @@ bool EmbeddingCachePrefetchActor::RetrieveEmbeddings(
     return true;
   }
 
-  // Merge all slice ids and embedding data address into ids_to_addrs map.
-  mindspore::HashMap<int, const float *> ids_to_addrs;
+  // Merge all slice ids and embedding data address into ids_to_addrs map. The received embeddings are not necessarily
+  // aligned, they are addressed by bytes.
+  mindspore::HashMap<int, const char *> ids_to_addrs;
   size_t embedding_dim = outputs->size() / ids_num;
   size_t offset = 0;
   for (size_t i = 0; i < slice_ids_list.size(); i++) {
@@ -1367,12 +1571,12 @@ bool EmbeddingCachePrefetchActor::RetrieveEmbeddings(
     if (slice_ids.empty()) {
       continue;
     }
-    const std::unique_ptr<std::vector<char>> &slice_embeddings = slice_embeddings_list[i];
+    const ReceivedDataPtr &slice_embeddings = slice_embeddings_list[i];
     MS_ERROR_IF_NULL(slice_embeddings);
-    const float *embeddings_data = reinterpret_cast<float *>(slice_embeddings->data());
+    const char *embeddings_data = slice_embeddings->data();
     for (size_t j = 0; j < slice_ids.size(); j++) {
       (void)ids_to_addrs.emplace(slice_ids[j], embeddings_data + offset);
-      offset += embedding_dim;
+      offset += embedding_dim * sizeof(float);
     }
     offset = 0;
   }
@@ -1414,6 +1618,10 @@ void EmbeddingCachePrefetchActor::SyncEmbeddingTable() {
   if (!initialized_) {
     return;
   }
+  // The embeddings evicted to remote must arrive before the latest ones of the local cache.
+  if (!rpc_task_pipeline_.WaitAllTasks()) {
+    MS_LOG(ERROR) << "Wait rpc tasks with remote failed.";
+  }
   if (!SyncHostEmbeddingTable()) {
     MS_LOG(ERROR) << "SyncHostEmbeddingTable failed.";
   }
@@ -1622,17 +1830,38 @@ void EmbeddingCachePrefetchActor::LinkRpcOperators() {
 }
 
 bool Sender::Send(const std::vector<ShapeVector> &shapes, const std::vector<TypeId> data_types,
-                  const AddressPtrList &data_list, bool finalize_remote, bool sync) const {
+                  const AddressPtrList &data_list, bool finalize_remote, bool sync,
+                  const std::shared_ptr<void> &data_owner) const {
   MS_ERROR_IF_NULL(receiver_);
-  auto message = BuildRpcMessage(shapes, data_types, data_list, receiver_->get_url(), server_url_, finalize_remote);
+  bool zero_copy =
+    data_owner != nullptr && std::any_of(data_list.begin(), data_list.end(), [](const AddressPtr &data) {
+      return data != nullptr && data->size >= kMinZeroCopySendSize;
+    });
+  // The data referred by the message must stay valid until the message is destroyed, so the message holds its owner,
+  // which outlives this method if the message is still not sent when it returns.
+  std::future<void> sent_future;
+  std::function<void()> release = nullptr;
+  if (zero_copy) {
+    auto sent = std::make_shared<std::promise<void>>();
+    sent_future = sent->get_future();
+    release = [sent, data_owner]() { sent->set_value(); };
+  }
+  auto message =
+    BuildRpcMessage(shapes, data_types, data_list, receiver_->get_url(), server_url_, finalize_remote, release);
   MS_ERROR_IF_NULL(message);
   MS_ERROR_IF_NULL(client_);
-  if (sync) {
-    auto ret = client_->SendSync(std::move(message));
-    return ret > 0;
+  if (!sync) {
+    client_->SendAsync(std::move(message));
+    return true;
   }
 
-  client_->SendAsync(std::move(message));
+  if (client_->SendSync(std::move(message)) <= 0) {
+    return false;
+  }
+  if (zero_copy && sent_future.wait_for(std::chrono::seconds(kRpcTimeoutInSec)) != std::future_status::ready) {
+    MS_LOG(ERROR) << "Send message to " << server_url_ << " timeout after " << kRpcTimeoutInSec << " seconds.";
+    return false;
+  }
   return true;
 }
 
@@ -1670,8 +1899,9 @@ bool Sender::ConnectServer() {
 std::unique_ptr<MessageBase> Sender::BuildRpcMessage(const std::vector<ShapeVector> &shapes,
                                                      const std::vector<TypeId> data_types,
                                                      const AddressPtrList &data_list, const std::string &from_url,
-                                                     const std::string &to_url, bool finalize_remote) const {
-  std::unique_ptr<MessageBase> message = std::make_unique<MessageBase>();
+                                                     const std::string &to_url, bool finalize_remote,
+                                                     const std::function<void()> &release) const {
+  std::unique_ptr<distributed::rpc::GatherMessage> message = std::make_unique<distributed::rpc::GatherMessage>();
   MS_ERROR_IF_NULL_W_RET_VAL(message, nullptr);
   message->from = AID("", from_url);
   message->to = AID("", to_url);
@@ -1699,22 +1929,29 @@ std::unique_ptr<MessageBase> Sender::BuildRpcMessage(const std::vector<ShapeVect
     // Message format:
     // |RPC_DYNAMIC_SHAPE_DATA | dynamic shape PB data size |---dynamic shape PB data----|---real data----|
     // 1. The dynamic shape header.
-    message->body.append(kRpcDynamicShapeData);
+    message->Append(kRpcDynamicShapeData, strlen(kRpcDynamicShapeData));
     // 2. The size of the protobuf DynamicShapeMessage.
     size_t ds_pb_msg_size = ds_pb_msg_str.size();
-    message->body.append(reinterpret_cast<char *>(&ds_pb_msg_size), sizeof(ds_pb_msg_size));
+    message->Append(&ds_pb_msg_size, sizeof(ds_pb_msg_size));
     // 3. Protobuf DynamicShapeMessage.
-    message->body.append(ds_pb_msg_str);
+    message->Append(ds_pb_msg_str.data(), ds_pb_msg_str.size());
     // 4. The real data buffer need to be sent.
-    message->body.append(static_cast<char *>(data->addr), data->size);
+    if (release != nullptr && data->size >= kMinZeroCopySendSize) {
+      message->AppendExternal(data->addr, data->size);
+    } else {
+      message->Append(data->addr, data->size);
+    }
   }
 
   // 5. Finalize remote command.
   if (finalize_remote) {
-    message->body.append(distributed::kFinalizeMuxRecvActor);
-    message->body.append(reinterpret_cast<char *>(&finalize_remote), sizeof(finalize_remote));
+    message->Append(distributed::kFinalizeMuxRecvActor, strlen(distributed::kFinalizeMuxRecvActor));
+    message->Append(&finalize_remote, sizeof(finalize_remote));
   }
 
+  if (release != nullptr) {
+    message->AppendExternal(nullptr, 0, release);
+  }
   return message;
 }
 
@@ -1726,14 +1963,12 @@ Receiver::~Receiver() {
   received_buffer_ = nullptr;
 }
 
-std::unique_ptr<std::vector<char>> Receiver::Receive() {
+ReceivedDataPtr Receiver::Receive() {
   std::unique_lock<std::mutex> locker(received_msg_mtx_);
-  // The maximum time(300 seconds) to wait to receive message.
-  const int64_t longest_time_to_wait = 300;
-  received_msg_cv_.wait_for(locker, std::chrono::seconds(longest_time_to_wait),
+  received_msg_cv_.wait_for(locker, std::chrono::seconds(kRpcTimeoutInSec),
                             [this] { return received_msg_.load(); });
 
-  std::unique_ptr<std::vector<char>> output = std::move(received_buffer_);
+  ReceivedDataPtr output = std::move(received_buffer_);
   MS_EXCEPTION_IF_NULL(output);
   received_msg_ = false;
   return output;
@@ -1752,6 +1987,7 @@ bool Receiver::StartServer() {
 
   // 2. Set the message handler of the server.
   server_->SetMessageHandler(std::bind(&Receiver::HandleMessage, this, std::placeholders::_1));
+  server_->SetMessageAllocator(std::bind(&Receiver::AllocateMessage, this, std::placeholders::_1));
 
   // 3. Register the server address to route table. The server should not be connected before this step is done.
   MS_LOG(INFO) << "Start server for receiver. Server address: " << server_url
@@ -1827,29 +2063,31 @@ MessageBase *Receiver::HandleMessage(MessageBase *const msg) {
     return distributed::rpc::NULL_MSG;
   }
 
-  const std::string &msg_body = msg->body;
+  // The body is in the buffer allocated by 'AllocateMessage'.
+  auto recv_buffer_msg = dynamic_cast<RecvBufferMessage *>(msg);
+  if (recv_buffer_msg == nullptr || recv_buffer_msg->buffer_ == nullptr) {
+    MS_LOG(EXCEPTION) << "The received message is not in a receive buffer.";
+  }
+  const char *msg_body = recv_buffer_msg->buffer_->data();
+  size_t msg_len = recv_buffer_msg->buffer_->size();
   // The data pair: <addr of data, size of data>.
   std::pair<const void *, size_t> real_data;
   // Get real data addr and size.
-  if (!ParseDynamicShapeData(msg_body.c_str(), msg_body.size(), &real_data)) {
+  if (!ParseDynamicShapeData(msg_body, msg_len, &real_data)) {
     MS_LOG(EXCEPTION) << "Parse dynamic shape data failed.";
   }
-
-  std::unique_lock<std::mutex> locker(received_msg_mtx_);
-  received_buffer_ = std::make_unique<std::vector<char>>();
-  received_buffer_->resize(real_data.second);
   MS_EXCEPTION_IF_NULL(real_data.first);
+  size_t offset = LongToSize(static_cast<const char *>(real_data.first) - msg_body);
 
-  int ret = memcpy_s(received_buffer_->data(), received_buffer_->size(), real_data.first, real_data.second);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "Memcpy for received data failed, errno[" << ret << "]";
-  }
-
+  std::unique_lock<std::mutex> locker(received_msg_mtx_);
+  received_buffer_ = std::make_unique<ReceivedData>(std::move(recv_buffer_msg->buffer_), offset, real_data.second);
   received_msg_ = true;
   received_msg_cv_.notify_one();
 
   delete msg;
   return distributed::rpc::NULL_MSG;
 }
+
+MessageBase *Receiver::AllocateMessage(size_t body_size) { return new (std::nothrow) RecvBufferMessage(body_size); }
 }  // namespace runtime
 }  // namespace mindspore
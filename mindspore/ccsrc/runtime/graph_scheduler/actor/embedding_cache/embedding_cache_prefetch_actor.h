@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 #include <utility>
+#include <functional>
+#include <condition_variable>
 
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "ir/anf.h"
@@ -31,6 +33,8 @@
 #include "distributed/rpc/tcp/tcp_server.h"
 #include "utils/hash_map.h"
 #include "distributed/embedding_cache/embedding_cache_utils.h"
+#include "distributed/embedding_cache/hot_id_tracker.h"
+#include "distributed/embedding_cache/rpc_task_pipeline.h"
 
 // Note: After the code in ps/ps_cache are removed into runtime/addons/embedding_cache/,
 // the follow include file and using declaration of ps will be removed.
@@ -52,6 +56,24 @@ using ReceiverPtr = std::shared_ptr<Receiver>;
 using SendRecvPair = std::pair<SenderPtr, ReceiverPtr>;
 using SendRecvPairList = std::vector<SendRecvPair>;
 
+// The body of a message received by a Receiver and the range of the real data in it. The body is received into the
+// buffer directly and handed over without copying the real data out.
+class ReceivedData {
+ public:
+  ReceivedData(std::unique_ptr<std::vector<char>> &&buffer, size_t offset, size_t size)
+      : buffer_(std::move(buffer)), offset_(offset), size_(size) {}
+  ~ReceivedData() = default;
+
+  const char *data() const { return buffer_->data() + offset_; }
+  size_t size() const { return size_; }
+
+ private:
+  std::unique_ptr<std::vector<char>> buffer_;
+  size_t offset_;
+  size_t size_;
+};
+using ReceivedDataPtr = std::unique_ptr<ReceivedData>;
+
 using distributed::EmbeddingCacheStatisticsInfo;
 using distributed::EmbeddingDeviceCache;
 using distributed::EmbeddingHostCache;
@@ -101,6 +123,12 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   // mapping information of the missing feature id that needs to be inserted into the cache.
   bool CountCacheMissIds(const int *batch_ids, const size_t batch_ids_len, int *hash_index);
 
+  // Create the hot id tracker if the environment variable 'MS_EMBEDDING_CACHE_HOT_ID_NUM' is set.
+  void InitHotIdTracker();
+  // Count the accesses of the local ids of the batch, and pin the hot ids in the local host cache when they are
+  // reselected.
+  bool RecordHotIds(const int *batch_ids, size_t batch_ids_num);
+
   // Increase the current global step of cache prefetching operation.
   bool IncreaseStep();
 
@@ -137,10 +165,17 @@ class EmbeddingCachePrefetchActor : public ActorBase {
 
   // Push non-hotspot embeddings on local host cache to remote.
   bool PushCacheFromLocalHostToRemote(const HashTableInfo &hash_info);
+  // Push the embeddings of the pinned ids on local host cache to remote, so that the other workers see their updates
+  // while they stay resident.
+  bool PushPinnedCacheToRemote();
+  // Send the lookup of missing embeddings to remote in the rpc thread, the embeddings are inserted into the local host
+  // cache by 'InsertCacheFromRemoteToLocalHost' once the rpc task 'task_id' finishes.
+  bool PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info, size_t *task_id,
+                                      std::shared_ptr<std::vector<float>> *lookup_result);
+  bool InsertCacheFromRemoteToLocalHost(const HashTableInfo &hash_info, size_t task_id,
+                                        const std::shared_ptr<std::vector<float>> &lookup_result);
   // Push non-hotspot embeddings on device cache to local host cache.
   bool PushCacheFromDeviceToLocalHost(const HashTableInfo &hash_info);
-  // Pull missing embeddings on local cache from remote.
-  bool PullCacheFromRemoteToLocalHost(const HashTableInfo &hash_info);
   // Pull missing embeddings on device cache from local host.
   bool PullCacheFromLocalHostToDevice(const HashTableInfo &hash_info);
 
@@ -177,15 +212,14 @@ class EmbeddingCachePrefetchActor : public ActorBase {
   // The parameter 'cache_operation' is cache operation name such as LookupEmbeddingCache and UpdateEmbeddingCache.
   bool SendToRemote(const std::string &cache_operation, int32_t param_key, size_t server_rank_id, size_t embedding_dim,
                     const void *keys, size_t keys_len, const void *values = nullptr, size_t values_len = 0,
-                    bool finalize_remote = false, bool sync = true);
+                    bool finalize_remote = false, bool sync = true,
+                    const std::shared_ptr<void> &data_owner = nullptr);
   // Wait response of remote and get return result.
   // The parameter 'cache_operation' is cache operation name such as LookupEmbeddingCache and UpdateEmbeddingCache.
-  std::unique_ptr<std::vector<char>> ReceiveFromRemote(const std::string &cache_operation, int32_t param_key,
-                                                       size_t server_rank_id);
+  ReceivedDataPtr ReceiveFromRemote(const std::string &cache_operation, int32_t param_key, size_t server_rank_id);
   // Retrieve embeddings by input ids order.
   bool RetrieveEmbeddings(const int *ids, size_t ids_num, const std::vector<std::vector<int>> &slice_ids_list,
-                          const std::vector<std::unique_ptr<std::vector<char>>> &slice_embeddings_list,
-                          std::vector<float> *outputs);
+                          const std::vector<ReceivedDataPtr> &slice_embeddings_list, std::vector<float> *outputs);
 
   // Send finalize request to remote and finalize it.
   bool FinalizeRemote();
@@ -335,6 +369,17 @@ class EmbeddingCachePrefetchActor : public ActorBase {
 
   // Record latest error information user related.
   std::string error_info_;
+
+  // The max number of rpc tasks in flight, set by the environment variable 'MS_EMBEDDING_CACHE_RPC_PIPELINE_DEPTH'.
+  size_t rpc_pipeline_depth_{0};
+  // The rpc tasks with remote run in order on the thread of the pipeline.
+  distributed::RpcTaskPipeline rpc_task_pipeline_;
+
+  // Track the most frequently accessed ids which are pinned in the local host cache, it is null if the hot ids are
+  // not tracked.
+  std::unique_ptr<distributed::HotIdTracker> hot_id_tracker_;
+  // The number of the ids pulled from the remote servers since the hot ids are reselected last time.
+  size_t interval_server_to_host_size_{0};
 };
 
 // RpcOperator is used to do rpc with other processes in distributed execution.
@@ -367,9 +412,12 @@ class Sender : public RpcOperator {
   Sender() : server_url_(""), client_(nullptr) {}
   ~Sender();
 
-  // Send buffer to peer.
+  // Send buffer to peer. If 'data_owner' is set, it owns the data in 'data_list', and the data not smaller than
+  // kMinZeroCopySendSize is sent from where it is instead of being copied into the message. The message holds the owner
+  // until it is destroyed, and a synchronous send fails if the message is not sent within the rpc timeout.
   bool Send(const std::vector<ShapeVector> &shapes, const std::vector<TypeId> data_types,
-            const AddressPtrList &data_list, bool finalize_remote = false, bool sync = true) const;
+            const AddressPtrList &data_list, bool finalize_remote = false, bool sync = true,
+            const std::shared_ptr<void> &data_owner = nullptr) const;
 
   // Set the receiver paired with the sender to get the 'from url' from the receiver.
   void set_receiver(const ReceiverPtr &receiver) { receiver_ = receiver; }
@@ -383,10 +431,12 @@ class Sender : public RpcOperator {
   // |--------22 bytes-------|-------sizeof(size_t)-------|-dynamic shape PB data size-| real data size |
   // |RPC_DYNAMIC_SHAPE_DATA | dynamic shape PB data size |---dynamic shape PB data----|---real data----|
   // The message.from (from url) must be set.
+  // If 'release' is set, the data not smaller than kMinZeroCopySendSize is referred by the message, and 'release' is
+  // called when the message is destroyed after it has been sent or dropped.
   std::unique_ptr<MessageBase> BuildRpcMessage(const std::vector<ShapeVector> &shapes,
                                                const std::vector<TypeId> data_types, const AddressPtrList &data_list,
                                                const std::string &from_url, const std::string &to_url,
-                                               bool finalize_remote) const;
+                                               bool finalize_remote, const std::function<void()> &release) const;
 
   // The url of the peer receiver's tcp server.
   std::string server_url_;
@@ -406,7 +456,7 @@ class Receiver : public RpcOperator {
 
   // Receive message from the peer sender, this interface is a synchronous interface and will wait for the message
   // until the timeout period is reached.
-  std::unique_ptr<std::vector<char>> Receive();
+  ReceivedDataPtr Receive();
 
   // Start receiver server and register this server address to route table in scheduler by proxy.
   bool StartServer();
@@ -417,6 +467,9 @@ class Receiver : public RpcOperator {
  private:
   // The message callback of the tcp server.
   MessageBase *HandleMessage(MessageBase *const msg);
+  // The message allocator of the tcp server, the message body is received into a buffer which is handed over by
+  // 'Receive' later.
+  MessageBase *AllocateMessage(size_t body_size);
 
   // Parse the dynamic shape protobuf message. The format is as below:
   // |--------22 bytes-------|-------sizeof(size_t)-------|-dynamic shape PB data size-| real data size |
@@ -430,8 +483,8 @@ class Receiver : public RpcOperator {
 
   std::unique_ptr<TCPServer> server_;
 
-  // The buffer used save received content of message.
-  std::unique_ptr<std::vector<char>> received_buffer_;
+  // The received content of message.
+  ReceivedDataPtr received_buffer_;
 
   // The flag indicates whether receive message successfully.
   std::atomic_bool received_msg_;
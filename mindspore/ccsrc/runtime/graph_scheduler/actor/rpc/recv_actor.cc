@@ -24,6 +24,7 @@
 #include "distributed/rpc/tcp/constants.h"
 #include "plugin/device/cpu/kernel/rpc/rpc_recv_kernel.h"
 #include "backend/common/optimizer/helper.h"
+#include "ps/ps_context.h"
 
 namespace mindspore {
 namespace runtime {
@@ -54,7 +55,7 @@ void RecvActor::SetRouteInfo(uint32_t, const std::string &, const std::string &r
 
 bool RecvActor::StartServer() {
   // Step 1: Create a tcp server and start listening.
-  server_ = std::make_unique<TCPServer>();
+  server_ = std::make_unique<TCPServer>(false, ps::PSContext::instance()->rpc_event_loop_num());
   MS_EXCEPTION_IF_NULL(server_);
   if (!server_->Initialize()) {
     MS_LOG(EXCEPTION) << "Failed to initialize tcp server for recv actor";
@@ -76,6 +76,7 @@ static mindspore::HashMap<TypeId, std::string> g_type_2_lable{{kTypeUnknown, "Un
                                                               {kNumberTypeComplex128, "Complex128"},
                                                               {kNumberTypeInt4, "Int4"},
                                                               {kNumberTypeGLUInt, "GLUInt"},
+                                                              {kNumberTypeBFloat16, "BFloat16"},
                                                               {kObjectTypeMonad, "Monad"},
                                                               {kObjectTypeUMonad, "UMonad"},
                                                               {kObjectTypeIOMonad, "IOMonad"}};
@@ -74,6 +74,7 @@ std::string GetExcptionTypeString(TypeId id) {
                                                                       {kNumberTypeComplex, "Complex"},
                                                                       {kNumberTypeInt4, "Int4"},
                                                                       {kNumberTypeGLUInt, "GLUInt"},
+                                                                      {kNumberTypeBFloat16, "BFloat16"},
                                                                       {kObjectTypeMonad, "Monad"},
                                                                       {kObjectTypeCSRTensorType, "CSRTensor"}};
 
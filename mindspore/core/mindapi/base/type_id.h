@@ -99,7 +99,11 @@ enum TypeId : int {
   kSparseTypeBegin = kMonadTypeEnd,
   kObjectTypeCSRTensorType,
   kObjectTypeSparseTensorType,
-  kSparseTypeEnd
+  kSparseTypeEnd,
+  //
+  // Number types added later are appended here,
+  // in order to keep the ids of the types above, which are saved in the existing models.
+  kNumberTypeBFloat16,
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_CORE_MINDAPI_BASE_TYPE_ID_H_
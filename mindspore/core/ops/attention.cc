@@ -17,9 +17,37 @@
 
 #include "ops/attention.h"
 #include "ops/primitive_c.h"
+#include "ops/op_utils.h"
 #include "mindapi/src/helper.h"
 
 namespace mindspore::ops {
+void Attention::Init(const int64_t head_num, const int64_t head_size, const float scale) {
+  this->set_head_num(head_num);
+  this->set_head_size(head_size);
+  this->set_scale(scale);
+}
+
+void Attention::set_head_num(const int64_t head_num) { (void)this->AddAttr(kHeadNum, api::MakeValue(head_num)); }
+
+void Attention::set_head_size(const int64_t head_size) { (void)this->AddAttr(kHeadSize, api::MakeValue(head_size)); }
+
+void Attention::set_scale(const float scale) { (void)this->AddAttr(kScale, api::MakeValue(scale)); }
+
+int64_t Attention::get_head_num() const {
+  auto value_ptr = this->GetAttr(kHeadNum);
+  return GetValue<int64_t>(value_ptr);
+}
+
+int64_t Attention::get_head_size() const {
+  auto value_ptr = this->GetAttr(kHeadSize);
+  return GetValue<int64_t>(value_ptr);
+}
+
+float Attention::get_scale() const {
+  auto value_ptr = this->GetAttr(kScale);
+  return GetValue<float>(value_ptr);
+}
+
 MIND_API_OPERATOR_IMPL(Attention, BaseOperator);
 REGISTER_PRIMITIVE_C(kNameAttention, Attention);
 }  // namespace mindspore::ops
@@ -37,7 +37,35 @@ class MIND_API Attention : public BaseOperator {
       {"output"});
   }
   /// \brief Initialize Attention op.
-  void Init() const {}
+  ///
+  /// \param[in] head_num Define the number of heads.
+  /// \param[in] head_size Define the size of each head.
+  /// \param[in] scale Define the scale multiplied to q * k before softmax.
+  void Init(const int64_t head_num = 0, const int64_t head_size = 0, const float scale = 1.0f);
+  /// \brief Method to set head_num attribute.
+  ///
+  /// \param[in] head_num Define the number of heads.
+  void set_head_num(const int64_t head_num);
+  /// \brief Method to set head_size attribute.
+  ///
+  /// \param[in] head_size Define the size of each head.
+  void set_head_size(const int64_t head_size);
+  /// \brief Method to set scale attribute.
+  ///
+  /// \param[in] scale Define the scale multiplied to q * k before softmax.
+  void set_scale(const float scale);
+  /// \brief Method to get head_num attribute.
+  ///
+  /// \return the number of heads.
+  int64_t get_head_num() const;
+  /// \brief Method to get head_size attribute.
+  ///
+  /// \return the size of each head.
+  int64_t get_head_size() const;
+  /// \brief Method to get scale attribute.
+  ///
+  /// \return the scale multiplied to q * k before softmax.
+  float get_scale() const;
 };
 }  // namespace ops
 }  // namespace mindspore
@@ -42,6 +42,32 @@ ActivationType MatMulFusion::get_activation_type() const {
   return ActivationType(GetValue<int64_t>(value_ptr));
 }
 
+void MatMulFusion::set_epilogue_type(const int64_t epilogue_type) {
+  (void)this->AddAttr(kEpilogueType, api::MakeValue(epilogue_type));
+}
+
+int64_t MatMulFusion::get_epilogue_type() const {
+  auto value_ptr = GetAttr(kEpilogueType);
+  return value_ptr == nullptr ? 0 : GetValue<int64_t>(value_ptr);
+}
+
+void MatMulFusion::set_approximate(const bool approximate) {
+  (void)this->AddAttr(kApproximate, api::MakeValue(approximate));
+}
+
+bool MatMulFusion::get_approximate() const {
+  auto value_ptr = GetAttr(kApproximate);
+  return value_ptr != nullptr && GetValue<bool>(value_ptr);
+}
+
+void MatMulFusion::set_epsilon(const float epsilon) { (void)this->AddAttr(kEpsilon, api::MakeValue(epsilon)); }
+
+float MatMulFusion::get_epsilon() const {
+  auto value_ptr = GetAttr(kEpsilon);
+  MS_EXCEPTION_IF_NULL(value_ptr);
+  return GetValue<float>(value_ptr);
+}
+
 REGISTER_PRIMITIVE_C(kNameMatMulFusion, MatMulFusion);
 }  // namespace ops
 }  // namespace mindspore
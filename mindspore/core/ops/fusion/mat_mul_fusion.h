@@ -42,6 +42,30 @@ class MIND_API MatMulFusion : public MatMul {
   ///
   /// \return activation type.
   ActivationType get_activation_type() const;
+  /// \brief Method to set the epilogues fused after the matmul, a bit mask of MatmulEpilogueType in nnacl.
+  ///
+  /// \param[in] epilogue_type Define the fused epilogues.
+  void set_epilogue_type(const int64_t epilogue_type);
+  /// \brief Method to get the fused epilogues.
+  ///
+  /// \return the fused epilogues.
+  int64_t get_epilogue_type() const;
+  /// \brief Method to set whether the fused gelu uses the tanh approximation.
+  ///
+  /// \param[in] approximate Define whether the fused gelu uses the tanh approximation.
+  void set_approximate(const bool approximate);
+  /// \brief Method to get whether the fused gelu uses the tanh approximation.
+  ///
+  /// \return whether the fused gelu uses the tanh approximation.
+  bool get_approximate() const;
+  /// \brief Method to set the epsilon of the fused layer norm.
+  ///
+  /// \param[in] epsilon Define the epsilon of the fused layer norm.
+  void set_epsilon(const float epsilon);
+  /// \brief Method to get the epsilon of the fused layer norm.
+  ///
+  /// \return the epsilon of the fused layer norm.
+  float get_epsilon() const;
 };
 }  // namespace ops
 }  // namespace mindspore
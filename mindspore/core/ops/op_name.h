@@ -142,6 +142,8 @@ constexpr auto kAttentionNumHeads = "attention_num_heads";
 constexpr auto kAttentionSizePerHead = "attention_size_per_head";
 constexpr auto kAttentionFromSeqLen = "attention_from_seq_len";
 constexpr auto kAttentionToSeqLen = "attention_to_seq_len";
+constexpr auto kHeadNum = "head_num";
+constexpr auto kHeadSize = "head_size";
 constexpr auto kOffset = "offset";
 constexpr auto kNmsIouThreshold = "nms_iou_threshold";
 constexpr auto kNmsScoreThreshold = "nms_score_threshold";
@@ -281,6 +283,7 @@ constexpr auto kSplitDim = "split_dim";
 constexpr auto kPadTop = "pad_top";
 constexpr auto kTransFormat = "trans_format";
 constexpr auto kApproximate = "approximate";
+constexpr auto kEpilogueType = "epilogue_type";
 constexpr auto kNumOutput = "num_output";
 constexpr auto kUseGlobalStats = "use_global_stats";
 constexpr auto kFmkType = "fmk_type";
@@ -41,6 +41,12 @@ class MS_API Converter {
   void SetWeightFp16(bool weight_fp16);
   bool GetWeightFp16() const;
 
+  void SetWeightBf16(bool weight_bf16);
+  bool GetWeightBf16() const;
+
+  void SetSparseWeightThreshold(float sparse_weight_threshold);
+  float GetSparseWeightThreshold() const;
+
   void SetInputShape(const std::map<std::string, std::vector<int64_t>> &input_shape);
   std::map<std::string, std::vector<int64_t>> GetInputShape() const;
 
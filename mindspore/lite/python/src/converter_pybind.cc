@@ -38,6 +38,10 @@ void ConverterPyBind(const py::module &m) {
     .def("get_config_info", &Converter::GetConfigInfo)
     .def("set_weight_fp16", &Converter::SetWeightFp16)
     .def("get_weight_fp16", &Converter::GetWeightFp16)
+    .def("set_weight_bf16", &Converter::SetWeightBf16)
+    .def("get_weight_bf16", &Converter::GetWeightBf16)
+    .def("set_sparse_weight_threshold", &Converter::SetSparseWeightThreshold)
+    .def("get_sparse_weight_threshold", &Converter::GetSparseWeightThreshold)
     .def("set_input_shape", &Converter::SetInputShape)
     .def("get_input_shape", &Converter::GetInputShape)
     .def("set_input_format", &Converter::SetInputFormat)
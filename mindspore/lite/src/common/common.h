@@ -68,6 +68,19 @@ static const char *const kMSCacheSerializePath = "serialize_path";
 // weight path
 static const char *const kWeight = "weight";
 static const char *const kWeightPath = "weight_path";
+// weights consumed only by gather are decoded on demand after compile, the peak memory of compile is not reduced.
+static const char *const kWeightLazyDecode = "lazy_decode";
+static const char *const kWeightDecodeCacheSize = "decode_cache_size";
+// inter op parallel
+static const char *const kInterOpParallel = "inter_op_parallel";
+static const char *const kInterOpParallelEnable = "enable";
+// subgraph memo
+static const char *const kSubGraphMemo = "subgraph_memo";
+static const char *const kSubGraphMemoEnable = "enable";
+static const char *const kSubGraphMemoCacheSize = "cache_size";
+// pipeline
+static const char *const kPipeline = "pipeline";
+static const char *const kPipelineStageNum = "stage_num";
 }  // namespace lite
 }  // namespace mindspore
 
@@ -389,6 +389,9 @@ OP_ATTR(axis, long)
 OP_SCHEMA_DEF_END(Concat)
 
 OP_SCHEMA_DEF(Attention)
+OP_ATTR(head_num, long)
+OP_ATTR(head_size, long)
+OP_ATTR_WITH_VALUE(scale, float, 1)
 OP_SCHEMA_DEF_END(Attention)
 
 OP_SCHEMA_DEF(Conv2DBackpropFilterFusion)
@@ -697,6 +700,9 @@ OP_SCHEMA_DEF(MatMulFusion)
 OP_ATTR_WITH_VALUE(transpose_a, bool, false)
 OP_ATTR_WITH_VALUE(transpose_b, bool, false)
 OP_ATTR_ENUM_WITH_VALUE(activation_type, ActivationType, 0)
+OP_ATTR_WITH_VALUE(epilogue_type, long, 0)
+OP_ATTR_WITH_VALUE(approximate, bool, false)
+OP_ATTR_WITH_VALUE(epsilon, float, 0.00001)
 OP_SCHEMA_DEF_END(MatMulFusion)
 
 OP_SCHEMA_DEF(Maximum)
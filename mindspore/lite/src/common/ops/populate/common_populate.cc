@@ -15,7 +15,6 @@
  */
 #include "src/common/ops/populate/populate_register.h"
 using mindspore::schema::PrimitiveType_AddN;
-using mindspore::schema::PrimitiveType_Attention;
 using mindspore::schema::PrimitiveType_Depend;
 using mindspore::schema::PrimitiveType_SwitchLayer;
 using mindspore::schema::PrimitiveType_ZerosLike;
@@ -40,7 +39,6 @@ OpParameter *PopulateCommonParameter(const void *prim) {
 REG_POPULATE(PrimitiveType_AddN, PopulateCommonParameter, SCHEMA_CUR)
 REG_POPULATE(PrimitiveType_ZerosLike, PopulateCommonParameter, SCHEMA_CUR)
 REG_POPULATE(PrimitiveType_Depend, PopulateCommonParameter, SCHEMA_CUR)
-REG_POPULATE(PrimitiveType_Attention, PopulateCommonParameter, SCHEMA_CUR)
 REG_POPULATE(PrimitiveType_SwitchLayer, PopulateCommonParameter, SCHEMA_CUR)
 }  // namespace lite
 }  // namespace mindspore
@@ -36,6 +36,14 @@ OpParameter *PopulateMatMulParameter(const void *prim) {
   param->a_transpose_ = value->transpose_a();
   param->has_bias_ = false;
   param->act_type_ = static_cast<ActType>(value->activation_type());
+  param->epilogue_ = static_cast<int>(value->epilogue_type());
+  param->gelu_approximate_ = value->approximate();
+  param->epilogue_epsilon_ = value->epsilon();
+  // a gelu activation has no gemm post-function, it runs as the first epilogue instead.
+  if (value->activation_type() == schema::ActivationType_GELU) {
+    param->act_type_ = ActType_No;
+    param->epilogue_ |= MatmulEpilogue_Gelu;
+  }
 
   return reinterpret_cast<OpParameter *>(param);
 }
@@ -34,6 +34,11 @@ int MatMulTensorRT::IsSupport(const mindspore::schema::Primitive *primitive,
     MS_LOG(ERROR) << "Unsupported input tensor unknown shape: " << op_name_;
     return RET_ERROR;
   }
+  auto matmul_prim = primitive->value_as_MatMulFusion();
+  if (matmul_prim != nullptr && matmul_prim->epilogue_type() != 0) {
+    MS_LOG(WARNING) << "Unsupported fused epilogue of " << op_name_;
+    return RET_NOT_SUPPORT;
+  }
   if (in_tensors.size() != INPUT_SIZE2 && in_tensors.size() != INPUT_SIZE3) {
     MS_LOG(ERROR) << "Unsupported input tensor size, size is " << in_tensors.size();
     return RET_ERROR;
@@ -253,6 +253,15 @@ Status Model::Predict(const MSKernelCallBack &before, const MSKernelCallBack &af
   return impl_->Predict(before, after);
 }
 
+Status Model::PredictPipeline(size_t micro_batch_num, const MSPipelineCallBack &feed, const MSPipelineCallBack &fetch,
+                              const MSKernelCallBack &before, const MSKernelCallBack &after) {
+  if (impl_ == nullptr) {
+    MS_LOG(ERROR) << "Model implement is null.";
+    return kLiteNullptr;
+  }
+  return impl_->PredictPipeline(micro_batch_num, feed, fetch, before, after);
+}
+
 Status Model::PredictWithPreprocess(const std::vector<std::vector<MSTensor>> &inputs, std::vector<MSTensor> *outputs,
                                     const MSKernelCallBack &before, const MSKernelCallBack &after) {
   MS_LOG(ERROR) << "Unsupported Feature.";
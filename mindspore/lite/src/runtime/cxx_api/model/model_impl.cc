@@ -177,13 +177,14 @@ static void ResetTensorData(std::vector<void *> old_data, const std::vector<lite
   }
 }
 
-Status ModelImpl::RunGraph(const MSKernelCallBack &before, const MSKernelCallBack &after) {
-  lite::KernelCallBack before_call_back = nullptr;
-  lite::KernelCallBack after_call_back = nullptr;
+void ModelImpl::ConvertCallBack(const MSKernelCallBack &before, const MSKernelCallBack &after,
+                                lite::KernelCallBack *before_call_back, lite::KernelCallBack *after_call_back) {
+  *before_call_back = nullptr;
+  *after_call_back = nullptr;
   if (before != nullptr) {
-    before_call_back = [&](const std::vector<mindspore::lite::Tensor *> &before_inputs,
-                           const std::vector<mindspore::lite::Tensor *> &before_outputs,
-                           const MSCallBackParam &call_param) {
+    *before_call_back = [&before](const std::vector<mindspore::lite::Tensor *> &before_inputs,
+                                  const std::vector<mindspore::lite::Tensor *> &before_outputs,
+                                  const MSCallBackParam &call_param) {
       std::vector<MSTensor> inputs = LiteTensorsToMSTensors(before_inputs);
       std::vector<MSTensor> outputs = LiteTensorsToMSTensors(before_outputs);
       return before(inputs, outputs, call_param);
@@ -191,14 +192,20 @@ Status ModelImpl::RunGraph(const MSKernelCallBack &before, const MSKernelCallBac
   }
 
   if (after != nullptr) {
-    after_call_back = [&](const std::vector<mindspore::lite::Tensor *> &before_inputs,
-                          const std::vector<mindspore::lite::Tensor *> &before_outputs,
-                          const MSCallBackParam &call_param) {
+    *after_call_back = [&after](const std::vector<mindspore::lite::Tensor *> &before_inputs,
+                                const std::vector<mindspore::lite::Tensor *> &before_outputs,
+                                const MSCallBackParam &call_param) {
       std::vector<MSTensor> inputs = LiteTensorsToMSTensors(before_inputs);
       std::vector<MSTensor> outputs = LiteTensorsToMSTensors(before_outputs);
       return after(inputs, outputs, call_param);
     };
   }
+}
+
+Status ModelImpl::RunGraph(const MSKernelCallBack &before, const MSKernelCallBack &after) {
+  lite::KernelCallBack before_call_back = nullptr;
+  lite::KernelCallBack after_call_back = nullptr;
+  ConvertCallBack(before, after, &before_call_back, &after_call_back);
   auto ret = session_->RunGraph(before_call_back, after_call_back);
   return static_cast<StatusCode>(ret);
 }
@@ -355,6 +362,31 @@ Status ModelImpl::Predict(const MSKernelCallBack &before, const MSKernelCallBack
   return kSuccess;
 }
 
+Status ModelImpl::PredictPipeline(size_t micro_batch_num, const MSPipelineCallBack &feed,
+                                  const MSPipelineCallBack &fetch, const MSKernelCallBack &before,
+                                  const MSKernelCallBack &after) {
+  if (session_ == nullptr) {
+    MS_LOG(ERROR) << "Run graph failed.";
+    return kLiteError;
+  }
+  if (feed == nullptr || fetch == nullptr) {
+    MS_LOG(ERROR) << "The feed and fetch callbacks of pipeline must be set.";
+    return kLiteNullptr;
+  }
+  lite::KernelCallBack before_call_back = nullptr;
+  lite::KernelCallBack after_call_back = nullptr;
+  ConvertCallBack(before, after, &before_call_back, &after_call_back);
+  auto lite_feed = [&feed](size_t index) { return static_cast<int>(feed(index).StatusCode()); };
+  auto lite_fetch = [&fetch](size_t index) { return static_cast<int>(fetch(index).StatusCode()); };
+  auto ret = session_->RunGraphPipeline(micro_batch_num, lite_feed, lite_fetch, before_call_back, after_call_back);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Run graph pipeline failed : " << ret;
+    return static_cast<StatusCode>(ret);
+  }
+  MS_LOG(DEBUG) << "Run graph pipeline success.";
+  return kSuccess;
+}
+
 std::vector<MSTensor> ModelImpl::GetInputs() {
   std::vector<MSTensor> empty;
   if (session_ == nullptr) {
@@ -74,6 +74,9 @@ class ModelImpl {
 
   Status Predict(const MSKernelCallBack &before, const MSKernelCallBack &after);
 
+  Status PredictPipeline(size_t micro_batch_num, const MSPipelineCallBack &feed, const MSPipelineCallBack &fetch,
+                         const MSKernelCallBack &before, const MSKernelCallBack &after);
+
   lite::LiteSession *CreateLiteSession(lite::InnerContext *context);
 
   Status LoadConfig(const std::string &config_path);
@@ -128,6 +131,8 @@ class ModelImpl {
   void SetContext(const std::shared_ptr<Context> &context) { context_ = context; }
   void SetConfig(const std::shared_ptr<TrainCfg> cfg) { cfg_ = cfg; }
   Status RunGraph(const MSKernelCallBack &before, const MSKernelCallBack &after);
+  void ConvertCallBack(const MSKernelCallBack &before, const MSKernelCallBack &after,
+                       lite::KernelCallBack *before_call_back, lite::KernelCallBack *after_call_back);
   std::map<std::string, TypeId> execution_plan_;
   std::map<std::string, std::map<std::string, std::string>> config_info_;
 };
@@ -18,6 +18,11 @@
 namespace mindspore::lite {
 int MatMulCoreMLOp::IsSupport() {
   MS_CHECK_GE(in_tensors_.size(), kInputSize1, RET_NOT_SUPPORT);
+  auto matmul_prim = op_primitive_->value_as_MatMulFusion();
+  if (matmul_prim != nullptr && matmul_prim->epilogue_type() != 0) {
+    MS_LOG(WARNING) << "The fused epilogue is not supported by CoreML matmul.";
+    return RET_NOT_SUPPORT;
+  }
   if (in_tensors_.size() > kInputSize1 && !in_tensors_.at(SECOND_INPUT).IsConst()) {
     MS_LOG(WARNING) << "Bias for CoreML matmul is supported only when the second input is a constant.";
     return RET_NOT_SUPPORT;
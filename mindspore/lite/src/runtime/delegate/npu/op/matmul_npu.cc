@@ -25,6 +25,10 @@ constexpr int BATCH_MATMUL_MAX_SHAPE = 1024;
 int MatMulNPUOp::IsSupport(const schema::Primitive *primitive, const std::vector<mindspore::MSTensor> &in_tensors,
                            const std::vector<mindspore::MSTensor> &out_tensors) {
   MS_CHECK_TRUE_RET(in_tensors.size() >= MATMUL_COMMON_DIM, RET_ERROR);
+  auto matmul_prim = primitive->value_as_MatMulFusion();
+  if (matmul_prim != nullptr && matmul_prim->epilogue_type() != 0) {
+    return RET_NOT_SUPPORT;
+  }
   if (in_tensors.front().Shape().size() > MATMUL_COMMON_DIM || in_tensors.at(1).Shape().size() > MATMUL_COMMON_DIM) {
     // The size of each input dim should be less than 1024 in batchmatmul, whose input dim exceeds 2.
     bool is_exceed_dim = std::any_of(in_tensors.begin(), in_tensors.begin() + 1, [](const MSTensor &input) {
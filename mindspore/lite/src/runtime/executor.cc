@@ -47,4 +47,30 @@ int Executor::Run(const std::vector<Tensor *> &in_tensors, const std::vector<Ten
   thread_pool->SetSpinCountMinValue();
   return RET_OK;
 }
+
+int Executor::RunPipeline(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                          const std::vector<kernel::KernelExec *> &kernels, size_t micro_batch_num,
+                          const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch, const KernelCallBack &before,
+                          const KernelCallBack &after) {
+  CHECK_NULL_RETURN(feed);
+  CHECK_NULL_RETURN(fetch);
+  for (size_t i = 0; i < micro_batch_num; ++i) {
+    auto ret = feed(i);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "feed micro-batch " << i << " failed.";
+      return ret;
+    }
+    ret = Run(in_tensors, out_tensors, kernels, before, after);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "run micro-batch " << i << " failed.";
+      return ret;
+    }
+    ret = fetch(i);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "fetch micro-batch " << i << " failed.";
+      return ret;
+    }
+  }
+  return RET_OK;
+}
 }  // namespace mindspore::lite
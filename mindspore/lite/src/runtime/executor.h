@@ -17,11 +17,16 @@
 #ifndef MINDSPORE_LITE_SRC_RUNTIME_EXECUTOR_H_
 #define MINDSPORE_LITE_SRC_RUNTIME_EXECUTOR_H_
 
+#include <functional>
 #include <vector>
 #include "src/runtime/inner_allocator.h"
 #include "src/runtime/kernel_exec.h"
 
 namespace mindspore::lite {
+// feed fills the graph inputs with the index-th micro-batch, fetch takes the graph outputs of the index-th micro-batch.
+using PipelineFeedFunc = std::function<int(size_t index)>;
+using PipelineFetchFunc = std::function<int(size_t index)>;
+
 class Executor {
  public:
   Executor() = default;
@@ -37,6 +42,12 @@ class Executor {
                   const std::vector<kernel::KernelExec *> &kernels, const KernelCallBack &before = nullptr,
                   const KernelCallBack &after = nullptr);
 
+  // run micro_batch_num micro-batches one by one, fetch is called in the order of micro-batches.
+  virtual int RunPipeline(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                          const std::vector<kernel::KernelExec *> &kernels, size_t micro_batch_num,
+                          const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch,
+                          const KernelCallBack &before = nullptr, const KernelCallBack &after = nullptr);
+
   virtual int Resize(const std::vector<Tensor *> &inputs, const std::vector<std::vector<int>> &dims) { return RET_OK; }
 
  protected:
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/cpu/fp16/attention_fp16.h"
+#include "schema/model_generated.h"
+#include "src/runtime/kernel_registry.h"
+#include "include/errorcode.h"
+#include "nnacl/fp16/cast_fp16.h"
+#include "nnacl/fp16/flash_attention_fp16.h"
+#include "nnacl/fp16/matmul_fp16.h"
+
+using mindspore::kernel::KERNEL_ARCH;
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_Attention;
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kWeightQIndex = 3;
+constexpr size_t kBiasQIndex = 7;
+constexpr size_t kMaskIndex = 11;
+}  // namespace
+
+void AttentionFp16CPUKernel::InitGlobalVariable() {
+#ifdef ENABLE_ARM64
+  row_tile_ = C16NUM;
+#else
+  row_tile_ = C12NUM;
+#endif
+  col_tile_ = C8NUM;
+  data_size_ = sizeof(float16_t);
+}
+
+int AttentionFp16CPUKernel::PackProjection(int index) {
+  auto weight = in_tensors_.at(kWeightQIndex + index);
+  auto bias = in_tensors_.at(kBiasQIndex + index);
+  auto weight_type = weight->data_type();
+  auto bias_type = bias->data_type();
+  if ((weight_type != kNumberTypeFloat32 && weight_type != kNumberTypeFloat16) ||
+      (bias_type != kNumberTypeFloat32 && bias_type != kNumberTypeFloat16)) {
+    MS_LOG(ERROR) << "Attention weight and bias should be float32 or float16.";
+    return RET_ERROR;
+  }
+  auto &projection = projections_[index];
+  size_t weight_size = projection.deep_ * projection.col_align_ * sizeof(float16_t);
+  projection.packed_weight_ = malloc(weight_size);
+  if (projection.packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc attention packed weight failed.";
+    return RET_MEMORY_FAILED;
+  }
+  memset(projection.packed_weight_, 0, weight_size);
+  RowMajor2Row8MajorFp16(weight->data(), reinterpret_cast<float16_t *>(projection.packed_weight_), projection.deep_,
+                         projection.col_, weight_type == kNumberTypeFloat32);
+
+  projection.packed_bias_ = malloc(projection.col_align_ * sizeof(float16_t));
+  if (projection.packed_bias_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc attention packed bias failed.";
+    return RET_MEMORY_FAILED;
+  }
+  auto packed_bias = reinterpret_cast<float16_t *>(projection.packed_bias_);
+  memset(packed_bias, 0, projection.col_align_ * sizeof(float16_t));
+  if (bias_type == kNumberTypeFloat32) {
+    Float32ToFloat16(reinterpret_cast<float *>(bias->data()), packed_bias, projection.col_);
+  } else {
+    memcpy(packed_bias, bias->data(), projection.col_ * sizeof(float16_t));
+  }
+  return RET_OK;
+}
+
+int AttentionFp16CPUKernel::PrepareMask() {
+  if (in_tensors_.size() <= kMaskIndex || in_tensors_.at(kMaskIndex)->data_type() != kNumberTypeFloat16) {
+    return AttentionCPUKernel::PrepareMask();
+  }
+  auto mask = in_tensors_.at(kMaskIndex);
+  CHECK_NULL_RETURN(mask->data());
+  int mask_num = mask->ElementsNum();
+  auto mask_data = reinterpret_cast<float *>(ms_context_->allocator->Malloc(mask_num * sizeof(float)));
+  if (mask_data == nullptr) {
+    MS_LOG(ERROR) << "Malloc attention mask failed.";
+    return RET_MEMORY_FAILED;
+  }
+  Float16ToFloat32(reinterpret_cast<float16_t *>(mask->data()), mask_data, mask_num);
+  mask_data_ = mask_data;
+  mask_need_free_ = true;
+  return RET_OK;
+}
+
+int AttentionFp16CPUKernel::ProjectImpl(const void *src, void *dst, void *pack_buffer, const Projection &projection,
+                                        int row_start, int row_num) {
+  int deep = projection.deep_;
+  auto src_data = reinterpret_cast<const float16_t *>(src) + static_cast<size_t>(row_start) * deep;
+  auto pack_data = reinterpret_cast<float16_t *>(pack_buffer) + static_cast<size_t>(row_start) * deep;
+  auto dst_data = reinterpret_cast<float16_t *>(dst) + static_cast<size_t>(row_start) * projection.col_;
+  auto weight = reinterpret_cast<float16_t *>(projection.packed_weight_);
+  auto bias = reinterpret_cast<float16_t *>(projection.packed_bias_);
+#ifdef ENABLE_ARM64
+  RowMajor2ColNMajorFp16(src_data, pack_data, row_num, deep);
+  MatmulBaseFp16Neon(pack_data, weight, dst_data, bias, ActType_No, deep, row_num, projection.col_, projection.col_,
+                     OutType_Nhwc);
+#else
+  RowMajor2Col12MajorFp16(src_data, pack_data, row_num, deep, false);
+  MatMulFp16(pack_data, weight, dst_data, bias, ActType_No, deep, row_num, projection.col_, projection.col_,
+             OutType_Nhwc);
+#endif
+  return RET_OK;
+}
+
+void AttentionFp16CPUKernel::AttentionImpl(int batch, int head, int q_start, void *buffer) {
+  FlashAttentionTileFp16(reinterpret_cast<float16_t *>(q_data_), reinterpret_cast<float16_t *>(k_data_),
+                         reinterpret_cast<float16_t *>(v_data_), reinterpret_cast<float *>(mask_data_),
+                         reinterpret_cast<float16_t *>(context_data_), reinterpret_cast<float *>(buffer), param_,
+                         batch, head, q_start);
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat16, PrimitiveType_Attention, LiteKernelCreator<AttentionFp16CPUKernel>)
+}  // namespace mindspore::kernel
@@ -0,0 +1,41 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP16_ATTENTION_FP16_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP16_ATTENTION_FP16_H_
+
+#include <vector>
+#include "src/runtime/kernel/cpu/fp32/attention_fp32.h"
+
+namespace mindspore::kernel {
+// float16 q/k/v and projections, the attention core keeps scores and softmax statistics in float.
+class AttentionFp16CPUKernel : public AttentionCPUKernel {
+ public:
+  AttentionFp16CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                         const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : AttentionCPUKernel(parameter, inputs, outputs, ctx) {}
+  ~AttentionFp16CPUKernel() override = default;
+
+ protected:
+  void InitGlobalVariable() override;
+  int PackProjection(int index) override;
+  int ProjectImpl(const void *src, void *dst, void *pack_buffer, const Projection &projection, int row_start,
+                  int row_num) override;
+  void AttentionImpl(int batch, int head, int q_start, void *buffer) override;
+  int PrepareMask() override;
+};
+}  // namespace mindspore::kernel
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP16_ATTENTION_FP16_H_
@@ -175,5 +175,25 @@ int MatmulFP16CPUKernel::Eval() {
   return RET_OK;
 }
 
-REG_KERNEL(kCPU, kNumberTypeFloat16, PrimitiveType_MatMulFusion, LiteKernelCreator<MatmulFP16CPUKernel>)
+/* creator func */
+kernel::LiteKernel *CpuMatmulFp16KernelCreator(const std::vector<lite::Tensor *> &inputs,
+                                               const std::vector<lite::Tensor *> &outputs, OpParameter *opParameter,
+                                               const lite::Context *ctx, const kernel::KernelKey &desc) {
+  // the fused epilogues only exist in fp32, returning null lets the scheduler fall back to it.
+  if (reinterpret_cast<MatMulParameter *>(opParameter)->epilogue_ != MatmulEpilogue_None) {
+    MS_LOG(DEBUG) << "Matmul fp16 not support the fused epilogue.";
+    free(opParameter);
+    return nullptr;
+  }
+  kernel::LiteKernel *kernel = new (std::nothrow)
+    kernel::MatmulFP16CPUKernel(opParameter, inputs, outputs, static_cast<const lite::InnerContext *>(ctx));
+  if (kernel == nullptr) {
+    MS_LOG(DEBUG) << "Create matmul fp16 kernel failed.";
+    free(opParameter);
+    return nullptr;
+  }
+  return kernel;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat16, PrimitiveType_MatMulFusion, CpuMatmulFp16KernelCreator)
 }  // namespace mindspore::kernel
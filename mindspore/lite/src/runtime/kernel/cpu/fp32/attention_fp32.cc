@@ -0,0 +1,410 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/cpu/fp32/attention_fp32.h"
+#include "schema/model_generated.h"
+#include "src/runtime/kernel_registry.h"
+#include "include/errorcode.h"
+#include "nnacl/fp32/flash_attention_fp32.h"
+#include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/pack_fp32.h"
+
+using mindspore::kernel::KERNEL_ARCH;
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_MEMORY_FAILED;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_Attention;
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kAttentionInputSize = 11;
+constexpr size_t kAttentionWithMaskInputSize = 12;
+constexpr size_t kInputQIndex = 0;
+constexpr size_t kInputKIndex = 1;
+constexpr size_t kInputVIndex = 2;
+constexpr size_t kWeightQIndex = 3;
+constexpr size_t kBiasQIndex = 7;
+constexpr size_t kMaskIndex = 11;
+constexpr int kWeightShapeSize = 2;
+constexpr int kInputShapeSize = 3;
+}  // namespace
+
+AttentionCPUKernel::~AttentionCPUKernel() { FreeProjections(); }
+
+void AttentionCPUKernel::InitGlobalVariable() {
+#ifdef ENABLE_AVX
+  row_tile_ = C6NUM;
+  col_tile_ = C16NUM;
+  pack_lhs_func_ = RowMajor2Col6Major;
+  pack_rhs_func_ = RowMajor2Row16Major;
+#elif defined(ENABLE_ARM32)
+  row_tile_ = C12NUM;
+  col_tile_ = C4NUM;
+  pack_lhs_func_ = RowMajor2Col12Major;
+  pack_rhs_func_ = RowMajor2Row4Major;
+#elif defined(ENABLE_SSE)
+  row_tile_ = C4NUM;
+  col_tile_ = C8NUM;
+  pack_lhs_func_ = RowMajor2Col4Major;
+  pack_rhs_func_ = RowMajor2Row8Major;
+#else
+  row_tile_ = C12NUM;
+  col_tile_ = C8NUM;
+  pack_lhs_func_ = RowMajor2Col12Major;
+  pack_rhs_func_ = RowMajor2Row8Major;
+#endif
+  data_size_ = sizeof(float);
+}
+
+void AttentionCPUKernel::FreeProjections() {
+  for (auto &projection : projections_) {
+    if (projection.packed_weight_ != nullptr) {
+      free(projection.packed_weight_);
+      projection.packed_weight_ = nullptr;
+    }
+    if (projection.packed_bias_ != nullptr) {
+      free(projection.packed_bias_);
+      projection.packed_bias_ = nullptr;
+    }
+  }
+}
+
+int AttentionCPUKernel::PackProjection(int index) {
+  auto weight = in_tensors_.at(kWeightQIndex + index);
+  auto bias = in_tensors_.at(kBiasQIndex + index);
+  if (weight->data_type() != kNumberTypeFloat32 || bias->data_type() != kNumberTypeFloat32) {
+    MS_LOG(ERROR) << "Attention weight and bias should be float32.";
+    return RET_ERROR;
+  }
+  auto &projection = projections_[index];
+  size_t weight_size = projection.deep_ * projection.col_align_ * sizeof(float);
+  projection.packed_weight_ = malloc(weight_size);
+  if (projection.packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc attention packed weight failed.";
+    return RET_MEMORY_FAILED;
+  }
+  memset(projection.packed_weight_, 0, weight_size);
+  pack_rhs_func_(reinterpret_cast<float *>(weight->data()), reinterpret_cast<float *>(projection.packed_weight_),
+                 projection.deep_, projection.col_);
+
+  projection.packed_bias_ = malloc(projection.col_align_ * sizeof(float));
+  if (projection.packed_bias_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc attention packed bias failed.";
+    return RET_MEMORY_FAILED;
+  }
+  memset(projection.packed_bias_, 0, projection.col_align_ * sizeof(float));
+  memcpy(projection.packed_bias_, bias->data(), projection.col_ * sizeof(float));
+  return RET_OK;
+}
+
+int AttentionCPUKernel::Prepare() {
+  CHECK_LESS_RETURN(in_tensors_.size(), kAttentionInputSize);
+  CHECK_LESS_RETURN(out_tensors_.size(), 1);
+  if (in_tensors_.size() > kAttentionWithMaskInputSize) {
+    MS_LOG(ERROR) << "Attention with relative position is not supported, inputs size: " << in_tensors_.size();
+    return RET_ERROR;
+  }
+  if (param_->head_num_ <= 0 || param_->head_size_ <= 0) {
+    MS_LOG(ERROR) << "Attention head_num " << param_->head_num_ << " and head_size " << param_->head_size_
+                  << " are invalid, the model should be converted again.";
+    return RET_ERROR;
+  }
+  InitGlobalVariable();
+
+  int hidden = param_->head_num_ * param_->head_size_;
+  for (int i = 0; i < kProjectionNum; ++i) {
+    auto weight = in_tensors_.at(kWeightQIndex + i);
+    auto bias = in_tensors_.at(kBiasQIndex + i);
+    CHECK_NULL_RETURN(weight);
+    CHECK_NULL_RETURN(bias);
+    if (!weight->IsConst() || !bias->IsConst() || weight->shape().size() != kWeightShapeSize ||
+        bias->ElementsNum() != weight->shape().at(1)) {
+      MS_LOG(ERROR) << "Attention weight " << i << " should be a const [in, out] matrix with a const bias.";
+      return RET_ERROR;
+    }
+    auto &projection = projections_[i];
+    projection.deep_ = weight->shape().at(0);
+    projection.col_ = weight->shape().at(1);
+    projection.col_align_ = UP_ROUND(projection.col_, col_tile_);
+    if ((i != kProjectionO && projection.col_ != hidden) || (i == kProjectionO && projection.deep_ != hidden)) {
+      MS_LOG(ERROR) << "Attention weight " << i << " does not match head_num * head_size: " << hidden;
+      return RET_ERROR;
+    }
+    auto ret = PackProjection(i);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Pack attention projection " << i << " failed.";
+      return ret;
+    }
+  }
+  if (!InferShapeDone()) {
+    return RET_OK;
+  }
+  return ReSize();
+}
+
+int AttentionCPUKernel::CheckInputs() {
+  auto q_shape = in_tensors_.at(kInputQIndex)->shape();
+  auto k_shape = in_tensors_.at(kInputKIndex)->shape();
+  auto v_shape = in_tensors_.at(kInputVIndex)->shape();
+  if (q_shape.size() < kWeightShapeSize || q_shape.size() > kInputShapeSize || k_shape.size() != q_shape.size() ||
+      v_shape.size() != q_shape.size()) {
+    MS_LOG(ERROR) << "Attention q/k/v should all be [batch, seq, d_model] or [seq, d_model].";
+    return RET_ERROR;
+  }
+  bool has_batch = q_shape.size() == kInputShapeSize;
+  param_->batch_ = has_batch ? q_shape.at(0) : 1;
+  param_->q_seq_ = q_shape.at(q_shape.size() - C2NUM);
+  param_->kv_seq_ = k_shape.at(k_shape.size() - C2NUM);
+  param_->d_model_ = q_shape.back();
+  param_->hidden_ = param_->head_num_ * param_->head_size_;
+  if ((has_batch && (k_shape.at(0) != param_->batch_ || v_shape.at(0) != param_->batch_)) ||
+      v_shape.at(v_shape.size() - C2NUM) != param_->kv_seq_) {
+    MS_LOG(ERROR) << "Attention k/v batch or sequence does not match.";
+    return RET_ERROR;
+  }
+  if (q_shape.back() != projections_[kProjectionQ].deep_ || k_shape.back() != projections_[kProjectionK].deep_ ||
+      v_shape.back() != projections_[kProjectionV].deep_) {
+    MS_LOG(ERROR) << "Attention q/k/v does not match their weights.";
+    return RET_ERROR;
+  }
+  if (param_->batch_ <= 0 || param_->q_seq_ <= 0 || param_->kv_seq_ <= 0) {
+    MS_LOG(ERROR) << "Attention q/k/v is empty.";
+    return RET_ERROR;
+  }
+
+  param_->mask_batch_stride_ = 0;
+  param_->mask_row_stride_ = 0;
+  if (in_tensors_.size() == kAttentionWithMaskInputSize) {
+    // mask is [batch, q_seq, kv_seq], [batch, kv_seq], [q_seq, kv_seq] or [kv_seq]
+    int mask_num = in_tensors_.at(kMaskIndex)->ElementsNum();
+    int q_kv = param_->q_seq_ * param_->kv_seq_;
+    if (mask_num == param_->batch_ * q_kv) {
+      param_->mask_batch_stride_ = q_kv;
+      param_->mask_row_stride_ = param_->kv_seq_;
+    } else if (mask_num == param_->batch_ * param_->kv_seq_) {
+      param_->mask_batch_stride_ = param_->kv_seq_;
+    } else if (mask_num == q_kv) {
+      param_->mask_row_stride_ = param_->kv_seq_;
+    } else if (mask_num != param_->kv_seq_) {
+      MS_LOG(ERROR) << "Attention mask with " << mask_num << " elements can not be broadcast to [" << param_->batch_
+                    << ", " << param_->q_seq_ << ", " << param_->kv_seq_ << "].";
+      return RET_ERROR;
+    }
+  }
+  return RET_OK;
+}
+
+int AttentionCPUKernel::ReSize() {
+  auto ret = CheckInputs();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  param_->q_tile_ = MSMIN(C32NUM, param_->q_seq_);
+  param_->kv_tile_ = MSMIN(C64NUM, param_->kv_seq_);
+  q_tile_num_ = UP_DIV(param_->q_seq_, param_->q_tile_);
+  attention_units_ = param_->batch_ * param_->head_num_ * q_tile_num_;
+  attention_buffer_stride_ = FlashAttentionBufferSize(param_);
+  return RET_OK;
+}
+
+int AttentionCPUKernel::MallocRunBuffer() {
+  auto allocator = ms_context_->allocator;
+  size_t q_size = static_cast<size_t>(param_->batch_) * param_->q_seq_ * param_->hidden_ * data_size_;
+  size_t kv_size = static_cast<size_t>(param_->batch_) * param_->kv_seq_ * param_->hidden_ * data_size_;
+  q_data_ = allocator->Malloc(q_size);
+  k_data_ = allocator->Malloc(kv_size);
+  v_data_ = allocator->Malloc(kv_size);
+  context_data_ = allocator->Malloc(q_size);
+
+  int max_rows = param_->batch_ * MSMAX(param_->q_seq_, param_->kv_seq_);
+  int max_deep = param_->hidden_;
+  for (int i = 0; i < kProjectionNum; ++i) {
+    max_deep = MSMAX(max_deep, projections_[i].deep_);
+  }
+  pack_buffer_ = allocator->Malloc(static_cast<size_t>(UP_ROUND(max_rows, row_tile_)) * max_deep * data_size_);
+  attention_buffer_ = allocator->Malloc(op_parameter_->thread_num_ * attention_buffer_stride_ * sizeof(float));
+  if (q_data_ == nullptr || k_data_ == nullptr || v_data_ == nullptr || context_data_ == nullptr ||
+      pack_buffer_ == nullptr || attention_buffer_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc attention run buffer failed.";
+    FreeRunBuffer();
+    return RET_MEMORY_FAILED;
+  }
+  return RET_OK;
+}
+
+void AttentionCPUKernel::FreeRunBuffer() {
+  auto allocator = ms_context_->allocator;
+  void **buffers[] = {&q_data_, &k_data_, &v_data_, &context_data_, &pack_buffer_, &attention_buffer_};
+  for (auto buffer : buffers) {
+    if (*buffer != nullptr) {
+      allocator->Free(*buffer);
+      *buffer = nullptr;
+    }
+  }
+  if (mask_need_free_ && mask_data_ != nullptr) {
+    allocator->Free(mask_data_);
+  }
+  mask_data_ = nullptr;
+  mask_need_free_ = false;
+}
+
+int AttentionCPUKernel::PrepareMask() {
+  mask_data_ = nullptr;
+  mask_need_free_ = false;
+  if (in_tensors_.size() != kAttentionWithMaskInputSize) {
+    return RET_OK;
+  }
+  auto mask = in_tensors_.at(kMaskIndex);
+  CHECK_NULL_RETURN(mask->data());
+  if (mask->data_type() == kNumberTypeFloat32) {
+    mask_data_ = mask->data();
+    return RET_OK;
+  }
+  int mask_num = mask->ElementsNum();
+  auto mask_data = reinterpret_cast<float *>(ms_context_->allocator->Malloc(mask_num * sizeof(float)));
+  if (mask_data == nullptr) {
+    MS_LOG(ERROR) << "Malloc attention mask failed.";
+    return RET_MEMORY_FAILED;
+  }
+  mask_data_ = mask_data;
+  mask_need_free_ = true;
+  if (mask->data_type() == kNumberTypeInt32) {
+    auto src = reinterpret_cast<int32_t *>(mask->data());
+    for (int i = 0; i < mask_num; ++i) {
+      mask_data[i] = static_cast<float>(src[i]);
+    }
+  } else if (mask->data_type() == kNumberTypeBool) {
+    auto src = reinterpret_cast<bool *>(mask->data());
+    for (int i = 0; i < mask_num; ++i) {
+      mask_data[i] = src[i] ? 1.0f : 0.0f;
+    }
+  } else {
+    MS_LOG(ERROR) << "Attention mask data type " << mask->data_type() << " is not supported.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int AttentionCPUKernel::ProjectImpl(const void *src, void *dst, void *pack_buffer, const Projection &projection,
+                                    int row_start, int row_num) {
+  int deep = projection.deep_;
+  auto src_data = reinterpret_cast<const float *>(src) + static_cast<size_t>(row_start) * deep;
+  auto pack_data = reinterpret_cast<float *>(pack_buffer) + static_cast<size_t>(row_start) * deep;
+  auto dst_data = reinterpret_cast<float *>(dst) + static_cast<size_t>(row_start) * projection.col_;
+  pack_lhs_func_(src_data, pack_data, row_num, deep);
+  MatMulOpt(pack_data, reinterpret_cast<float *>(projection.packed_weight_), dst_data,
+            reinterpret_cast<float *>(projection.packed_bias_), ActType_No, deep, row_num, projection.col_,
+            projection.col_, OutType_Nhwc);
+  return RET_OK;
+}
+
+int AttentionProjectRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<AttentionCPUKernel *>(cdata);
+  auto ret = kernel->DoProject(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "DoProject error task_id: " << task_id << ", ret: " << ret;
+  }
+  return ret;
+}
+
+int AttentionCPUKernel::DoProject(int task_id) {
+  int row_start = task_id * project_task_stride_;
+  int row_num = MSMIN(project_task_stride_, project_rows_ - row_start);
+  if (row_num <= 0) {
+    return RET_OK;
+  }
+  return ProjectImpl(project_src_, project_dst_, pack_buffer_, *project_, row_start, row_num);
+}
+
+int AttentionCPUKernel::Project(const void *src, void *dst, const Projection &projection, int rows) {
+  CHECK_NULL_RETURN(src);
+  CHECK_NULL_RETURN(dst);
+  project_src_ = src;
+  project_dst_ = dst;
+  project_ = &projection;
+  project_rows_ = rows;
+  // every task packs and computes whole row tiles.
+  project_task_stride_ = UP_DIV(UP_DIV(rows, row_tile_), op_parameter_->thread_num_) * row_tile_;
+  return ParallelLaunch(this->ms_context_, AttentionProjectRun, this, op_parameter_->thread_num_);
+}
+
+void AttentionCPUKernel::AttentionImpl(int batch, int head, int q_start, void *buffer) {
+  FlashAttentionTile(reinterpret_cast<float *>(q_data_), reinterpret_cast<float *>(k_data_),
+                     reinterpret_cast<float *>(v_data_), reinterpret_cast<float *>(mask_data_),
+                     reinterpret_cast<float *>(context_data_), reinterpret_cast<float *>(buffer), param_, batch, head,
+                     q_start);
+}
+
+int AttentionRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  CHECK_NULL_RETURN(cdata);
+  auto kernel = reinterpret_cast<AttentionCPUKernel *>(cdata);
+  auto ret = kernel->DoAttention(task_id);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "DoAttention error task_id: " << task_id << ", ret: " << ret;
+  }
+  return ret;
+}
+
+int AttentionCPUKernel::DoAttention(int task_id) {
+  int stride = UP_DIV(attention_units_, op_parameter_->thread_num_);
+  int start = task_id * stride;
+  int end = MSMIN(start + stride, attention_units_);
+  auto buffer = reinterpret_cast<float *>(attention_buffer_) + task_id * attention_buffer_stride_;
+  for (int unit = start; unit < end; ++unit) {
+    int q_tile = unit % q_tile_num_;
+    int head = (unit / q_tile_num_) % param_->head_num_;
+    int batch = unit / (q_tile_num_ * param_->head_num_);
+    AttentionImpl(batch, head, q_tile * param_->q_tile_, buffer);
+  }
+  return RET_OK;
+}
+
+int AttentionCPUKernel::Run() {
+  auto ret = MallocRunBuffer();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = PrepareMask();
+  if (ret == RET_OK) {
+    ret = Project(in_tensors_.at(kInputQIndex)->data(), q_data_, projections_[kProjectionQ],
+                  param_->batch_ * param_->q_seq_);
+  }
+  if (ret == RET_OK) {
+    ret = Project(in_tensors_.at(kInputKIndex)->data(), k_data_, projections_[kProjectionK],
+                  param_->batch_ * param_->kv_seq_);
+  }
+  if (ret == RET_OK) {
+    ret = Project(in_tensors_.at(kInputVIndex)->data(), v_data_, projections_[kProjectionV],
+                  param_->batch_ * param_->kv_seq_);
+  }
+  if (ret == RET_OK) {
+    ret = ParallelLaunch(this->ms_context_, AttentionRun, this, op_parameter_->thread_num_);
+  }
+  if (ret == RET_OK) {
+    ret = Project(context_data_, out_tensors_.front()->data(), projections_[kProjectionO],
+                  param_->batch_ * param_->q_seq_);
+  }
+  FreeRunBuffer();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Attention run failed.";
+  }
+  return ret;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_Attention, LiteKernelCreator<AttentionCPUKernel>)
+}  // namespace mindspore::kernel
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
+
+#include <vector>
+#include "src/runtime/lite_kernel.h"
+#include "nnacl/attention_parameter.h"
+
+namespace mindspore::kernel {
+// inputs: 0:Q 1:K 2:V 3:WQ 4:WK 5:WV 6:WO 7:BQ 8:BK 9:BV 10:BO 11:MASK(optional)
+// Q/K/V are [batch, seq, d_model], weights are [in, out] and the mask is broadcast to [batch, q_seq, kv_seq].
+// Attention of each head is computed tile by tile with online softmax, the [q_seq, kv_seq] scores are never stored.
+class AttentionCPUKernel : public LiteKernel {
+ public:
+  AttentionCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                     const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx)
+      : LiteKernel(parameter, inputs, outputs, ctx) {
+    param_ = reinterpret_cast<AttentionParameter *>(op_parameter_);
+  }
+  ~AttentionCPUKernel() override;
+
+  int Prepare() override;
+  int ReSize() override;
+  int Run() override;
+
+  int DoProject(int task_id);
+  int DoAttention(int task_id);
+
+ protected:
+  enum ProjectionIndex { kProjectionQ = 0, kProjectionK, kProjectionV, kProjectionO, kProjectionNum };
+  struct Projection {
+    void *packed_weight_ = nullptr;
+    void *packed_bias_ = nullptr;
+    int deep_ = 0;
+    int col_ = 0;
+    int col_align_ = 0;
+  };
+
+  virtual void InitGlobalVariable();
+  virtual int PackProjection(int index);
+  virtual int ProjectImpl(const void *src, void *dst, void *pack_buffer, const Projection &projection, int row_start,
+                          int row_num);
+  virtual void AttentionImpl(int batch, int head, int q_start, void *buffer);
+  virtual int PrepareMask();
+
+  int CheckInputs();
+  int Project(const void *src, void *dst, const Projection &projection, int rows);
+  int MallocRunBuffer();
+  void FreeRunBuffer();
+  void FreeProjections();
+
+  AttentionParameter *param_ = nullptr;
+  size_t data_size_ = sizeof(float);
+  int row_tile_ = C12NUM;
+  int col_tile_ = C8NUM;
+  void (*pack_lhs_func_)(const float *src_ptr, float *dst_ptr, int row, int col) = nullptr;
+  void (*pack_rhs_func_)(const float *src_ptr, float *dst_ptr, int row, int col) = nullptr;
+  Projection projections_[kProjectionNum];
+  // args of the projection being run
+  const void *project_src_ = nullptr;
+  void *project_dst_ = nullptr;
+  const Projection *project_ = nullptr;
+  int project_rows_ = 0;
+  int project_task_stride_ = 0;
+  // run buffers
+  void *q_data_ = nullptr;
+  void *k_data_ = nullptr;
+  void *v_data_ = nullptr;
+  void *context_data_ = nullptr;
+  void *pack_buffer_ = nullptr;
+  void *mask_data_ = nullptr;
+  bool mask_need_free_ = false;
+  void *attention_buffer_ = nullptr;
+  size_t attention_buffer_stride_ = 0;
+  int q_tile_num_ = 0;
+  int attention_units_ = 0;
+};
+}  // namespace mindspore::kernel
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_ATTENTION_FP32_H_
@@ -93,6 +93,43 @@ int Convolution1x1CPUKernel::InitConv1x1Param() {
     memset(input_ptr_, 0, matmul_param_->row_ * matmul_param_->deep_ * sizeof(float));
   }
 
+  return InitJitGemm();
+}
+
+int Convolution1x1CPUKernel::InitJitGemm() {
+  use_jit_ = false;
+#if defined(ENABLE_AVX) && defined(__linux__)
+  if (!JitGemmFp32::IsSupported() || out_tensors_[0]->format() == NC4HW4) {
+    return RET_OK;
+  }
+  JitGemmParam param;
+  param.deep = matmul_param_->deep_;
+  param.a_stride = matmul_param_->deep_;
+  param.c_stride = matmul_param_->col_;
+  param.b_panel = col_tile_;
+  param.col_align = matmul_param_->col_align_;
+  param.has_bias = bias_data_ != nullptr;
+  param.act_type = matmul_param_->act_type_;
+  std::vector<int> row_nums;
+  std::vector<int> col_splits;
+  if (multi_thread_by_hw_) {
+    for (int task_id = 0; task_id < thread_count_; ++task_id) {
+      row_nums.push_back(MSMIN(thread_stride_, matmul_param_->row_ - task_id * thread_stride_));
+    }
+    col_splits.push_back(0);
+  } else {
+    row_nums.push_back(matmul_param_->row_);
+    for (int task_id = 0; task_id < thread_count_ && task_id * thread_stride_ < matmul_param_->col_; ++task_id) {
+      col_splits.push_back(task_id * thread_stride_);
+    }
+  }
+  auto ret = jit_gemm_.Init(param, row_nums, col_splits, matmul_param_->col_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Conv1x1 init jit gemm failed.";
+    return ret;
+  }
+  use_jit_ = true;
+#endif
   return RET_OK;
 }
 
@@ -152,6 +189,13 @@ int Convolution1x1CPUKernel::DoConv1x1(int task_id) {
     return RET_OK;
   }
   CHECK_NULL_RETURN(out_tensors()[0]);
+#if defined(ENABLE_AVX) && defined(__linux__)
+  if (use_jit_) {
+    return jit_gemm_.Run(input_ptr_, reinterpret_cast<float *>(packed_weight_), output_ptr_,
+                         reinterpret_cast<float *>(bias_data_), matmul_param_->row_, task_id * thread_stride_,
+                         task_id * thread_stride_ + cur_oc);
+  }
+#endif
   auto bias = (bias_data_ == nullptr) ? nullptr : reinterpret_cast<float *>(bias_data_) + thread_stride_ * task_id;
   if (out_tensors()[0]->format() == NC4HW4) {
     MatMulOpt(pack_input_, reinterpret_cast<float *>(packed_weight_) + task_id * thread_stride_ * matmul_param_->deep_,
@@ -183,6 +227,13 @@ int Convolution1x1CPUKernel::DoConv1x1Hw(int task_id) {
   }
 
   float *thread_input_ptr = input_ptr_ + task_id * thread_stride_ * matmul_param_->deep_;
+#if defined(ENABLE_AVX) && defined(__linux__)
+  if (use_jit_) {
+    return jit_gemm_.Run(thread_input_ptr, reinterpret_cast<float *>(packed_weight_),
+                         output_ptr_ + task_id * thread_stride_ * matmul_param_->col_,
+                         reinterpret_cast<float *>(bias_data_), cur_hw_, 0, matmul_param_->col_);
+  }
+#endif
   float *thread_pack_input = pack_input_ + task_id * row_tile_ * matmul_param_->deep_;
   float *thread_output_ptr = nullptr;
   if (out_tensors()[0]->format() != NC4HW4) {
@@ -229,12 +280,14 @@ int Convolution1x1CPUKernel::Run() {
   auto src_out = reinterpret_cast<float *>(out_tensors_[0]->data());
   CHECK_NULL_RETURN(src_in);
   CHECK_NULL_RETURN(src_out);
-  int pack_input_size = multi_thread_by_hw_ ? (thread_count_ * row_tile_ * matmul_param_->deep_)
-                                            : (matmul_param_->row_align_ * matmul_param_->deep_);
-  pack_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(pack_input_size * sizeof(float)));
-  if (pack_input_ == nullptr) {
-    MS_LOG(ERROR) << "Conv1x1 Malloc pack_input_ error!";
-    return RET_MEMORY_FAILED;
+  if (!use_jit_) {
+    int pack_input_size = multi_thread_by_hw_ ? (thread_count_ * row_tile_ * matmul_param_->deep_)
+                                              : (matmul_param_->row_align_ * matmul_param_->deep_);
+    pack_input_ = reinterpret_cast<float *>(ctx_->allocator->Malloc(pack_input_size * sizeof(float)));
+    if (pack_input_ == nullptr) {
+      MS_LOG(ERROR) << "Conv1x1 Malloc pack_input_ error!";
+      return RET_MEMORY_FAILED;
+    }
   }
   if (RepackWeight() != RET_OK) {
     MS_LOG(ERROR) << "Repack weight failed.";
@@ -253,7 +306,9 @@ int Convolution1x1CPUKernel::Run() {
     if (multi_thread_by_hw_) {
       ret = ParallelLaunch(this->ms_context_, Convolution1x1RunHw, this, thread_count_);
     } else {
-      PackMatmulInput(input_ptr_, pack_input_, matmul_param_->row_, matmul_param_->deep_);
+      if (!use_jit_) {
+        PackMatmulInput(input_ptr_, pack_input_, matmul_param_->row_, matmul_param_->deep_);
+      }
       ret = ParallelLaunch(this->ms_context_, Convolution1x1Run, this, thread_count_);
     }
     if (ret != RET_OK) {
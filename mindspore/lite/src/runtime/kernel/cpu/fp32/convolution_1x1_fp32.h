@@ -28,6 +28,9 @@
 #include "nnacl/fp32/common_func_fp32.h"
 #include "nnacl/matmul_parameter.h"
 #include "nnacl/fp32/matmul_fp32.h"
+#if defined(ENABLE_AVX) && defined(__linux__)
+#include "src/runtime/kernel/cpu/fp32/jit_gemm_x86_fp32.h"
+#endif
 
 namespace mindspore::kernel {
 class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
@@ -52,6 +55,7 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
   void PackWeight() override;
   void FreeTmpBuffer();
   void PackMatmulInput(const float *src_ptr, float *dst_ptr, int row, int col) const;
+  int InitJitGemm();
 
  private:
   MatMulParameter *matmul_param_ = nullptr;
@@ -64,6 +68,10 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
   float *output_ptr_ = nullptr;
   int row_tile_ = 0;
   int col_tile_ = 0;
+  bool use_jit_ = false;  // the nhwc input is multiplied in place by generated kernels, without packing it
+#if defined(ENABLE_AVX) && defined(__linux__)
+  JitGemmFp32 jit_gemm_;
+#endif
 };
 }  // namespace mindspore::kernel
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_CONVOLUTION_1X1_FP32_H_
@@ -19,6 +19,7 @@
 #include "src/runtime/kernel/cpu/fp32/convolution_fp32.h"
 #include "src/runtime/kernel/cpu/fp32/convolution_1x1_fp32.h"
 #include "src/runtime/kernel/cpu/fp32/convolution_winograd_fp32.h"
+#include "src/runtime/kernel/cpu/fp32/winograd_unit_selector_fp32.h"
 #include "src/runtime/kernel/cpu/fp32/convolution_depthwise_fp32.h"
 #include "src/runtime/kernel/cpu/fp32/convolution_depthwise_slidewindow_fp32.h"
 #include "src/runtime/kernel/cpu/fp32/convolution_depthwise_slidewindow_x86_fp32.h"
@@ -218,11 +219,13 @@ kernel::LiteKernel *ConvolutionDelegateCPUKernel::CpuConvFp32NHWCKernelSelect()
   kernel::LiteKernel *kernel = nullptr;
   auto conv_param = reinterpret_cast<ConvParameter *>(op_parameter_);
 
-  int out_unit;
-  if (CheckIfUseWinograd(&out_unit, conv_param)) {
-    kernel = new (std::nothrow) kernel::ConvolutionWinogradCPUKernel(
-      op_parameter_, in_tensors_, out_tensors_, static_cast<const lite::InnerContext *>(this->ms_context_), out_unit,
-      origin_weight_, origin_bias_);
+  if (CheckWinogradConvShape(conv_param)) {
+    int out_unit = WinogradUnitSelector::GetInstance()->Select(conv_param);
+    if (out_unit > 1) {
+      kernel = new (std::nothrow) kernel::ConvolutionWinogradCPUKernel(
+        op_parameter_, in_tensors_, out_tensors_, static_cast<const lite::InnerContext *>(this->ms_context_), out_unit,
+        origin_weight_, origin_bias_);
+    }
   }
 
 #ifdef ENABLE_AVX
@@ -29,6 +29,15 @@
 
 #if defined(ENABLE_AVX)
 #include "src/runtime/kernel/cpu/fp32/matmul_fp32_avx.h"
+#include "src/runtime/kernel/cpu/fp32/matmul_fp32_bf16.h"
+#endif
+
+#if defined(ENABLE_AVX) && defined(ENABLE_SPARSE_COMPUTE)
+#include "src/runtime/kernel/cpu/fp32_sparse/matmul_sparse_x86_fp32.h"
+#endif
+
+#if defined(ENABLE_AVX) && defined(__linux__)
+#include "src/runtime/kernel/cpu/fp32/matmul_fp32_jit.h"
 #endif
 
 #if defined(ENABLE_SSE)
@@ -49,6 +58,28 @@ class FullconnectionCPUKernel : public LiteKernel {
   FullconnectionCPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
                           const std::vector<lite::Tensor *> &outputs, const mindspore::lite::InnerContext *ctx)
       : LiteKernel(parameter, inputs, outputs, ctx) {
+#if defined(ENABLE_AVX)
+    if (MatmulFp32BF16CPUKernel::IsBF16Weight(inputs)) {
+      matmul_base_ = new (std::nothrow) MatmulFp32BF16CPUKernel(parameter, inputs, outputs, ctx);
+    }
+#endif
+
+#if defined(ENABLE_AVX) && defined(ENABLE_SPARSE_COMPUTE)
+    if (matmul_base_ == nullptr) {
+      auto sparse_format =
+        MatmulSparseX86CPUKernel::SelectSparseFormat(inputs, reinterpret_cast<MatMulParameter *>(parameter));
+      if (sparse_format != SparseWeightFormat_None) {
+        matmul_base_ = new (std::nothrow) MatmulSparseX86CPUKernel(parameter, inputs, outputs, ctx, sparse_format);
+      }
+    }
+#endif
+
+#if defined(ENABLE_AVX) && defined(__linux__)
+    if (matmul_base_ == nullptr && MatmulFp32JitCPUKernel::IsSupported(parameter)) {
+      matmul_base_ = new (std::nothrow) MatmulFp32JitCPUKernel(parameter, inputs, outputs, ctx);
+    }
+#endif
+
 #if defined(ENABLE_AVX512)
     if (matmul_base_ == nullptr) {
       AVX512_HARDWARE_SELF_AWARENESS_BEGIN
@@ -0,0 +1,463 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(ENABLE_AVX) && defined(__linux__)
+#include "src/runtime/kernel/cpu/fp32/jit_gemm_x86_fp32.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <unordered_map>
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/common/log_adapter.h"
+#include "include/errorcode.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+namespace {
+constexpr int kJitGemmUnroll = 4;         // deep steps of the generated loop body, the deep tail is fully unrolled
+constexpr int kJitGemmMaxRow = C12NUM;    // rows of the largest tile
+constexpr size_t kJitGemmMaxFuncNum = 8192;  // bound of the process-wide cache, generated code is never released
+constexpr float kJitGemmRelu6 = 6.0f;
+
+// x86-64 general purpose registers of the System V calling convention used by the generated code.
+constexpr int kRax = 0;
+constexpr int kRcx = 1;  // bias
+constexpr int kRdx = 2;  // c
+constexpr int kRsi = 6;  // b
+constexpr int kRdi = 7;  // a
+
+// opcode maps and mandatory prefixes of the VEX/EVEX encoded instructions.
+constexpr uint8_t kMap0F = 1;
+constexpr uint8_t kMap0F38 = 2;
+constexpr uint8_t kPpNone = 0;
+constexpr uint8_t kPp66 = 1;
+
+constexpr uint8_t kOpMovupsLoad = 0x10;
+constexpr uint8_t kOpMovupsStore = 0x11;
+constexpr uint8_t kOpXorps = 0x57;
+constexpr uint8_t kOpPxord = 0xEF;
+constexpr uint8_t kOpMinps = 0x5D;
+constexpr uint8_t kOpMaxps = 0x5F;
+constexpr uint8_t kOpBroadcastss = 0x18;
+constexpr uint8_t kOpMaskmovpsStore = 0x2E;
+constexpr uint8_t kOpFmadd231ps = 0xB8;
+
+int JitGemmMaxRow(int simd, int vec_num) {
+  // accumulators + one register per vector of b + the broadcast of a, and 3 registers free for the epilogue
+  // constants (zero, six and the avx2 store mask) once b and a are no longer needed.
+  int reg_num = simd == C16NUM ? C32NUM : C16NUM;
+  int spare = MSMAX(vec_num + 1, C3NUM);
+  return MSMIN(kJitGemmMaxRow, (reg_num - spare) / vec_num);
+}
+
+class JitGemmCodeGen {
+ public:
+  explicit JitGemmCodeGen(const JitGemmTileKey &key) : key_(key), evex_(key.simd == C16NUM) {}
+  ~JitGemmCodeGen() = default;
+
+  const std::vector<uint8_t> &Generate() {
+    const int vec_num = UP_DIV(key_.col, key_.simd);
+    const int last_col = key_.col - (vec_num - 1) * key_.simd;
+    const int top = evex_ ? C32NUM - 1 : C16NUM - 1;
+    const int broadcast = top - vec_num;
+    auto acc = [vec_num](int r, int v) { return r * vec_num + v; };
+
+    for (int r = 0; r < key_.row; ++r) {
+      for (int v = 0; v < vec_num; ++v) {
+        if (key_.has_bias) {
+          VecMem(kMap0F, kPpNone, kOpMovupsLoad, acc(r, v), 0, kRcx, v * key_.simd * sizeof(float), VecBytes());
+        } else {
+          VecReg(kMap0F, evex_ ? kPp66 : kPpNone, evex_ ? kOpPxord : kOpXorps, acc(r, v), acc(r, v), acc(r, v));
+        }
+      }
+    }
+
+    auto deep_block = [&](int step) {
+      for (int k = 0; k < step; ++k) {
+        for (int v = 0; v < vec_num; ++v) {
+          VecMem(kMap0F, kPpNone, kOpMovupsLoad, top - v, 0, kRsi,
+                 (k * key_.b_stride + key_.b_offset[v]) * sizeof(float), VecBytes());
+        }
+        for (int r = 0; r < key_.row; ++r) {
+          VecMem(kMap0F38, kPp66, kOpBroadcastss, broadcast, 0, kRdi, (r * key_.a_stride + k) * sizeof(float),
+                 sizeof(float));
+          for (int v = 0; v < vec_num; ++v) {
+            VecReg(kMap0F38, kPp66, kOpFmadd231ps, acc(r, v), top - v, broadcast);
+          }
+        }
+      }
+    };
+    int loop_num = key_.deep / kJitGemmUnroll;
+    if (loop_num > 0) {
+      size_t loop_begin = 0;
+      if (loop_num > 1) {
+        MovEaxImm(loop_num);
+        loop_begin = code_.size();
+      }
+      deep_block(kJitGemmUnroll);
+      AddImm(kRdi, kJitGemmUnroll * sizeof(float));
+      AddImm(kRsi, kJitGemmUnroll * key_.b_stride * sizeof(float));
+      if (loop_num > 1) {
+        Emit({0xFF, 0xC8});  // dec eax
+        Emit({0x0F, 0x85});  // jnz loop_begin
+        Emit32(static_cast<int32_t>(loop_begin - (code_.size() + sizeof(int32_t))));
+      }
+    }
+    deep_block(key_.deep % kJitGemmUnroll);
+
+    if (key_.act_type == ActType_Relu || key_.act_type == ActType_Relu6) {
+      const int zero = top;
+      const int six = top - 1;
+      VecReg(kMap0F, evex_ ? kPp66 : kPpNone, evex_ ? kOpPxord : kOpXorps, zero, zero, zero);
+      if (key_.act_type == ActType_Relu6) {
+        VecRip(kMap0F38, kPp66, kOpBroadcastss, six, 0, &six_fixups_);
+      }
+      for (int i = 0; i < key_.row * vec_num; ++i) {
+        VecReg(kMap0F, kPpNone, kOpMaxps, i, i, zero);
+        if (key_.act_type == ActType_Relu6) {
+          VecReg(kMap0F, kPpNone, kOpMinps, i, i, six);
+        }
+      }
+    }
+
+    const bool tail = last_col < key_.simd;
+    const int mask = top - C2NUM;
+    if (tail && evex_) {
+      MovEaxImm((1 << last_col) - 1);
+      Emit({0xC5, 0xF8, 0x92, 0xC8});  // kmovw k1, eax
+    } else if (tail) {
+      // the table holds 8 all-ones lanes followed by 8 zero lanes, start last_col lanes before the zeros
+      VecRip(kMap0F, kPpNone, kOpMovupsLoad, mask, (key_.simd - last_col) * sizeof(float), &mask_fixups_);
+    }
+    for (int r = 0; r < key_.row; ++r) {
+      for (int v = 0; v < vec_num; ++v) {
+        int disp = (r * key_.c_stride + v * key_.simd) * sizeof(float);
+        if (!tail || v != vec_num - 1) {
+          VecMem(kMap0F, kPpNone, kOpMovupsStore, acc(r, v), 0, kRdx, disp, VecBytes());
+        } else if (evex_) {
+          VecMem(kMap0F, kPpNone, kOpMovupsStore, acc(r, v), 0, kRdx, disp, VecBytes(), 1);
+        } else {
+          VecMem(kMap0F38, kPp66, kOpMaskmovpsStore, acc(r, v), mask, kRdx, disp, 1);
+        }
+      }
+    }
+    Emit({0xC5, 0xF8, 0x77});  // vzeroupper
+    Emit({0xC3});              // ret
+    EmitData();
+    return code_;
+  }
+
+ private:
+  int VecBytes() const { return key_.simd * sizeof(float); }
+
+  void Emit(std::initializer_list<uint8_t> bytes) { code_.insert(code_.end(), bytes); }
+  void Emit32(int32_t value) {
+    auto bytes = reinterpret_cast<const uint8_t *>(&value);
+    code_.insert(code_.end(), bytes, bytes + sizeof(int32_t));
+  }
+
+  // VEX (ymm) or EVEX (zmm) prefix and opcode, rm_ext is bit 4 of a register rm operand.
+  void Prefix(uint8_t map, uint8_t pp, uint8_t opcode, int reg, int vvvv, int rm_low, int rm_ext, int mask) {
+    int not_reg3 = ((reg >> C3NUM) & 1) ^ 1;
+    int not_rm3 = ((rm_low >> C3NUM) & 1) ^ 1;
+    int not_vvvv = (~vvvv) & 0xF;
+    if (evex_) {
+      int not_reg4 = ((reg >> C4NUM) & 1) ^ 1;
+      int not_rm4 = rm_ext ^ 1;
+      int not_vvvv4 = ((vvvv >> C4NUM) & 1) ^ 1;
+      Emit({0x62, static_cast<uint8_t>((not_reg3 << C7NUM) | (not_rm4 << C6NUM) | (not_rm3 << C5NUM) |
+                                       (not_reg4 << C4NUM) | map),
+            static_cast<uint8_t>((not_vvvv << C3NUM) | (1 << C2NUM) | pp),
+            static_cast<uint8_t>((C2NUM << C5NUM) | (not_vvvv4 << C3NUM) | mask), opcode});
+    } else {
+      Emit({0xC4, static_cast<uint8_t>((not_reg3 << C7NUM) | (1 << C6NUM) | (not_rm3 << C5NUM) | map),
+            static_cast<uint8_t>((not_vvvv << C3NUM) | (1 << C2NUM) | pp), opcode});
+    }
+  }
+
+  void VecReg(uint8_t map, uint8_t pp, uint8_t opcode, int reg, int vvvv, int rm) {
+    Prefix(map, pp, opcode, reg, vvvv, rm, (rm >> C4NUM) & 1, 0);
+    Emit({static_cast<uint8_t>(0xC0 | ((reg & C7NUM) << C3NUM) | (rm & C7NUM))});
+  }
+
+  // [base + disp], n is the evex disp8 scale of the operand.
+  void VecMem(uint8_t map, uint8_t pp, uint8_t opcode, int reg, int vvvv, int base, int disp, int n, int mask = 0) {
+    Prefix(map, pp, opcode, reg, vvvv, base, 0, mask);
+    int scale = evex_ ? n : 1;
+    if (disp % scale == 0 && disp / scale >= SCHAR_MIN && disp / scale <= SCHAR_MAX) {
+      Emit({static_cast<uint8_t>(0x40 | ((reg & C7NUM) << C3NUM) | base), static_cast<uint8_t>(disp / scale)});
+    } else {
+      Emit({static_cast<uint8_t>(0x80 | ((reg & C7NUM) << C3NUM) | base)});
+      Emit32(disp);
+    }
+  }
+
+  // [rip + disp32] pointing at the constants placed after the code.
+  void VecRip(uint8_t map, uint8_t pp, uint8_t opcode, int reg, int offset,
+              std::vector<std::pair<size_t, int>> *fixups) {
+    Prefix(map, pp, opcode, reg, 0, 0, 0, 0);
+    Emit({static_cast<uint8_t>(((reg & C7NUM) << C3NUM) | C5NUM)});
+    fixups->emplace_back(code_.size(), offset);
+    Emit32(0);
+  }
+
+  void MovEaxImm(int32_t value) {
+    Emit({static_cast<uint8_t>(0xB8 + kRax)});
+    Emit32(value);
+  }
+
+  void AddImm(int reg, int32_t value) {
+    Emit({0x48, 0x81, static_cast<uint8_t>(0xC0 | reg)});
+    Emit32(value);
+  }
+
+  void EmitData() {
+    while (code_.size() % sizeof(float) != 0) {
+      Emit({0xCC});
+    }
+    auto patch = [this](const std::vector<std::pair<size_t, int>> &fixups, size_t data) {
+      for (auto &fixup : fixups) {
+        auto disp = static_cast<int32_t>(data + fixup.second - (fixup.first + sizeof(int32_t)));
+        memcpy(code_.data() + fixup.first, &disp, sizeof(int32_t));
+      }
+    };
+    if (!six_fixups_.empty()) {
+      patch(six_fixups_, code_.size());
+      int32_t six;
+      memcpy(&six, &kJitGemmRelu6, sizeof(float));
+      Emit32(six);
+    }
+    if (!mask_fixups_.empty()) {
+      patch(mask_fixups_, code_.size());
+      for (int i = 0; i < C16NUM; ++i) {
+        Emit32(i < C8NUM ? -1 : 0);
+      }
+    }
+  }
+
+  JitGemmTileKey key_;
+  bool evex_ = false;
+  std::vector<uint8_t> code_;
+  std::vector<std::pair<size_t, int>> six_fixups_;
+  std::vector<std::pair<size_t, int>> mask_fixups_;
+};
+
+void *MapExecutable(const std::vector<uint8_t> &code) {
+  auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t size = UP_ROUND(code.size(), page);
+  void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (addr == MAP_FAILED) {
+    return nullptr;
+  }
+  memcpy(addr, code.data(), code.size());
+  if (mprotect(addr, size, PROT_READ | PROT_EXEC) != 0) {
+    (void)munmap(addr, size);
+    return nullptr;
+  }
+  return addr;
+}
+
+class JitGemmCache {
+ public:
+  static JitGemmCache *GetInstance() {
+    static JitGemmCache instance;
+    return &instance;
+  }
+
+  JitGemmTileFunc Get(const JitGemmTileKey &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = funcs_.find(key);
+    if (iter != funcs_.end()) {
+      return iter->second;
+    }
+    if (funcs_.size() >= kJitGemmMaxFuncNum) {
+      MS_LOG(ERROR) << "too many jit gemm kernels: " << funcs_.size();
+      return nullptr;
+    }
+    JitGemmCodeGen code_gen(key);
+    auto addr = MapExecutable(code_gen.Generate());
+    if (addr == nullptr) {
+      MS_LOG(ERROR) << "map executable memory for the jit gemm kernel failed.";
+      return nullptr;
+    }
+    auto func = reinterpret_cast<JitGemmTileFunc>(addr);
+    funcs_[key] = func;
+    return func;
+  }
+
+ private:
+  JitGemmCache() = default;
+  ~JitGemmCache() = default;
+
+  std::mutex mutex_;
+  std::unordered_map<JitGemmTileKey, JitGemmTileFunc, JitGemmTileKeyHash> funcs_;
+};
+}  // namespace
+
+bool JitGemmTileKey::operator==(const JitGemmTileKey &other) const {
+  return simd == other.simd && row == other.row && col == other.col && deep == other.deep &&
+         a_stride == other.a_stride && c_stride == other.c_stride && b_stride == other.b_stride &&
+         memcmp(b_offset, other.b_offset, sizeof(b_offset)) == 0 && has_bias == other.has_bias &&
+         act_type == other.act_type;
+}
+
+size_t JitGemmTileKeyHash::operator()(const JitGemmTileKey &key) const {
+  size_t seed = 0;
+  auto combine = [&seed](int value) { seed ^= std::hash<int>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2); };
+  combine(key.simd);
+  combine(key.row);
+  combine(key.col);
+  combine(key.deep);
+  combine(key.a_stride);
+  combine(key.c_stride);
+  combine(key.b_stride);
+  for (auto offset : key.b_offset) {
+    combine(offset);
+  }
+  combine(key.has_bias);
+  combine(key.act_type);
+  return seed;
+}
+
+bool JitGemmFp32::IsSupported() {
+  static const bool supported = []() {
+    if (!X86_Avx_Support()) {
+      return false;
+    }
+    // hardened systems may forbid executable anonymous memory, probe it once.
+    auto addr = MapExecutable({0xC3});
+    if (addr == nullptr) {
+      MS_LOG(WARNING) << "executable memory is not available, jit gemm is disabled.";
+      return false;
+    }
+    (void)munmap(addr, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+    return true;
+  }();
+  return supported;
+}
+
+int JitGemmFp32::SimdLanes() { return X86_Avx512_Support() ? C16NUM : C8NUM; }
+
+int JitGemmFp32::MaxTileCol() { return X86_Avx512_Support() ? C64NUM : C16NUM; }
+
+template <typename Fn>
+int JitGemmFp32::ForEachTile(int row, int start_col, int end_col, const Fn &fn) const {
+  const int simd = SimdLanes();
+  const int max_col = MaxTileCol();
+  const int panel = param_.b_panel;
+  auto panel_base = [this, panel](int col) { return (col / panel) * panel * param_.deep + col % panel; };
+  for (int col_index = start_col; col_index < end_col;) {
+    int col = MSMIN(max_col, end_col - col_index);
+    if (panel >= max_col) {
+      // a tile never crosses a panel, the last panel may be narrower than the others.
+      col = MSMIN(col, (col_index / panel + 1) * panel - col_index);
+    } else if (col_index % panel != 0 || param_.col_align % panel != 0) {
+      MS_LOG(ERROR) << "tiles of jit gemm must cover whole panels of b.";
+      return RET_ERROR;
+    }
+    JitGemmTileKey key;
+    key.simd = simd;
+    key.col = col;
+    key.deep = param_.deep;
+    key.a_stride = param_.a_stride;
+    key.c_stride = param_.c_stride;
+    key.b_stride = MSMIN(panel, param_.col_align - col_index / panel * panel);
+    int vec_num = UP_DIV(col, simd);
+    for (int v = 0; v < vec_num; ++v) {
+      key.b_offset[v] = panel_base(col_index + v * simd) - panel_base(col_index);
+    }
+    key.has_bias = param_.has_bias;
+    key.act_type = param_.act_type;
+    int max_row = JitGemmMaxRow(simd, vec_num);
+    for (int row_index = 0; row_index < row; row_index += max_row) {
+      key.row = MSMIN(max_row, row - row_index);
+      auto ret = fn(key, row_index, col_index, panel_base(col_index));
+      if (ret != RET_OK) {
+        return ret;
+      }
+    }
+    col_index += col;
+  }
+  return RET_OK;
+}
+
+JitGemmTileFunc JitGemmFp32::FindTileFunc(const JitGemmTileKey &key) const {
+  for (auto &tile_func : tile_funcs_) {
+    if (tile_func.first == key) {
+      return tile_func.second;
+    }
+  }
+  // a split that was not known when the kernels were prepared.
+  return JitGemmCache::GetInstance()->Get(key);
+}
+
+int JitGemmFp32::Init(const JitGemmParam &param, const std::vector<int> &row_nums, const std::vector<int> &col_splits,
+                      int col) {
+  MS_CHECK_TRUE_MSG(param.deep > 0 && param.b_panel > 0 && param.col_align >= col, RET_ERROR,
+                    "invalid jit gemm param.");
+  MS_CHECK_TRUE_MSG(static_cast<int64_t>(kJitGemmMaxRow) * MSMAX(param.a_stride, param.c_stride) < INT_MAX / C4NUM,
+                    RET_ERROR, "jit gemm stride is too large.");
+  MS_CHECK_TRUE_MSG(static_cast<int64_t>(param.col_align) * param.deep < INT_MAX / C4NUM, RET_ERROR,
+                    "jit gemm weight is too large.");
+  param_ = param;
+  tile_funcs_.clear();
+  auto prepare = [this](const JitGemmTileKey &key, int, int, int) {
+    for (auto &tile_func : tile_funcs_) {
+      if (tile_func.first == key) {
+        return RET_OK;
+      }
+    }
+    auto func = JitGemmCache::GetInstance()->Get(key);
+    if (func == nullptr) {
+      return RET_ERROR;
+    }
+    tile_funcs_.emplace_back(key, func);
+    return RET_OK;
+  };
+  for (auto row_num : row_nums) {
+    for (size_t i = 0; i < col_splits.size(); ++i) {
+      int end_col = i + 1 < col_splits.size() ? col_splits[i + 1] : col;
+      auto ret = ForEachTile(row_num, col_splits[i], end_col, prepare);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "generate jit gemm kernels failed.";
+        return ret;
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int JitGemmFp32::Run(const float *a, const float *b, float *c, const float *bias, int row, int start_col,
+                     int end_col) const {
+  auto compute = [&, this](const JitGemmTileKey &key, int row_index, int col_index, int b_index) {
+    auto func = FindTileFunc(key);
+    if (func == nullptr) {
+      return RET_ERROR;
+    }
+    func(a + row_index * param_.a_stride, b + b_index, c + row_index * param_.c_stride + col_index,
+         param_.has_bias ? bias + col_index : nullptr);
+    return RET_OK;
+  };
+  return ForEachTile(row, start_col, end_col, compute);
+}
+}  // namespace mindspore::kernel
+#endif
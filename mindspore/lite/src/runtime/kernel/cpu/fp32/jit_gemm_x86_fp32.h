@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_JIT_GEMM_X86_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_JIT_GEMM_X86_FP32_H_
+
+#if defined(ENABLE_AVX) && defined(__linux__)
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "nnacl/op_base.h"
+
+namespace mindspore::kernel {
+constexpr int kJitGemmMaxVecNum = 4;
+
+// c = act(a * b + bias) for one row x col tile, the shape, strides, bias and activation are baked into the code.
+using JitGemmTileFunc = void (*)(const float *a, const float *b, float *c, const float *bias);
+
+struct JitGemmParam {
+  int deep = 0;
+  int a_stride = 0;  // row stride of a in floats, a is row-major
+  int c_stride = 0;  // row stride of c in floats
+  // b is packed in panels of b_panel columns, each panel is [deep, panel width] and only the last one may be narrower.
+  int b_panel = 0;
+  int col_align = 0;  // packed columns of b
+  bool has_bias = false;
+  ActType act_type = ActType_No;
+};
+
+struct JitGemmTileKey {
+  int simd = 0;
+  int row = 0;
+  int col = 0;
+  int deep = 0;
+  int a_stride = 0;
+  int c_stride = 0;
+  int b_stride = 0;                     // floats between two deep rows of b
+  int b_offset[kJitGemmMaxVecNum] = {};  // offset of each vector of the tile from the b pointer, in floats
+  bool has_bias = false;
+  int act_type = 0;
+
+  bool operator==(const JitGemmTileKey &other) const;
+};
+
+struct JitGemmTileKeyHash {
+  size_t operator()(const JitGemmTileKey &key) const;
+};
+
+// GEMM built from micro-kernels generated at run time (AVX-512 when the cpu has it, AVX2 + FMA otherwise) for the
+// exact row/column tails, deep, strides, bias and activation of a matmul, instead of the fixed tiles of nnacl.
+// Generated code is cached process-wide by shape signature and shared by all kernels.
+class JitGemmFp32 {
+ public:
+  JitGemmFp32() = default;
+  ~JitGemmFp32() = default;
+
+  // the cpu supports the generated code and the process may map executable memory.
+  static bool IsSupported();
+  static int SimdLanes();
+  static int MaxTileCol();
+
+  // generates the tiles needed to compute row_num rows for each of row_nums, over the column ranges that start at
+  // col_splits and end at the next split or at col.
+  int Init(const JitGemmParam &param, const std::vector<int> &row_nums, const std::vector<int> &col_splits, int col);
+  // computes the columns [start_col, end_col) of row rows, c and bias point to column 0.
+  int Run(const float *a, const float *b, float *c, const float *bias, int row, int start_col, int end_col) const;
+
+ private:
+  template <typename Fn>
+  int ForEachTile(int row, int start_col, int end_col, const Fn &fn) const;
+  JitGemmTileFunc FindTileFunc(const JitGemmTileKey &key) const;
+
+  JitGemmParam param_;
+  std::vector<std::pair<JitGemmTileKey, JitGemmTileFunc>> tile_funcs_;
+};
+}  // namespace mindspore::kernel
+#endif
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_JIT_GEMM_X86_FP32_H_
@@ -16,6 +16,7 @@
 
 #include "src/runtime/kernel/cpu/fp32/matmul_fp32_base.h"
 #include <algorithm>
+#include "nnacl/fp32/matmul_epilogue_fp32.h"
 #include "nnacl/fp32/matmul_fp32.h"
 #include "nnacl/fp32/pack_fp32.h"
 #include "nnacl/fp32/pack_fp32_opt.h"
@@ -37,6 +38,23 @@ int MatmulRun(void *cdata, int task_id, float, float) {
     MS_LOG(ERROR) << "MatmulRun error task_id[" << task_id << "] error_code[" << error_code << "]";
     return RET_ERROR;
   }
+  // the epilogue follows on the same thread while the task's output is still in cache.
+  error_code = op->RunEpilogue(task_id);
+  if (error_code != RET_OK) {
+    MS_LOG(ERROR) << "MatmulRun epilogue error task_id[" << task_id << "] error_code[" << error_code << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int MatmulRowwiseEpilogueRun(void *cdata, int task_id, float, float) {
+  CHECK_NULL_RETURN(cdata);
+  auto op = reinterpret_cast<const MatmulFp32BaseCPUKernel *>(cdata);
+  auto error_code = op->RunRowwiseEpilogue(task_id);
+  if (error_code != RET_OK) {
+    MS_LOG(ERROR) << "MatmulRowwiseEpilogueRun error task_id[" << task_id << "] error_code[" << error_code << "]";
+    return RET_ERROR;
+  }
   return RET_OK;
 }
 
@@ -250,6 +268,8 @@ int MatmulFp32BaseCPUKernel::PackMatrixBImpl() {
   return RET_OK;
 }
 
+int MatmulFp32BaseCPUKernel::GetMatrixBPackSize() const { return b_batch_ * params_->col_align_ * params_->deep_; }
+
 void MatmulFp32BaseCPUKernel::FreePackedMatrixB() {
   if (matrix_b_.need_pack && !op_parameter_->is_train_session_ && matrix_b_.pack_ptr != nullptr) {
     ms_context_->allocator->Free(matrix_b_.pack_ptr);
@@ -257,8 +277,106 @@ void MatmulFp32BaseCPUKernel::FreePackedMatrixB() {
   matrix_b_.pack_ptr = nullptr;
 }
 
+size_t MatmulFp32BaseCPUKernel::MatmulInputNum() const {
+  return in_tensors_.size() - static_cast<size_t>(MatmulEpilogueInputNum(params_->epilogue_));
+}
+
+int MatmulFp32BaseCPUKernel::CheckEpilogueInputs() {
+  if (params_->epilogue_ == MatmulEpilogue_None) {
+    return RET_OK;
+  }
+  size_t index = MatmulInputNum();
+  auto out_num = out_tensors_.front()->ElementsNum();
+  if (params_->epilogue_ & MatmulEpilogue_ResidualAdd) {
+    MS_CHECK_TRUE_MSG(in_tensors_[index]->ElementsNum() == out_num, RET_ERROR,
+                      "the residual of the epilogue must have the output shape.");
+    ++index;
+  }
+  if (params_->epilogue_ & MatmulEpilogue_LayerNorm) {
+    MS_CHECK_TRUE_MSG(in_tensors_[index]->ElementsNum() == params_->col_ &&
+                        in_tensors_[index + 1]->ElementsNum() == params_->col_,
+                      RET_ERROR, "the gamma and beta of the epilogue must have one value per column.");
+  }
+  return RET_OK;
+}
+
+// the row-wise epilogues need whole rows, which only the column cutting does not give a task.
+bool MatmulFp32BaseCPUKernel::RunRowwiseEpilogueByTask() const {
+  return MatmulEpilogueHasRowwise(params_->epilogue_) && parallel_fun_ != &MatmulFp32BaseCPUKernel::ParallelRunByOC;
+}
+
+int MatmulFp32BaseCPUKernel::RunEpilogue(int task_id) const {
+  if (params_->epilogue_ == MatmulEpilogue_None) {
+    return RET_OK;
+  }
+  int start_row = 0;
+  int end_row = params_->batch * params_->row_;
+  int start_col = 0;
+  int end_col = params_->col_;
+  if (parallel_fun_ == &MatmulFp32BaseCPUKernel::ParallelRunByOC) {
+    start_col = split_points_[task_id];
+    if (task_id < (thread_count_ - 1)) {
+      end_col = MSMIN(split_points_[task_id + 1], params_->col_);
+    }
+  } else if (parallel_fun_ == &MatmulFp32BaseCPUKernel::ParallelRunByRow) {
+    start_row = split_points_[task_id];
+    end_row = task_id < (thread_count_ - 1) ? split_points_[task_id + 1] : row_num_;
+  } else {
+    start_row = task_id * batch_stride_ * params_->row_;
+    end_row = MSMIN(params_->batch, (task_id + 1) * batch_stride_) * params_->row_;
+  }
+  if (start_row >= end_row || start_col >= end_col) {
+    return RET_OK;
+  }
+
+  size_t input_index = MatmulInputNum();
+  const float *residual = nullptr;
+  if (params_->epilogue_ & MatmulEpilogue_ResidualAdd) {
+    residual = reinterpret_cast<const float *>(in_tensors_[input_index++]->data());
+    CHECK_NULL_RETURN(residual);
+    residual += start_row * params_->col_ + start_col;
+  }
+  float *c = output_data_ + start_row * col_step_ + start_col;
+  auto ret = MatmulEpilogueElementwise(c, residual, end_row - start_row, end_col - start_col, col_step_,
+                                       params_->col_, params_);
+  MS_CHECK_TRUE_MSG(ret == NNACL_OK, RET_ERROR, "matmul element-wise epilogue failed.");
+  if (!RunRowwiseEpilogueByTask()) {
+    return RET_OK;
+  }
+  const float *gamma = nullptr;
+  const float *beta = nullptr;
+  if (params_->epilogue_ & MatmulEpilogue_LayerNorm) {
+    gamma = reinterpret_cast<const float *>(in_tensors_[input_index]->data());
+    beta = reinterpret_cast<const float *>(in_tensors_[input_index + 1]->data());
+  }
+  ret = MatmulEpilogueRowwise(c, gamma, beta, end_row - start_row, params_->col_, col_step_, params_);
+  MS_CHECK_TRUE_MSG(ret == NNACL_OK, RET_ERROR, "matmul row-wise epilogue failed.");
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::RunRowwiseEpilogue(int task_id) const {
+  int total_row = params_->batch * params_->row_;
+  int row_step = UP_DIV(total_row, op_parameter_->thread_num_);
+  int start_row = task_id * row_step;
+  int end_row = MSMIN(total_row, start_row + row_step);
+  if (start_row >= end_row) {
+    return RET_OK;
+  }
+  const float *gamma = nullptr;
+  const float *beta = nullptr;
+  if (params_->epilogue_ & MatmulEpilogue_LayerNorm) {
+    size_t input_index = in_tensors_.size() - C2NUM;
+    gamma = reinterpret_cast<const float *>(in_tensors_[input_index]->data());
+    beta = reinterpret_cast<const float *>(in_tensors_[input_index + 1]->data());
+  }
+  auto ret = MatmulEpilogueRowwise(output_data_ + start_row * col_step_, gamma, beta, end_row - start_row,
+                                   params_->col_, col_step_, params_);
+  MS_CHECK_TRUE_MSG(ret == NNACL_OK, RET_ERROR, "matmul row-wise epilogue failed.");
+  return RET_OK;
+}
+
 int MatmulFp32BaseCPUKernel::PackBiasMatrix() {
-  if (in_tensors_.size() != FOURTH_INPUT) {
+  if (MatmulInputNum() != FOURTH_INPUT) {
     return RET_OK;
   }
   if (matrix_c_.has_packed) {
@@ -317,9 +435,15 @@ int MatmulFp32BaseCPUKernel::Prepare() {
   CHECK_LESS_RETURN(out_tensors_.size(), 1);
   MS_CHECK_TRUE_MSG(in_tensors_[FIRST_INPUT]->data_type() == kNumberTypeFloat32, RET_ERROR,
                     "matrix-a's data type is invalid.");
-  MS_CHECK_TRUE_MSG(in_tensors_[SECOND_INPUT]->data_type() == kNumberTypeFloat32, RET_ERROR,
+  MS_CHECK_TRUE_MSG(in_tensors_[SECOND_INPUT]->data_type() == matrix_b_data_type_, RET_ERROR,
                     "matrix-b's data type is invalid.");
-  if (in_tensors_.size() == FOURTH_INPUT) {
+  CHECK_LESS_RETURN(in_tensors_.size(), static_cast<size_t>(C2NUM + MatmulEpilogueInputNum(params_->epilogue_)));
+  MS_CHECK_TRUE_MSG(MatmulInputNum() <= FOURTH_INPUT, RET_ERROR, "matmul has too many inputs.");
+  for (size_t i = MatmulInputNum(); i < in_tensors_.size(); ++i) {
+    MS_CHECK_TRUE_MSG(in_tensors_[i]->data_type() == kNumberTypeFloat32, RET_ERROR,
+                      "the epilogue input's data type is invalid.");
+  }
+  if (MatmulInputNum() == FOURTH_INPUT) {
     MS_CHECK_TRUE_MSG(in_tensors_[THIRD_INPUT]->IsConst(), RET_ERROR, "matrix-c must be const when existing.");
     MS_CHECK_TRUE_MSG(in_tensors_[THIRD_INPUT]->data_type() == kNumberTypeFloat32, RET_ERROR,
                       "matrix-c's data type is invalid.");
@@ -342,7 +466,7 @@ int MatmulFp32BaseCPUKernel::Prepare() {
     matrix_b_.has_packed = true;
   }
   if (!InferShapeDone()) {
-    if (in_tensors_.size() == FOURTH_INPUT && !op_parameter_->is_train_session_) {
+    if (MatmulInputNum() == FOURTH_INPUT && !op_parameter_->is_train_session_) {
       ret = BackupConstMatrix(&matrix_c_, THIRD_INPUT);
       MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "backup matrix-c failed.");
     }
@@ -455,11 +579,21 @@ int MatmulFp32BaseCPUKernel::ReSize() {
     MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "pack const-matrix c failed.");
     matrix_c_.has_packed = true;
   }
+  ret = CheckEpilogueInputs();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "CheckEpilogueInputs error!";
+    return ret;
+  }
   ret = InitTmpOutBuffer();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "InitTmpOutBuffer error!";
     return ret;
   }
+  ret = InitComputeFunc();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "InitComputeFunc error!";
+    return ret;
+  }
   return RET_OK;
 }
 
@@ -586,7 +720,7 @@ int MatmulFp32BaseCPUKernel::InitParameter() {
   MS_CHECK_INT_MUL_NOT_OVERFLOW(a_batch_, params_->col_align_, RET_ERROR);
   MS_CHECK_INT_MUL_NOT_OVERFLOW(a_batch_ * params_->col_align_, params_->deep_, RET_ERROR);
   auto a_pack_size = a_batch_ * params_->row_align_ * params_->deep_;
-  auto b_pack_size = b_batch_ * params_->col_align_ * params_->deep_;
+  auto b_pack_size = GetMatrixBPackSize();
   if ((matrix_a_.has_packed && matrix_a_.pack_size != a_pack_size) ||
       (matrix_b_.has_packed && matrix_b_.pack_size != b_pack_size)) {
     MS_LOG(ERROR) << "matmul don't support dynamic packing if matrix is a constant.";
@@ -698,6 +832,13 @@ int MatmulFp32BaseCPUKernel::Run() {
     MS_LOG(ERROR) << "MatmulRun failed in split by batch";
     return ret;
   }
+  if (MatmulEpilogueHasRowwise(params_->epilogue_) && !RunRowwiseEpilogueByTask()) {
+    ret = ParallelLaunch(this->ms_context_, MatmulRowwiseEpilogueRun, this, op_parameter_->thread_num_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "MatmulRowwiseEpilogueRun failed";
+      return ret;
+    }
+  }
 
   if (out_need_aligned_) {
     PackNHWCXToNHWCFp32(output_data_, out_data, params_->batch, params_->row_, params_->col_, col_tile_);
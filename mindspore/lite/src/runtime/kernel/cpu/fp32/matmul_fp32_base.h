@@ -48,6 +48,10 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   int FullConnectionReSize();
   int MatmulReSize();
   int Run() override;
+  // applies the fused epilogues to the output region the task has just computed.
+  int RunEpilogue(int task_id) const;
+  // the row-wise epilogues over rows split by task, for when the gemm tasks own column slices.
+  int RunRowwiseEpilogue(int task_id) const;
 
   using ParallelRun = int (MatmulFp32BaseCPUKernel::*)(int task_id) const;
   ParallelRun parallel_fun_ = nullptr;
@@ -65,16 +69,19 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   virtual int ParallelRunByRow(int task_id) const;
   virtual int ParallelRunByOC(int task_id) const;
   virtual int ParallelRunByBatch(int task_id) const;
-  int ParallelRunIsNotPackByBatch(int task_id) const;
+  virtual int ParallelRunIsNotPackByBatch(int task_id) const;
   int BackupConstMatrix(MatrixInfo *matrix_info, int index);
   virtual void InitGlobalVariable();
   int PackMatrixA();
   int PackMatrixB();
   int PackMatrixAImpl();
-  int PackMatrixBImpl();
+  virtual int PackMatrixBImpl();
+  virtual int GetMatrixBPackSize() const;
   virtual int PackMatrixAImplOpt();
   bool CheckRow1OptimalConditions();
   virtual bool SupportMulBatchCuttingByRow() { return false; }
+  // called at the end of ReSize, once the shapes, the thread cutting and the bias are known.
+  virtual int InitComputeFunc() { return RET_OK; }
   int PackBiasMatrix();
   void FreePackedMatrixA();
   void FreePackedMatrixB();
@@ -86,6 +93,10 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   void InitShapeA();
   void InitShapeB();
   int InitBroadcastParams();
+  // the matmul inputs without the epilogue ones, 3 when there is a bias.
+  size_t MatmulInputNum() const;
+  int CheckEpilogueInputs();
+  bool RunRowwiseEpilogueByTask() const;
 
  protected:
   MatMulParameter *params_ = nullptr;
@@ -112,6 +123,7 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   bool pack_opt_{false};  // indicate whether packing can be multi-threads, currently, only support in ARM64 && packA.
   MatrixPackFun matrix_a_pack_fun_ = nullptr;
   MatrixPackFun matrix_b_pack_fun_ = nullptr;
+  TypeId matrix_b_data_type_ = kNumberTypeFloat32;  // data type of the weight accepted by the kernel.
 };
 }  // namespace mindspore::kernel
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_BASE_H_
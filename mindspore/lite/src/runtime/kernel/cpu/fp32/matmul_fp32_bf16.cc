@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_AVX
+#include "src/runtime/kernel/cpu/fp32/matmul_fp32_bf16.h"
+#include "nnacl/fp32/pack_fp32.h"
+
+namespace mindspore::kernel {
+void MatmulFp32BF16CPUKernel::InitGlobalVariable() {
+  matrix_a_.need_pack = params_->a_transpose_;
+  matrix_b_.need_pack = true;
+  matrix_a_pack_fun_ = params_->a_transpose_ ? RowMajor2ColMajor : RowMajor2RowMajor;
+  matrix_b_pack_fun_ = nullptr;  // the bf16 weight is packed by PackMatrixBImpl
+  row_tile_ = C1NUM;
+  col_tile_ = MATMUL_BF16_COL_TILE;
+  col_min_unit_ = C32NUM;
+  out_need_aligned_ = false;
+  deep_2_ = UP_ROUND(params_->deep_, C2NUM);
+  matmul_func_ = GetMatmulBf16Func();
+}
+
+int MatmulFp32BF16CPUKernel::GetMatrixBPackSize() const {
+  // counted in floats, two bf16 values share one float
+  return b_batch_ * UP_ROUND(params_->col_, MATMUL_BF16_COL_TILE) * deep_2_ / C2NUM;
+}
+
+int MatmulFp32BF16CPUKernel::PackMatrixBImpl() {
+  auto src_ptr = reinterpret_cast<const uint16_t *>(in_tensors_[SECOND_INPUT]->data());
+  MS_CHECK_TRUE_MSG(src_ptr != nullptr, RET_ERROR, "matrix-b source ptr is a nullptr.");
+  MS_CHECK_TRUE_MSG(matrix_b_.pack_ptr != nullptr, RET_ERROR, "matrix-b pack ptr is a nullptr.");
+  auto dst_ptr = reinterpret_cast<uint16_t *>(matrix_b_.pack_ptr);
+  int col_16 = UP_ROUND(params_->col_, MATMUL_BF16_COL_TILE);
+  for (int i = 0; i < b_batch_; i++) {
+    PackMatrixBToCol16PairBf16(src_ptr + i * params_->deep_ * params_->col_, dst_ptr + i * deep_2_ * col_16,
+                               params_->deep_, params_->col_, true, params_->b_transpose_);
+  }
+  return RET_OK;
+}
+
+void MatmulFp32BF16CPUKernel::Compute(int batch_index, int start_oc, int compute_oc, uint16_t *a_buffer) const {
+  int col_16 = UP_ROUND(params_->col_, MATMUL_BF16_COL_TILE);
+  const float *a = matrix_a_.pack_ptr + a_offset_[batch_index] * params_->row_align_ * params_->deep_;
+  const uint16_t *b =
+    reinterpret_cast<const uint16_t *>(matrix_b_.pack_ptr) + b_offset_[batch_index] * deep_2_ * col_16;
+  float *c = output_data_ + batch_index * params_->row_ * col_step_ + start_oc;
+  auto bias = (matrix_c_.pack_ptr == nullptr) ? nullptr : matrix_c_.pack_ptr + start_oc;
+  matmul_func_(a, b + start_oc * deep_2_, c, bias, params_->act_type_, params_->deep_, params_->row_, compute_oc,
+               col_step_, a_buffer);
+}
+
+int MatmulFp32BF16CPUKernel::ParallelRunByBatch(int task_id) const {
+  int start_batch = task_id * batch_stride_;
+  int end_batch = MSMIN(params_->batch, start_batch + batch_stride_);
+  uint16_t *a_buffer = a_buffer_ + task_id * MATMUL_BF16_ROW_TILE * deep_2_;
+  for (int index = start_batch; index < end_batch; ++index) {
+    Compute(index, 0, params_->col_, a_buffer);
+  }
+  return RET_OK;
+}
+
+int MatmulFp32BF16CPUKernel::ParallelRunIsNotPackByBatch(int task_id) const { return ParallelRunByBatch(task_id); }
+
+int MatmulFp32BF16CPUKernel::ParallelRunByOC(int task_id) const {
+  int start_oc = split_points_[task_id];
+  int end_oc = params_->col_;
+  if (task_id < (thread_count_ - 1)) {
+    end_oc = split_points_[task_id + 1];
+  }
+  int compute_oc = MSMIN(end_oc, params_->col_) - start_oc;
+  if (compute_oc <= 0) {
+    return RET_OK;
+  }
+  uint16_t *a_buffer = a_buffer_ + task_id * MATMUL_BF16_ROW_TILE * deep_2_;
+  for (int i = 0; i < params_->batch; ++i) {
+    Compute(i, start_oc, compute_oc, a_buffer);
+  }
+  return RET_OK;
+}
+
+int MatmulFp32BF16CPUKernel::Run() {
+  MS_CHECK_TRUE_MSG(params_->b_const_ && matrix_b_.has_packed, RET_ERROR, "bf16 matrix-b must be a constant.");
+  MS_CHECK_TRUE_MSG(matmul_func_ != nullptr, RET_ERROR, "bf16 matmul func is a nullptr.");
+  a_buffer_ = reinterpret_cast<uint16_t *>(
+    ms_context_->allocator->Malloc(thread_count_ * MATMUL_BF16_ROW_TILE * deep_2_ * sizeof(uint16_t)));
+  MS_CHECK_TRUE_MSG(a_buffer_ != nullptr, RET_ERROR, "malloc bf16 matrix-a buffer failed.");
+  auto ret = MatmulFp32BaseCPUKernel::Run();
+  ms_context_->allocator->Free(a_buffer_);
+  a_buffer_ = nullptr;
+  return ret;
+}
+}  // namespace mindspore::kernel
+#endif
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_BF16_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_BF16_H_
+
+#ifdef ENABLE_AVX
+#include <vector>
+#include "src/runtime/kernel/cpu/fp32/matmul_fp32_base.h"
+#include "nnacl/fp32/matmul_bf16_fp32.h"
+namespace mindspore::kernel {
+// fp32 matmul with a constant bf16 weight, the weight stays bf16 after packing and is widened inside the gemm.
+class MatmulFp32BF16CPUKernel : public MatmulFp32BaseCPUKernel {
+ public:
+  MatmulFp32BF16CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                          const std::vector<lite::Tensor *> &outputs, const mindspore::lite::InnerContext *ctx)
+      : MatmulFp32BaseCPUKernel(parameter, inputs, outputs, ctx) {
+    matrix_b_data_type_ = kNumberTypeBFloat16;
+  }
+  ~MatmulFp32BF16CPUKernel() = default;
+
+  int Run() override;
+
+  void InitGlobalVariable() override;
+  int PackMatrixBImpl() override;
+  int GetMatrixBPackSize() const override;
+  int ParallelRunByBatch(int task_id) const override;
+  int ParallelRunByOC(int task_id) const override;
+  int ParallelRunIsNotPackByBatch(int task_id) const override;
+
+  // a weight is only kept in bf16 when it is constant.
+  static bool IsBF16Weight(const std::vector<lite::Tensor *> &inputs) {
+    return inputs.size() > kWeightIndex && inputs[kWeightIndex]->data_type() == kNumberTypeBFloat16 &&
+           inputs[kWeightIndex]->IsConst();
+  }
+
+ private:
+  void Compute(int batch_index, int start_oc, int compute_oc, uint16_t *a_buffer) const;
+
+  MatmulBf16Func matmul_func_ = nullptr;
+  uint16_t *a_buffer_ = nullptr;
+  int deep_2_ = 0;
+};
+}  // namespace mindspore::kernel
+#endif
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_BF16_H_
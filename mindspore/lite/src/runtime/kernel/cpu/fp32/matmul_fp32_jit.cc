@@ -0,0 +1,162 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(ENABLE_AVX) && defined(__linux__)
+#include "src/runtime/kernel/cpu/fp32/matmul_fp32_jit.h"
+#include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/pack_fp32.h"
+
+namespace mindspore::kernel {
+void MatmulFp32JitCPUKernel::InitGlobalVariable() {
+  matrix_a_.need_pack = params_->a_transpose_;
+  matrix_b_.need_pack = true;
+  matrix_a_pack_fun_ = params_->a_transpose_ ? RowMajor2ColMajor : RowMajor2RowMajor;
+  if (JitGemmFp32::SimdLanes() == C16NUM) {
+    matrix_b_pack_fun_ = params_->b_transpose_ ? RowMajor2Col64Major : RowMajor2Row64Major;
+    b_panel_ = C64NUM;
+  } else {
+    matrix_b_pack_fun_ = params_->b_transpose_ ? RowMajor2Col32Major : RowMajor2Row32Major;
+    b_panel_ = C32NUM;
+  }
+  row_tile_ = C1NUM;
+  col_tile_ = JitGemmFp32::SimdLanes();
+  col_min_unit_ = b_panel_;
+  // the generated code stores the column tail with masks, c never needs an aligned buffer.
+  out_need_aligned_ = false;
+}
+
+int MatmulFp32JitCPUKernel::InitComputeFunc() {
+  if (col_tile_ == 1) {
+    // matrix-vector product without packing b, computed by nnacl.
+    return RET_OK;
+  }
+  JitGemmParam param;
+  param.deep = params_->deep_;
+  param.a_stride = params_->deep_;
+  param.c_stride = col_step_;
+  param.b_panel = b_panel_;
+  param.col_align = params_->col_align_;
+  param.has_bias = matrix_c_.pack_ptr != nullptr;
+  param.act_type = params_->act_type_;
+  std::vector<int> row_nums;
+  std::vector<int> col_splits = {0};
+  if (parallel_fun_ == &MatmulFp32BaseCPUKernel::ParallelRunByRow) {
+    for (size_t i = 0; i < split_points_.size(); ++i) {
+      int end_row = i + 1 < split_points_.size() ? split_points_[i + 1] : row_num_;
+      row_nums.push_back(end_row - split_points_[i]);
+    }
+  } else {
+    row_nums.push_back(params_->row_);
+    if (parallel_fun_ == &MatmulFp32BaseCPUKernel::ParallelRunByOC) {
+      col_splits = split_points_;
+    }
+  }
+  return jit_gemm_.Init(param, row_nums, col_splits, params_->col_);
+}
+
+int MatmulFp32JitCPUKernel::PackMatrixAImplOpt() {
+  MS_LOG(ERROR) << "Matmul: don't support optimized-packing, only support single-thread currently.";
+  return RET_ERROR;
+}
+
+int MatmulFp32JitCPUKernel::ParallelRunByBatch(int task_id) const {
+  int start_batch = task_id * batch_stride_;
+  int end_batch = MSMIN(params_->batch, start_batch + batch_stride_);
+  for (int index = start_batch; index < end_batch; ++index) {
+    const float *a = matrix_a_.pack_ptr + a_offset_[index] * params_->row_align_ * params_->deep_;
+    const float *b = matrix_b_.pack_ptr + b_offset_[index] * params_->deep_ * params_->col_align_;
+    float *c = output_data_ + index * params_->row_ * col_step_;
+    if (col_tile_ == 1) {
+      MatVecMulNoPackFp32(a, b, c, matrix_c_.pack_ptr, params_->act_type_, params_->deep_, col_step_, col_step_);
+      continue;
+    }
+    auto ret = jit_gemm_.Run(a, b, c, matrix_c_.pack_ptr, params_->row_, 0, params_->col_);
+    MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "jit gemm run failed.");
+  }
+  return RET_OK;
+}
+
+int MatmulFp32JitCPUKernel::ParallelRunByRow(int task_id) const {
+  int start_row = split_points_[task_id];
+  int end_row = row_num_;
+  if (task_id < (thread_count_ - 1)) {
+    end_row = split_points_[task_id + 1];
+  }
+  int row_num = end_row - start_row;
+  if (row_num <= 0) {
+    return RET_OK;
+  }
+  const float *input = matrix_a_.pack_ptr + start_row * params_->deep_;
+  float *output = output_data_ + start_row * col_step_;
+  if (params_->col_ == 1 && col_tile_ == 1) {
+    float bias = 0;
+    if (matrix_c_.pack_ptr != nullptr) {
+      bias = matrix_c_.pack_ptr[0];
+    }
+    gemmIsNotPackFun(input, matrix_b_.pack_ptr, output, &bias, row_num, params_->deep_, params_->act_type_);
+    return RET_OK;
+  }
+  auto ret = jit_gemm_.Run(input, matrix_b_.pack_ptr, output, matrix_c_.pack_ptr, row_num, 0, params_->col_);
+  MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "jit gemm run failed.");
+  return RET_OK;
+}
+
+int MatmulFp32JitCPUKernel::ParallelRunByOC(int task_id) const {
+  int start_oc = split_points_[task_id];
+  int end_oc = col_step_;
+  if (task_id < (thread_count_ - 1)) {
+    end_oc = split_points_[task_id + 1];
+  }
+  if (end_oc <= start_oc) {
+    return RET_OK;
+  }
+  for (int i = 0; i < params_->batch; ++i) {
+    auto a = matrix_a_.pack_ptr + a_offset_[i] * params_->row_align_ * params_->deep_;
+    auto b = matrix_b_.pack_ptr + b_offset_[i] * params_->deep_ * params_->col_align_;
+    auto c = output_data_ + i * params_->row_ * col_step_;
+    if (col_tile_ == 1) {
+      auto bias = (matrix_c_.pack_ptr == nullptr) ? nullptr : matrix_c_.pack_ptr + start_oc;
+      MatVecMulNoPackFp32(a, b + start_oc, c + start_oc, bias, params_->act_type_, params_->deep_, end_oc - start_oc,
+                          col_step_);
+      continue;
+    }
+    auto ret = jit_gemm_.Run(a, b, c, matrix_c_.pack_ptr, params_->row_, start_oc, end_oc);
+    MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "jit gemm run failed.");
+  }
+  return RET_OK;
+}
+
+bool MatmulFp32JitCPUKernel::CheckThreadCuttingByRow() {
+  if (b_batch_ != C1NUM) {
+    return false;
+  }
+  if (row_num_ < op_parameter_->thread_num_) {
+    return false;
+  }
+  if (params_->col_ == 1) {
+    row_min_unit_ = C8NUM;
+    return true;
+  }
+  if (params_->row_ == 1 && !params_->b_const_ && params_->col_ <= C128NUM) {
+    return false;
+  }
+  // a thread computes at least one full row tile of the generated kernels.
+  row_min_unit_ = col_step_ < JitGemmFp32::MaxTileCol() ? C12NUM : C6NUM;
+  return MSMIN(row_num_ / row_min_unit_, op_parameter_->thread_num_) >
+         MSMIN(col_step_ / col_min_unit_, op_parameter_->thread_num_);
+}
+}  // namespace mindspore::kernel
+#endif
@@ -17,10 +17,11 @@
 
 #include "src/runtime/kernel/cpu/fp32/transpose_fp32.h"
 #include "src/runtime/kernel_registry.h"
-#include "nnacl/fp32/transpose_fp32.h"
 #include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/errorcode.h"
 
 using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_OK;
 using mindspore::schema::PrimitiveType_Transpose;
 
@@ -31,15 +32,29 @@ int TransposeCPUKernel::ReSize() {
     MS_LOG(ERROR) << "Do transpose resize failed.";
     return ret;
   }
-  thread_num_ = (!opt_run_ && param_->num_axes_ <= DIMENSION_6D) ? 1 : thread_num_;
+  thread_num_ = op_parameter_->thread_num_ > 0 ? op_parameter_->thread_num_ : 1;
+  if (!is_valid_ || opt_run_) {
+    return RET_OK;
+  }
+  int in_shape[MAX_TRANSPOSE_DIM_SIZE] = {0};
+  for (int i = 0; i < param_->num_axes_; ++i) {
+    in_shape[param_->perm_[i]] = out_shape_[i];
+  }
+  ret = TiledTransposeInit(&tiled_info_, in_shape, param_->perm_, param_->num_axes_, sizeof(float));
+  if (ret != NNACL_OK) {
+    MS_LOG(ERROR) << "Init tiled transpose failed.";
+    return RET_ERROR;
+  }
+  thread_num_ = static_cast<int>(MSMIN(thread_num_, tiled_info_.unit_num_));
   return RET_OK;
 }
 
 int TransposeCPUKernel::DoTransposeSingleThread() {
-  if (opt_run_ || param_->num_axes_ > DIMENSION_6D) {
+  if (opt_run_) {
     return DoTransposeMultiThread(0);
   }
-  return DoTransposeFp32(static_cast<const float *>(in_data_), static_cast<float *>(out_data_), out_shape_, param_);
+  TiledTranspose(in_data_, out_data_, &tiled_info_, 0, tiled_info_.unit_num_);
+  return RET_OK;
 }
 
 int TransposeCPUKernel::DoTransposeMultiThread(int task_id) {
@@ -48,8 +63,8 @@ int TransposeCPUKernel::DoTransposeMultiThread(int task_id) {
                        task_id, thread_num_);
     return RET_OK;
   }
-  TransposeDimsFp32(static_cast<const float *>(in_data_), static_cast<float *>(out_data_), out_shape_, param_, task_id,
-                    thread_num_);
+  int64_t unit_step = UP_DIV(tiled_info_.unit_num_, thread_num_);
+  TiledTranspose(in_data_, out_data_, &tiled_info_, task_id * unit_step, (task_id + 1) * unit_step);
   return RET_OK;
 }
 
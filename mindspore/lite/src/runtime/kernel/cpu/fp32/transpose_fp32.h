@@ -19,6 +19,7 @@
 #ifndef BFC_MEMORY
 #include <vector>
 #include "src/runtime/kernel/cpu/base/transpose_base.h"
+#include "nnacl/base/tiled_transpose_base.h"
 
 namespace mindspore::kernel {
 class TransposeCPUKernel : public TransposeBaseCPUKernel {
@@ -33,6 +34,9 @@ class TransposeCPUKernel : public TransposeBaseCPUKernel {
  private:
   int DoTransposeSingleThread() override;
   int DoTransposeMultiThread(int task_id) override;
+
+  // only valid when opt_run_ is false
+  TiledTransposeInfo tiled_info_{};
 };
 }  // namespace mindspore::kernel
 
@@ -17,6 +17,7 @@
 #include "src/runtime/kernel/cpu/fp32/unique_fp32.h"
 #include "src/runtime/kernel_registry.h"
 #include "include/errorcode.h"
+#include "src/runtime/inner_allocator.h"
 #include "nnacl/fp32/unique_fp32.h"
 #ifdef ENABLE_FP16
 #include "nnacl/fp16/unique_fp16.h"
@@ -28,6 +29,11 @@ using mindspore::lite::RET_OK;
 using mindspore::schema::PrimitiveType_Unique;
 
 namespace mindspore::kernel {
+namespace {
+// Shorter inputs are deduplicated by a linear search of the outputs so far.
+constexpr int kUniqueHashMinSize = 64;
+}  // namespace
+
 int UniqueCPUKernel::Prepare() {
   CHECK_LESS_RETURN(in_tensors_.size(), 1);
   CHECK_LESS_RETURN(out_tensors_.size(), C2NUM);
@@ -54,8 +60,25 @@ int UniqueCPUKernel::Run() {
                &output0_len, output1);
 #endif
   } else {
-    Unique(static_cast<float *>(input), in_tensors_[0]->ElementsNum(), static_cast<float *>(output0), &output0_len,
-           output1);
+    int input_len = in_tensors_[0]->ElementsNum();
+    if (input_len < kUniqueHashMinSize) {
+      Unique(static_cast<float *>(input), input_len, static_cast<float *>(output0), &output0_len, output1);
+    } else {
+      CHECK_LESS_RETURN(static_cast<size_t>(MAX_MALLOC_SIZE) / (sizeof(int) * C4NUM), static_cast<size_t>(input_len));
+      int table_size = C2NUM;
+      while (table_size < input_len * C2NUM) {
+        table_size *= C2NUM;
+      }
+      MS_ASSERT(ms_context_->allocator != nullptr);
+      auto hash_table = reinterpret_cast<int *>(ms_context_->allocator->Malloc(table_size * sizeof(int)));
+      if (hash_table == nullptr) {
+        MS_LOG(ERROR) << "Malloc unique hash table failed.";
+        return RET_ERROR;
+      }
+      UniqueByHash(static_cast<float *>(input), input_len, static_cast<float *>(output0), &output0_len, output1,
+                   hash_table, table_size);
+      ms_context_->allocator->Free(hash_table);
+    }
   }
 
   std::vector<int> out_shape = out_tensors_[0]->shape();
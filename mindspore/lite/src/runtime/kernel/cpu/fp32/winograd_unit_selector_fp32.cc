@@ -0,0 +1,254 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/cpu/fp32/winograd_unit_selector_fp32.h"
+#include <cstdlib>
+#include <cstring>
+#include "nnacl/base/conv_common_base.h"
+#include "nnacl/fp32/conv_common_fp32.h"
+#include "nnacl/fp32/conv_winograd_fp32.h"
+#include "nnacl/fp32/winograd_utils.h"
+#include "src/common/log_adapter.h"
+#include "src/common/utils.h"
+#include "src/runtime/inner_allocator.h"
+
+namespace mindspore::kernel {
+namespace {
+#ifdef ENABLE_AVX
+constexpr int kWinogradOcBlock = C16NUM;
+constexpr int kWinogradChannelTile = C8NUM;
+constexpr int kIm2colOcBlock = C16NUM;
+#elif defined(ENABLE_ARM32)
+constexpr int kWinogradOcBlock = C8NUM;
+constexpr int kWinogradChannelTile = C4NUM;
+constexpr int kIm2colOcBlock = C4NUM;
+#else
+constexpr int kWinogradOcBlock = C8NUM;
+constexpr int kWinogradChannelTile = C4NUM;
+constexpr int kIm2colOcBlock = C8NUM;
+#endif
+constexpr int kWinogradTileNum = C12NUM;
+constexpr int kIm2colTimedPixels = C24NUM;  // whole row tiles for every im2col tile size (4, 6, 8, 12)
+constexpr int kMaxOutputUnitNum = 8;
+// Above this the gemm dominates both algorithms, so the cost model is trusted instead of spending time on the timing.
+constexpr int64_t kMaxTimedChannelProduct = 512 * 512;
+constexpr int kTimingRounds = 3;
+constexpr int kMaxLoopsPerRound = 64;
+constexpr uint64_t kMinRoundUs = 200;
+
+// Best per-call time over a few rounds, each round loops until it is long enough for the us clock.
+template <typename Func>
+float TimeCall(const Func &func) {
+  func();  // warm up caches and page in the buffers
+  float best = -1.0f;
+  for (int round = 0; round < kTimingRounds; ++round) {
+    int loops = 0;
+    uint64_t start = lite::GetTimeUs();
+    uint64_t elapsed = 0;
+    do {
+      func();
+      ++loops;
+      elapsed = lite::GetTimeUs() - start;
+    } while (elapsed < kMinRoundUs && loops < kMaxLoopsPerRound);
+    float cost = static_cast<float>(elapsed) / loops;
+    if (best < 0.0f || cost < best) {
+      best = cost;
+    }
+  }
+  return best;
+}
+
+// The timed data only has to be finite and free of denormals.
+float *MallocTimingData(size_t size) {
+  if (size == 0 || size > static_cast<size_t>(MAX_MALLOC_SIZE) / sizeof(float)) {
+    return nullptr;
+  }
+  auto data = reinterpret_cast<float *>(malloc(size * sizeof(float)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<float>(i % C8NUM) * 0.125f - 0.5f;
+  }
+  return data;
+}
+
+// A single image whose output is exactly out_h x out_w, without padding, run by one thread.
+ConvParameter TimingConvParam(const ConvParameter *conv_param, int out_h, int out_w) {
+  ConvParameter param = *conv_param;
+  param.input_batch_ = 1;
+  param.output_batch_ = 1;
+  param.output_h_ = out_h;
+  param.output_w_ = out_w;
+  param.input_h_ = out_h + conv_param->kernel_h_ - 1;
+  param.input_w_ = out_w + conv_param->kernel_w_ - 1;
+  param.pad_u_ = 0;
+  param.pad_d_ = 0;
+  param.pad_l_ = 0;
+  param.pad_r_ = 0;
+  param.thread_num_ = 1;
+  param.op_parameter_.thread_num_ = 1;
+  param.out_format_ = Format_NHWC;
+  return param;
+}
+}  // namespace
+
+WinogradUnitSelector *WinogradUnitSelector::GetInstance() {
+  static WinogradUnitSelector instance;
+  return &instance;
+}
+
+int WinogradUnitSelector::Select(const ConvParameter *conv_param) {
+  std::vector<int> key = {conv_param->kernel_h_,
+                          conv_param->input_channel_,
+                          conv_param->output_channel_,
+                          conv_param->output_h_,
+                          conv_param->output_w_,
+                          conv_param->input_batch_,
+                          conv_param->op_parameter_.thread_num_,
+                          static_cast<int>(conv_param->act_type_)};
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = output_units_.find(key);
+  if (iter != output_units_.end()) {
+    return iter->second;
+  }
+  int output_unit = MeasureOutputUnit(conv_param);
+  output_units_[key] = output_unit;
+  return output_unit;
+}
+
+int WinogradUnitSelector::MeasureOutputUnit(const ConvParameter *conv_param) {
+  int model_unit = SelectOutputUnit(conv_param);
+  int64_t channel_product = static_cast<int64_t>(conv_param->input_channel_) * conv_param->output_channel_;
+  if (conv_param->op_parameter_.thread_num_ <= 0 || channel_product > kMaxTimedChannelProduct) {
+    return model_unit;
+  }
+  int units[kMaxOutputUnitNum];
+  int unit_num = GetWinogradOutputUnits(conv_param, units, kMaxOutputUnitNum);
+  if (unit_num == 0) {
+    return 1;
+  }
+
+  int thread_num = conv_param->op_parameter_.thread_num_;
+  int batch = conv_param->input_batch_;
+  int out_h = conv_param->output_h_;
+  int out_w = conv_param->output_w_;
+  float pixel_cost = TimeIm2colPixel(conv_param);
+  if (pixel_cost < 0.0f) {
+    return model_unit;
+  }
+  // threads split the output pixels evenly.
+  float best_cost = pixel_cost * UP_DIV(out_h * out_w, thread_num) * batch;
+  int best_unit = 1;
+  for (int i = 0; i < unit_num; ++i) {
+    float block_cost = TimeWinogradBlock(conv_param, units[i]);
+    if (block_cost < 0.0f) {
+      return model_unit;
+    }
+    // threads take whole blocks of tiles, so large units can leave threads idle on small outputs.
+    int tile_count = UP_DIV(out_h, units[i]) * UP_DIV(out_w, units[i]);
+    float cost = block_cost * UP_DIV(UP_DIV(tile_count, kWinogradTileNum), thread_num) * batch;
+    MS_LOG(DEBUG) << "winograd output unit " << units[i] << " estimated " << cost << "us, im2col "
+                  << pixel_cost * UP_DIV(out_h * out_w, thread_num) * batch << "us";
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_unit = units[i];
+    }
+  }
+  MS_LOG(INFO) << "conv " << conv_param->kernel_h_ << "x" << conv_param->kernel_w_ << " in "
+               << conv_param->input_channel_ << " out " << conv_param->output_channel_ << " plane " << out_h << "x"
+               << out_w << " select winograd output unit " << best_unit << ", cost model gives " << model_unit;
+  return best_unit;
+}
+
+float WinogradUnitSelector::TimeWinogradBlock(const ConvParameter *conv_param, int output_unit) {
+  // one row of C12NUM tiles is exactly one block of ConvWinogardFp32.
+  ConvParameter param = TimingConvParam(conv_param, output_unit, output_unit * kWinogradTileNum);
+  int input_unit = output_unit + conv_param->kernel_h_ - 1;
+  param.input_unit_ = input_unit;
+  param.output_unit_ = output_unit;
+  TransFuncList trans_func = {nullptr, nullptr, nullptr, nullptr};
+  trans_func.in_func_ = GetInputTransFunc(input_unit);
+#ifdef ENABLE_ARM64
+  trans_func.in_step_func_ = GetInputTransStepFunc(input_unit);
+  trans_func.in_pack_func_ = GetInputTransPackFunc(input_unit);
+#endif
+  trans_func.out_func_ = GetOutputTransFunc(input_unit, output_unit, param.act_type_);
+  if (trans_func.in_func_ == nullptr || trans_func.out_func_ == nullptr) {
+    return -1.0f;
+  }
+
+  size_t in_channel = param.input_channel_;
+  size_t out_channel = param.output_channel_;
+  size_t unit_square = input_unit * input_unit;
+  size_t trans_input_size = kWinogradTileNum * unit_square * in_channel;
+  size_t gemm_out_size = kWinogradTileNum * unit_square * UP_ROUND(out_channel, C8NUM);
+  size_t tmp_data_size = kWinogradChannelTile * unit_square;
+  size_t col_buffer_size = kWinogradTileNum * in_channel;
+  size_t opt_input_size = kWinogradTileNum * unit_square * UP_ROUND(in_channel, kWinogradChannelTile);
+  size_t weight_size = unit_square * in_channel * UP_ROUND(out_channel, kWinogradOcBlock);
+  size_t bias_size = UP_ROUND(out_channel, kWinogradOcBlock);
+  size_t input_size = static_cast<size_t>(param.input_h_) * param.input_w_ * in_channel;
+  size_t output_size = static_cast<size_t>(param.output_h_) * param.output_w_ * out_channel;
+  size_t total_size = trans_input_size + gemm_out_size + tmp_data_size + col_buffer_size + opt_input_size +
+                      weight_size + bias_size + input_size + output_size;
+  float *data = MallocTimingData(total_size);
+  if (data == nullptr) {
+    MS_LOG(WARNING) << "malloc winograd timing data failed.";
+    return -1.0f;
+  }
+  TmpBufferAddress buffer_list[C5NUM];
+  buffer_list[0] = data;
+  buffer_list[1] = buffer_list[0] + trans_input_size;
+  buffer_list[2] = buffer_list[1] + gemm_out_size;
+  buffer_list[3] = buffer_list[2] + tmp_data_size;
+  buffer_list[4] = buffer_list[3] + col_buffer_size;
+  float *weight = buffer_list[4] + opt_input_size;
+  float *bias = weight + weight_size;
+  float *input = bias + bias_size;
+  float *output = input + input_size;
+
+  float cost = TimeCall([&]() { ConvWinogardFp32(input, weight, bias, output, buffer_list, 0, &param, trans_func); });
+  free(data);
+  return cost;
+}
+
+float WinogradUnitSelector::TimeIm2colPixel(const ConvParameter *conv_param) {
+  ConvParameter param = TimingConvParam(conv_param, 1, kIm2colTimedPixels);
+  size_t deep = static_cast<size_t>(param.kernel_h_) * param.kernel_w_ * param.input_channel_;
+  size_t out_channel = param.output_channel_;
+  size_t pack_size = deep * C12NUM;
+  size_t weight_size = deep * UP_ROUND(out_channel, kIm2colOcBlock);
+  size_t bias_size = UP_ROUND(out_channel, kIm2colOcBlock);
+  size_t input_size = static_cast<size_t>(param.input_h_) * param.input_w_ * param.input_channel_;
+  size_t output_size = kIm2colTimedPixels * out_channel;
+  float *data = MallocTimingData(pack_size + pack_size + weight_size + bias_size + input_size + output_size);
+  if (data == nullptr) {
+    MS_LOG(WARNING) << "malloc im2col timing data failed.";
+    return -1.0f;
+  }
+  float *packed_input = data;
+  float *col_major_input = packed_input + pack_size;
+  float *weight = col_major_input + pack_size;
+  float *bias = weight + weight_size;
+  float *input = bias + bias_size;
+  float *output = input + input_size;
+
+  float cost = TimeCall([&]() { ConvFp32(input, packed_input, weight, bias, col_major_input, output, 0, &param); });
+  free(data);
+  return cost / kIm2colTimedPixels;
+}
+}  // namespace mindspore::kernel
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_WINOGRAD_UNIT_SELECTOR_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_WINOGRAD_UNIT_SELECTOR_FP32_H_
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include "nnacl/conv_parameter.h"
+
+namespace mindspore::kernel {
+// Picks the winograd output unit of a fp32 convolution by timing one tile block of every valid unit and a slice of the
+// im2col convolution on this machine, then scaling them to the real shape and thread count. The choice is cached by
+// shape, so each distinct convolution shape is measured once per process.
+class WinogradUnitSelector {
+ public:
+  static WinogradUnitSelector *GetInstance();
+  virtual ~WinogradUnitSelector() = default;
+
+  // Returns the output unit to run with, 1 means im2col is expected to be faster than any winograd unit.
+  int Select(const ConvParameter *conv_param);
+
+ private:
+  WinogradUnitSelector() = default;
+
+  int MeasureOutputUnit(const ConvParameter *conv_param);
+  // us to compute one block of C12NUM tiles with the given output unit, negative on failure.
+  float TimeWinogradBlock(const ConvParameter *conv_param, int output_unit);
+  // us to compute one output pixel with im2col + gemm, negative on failure.
+  float TimeIm2colPixel(const ConvParameter *conv_param);
+
+  std::mutex mutex_;
+  std::map<std::vector<int>, int> output_units_;
+};
+}  // namespace mindspore::kernel
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_WINOGRAD_UNIT_SELECTOR_FP32_H_
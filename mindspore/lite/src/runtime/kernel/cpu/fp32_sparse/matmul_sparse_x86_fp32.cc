@@ -0,0 +1,143 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ENABLE_AVX
+#include "src/runtime/kernel/cpu/fp32_sparse/matmul_sparse_x86_fp32.h"
+#include "nnacl/fp32/pack_fp32.h"
+
+namespace mindspore::kernel {
+namespace {
+constexpr size_t kSparseWeightDims = 2;
+// the block-sparse gemm reaches the dense avx512 gemm at about 45% of non-zero blocks, keep some margin.
+constexpr float kBlockSparseMaxDensity = 0.4f;
+// the 2:4 gemm does as many fma + permute as the dense gemm does fma, it only wins when loading the weight is the
+// bottleneck, which is the case for weights that do not fit in L2.
+constexpr size_t kSparse2x4MinWeightSize = 4 * 1024 * 1024;
+}  // namespace
+
+SparseWeightFormat MatmulSparseX86CPUKernel::SelectSparseFormat(const std::vector<lite::Tensor *> &inputs,
+                                                                const MatMulParameter *param) {
+  if (param == nullptr || param->op_parameter_.is_train_session_ || inputs.size() <= kWeightIndex) {
+    return SparseWeightFormat_None;
+  }
+  auto weight = inputs[kWeightIndex];
+  if (weight->data_type() != kNumberTypeFloat32 || !weight->IsConst() || weight->data() == nullptr ||
+      weight->shape().size() != kSparseWeightDims) {
+    return SparseWeightFormat_None;
+  }
+  int deep = param->b_transpose_ ? weight->shape()[1] : weight->shape()[0];
+  int col = param->b_transpose_ ? weight->shape()[0] : weight->shape()[1];
+  if (deep < SPARSE_NM_GROUP || col < SPARSE_COL_TILE) {
+    return SparseWeightFormat_None;
+  }
+  auto src = reinterpret_cast<const float *>(weight->data());
+  int block_num = BlockSparseBlockNum(src, deep, col, param->b_transpose_);
+  float block_density = static_cast<float>(block_num) / (deep * UP_DIV(col, SPARSE_COL_TILE));
+  if (block_density <= kBlockSparseMaxDensity) {
+    MS_LOG(INFO) << weight->tensor_name() << " uses the block-sparse gemm, block density: " << block_density;
+    return SparseWeightFormat_Block;
+  }
+  if (weight->Size() >= kSparse2x4MinWeightSize && IsSparse2x4(src, deep, col, param->b_transpose_)) {
+    MS_LOG(INFO) << weight->tensor_name() << " uses the 2:4 sparse gemm.";
+    return SparseWeightFormat_2x4;
+  }
+  return SparseWeightFormat_None;
+}
+
+const float *MatmulSparseX86CPUKernel::GetMatrixBSource() const {
+  return matrix_b_.has_origin ? matrix_b_.origin_ptr : reinterpret_cast<float *>(in_tensors_[SECOND_INPUT]->data());
+}
+
+void MatmulSparseX86CPUKernel::InitGlobalVariable() {
+  matrix_a_.need_pack = params_->a_transpose_;
+  matrix_b_.need_pack = true;
+  matrix_a_pack_fun_ = params_->a_transpose_ ? RowMajor2ColMajor : RowMajor2RowMajor;
+  matrix_b_pack_fun_ = nullptr;  // the sparse weight is packed by PackMatrixBImpl
+  row_tile_ = C1NUM;
+  col_tile_ = SPARSE_COL_TILE;
+  col_min_unit_ = SPARSE_COL_TILE;
+  out_need_aligned_ = false;
+  matmul_func_ = GetMatmulSparseFunc(sparse_format_);
+  if (pack_size_ != 0) {
+    return;
+  }
+  auto src_ptr = GetMatrixBSource();
+  if (src_ptr == nullptr) {
+    return;
+  }
+  if (sparse_format_ == SparseWeightFormat_Block) {
+    int block_num = BlockSparseBlockNum(src_ptr, params_->deep_, params_->col_, params_->b_transpose_);
+    pack_size_ = BlockSparsePackSize(params_->col_, block_num);
+  } else if (sparse_format_ == SparseWeightFormat_2x4) {
+    pack_size_ = Sparse2x4PackSize(params_->deep_, params_->col_);
+  }
+}
+
+int MatmulSparseX86CPUKernel::GetMatrixBPackSize() const {
+  // counted in floats
+  return static_cast<int>(UP_DIV(pack_size_, sizeof(float)));
+}
+
+int MatmulSparseX86CPUKernel::PackMatrixBImpl() {
+  MS_CHECK_TRUE_MSG(params_->b_const_ && b_batch_ == 1, RET_ERROR, "sparse matrix-b must be a 2d constant.");
+  auto src_ptr = GetMatrixBSource();
+  MS_CHECK_TRUE_MSG(src_ptr != nullptr, RET_ERROR, "matrix-b source ptr is a nullptr.");
+  MS_CHECK_TRUE_MSG(matrix_b_.pack_ptr != nullptr, RET_ERROR, "matrix-b pack ptr is a nullptr.");
+  if (sparse_format_ == SparseWeightFormat_Block) {
+    PackBlockSparseB(src_ptr, matrix_b_.pack_ptr, params_->deep_, params_->col_, params_->b_transpose_);
+  } else if (sparse_format_ == SparseWeightFormat_2x4) {
+    PackSparse2x4B(src_ptr, matrix_b_.pack_ptr, params_->deep_, params_->col_, params_->b_transpose_);
+  } else {
+    MS_LOG(ERROR) << "unsupported sparse weight format: " << sparse_format_;
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+void MatmulSparseX86CPUKernel::Compute(int batch_index, int start_oc, int end_oc) const {
+  const float *a = matrix_a_.pack_ptr + a_offset_[batch_index] * params_->row_align_ * params_->deep_;
+  float *c = output_data_ + batch_index * params_->row_ * col_step_;
+  matmul_func_(a, matrix_b_.pack_ptr, c, matrix_c_.pack_ptr, params_->act_type_, params_->deep_, params_->row_,
+               params_->col_, start_oc, end_oc, col_step_);
+}
+
+int MatmulSparseX86CPUKernel::ParallelRunByBatch(int task_id) const {
+  int start_batch = task_id * batch_stride_;
+  int end_batch = MSMIN(params_->batch, start_batch + batch_stride_);
+  for (int index = start_batch; index < end_batch; ++index) {
+    Compute(index, 0, params_->col_);
+  }
+  return RET_OK;
+}
+
+int MatmulSparseX86CPUKernel::ParallelRunIsNotPackByBatch(int task_id) const { return ParallelRunByBatch(task_id); }
+
+int MatmulSparseX86CPUKernel::ParallelRunByOC(int task_id) const {
+  int start_oc = split_points_[task_id];
+  int end_oc = params_->col_;
+  if (task_id < (thread_count_ - 1)) {
+    end_oc = MSMIN(split_points_[task_id + 1], params_->col_);
+  }
+  if (end_oc <= start_oc) {
+    return RET_OK;
+  }
+  for (int i = 0; i < params_->batch; ++i) {
+    Compute(i, start_oc, end_oc);
+  }
+  return RET_OK;
+}
+}  // namespace mindspore::kernel
+#endif
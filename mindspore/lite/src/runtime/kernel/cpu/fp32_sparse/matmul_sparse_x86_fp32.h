@@ -0,0 +1,57 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_SPARSE_X86_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_SPARSE_X86_FP32_H_
+
+#ifdef ENABLE_AVX
+#include <vector>
+#include "src/runtime/kernel/cpu/fp32/matmul_fp32_base.h"
+#include "nnacl/fp32_sparse/matmul_sparse_x86_fp32.h"
+namespace mindspore::kernel {
+// fp32 matmul with a constant pruned weight, which is packed into a block-sparse or a 2:4 structured-sparse format.
+class MatmulSparseX86CPUKernel : public MatmulFp32BaseCPUKernel {
+ public:
+  MatmulSparseX86CPUKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                           const std::vector<lite::Tensor *> &outputs, const mindspore::lite::InnerContext *ctx,
+                           SparseWeightFormat sparse_format)
+      : MatmulFp32BaseCPUKernel(parameter, inputs, outputs, ctx), sparse_format_(sparse_format) {}
+  ~MatmulSparseX86CPUKernel() = default;
+
+  void InitGlobalVariable() override;
+  int PackMatrixBImpl() override;
+  int GetMatrixBPackSize() const override;
+  int ParallelRunByBatch(int task_id) const override;
+  int ParallelRunByOC(int task_id) const override;
+  int ParallelRunIsNotPackByBatch(int task_id) const override;
+
+  // returns SparseWeightFormat_None when the weight is not constant or the sparse gemm is not expected to be faster
+  // than the dense one.
+  static SparseWeightFormat SelectSparseFormat(const std::vector<lite::Tensor *> &inputs,
+                                               const MatMulParameter *param);
+
+ private:
+  const float *GetMatrixBSource() const;
+  void Compute(int batch_index, int start_oc, int end_oc) const;
+
+  SparseWeightFormat sparse_format_ = SparseWeightFormat_None;
+  MatmulSparseFunc matmul_func_ = nullptr;
+  size_t pack_size_ = 0;  // in bytes
+};
+}  // namespace mindspore::kernel
+#endif
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_MATMUL_SPARSE_X86_FP32_H_
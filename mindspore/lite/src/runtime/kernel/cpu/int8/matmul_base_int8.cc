@@ -33,11 +33,11 @@ int MatmulBaseInt8Run(void *cdata, int task_id, float, float) {
   return RET_OK;
 }
 
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64))
-int Arm64SdotPreRun(void *cdata, int task_id, float, float) {
+#ifdef MATMUL_INT8_DOT_PRODUCT
+int DotProductPreRun(void *cdata, int task_id, float, float) {
   CHECK_NULL_RETURN(cdata);
   auto op = reinterpret_cast<MatmulBaseInt8CPUKernel *>(cdata);
-  auto ret = op->Arm64SdotPre(task_id);
+  auto ret = op->DotProductPre(task_id);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "MatmulInt8Run error task_id[" << task_id << "] error_code[" << ret << "]";
     return ret;
@@ -45,10 +45,10 @@ int Arm64SdotPreRun(void *cdata, int task_id, float, float) {
   return RET_OK;
 }
 
-int Arm64SdotRun(void *cdata, int task_id, float, float) {
+int DotProductRun(void *cdata, int task_id, float, float) {
   CHECK_NULL_RETURN(cdata);
   auto op = reinterpret_cast<MatmulBaseInt8CPUKernel *>(cdata);
-  auto ret = op->Arm64SdotImpl(task_id);
+  auto ret = op->DotProductImpl(task_id);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "MatmulInt8Run error task_id[" << task_id << "] error_code[" << ret << "]";
     return ret;
@@ -56,7 +56,7 @@ int Arm64SdotRun(void *cdata, int task_id, float, float) {
   return RET_OK;
 }
 
-int MatmulBaseInt8CPUKernel::Arm64SdotPre(int task_id) {
+int MatmulBaseInt8CPUKernel::DotProductPre(int task_id) {
   int row_thread_count = MSMIN(op_parameter_->thread_num_, UP_DIV(param_->row_align_, row_tile_));
   int row_stride = UP_DIV(UP_DIV(param_->row_align_, row_tile_), row_thread_count) * row_tile_;
 
@@ -82,7 +82,7 @@ int MatmulBaseInt8CPUKernel::Arm64SdotPre(int task_id) {
   return RET_OK;
 }
 
-int MatmulBaseInt8CPUKernel::Arm64SdotImpl(int task_id) {
+int MatmulBaseInt8CPUKernel::DotProductImpl(int task_id) {
   int stride = thread_stride_ * col_tile_;
   int cur_stride = task_id * stride;
   int res_stride = param_->col_ - cur_stride;
@@ -115,10 +115,18 @@ int MatmulBaseInt8CPUKernel::Arm64SdotImpl(int task_id) {
     filter_per_channel_ ? quant_param_->quant_multiplier_ + cur_stride : quant_param_->quant_multiplier_;
   int32_t *cur_zp = filter_per_channel_ ? quant_param_->filter_zp_ + cur_stride : quant_param_->filter_zp_;
 
+#ifdef ENABLE_AVX
+  CHECK_NULL_RETURN(matmul_dp_func_);
+  matmul_dp_func_(pack_a_ptr_, batch_b_ptr_ + cur_stride * param_->deep_align_, batch_c_ptr_ + cur_stride, param_->row_,
+                  cur_oc, param_->deep_align_, param_->col_, input_sums_, batch_sums_ + cur_stride, cur_left, cur_right,
+                  cur_mul, quant_param_->output_.zp_, quant_param_->out_act_min_, quant_param_->out_act_max_,
+                  filter_per_channel_, cur_zp);
+#else
   MatmulInt8DpOpt(pack_a_ptr_, batch_b_ptr_ + cur_stride * param_->deep_align_, batch_c_ptr_ + cur_stride, param_->row_,
                   cur_oc, param_->deep_align_, input_sums_, batch_sums_ + cur_stride, quant_param_->out_act_min_,
                   quant_param_->out_act_max_, quant_param_->output_.zp_, cur_mul, cur_left, cur_right, param_->col_,
                   filter_per_channel_, cur_zp);
+#endif
 
   return RET_OK;
 }
@@ -269,15 +277,21 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
   col_tile_ = C2NUM;
   deep_tile_ = C16NUM;
 #elif ENABLE_ARM64
-  support_sdot_ = mindspore::lite::IsSupportSDot();
+  support_dot_product_ = mindspore::lite::IsSupportSDot();
   row_tile_ = C4NUM;
-  if (support_sdot_) {
+  if (support_dot_product_) {
     col_tile_ = C16NUM;
     deep_tile_ = C4NUM;
   } else {
     col_tile_ = C4NUM;
     deep_tile_ = C16NUM;
   }
+#elif ENABLE_AVX
+  support_dot_product_ = true;
+  matmul_dp_func_ = GetMatmulInt8DpAvxFunc();
+  row_tile_ = C4NUM;
+  col_tile_ = C16NUM;
+  deep_tile_ = C4NUM;
 #else
   row_tile_ = C4NUM;
   col_tile_ = C4NUM;
@@ -292,11 +306,13 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
 #ifdef ENABLE_ARM32
     b_pack_func_ = RowMajor2Row2x16MajorInt8;
 #elif ENABLE_ARM64
-    if (support_sdot_) {
+    if (support_dot_product_) {
       b_pack_func_ = RowMajor2Row4x16MajorInt8;
     } else {
       b_pack_func_ = RowMajor2Row16x4MajorInt8;
     }
+#elif ENABLE_AVX
+    b_pack_func_ = RowMajor2Row4x16MajorInt8;
 #else
     b_pack_func_ = RowMajor2Row16x4MajorInt8;
 #endif
@@ -304,11 +320,13 @@ void MatmulBaseInt8CPUKernel::InitParameter() {
 #ifdef ENABLE_ARM32
     b_pack_func_ = RowMajor2Col16x2MajorInt8;
 #elif ENABLE_ARM64
-    if (support_sdot_) {
+    if (support_dot_product_) {
       b_pack_func_ = RowMajor2Col4x16MajorInt8;
     } else {
       b_pack_func_ = RowMajor2Col16x4MajorInt8;
     }
+#elif ENABLE_AVX
+    b_pack_func_ = RowMajor2Col4x16MajorInt8;
 #else
     b_pack_func_ = RowMajor2Col16x4MajorInt8;
 #endif
@@ -456,8 +474,8 @@ int MatmulBaseInt8CPUKernel::ReSize() {
   return RET_OK;
 }
 
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64))
-int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
+#ifdef MATMUL_INT8_DOT_PRODUCT
+int MatmulBaseInt8CPUKernel::RunDotProduct() {
   int8_t *a_ptr = reinterpret_cast<int8_t *>(in_tensors_.at(0)->data());
   int8_t *b_ptr = reinterpret_cast<int8_t *>(in_tensors_.at(1)->data());
   int8_t *c_ptr = reinterpret_cast<int8_t *>(out_tensors_.at(0)->data());
@@ -467,9 +485,9 @@ int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
 
   for (int i = 0; i < param_->batch; i++) {
     batch_input_ptr_ = a_ptr + i * param_->row_ * param_->deep_;
-    auto ret = ParallelLaunch(this->ms_context_, Arm64SdotPreRun, this, op_parameter_->thread_num_);
+    auto ret = ParallelLaunch(this->ms_context_, DotProductPreRun, this, op_parameter_->thread_num_);
     if (ret != RET_OK) {
-      MS_LOG(ERROR) << "Arm64SdotPreRun error: [" << ret << "]";
+      MS_LOG(ERROR) << "DotProductPreRun error: [" << ret << "]";
       return ret;
     }
 
@@ -478,9 +496,9 @@ int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
     batch_sums_ = weight_bias_sums_ + i * param_->col_align_;
     batch_c_ptr_ = c_ptr + i * param_->row_ * param_->col_;
 
-    ret = ParallelLaunch(this->ms_context_, Arm64SdotRun, this, thread_count_);
+    ret = ParallelLaunch(this->ms_context_, DotProductRun, this, thread_count_);
     if (ret != RET_OK) {
-      MS_LOG(ERROR) << "Arm64SdotRun error: [" << ret << "]";
+      MS_LOG(ERROR) << "DotProductRun error: [" << ret << "]";
       return ret;
     }
   }
@@ -489,9 +507,9 @@ int MatmulBaseInt8CPUKernel::RunArm64Sdot() {
 #endif
 
 int MatmulBaseInt8CPUKernel::Run() {
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64))
-  if (support_sdot_) {
-    return RunArm64Sdot();
+#ifdef MATMUL_INT8_DOT_PRODUCT
+  if (support_dot_product_) {
+    return RunDotProduct();
   }
 #endif
   if (param_->b_const_ == false) {
@@ -26,6 +26,16 @@
 #include "nnacl/int8/quantize.h"
 #include "nnacl/int8/common_func_int8.h"
 #include "nnacl/int8/matmul_int8.h"
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#endif
+
+// the kernel runs in row4x4 * row4x16 layout, which is computed by arm64 sdot or x86 avx2/avx512.
+#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && !defined(SUPPORT_34XX) && (!defined(MACHINE_LINUX_ARM64))
+#define MATMUL_INT8_DOT_PRODUCT
+#elif defined(ENABLE_AVX)
+#define MATMUL_INT8_DOT_PRODUCT
+#endif
 
 namespace mindspore::kernel {
 class MatmulBaseInt8CPUKernel : public LiteKernel {
@@ -44,10 +54,10 @@ class MatmulBaseInt8CPUKernel : public LiteKernel {
 
  public:
   int RunImpl(int task_id);
-#if defined(ENABLE_ARM64) && !defined(SUPPORT_NNIE) && (!defined(MACHINE_LINUX_ARM64))
-  int RunArm64Sdot();
-  int Arm64SdotImpl(int task_id);
-  int Arm64SdotPre(int task_id);
+#ifdef MATMUL_INT8_DOT_PRODUCT
+  int RunDotProduct();
+  int DotProductImpl(int task_id);
+  int DotProductPre(int task_id);
 #endif
 
  protected:
@@ -87,7 +97,10 @@ class MatmulBaseInt8CPUKernel : public LiteKernel {
   int col_tile_ = C4NUM;
   int deep_tile_ = C16NUM;
   int channel_num_ = 0;
-  bool support_sdot_ = false;
+  bool support_dot_product_ = false;
+#ifdef ENABLE_AVX
+  MatmulInt8DpFunc matmul_dp_func_{nullptr};
+#endif
   PackFunc a_pack_func_{nullptr};
   PackFunc b_pack_func_{nullptr};
 };
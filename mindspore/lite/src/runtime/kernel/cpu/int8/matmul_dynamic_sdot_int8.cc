@@ -90,6 +90,9 @@ int MatMulDynamicSdotInt8Kernel::MatMulDynamicArm64SdotImpl(int task_id) {
   if (cur_oc <= 0) {
     return RET_OK;
   }
+#ifdef ENABLE_AVX
+  CHECK_NULL_RETURN(dynamic_matmul_dp_func_);
+#endif
   auto current_sums = batch_sums_ + cur_stride;
   if (!param_->b_const_) {
     auto current_b_pack = batch_b_ptr_ + cur_stride * param_->deep_align_;
@@ -132,6 +135,10 @@ int MatMulDynamicSdotInt8Kernel::MatMulDynamicArm64SdotImpl(int task_id) {
       DynamicMatmulSdot4x4x16AIWI(a_ptr, b_ptr, out_ptr, param_->deep_align_, multi_scale.data() + c, bias, row, col,
                                   out_stride, input_sums_ptr, weight_sums_ptr, quant_param_->input_zp_,
                                   quant_param_->filter_zp_[0] * param_->deep_);
+#elif defined(ENABLE_AVX)
+      dynamic_matmul_dp_func_(a_ptr, b_ptr, out_ptr, param_->deep_align_, multi_scale.data() + c, bias, row, col,
+                              out_stride, input_sums_ptr, weight_sums_ptr, quant_param_->input_zp_,
+                              quant_param_->filter_zp_[0] * param_->deep_);
 #else
       DynamicMatmul4x4x16AIWI(a_ptr, b_ptr, out_ptr, param_->deep_align_, multi_scale.data() + c, bias, row, col,
                               out_stride, input_sums_ptr, weight_sums_ptr, quant_param_->input_zp_,
@@ -149,6 +156,9 @@ void MatMulDynamicSdotInt8Kernel::InitParameter() {
   row_tile_ = C4NUM;
   col_tile_ = C16NUM;
   deep_tile_ = C4NUM;
+#ifdef ENABLE_AVX
+  dynamic_matmul_dp_func_ = GetDynamicMatmulInt8DpAvxFunc();
+#endif
 
   if (param_->b_transpose_) {
     b_pack_func_ = RowMajor2Row4x16MajorInt8;
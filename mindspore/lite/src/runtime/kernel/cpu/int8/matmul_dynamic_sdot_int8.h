@@ -19,8 +19,12 @@
 
 #include <vector>
 #include "src/runtime/kernel/cpu/int8/matmul_dynamic_base_int8.h"
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#endif
 
 namespace mindspore::kernel {
+// row4x4 * row4x16 layout kernel, computed by arm64 sdot or x86 avx2/avx512.
 class MatMulDynamicSdotInt8Kernel : public MatmulDynamicBaseInt8CPUKernel {
  public:
   MatMulDynamicSdotInt8Kernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
@@ -39,6 +43,9 @@ class MatMulDynamicSdotInt8Kernel : public MatmulDynamicBaseInt8CPUKernel {
 
  private:
   int *batch_sums_ = nullptr;
+#ifdef ENABLE_AVX
+  DynamicMatmulInt8DpFunc dynamic_matmul_dp_func_{nullptr};
+#endif
 };
 }  // namespace mindspore::kernel
 
@@ -92,7 +92,12 @@ kernel::LiteKernel *MatmulInt8CPUKernelCreator(const std::vector<lite::Tensor *>
       MS_LOG(ERROR) << "kernel: " << parameter->name_ << " is unsupported A is const.";
       return nullptr;
     }
-    if (lite::IsSupportSDot()) {
+#ifdef ENABLE_AVX
+    bool support_dot_product = true;
+#else
+    bool support_dot_product = lite::IsSupportSDot();
+#endif
+    if (support_dot_product) {
       kernel = new (std::nothrow)
         MatMulDynamicSdotInt8Kernel(parameter, inputs, outputs, static_cast<const lite::InnerContext *>(ctx));
     } else {
@@ -51,6 +51,10 @@ int MatMulOpenCLKernel::CheckSpecs() {
     return RET_ERROR;
   }
   auto param = reinterpret_cast<MatMulParameter *>(op_parameter_);
+  if (param->epilogue_ != MatmulEpilogue_None) {
+    MS_LOG(WARNING) << "matmul not support the fused epilogue.";
+    return RET_ERROR;
+  }
   transposeA = param->a_transpose_;
   if (transposeA) {
     MS_LOG(WARNING) << "matmul only support a_transpose_=false yet.";
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_EXEC_H_
 #define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_EXEC_H_
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
@@ -93,9 +94,16 @@ class KernelExec {
 
   virtual ~KernelExec() = default;
 
-  virtual int Execute() { return DoExecute(); }
+  virtual int Execute() { return Execute(nullptr, nullptr); }
 
   virtual int Execute(const KernelCallBack &before, const KernelCallBack &after) {
+    if (acquire_inputs_ != nullptr) {
+      auto ret = acquire_inputs_();
+      if (ret != lite::RET_OK) {
+        MS_LOG(ERROR) << "acquire inputs failed, name: " << this->name();
+        return ret;
+      }
+    }
     if (before != nullptr) {
       if (!before(this->in_tensors(), this->out_tensors(),
                   {this->name(), schema::EnumNamePrimitiveType(this->type())})) {
@@ -111,9 +119,19 @@ class KernelExec {
         MS_LOG(WARNING) << "run kernel after_callback failed, name: " << this->name();
       }
     }
+    if (release_inputs_ != nullptr) {
+      release_inputs_();
+    }
     return ret;
   }
 
+  // acquire makes the inputs ready right before the kernel runs, such as decoding the lazily decoded weights, and its
+  // failure is returned without running the kernel. release is called after the kernel and the after callback.
+  void set_input_hooks(const std::function<int()> &acquire, const std::function<void()> &release) {
+    acquire_inputs_ = acquire;
+    release_inputs_ = release;
+  }
+
   // called while compiling graph
   virtual int Prepare() {
     MS_ASSERT(kernel_ != nullptr);
@@ -387,6 +405,8 @@ class KernelExec {
   SubGraphType subgraph_type_ = kNotSubGraph;
   const lite::InnerContext *context_ = nullptr;
   bool enable_gl_texture_ = false;
+  std::function<int()> acquire_inputs_ = nullptr;
+  std::function<void()> release_inputs_ = nullptr;
 };
 
 typedef LiteKernel *(*KernelCreator)(const std::vector<lite::Tensor *> &inputs,
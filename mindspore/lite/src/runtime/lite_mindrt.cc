@@ -44,7 +44,11 @@ void LiteOpActor::RunOpData(OpData<lite::Tensor> *inputs, OpContext<lite::Tensor
     context->SetFailed(ret);
     return;
   }
-  AsyncOutput(context);
+  if (pipeline_slot_num_ > 0) {
+    StagePipelineOutput(context);
+  } else {
+    AsyncOutput(context);
+  }
   SetOutputData(context);
   return;
 }
@@ -352,6 +356,84 @@ void LiteOpActor::AsyncOutput(OpContext<Tensor> *context) {
   }
 }
 
+int LiteOpActor::PreparePipeline(size_t slot_num) {
+  if (pipeline_outputs_.size() == slot_num) {
+    return RET_OK;
+  }
+  if ((kernel_->subgraph_type() != kernel::kCpuFP32SubGraph && kernel_->subgraph_type() != kernel::kCpuFP16SubGraph) ||
+      call_node_ != nullptr || partial_node_ != nullptr) {
+    MS_LOG(INFO) << "Pipeline is only supported by cpu subgraph without control flow, actor: " << GetAID();
+    return RET_NOT_SUPPORT;
+  }
+  pipeline_outputs_.clear();
+  pipeline_outputs_data_.clear();
+  for (size_t slot = 0; slot < slot_num; ++slot) {
+    std::vector<std::unique_ptr<Tensor>> outputs;
+    for (auto *tensor : kernel_->out_tensors()) {
+      if (tensor->data_type() == kObjectTypeTensorType || tensor->allocator() == nullptr) {
+        MS_LOG(INFO) << "Pipeline is not supported by output: " << tensor->tensor_name();
+        pipeline_outputs_.clear();
+        pipeline_outputs_data_.clear();
+        return RET_NOT_SUPPORT;
+      }
+      auto output =
+        std::make_unique<Tensor>(tensor->data_type(), tensor->shape(), tensor->format(), tensor->category());
+      output->set_tensor_name(tensor->tensor_name() + "_pipeline_" + std::to_string(slot));
+      for (LiteQuantParam quant : tensor->quant_params()) {
+        output->AddQuantParam(quant);
+      }
+      outputs.push_back(std::move(output));
+    }
+    std::vector<OpDataPtr<Tensor>> outputs_data;
+    for (auto &arrow : output_data_arrows_) {
+      auto data = std::make_shared<OpData<Tensor>>(this->GetAID(), outputs.at(arrow->from_output_index_).get(),
+                                                   static_cast<int>(arrow->to_input_index_));
+      outputs_data.push_back(data);
+    }
+    pipeline_outputs_.push_back(std::move(outputs));
+    pipeline_outputs_data_.push_back(outputs_data);
+  }
+  return RET_OK;
+}
+
+Tensor *LiteOpActor::GetPipelineOutput(size_t slot, const Tensor *tensor) const {
+  auto &out_tensors = kernel_->out_tensors();
+  auto iter = std::find(out_tensors.begin(), out_tensors.end(), tensor);
+  if (slot >= pipeline_outputs_.size() || iter == out_tensors.end()) {
+    return nullptr;
+  }
+  return pipeline_outputs_[slot].at(iter - out_tensors.begin()).get();
+}
+
+void LiteOpActor::StagePipelineOutput(OpContext<Tensor> *context) {
+  auto slot = static_cast<size_t>(context->sequential_num_) % pipeline_slot_num_;
+  auto &outputs = pipeline_outputs_.at(slot);
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    auto src_tensor = kernel_->out_tensors()[i];
+    auto dst_tensor = outputs[i].get();
+    dst_tensor->set_data_type(src_tensor->data_type());
+    dst_tensor->set_shape(src_tensor->shape());
+    dst_tensor->set_format(src_tensor->format());
+    // the slot is reused after its former micro-batch finished, data left here is not consumed by anyone.
+    dst_tensor->FreeData();
+    if (src_tensor->data() == nullptr) {
+      continue;
+    }
+    // the buffer is moved to the slot, the kernel output is left empty and mallocs a new buffer for the next run.
+    dst_tensor->set_allocator(src_tensor->allocator());
+    dst_tensor->set_data(src_tensor->data());
+    dst_tensor->set_own_data(src_tensor->own_data());
+    dst_tensor->set_ref_count(src_tensor->ref_count());
+    src_tensor->set_data(nullptr);
+    src_tensor->set_ref_count(0);
+  }
+  auto &outputs_data = pipeline_outputs_data_.at(slot);
+  for (size_t i = 0; i < output_data_arrows_.size(); ++i) {
+    Async(output_data_arrows_[i]->to_op_id_, get_actor_mgr(), &mindspore::OpActor<Tensor>::RunOpData,
+          outputs_data[i].get(), context);
+  }
+}
+
 void LiteOpActor::AddResultIndex(size_t index) { results_index_.push_back(index); }
 
 void LiteOpActor::SetOutputData(OpContext<Tensor> *context) {
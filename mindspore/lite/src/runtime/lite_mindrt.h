@@ -62,6 +62,12 @@ class LiteOpActor : public OpActor<lite::Tensor> {
                       std::unordered_map<Tensor *, Tensor *> *input_map);
   virtual int PostInit();
   int ResizeGraphInput(const std::vector<mindspore::lite::Tensor *> &inputs, const std::vector<std::vector<int>> &dims);
+  // create slot_num groups of output tensors, the outputs of a micro-batch are moved into the group of its slot after
+  // the kernel runs, so the kernel can run the next micro-batch before the consumers take the outputs.
+  int PreparePipeline(size_t slot_num);
+  // slot of a micro-batch is its sequential num modulo slot_num, 0 means the actor is not pipelined.
+  void set_pipeline_slot_num(size_t slot_num) { pipeline_slot_num_ = slot_num; }
+  Tensor *GetPipelineOutput(size_t slot, const Tensor *tensor) const;
 
  public:
   void AddResultIndex(size_t index);
@@ -80,6 +86,7 @@ class LiteOpActor : public OpActor<lite::Tensor> {
   virtual void InitInputData();
   void SetOutputData(OpContext<Tensor> *context);
   virtual void AsyncOutput(OpContext<Tensor> *context);
+  void StagePipelineOutput(OpContext<Tensor> *context);
 
   int CompileArrowThroughOutputTensors(
     const std::unordered_map<void *, std::set<std::pair<AID, size_t>>> &receivers_map);
@@ -94,6 +101,11 @@ class LiteOpActor : public OpActor<lite::Tensor> {
   std::vector<Tensor *> inputs_data_{};
   std::unordered_map<Tensor *, Tensor *> *isolate_input_map_ = nullptr; /* real obj in session */
   lite::InnerContext *ctx_ = nullptr;
+  size_t pipeline_slot_num_ = 0;
+  // [slot][output index]
+  std::vector<std::vector<std::unique_ptr<Tensor>>> pipeline_outputs_{};
+  // [slot][arrow index]
+  std::vector<std::vector<OpDataPtr<Tensor>>> pipeline_outputs_data_{};
 
  private:
   int CreateCommonArrow(const std::unordered_map<void *, std::set<std::pair<AID, size_t>>> &receivers_map,
@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/lite_session.h"
+#include <algorithm>
 #include <set>
 #include "src/runtime/pack_weight_manager.h"
 #include "src/runtime/runtime_pass.h"
@@ -572,6 +573,13 @@ int LiteSession::CompileGraph(Model *model) {
 
   FreePackOpWeight(kernels_);
 
+  ret = InitWeightDecodeCache(model);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init weight decode cache failed.";
+    is_running_.store(false);
+    return ret;
+  }
+
   ret = RuntimeAllocatorInit();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Runtime allocator init failed.";
@@ -579,6 +587,13 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
 
+  ret = InitSubGraphMemo();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init subgraph memo failed.";
+    is_running_.store(false);
+    return ret;
+  }
+
   is_running_.store(false);
 #if defined(LINUX_RUNTIME)
   (void)malloc_trim(0);
@@ -731,6 +746,40 @@ int LiteSession::RunGraph(const KernelCallBack &before, const KernelCallBack &af
   return ret;
 }
 
+int LiteSession::RunGraphPipeline(size_t micro_batch_num, const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch,
+                                  const KernelCallBack &before, const KernelCallBack &after) {
+  bool expected = false;
+  if (!is_running_.compare_exchange_strong(expected, true)) {
+    MS_LOG(ERROR) << "Not support multi-threading";
+    return RET_ERROR;
+  }
+  if (weight_decode_cache_ != nullptr) {
+    MS_LOG(ERROR) << "Pipeline is not supported with lazily decoded weights.";
+    is_running_.store(false);
+    return RET_NOT_SUPPORT;
+  }
+  MS_ASSERT(this->executor_ != nullptr);
+  auto check_feed = [this, &feed](size_t index) {
+    auto ret = feed(index);
+    if (ret != RET_OK) {
+      return ret;
+    }
+    ret = CheckTensorsInvalid(inputs_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "CheckInputs failed.";
+      return ret;
+    }
+    return CheckGraphInputShapes(inputs_, input_shape_map_);
+  };
+  auto ret = executor_->RunPipeline(this->inputs_, this->outputs_, this->kernels_, micro_batch_num, check_feed, fetch,
+                                    before, after);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "RunGraphPipeline failed : " << ret;
+  }
+  is_running_.store(false);
+  return ret;
+}
+
 int LiteSession::ContextInit(InnerContext *context) {
   if (context == nullptr) {
     MS_LOG(ERROR) << "context is nullptr";
@@ -905,6 +954,12 @@ LiteSession::~LiteSession() {
     MS_LOG(ERROR) << "Not support multi-threading";
     return;
   }
+  // stop prefetching before tensors are destroyed.
+  weight_decode_cache_.reset();
+  if (subgraph_memo_ != nullptr) {
+    MS_LOG(INFO) << "Subgraph memo hit: " << subgraph_memo_->hit_count() << ", miss: " << subgraph_memo_->miss_count();
+    subgraph_memo_.reset();
+  }
   for (auto *kernel : kernels_) {
     delete kernel;
     kernel = nullptr;
@@ -1265,6 +1320,31 @@ int LiteSession::InitExecutor() {
     MS_LOG(ERROR) << "Prepare executor failed: " << ret;
     return ret;
   }
+  return InitInterOpParallel();
+}
+
+int LiteSession::InitInterOpParallel() {
+  if (config_info_ == nullptr || is_control_flow_ || context_->enable_parallel_) {
+    return RET_OK;
+  }
+  auto section_iter = config_info_->find(kInterOpParallel);
+  if (section_iter == config_info_->end()) {
+    return RET_OK;
+  }
+  auto enable_iter = section_iter->second.find(kInterOpParallelEnable);
+  if (enable_iter == section_iter->second.end() || enable_iter->second != "true") {
+    return RET_OK;
+  }
+  for (auto kernel : kernels_) {
+    if (kernel->subgraph_type() != kernel::kCpuFP32SubGraph && kernel->subgraph_type() != kernel::kCpuFP16SubGraph) {
+      continue;
+    }
+    auto ret = static_cast<kernel::CpuSubGraph *>(kernel)->InitParallelExecutor(context_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Init inter op parallel failed, subgraph: " << kernel->name();
+      return ret;
+    }
+  }
   return RET_OK;
 }
 
@@ -1633,6 +1713,180 @@ std::string lite::LiteSession::ParseWeightPath() {
   return weight_path;
 }
 
+namespace {
+constexpr size_t kDefaultWeightDecodeCacheSize = 64;  // MB
+constexpr size_t kDefaultSubGraphMemoCacheSize = 16;  // MB
+constexpr size_t kMBShift = 20;
+
+bool IsLazyDecodeKernel(const kernel::KernelExec *kernel) {
+  // weights of the other kernels are packed in Prepare and the origin data is not accessed any more.
+  return kernel->subgraph_type() == kernel::kNotSubGraph &&
+         (kernel->type() == schema::PrimitiveType_Gather || kernel->type() == schema::PrimitiveType_GatherNd);
+}
+}  // namespace
+
+// the weights have been decoded by ConvertTensors since the const tensors must hold data during scheduling, the cache
+// releases them here and only bounds the decoded weight memory of running the graph.
+int lite::LiteSession::InitWeightDecodeCache(const Model *model) {
+  if (config_info_ == nullptr || model->model_type_ != ModelType_MSLite) {
+    return RET_OK;
+  }
+  auto ms_weight = config_info_->find(kWeight);
+  if (ms_weight == config_info_->end()) {
+    return RET_OK;
+  }
+  auto lazy_decode_iter = ms_weight->second.find(kWeightLazyDecode);
+  if (lazy_decode_iter == ms_weight->second.end() || lazy_decode_iter->second != "true") {
+    return RET_OK;
+  }
+  size_t cache_size = kDefaultWeightDecodeCacheSize;
+  auto cache_size_iter = ms_weight->second.find(kWeightDecodeCacheSize);
+  if (cache_size_iter != ms_weight->second.end()) {
+    auto cache_size_opt = GenericParseValue<size_t>(cache_size_iter->second);
+    if (cache_size_opt.IsNone()) {
+      MS_LOG(ERROR) << "Invalid decode cache size: " << cache_size_iter->second;
+      return RET_ERROR;
+    }
+    cache_size = cache_size_opt.Get();
+  }
+
+  std::vector<kernel::KernelExec *> nodes;
+  for (auto *kernel : kernels_) {
+    if (kernel->subgraph_type() == kernel::kNotSubGraph) {
+      nodes.push_back(kernel);
+    } else {
+      auto &sub_nodes = reinterpret_cast<kernel::SubGraphKernel *>(kernel)->nodes();
+      nodes.insert(nodes.end(), sub_nodes.begin(), sub_nodes.end());
+    }
+  }
+  std::unordered_map<Tensor *, std::vector<kernel::KernelExec *>> consumers;
+  for (auto *node : nodes) {
+    for (auto *tensor : node->in_tensors()) {
+      consumers[tensor].push_back(node);
+    }
+  }
+
+  auto lite_model = reinterpret_cast<const lite::LiteModel *>(model);
+  auto cache = std::make_unique<WeightDecodeCache>(cache_size << kMBShift);
+  std::set<Tensor *> lazy_tensors;
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    auto *tensor = tensors_[i];
+    auto iter = consumers.find(tensor);
+    if (tensor == nullptr || !tensor->IsConst() || !tensor->own_data() || iter == consumers.end() ||
+        !std::all_of(iter->second.begin(), iter->second.end(), IsLazyDecodeKernel)) {
+      continue;
+    }
+    auto src_tensor = lite_model->GetSchemaTensor(i);
+    // only the weights expanded by decoding are worth releasing.
+    if (src_tensor == nullptr || src_tensor->handler() == nullptr || src_tensor->data() == nullptr ||
+        src_tensor->length() >= tensor->Size()) {
+      continue;
+    }
+    auto *consumer = iter->second.front();
+    if (consumer->op_parameter() == nullptr) {
+      continue;
+    }
+    auto input_index =
+      std::find(consumer->in_tensors().begin(), consumer->in_tensors().end(), tensor) - consumer->in_tensors().begin();
+    auto preferred_dim = WeightDecoder::GetPreferredDim(consumer->in_tensors(), consumer->op_parameter(),
+                                                        static_cast<int>(input_index), tensor->shape(),
+                                                        model->graph_.version_);
+    auto src_data_type = static_cast<TypeId>(src_tensor->handler()->dataType());
+    auto dst_data_type = tensor->data_type();
+    auto shape = tensor->shape();
+    auto format = tensor->format();
+    auto decode_func = [src_tensor, src_data_type, dst_data_type, shape, format, preferred_dim]() -> void * {
+      Tensor decode_tensor(src_data_type, shape, format, Category::CONST_TENSOR);
+      ConvertTensorsQuantParam(src_tensor->handler(), &decode_tensor);
+      if (WeightDecoder::DecodeWeight(*src_tensor, preferred_dim, dst_data_type, &decode_tensor) != RET_OK) {
+        return nullptr;
+      }
+      auto data = decode_tensor.data();
+      decode_tensor.set_own_data(false);
+      return data;
+    };
+    auto ret = cache->Register(tensor, tensor->Size(), decode_func);
+    if (ret == RET_NOT_SUPPORT) {
+      continue;
+    }
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Register lazily decoded weight failed: " << tensor->tensor_name();
+      return ret;
+    }
+    lazy_tensors.insert(tensor);
+  }
+  if (lazy_tensors.empty()) {
+    return RET_OK;
+  }
+  std::vector<std::vector<Tensor *>> kernel_weights;
+  auto cache_ptr = cache.get();
+  for (auto *node : nodes) {
+    std::vector<Tensor *> weights;
+    for (auto *tensor : node->in_tensors()) {
+      if (lazy_tensors.find(tensor) != lazy_tensors.end()) {
+        weights.push_back(tensor);
+      }
+    }
+    if (!weights.empty()) {
+      // the weights are decoded right before the kernel runs, and a failed decoding fails the kernel.
+      node->set_input_hooks([cache_ptr, weights]() { return cache_ptr->Acquire(weights); },
+                            [cache_ptr, weights]() { cache_ptr->Release(weights); });
+      kernel_weights.push_back(weights);
+    }
+  }
+  cache->SetExecutionOrder(kernel_weights);
+  MS_LOG(INFO) << "Lazily decoded weight num: " << lazy_tensors.size() << ", cache size: " << cache_size << "MB";
+  weight_decode_cache_ = std::move(cache);
+  return RET_OK;
+}
+
+int lite::LiteSession::InitSubGraphMemo() {
+  if (config_info_ == nullptr) {
+    return RET_OK;
+  }
+  auto memo_config = config_info_->find(kSubGraphMemo);
+  if (memo_config == config_info_->end()) {
+    return RET_OK;
+  }
+  auto enable_iter = memo_config->second.find(kSubGraphMemoEnable);
+  if (enable_iter == memo_config->second.end() || enable_iter->second != "true") {
+    return RET_OK;
+  }
+  // tensors of runtime allocator share one buffer, and the inputs of control flow subgraphs are not their own.
+  if (runtime_allocator_ != nullptr || is_control_flow_) {
+    MS_LOG(WARNING) << "Subgraph memo is not supported with runtime allocator or control flow.";
+    return RET_OK;
+  }
+  size_t cache_size = kDefaultSubGraphMemoCacheSize;
+  auto cache_size_iter = memo_config->second.find(kSubGraphMemoCacheSize);
+  if (cache_size_iter != memo_config->second.end()) {
+    auto cache_size_opt = GenericParseValue<size_t>(cache_size_iter->second);
+    if (cache_size_opt.IsNone()) {
+      MS_LOG(ERROR) << "Invalid subgraph memo cache size: " << cache_size_iter->second;
+      return RET_ERROR;
+    }
+    cache_size = cache_size_opt.Get();
+  }
+
+  auto memo = std::make_unique<SubGraphMemo>(cache_size << kMBShift);
+  size_t memo_subgraph_num = 0;
+  for (auto *kernel : kernels_) {
+    if (kernel->subgraph_type() != kernel::kCpuFP32SubGraph && kernel->subgraph_type() != kernel::kCpuFP16SubGraph) {
+      continue;
+    }
+    auto subgraph = reinterpret_cast<kernel::CpuSubGraph *>(kernel);
+    if (subgraph->is_pure()) {
+      subgraph->set_memo(memo.get());
+      memo_subgraph_num++;
+    }
+  }
+  MS_LOG(INFO) << "Memoized subgraph num: " << memo_subgraph_num << ", cache size: " << cache_size << "MB";
+  if (memo_subgraph_num > 0) {
+    subgraph_memo_ = std::move(memo);
+  }
+  return RET_OK;
+}
+
 int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, mindspore::ModelType model_type,
                                                 const size_t &buf_size) {
   size_t lite_buf_size = 0;
@@ -29,6 +29,8 @@
 #include "src/runtime/runtime_allocator.h"
 #include "schema/model_generated.h"
 #include "src/runtime/executor.h"
+#include "src/runtime/weight_decode_cache.h"
+#include "src/runtime/subgraph_memo.h"
 #include "src/tensor.h"
 #include "src/tensorlist.h"
 #include "include/api/delegate.h"
@@ -57,6 +59,11 @@ class LiteSession {
   virtual std::vector<mindspore::lite::Tensor *> GetInputs() const;
   virtual mindspore::lite::Tensor *GetInputsByTensorName(const std::string &name) const;
   virtual int RunGraph(const KernelCallBack &before = nullptr, const KernelCallBack &after = nullptr);
+  // run a stream of micro-batches, feed writes the inputs of a micro-batch into GetInputs() and fetch reads its
+  // outputs from GetOutputs(). With [pipeline] stage_num configured, a micro-batch enters the graph before the former
+  // one leaves it.
+  virtual int RunGraphPipeline(size_t micro_batch_num, const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch,
+                               const KernelCallBack &before = nullptr, const KernelCallBack &after = nullptr);
   virtual std::vector<mindspore::lite::Tensor *> GetOutputsByNodeName(const std::string &node_name) const;
   virtual std::vector<std::string> GetOutputTensorNames() const;
   virtual mindspore::lite::Tensor *GetOutputByTensorName(const std::string &tensor_name) const;
@@ -132,10 +139,13 @@ class LiteSession {
     const std::unordered_map<Tensor *, Tensor *> &isolate_input_map = std::unordered_map<Tensor *, Tensor *>());
   static void FreePackOpWeight(const std::vector<kernel::KernelExec *> &kernels);
   std::string ParseWeightPath();
+  int InitWeightDecodeCache(const Model *model);
+  int InitSubGraphMemo();
 
  private:
   int PreCheck(Model *model);
   int InitExecutor();
+  int InitInterOpParallel();
   void ResetInputsShape(const std::vector<std::vector<int>> &dims);
   int ContextInit(InnerContext *context);
   int CreateTensorRTDelegate();
@@ -198,6 +208,8 @@ class LiteSession {
   int delegate_device_type_ = -1;  // -1: not specified; 0: CPU; 1: GPU; 2: NPU
   std::map<std::string, TypeId> *execution_plan_ = nullptr;
   const std::map<std::string, std::map<std::string, std::string>> *config_info_ = nullptr;
+  std::unique_ptr<WeightDecodeCache> weight_decode_cache_ = nullptr;
+  std::unique_ptr<SubGraphMemo> subgraph_memo_ = nullptr;
   std::vector<kernel::KernelExec *> non_tail_call_kernels_;
 };
 }  // namespace lite
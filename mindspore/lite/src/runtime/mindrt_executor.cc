@@ -15,9 +15,11 @@
  */
 #include "src/runtime/mindrt_executor.h"
 #include <algorithm>
+#include <cstring>
 #include <list>
 #include <queue>
 #include <memory>
+#include <string>
 #include "src/runtime/lite_mindrt.h"
 #include "include/errorcode.h"
 #include "src/common/common.h"
@@ -248,34 +250,42 @@ int MindrtExecutor::TransferGraphOutput() {
     if (dst_tensor->data_type() == kNumberTypeGLUInt && src_tensor->data_type() == kNumberTypeGLUInt) {
       continue;
     }
-    dst_tensor->set_shape(src_tensor->shape());
-    /* dst tensor free in FreeOutputTensor */
-#ifdef ENABLE_FP16
-    if (src_tensor->data_type() == kNumberTypeFloat16) {
-      auto ret = dst_tensor->MallocData();
-      if (ret != RET_OK) {
-        MS_LOG(ERROR) << "MallocData failed";
-        return ret;
-      }
-      Fp16ToFloat32(reinterpret_cast<float16_t *>(src_tensor->MutableData()),
-                    reinterpret_cast<float *>(dst_tensor->data()), dst_tensor->ElementsNum());
-    } else {
-#endif
-      if (dst_tensor->allocator() != src_tensor->allocator()) {
-        dst_tensor->set_allocator(src_tensor->allocator());
-      }
-      if (src_tensor->allocator() != nullptr) {
-        dst_tensor->set_data(src_tensor->data());
-        dst_tensor->set_own_data(src_tensor->own_data());
-      } else {
-        dst_tensor->set_data(src_tensor->data());
-        src_tensor->set_data(nullptr);
-      }
+    auto ret = TransferOutputData(src_tensor, dst_tensor);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int MindrtExecutor::TransferOutputData(Tensor *src_tensor, Tensor *dst_tensor) {
+  dst_tensor->set_shape(src_tensor->shape());
+  /* dst tensor free in FreeOutputTensor */
 #ifdef ENABLE_FP16
+  if (src_tensor->data_type() == kNumberTypeFloat16) {
+    auto ret = dst_tensor->MallocData();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "MallocData failed";
+      return ret;
     }
+    Fp16ToFloat32(reinterpret_cast<float16_t *>(src_tensor->MutableData()),
+                  reinterpret_cast<float *>(dst_tensor->data()), dst_tensor->ElementsNum());
+  } else {
 #endif
-    src_tensor->DecRefCount();
+    if (dst_tensor->allocator() != src_tensor->allocator()) {
+      dst_tensor->set_allocator(src_tensor->allocator());
+    }
+    if (src_tensor->allocator() != nullptr) {
+      dst_tensor->set_data(src_tensor->data());
+      dst_tensor->set_own_data(src_tensor->own_data());
+    } else {
+      dst_tensor->set_data(src_tensor->data());
+      src_tensor->set_data(nullptr);
+    }
+#ifdef ENABLE_FP16
   }
+#endif
+  src_tensor->DecRefCount();
   return RET_OK;
 }
 
@@ -327,4 +337,201 @@ int MindrtExecutor::Run(const std::vector<Tensor *> &in_tensors, const std::vect
   thread_pool->SetSpinCountMinValue();
   return RET_OK;
 }
+
+int MindrtExecutor::PreparePipeline(const std::vector<Tensor *> &in_tensors) {
+  if (!pipeline_slots_.empty()) {
+    return RET_OK;
+  }
+  for (auto &actor : op_actors_) {
+    auto ret = actor->PreparePipeline(kPipelineSlotNum);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  std::vector<PipelineSlot> slots(kPipelineSlotNum);
+  for (size_t i = 0; i < kPipelineSlotNum; ++i) {
+    auto &slot = slots[i];
+    for (auto *tensor : in_tensors) {
+      auto input = std::make_unique<Tensor>(tensor->data_type(), tensor->shape(), tensor->format(), GRAPH_INPUT);
+      input->set_tensor_name(tensor->tensor_name() + "_pipeline_" + std::to_string(i));
+      slot.inputs.push_back(std::move(input));
+    }
+    for (auto &data : input_data_) {
+      size_t idx = std::find(in_tensors.begin(), in_tensors.end(), data->data_) - in_tensors.begin();
+      if (idx == in_tensors.size()) {
+        MS_LOG(ERROR) << "The input is not found.";
+        return RET_ERROR;
+      }
+      slot.input_data.push_back(std::make_shared<OpData<Tensor>>(data->op_id_, slot.inputs[idx].get(), data->index_));
+    }
+    for (auto tensor_map : *isolate_output_map_) {
+      auto src_tensor = tensor_map.first;
+      if (src_tensor->data_type() == kNumberTypeGLUInt || tensor_map.second->IsGraphInput()) {
+        MS_LOG(INFO) << "Pipeline is not supported by graph output: " << tensor_map.second->tensor_name();
+        return RET_NOT_SUPPORT;
+      }
+      Tensor *output = nullptr;
+      for (auto &actor : op_actors_) {
+        output = actor->GetPipelineOutput(i, src_tensor);
+        if (output != nullptr) {
+          break;
+        }
+      }
+      if (output == nullptr) {
+        MS_LOG(INFO) << "Pipeline is not supported by graph output: " << tensor_map.second->tensor_name();
+        return RET_NOT_SUPPORT;
+      }
+      slot.outputs.emplace_back(output, tensor_map.second);
+    }
+  }
+  pipeline_slots_ = std::move(slots);
+  return RET_OK;
+}
+
+int MindrtExecutor::FeedPipelineSlot(PipelineSlot *slot, const std::vector<Tensor *> &in_tensors) {
+  for (size_t i = 0; i < in_tensors.size(); ++i) {
+    auto src_tensor = in_tensors[i];
+    auto dst_tensor = slot->inputs[i].get();
+    if (src_tensor->data() == nullptr) {
+      MS_LOG(ERROR) << "Input of micro-batch is not set, tensor: " << src_tensor->tensor_name();
+      return RET_ERROR;
+    }
+    if (dst_tensor->data_type() != src_tensor->data_type() || dst_tensor->shape() != src_tensor->shape()) {
+      dst_tensor->FreeData();
+      dst_tensor->set_data_type(src_tensor->data_type());
+      dst_tensor->set_shape(src_tensor->shape());
+    }
+    dst_tensor->set_format(src_tensor->format());
+    auto ret = dst_tensor->MallocData();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Malloc input of micro-batch failed, tensor: " << src_tensor->tensor_name();
+      return ret;
+    }
+    memcpy(dst_tensor->data(), src_tensor->data(), src_tensor->Size());
+  }
+  return RET_OK;
+}
+
+int MindrtExecutor::FetchPipelineSlot(PipelineSlot *slot) {
+  for (auto &output : slot->outputs) {
+    auto src_tensor = output.first;
+    auto dst_tensor = output.second;
+    // the outputs of the former micro-batch have been fetched.
+    dst_tensor->FreeData();
+#ifdef ENABLE_FP16
+    if (src_tensor->data_type() == kNumberTypeFloat16) {
+      auto ret = TransferOutputData(src_tensor, dst_tensor);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "Transfer output of micro-batch failed, tensor: " << dst_tensor->tensor_name();
+        return ret;
+      }
+      src_tensor->FreeData();
+      continue;
+    }
+#endif
+    // the buffer is moved rather than shared, the graph output is its only owner until the next micro-batch of this
+    // slot is fetched, while the slot stages the next micro-batch into a new buffer.
+    dst_tensor->set_shape(src_tensor->shape());
+    dst_tensor->set_allocator(src_tensor->allocator());
+    dst_tensor->set_data(src_tensor->data());
+    dst_tensor->set_own_data(src_tensor->own_data());
+    src_tensor->set_data(nullptr);
+    src_tensor->set_ref_count(0);
+  }
+  return RET_OK;
+}
+
+int MindrtExecutor::RunPipelineMicroBatches(const std::vector<Tensor *> &in_tensors, size_t micro_batch_num,
+                                            const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch,
+                                            const KernelCallBack &before, const KernelCallBack &after) {
+  std::queue<Future<std::list<int>>> in_flight;
+  auto drain = [&in_flight]() {
+    while (!in_flight.empty()) {
+      in_flight.front().Wait();
+      in_flight.pop();
+    }
+  };
+  size_t next = 0;
+  for (size_t done = 0; done < micro_batch_num; ++done) {
+    while (next < micro_batch_num && next - done < kPipelineSlotNum) {
+      auto &slot = pipeline_slots_[next % kPipelineSlotNum];
+      auto ret = feed(next);
+      if (ret == RET_OK) {
+        ret = FeedPipelineSlot(&slot, in_tensors);
+      }
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "feed micro-batch " << next << " failed.";
+        drain();
+        return ret;
+      }
+      slot.results = std::vector<Promise<int>>(output_data_.size());
+      // actors find the slot of micro-batch by the sequential num.
+      slot.context.sequential_num_ = static_cast<int>(next);
+      slot.context.results_ = &slot.results;
+      slot.context.output_data_ = &output_data_;
+      slot.context.kernel_call_back_before_ = &before;
+      slot.context.kernel_call_back_after_ = &after;
+      in_flight.push(MindrtAsyncRun<Tensor>(slot.input_data, &slot.context, actor_mgr_));
+      ++next;
+    }
+    in_flight.front().Wait();
+    auto is_ok = in_flight.front().IsOK();
+    in_flight.pop();
+    if (!is_ok) {
+      MS_LOG(ERROR) << "run micro-batch " << done << " failed.";
+      drain();
+      return RET_ERROR;
+    }
+    auto ret = FetchPipelineSlot(&pipeline_slots_[done % kPipelineSlotNum]);
+    if (ret == RET_OK) {
+      ret = fetch(done);
+    }
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "fetch micro-batch " << done << " failed.";
+      drain();
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int MindrtExecutor::RunPipeline(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                                const std::vector<kernel::KernelExec *> &kernels, size_t micro_batch_num,
+                                const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch,
+                                const KernelCallBack &before, const KernelCallBack &after) {
+  CHECK_NULL_RETURN(ctx_);
+  CHECK_NULL_RETURN(feed);
+  CHECK_NULL_RETURN(fetch);
+  auto thread_pool = ctx_->thread_pool();
+  CHECK_NULL_RETURN(thread_pool);
+  // a single actor runs the micro-batches one by one anyway.
+  auto ret = op_actors_.size() > 1 ? PreparePipeline(in_tensors) : RET_NOT_SUPPORT;
+  if (ret == RET_NOT_SUPPORT) {
+    MS_LOG(INFO) << "Graph can not be pipelined, run micro-batches sequentially.";
+    return Executor::RunPipeline(in_tensors, out_tensors, kernels, micro_batch_num, feed, fetch, before, after);
+  }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Prepare pipeline failed.";
+    return ret;
+  }
+  if (ctx_->delegate == nullptr) {
+    thread_pool->SetSpinCountMaxValue();
+  }
+  for (auto &slot : pipeline_slots_) {
+    for (auto &output : slot.outputs) {
+      if (output.second->allocator() != nullptr) {
+        output.second->FreeData();
+      }
+    }
+  }
+  for (auto &actor : op_actors_) {
+    actor->set_pipeline_slot_num(kPipelineSlotNum);
+  }
+  ret = RunPipelineMicroBatches(in_tensors, micro_batch_num, feed, fetch, before, after);
+  for (auto &actor : op_actors_) {
+    actor->set_pipeline_slot_num(0);
+  }
+  thread_pool->SetSpinCountMinValue();
+  return ret;
+}
 }  // namespace mindspore::lite
@@ -29,6 +29,9 @@
 #include "mindrt/src/actor/actormgr.h"
 
 namespace mindspore::lite {
+// double buffering: one micro-batch is fed while the former one is running.
+constexpr size_t kPipelineSlotNum = 2;
+
 class MindrtExecutor : public Executor {
  public:
   explicit MindrtExecutor(std::unordered_map<Tensor *, Tensor *> *output_map,
@@ -43,11 +46,34 @@ class MindrtExecutor : public Executor {
           const std::vector<kernel::KernelExec *> &kernels, const KernelCallBack &before = nullptr,
           const KernelCallBack &after = nullptr) override;
 
+  // micro-batches are pushed into the actors while the former ones are still running, at most kPipelineSlotNum
+  // micro-batches are in flight and every one of them owns a slot of the graph inputs and the actor outputs.
+  int RunPipeline(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                  const std::vector<kernel::KernelExec *> &kernels, size_t micro_batch_num,
+                  const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch, const KernelCallBack &before = nullptr,
+                  const KernelCallBack &after = nullptr) override;
+
   int Resize(const std::vector<mindspore::lite::Tensor *> &inputs, const std::vector<std::vector<int>> &dims) override;
 
  private:
+  struct PipelineSlot {
+    std::vector<std::unique_ptr<Tensor>> inputs;
+    std::vector<OpDataPtr<Tensor>> input_data;
+    // pairs of the actor output of this slot and the graph output tensor.
+    std::vector<std::pair<Tensor *, Tensor *>> outputs;
+    std::vector<Promise<int>> results;
+    OpContext<Tensor> context;
+  };
+
   int TransferGraphOutput();
+  int TransferOutputData(Tensor *src_tensor, Tensor *dst_tensor);
   void FreeOutputTensor();
+  int PreparePipeline(const std::vector<Tensor *> &in_tensors);
+  int FeedPipelineSlot(PipelineSlot *slot, const std::vector<Tensor *> &in_tensors);
+  int FetchPipelineSlot(PipelineSlot *slot);
+  int RunPipelineMicroBatches(const std::vector<Tensor *> &in_tensors, size_t micro_batch_num,
+                              const PipelineFeedFunc &feed, const PipelineFetchFunc &fetch,
+                              const KernelCallBack &before, const KernelCallBack &after);
   std::unordered_map<void *, std::set<std::pair<AID, size_t>>> BuildReceiverMap();
 
  protected:
@@ -62,6 +88,7 @@ class MindrtExecutor : public Executor {
   std::unordered_map<Tensor *, Tensor *> *isolate_output_map_;
   std::unordered_map<Tensor *, Tensor *> *isolate_input_map_;
   std::shared_ptr<ActorMgr> actor_mgr_;
+  std::vector<PipelineSlot> pipeline_slots_;
 };
 
 }  // namespace mindspore::lite
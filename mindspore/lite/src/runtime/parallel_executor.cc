@@ -0,0 +1,247 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/parallel_executor.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include "include/errorcode.h"
+#include "src/common/log_util.h"
+#include "src/runtime/thread_cost_model.h"
+
+namespace mindspore::lite {
+namespace {
+int DataflowRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  auto executor = reinterpret_cast<ParallelExecutor *>(cdata);
+  CHECK_NULL_RETURN(executor);
+  return executor->RunWorker(task_id);
+}
+
+bool IsReductionKernel(schema::PrimitiveType type) {
+  return type == schema::PrimitiveType_Conv2DFusion || type == schema::PrimitiveType_MatMulFusion ||
+         type == schema::PrimitiveType_FullConnection || type == schema::PrimitiveType_Conv2dTransposeFusion;
+}
+}  // namespace
+
+int ParallelExecutor::Prepare(const std::vector<kernel::KernelExec *> &kernels, const std::vector<Tensor *> &inputs,
+                              const std::vector<Tensor *> &outputs, lite::InnerContext *ctx) {
+  CHECK_NULL_RETURN(ctx);
+  ctx_ = ctx;
+  thread_num_ = MSMAX(ctx->thread_num_, 1);
+  auto ret = BuildDependency(kernels);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "build kernel dependency failed.";
+    return ret;
+  }
+  inter_op_parallel_num_ = EvaluateParallelNum();
+  MS_LOG(INFO) << "inter op parallel num: " << inter_op_parallel_num_ << ", kernel num: " << kernels_.size();
+  return RET_OK;
+}
+
+int ParallelExecutor::BuildDependency(const std::vector<kernel::KernelExec *> &kernels) {
+  kernels_ = kernels;
+  kernel_index_.clear();
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    CHECK_NULL_RETURN(kernels_[i]);
+    kernel_index_[kernels_[i]] = i;
+  }
+  successors_.assign(kernels_.size(), {});
+  in_degree_.assign(kernels_.size(), 0);
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    for (auto *out_kernel : kernels_[i]->out_kernels()) {
+      auto iter = kernel_index_.find(out_kernel);
+      // the successor out of this subgraph is scheduled by the outer executor.
+      if (iter == kernel_index_.end()) {
+        continue;
+      }
+      successors_[i].push_back(iter->second);
+      in_degree_[iter->second]++;
+    }
+  }
+  pending_ = std::make_unique<std::atomic_int[]>(kernels_.size());
+  return RET_OK;
+}
+
+float ParallelExecutor::KernelCost(const kernel::KernelExec *kernel) {
+  ThreadCostContext cost_context;
+  cost_context.total_unit_num_ = 0;
+  for (auto *out_tensor : kernel->out_tensors()) {
+    cost_context.total_unit_num_ += MSMAX(out_tensor->ElementsNum(), 0);
+  }
+  cost_context.per_unit_load_num_ = static_cast<int64_t>(kernel->in_tensors().size());
+  cost_context.per_unit_store_num_ = static_cast<int64_t>(kernel->out_tensors().size());
+  cost_context.per_unit_compute_cost_ = GetKernelComputeCost(TC_TYPE(kernel->type(), 0));
+  // conv and matmul do a reduction over the weight for every output unit.
+  if (IsReductionKernel(kernel->type()) && kernel->in_tensors().size() > 1 && !kernel->out_tensors().empty()) {
+    auto weight = kernel->in_tensors().at(1);
+    auto out_shape = kernel->out_tensors().front()->shape();
+    if (weight->IsConst() && !out_shape.empty() && out_shape.back() > 0) {
+      cost_context.per_unit_compute_cost_ = static_cast<float>(weight->ElementsNum()) / out_shape.back();
+    }
+  }
+  return ThreadCostModel::TotalCost(&cost_context);
+}
+
+int ParallelExecutor::KernelIntraOpThreadNum(const kernel::KernelExec *kernel) const {
+  auto cost = KernelCost(kernel);
+  // shape unknown before infer, regard it as a heavy kernel.
+  if (cost <= 0) {
+    return thread_num_;
+  }
+  auto thread_num =
+    static_cast<int>((cost - ThreadCostModel::thread_startup_cost_) / ThreadCostModel::single_thread_cost_ + 0.9);
+  return MSMIN(MSMAX(thread_num, 1), thread_num_);
+}
+
+int ParallelExecutor::EvaluateParallelNum() {
+  if (thread_num_ <= 1 || kernels_.size() <= 1) {
+    return 1;
+  }
+  // walk the graph level by level, kernels in the same level don't depend on each other. Kernels that can't occupy
+  // the whole thread pool by themselves are worth running side by side, the rest keeps intra-op parallelism.
+  std::vector<int> degree = in_degree_;
+  std::vector<size_t> level;
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    if (degree[i] == 0) {
+      level.push_back(i);
+    }
+  }
+  int parallel_num = 1;
+  size_t visited = 0;
+  while (!level.empty()) {
+    int light_kernel_num = 0;
+    int light_thread_num = 0;
+    std::vector<size_t> next_level;
+    for (auto index : level) {
+      auto intra_thread_num = KernelIntraOpThreadNum(kernels_[index]);
+      if (intra_thread_num < thread_num_) {
+        light_kernel_num++;
+        light_thread_num += intra_thread_num;
+      }
+      for (auto succ : successors_[index]) {
+        if (--degree[succ] == 0) {
+          next_level.push_back(succ);
+        }
+      }
+    }
+    if (light_kernel_num > 1) {
+      int avg_thread_num = UP_DIV(light_thread_num, light_kernel_num);
+      parallel_num = MSMAX(parallel_num, MSMIN(light_kernel_num, thread_num_ / avg_thread_num));
+    }
+    visited += level.size();
+    level = std::move(next_level);
+  }
+  if (visited != kernels_.size()) {
+    MS_LOG(WARNING) << "kernels are not a DAG, run them sequentially.";
+    return 1;
+  }
+  return MSMIN(parallel_num, thread_num_);
+}
+
+kernel::KernelExec *ParallelExecutor::PopReadyKernel() {
+  std::lock_guard<std::mutex> lock(ready_mutex_);
+  if (ready_queue_.empty()) {
+    return nullptr;
+  }
+  auto index = ready_queue_.front();
+  ready_queue_.pop();
+  return kernels_[index];
+}
+
+void ParallelExecutor::PushReadyKernel(size_t index) {
+  std::lock_guard<std::mutex> lock(ready_mutex_);
+  ready_queue_.push(index);
+}
+
+int ParallelExecutor::RunWorker(int task_id) {
+  while (finished_num_ < kernels_.size() && !failed_) {
+    auto *kernel = PopReadyKernel();
+    if (kernel == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    auto ret = kernel->Execute(before_, after_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name() << ", worker: " << task_id;
+      failed_ = true;
+      return ret;
+    }
+    for (auto succ : successors_[kernel_index_.at(kernel)]) {
+      if (pending_[succ].fetch_sub(1) == 1) {
+        PushReadyKernel(succ);
+      }
+    }
+    finished_num_++;
+  }
+  return failed_ ? RET_ERROR : RET_OK;
+}
+
+int ParallelExecutor::Run(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+                          const std::vector<kernel::KernelExec *> &kernels, const KernelCallBack &before,
+                          const KernelCallBack &after) {
+  // the kernels are the nodes of a subgraph, whose inputs are produced upstream and keep the ref count set by their
+  // producers, so the ref count is not cleared here as the whole graph executor does.
+  if (inter_op_parallel_num_ <= 1 || kernels != kernels_) {
+    for (auto *kernel : kernels) {
+      auto ret = kernel->Execute(before, after);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+        return ret;
+      }
+    }
+    return RET_OK;
+  }
+  CHECK_NULL_RETURN(ctx_);
+  auto thread_pool = ctx_->thread_pool();
+  CHECK_NULL_RETURN(thread_pool);
+  thread_pool->SetSpinCountMaxValue();
+
+  // callbacks are not required to be thread safe.
+  before_ = before == nullptr ? nullptr
+                              : KernelCallBack([this, &before](std::vector<lite::Tensor *> inputs,
+                                                               std::vector<lite::Tensor *> outputs,
+                                                               const MSCallBackParam &op_info) {
+                                  std::lock_guard<std::mutex> lock(callback_mutex_);
+                                  return before(inputs, outputs, op_info);
+                                });
+  after_ = after == nullptr ? nullptr
+                            : KernelCallBack([this, &after](std::vector<lite::Tensor *> inputs,
+                                                            std::vector<lite::Tensor *> outputs,
+                                                            const MSCallBackParam &op_info) {
+                                std::lock_guard<std::mutex> lock(callback_mutex_);
+                                return after(inputs, outputs, op_info);
+                              });
+  ready_queue_ = {};
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    pending_[i] = in_degree_[i];
+    if (in_degree_[i] == 0) {
+      ready_queue_.push(i);
+    }
+  }
+  finished_num_ = 0;
+  failed_ = false;
+
+  auto ret = thread_pool->ParallelLaunch(DataflowRun, this, inter_op_parallel_num_);
+  before_ = nullptr;
+  after_ = nullptr;
+  thread_pool->SetSpinCountMinValue();
+  if (ret != RET_OK || failed_) {
+    MS_LOG(ERROR) << "run dataflow graph failed.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_PARALLEL_EXECUTOR_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_PARALLEL_EXECUTOR_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "src/runtime/executor.h"
+#include "src/runtime/kernel_exec.h"
+#include "src/runtime/inner_context.h"
+
+namespace mindspore::lite {
+// ParallelExecutor runs the kernels of one subgraph as a dataflow graph: every kernel whose producers have finished is
+// pushed into a ready queue, and several workers of the context thread pool pop and run ready kernels concurrently.
+// The number of inter-op workers is decided by ThreadCostModel, so that the threads left for intra-op parallelism of
+// the heavy kernels are not taken away by cheap independent branches.
+class ParallelExecutor : public Executor {
+ public:
+  ParallelExecutor() = default;
+  ~ParallelExecutor() override = default;
+
+  int Prepare(const std::vector<kernel::KernelExec *> &kernels, const std::vector<Tensor *> &inputs,
+              const std::vector<Tensor *> &outputs, lite::InnerContext *ctx) override;
+
+  int Run(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
+          const std::vector<kernel::KernelExec *> &kernels, const KernelCallBack &before = nullptr,
+          const KernelCallBack &after = nullptr) override;
+
+  // number of workers running kernels concurrently, 1 means the graph is executed sequentially.
+  int inter_op_parallel_num() const { return inter_op_parallel_num_; }
+
+  int RunWorker(int task_id);
+
+  // estimated cost of running a kernel, which is comparable between kernels.
+  static float KernelCost(const kernel::KernelExec *kernel);
+
+ private:
+  int BuildDependency(const std::vector<kernel::KernelExec *> &kernels);
+  int EvaluateParallelNum();
+  int KernelIntraOpThreadNum(const kernel::KernelExec *kernel) const;
+  kernel::KernelExec *PopReadyKernel();
+  void PushReadyKernel(size_t index);
+
+  std::vector<kernel::KernelExec *> kernels_;
+  std::unordered_map<const kernel::KernelExec *, size_t> kernel_index_;
+  std::vector<std::vector<size_t>> successors_;
+  std::vector<int> in_degree_;
+  int inter_op_parallel_num_ = 1;
+  int thread_num_ = 1;
+
+  // running status, reset at the beginning of every Run.
+  std::unique_ptr<std::atomic_int[]> pending_;
+  std::queue<size_t> ready_queue_;
+  std::mutex ready_mutex_;
+  std::atomic_size_t finished_num_ = {0};
+  std::atomic_bool failed_ = {false};
+  KernelCallBack before_ = nullptr;
+  KernelCallBack after_ = nullptr;
+  std::mutex callback_mutex_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_PARALLEL_EXECUTOR_H_
@@ -0,0 +1,602 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/pass/layout_assignment.h"
+#include <algorithm>
+#include <set>
+#include <string>
+#include <utility>
+#include "src/runtime/kernel_exec_util.h"
+
+namespace mindspore::lite::pass {
+namespace {
+constexpr int kMaxAssignIterations = 10;
+// the fixed overhead of launching a transpose kernel, counted in elements.
+constexpr double kTransposeLaunchCost = 1024.0;
+constexpr double kInvalidCost = 1e30;
+
+// the format pairs supported by TransData of FormatTranspose kernel.
+const std::set<std::pair<FormatC, FormatC>> kFp32TransPairs = {
+  {Format_NHWC, Format_NCHW},   {Format_NCHW, Format_NHWC},   {Format_NHWC, Format_NC4HW4},
+  {Format_NC4HW4, Format_NHWC}, {Format_NCHW, Format_NC4HW4}, {Format_NC4HW4, Format_NCHW},
+};
+const std::set<std::pair<FormatC, FormatC>> kFp16TransPairs = {
+  {Format_NHWC, Format_NCHW},
+  {Format_NCHW, Format_NHWC},
+  {Format_NCHW, Format_NC8HW8},
+  {Format_NC8HW8, Format_NHWC},
+};
+
+bool IsFloatType(TypeId data_type) { return data_type == kNumberTypeFloat32 || data_type == kNumberTypeFloat16; }
+
+bool CheckTransData(FormatC src_format, FormatC dst_format, TypeId data_type) {
+  if (data_type == kNumberTypeFloat32) {
+    return kFp32TransPairs.find({src_format, dst_format}) != kFp32TransPairs.end();
+  }
+  if (data_type == kNumberTypeFloat16) {
+    return kFp16TransPairs.find({src_format, dst_format}) != kFp16TransPairs.end();
+  }
+  return false;
+}
+
+std::vector<int> ConvertShape(const std::vector<int> &shape, FormatC src_format, FormatC dst_format) {
+  if (shape.size() != DIMENSION_4D || (src_format == Format_NHWC) == (dst_format == Format_NHWC)) {
+    return shape;
+  }
+  const auto &perm = src_format == Format_NHWC ? nh2nc_perm : nc2nh_perm;
+  std::vector<int> dst_shape;
+  for (auto axis : perm) {
+    dst_shape.push_back(shape.at(axis));
+  }
+  return dst_shape;
+}
+
+size_t CountTransposes(kernel::SubGraphKernel *subgraph) {
+  TransInfoPair trans;
+  return std::count_if(
+    subgraph->nodes().begin(), subgraph->nodes().end(),
+    [&trans](const kernel::KernelExec *kernel) { return GetTransposeInfo(kernel, &trans) == RET_OK; });
+}
+
+// keep the link of in_kernel and out_kernel consistent with the tensors between them.
+void UpdateKernelLink(kernel::KernelExec *in_kernel, kernel::KernelExec *out_kernel) {
+  if (in_kernel == nullptr) {
+    return;
+  }
+  auto linked = std::any_of(in_kernel->out_tensors().begin(), in_kernel->out_tensors().end(),
+                            [out_kernel](Tensor *tensor) { return IsContain(out_kernel->in_tensors(), tensor); });
+  if (linked) {
+    in_kernel->AddOutKernel(out_kernel);
+    out_kernel->AddInKernel(in_kernel);
+  } else {
+    in_kernel->RemoveOutKernel(out_kernel);
+    out_kernel->RemoveInKernel(in_kernel);
+  }
+}
+
+// in_kernel -> in_tensor -> out_kernel  ==>  in_kernel -> in_tensor -> transpose -> new tensor -> out_kernel
+int InsertTranspose(kernel::SubGraphKernel *subgraph, kernel::KernelExec *in_kernel, kernel::KernelExec *out_kernel,
+                    size_t index, const TransInfoPair &trans_info, const kernel::KernelKey &desc,
+                    std::vector<Tensor *> *all_tensors) {
+  auto in_tensor = out_kernel->in_tensors().at(index);
+  auto trans_name = out_kernel->name() + "_layout_" + std::to_string(index);
+  auto out_tensor = new (std::nothrow) Tensor(in_tensor->data_type(), {}, (Format)trans_info.dst_format_);
+  CHECK_NULL_RETURN(out_tensor);
+  out_tensor->set_tensor_name(trans_name + "_output");
+  out_tensor->set_shape(ConvertShape(in_tensor->shape(), trans_info.src_format_, trans_info.dst_format_));
+
+  auto trans_kernel = CreateFormatTranspose(in_tensor, out_tensor, trans_info, trans_name, out_kernel->Context(), desc);
+  if (trans_kernel == nullptr) {
+    delete out_tensor;
+    return RET_NULL_PTR;
+  }
+  all_tensors->push_back(out_tensor);
+  out_kernel->set_in_tensor(out_tensor, index);
+  if (in_kernel != nullptr) {
+    in_kernel->AddOutKernel(trans_kernel);
+    trans_kernel->AddInKernel(in_kernel);
+  }
+  trans_kernel->AddOutKernel(out_kernel);
+  out_kernel->AddInKernel(trans_kernel);
+  subgraph->nodes().push_back(trans_kernel);
+  return RET_OK;
+}
+}  // namespace
+
+void LayoutAssignment::Reset() {
+  regions_.clear();
+  region_index_.clear();
+  trans_kernels_.clear();
+  trans_infos_.clear();
+  edges_.clear();
+  region_edges_.clear();
+  eliminated_transpose_num_ = 0;
+}
+
+int LayoutAssignment::RegionOf(const kernel::KernelExec *kernel) const {
+  if (kernel == nullptr) {
+    return -1;
+  }
+  auto iter = region_index_.find(kernel);
+  if (iter == region_index_.end() || regions_.at(iter->second).frame == Format_NONE) {
+    return -1;
+  }
+  return iter->second;
+}
+
+bool LayoutAssignment::IsRegionChanged(int region_index) const {
+  return region_index >= 0 && regions_.at(region_index).layout != regions_.at(region_index).frame;
+}
+
+void LayoutAssignment::BuildRegions(kernel::SubGraphKernel *subgraph) {
+  const auto &kernels = subgraph->nodes();
+  std::unordered_map<const kernel::KernelExec *, size_t> kernel_index;
+  std::vector<size_t> parent;
+  for (const auto &kernel : kernels) {
+    if (dynamic_format_kernel_lists.find(kernel->type()) != dynamic_format_kernel_lists.end()) {
+      kernel_index[kernel] = parent.size();
+      parent.push_back(parent.size());
+    }
+  }
+  auto find_root = [&parent](size_t index) {
+    while (parent[index] != index) {
+      parent[index] = parent[parent[index]];
+      index = parent[index];
+    }
+    return index;
+  };
+  for (const auto &kernel : kernels) {
+    auto iter = kernel_index.find(kernel);
+    if (iter == kernel_index.end()) {
+      continue;
+    }
+    for (const auto &out_kernel : kernel->out_kernels()) {
+      auto out_iter = kernel_index.find(out_kernel);
+      if (out_iter != kernel_index.end()) {
+        parent[find_root(iter->second)] = find_root(out_iter->second);
+      }
+    }
+  }
+  std::unordered_map<size_t, int> root_region;
+  for (const auto &kernel : kernels) {
+    auto iter = kernel_index.find(kernel);
+    if (iter == kernel_index.end()) {
+      continue;
+    }
+    auto root = find_root(iter->second);
+    auto region_iter = root_region.find(root);
+    if (region_iter == root_region.end()) {
+      region_iter = root_region.emplace(root, static_cast<int>(regions_.size())).first;
+      regions_.emplace_back();
+    }
+    regions_[region_iter->second].kernels.push_back(kernel);
+    region_index_[kernel] = region_iter->second;
+  }
+}
+
+void LayoutAssignment::InferRegionFrames(kernel::SubGraphKernel *subgraph) {
+  // The region executed in the destination format of its input transposes, and in the source format of its output
+  // transposes. The layout of a region is unknown if the transposes around it don't agree with each other.
+  std::vector<bool> conflicts(regions_.size(), false);
+  auto set_frame = [this, &conflicts](const kernel::KernelExec *kernel, FormatC frame) {
+    auto iter = region_index_.find(kernel);
+    if (iter == region_index_.end()) {
+      return;
+    }
+    auto &region = regions_[iter->second];
+    if (region.frame == Format_NONE) {
+      region.frame = frame;
+    } else if (region.frame != frame) {
+      conflicts[iter->second] = true;
+    }
+  };
+  for (const auto &kernel : subgraph->nodes()) {
+    TransInfoPair trans;
+    if (GetTransposeInfo(kernel, &trans) != RET_OK || kernel->out_tensors().size() != 1 ||
+        !IsFloatType(kernel->desc().data_type)) {
+      continue;
+    }
+    trans_kernels_.push_back(kernel);
+    trans_infos_[kernel] = trans;
+    set_frame(kernel::KernelExecUtil::FindInKernelForInTensor(kernel, kernel->in_tensors().at(0)), trans.src_format_);
+    auto out_kernels = kernel::KernelExecUtil::FindOutKernelsForOutTensor(kernel, kernel->out_tensors().at(0));
+    for (const auto &out_kernel : out_kernels) {
+      set_frame(out_kernel, trans.dst_format_);
+    }
+  }
+  for (size_t i = 0; i < regions_.size(); i++) {
+    auto frame = regions_[i].frame;
+    if (conflicts[i] || (frame != Format_NHWC && frame != Format_NCHW && frame != runtime_format_)) {
+      regions_[i].frame = Format_NONE;
+    }
+    regions_[i].layout = regions_[i].frame;
+  }
+}
+
+void LayoutAssignment::SetRegionCandidates(kernel::SubGraphKernel *subgraph) {
+  for (auto &region : regions_) {
+    if (region.frame == Format_NONE) {
+      continue;
+    }
+    region.candidates = {region.frame};
+    bool has_axis = false;
+    bool movable = true;
+    for (const auto &kernel : region.kernels) {
+      if (!transpose_strategy_.CheckChangeKernelAxis(kernel) || !IsFloatType(kernel->desc().data_type)) {
+        movable = false;
+        break;
+      }
+      has_axis = has_axis || dynamic_format_kernel_lists.at(kernel->type());
+      // the output of subgraph must be kept in its origin layout.
+      movable = std::all_of(kernel->out_tensors().begin(), kernel->out_tensors().end(), [subgraph](Tensor *tensor) {
+        return tensor->shape().size() == DIMENSION_4D && !IsContain(subgraph->out_tensors(), tensor);
+      });
+      // the none-4D inputs must be const attributes, like the min and max of clip.
+      movable = movable && std::all_of(kernel->in_tensors().begin(), kernel->in_tensors().end(), [](Tensor *tensor) {
+                  return tensor->shape().size() == DIMENSION_4D || tensor->IsConst();
+                });
+      if (!movable) {
+        break;
+      }
+    }
+    if (!movable) {
+      continue;
+    }
+    for (auto layout : {Format_NHWC, Format_NCHW, runtime_format_}) {
+      if (layout == region.frame) {
+        continue;
+      }
+      // the axis of kernel can only be changed between NHWC and NCHW.
+      if (has_axis && (layout == runtime_format_ || region.frame == runtime_format_)) {
+        continue;
+      }
+      if (std::all_of(region.kernels.begin(), region.kernels.end(), [layout](kernel::KernelExec *kernel) {
+            return CheckInTensorsShape(kernel, static_cast<Format>(layout));
+          })) {
+        region.candidates.push_back(layout);
+      }
+    }
+  }
+}
+
+void LayoutAssignment::AddEdge(const LayoutEdge &edge) {
+  auto edge_index = edges_.size();
+  edges_.push_back(edge);
+  if (edge.src_region >= 0) {
+    region_edges_[edge.src_region].push_back(edge_index);
+  }
+  if (edge.dst_region >= 0 && edge.dst_region != edge.src_region) {
+    region_edges_[edge.dst_region].push_back(edge_index);
+  }
+}
+
+void LayoutAssignment::BuildEdges(kernel::SubGraphKernel *subgraph) {
+  region_edges_.assign(regions_.size(), {});
+  // the edges through transposes, one edge for every consumer of the transpose.
+  for (const auto &trans_kernel : trans_kernels_) {
+    const auto &trans = trans_infos_.at(trans_kernel);
+    auto in_tensor = trans_kernel->in_tensors().at(0);
+    auto out_tensor = trans_kernel->out_tensors().at(0);
+    auto src_region = RegionOf(kernel::KernelExecUtil::FindInKernelForInTensor(trans_kernel, in_tensor));
+    auto out_kernels = kernel::KernelExecUtil::FindOutKernelsForOutTensor(trans_kernel, out_tensor);
+    if (src_region < 0 && std::all_of(out_kernels.begin(), out_kernels.end(),
+                                      [this](const kernel::KernelExec *kernel) { return RegionOf(kernel) < 0; })) {
+      continue;
+    }
+    auto data_type = trans_kernel->desc().data_type;
+    for (const auto &out_kernel : out_kernels) {
+      AddEdge({src_region, trans.src_format_, RegionOf(out_kernel), trans.dst_format_, out_tensor, data_type});
+    }
+    if (IsContain(subgraph->out_tensors(), out_tensor)) {
+      AddEdge({src_region, trans.src_format_, -1, trans.dst_format_, out_tensor, data_type});
+    }
+  }
+  // the direct links between a region and the other kernels, which only cost when the layout of region changes.
+  for (size_t i = 0; i < regions_.size(); i++) {
+    const auto &region = regions_[i];
+    if (region.candidates.size() <= 1) {
+      continue;
+    }
+    auto region_index = static_cast<int>(i);
+    for (const auto &kernel : region.kernels) {
+      auto data_type = kernel->desc().data_type;
+      for (const auto &in_tensor : kernel->in_tensors()) {
+        if (in_tensor->shape().size() != DIMENSION_4D) {
+          continue;
+        }
+        auto in_kernel = kernel::KernelExecUtil::FindInKernelForInTensor(kernel, in_tensor);
+        if (RegionOf(in_kernel) == region_index || trans_infos_.find(in_kernel) != trans_infos_.end()) {
+          continue;
+        }
+        AddEdge({-1, region.frame, region_index, region.frame, in_tensor, data_type});
+      }
+      for (const auto &out_tensor : kernel->out_tensors()) {
+        for (const auto &out_kernel : kernel::KernelExecUtil::FindOutKernelsForOutTensor(kernel, out_tensor)) {
+          if (RegionOf(out_kernel) == region_index || trans_infos_.find(out_kernel) != trans_infos_.end()) {
+            continue;
+          }
+          auto input_num = std::count(out_kernel->in_tensors().begin(), out_kernel->in_tensors().end(), out_tensor);
+          for (int64_t n = 0; n < input_num; n++) {
+            AddEdge({region_index, region.frame, -1, region.frame, out_tensor, data_type});
+          }
+        }
+      }
+    }
+  }
+}
+
+double LayoutAssignment::EdgeCost(const LayoutEdge &edge) const {
+  auto src_layout = edge.src_region >= 0 ? regions_.at(edge.src_region).layout : edge.src_layout;
+  auto dst_layout = edge.dst_region >= 0 ? regions_.at(edge.dst_region).layout : edge.dst_layout;
+  if (src_layout == dst_layout) {
+    return 0;
+  }
+  if (!CheckTransData(src_layout, dst_layout, edge.data_type)) {
+    return kInvalidCost;
+  }
+  // a transpose reads and writes the whole tensor, unknown shape only counts the launch overhead.
+  auto element_num = edge.tensor->ElementsNum();
+  return kTransposeLaunchCost + static_cast<double>(std::max<int64_t>(element_num, 0));
+}
+
+double LayoutAssignment::RegionCost(size_t region_index, FormatC layout) {
+  auto &region = regions_.at(region_index);
+  auto origin_layout = region.layout;
+  region.layout = layout;
+  double cost = 0;
+  for (auto edge_index : region_edges_.at(region_index)) {
+    cost += EdgeCost(edges_.at(edge_index));
+  }
+  region.layout = origin_layout;
+  return cost;
+}
+
+double LayoutAssignment::TotalCost() const {
+  double cost = 0;
+  for (const auto &edge : edges_) {
+    cost += EdgeCost(edge);
+  }
+  return cost;
+}
+
+void LayoutAssignment::AssignLayout() {
+  // Iterated conditional modes: move one region to its best layout with the others fixed, until nothing changes.
+  // Starting from the current layouts, the total cost never increases.
+  for (int iter = 0; iter < kMaxAssignIterations; iter++) {
+    bool changed = false;
+    for (size_t i = 0; i < regions_.size(); i++) {
+      auto &region = regions_[i];
+      if (region.candidates.size() <= 1) {
+        continue;
+      }
+      auto best_layout = region.layout;
+      auto best_cost = RegionCost(i, region.layout);
+      for (auto layout : region.candidates) {
+        auto cost = RegionCost(i, layout);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_layout = layout;
+        }
+      }
+      if (best_layout != region.layout) {
+        region.layout = best_layout;
+        changed = true;
+      }
+    }
+    if (!changed) {
+      break;
+    }
+  }
+}
+
+int LayoutAssignment::ChangeRegionLayout(const Region &region) {
+  for (const auto &kernel : region.kernels) {
+    auto ret = transpose_strategy_.ChangeKernelAxis(kernel, TransInfoPair(region.frame, region.layout));
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Change kernel axis " << kernel->name() << " failed.";
+      return RET_ERROR;
+    }
+    for (const auto &tensor : kernel->out_tensors()) {
+      tensor->set_shape(ConvertShape(tensor->shape(), region.frame, region.layout));
+      tensor->set_format(static_cast<Format>(region.layout));
+    }
+  }
+  return RET_OK;
+}
+
+int LayoutAssignment::InsertRegionTransposes(kernel::SubGraphKernel *subgraph, const Region &region,
+                                             std::vector<Tensor *> *tensors) {
+  auto region_index = RegionOf(region.kernels.front());
+  for (const auto &kernel : region.kernels) {
+    auto desc = kernel->desc();
+    for (size_t i = 0; i < kernel->in_tensors().size(); i++) {
+      auto in_tensor = kernel->in_tensors().at(i);
+      if (in_tensor->shape().size() != DIMENSION_4D) {
+        continue;
+      }
+      auto in_kernel = kernel::KernelExecUtil::FindInKernelForInTensor(kernel, in_tensor);
+      if (RegionOf(in_kernel) == region_index || trans_infos_.find(in_kernel) != trans_infos_.end()) {
+        continue;
+      }
+      auto ret = InsertTranspose(subgraph, in_kernel, kernel, i, TransInfoPair(region.frame, region.layout), desc,
+                                 tensors);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "Insert transpose for op: " << kernel->name() << " input tensor " << i << " failed.";
+        return RET_ERROR;
+      }
+      UpdateKernelLink(in_kernel, kernel);
+    }
+    for (const auto &out_tensor : kernel->out_tensors()) {
+      for (const auto &out_kernel : kernel::KernelExecUtil::FindOutKernelsForOutTensor(kernel, out_tensor)) {
+        if (RegionOf(out_kernel) == region_index || trans_infos_.find(out_kernel) != trans_infos_.end()) {
+          continue;
+        }
+        for (size_t i = 0; i < out_kernel->in_tensors().size(); i++) {
+          if (out_kernel->in_tensors().at(i) != out_tensor) {
+            continue;
+          }
+          auto ret = InsertTranspose(subgraph, kernel, out_kernel, i, TransInfoPair(region.layout, region.frame), desc,
+                                     tensors);
+          if (ret != RET_OK) {
+            MS_LOG(ERROR) << "Insert transpose for op: " << out_kernel->name() << " input tensor " << i << " failed.";
+            return RET_ERROR;
+          }
+        }
+        UpdateKernelLink(kernel, out_kernel);
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int LayoutAssignment::RebuildTranspose(kernel::SubGraphKernel *subgraph, kernel::KernelExec *trans_kernel,
+                                       std::vector<Tensor *> *tensors) {
+  auto trans = trans_infos_.at(trans_kernel);
+  auto in_tensor = trans_kernel->in_tensors().at(0);
+  auto out_tensor = trans_kernel->out_tensors().at(0);
+  auto in_kernel = kernel::KernelExecUtil::FindInKernelForInTensor(trans_kernel, in_tensor);
+  auto src_region = RegionOf(in_kernel);
+  auto src_layout = src_region >= 0 ? regions_.at(src_region).layout : trans.src_format_;
+  auto out_kernels = kernel::KernelExecUtil::FindOutKernelsForOutTensor(trans_kernel, out_tensor);
+  if (!IsRegionChanged(src_region) &&
+      std::none_of(out_kernels.begin(), out_kernels.end(),
+                   [this](const kernel::KernelExec *kernel) { return IsRegionChanged(RegionOf(kernel)); })) {
+    return RET_OK;
+  }
+  auto desc = trans_kernel->desc();
+  // the kernels of regions read the input of transpose directly, a new transpose is inserted only if needed.
+  for (const auto &out_kernel : out_kernels) {
+    auto dst_region = RegionOf(out_kernel);
+    if (dst_region < 0) {
+      continue;
+    }
+    auto dst_layout = regions_.at(dst_region).layout;
+    trans_kernel->RemoveOutKernel(out_kernel);
+    out_kernel->RemoveInKernel(trans_kernel);
+    for (size_t i = 0; i < out_kernel->in_tensors().size(); i++) {
+      if (out_kernel->in_tensors().at(i) != out_tensor) {
+        continue;
+      }
+      out_kernel->set_in_tensor(in_tensor, i);
+      if (src_layout == dst_layout) {
+        continue;
+      }
+      auto ret = InsertTranspose(subgraph, in_kernel, out_kernel, i, TransInfoPair(src_layout, dst_layout), desc,
+                                 tensors);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "Insert transpose for op: " << out_kernel->name() << " input tensor " << i << " failed.";
+        return RET_ERROR;
+      }
+    }
+    UpdateKernelLink(in_kernel, out_kernel);
+  }
+
+  // the other consumers still need the destination format of the origin transpose.
+  auto remain_kernels = kernel::KernelExecUtil::FindOutKernelsForOutTensor(trans_kernel, out_tensor);
+  if (remain_kernels.empty() && !IsContain(subgraph->out_tensors(), out_tensor)) {
+    if (in_kernel != nullptr) {
+      in_kernel->RemoveOutKernel(trans_kernel);
+      trans_kernel->RemoveInKernel(in_kernel);
+    }
+    subgraph->DropNode(trans_kernel);
+    delete trans_kernel;
+    return RET_OK;
+  }
+  if (src_layout == trans.src_format_) {
+    return RET_OK;
+  }
+  if (src_layout == trans.dst_format_) {
+    return subgraph->DeleteSingleWayNode(trans_kernel, true);
+  }
+  auto kernel = CreateFormatTranspose(in_tensor, out_tensor, TransInfoPair(src_layout, trans.dst_format_),
+                                      trans_kernel->name() + "_layout", trans_kernel->Context(), desc);
+  CHECK_NULL_RETURN(kernel);
+  if (in_kernel != nullptr) {
+    in_kernel->RemoveOutKernel(trans_kernel);
+    in_kernel->AddOutKernel(kernel);
+    kernel->AddInKernel(in_kernel);
+  }
+  for (const auto &remain_kernel : remain_kernels) {
+    remain_kernel->RemoveInKernel(trans_kernel);
+    remain_kernel->AddInKernel(kernel);
+    kernel->AddOutKernel(remain_kernel);
+  }
+  subgraph->nodes().push_back(kernel);
+  subgraph->DropNode(trans_kernel);
+  delete trans_kernel;
+  return RET_OK;
+}
+
+int LayoutAssignment::ApplyLayout(kernel::SubGraphKernel *subgraph, std::vector<Tensor *> *tensors) {
+  for (const auto &region : regions_) {
+    if (region.frame == region.layout) {
+      continue;
+    }
+    auto ret = ChangeRegionLayout(region);
+    if (ret != RET_OK) {
+      return ret;
+    }
+    ret = InsertRegionTransposes(subgraph, region, tensors);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  for (const auto &trans_kernel : trans_kernels_) {
+    auto ret = RebuildTranspose(subgraph, trans_kernel, tensors);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Rebuild transpose " << trans_kernel->name() << " failed.";
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int LayoutAssignment::Run(kernel::SubGraphKernel *subgraph, std::vector<Tensor *> *tensors) {
+  CHECK_NULL_RETURN(subgraph);
+  CHECK_NULL_RETURN(tensors);
+  Reset();
+  BuildRegions(subgraph);
+  InferRegionFrames(subgraph);
+  SetRegionCandidates(subgraph);
+  BuildEdges(subgraph);
+
+  auto origin_cost = TotalCost();
+  AssignLayout();
+  auto cost = TotalCost();
+  if (cost >= origin_cost || cost >= kInvalidCost) {
+    MS_LOG(INFO) << "No better layout is found for " << subgraph->name() << ", transpose cost: " << origin_cost;
+    return RET_OK;
+  }
+
+  auto origin_trans_num = CountTransposes(subgraph);
+  auto ret = ApplyLayout(subgraph, tensors);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Apply layout for " << subgraph->name() << " failed.";
+    return RET_ERROR;
+  }
+  subgraph->SetInNodes(kernel::KernelExecUtil::SubgraphInputNodes(subgraph->nodes()));
+  subgraph->SetOutNodes(kernel::KernelExecUtil::SubgraphOutputNodes(subgraph->nodes()));
+  ret = subgraph->TopologicalSortNodes();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Topological sort kernels failed.";
+    return RET_ERROR;
+  }
+  eliminated_transpose_num_ = static_cast<int>(origin_trans_num) - static_cast<int>(CountTransposes(subgraph));
+  MS_LOG(INFO) << "Layout assignment of " << subgraph->name() << " eliminates " << eliminated_transpose_num_
+               << " transposes, transpose cost: " << origin_cost << " -> " << cost;
+  return RET_OK;
+}
+}  // namespace mindspore::lite::pass
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_PASS_LAYOUT_ASSIGNMENT_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_PASS_LAYOUT_ASSIGNMENT_H_
+
+#include <unordered_map>
+#include <vector>
+#include "src/runtime/pass/runtime_optimizer.h"
+#include "src/runtime/pass/pass_utils.h"
+#include "src/runtime/pass/transpose_strategy.h"
+
+namespace mindspore::lite::pass {
+/* LayoutAssignment PASS
+ * DecreaseTransposeAlgo fuses a transpose with its neighbours only, LayoutAssignment works on the whole subgraph:
+ * 1. The dynamic format kernels linked directly are grouped into regions, the tensors in a region share one layout.
+ * 2. The transposes around the regions and the direct links between the regions and the other kernels are the edges
+ *    of a layout graph, an edge costs a transpose when the layouts of its two sides are different.
+ * 3. The layout of every region is chosen from NHWC/NCHW/runtime format to minimize the total transpose cost.
+ * 4. The boundary of the regions whose layout changes is rebuilt with the FormatTranspose kernels still needed.
+ * */
+class LayoutAssignment : public RuntimePass {
+ public:
+  explicit LayoutAssignment(Format runtime_format) : runtime_format_(static_cast<FormatC>(runtime_format)) {}
+  ~LayoutAssignment() override = default;
+  int Run(kernel::SubGraphKernel *subgraph, std::vector<Tensor *> *tensors) override;
+
+  int eliminated_transpose_num() const { return eliminated_transpose_num_; }
+
+ private:
+  struct Region {
+    std::vector<kernel::KernelExec *> kernels;
+    /* frame is the layout the region is executed in now, Format_NONE means the layout of region is unknown. */
+    FormatC frame = Format_NONE;
+    FormatC layout = Format_NONE;
+    std::vector<FormatC> candidates;
+  };
+  /* A tensor passed from the source side to the destination side. The side belongs to a region, or has a fixed
+   * layout if the region index is -1. */
+  struct LayoutEdge {
+    int src_region = -1;
+    FormatC src_layout = Format_NONE;
+    int dst_region = -1;
+    FormatC dst_layout = Format_NONE;
+    const Tensor *tensor = nullptr;
+    TypeId data_type = kTypeUnknown;
+  };
+
+  void Reset();
+  void BuildRegions(kernel::SubGraphKernel *subgraph);
+  void InferRegionFrames(kernel::SubGraphKernel *subgraph);
+  void SetRegionCandidates(kernel::SubGraphKernel *subgraph);
+  void BuildEdges(kernel::SubGraphKernel *subgraph);
+  void AddEdge(const LayoutEdge &edge);
+  double EdgeCost(const LayoutEdge &edge) const;
+  double RegionCost(size_t region_index, FormatC layout);
+  double TotalCost() const;
+  void AssignLayout();
+  int ApplyLayout(kernel::SubGraphKernel *subgraph, std::vector<Tensor *> *tensors);
+  int ChangeRegionLayout(const Region &region);
+  int InsertRegionTransposes(kernel::SubGraphKernel *subgraph, const Region &region, std::vector<Tensor *> *tensors);
+  int RebuildTranspose(kernel::SubGraphKernel *subgraph, kernel::KernelExec *trans_kernel,
+                       std::vector<Tensor *> *tensors);
+  int RegionOf(const kernel::KernelExec *kernel) const;
+  bool IsRegionChanged(int region_index) const;
+
+  FormatC runtime_format_;
+  TransposeStrategy transpose_strategy_;
+  std::vector<Region> regions_;
+  std::unordered_map<const kernel::KernelExec *, int> region_index_;
+  std::vector<kernel::KernelExec *> trans_kernels_;
+  std::unordered_map<const kernel::KernelExec *, TransInfoPair> trans_infos_;
+  std::vector<LayoutEdge> edges_;
+  std::vector<std::vector<size_t>> region_edges_;
+  int eliminated_transpose_num_ = 0;
+};
+}  // namespace mindspore::lite::pass
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_PASS_LAYOUT_ASSIGNMENT_H_
@@ -21,6 +21,7 @@
 #include "src/runtime/pass/runtime_optimizer.h"
 #include "src/runtime/pass/to_nchw_format.h"
 #include "src/runtime/pass/decrease_transpose_algo.h"
+#include "src/runtime/pass/layout_assignment.h"
 #include "src/runtime/pass/infershape_pass.h"
 #endif
 
@@ -62,6 +63,7 @@ int RuntimeNCXPass(std::vector<kernel::KernelExec *> *subgraphs, std::vector<Ten
     Format runtime_format = subgraph->subgraph_type() == kernel::kCpuFP32SubGraph ? NC4HW4 : NC8HW8;
     optimize.AddPass(std::make_shared<ToNCHWFormat>(NHWC, runtime_format, ncxhwx_kernels));
     optimize.AddPass(std::make_shared<DecreaseTransposeAlgo>(runtime_format));
+    optimize.AddPass(std::make_shared<LayoutAssignment>(runtime_format));
     optimize.AddPass(std::make_shared<Infershape>());
     auto ret = optimize.Run(graph, tensors);
     if (ret != RET_OK) {
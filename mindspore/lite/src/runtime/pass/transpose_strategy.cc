@@ -212,4 +212,16 @@ int TransposeStrategy::ChangeKernelAxis(kernel::KernelExec *kernel, const TransI
     return RET_ERROR;
   }
 }
+
+bool TransposeStrategy::CheckChangeKernelAxis(const kernel::KernelExec *kernel) {
+  auto iter = dynamic_format_kernel_lists.find(kernel->type());
+  if (iter == dynamic_format_kernel_lists.end()) {
+    return false;
+  }
+  if (iter->second == false) {
+    return true;
+  }
+  auto process_iter = process_funcs.find(kernel->type());
+  return process_iter != process_funcs.end() && process_iter->second != nullptr;
+}
 }  // namespace mindspore::lite::pass
@@ -85,6 +85,8 @@ static const std::unordered_map<schema::PrimitiveType, bool> dynamic_format_kern
 static TransInfoPair NHWC2NCHWTrans = {Format_NHWC, Format_NCHW};
 static TransInfoPair NCHW2NHWCTrans = {Format_NCHW, Format_NHWC};
 
+bool CheckInTensorsShape(kernel::KernelExec *kernel, const Format &runtime_format);
+
 class TransposeStrategy {
  public:
   TransposeStrategy() = default;
@@ -93,6 +95,7 @@ class TransposeStrategy {
   size_t GetTransCount(const std::vector<kernel::KernelExec *> &kernels, TransInfoPair *trans_info);
   bool CheckFusion(kernel::KernelExec *kernel, TransInfoPair *pre_trans, TransInfoPair *post_trans);
   int ChangeKernelAxis(kernel::KernelExec *kernel, const TransInfoPair &post_trans);
+  bool CheckChangeKernelAxis(const kernel::KernelExec *kernel);
 };
 }  // namespace mindspore::lite::pass
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_PASS_TRANSPOSE_STRATEGY_H_
@@ -17,6 +17,7 @@
 #include "src/runtime/scheduler.h"
 #include <map>
 #include <queue>
+#include <set>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -25,12 +26,14 @@
 #include "include/errorcode.h"
 #include "src/common/graph_util.h"
 #include "src/common/utils.h"
+#include "src/common/common.h"
 #include "src/runtime/kernel_registry.h"
 #ifndef CUSTOM_KERNEL_REGISTRY_CLIP
 #include "include/registry/register_kernel.h"
 #endif
 #include "src/runtime/kernel_exec_util.h"
 #include "src/runtime/sub_graph_kernel.h"
+#include "src/runtime/parallel_executor.h"
 #include "src/common/ops/populate/populate_register.h"
 #include "src/common/version_manager.h"
 #include "src/common/prim_util.h"
@@ -46,6 +49,7 @@
 #include "src/runtime/weight_decoder.h"
 #include "src/runtime/kernel/cpu/fp16/fp16_op_handler.h"
 #include "nnacl/nnacl_common.h"
+#include "nnacl/base/cast_base.h"
 #if GPU_OPENCL
 #include "src/runtime/kernel/opencl/opencl_subgraph.h"
 #include "src/runtime/kernel/gpu/opencl/opencl_runtime.h"
@@ -59,9 +63,69 @@ using AbstractBaseModel = mindspore::infer::AbstractBaseModel;
 namespace mindspore::lite {
 namespace {
 constexpr int kMainSubGraphIndex = 0;
+// outputs of these kernels are not determined by their inputs, a subgraph containing them can't be memoized.
+const std::set<schema::PrimitiveType> kImpureKernelTypes = {
+  schema::PrimitiveType_RandomNormal,      schema::PrimitiveType_RandomStandardNormal,
+  schema::PrimitiveType_UniformReal,       schema::PrimitiveType_Assign,
+  schema::PrimitiveType_AssignAdd,         schema::PrimitiveType_TensorArray,
+  schema::PrimitiveType_TensorArrayRead,   schema::PrimitiveType_TensorArrayWrite,
+  schema::PrimitiveType_TensorListSetItem, schema::PrimitiveType_PartialFusion,
+  schema::PrimitiveType_Call,              schema::PrimitiveType_Switch,
+  schema::PrimitiveType_SwitchLayer,       schema::PrimitiveType_Custom};
+
+bool IsPureSubGraph(kernel::SubGraphKernel *subgraph) {
+  if (subgraph->subgraph_type() != kernel::kCpuFP32SubGraph && subgraph->subgraph_type() != kernel::kCpuFP16SubGraph) {
+    return false;
+  }
+  auto is_plain_tensor = [](const Tensor *tensor) { return tensor->data_type() != kObjectTypeTensorType; };
+  if (!std::all_of(subgraph->in_tensors().begin(), subgraph->in_tensors().end(), is_plain_tensor) ||
+      !std::all_of(subgraph->out_tensors().begin(), subgraph->out_tensors().end(), is_plain_tensor)) {
+    return false;
+  }
+  return std::all_of(subgraph->nodes().begin(), subgraph->nodes().end(), [](kernel::KernelExec *node) {
+    return node->IsBuiltin() && kImpureKernelTypes.find(node->type()) == kImpureKernelTypes.end();
+  });
+}
 }  // namespace
 
 namespace {
+// bf16 weights of matmul and fullconnection are consumed directly by the fp32 kernels on x86, other bf16 const
+// tensors only save storage and are widened to fp32 before the kernel is created.
+bool KeepBf16Weight(const OpParameter *op_parameter, size_t index, TypeId kernel_data_type) {
+#ifdef ENABLE_AVX
+  return kernel_data_type == kNumberTypeFloat32 && index == kWeightIndex &&
+         (op_parameter->type_ == schema::PrimitiveType_MatMulFusion ||
+          op_parameter->type_ == schema::PrimitiveType_FullConnection);
+#else
+  return false;
+#endif
+}
+
+int DecodeBf16ConstTensors(const OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors,
+                           TypeId kernel_data_type) {
+  for (size_t i = 0; i < in_tensors.size(); ++i) {
+    auto *tensor = in_tensors[i];
+    MS_CHECK_TRUE_RET(tensor != nullptr, RET_ERROR);
+    if (!tensor->IsConst() || tensor->data_type() != kNumberTypeBFloat16 ||
+        KeepBf16Weight(op_parameter, i, kernel_data_type)) {
+      continue;
+    }
+    auto origin_data = tensor->data();
+    MS_CHECK_TRUE_RET(origin_data != nullptr, RET_ERROR);
+    auto new_data = static_cast<float *>(malloc(tensor->ElementsNum() * sizeof(float)));
+    if (new_data == nullptr) {
+      MS_LOG(ERROR) << "malloc data failed";
+      return RET_ERROR;
+    }
+    BFloat16ToFloat32(static_cast<const uint16_t *>(origin_data), new_data, tensor->ElementsNum());
+    tensor->FreeData();
+    tensor->set_data(new_data);
+    tensor->set_own_data(true);
+    tensor->set_data_type(kNumberTypeFloat32);
+  }
+  return RET_OK;
+}
+
 // support_fp16: current device and package support float16
 int CastConstTensorData(Tensor *tensor, TypeId dst_data_type, bool support_fp16) {
   MS_ASSERT(tensor != nullptr);
@@ -403,6 +467,98 @@ STATUS Scheduler::DelQuantDTypeCastKernel(std::vector<kernel::KernelExec *> *ker
   return RET_OK;
 }
 
+int Scheduler::SplitPipelineStages(std::vector<kernel::KernelExec *> *dst_kernels) {
+#ifdef ENABLE_MINDRT
+  if (config_info_ == nullptr || *is_control_flow_ || is_train_session_ || delegate_ != nullptr ||
+      context_->enable_parallel_) {
+    return RET_OK;
+  }
+  auto pipeline_config = config_info_->find(kPipeline);
+  if (pipeline_config == config_info_->end()) {
+    return RET_OK;
+  }
+  auto stage_num_iter = pipeline_config->second.find(kPipelineStageNum);
+  if (stage_num_iter == pipeline_config->second.end()) {
+    return RET_OK;
+  }
+  auto stage_num_opt = GenericParseValue<size_t>(stage_num_iter->second);
+  if (stage_num_opt.IsNone()) {
+    MS_LOG(ERROR) << "Invalid pipeline stage num: " << stage_num_iter->second;
+    return RET_ERROR;
+  }
+  auto stage_num = stage_num_opt.Get();
+  if (stage_num <= 1) {
+    return RET_OK;
+  }
+
+  std::vector<kernel::KernelExec *> stage_kernels;
+  for (auto *kernel : *dst_kernels) {
+    auto subgraph_type = kernel->subgraph_type();
+    auto subgraph = reinterpret_cast<kernel::SubGraphKernel *>(kernel);
+    if ((subgraph_type != kernel::kCpuFP32SubGraph && subgraph_type != kernel::kCpuFP16SubGraph) ||
+        subgraph->nodes().size() < stage_num) {
+      stage_kernels.push_back(kernel);
+      continue;
+    }
+    // nodes are in topological order, so the tensors between contiguous stages only flow forward.
+    auto nodes = subgraph->nodes();
+    std::vector<float> costs(nodes.size());
+    float total_cost = 0.0f;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      // unknown shape, regard every node as the same.
+      costs[i] = MSMAX(ParallelExecutor::KernelCost(nodes[i]), 1.0f);
+      total_cost += costs[i];
+    }
+    std::vector<std::vector<kernel::KernelExec *>> stages(1);
+    float stage_cost = 0.0f;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      auto left_nodes = nodes.size() - i;
+      auto left_stages = stage_num - stages.size();
+      if (!stages.back().empty() && left_stages > 0 &&
+          (stage_cost >= total_cost * stages.size() / stage_num || left_nodes <= left_stages)) {
+        stages.emplace_back();
+      }
+      stages.back().push_back(nodes[i]);
+      stage_cost += costs[i];
+    }
+    std::vector<kernel::KernelExec *> new_subgraphs;
+    for (auto &stage : stages) {
+      auto stage_subgraph = kernel::KernelExecUtil::CreateSubGraphKernel(stage, nullptr, nullptr, subgraph_type,
+                                                                         *context_, schema_version_);
+      if (stage_subgraph == nullptr) {
+        MS_LOG(ERROR) << "Create pipeline stage failed, subgraph: " << subgraph->name();
+        for (auto *new_subgraph : new_subgraphs) {
+          reinterpret_cast<kernel::SubGraphKernel *>(new_subgraph)->set_nodes({});
+          delete new_subgraph;
+        }
+        return RET_ERROR;
+      }
+      new_subgraphs.push_back(stage_subgraph);
+    }
+    MS_LOG(INFO) << "Split " << subgraph->name() << " into " << new_subgraphs.size() << " pipeline stages.";
+    // the nodes are owned by the stages now.
+    subgraph->set_nodes({});
+    delete subgraph;
+    stage_kernels.insert(stage_kernels.end(), new_subgraphs.begin(), new_subgraphs.end());
+  }
+  *dst_kernels = stage_kernels;
+#endif
+  return RET_OK;
+}
+
+void Scheduler::MarkPureSubGraphs(const std::vector<kernel::KernelExec *> &dst_kernels) {
+  if (*is_control_flow_ || is_train_session_) {
+    return;
+  }
+  for (auto *kernel : dst_kernels) {
+    if (kernel->desc().arch == kernel::KERNEL_ARCH::kDelegate) {
+      continue;
+    }
+    auto subgraph = reinterpret_cast<kernel::SubGraphKernel *>(kernel);
+    subgraph->set_pure(IsPureSubGraph(subgraph));
+  }
+}
+
 bool Scheduler::CheckRunNCXPass() {
   // Only valid for CPU inference right now.
   if (*is_control_flow_ || delegate_ != nullptr || is_train_session_) {
@@ -500,6 +656,14 @@ int Scheduler::Schedule(std::vector<kernel::KernelExec *> *dst_kernels) {
     }
   }
 
+  ret = SplitPipelineStages(dst_kernels);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Split pipeline stages failed.";
+    return ret;
+  }
+
+  MarkPureSubGraphs(*dst_kernels);
+
   ret = InitKernels(std::move(*dst_kernels));
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "InitKernels failed.";
@@ -1056,6 +1220,11 @@ int Scheduler::FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std:
     MS_LOG(DEBUG) << "Dequant input tensors failed: " << ret;
     return RET_NOT_SUPPORT;
   }
+  ret = DecodeBf16ConstTensors(op_parameter, in_tensors, kernel_data_type);
+  if (ret != RET_OK) {
+    MS_LOG(DEBUG) << "Decode bf16 input tensors failed: " << ret;
+    return RET_NOT_SUPPORT;
+  }
   std::map<Tensor *, Tensor *> restored_origin_tensors;
 
   if (is_train_session_) {
@@ -92,6 +92,10 @@ class Scheduler {
                          const LiteGraph::Node *node, TypeId data_type, kernel::KernelExec **kernel);
 
   int InitKernels(std::vector<kernel::KernelExec *> &&dst_kernels);
+  // split big cpu subgraphs into pipeline stages, each stage is run by its own actor.
+  int SplitPipelineStages(std::vector<kernel::KernelExec *> *dst_kernels);
+  // mark the subgraphs whose outputs are determined by their inputs, which can be memoized across inferences.
+  void MarkPureSubGraphs(const std::vector<kernel::KernelExec *> &dst_kernels);
   kernel::KernelExec *SchedulePartialToKernel(const lite::LiteGraph::Node *src_node);
   // schedule a partial node to a subgraph_kernel
   std::vector<kernel::KernelExec *> ScheduleSubGraphToSubGraphKernels(const int &subgraph_index);
@@ -28,6 +28,7 @@
 #include "src/common/utils.h"
 #include "src/common/prim_inner.h"
 #include "src/runtime/kernel_exec_util.h"
+#include "src/runtime/parallel_executor.h"
 
 namespace mindspore::kernel {
 using mindspore::lite::RET_ERROR;
@@ -412,8 +413,40 @@ int CpuSubGraph::Prepare() {
   return RET_OK;
 }
 
+int CpuSubGraph::InitParallelExecutor(lite::InnerContext *ctx) {
+  auto executor = new (std::nothrow) lite::ParallelExecutor();
+  if (executor == nullptr) {
+    MS_LOG(ERROR) << "new ParallelExecutor failed.";
+    return RET_ERROR;
+  }
+  auto ret = executor->Prepare(nodes_, this->in_tensors(), this->out_tensors(), ctx);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "prepare ParallelExecutor failed, subgraph: " << this->name();
+    delete executor;
+    return ret;
+  }
+  if (executor->inter_op_parallel_num() <= 1) {
+    MS_LOG(DEBUG) << "no inter op parallelism in subgraph: " << this->name();
+    delete executor;
+    return RET_OK;
+  }
+  delete this->executor_;
+  this->executor_ = executor;
+  return RET_OK;
+}
+
 int CpuSubGraph::Execute(const KernelCallBack &before, const KernelCallBack &after) {
   MS_ASSERT(this->Context()->allocator.get() != nullptr);
+  if (this->memo_ != nullptr) {
+    return ExecuteWithMemo(before, after);
+  }
+  return ExecuteNodes(before, after);
+}
+
+int CpuSubGraph::ExecuteNodes(const KernelCallBack &before, const KernelCallBack &after) {
+  if (this->executor_ != nullptr) {
+    return SubGraphKernel::Execute(before, after);
+  }
 
   for (auto *kernel : nodes_) {
     MS_ASSERT(kernel != nullptr);
@@ -425,4 +458,41 @@ int CpuSubGraph::Execute(const KernelCallBack &before, const KernelCallBack &aft
   }
   return RET_OK;
 }
+
+int CpuSubGraph::ExecuteWithMemo(const KernelCallBack &before, const KernelCallBack &after) {
+  bool hit = false;
+  auto ret = memo_->Lookup(this, in_tensors(), out_tensors(), &hit);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "lookup subgraph memo failed, name: " << this->name();
+    return ret;
+  }
+  MSCallBackParam callback_param{this->name(), hit ? lite::kSubGraphMemoHit : lite::kSubGraphMemoMiss};
+  if (before != nullptr && !before(this->in_tensors(), this->out_tensors(), callback_param)) {
+    MS_LOG(WARNING) << "run kernel before_callback failed, name: " << this->name();
+  }
+  if (hit) {
+    // the nodes are skipped, release the subgraph inputs as the nodes consuming them do.
+    for (auto *node : nodes_) {
+      for (auto *tensor : node->in_tensors()) {
+        if (lite::IsContain(this->in_tensors(), tensor)) {
+          tensor->DecRefCount();
+        }
+      }
+    }
+  } else {
+    ret = ExecuteNodes(before, after);
+    if (ret != RET_OK) {
+      return ret;
+    }
+    ret = memo_->Insert(this, out_tensors());
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "insert subgraph memo failed, name: " << this->name();
+      return ret;
+    }
+  }
+  if (after != nullptr && !after(this->in_tensors(), this->out_tensors(), callback_param)) {
+    MS_LOG(WARNING) << "run kernel after_callback failed, name: " << this->name();
+  }
+  return RET_OK;
+}
 }  // namespace mindspore::kernel
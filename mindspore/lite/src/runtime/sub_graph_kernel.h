@@ -25,6 +25,7 @@
 #include <memory>
 #include "src/runtime/kernel_exec.h"
 #include "src/runtime/executor.h"
+#include "src/runtime/subgraph_memo.h"
 #include "src/common/log_adapter.h"
 #include "src/common/version_manager.h"
 #include "src/runtime/cpu_info.h"
@@ -129,6 +130,11 @@ class SubGraphKernel : public KernelExec {
 
   int DeleteSingleWayNode(KernelExec *kernel, bool keep_input);
 
+  // a pure subgraph has no state and no random node, its outputs are determined by its inputs.
+  bool is_pure() const { return is_pure_; }
+
+  void set_pure(bool is_pure) { is_pure_ = is_pure; }
+
  protected:
   std::vector<KernelExec *> nodes_{};
   // entry nodes in nodes
@@ -137,6 +143,7 @@ class SubGraphKernel : public KernelExec {
   std::vector<KernelExec *> out_nodes_{};
   mindspore::lite::Executor *executor_ = nullptr;
   int schema_version_ = lite::SCHEMA_VERSION::SCHEMA_CUR;
+  bool is_pure_ = false;
 };
 
 class CpuSubGraph : public SubGraphKernel {
@@ -153,6 +160,16 @@ class CpuSubGraph : public SubGraphKernel {
   int SetFp16Attr() override { return SubGraphKernel::SetFp16Attr(); }
   int Execute() override { return Execute(nullptr, nullptr); }
   int Execute(const KernelCallBack &before, const KernelCallBack &after) override;
+  // run independent branches of nodes concurrently, keep sequential execution when there is nothing to parallelize.
+  int InitParallelExecutor(lite::InnerContext *ctx);
+  // reuse the outputs of former inferences with the same inputs, only set for pure subgraphs.
+  void set_memo(lite::SubGraphMemo *memo) { memo_ = memo; }
+
+ private:
+  int ExecuteNodes(const KernelCallBack &before, const KernelCallBack &after);
+  int ExecuteWithMemo(const KernelCallBack &before, const KernelCallBack &after);
+
+  lite::SubGraphMemo *memo_ = nullptr;
 };
 
 class CpuFp32SubGraph : public CpuSubGraph {
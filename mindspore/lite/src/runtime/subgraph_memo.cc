@@ -0,0 +1,185 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/subgraph_memo.h"
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+#include "src/common/log_util.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr uint64_t kHashSeed = 0x9e3779b97f4a7c15ULL;
+constexpr int kHashLeftShift = 6;
+constexpr int kHashRightShift = 2;
+
+void HashCombine(uint64_t *seed, uint64_t value) {
+  *seed ^= value + kHashSeed + (*seed << kHashLeftShift) + (*seed >> kHashRightShift);
+}
+
+// const inputs never change, only the other inputs are part of the key.
+bool IsKeyInput(const Tensor *tensor) { return tensor != nullptr && !tensor->IsConst(); }
+}  // namespace
+
+uint64_t SubGraphMemo::HashInputs(const void *owner, const std::vector<Tensor *> &inputs) const {
+  uint64_t seed = std::hash<const void *>()(owner);
+  for (auto *input : inputs) {
+    if (!IsKeyInput(input)) {
+      continue;
+    }
+    HashCombine(&seed, static_cast<uint64_t>(input->data_type()));
+    for (auto dim : input->shape()) {
+      HashCombine(&seed, static_cast<uint64_t>(dim));
+    }
+    if (input->data() != nullptr) {
+      HashCombine(&seed, std::hash<std::string_view>()(
+                           std::string_view(static_cast<const char *>(input->data()), input->Size())));
+    }
+  }
+  return seed;
+}
+
+bool SubGraphMemo::MatchInputs(const Entry &entry, const std::vector<Tensor *> &inputs) const {
+  size_t index = 0;
+  for (auto *input : inputs) {
+    if (!IsKeyInput(input)) {
+      continue;
+    }
+    if (index >= entry.inputs.size()) {
+      return false;
+    }
+    const auto &cached = entry.inputs[index++];
+    if (input->data() == nullptr || cached.data_type != input->data_type() || cached.shape != input->shape() ||
+        cached.data.size() != input->Size() || memcmp(cached.data.data(), input->data(), cached.data.size()) != 0) {
+      return false;
+    }
+  }
+  return index == entry.inputs.size();
+}
+
+void SubGraphMemo::EvictEntries(size_t need_size) {
+  while (!entries_.empty() && cached_size_ + need_size > capacity_) {
+    auto &entry = entries_.back();
+    cached_size_ -= entry.size;
+    entry_map_.erase(entry.key);
+    entries_.pop_back();
+  }
+}
+
+int SubGraphMemo::Lookup(const void *owner, const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+                         bool *hit) {
+  CHECK_NULL_RETURN(hit);
+  *hit = false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = HashInputs(owner, inputs);
+  auto iter = entry_map_.find(key);
+  if (iter != entry_map_.end() && iter->second->owner == owner && iter->second->outputs.size() == outputs.size() &&
+      MatchInputs(*iter->second, inputs)) {
+    const auto &entry = *iter->second;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      auto *output = outputs[i];
+      CHECK_NULL_RETURN(output);
+      const auto &cached = entry.outputs[i];
+      output->set_data_type(cached.data_type);
+      output->set_format(cached.format);
+      output->set_shape(cached.shape);
+      auto ret = output->MallocData();
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "Malloc data of memoized output failed, tensor: " << output->tensor_name();
+        return ret;
+      }
+      if (output->Size() != cached.data.size()) {
+        MS_LOG(ERROR) << "Size of memoized output mismatch, tensor: " << output->tensor_name();
+        return RET_ERROR;
+      }
+      memcpy(output->data(), cached.data.data(), cached.data.size());
+      output->ResetRefCount();
+    }
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    hit_count_++;
+    *hit = true;
+    return RET_OK;
+  }
+
+  miss_count_++;
+  auto &pending = pending_entries_[owner];
+  pending = Entry();
+  pending.owner = owner;
+  pending.key = key;
+  for (auto *input : inputs) {
+    if (!IsKeyInput(input)) {
+      continue;
+    }
+    // an input without data can't be compared, give up caching this time.
+    if (input->data() == nullptr) {
+      pending_entries_.erase(owner);
+      return RET_OK;
+    }
+    TensorData cached;
+    cached.data_type = input->data_type();
+    cached.format = input->format();
+    cached.shape = input->shape();
+    cached.data.assign(static_cast<const char *>(input->data()), input->Size());
+    pending.size += cached.data.size();
+    pending.inputs.push_back(std::move(cached));
+  }
+  return RET_OK;
+}
+
+int SubGraphMemo::Insert(const void *owner, const std::vector<Tensor *> &outputs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto pending_iter = pending_entries_.find(owner);
+  if (pending_iter == pending_entries_.end()) {
+    return RET_OK;
+  }
+  auto entry = std::move(pending_iter->second);
+  pending_entries_.erase(pending_iter);
+  for (auto *output : outputs) {
+    CHECK_NULL_RETURN(output);
+    if (output->data() == nullptr) {
+      MS_LOG(INFO) << "Output of subgraph has been released, skip memoizing, tensor: " << output->tensor_name();
+      return RET_OK;
+    }
+    TensorData cached;
+    cached.data_type = output->data_type();
+    cached.format = output->format();
+    cached.shape = output->shape();
+    cached.data.assign(static_cast<const char *>(output->data()), output->Size());
+    entry.size += cached.data.size();
+    entry.outputs.push_back(std::move(cached));
+  }
+  if (entry.size > capacity_) {
+    MS_LOG(DEBUG) << "Entry size " << entry.size << " exceeds the capacity of subgraph memo " << capacity_;
+    return RET_OK;
+  }
+  // the entry with the same key is replaced, it is a hash collision or an outdated one.
+  auto iter = entry_map_.find(entry.key);
+  if (iter != entry_map_.end()) {
+    cached_size_ -= iter->second->size;
+    entries_.erase(iter->second);
+    entry_map_.erase(iter);
+  }
+  EvictEntries(entry.size);
+  cached_size_ += entry.size;
+  auto key = entry.key;
+  entries_.push_front(std::move(entry));
+  entry_map_[key] = entries_.begin();
+  return RET_OK;
+}
+}  // namespace mindspore::lite
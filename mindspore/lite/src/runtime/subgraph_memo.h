@@ -0,0 +1,83 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_SUBGRAPH_MEMO_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_SUBGRAPH_MEMO_H_
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "src/tensor.h"
+
+namespace mindspore::lite {
+// node type passed to KernelCallBack when a memoized subgraph is looked up, node name is the name of subgraph.
+static const char *const kSubGraphMemoHit = "SubGraphMemoHit";
+static const char *const kSubGraphMemoMiss = "SubGraphMemoMiss";
+
+// SubGraphMemo caches the outputs of pure subgraphs in a LRU cache bounded by capacity bytes. The key is the content
+// of the subgraph inputs, so a subgraph whose inputs are the same as a former inference reuses the former outputs
+// instead of running its kernels again.
+class SubGraphMemo {
+ public:
+  explicit SubGraphMemo(size_t capacity) : capacity_(capacity) {}
+  ~SubGraphMemo() = default;
+
+  // fill the outputs with the cached data if hit, otherwise record the inputs for the following Insert.
+  int Lookup(const void *owner, const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs, bool *hit);
+
+  // cache the outputs for the inputs recorded by the last missed Lookup of owner.
+  int Insert(const void *owner, const std::vector<Tensor *> &outputs);
+
+  size_t hit_count() const { return hit_count_; }
+
+  size_t miss_count() const { return miss_count_; }
+
+  size_t cached_size() const { return cached_size_; }
+
+ private:
+  struct TensorData {
+    TypeId data_type = kTypeUnknown;
+    Format format = NHWC;
+    std::vector<int> shape;
+    std::string data;
+  };
+  struct Entry {
+    const void *owner = nullptr;
+    uint64_t key = 0;
+    std::vector<TensorData> inputs;
+    std::vector<TensorData> outputs;
+    size_t size = 0;
+  };
+
+  uint64_t HashInputs(const void *owner, const std::vector<Tensor *> &inputs) const;
+  bool MatchInputs(const Entry &entry, const std::vector<Tensor *> &inputs) const;
+  void EvictEntries(size_t need_size);
+
+  size_t capacity_ = 0;
+  size_t cached_size_ = 0;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+  // the most recently used entry is at the front.
+  std::list<Entry> entries_;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> entry_map_;
+  // inputs of the last missed lookup of every owner, which are probably released after the subgraph runs.
+  std::unordered_map<const void *, Entry> pending_entries_;
+  std::mutex mutex_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_SUBGRAPH_MEMO_H_
@@ -21,6 +21,8 @@
 #include "thread/threadpool.h"
 
 namespace mindspore::lite {
+constexpr float kDefaultKernelComputeCost = 1.0f;
+
 const std::map<int32_t, float> kernel_compute_cost_map_ = {
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU), 1.806f},        // dataNum about 100k
   {TC_TYPE(schema::PrimitiveType_Activation, schema::ActivationType_RELU6), 1.806f},       // dataNum about 100k
@@ -119,6 +121,15 @@ int ThreadNumUpdateStrategy(const ThreadCostContext *thread_cost_context, int ta
   return task_num;
 }
 
+float GetKernelComputeCost(int32_t kernel_type) {
+  auto iter = kernel_compute_cost_map_.find(kernel_type);
+  if (iter != kernel_compute_cost_map_.end()) {
+    return iter->second;
+  }
+  return kDefaultKernelComputeCost;
+}
+
+#ifdef DYNAMIC_THREAD_DISTRIBUTE
 int UpdateThreadNum(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_unit_store_num, int64_t unit_num,
                     int thread_num) {
   if (kernel_compute_cost_map_.count(kernel_type) > 0) {
@@ -131,4 +142,5 @@ int UpdateThreadNum(int32_t kernel_type, int64_t per_unit_load_num, int64_t per_
   }
   return thread_num;
 }
+#endif
 }  // namespace mindspore::lite
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/weight_decode_cache.h"
+#include <utility>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore::lite {
+WeightDecodeCache::WeightDecodeCache(size_t capacity) : capacity_(capacity) {
+  prefetch_thread_ = std::thread(&WeightDecodeCache::PrefetchLoop, this);
+}
+
+WeightDecodeCache::~WeightDecodeCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  prefetch_cond_.notify_all();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+  // tensors may have been destroyed, only the decoded data is released here.
+  for (auto &item : entries_) {
+    free(item.second.data);
+    item.second.data = nullptr;
+  }
+  entries_.clear();
+}
+
+int WeightDecodeCache::Register(Tensor *tensor, size_t size, WeightDecodeFunc decode_func) {
+  if (tensor == nullptr || decode_func == nullptr) {
+    MS_LOG(ERROR) << "tensor or decode function is nullptr.";
+    return RET_NULL_PTR;
+  }
+  if (tensor->allocator() != nullptr) {
+    MS_LOG(DEBUG) << "tensor with allocator is not supported, tensor: " << tensor->tensor_name();
+    return RET_NOT_SUPPORT;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.find(tensor) != entries_.end()) {
+    MS_LOG(ERROR) << "tensor has been registered: " << tensor->tensor_name();
+    return RET_ERROR;
+  }
+  tensor->FreeData();
+  tensor->set_data(nullptr);
+  tensor->set_own_data(false);
+  auto &entry = entries_[tensor];
+  entry.size = size;
+  entry.decode_func = std::move(decode_func);
+  entry.lru_iter = lru_list_.end();
+  return RET_OK;
+}
+
+void WeightDecodeCache::SetExecutionOrder(const std::vector<std::vector<Tensor *>> &kernel_weights) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  next_weights_.clear();
+  for (size_t i = 0; i + 1 < kernel_weights.size(); ++i) {
+    for (auto *tensor : kernel_weights[i]) {
+      next_weights_[tensor] = kernel_weights[i + 1];
+    }
+  }
+}
+
+int WeightDecodeCache::Acquire(const std::vector<Tensor *> &tensors) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  std::vector<Entry *> pinned;
+  const Tensor *last_tensor = nullptr;
+  for (auto *tensor : tensors) {
+    auto iter = entries_.find(tensor);
+    if (iter == entries_.end()) {
+      continue;
+    }
+    auto &entry = iter->second;
+    entry.pin_count++;
+    pinned.push_back(&entry);
+    auto ret = Load(tensor, &entry, &lock);
+    if (ret != RET_OK) {
+      // the kernel is not run, so the weights pinned by this call are not released by it.
+      for (auto *pinned_entry : pinned) {
+        pinned_entry->pin_count--;
+      }
+      MS_LOG(ERROR) << "decode weight failed, tensor: " << tensor->tensor_name();
+      return ret;
+    }
+    last_tensor = tensor;
+  }
+  if (last_tensor != nullptr) {
+    Prefetch(last_tensor);
+  }
+  return RET_OK;
+}
+
+void WeightDecodeCache::Release(const std::vector<Tensor *> &tensors) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto *tensor : tensors) {
+    auto iter = entries_.find(tensor);
+    if (iter != entries_.end() && iter->second.pin_count > 0) {
+      iter->second.pin_count--;
+    }
+  }
+}
+
+int WeightDecodeCache::Load(Tensor *tensor, Entry *entry, std::unique_lock<std::mutex> *lock) {
+  decode_cond_.wait(*lock, [entry] { return !entry->decoding; });
+  if (entry->data != nullptr) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, entry->lru_iter);
+    return RET_OK;
+  }
+  // decode without holding the lock, the other weights are still accessible meanwhile.
+  entry->decoding = true;
+  lock->unlock();
+  auto data = entry->decode_func();
+  lock->lock();
+  entry->decoding = false;
+  decode_cond_.notify_all();
+  if (data == nullptr) {
+    return RET_ERROR;
+  }
+  decode_count_++;
+  EvictLocked(entry->size);
+  entry->data = data;
+  lru_list_.push_front(tensor);
+  entry->lru_iter = lru_list_.begin();
+  cached_size_ += entry->size;
+  tensor->set_data(data);
+  tensor->set_own_data(false);
+  return RET_OK;
+}
+
+void WeightDecodeCache::EvictLocked(size_t need_size) {
+  auto iter = lru_list_.end();
+  while (cached_size_ + need_size > capacity_ && iter != lru_list_.begin()) {
+    --iter;
+    auto *tensor = *iter;
+    auto &entry = entries_[tensor];
+    if (entry.pin_count > 0) {
+      continue;
+    }
+    free(entry.data);
+    entry.data = nullptr;
+    tensor->set_data(nullptr);
+    tensor->set_own_data(false);
+    cached_size_ -= entry.size;
+    iter = lru_list_.erase(iter);
+    entry.lru_iter = lru_list_.end();
+  }
+  if (cached_size_ + need_size > capacity_) {
+    MS_LOG(DEBUG) << "pinned weights exceed the capacity of decode cache, cached size: " << cached_size_
+                  << ", need size: " << need_size << ", capacity: " << capacity_;
+  }
+}
+
+void WeightDecodeCache::Prefetch(const Tensor *tensor) {
+  auto iter = next_weights_.find(tensor);
+  if (iter == next_weights_.end()) {
+    return;
+  }
+  for (auto *next : iter->second) {
+    prefetch_queue_.push(next);
+  }
+  prefetch_cond_.notify_one();
+}
+
+void WeightDecodeCache::PrefetchLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    prefetch_cond_.wait(lock, [this] { return stop_ || !prefetch_queue_.empty(); });
+    if (stop_) {
+      return;
+    }
+    auto *tensor = prefetch_queue_.front();
+    prefetch_queue_.pop();
+    auto iter = entries_.find(tensor);
+    if (iter == entries_.end() || iter->second.data != nullptr || iter->second.decoding) {
+      continue;
+    }
+    auto &entry = iter->second;
+    // pin the weight to keep it from being evicted by the next prefetched one.
+    entry.pin_count++;
+    if (Load(tensor, &entry, &lock) != RET_OK) {
+      MS_LOG(WARNING) << "prefetch weight failed, tensor: " << tensor->tensor_name();
+    }
+    entry.pin_count--;
+  }
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_DECODE_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_DECODE_CACHE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "src/tensor.h"
+
+namespace mindspore::lite {
+// return the decoded data malloc-ed by the function, nullptr means failure.
+using WeightDecodeFunc = std::function<void *()>;
+
+// WeightDecodeCache keeps the decoded data of compressed weights in a LRU cache bounded by capacity bytes. A weight is
+// decoded when the kernel reading it is about to run, and the weights of the next kernel are decoded on a background
+// thread meanwhile. Data of the weights which are not pinned by a running kernel can be evicted at any time.
+// Registered weights have already been decoded once by ConvertTensors, so the capacity bounds the memory held after
+// compile, not the peak memory of compiling the graph.
+class WeightDecodeCache {
+ public:
+  explicit WeightDecodeCache(size_t capacity);
+  ~WeightDecodeCache();
+
+  // release the current data of tensor, and decode it by decode_func when it is acquired.
+  int Register(Tensor *tensor, size_t size, WeightDecodeFunc decode_func);
+
+  bool IsRegistered(const Tensor *tensor) const { return entries_.find(tensor) != entries_.end(); }
+
+  // the registered tensors of every kernel in execution order, used to prefetch the weights of the next kernel.
+  void SetExecutionOrder(const std::vector<std::vector<Tensor *>> &kernel_weights);
+
+  // make sure data of the registered tensors is ready and pin them, unregistered tensors are ignored.
+  int Acquire(const std::vector<Tensor *> &tensors);
+
+  void Release(const std::vector<Tensor *> &tensors);
+
+  size_t cached_size() const { return cached_size_; }
+
+  size_t decode_count() const { return decode_count_; }
+
+ private:
+  struct Entry {
+    size_t size = 0;
+    WeightDecodeFunc decode_func = nullptr;
+    void *data = nullptr;
+    int pin_count = 0;
+    bool decoding = false;
+    std::list<Tensor *>::iterator lru_iter;
+  };
+
+  int Load(Tensor *tensor, Entry *entry, std::unique_lock<std::mutex> *lock);
+  void EvictLocked(size_t need_size);
+  void Prefetch(const Tensor *tensor);
+  void PrefetchLoop();
+
+  size_t capacity_ = 0;
+  size_t cached_size_ = 0;
+  size_t decode_count_ = 0;
+  std::unordered_map<const Tensor *, Entry> entries_;
+  // the most recently used tensor is at the front.
+  std::list<Tensor *> lru_list_;
+  std::unordered_map<const Tensor *, std::vector<Tensor *>> next_weights_;
+  std::mutex mutex_;
+  std::condition_variable decode_cond_;
+
+  std::queue<Tensor *> prefetch_queue_;
+  std::condition_variable prefetch_cond_;
+  std::thread prefetch_thread_;
+  bool stop_ = false;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_DECODE_CACHE_H_
@@ -270,6 +270,44 @@ STATUS WeightDecoder::SparseDecompress(const SchemaTensorWrapper &src_tensor, Te
   return RET_OK;
 }
 
+STATUS WeightDecoder::FloatSparseDecompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor) {
+  MS_ASSERT(src_tensor.handler() != nullptr);
+  MS_ASSERT(src_tensor.data() != nullptr);
+  MS_LOG(DEBUG) << "un-sparse float weight";
+  MS_CHECK_TRUE_MSG(dst_tensor->data_type() == kNumberTypeFloat32, RET_ERROR, "sparse weight must be float32.");
+  // a bitmap of the non zero elements followed by the non zero values
+  auto elem_cnt = static_cast<size_t>(dst_tensor->ElementsNum());
+  size_t bitmap_size = UP_DIV(elem_cnt, kBit8);
+  MS_CHECK_TRUE_MSG(src_tensor.length() >= bitmap_size, RET_ERROR, "sparse weight is truncated.");
+  auto bitmap = static_cast<const uint8_t *>(src_tensor.data());
+  auto values = bitmap + bitmap_size;
+  size_t value_cnt = (src_tensor.length() - bitmap_size) / sizeof(float);
+  if (dst_tensor->data() != nullptr) {
+    MS_LOG(ERROR) << "data_c not null";
+    return RET_ERROR;
+  }
+  auto ret = dst_tensor->MallocData();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Malloc tensor data failed";
+    return RET_NULL_PTR;
+  }
+  auto dst_data = static_cast<float *>(dst_tensor->data());
+  size_t value_index = 0;
+  for (size_t i = 0; i < elem_cnt; i++) {
+    if ((bitmap[i / kBit8] >> (i % kBit8)) & 1) {
+      if (value_index >= value_cnt) {
+        MS_LOG(ERROR) << "sparse weight has less values than its bitmap.";
+        return RET_ERROR;
+      }
+      memcpy(dst_data + i, values + value_index * sizeof(float), sizeof(float));
+      value_index++;
+    } else {
+      dst_data[i] = 0.0f;
+    }
+  }
+  return RET_OK;
+}
+
 std::vector<bool> WeightDecoder::StringToBitVector(const std::string &str) {
   std::vector<bool> vec(str.size() * kBit8);
   size_t index = 0;
@@ -495,6 +533,8 @@ int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite:
     return IndexingDecompress(src_tensor, dst_tensor);
   } else if (src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_SPARSE) {
     return SparseDecompress(src_tensor, dst_tensor);
+  } else if (src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_FLOAT_SPARSE) {
+    return FloatSparseDecompress(src_tensor, dst_tensor);
   }
   if (!NeedBitUppackCheck(src_tensor)) {
     return RET_NO_CHANGE;
@@ -513,4 +553,42 @@ int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite:
   return RET_NO_CHANGE;
 #endif
 }
+
+int WeightDecoder::DecodeWeight(const SchemaTensorWrapper &src_tensor, int preferred_dim, TypeId dst_data_type,
+                                lite::Tensor *dst_tensor) {
+  MS_ASSERT(dst_tensor != nullptr);
+  if (src_tensor.handler() == nullptr || src_tensor.data() == nullptr) {
+    MS_LOG(ERROR) << "src tensor has no data.";
+    return RET_ERROR;
+  }
+  auto ret = DecompressTensor(src_tensor, dst_tensor);
+  if (ret == RET_NO_CHANGE) {
+    if (dst_tensor->Size() == 0 || src_tensor.length() < dst_tensor->Size()) {
+      MS_LOG(ERROR) << "Tensor data shape invalid";
+      return RET_ERROR;
+    }
+    if (dst_tensor->MallocData() != RET_OK) {
+      MS_LOG(ERROR) << "Malloc tensor data failed.";
+      return RET_ERROR;
+    }
+    (void)memcpy(dst_tensor->data(), src_tensor.data(), dst_tensor->Size());
+  } else if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Decompress tensor data failed: " << ret;
+    return ret;
+  }
+  if (dst_tensor->data_type() == dst_data_type) {
+    return RET_OK;
+  }
+#ifndef WEIGHT_DECODE_CLIP
+  ret = DequantTensor(dst_tensor, preferred_dim, dst_data_type);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Dequant tensor failed: " << ret;
+    return RET_ERROR;
+  }
+  return RET_OK;
+#else
+  MS_LOG(ERROR) << unsupport_weight_decode_log;
+  return RET_NOT_SUPPORT;
+#endif
+}
 }  // namespace mindspore::lite
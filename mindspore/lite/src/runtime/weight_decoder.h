@@ -45,6 +45,11 @@ class WeightDecoder {
                          const std::string &model_version, bool float_mode);
   static int DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
 
+  // Decode src_tensor into dst_tensor and dequant it into dst_data_type if needed. dst_tensor carries the origin data
+  // type, shape and quant params of src_tensor, used to restore a weight whose decoded data has been released.
+  static int DecodeWeight(const SchemaTensorWrapper &src_tensor, int preferred_dim, TypeId dst_data_type,
+                          lite::Tensor *dst_tensor);
+
   template <typename T>
   static int GetPreferredDim(const std::vector<T *> &in_tensors, const OpParameter *op_parameter, int index,
                              const std::vector<int> &dims, const std::string &model_version) {
@@ -110,6 +115,8 @@ class WeightDecoder {
 
   static STATUS IndexingDecompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor);
 
+  static STATUS FloatSparseDecompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor);
+
   static bool IsChannelFirst(int index, const OpParameter *op_parameter);
 
   // A * stride_a + bucket_index * stride_b + C
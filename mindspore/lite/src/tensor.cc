@@ -353,6 +353,9 @@ std::string Tensor::ToString() const {
     case kNumberTypeFloat16: {
       oss << DataToString<int16_t>(data_, this->ElementsNum());
     } break;
+    case kNumberTypeBFloat16: {
+      oss << DataToString<uint16_t>(data_, this->ElementsNum());
+    } break;
     case kNumberTypeInt32: {
       oss << DataToString<int32_t>(data_, this->ElementsNum());
     } break;
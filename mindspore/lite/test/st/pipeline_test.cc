@@ -0,0 +1,170 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "common/common_test.h"
+#include "schema/inner/model_generated.h"
+#include "include/api/model.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kElementNum = 4;
+constexpr size_t kMicroBatchNum = 5;
+
+class PipelineTest : public mindspore::CommonTest {
+ public:
+  PipelineTest() {}
+};
+
+std::unique_ptr<schema::CNodeT> CreateNode(const std::string &name, schema::PrimitiveType type, uint32_t input,
+                                           uint32_t output) {
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {input};
+  node->outputIndex = {output};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = type;
+  if (type == schema::PrimitiveType_Cos) {
+    node->primitive->value.value = new schema::CosT;
+  } else if (type == schema::PrimitiveType_Sin) {
+    node->primitive->value.value = new schema::SinT;
+  } else {
+    node->primitive->value.value = new schema::ExpFusionT;
+  }
+  node->name = name;
+  return node;
+}
+
+// tensor0 -> cos -> exp -> sin -> cos -> tensor4
+void ConstructModel(schema::MetaGraphT *meta_graph) {
+  meta_graph->name = "pipeline_graph";
+  meta_graph->version = mindspore::Version();
+  meta_graph->nodes.emplace_back(CreateNode("op1", schema::PrimitiveType_Cos, 0, 1));
+  meta_graph->nodes.emplace_back(CreateNode("op2", schema::PrimitiveType_ExpFusion, 1, 2));
+  meta_graph->nodes.emplace_back(CreateNode("op3", schema::PrimitiveType_Sin, 2, 3));
+  meta_graph->nodes.emplace_back(CreateNode("op4", schema::PrimitiveType_Cos, 3, 4));
+  for (size_t i = 0; i <= meta_graph->nodes.size(); ++i) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = lite::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    tensor->dims = {1, 2, 2, 1};
+    tensor->offset = -1;
+    tensor->name = "tensor" + std::to_string(i);
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {4};
+}
+
+float MicroBatchInput(size_t index, size_t i) { return static_cast<float>(index) + 0.25f * i; }
+
+void BuildModel(Model *model, flatbuffers::FlatBufferBuilder *builder) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  ConstructModel(meta_graph.get());
+  auto offset = schema::MetaGraph::Pack(*builder, meta_graph.get());
+  builder->Finish(offset);
+  schema::FinishMetaGraphBuffer(*builder, offset);
+
+  auto context = std::make_shared<mindspore::Context>();
+  context->SetThreadNum(2);
+  context->MutableDeviceInfo().push_back(std::make_shared<CPUDeviceInfo>());
+  ASSERT_EQ(model->UpdateConfig("pipeline", {"stage_num", "2"}), kSuccess);
+  ASSERT_EQ(model->Build(builder->GetBufferPointer(), builder->GetSize(), kMindIR_Lite, context), kSuccess);
+}
+}  // namespace
+
+TEST_F(PipelineTest, PredictPipeline) {
+  Model model;
+  flatbuffers::FlatBufferBuilder builder(1024);
+  BuildModel(&model, &builder);
+
+  auto feed = [&model](size_t index) {
+    auto inputs = model.GetInputs();
+    auto data = static_cast<float *>(inputs[0].MutableData());
+    for (size_t i = 0; i < kElementNum; ++i) {
+      data[i] = MicroBatchInput(index, i);
+    }
+    return Status(kSuccess);
+  };
+  std::vector<size_t> fetch_order;
+  std::vector<std::vector<float>> results(kMicroBatchNum);
+  auto fetch = [&model, &fetch_order, &results](size_t index) {
+    auto outputs = model.GetOutputs();
+    auto data = static_cast<const float *>(outputs[0].Data().get());
+    results[index].assign(data, data + kElementNum);
+    fetch_order.push_back(index);
+    return Status(kSuccess);
+  };
+  // run twice, the buffers handed over to the graph output are released before the next run.
+  for (int run = 0; run < 2; ++run) {
+    fetch_order.clear();
+    ASSERT_EQ(model.PredictPipeline(kMicroBatchNum, feed, fetch), kSuccess);
+    ASSERT_EQ(fetch_order.size(), kMicroBatchNum);
+    for (size_t index = 0; index < kMicroBatchNum; ++index) {
+      ASSERT_EQ(fetch_order[index], index);
+      for (size_t i = 0; i < kElementNum; ++i) {
+        auto expect = std::cos(std::sin(std::exp(std::cos(MicroBatchInput(index, i)))));
+        ASSERT_LE(std::fabs(results[index][i] - expect), 1e-5);
+      }
+    }
+  }
+
+  // the model still predicts a single batch after pipelining.
+  auto inputs = model.GetInputs();
+  ASSERT_EQ(feed(0), kSuccess);
+  auto outputs = model.GetOutputs();
+  ASSERT_EQ(model.Predict(inputs, &outputs), kSuccess);
+  auto data = static_cast<const float *>(outputs[0].Data().get());
+  for (size_t i = 0; i < kElementNum; ++i) {
+    ASSERT_LE(std::fabs(data[i] - results[0][i]), 1e-5);
+  }
+}
+
+TEST_F(PipelineTest, FeedFailed) {
+  Model model;
+  flatbuffers::FlatBufferBuilder builder(1024);
+  BuildModel(&model, &builder);
+
+  const size_t failed_index = 2;
+  auto feed = [&model](size_t index) {
+    if (index == failed_index) {
+      return Status(kLiteError);
+    }
+    auto inputs = model.GetInputs();
+    auto data = static_cast<float *>(inputs[0].MutableData());
+    for (size_t i = 0; i < kElementNum; ++i) {
+      data[i] = MicroBatchInput(index, i);
+    }
+    return Status(kSuccess);
+  };
+  std::vector<size_t> fetch_order;
+  auto fetch = [&fetch_order](size_t index) {
+    fetch_order.push_back(index);
+    return Status(kSuccess);
+  };
+  ASSERT_NE(model.PredictPipeline(kMicroBatchNum, feed, fetch), kSuccess);
+  // the micro-batches fed before the failure are fetched in order, or dropped.
+  ASSERT_LE(fetch_order.size(), failed_index);
+  for (size_t index = 0; index < fetch_order.size(); ++index) {
+    ASSERT_EQ(fetch_order[index], index);
+  }
+  ASSERT_NE(model.PredictPipeline(kMicroBatchNum, nullptr, fetch), kSuccess);
+}
+}  // namespace mindspore
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/dynamic_matmul_int8.h"
+#ifdef ENABLE_AVX
+#include "nnacl/int8/matmul_avx_int8.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+
+namespace mindspore {
+#ifdef ENABLE_AVX
+class MatmulAvxInt8Test : public mindspore::CommonTest {
+ public:
+  MatmulAvxInt8Test() {}
+
+  void SetUp() override { IntelX86CpuInfoInit(); }
+
+  // pack a row-major [row, deep] and a row-major [deep, col] int8 matrix in the row4x4 * row4x16 layout.
+  void Prepare(int row, int col, int deep) {
+    row_ = row;
+    col_ = col;
+    deep_ = deep;
+    deep4_ = UP_ROUND(deep, C4NUM);
+    int row4 = UP_ROUND(row, C4NUM);
+    int col16 = UP_ROUND(col, C16NUM);
+    std::mt19937 gen(row * col + deep);
+    std::uniform_int_distribution<int> dist(INT8_MIN, INT8_MAX);
+    std::vector<int8_t> a(row * deep);
+    std::vector<int8_t> b(deep * col);
+    for (auto &value : a) {
+      value = static_cast<int8_t>(dist(gen));
+    }
+    for (auto &value : b) {
+      value = static_cast<int8_t>(dist(gen));
+    }
+    pack_a_.assign(row4 * deep4_, 0);
+    pack_b_.assign(col16 * deep4_, 0);
+    input_sums_.assign(row4, 0);
+    weight_sums_.assign(col16, 0);
+    PackInput4x4AndInputSumPert(a.data(), pack_a_.data(), input_sums_.data(), deep, row, kFilterZp);
+    RowMajor2Col4x16MajorInt8(b.data(), pack_b_.data(), deep, col);
+    CalcWeightSums(b.data(), deep, col, weight_sums_.data(), RowMajor);
+  }
+
+  void CheckMatmul(MatmulInt8DpFunc func) {
+    int col16 = UP_ROUND(col_, C16NUM);
+    std::vector<int32_t> bias(col16);
+    std::vector<int32_t> filter_zp(col16, kFilterZp);
+    std::vector<int32_t> left_shift(col16, 0);
+    std::vector<int32_t> right_shift(col16, -10);
+    std::vector<int32_t> multiplier(col16, 1 << 30);
+    for (int i = 0; i < col16; ++i) {
+      bias[i] = i * 100;
+    }
+    std::vector<int8_t> expect(row_ * col_);
+    std::vector<int8_t> output(row_ * col_);
+    MatMulInt8_4x16_r(pack_a_.data(), pack_b_.data(), expect.data(), row_, col_, deep4_, col_, input_sums_.data(),
+                      bias.data(), left_shift.data(), right_shift.data(), multiplier.data(), 1, INT8_MIN, INT8_MAX, 0,
+                      filter_zp.data());
+    func(pack_a_.data(), pack_b_.data(), output.data(), row_, col_, deep4_, col_, input_sums_.data(), bias.data(),
+         left_shift.data(), right_shift.data(), multiplier.data(), 1, INT8_MIN, INT8_MAX, 0, filter_zp.data());
+    ASSERT_EQ(0, memcmp(expect.data(), output.data(), expect.size()));
+  }
+
+  void CheckDynamicMatmul(DynamicMatmulInt8DpFunc func) {
+    int col16 = UP_ROUND(col_, C16NUM);
+    std::vector<float> scales(col16);
+    std::vector<float> bias(col16);
+    for (int i = 0; i < col16; ++i) {
+      scales[i] = 0.001f * (i + 1);
+      bias[i] = 0.5f * i;
+    }
+    const int64_t input_zp = 3;
+    const int64_t filter_zp_sum = static_cast<int64_t>(kFilterZp) * deep_;
+    std::vector<float> expect(row_ * col_);
+    std::vector<float> output(row_ * col_);
+    for (int r = 0; r < row_; r += C4NUM) {
+      for (int c = 0; c < col_; c += C16NUM) {
+        DynamicMatmul4x4x16AIWI(pack_a_.data() + r * deep4_, pack_b_.data() + c * deep4_, expect.data() + r * col_ + c,
+                                deep4_, scales.data() + c, bias.data() + c, MSMIN(C4NUM, row_ - r),
+                                MSMIN(C16NUM, col_ - c), col_ * sizeof(float), input_sums_.data() + r,
+                                weight_sums_.data() + c, input_zp, filter_zp_sum);
+      }
+    }
+    func(pack_a_.data(), pack_b_.data(), output.data(), deep4_, scales.data(), bias.data(), row_, col_,
+         col_ * sizeof(float), input_sums_.data(), weight_sums_.data(), input_zp, filter_zp_sum);
+    ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), expect.size(), 0.0001));
+  }
+
+ protected:
+  static constexpr int32_t kFilterZp = 2;
+  int row_ = 0;
+  int col_ = 0;
+  int deep_ = 0;
+  int deep4_ = 0;
+  std::vector<int8_t> pack_a_;
+  std::vector<int8_t> pack_b_;
+  std::vector<int32_t> input_sums_;
+  std::vector<int32_t> weight_sums_;
+};
+
+TEST_F(MatmulAvxInt8Test, MatmulInt8DpAvx2) {
+  Prepare(13, 37, 70);
+  CheckMatmul(MatmulInt8DpAvx2);
+  CheckDynamicMatmul(DynamicMatmulAvx2_4x4x16AIWI);
+}
+
+TEST_F(MatmulAvxInt8Test, MatmulInt8DpSelected) {
+  Prepare(64, 128, 257);
+  CheckMatmul(GetMatmulInt8DpAvxFunc());
+  CheckDynamicMatmul(GetDynamicMatmulInt8DpAvxFunc());
+}
+
+#ifdef ENABLE_AVX512
+TEST_F(MatmulAvxInt8Test, MatmulInt8DpAvx512) {
+  Prepare(5, 17, 9);
+  if (X86_Avx512Bw_Support()) {
+    CheckMatmul(MatmulInt8DpAvx512);
+    CheckDynamicMatmul(DynamicMatmulAvx512_4x4x16AIWI);
+  }
+  if (X86_Avx512Vnni_Support()) {
+    CheckMatmul(MatmulInt8DpAvx512Vnni);
+    CheckDynamicMatmul(DynamicMatmulAvx512Vnni_4x4x16AIWI);
+  }
+}
+#endif
+#endif
+}  // namespace mindspore
@@ -0,0 +1,185 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+#ifdef ENABLE_NEON
+#include <arm_neon.h>
+#endif
+#include "common/common_test.h"
+#include "nnacl/attention_parameter.h"
+#include "mindspore/lite/src/runtime/kernel_registry.h"
+
+namespace mindspore {
+class TestAttentionFp16 : public mindspore::CommonTest {
+ public:
+  TestAttentionFp16() {}
+};
+
+namespace {
+constexpr int kBatch = 2;
+constexpr int kQSeq = 3;
+constexpr int kKvSeq = 70;
+constexpr int kDModel = 6;
+constexpr int kHeadNum = 2;
+constexpr int kHeadSize = 3;
+constexpr int kHidden = kHeadNum * kHeadSize;
+constexpr size_t kActivationNum = 3;
+
+void FillData(std::vector<float> *data, int seed) {
+  for (size_t i = 0; i < data->size(); ++i) {
+    data->at(i) = static_cast<float>((i * 7 + seed * 13) % 17) / 17.0f - 0.5f;
+  }
+}
+
+// dst[rows, col] = src[rows, deep] * weight[deep, col] + bias
+std::vector<float> Linear(const std::vector<float> &src, const std::vector<float> &weight,
+                          const std::vector<float> &bias, int rows, int deep, int col) {
+  std::vector<float> dst(rows * col);
+  for (int r = 0; r < rows; ++r) {
+    for (int c = 0; c < col; ++c) {
+      float sum = bias[c];
+      for (int d = 0; d < deep; ++d) {
+        sum += src[r * deep + d] * weight[d * col + c];
+      }
+      dst[r * col + c] = sum;
+    }
+  }
+  return dst;
+}
+
+std::vector<float> ReferenceAttention(const std::vector<std::vector<float>> &inputs, const std::vector<float> &mask,
+                                      float scale) {
+  auto q = Linear(inputs[0], inputs[3], inputs[7], kBatch * kQSeq, kDModel, kHidden);
+  auto k = Linear(inputs[1], inputs[4], inputs[8], kBatch * kKvSeq, kDModel, kHidden);
+  auto v = Linear(inputs[2], inputs[5], inputs[9], kBatch * kKvSeq, kDModel, kHidden);
+  std::vector<float> context(kBatch * kQSeq * kHidden);
+  std::vector<float> scores(kKvSeq);
+  for (int b = 0; b < kBatch; ++b) {
+    for (int h = 0; h < kHeadNum; ++h) {
+      for (int i = 0; i < kQSeq; ++i) {
+        float max = -1e30f;
+        for (int j = 0; j < kKvSeq; ++j) {
+          float dot = 0.0f;
+          for (int c = 0; c < kHeadSize; ++c) {
+            dot += q[(b * kQSeq + i) * kHidden + h * kHeadSize + c] * k[(b * kKvSeq + j) * kHidden + h * kHeadSize + c];
+          }
+          scores[j] = dot * scale + (1.0f - mask[b * kKvSeq + j]) * -10000.0f;
+          max = std::max(max, scores[j]);
+        }
+        float sum = 0.0f;
+        for (int j = 0; j < kKvSeq; ++j) {
+          scores[j] = std::exp(scores[j] - max);
+          sum += scores[j];
+        }
+        for (int c = 0; c < kHeadSize; ++c) {
+          float out = 0.0f;
+          for (int j = 0; j < kKvSeq; ++j) {
+            out += scores[j] * v[(b * kKvSeq + j) * kHidden + h * kHeadSize + c];
+          }
+          context[(b * kQSeq + i) * kHidden + h * kHeadSize + c] = out / sum;
+        }
+      }
+    }
+  }
+  return Linear(context, inputs[6], inputs[10], kBatch * kQSeq, kHidden, kDModel);
+}
+}  // namespace
+
+// the activations and the mask are float16, the const weights are float32 and packed into float16 in Prepare.
+TEST_F(TestAttentionFp16, MaskedMultiHead) {
+  std::vector<std::vector<int>> shapes = {{kBatch, kQSeq, kDModel},  {kBatch, kKvSeq, kDModel},
+                                          {kBatch, kKvSeq, kDModel}, {kDModel, kHidden},
+                                          {kDModel, kHidden},        {kDModel, kHidden},
+                                          {kHidden, kDModel},        {kHidden},
+                                          {kHidden},                 {kHidden},
+                                          {kDModel}};
+  std::vector<std::vector<float>> datas(shapes.size());
+  std::vector<std::vector<float16_t>> fp16_datas(kActivationNum);
+  std::vector<std::unique_ptr<lite::Tensor>> tensors;
+  std::vector<lite::Tensor *> inputs;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    int num = 1;
+    for (auto dim : shapes[i]) {
+      num *= dim;
+    }
+    datas[i].resize(num);
+    FillData(&datas[i], i);
+    if (i < kActivationNum) {
+      // the reference uses the values rounded to float16 as the kernel does.
+      fp16_datas[i].resize(num);
+      for (int j = 0; j < num; ++j) {
+        fp16_datas[i][j] = static_cast<float16_t>(datas[i][j]);
+        datas[i][j] = static_cast<float>(fp16_datas[i][j]);
+      }
+      tensors.emplace_back(
+        std::make_unique<lite::Tensor>(kNumberTypeFloat16, shapes[i], mindspore::NHWC, lite::Category::VAR));
+      tensors.back()->set_data(fp16_datas[i].data());
+    } else {
+      tensors.emplace_back(
+        std::make_unique<lite::Tensor>(kNumberTypeFloat32, shapes[i], mindspore::NHWC, lite::Category::CONST_TENSOR));
+      tensors.back()->set_data(datas[i].data());
+    }
+    inputs.push_back(tensors.back().get());
+  }
+  // the last kv positions of the second batch are padding
+  std::vector<float> mask(kBatch * kKvSeq, 1.0f);
+  for (int j = kKvSeq - 5; j < kKvSeq; ++j) {
+    mask[kKvSeq + j] = 0.0f;
+  }
+  std::vector<float16_t> fp16_mask(mask.begin(), mask.end());
+  lite::Tensor mask_tensor(kNumberTypeFloat16, {kBatch, kKvSeq});
+  mask_tensor.set_data(fp16_mask.data());
+  inputs.push_back(&mask_tensor);
+
+  std::vector<float16_t> output(kBatch * kQSeq * kDModel);
+  lite::Tensor out_tensor(kNumberTypeFloat16, {kBatch, kQSeq, kDModel});
+  out_tensor.set_data(output.data());
+  std::vector<lite::Tensor *> outputs = {&out_tensor};
+
+  auto param = static_cast<AttentionParameter *>(malloc(sizeof(AttentionParameter)));
+  ASSERT_NE(param, nullptr);
+  memset(param, 0, sizeof(AttentionParameter));
+  param->op_parameter_.type_ = schema::PrimitiveType_Attention;
+  param->op_parameter_.thread_num_ = 2;
+  param->head_num_ = kHeadNum;
+  param->head_size_ = kHeadSize;
+  param->scale_ = 1.0f / std::sqrt(static_cast<float>(kHeadSize));
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat16, NHWC, schema::PrimitiveType_Attention};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, ctx->Init());
+  auto kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+  ASSERT_NE(kernel, nullptr);
+  EXPECT_EQ(lite::RET_OK, kernel->Prepare());
+  EXPECT_EQ(lite::RET_OK, kernel->Run());
+
+  auto expect = ReferenceAttention(datas, mask, param->scale_);
+  std::vector<float> actual(output.begin(), output.end());
+  ASSERT_EQ(0, CompareOutputData(actual.data(), expect.data(), actual.size(), 0.01));
+
+  for (auto input : inputs) {
+    input->set_data(nullptr);
+  }
+  out_tensor.set_data(nullptr);
+  delete kernel;
+}
+}  // namespace mindspore
@@ -0,0 +1,255 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32_sparse/matmul_sparse_x86_fp32.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/runtime/tensor_category.h"
+#include "src/runtime/infer_manager.h"
+#include "src/runtime/kernel_registry.h"
+#include "src/runtime/kernel/cpu/fp32/fullconnection_fp32.h"
+
+namespace mindspore {
+class TestMatmulSparseX86Fp32 : public mindspore::CommonTest {
+ public:
+  TestMatmulSparseX86Fp32() {}
+#ifdef ENABLE_AVX
+  void SetUp() override { IntelX86CpuInfoInit(); }
+#endif
+
+  static std::vector<float> RandomData(size_t size, std::mt19937 *gen) {
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = dis(*gen);
+    }
+    return data;
+  }
+
+  // keeps about density of the 16 columns blocks of b, b is [deep, col].
+  static void PruneBlocks(std::vector<float> *b, int deep, int col, float density, std::mt19937 *gen) {
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+    for (int d = 0; d < deep; ++d) {
+      for (int p = 0; p < col; p += SPARSE_COL_TILE) {
+        if (dis(*gen) < density) {
+          continue;
+        }
+        std::fill(b->begin() + d * col + p, b->begin() + d * col + std::min(p + SPARSE_COL_TILE, col), 0.0f);
+      }
+    }
+  }
+
+  // keeps at most 2 values in every 4 deep values of a column, b is [deep, col].
+  static void Prune2x4(std::vector<float> *b, int deep, int col, std::mt19937 *gen) {
+    for (int c = 0; c < col; ++c) {
+      for (int g = 0; g < deep; g += SPARSE_NM_GROUP) {
+        int keep0 = (*gen)() % SPARSE_NM_GROUP;
+        int keep1 = (*gen)() % SPARSE_NM_GROUP;
+        for (int d = g; d < std::min(g + SPARSE_NM_GROUP, deep); ++d) {
+          if (d - g != keep0 && d - g != keep1) {
+            (*b)[d * col + c] = 0.0f;
+          }
+        }
+      }
+    }
+  }
+
+  static std::vector<float> Reference(const std::vector<float> &a, const std::vector<float> &b,
+                                      const std::vector<float> &bias, int row, int deep, int col, ActType act_type) {
+    std::vector<float> c(row * col);
+    for (int r = 0; r < row; ++r) {
+      for (int j = 0; j < col; ++j) {
+        double sum = bias[j];
+        for (int d = 0; d < deep; ++d) {
+          sum += static_cast<double>(a[r * deep + d]) * b[d * col + j];
+        }
+        if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+          sum = std::max(sum, 0.0);
+        }
+        if (act_type == ActType_Relu6) {
+          sum = std::min(sum, 6.0);
+        }
+        c[r * col + j] = static_cast<float>(sum);
+      }
+    }
+    return c;
+  }
+
+  static void CheckKernel(MatmulSparseFunc func, SparseWeightFormat format, int row, int deep, int col,
+                          ActType act_type) {
+    std::mt19937 gen(row * deep + col);
+    auto a = RandomData(row * deep, &gen);
+    auto b = RandomData(deep * col, &gen);
+    auto bias = RandomData(col, &gen);
+    std::vector<uint8_t> packed_b;
+    if (format == SparseWeightFormat_Block) {
+      PruneBlocks(&b, deep, col, 0.3f, &gen);
+      int block_num = BlockSparseBlockNum(b.data(), deep, col, false);
+      packed_b.resize(BlockSparsePackSize(col, block_num));
+      PackBlockSparseB(b.data(), packed_b.data(), deep, col, false);
+    } else {
+      Prune2x4(&b, deep, col, &gen);
+      ASSERT_TRUE(IsSparse2x4(b.data(), deep, col, false));
+      packed_b.resize(Sparse2x4PackSize(deep, col));
+      PackSparse2x4B(b.data(), packed_b.data(), deep, col, false);
+    }
+    std::vector<float> c(row * col);
+    func(a.data(), packed_b.data(), c.data(), bias.data(), act_type, deep, row, col, 0, col, col);
+    auto expect = Reference(a, b, bias, row, deep, col, act_type);
+    ASSERT_EQ(0, CompareOutputData(c.data(), expect.data(), row * col, 0.0001));
+  }
+
+  static void CheckKernelShapes(MatmulSparseFunc func, SparseWeightFormat format) {
+    CheckKernel(func, format, 1, 1, 1, ActType_No);
+    CheckKernel(func, format, 3, 7, 17, ActType_Relu);
+    CheckKernel(func, format, 8, 64, 32, ActType_Relu6);
+    CheckKernel(func, format, 13, 33, 47, ActType_No);
+    CheckKernel(func, format, 37, 129, 70, ActType_Relu);
+  }
+};
+
+TEST_F(TestMatmulSparseX86Fp32, PackBlockSparse) {
+  // 2 panels, the second one is padded to 16 columns
+  const int deep = 3;
+  const int col = 20;
+  std::vector<float> b(deep * col, 0.0f);
+  b[0 * col + 1] = 1.0f;
+  b[2 * col + 15] = 2.0f;
+  b[1 * col + 19] = 3.0f;
+  int block_num = BlockSparseBlockNum(b.data(), deep, col, false);
+  ASSERT_EQ(block_num, 3);
+  std::vector<uint8_t> packed(BlockSparsePackSize(col, block_num));
+  PackBlockSparseB(b.data(), packed.data(), deep, col, false);
+  auto block_offset = reinterpret_cast<const int32_t *>(packed.data());
+  EXPECT_EQ(block_offset[0], 0);
+  EXPECT_EQ(block_offset[1], 2);
+  EXPECT_EQ(block_offset[2], 3);
+  auto block_deep = block_offset + 3;
+  EXPECT_EQ(block_deep[0], 0);
+  EXPECT_EQ(block_deep[1], 2);
+  EXPECT_EQ(block_deep[2], 1);
+  auto value = reinterpret_cast<const float *>(block_deep + block_num);
+  EXPECT_EQ(value[1], 1.0f);
+  EXPECT_EQ(value[SPARSE_COL_TILE + 15], 2.0f);
+  EXPECT_EQ(value[C2NUM * SPARSE_COL_TILE + 3], 3.0f);
+  EXPECT_EQ(value[C2NUM * SPARSE_COL_TILE + 4], 0.0f);
+}
+
+TEST_F(TestMatmulSparseX86Fp32, Is2x4) {
+  std::vector<float> b = {1, 0, 0, 1, 0, 0, 0, 0};  // [4, 2]
+  EXPECT_TRUE(IsSparse2x4(b.data(), C4NUM, C2NUM, false));
+  b[C4NUM] = 1.0f;
+  EXPECT_FALSE(IsSparse2x4(b.data(), C4NUM, C2NUM, false));
+}
+
+TEST_F(TestMatmulSparseX86Fp32, KernelC) {
+  CheckKernelShapes(MatmulBlockSparseFp32, SparseWeightFormat_Block);
+  CheckKernelShapes(MatmulSparse2x4Fp32, SparseWeightFormat_2x4);
+}
+
+#ifdef ENABLE_AVX
+TEST_F(TestMatmulSparseX86Fp32, KernelAvx2) {
+  if (!X86_Avx_Support()) {
+    return;
+  }
+  CheckKernelShapes(MatmulBlockSparseAvx2Fp32, SparseWeightFormat_Block);
+  CheckKernelShapes(MatmulSparse2x4Avx2Fp32, SparseWeightFormat_2x4);
+}
+#endif
+
+#ifdef ENABLE_AVX512
+TEST_F(TestMatmulSparseX86Fp32, KernelAvx512) {
+  if (!X86_Avx512_Support()) {
+    return;
+  }
+  CheckKernelShapes(MatmulBlockSparseAvx512Fp32, SparseWeightFormat_Block);
+  CheckKernelShapes(MatmulSparse2x4Avx512Fp32, SparseWeightFormat_2x4);
+}
+#endif
+
+#ifdef ENABLE_AVX
+TEST_F(TestMatmulSparseX86Fp32, FullConnectionBlockSparseWeight) {
+  const int row = 9;
+  const int deep = 40;
+  const int col = 50;
+  std::mt19937 gen(row + deep + col);
+  auto in = RandomData(row * deep, &gen);
+  auto weight = RandomData(deep * col, &gen);
+  auto bias = RandomData(col, &gen);
+  PruneBlocks(&weight, deep, col, 0.2f, &gen);
+  // full connection weight is [col, deep]
+  std::vector<float> weight_t(col * deep);
+  for (int d = 0; d < deep; ++d) {
+    for (int j = 0; j < col; ++j) {
+      weight_t[j * deep + d] = weight[d * col + j];
+    }
+  }
+  std::vector<lite::Tensor *> inputs;
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, deep}, in));
+  inputs.push_back(
+    CreateTensor<float>(kNumberTypeFloat32, {col, deep}, weight_t, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {col}, bias, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  std::vector<lite::Tensor *> outputs;
+  outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, col}, {}));
+
+  auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  ASSERT_NE(param, nullptr);
+  memset(param, 0, sizeof(MatMulParameter));
+  param->b_transpose_ = true;
+  param->has_bias_ = true;
+  param->act_type_ = ActType_Relu;
+  param->op_parameter_.type_ = schema::PrimitiveType_FullConnection;
+  KernelInferShape(inputs, outputs, reinterpret_cast<OpParameter *>(param));
+  ASSERT_EQ(kernel::MatmulSparseX86CPUKernel::SelectSparseFormat(inputs, param), SparseWeightFormat_Block);
+
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(ctx->Init(), RET_OK);
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_FullConnection};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  auto *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(kernel->Prepare(), RET_OK);
+  ASSERT_EQ(kernel->Run(), RET_OK);
+
+  auto expect = Reference(in, weight, bias, row, deep, col, ActType_Relu);
+  ASSERT_EQ(0, CompareOutputData(static_cast<float *>(outputs[0]->data()), expect.data(), row * col, 0.0001));
+  delete kernel;
+  DestroyTensors(inputs);
+  DestroyTensors(outputs);
+}
+
+TEST_F(TestMatmulSparseX86Fp32, DenseWeightFallback) {
+  const int deep = 32;
+  const int col = 32;
+  std::mt19937 gen(deep + col);
+  auto weight = RandomData(deep * col, &gen);
+  std::vector<lite::Tensor *> inputs;
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {1, deep}, {}));
+  inputs.push_back(
+    CreateTensor<float>(kNumberTypeFloat32, {deep, col}, weight, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  MatMulParameter param{};
+  EXPECT_EQ(kernel::MatmulSparseX86CPUKernel::SelectSparseFormat(inputs, &param), SparseWeightFormat_None);
+  DestroyTensors(inputs);
+}
+#endif
+}  // namespace mindspore
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32/matmul_bf16_fp32.h"
+#include "nnacl/nnacl_common.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/runtime/tensor_category.h"
+#include "src/runtime/infer_manager.h"
+#include "src/runtime/kernel_registry.h"
+
+namespace mindspore {
+class TestMatmulBf16Fp32 : public mindspore::CommonTest {
+ public:
+  TestMatmulBf16Fp32() {}
+#ifdef ENABLE_AVX
+  void SetUp() override { IntelX86CpuInfoInit(); }
+#endif
+
+  static std::vector<float> RandomData(size_t size, std::mt19937 *gen) {
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = dis(*gen);
+    }
+    return data;
+  }
+
+  static float RoundToBf16(float value) { return BF16ToFloat32(Float32ToBF16(value)); }
+
+  // c = act(a * b + bias), b is [col, deep] when b_transpose is set, [deep, col] otherwise.
+  static std::vector<float> Reference(const std::vector<float> &a, const std::vector<float> &b,
+                                      const std::vector<float> &bias, int row, int deep, int col, bool b_transpose,
+                                      bool bf16_a, ActType act_type) {
+    std::vector<float> c(row * col);
+    for (int r = 0; r < row; ++r) {
+      for (int j = 0; j < col; ++j) {
+        double sum = bias.empty() ? 0.0 : bias[j];
+        for (int d = 0; d < deep; ++d) {
+          float a_value = bf16_a ? RoundToBf16(a[r * deep + d]) : a[r * deep + d];
+          float b_value = RoundToBf16(b_transpose ? b[j * deep + d] : b[d * col + j]);
+          sum += static_cast<double>(a_value) * b_value;
+        }
+        if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+          sum = std::max(sum, 0.0);
+        }
+        if (act_type == ActType_Relu6) {
+          sum = std::min(sum, 6.0);
+        }
+        c[r * col + j] = static_cast<float>(sum);
+      }
+    }
+    return c;
+  }
+
+  static void CheckKernel(MatmulBf16Func func, bool bf16_a, int row, int deep, int col, bool b_transpose,
+                          ActType act_type) {
+    std::mt19937 gen(row * deep + col);
+    auto a = RandomData(row * deep, &gen);
+    auto b = RandomData(deep * col, &gen);
+    auto bias = RandomData(col, &gen);
+    int deep_2 = UP_ROUND(deep, C2NUM);
+    std::vector<uint16_t> packed_b(deep_2 * UP_ROUND(col, C16NUM));
+    PackMatrixBToCol16PairBf16(b.data(), packed_b.data(), deep, col, false, b_transpose);
+    std::vector<uint16_t> a_buffer(MATMUL_BF16_ROW_TILE * deep_2);
+    std::vector<float> c(row * col);
+    func(a.data(), packed_b.data(), c.data(), bias.data(), act_type, deep, row, col, col, a_buffer.data());
+    auto expect = Reference(a, b, bias, row, deep, col, b_transpose, bf16_a, act_type);
+    ASSERT_EQ(0, CompareOutputData(c.data(), expect.data(), row * col, 0.0001));
+  }
+
+  static void CheckKernelShapes(MatmulBf16Func func, bool bf16_a) {
+    CheckKernel(func, bf16_a, 1, 1, 1, false, ActType_No);
+    CheckKernel(func, bf16_a, 3, 7, 17, true, ActType_Relu);
+    CheckKernel(func, bf16_a, 8, 64, 32, false, ActType_Relu6);
+    CheckKernel(func, bf16_a, 13, 33, 47, true, ActType_No);
+    CheckKernel(func, bf16_a, 37, 129, 70, false, ActType_Relu);
+  }
+};
+
+TEST_F(TestMatmulBf16Fp32, Bf16Conversion) {
+  EXPECT_EQ(Float32ToBF16(1.0f), 0x3f80);
+  EXPECT_EQ(BF16ToFloat32(0xc040), -3.0f);
+  // round to nearest even: 1 + 2^-8 is a tie between 1 and 1 + 2^-7
+  EXPECT_EQ(Float32ToBF16(1.00390625f), 0x3f80);
+  EXPECT_EQ(Float32ToBF16(1.01171875f), 0x3f82);
+  EXPECT_TRUE(std::isnan(BF16ToFloat32(Float32ToBF16(std::nanf("")))));
+  EXPECT_TRUE(std::isinf(BF16ToFloat32(Float32ToBF16(3.4e38f))));
+}
+
+TEST_F(TestMatmulBf16Fp32, KernelC) { CheckKernelShapes(MatmulBf16Fp32, false); }
+
+#ifdef ENABLE_AVX
+TEST_F(TestMatmulBf16Fp32, KernelAvx2) {
+  if (!X86_Avx_Support()) {
+    return;
+  }
+  CheckKernelShapes(MatmulBf16Avx2Fp32, false);
+}
+#endif
+
+#ifdef ENABLE_AVX512
+TEST_F(TestMatmulBf16Fp32, KernelAvx512) {
+  if (!X86_Avx512_Support()) {
+    return;
+  }
+  CheckKernelShapes(MatmulBf16Avx512Fp32, false);
+}
+
+TEST_F(TestMatmulBf16Fp32, KernelAvx512Bf16) {
+  if (!X86_Avx512Bf16_Support()) {
+    return;
+  }
+  CheckKernelShapes(MatmulBf16Avx512Bf16Fp32, true);
+}
+#endif
+
+#ifdef ENABLE_AVX
+TEST_F(TestMatmulBf16Fp32, FullConnectionBf16Weight) {
+  const int row = 5;
+  const int deep = 37;
+  const int col = 35;
+  std::mt19937 gen(row + deep + col);
+  auto in = RandomData(row * deep, &gen);
+  auto weight = RandomData(col * deep, &gen);
+  auto bias = RandomData(col, &gen);
+  std::vector<uint16_t> weight_bf16(weight.size());
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight_bf16[i] = Float32ToBF16(weight[i]);
+  }
+  std::vector<lite::Tensor *> inputs;
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, deep}, in));
+  inputs.push_back(CreateTensor<uint16_t>(kNumberTypeBFloat16, {col, deep}, weight_bf16, mindspore::NHWC,
+                                          lite::Category::CONST_TENSOR));
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {col}, bias, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  std::vector<lite::Tensor *> outputs;
+  outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, col}, {}));
+
+  auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  ASSERT_NE(param, nullptr);
+  memset(param, 0, sizeof(MatMulParameter));
+  param->b_transpose_ = true;
+  param->has_bias_ = true;
+  param->act_type_ = ActType_Relu;
+  param->op_parameter_.type_ = schema::PrimitiveType_FullConnection;
+  KernelInferShape(inputs, outputs, reinterpret_cast<OpParameter *>(param));
+
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(ctx->Init(), RET_OK);
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_FullConnection};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  auto *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(kernel->Prepare(), RET_OK);
+  ASSERT_EQ(kernel->Run(), RET_OK);
+
+  bool bf16_a = false;
+#ifdef ENABLE_AVX512
+  bf16_a = GetMatmulBf16Func() == MatmulBf16Avx512Bf16Fp32;
+#endif
+  auto expect = Reference(in, weight, bias, row, deep, col, true, bf16_a, ActType_Relu);
+  ASSERT_EQ(0, CompareOutputData(static_cast<float *>(outputs[0]->data()), expect.data(), row * col, 0.0001));
+  delete kernel;
+  DestroyTensors(inputs);
+  DestroyTensors(outputs);
+}
+#endif
+}  // namespace mindspore
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32/matmul_epilogue_fp32.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/runtime/tensor_category.h"
+#include "src/runtime/infer_manager.h"
+#include "src/runtime/kernel_registry.h"
+
+namespace mindspore {
+class TestMatmulEpilogueFp32 : public mindspore::CommonTest {
+ public:
+  TestMatmulEpilogueFp32() {}
+#ifdef ENABLE_AVX
+  void SetUp() override { IntelX86CpuInfoInit(); }
+#endif
+
+  static std::vector<float> RandomData(size_t size, float low, float high, std::mt19937 *gen) {
+    std::uniform_real_distribution<float> dis(low, high);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = dis(*gen);
+    }
+    return data;
+  }
+
+  // applies the epilogues to a row x col output in double, in the order the kernel runs them.
+  static void ReferenceEpilogue(std::vector<double> *c, const std::vector<float> &residual,
+                                const std::vector<float> &gamma, const std::vector<float> &beta, int row, int col,
+                                int epilogue, float epsilon) {
+    for (int r = 0; r < row; ++r) {
+      double *dst = c->data() + r * col;
+      for (int j = 0; j < col; ++j) {
+        if (epilogue & MatmulEpilogue_ResidualAdd) {
+          dst[j] += residual[r * col + j];
+        }
+        if (epilogue & MatmulEpilogue_Gelu) {
+          dst[j] = 0.5 * dst[j] * (1.0 + std::erf(dst[j] / std::sqrt(2.0)));
+        }
+      }
+      if (epilogue & MatmulEpilogue_LayerNorm) {
+        double mean = 0.0;
+        double variance = 0.0;
+        for (int j = 0; j < col; ++j) {
+          mean += dst[j];
+        }
+        mean /= col;
+        for (int j = 0; j < col; ++j) {
+          variance += (dst[j] - mean) * (dst[j] - mean);
+        }
+        variance /= col;
+        for (int j = 0; j < col; ++j) {
+          dst[j] = (dst[j] - mean) / std::sqrt(variance + epsilon) * gamma[j] + beta[j];
+        }
+      } else if (epilogue & MatmulEpilogue_Softmax) {
+        double max = dst[0];
+        for (int j = 1; j < col; ++j) {
+          max = std::max(max, dst[j]);
+        }
+        double sum = 0.0;
+        for (int j = 0; j < col; ++j) {
+          dst[j] = std::exp(dst[j] - max);
+          sum += dst[j];
+        }
+        for (int j = 0; j < col; ++j) {
+          dst[j] /= sum;
+        }
+      }
+    }
+  }
+
+  // runs the fp32 matmul kernel with the epilogue, a is [row, deep], b is [deep, col].
+  static void CheckMatmulKernel(int row, int deep, int col, int epilogue, int thread_num) {
+    const float epsilon = 1e-5f;
+    std::mt19937 gen(row * deep + col + epilogue);
+    auto a = RandomData(row * deep, -1.0f, 1.0f, &gen);
+    auto b = RandomData(deep * col, -1.0f, 1.0f, &gen);
+    auto bias = RandomData(col, -1.0f, 1.0f, &gen);
+    auto residual = RandomData(row * col, -1.0f, 1.0f, &gen);
+    auto gamma = RandomData(col, 0.5f, 1.5f, &gen);
+    auto beta = RandomData(col, -0.5f, 0.5f, &gen);
+    std::vector<lite::Tensor *> inputs;
+    inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, deep}, a));
+    inputs.push_back(
+      CreateTensor<float>(kNumberTypeFloat32, {deep, col}, b, mindspore::NHWC, lite::Category::CONST_TENSOR));
+    inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {col}, bias, mindspore::NHWC, lite::Category::CONST_TENSOR));
+    if (epilogue & MatmulEpilogue_ResidualAdd) {
+      inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, col}, residual));
+    }
+    if (epilogue & MatmulEpilogue_LayerNorm) {
+      inputs.push_back(
+        CreateTensor<float>(kNumberTypeFloat32, {col}, gamma, mindspore::NHWC, lite::Category::CONST_TENSOR));
+      inputs.push_back(
+        CreateTensor<float>(kNumberTypeFloat32, {col}, beta, mindspore::NHWC, lite::Category::CONST_TENSOR));
+    }
+    std::vector<lite::Tensor *> outputs;
+    outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, col}, {}));
+
+    auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+    ASSERT_NE(param, nullptr);
+    memset(param, 0, sizeof(MatMulParameter));
+    param->epilogue_ = epilogue;
+    param->epilogue_epsilon_ = epsilon;
+    param->op_parameter_.type_ = schema::PrimitiveType_MatMulFusion;
+    ASSERT_EQ(KernelInferShape(inputs, outputs, reinterpret_cast<OpParameter *>(param)), RET_OK);
+    ASSERT_EQ(outputs[0]->shape(), std::vector<int>({row, col}));
+
+    auto ctx = std::make_shared<lite::InnerContext>();
+    ctx->thread_num_ = thread_num;
+    ASSERT_EQ(ctx->Init(), RET_OK);
+    param->op_parameter_.thread_num_ = ctx->thread_num_;
+    kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_MatMulFusion};
+    auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+    ASSERT_NE(creator, nullptr);
+    auto *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+    ASSERT_NE(kernel, nullptr);
+    ASSERT_EQ(kernel->Prepare(), RET_OK);
+    ASSERT_EQ(kernel->Run(), RET_OK);
+
+    std::vector<double> expect(row * col);
+    for (int r = 0; r < row; ++r) {
+      for (int j = 0; j < col; ++j) {
+        double sum = bias[j];
+        for (int d = 0; d < deep; ++d) {
+          sum += static_cast<double>(a[r * deep + d]) * b[d * col + j];
+        }
+        expect[r * col + j] = sum;
+      }
+    }
+    ReferenceEpilogue(&expect, residual, gamma, beta, row, col, epilogue, epsilon);
+    std::vector<float> expect_float(expect.begin(), expect.end());
+    ASSERT_EQ(0, CompareOutputData(static_cast<float *>(outputs[0]->data()), expect_float.data(), row * col, 0.0001));
+    delete kernel;
+    DestroyTensors(inputs);
+    DestroyTensors(outputs);
+  }
+};
+
+TEST_F(TestMatmulEpilogueFp32, ElementwiseBlock) {
+  const int row = 7;
+  const int col = 37;
+  const int stride = 40;
+  std::mt19937 gen(row * col);
+  auto c = RandomData(row * stride, -2.0f, 2.0f, &gen);
+  auto residual = RandomData(row * col, -1.0f, 1.0f, &gen);
+  MatMulParameter param;
+  memset(&param, 0, sizeof(MatMulParameter));
+  param.epilogue_ = MatmulEpilogue_ResidualAdd | MatmulEpilogue_Gelu;
+  std::vector<double> expect(row * col);
+  for (int r = 0; r < row; ++r) {
+    for (int j = 0; j < col; ++j) {
+      expect[r * col + j] = c[r * stride + j];
+    }
+  }
+  ReferenceEpilogue(&expect, residual, {}, {}, row, col, param.epilogue_, 0.0f);
+  // two column slices, like two tasks cutting by the output channel.
+  const int split = 16;
+  ASSERT_EQ(MatmulEpilogueElementwise(c.data(), residual.data(), row, split, stride, col, &param), NNACL_OK);
+  ASSERT_EQ(MatmulEpilogueElementwise(c.data() + split, residual.data() + split, row, col - split, stride, col, &param),
+            NNACL_OK);
+  for (int r = 0; r < row; ++r) {
+    std::vector<float> expect_row(expect.begin() + r * col, expect.begin() + (r + 1) * col);
+    ASSERT_EQ(0, CompareOutputData(c.data() + r * stride, expect_row.data(), col, 0.0001));
+  }
+  ASSERT_EQ(MatmulEpilogueElementwise(c.data(), nullptr, row, col, stride, col, &param), NNACL_NULL_PTR);
+}
+
+TEST_F(TestMatmulEpilogueFp32, RowwiseBlock) {
+  const int row = 5;
+  const int col = 67;
+  std::mt19937 gen(row + col);
+  auto gamma = RandomData(col, 0.5f, 1.5f, &gen);
+  auto beta = RandomData(col, -0.5f, 0.5f, &gen);
+  for (int epilogue : {MatmulEpilogue_LayerNorm, MatmulEpilogue_Softmax}) {
+    auto c = RandomData(row * col, -3.0f, 3.0f, &gen);
+    MatMulParameter param;
+    memset(&param, 0, sizeof(MatMulParameter));
+    param.epilogue_ = epilogue;
+    param.epilogue_epsilon_ = 1e-5f;
+    std::vector<double> expect(c.begin(), c.end());
+    ReferenceEpilogue(&expect, {}, gamma, beta, row, col, epilogue, param.epilogue_epsilon_);
+    ASSERT_EQ(MatmulEpilogueRowwise(c.data(), gamma.data(), beta.data(), row, col, col, &param), NNACL_OK);
+    std::vector<float> expect_float(expect.begin(), expect.end());
+    ASSERT_EQ(0, CompareOutputData(c.data(), expect_float.data(), row * col, 0.0001));
+  }
+}
+
+TEST_F(TestMatmulEpilogueFp32, InputNum) {
+  ASSERT_EQ(MatmulEpilogueInputNum(MatmulEpilogue_None), 0);
+  ASSERT_EQ(MatmulEpilogueInputNum(MatmulEpilogue_ResidualAdd | MatmulEpilogue_Gelu), 1);
+  ASSERT_EQ(MatmulEpilogueInputNum(MatmulEpilogue_ResidualAdd | MatmulEpilogue_LayerNorm), 3);
+  ASSERT_EQ(MatmulEpilogueInputNum(MatmulEpilogue_Softmax), 0);
+}
+
+TEST_F(TestMatmulEpilogueFp32, MatmulKernel) {
+  CheckMatmulKernel(9, 20, 33, MatmulEpilogue_ResidualAdd | MatmulEpilogue_LayerNorm, 1);
+  CheckMatmulKernel(3, 16, 100, MatmulEpilogue_ResidualAdd | MatmulEpilogue_Gelu, 2);
+  CheckMatmulKernel(2, 31, 70, MatmulEpilogue_Softmax, 4);
+  CheckMatmulKernel(40, 24, 24, MatmulEpilogue_Gelu | MatmulEpilogue_LayerNorm, 3);
+}
+}  // namespace mindspore
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32/pack_fp32.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/runtime/tensor_category.h"
+#include "src/runtime/infer_manager.h"
+#include "src/runtime/kernel_registry.h"
+#include "src/runtime/kernel/cpu/fp32/jit_gemm_x86_fp32.h"
+
+#if defined(ENABLE_AVX) && defined(__linux__)
+namespace mindspore {
+using kernel::JitGemmFp32;
+using kernel::JitGemmParam;
+
+class TestMatmulJitFp32 : public mindspore::CommonTest {
+ public:
+  TestMatmulJitFp32() {}
+  void SetUp() override { IntelX86CpuInfoInit(); }
+
+  static std::vector<float> RandomData(size_t size, std::mt19937 *gen) {
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = dis(*gen);
+    }
+    return data;
+  }
+
+  // c = act(a * b + bias), b is [col, deep] when b_transpose is set, [deep, col] otherwise.
+  static std::vector<float> Reference(const std::vector<float> &a, const std::vector<float> &b,
+                                      const std::vector<float> &bias, int row, int deep, int col, bool b_transpose,
+                                      ActType act_type) {
+    std::vector<float> c(row * col);
+    for (int r = 0; r < row; ++r) {
+      for (int j = 0; j < col; ++j) {
+        double sum = bias.empty() ? 0.0 : bias[j];
+        for (int d = 0; d < deep; ++d) {
+          sum += static_cast<double>(a[r * deep + d]) * (b_transpose ? b[j * deep + d] : b[d * col + j]);
+        }
+        if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+          sum = std::max(sum, 0.0);
+        }
+        if (act_type == ActType_Relu6) {
+          sum = std::min(sum, 6.0);
+        }
+        c[r * col + j] = static_cast<float>(sum);
+      }
+    }
+    return c;
+  }
+
+  // conv_layout packs a [col, deep] b like conv1x1 (panels of 16 columns), otherwise a [deep, col] b like the jit
+  // matmul (panels of 64 or 32).
+  static void CheckGemm(int row, int deep, int col, bool conv_layout, bool has_bias, ActType act_type,
+                        const std::vector<int> &col_splits) {
+    std::mt19937 gen(row * deep + col);
+    auto a = RandomData(row * deep, &gen);
+    auto b = RandomData(deep * col, &gen);
+    auto bias = has_bias ? RandomData(col, &gen) : std::vector<float>();
+    JitGemmParam param;
+    param.deep = deep;
+    param.a_stride = deep;
+    param.c_stride = col;
+    param.has_bias = has_bias;
+    param.act_type = act_type;
+    std::vector<float> packed_b;
+    if (conv_layout) {
+      param.b_panel = C16NUM;
+      param.col_align = UP_ROUND(col, C16NUM);
+      packed_b.assign(param.col_align * deep, 0.0f);
+      RowMajor2Col16Major(b.data(), packed_b.data(), col, deep);
+    } else {
+      param.b_panel = JitGemmFp32::SimdLanes() == C16NUM ? C64NUM : C32NUM;
+      param.col_align = UP_ROUND(col, JitGemmFp32::SimdLanes());
+      packed_b.assign(param.col_align * deep, 0.0f);
+      if (param.b_panel == C64NUM) {
+        RowMajor2Row64Major(b.data(), packed_b.data(), deep, col);
+      } else {
+        RowMajor2Row32Major(b.data(), packed_b.data(), deep, col);
+      }
+    }
+    std::vector<float> padded_bias(param.col_align, 0.0f);
+    std::copy(bias.begin(), bias.end(), padded_bias.begin());
+
+    JitGemmFp32 gemm;
+    ASSERT_EQ(gemm.Init(param, {row}, col_splits, col), RET_OK);
+    std::vector<float> c(row * col);
+    for (size_t i = 0; i < col_splits.size(); ++i) {
+      int end_col = i + 1 < col_splits.size() ? col_splits[i + 1] : col;
+      ASSERT_EQ(gemm.Run(a.data(), packed_b.data(), c.data(), padded_bias.data(), row, col_splits[i], end_col), RET_OK);
+    }
+    auto expect = Reference(a, b, bias, row, deep, col, conv_layout, act_type);
+    ASSERT_EQ(0, CompareOutputData(c.data(), expect.data(), row * col, 0.0001));
+  }
+};
+
+TEST_F(TestMatmulJitFp32, MatmulLayout) {
+  if (!JitGemmFp32::IsSupported()) {
+    return;
+  }
+  CheckGemm(1, 1, 1, false, false, ActType_No, {0});
+  CheckGemm(7, 37, 50, false, true, ActType_Relu, {0});
+  CheckGemm(13, 64, 70, false, true, ActType_Relu6, {0, 64});
+  CheckGemm(25, 3, 130, false, false, ActType_No, {0, 64, 128});
+  CheckGemm(49, 129, 200, false, true, ActType_Relu, {0, 128});
+}
+
+TEST_F(TestMatmulJitFp32, Conv1x1Layout) {
+  if (!JitGemmFp32::IsSupported()) {
+    return;
+  }
+  CheckGemm(1, 5, 3, true, true, ActType_No, {0});
+  CheckGemm(17, 24, 40, true, true, ActType_Relu6, {0, 16, 32});
+  CheckGemm(196, 64, 24, true, false, ActType_Relu, {0});
+  CheckGemm(30, 33, 100, true, true, ActType_No, {0, 48});
+}
+
+TEST_F(TestMatmulJitFp32, FullConnection) {
+  if (!JitGemmFp32::IsSupported()) {
+    return;
+  }
+  const int row = 9;
+  const int deep = 45;
+  const int col = 77;
+  std::mt19937 gen(row + deep + col);
+  auto in = RandomData(row * deep, &gen);
+  auto weight = RandomData(col * deep, &gen);
+  auto bias = RandomData(col, &gen);
+  std::vector<lite::Tensor *> inputs;
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, deep}, in));
+  inputs.push_back(
+    CreateTensor<float>(kNumberTypeFloat32, {col, deep}, weight, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {col}, bias, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  std::vector<lite::Tensor *> outputs;
+  outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {row, col}, {}));
+
+  auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  ASSERT_NE(param, nullptr);
+  memset(param, 0, sizeof(MatMulParameter));
+  param->b_transpose_ = true;
+  param->has_bias_ = true;
+  param->act_type_ = ActType_Relu6;
+  param->op_parameter_.type_ = schema::PrimitiveType_FullConnection;
+  KernelInferShape(inputs, outputs, reinterpret_cast<OpParameter *>(param));
+
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(ctx->Init(), RET_OK);
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_FullConnection};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  auto *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(kernel->Prepare(), RET_OK);
+  ASSERT_EQ(kernel->Run(), RET_OK);
+
+  auto expect = Reference(in, weight, bias, row, deep, col, true, ActType_Relu6);
+  ASSERT_EQ(0, CompareOutputData(static_cast<float *>(outputs[0]->data()), expect.data(), row * col, 0.0001));
+  delete kernel;
+  DestroyTensors(inputs);
+  DestroyTensors(outputs);
+}
+}  // namespace mindspore
+#endif
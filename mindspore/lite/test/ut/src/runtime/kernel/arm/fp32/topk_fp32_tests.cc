@@ -14,8 +14,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
 #include "common/common_test.h"
 #include "nnacl/fp32/topk_fp32.h"
 #include "mindspore/lite/src/runtime/kernel_registry.h"
@@ -68,4 +72,41 @@ TEST_F(TestTopKFp32, TopK) {
   out_tensor1.set_data(nullptr);
   delete kernel;
 }
+
+// small k goes through the heap selection, compared with a stable sort of every slice.
+TEST_F(TestTopKFp32, TopKPartialSelect) {
+  const int outer = 3;
+  const int dim = 200;
+  const int inner = 2;
+  std::mt19937 gen(dim);
+  std::vector<float> input(outer * dim * inner);
+  for (auto &value : input) {
+    value = static_cast<float>(gen() % 50);
+  }
+  std::vector<TopkNode> node_list(dim);
+  for (int k : {1, 7, 100, 150}) {
+    for (bool sorted : {true, false}) {
+      TopkParameter parameter = {{}, k, 1, sorted, dim, outer, inner, node_list.data()};
+      std::vector<float> output(outer * k * inner);
+      std::vector<int32_t> index(outer * k * inner);
+      Topk(input.data(), output.data(), index.data(), &parameter);
+      for (int i = 0; i < outer; ++i) {
+        for (int j = 0; j < inner; ++j) {
+          std::vector<int32_t> expect(dim);
+          std::iota(expect.begin(), expect.end(), 0);
+          auto value = [&](int m) { return input[(i * dim + m) * inner + j]; };
+          std::stable_sort(expect.begin(), expect.end(), [&](int a, int b) { return value(a) > value(b); });
+          if (!sorted) {
+            std::sort(expect.begin(), expect.begin() + k);
+          }
+          for (int m = 0; m < k; ++m) {
+            int offset = (i * k + m) * inner + j;
+            ASSERT_EQ(index[offset], expect[m]);
+            ASSERT_EQ(output[offset], value(expect[m]));
+          }
+        }
+      }
+    }
+  }
+}
 }  // namespace mindspore
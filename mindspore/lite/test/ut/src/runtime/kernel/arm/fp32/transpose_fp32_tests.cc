@@ -16,9 +16,12 @@
 
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "src/common/log_adapter.h"
 #include "common/common_test.h"
 #include "nnacl/fp32/transpose_fp32.h"
+#include "nnacl/base/tiled_transpose_base.h"
 #include "nnacl/transpose.h"
 #include "mindspore/lite/src/runtime/kernel_registry.h"
 #include "mindspore/lite/src/runtime/kernel_exec.h"
@@ -28,8 +31,62 @@ namespace mindspore {
 class TestTransposeFp32 : public mindspore::CommonTest {
  public:
   TestTransposeFp32() {}
+
+  // runs the tiled engine split in task_num unit ranges and compares it with an element by element transpose.
+  template <typename T>
+  static void CheckTiledTranspose(const std::vector<int> &in_shape, const std::vector<int> &perm, int task_num) {
+    int num_axes = static_cast<int>(in_shape.size());
+    std::vector<int> in_strides(num_axes, 1);
+    for (int i = num_axes - 2; i >= 0; --i) {
+      in_strides[i] = in_strides[i + 1] * in_shape[i + 1];
+    }
+    int data_num = in_strides[0] * in_shape[0];
+    std::vector<T> input(data_num);
+    for (int i = 0; i < data_num; ++i) {
+      input[i] = static_cast<T>(i % 251);
+    }
+    std::vector<T> expect(data_num);
+    for (int i = 0; i < data_num; ++i) {
+      int index = i;
+      int offset = 0;
+      for (int j = num_axes - 1; j >= 0; --j) {
+        offset += index % in_shape[perm[j]] * in_strides[perm[j]];
+        index /= in_shape[perm[j]];
+      }
+      expect[i] = input[offset];
+    }
+    TiledTransposeInfo info;
+    ASSERT_EQ(TiledTransposeInit(&info, in_shape.data(), perm.data(), num_axes, sizeof(T)), NNACL_OK);
+    std::vector<T> output(data_num);
+    int64_t unit_step = UP_DIV(info.unit_num_, task_num);
+    for (int task_id = 0; task_id < task_num; ++task_id) {
+      TiledTranspose(input.data(), output.data(), &info, task_id * unit_step, (task_id + 1) * unit_step);
+    }
+    ASSERT_EQ(output, expect);
+  }
 };
 
+TEST_F(TestTransposeFp32, TiledTranspose) {
+  const std::vector<std::pair<std::vector<int>, std::vector<int>>> cases = {
+    {{37, 53}, {1, 0}},
+    {{64, 64}, {1, 0}},
+    {{2, 1, 3, 4, 5}, {0, 4, 2, 3, 1}},
+    {{3, 4, 5}, {0, 1, 2}},
+    {{3, 4, 5}, {1, 0, 2}},
+    {{7, 9, 11, 13}, {0, 2, 3, 1}},
+    {{7, 9, 11, 13}, {2, 0, 3, 1}},
+    {{5, 70, 1, 33}, {3, 1, 2, 0}},
+    {{2, 3, 2, 3, 2, 3, 2}, {6, 4, 2, 0, 1, 3, 5}}};
+  for (int task_num : {1, 3}) {
+    for (auto &item : cases) {
+      CheckTiledTranspose<float>(item.first, item.second, task_num);
+      CheckTiledTranspose<uint8_t>(item.first, item.second, task_num);
+      CheckTiledTranspose<int16_t>(item.first, item.second, task_num);
+      CheckTiledTranspose<double>(item.first, item.second, task_num);
+    }
+  }
+}
+
 TEST_F(TestTransposeFp32, 10D) {
   lite::Tensor in_tensor(kNumberTypeFloat32, {2, 3, 4, 1, 1, 1, 1, 1, 1, 1});
   float in[24] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24};
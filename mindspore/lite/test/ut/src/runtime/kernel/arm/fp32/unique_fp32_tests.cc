@@ -16,6 +16,8 @@
 
 #include <iostream>
 #include <memory>
+#include <random>
+#include <vector>
 #include "common/common_test.h"
 #include "nnacl/fp32/unique_fp32.h"
 #include "mindspore/lite/src/runtime/kernel_registry.h"
@@ -71,4 +73,33 @@ TEST_F(TestUniqueFp32, Unique) {
   out_tensor1.set_data(nullptr);
   delete kernel;
 }
+
+TEST_F(TestUniqueFp32, UniqueByHash) {
+  const int input_len = 1000;
+  const int table_size = 2048;
+  std::mt19937 gen(input_len);
+  std::vector<float> input(input_len);
+  for (auto &value : input) {
+    value = static_cast<float>(static_cast<int>(gen() % 300) - 150) * 0.5f;
+  }
+  input[1] = -0.0f;
+  input[2] = 0.0f;
+  std::vector<float> expect0(input_len);
+  std::vector<int> expect1(input_len);
+  int expect_len = 0;
+  Unique(input.data(), input_len, expect0.data(), &expect_len, expect1.data());
+
+  std::vector<float> output0(input_len);
+  std::vector<int> output1(input_len);
+  std::vector<int> hash_table(table_size);
+  int output_len = 0;
+  UniqueByHash(input.data(), input_len, output0.data(), &output_len, output1.data(), hash_table.data(), table_size);
+  ASSERT_EQ(output_len, expect_len);
+  for (int i = 0; i < output_len; ++i) {
+    ASSERT_EQ(output0[i], expect0[i]);
+  }
+  for (int i = 0; i < input_len; ++i) {
+    ASSERT_EQ(output1[i], expect1[i]);
+  }
+}
 }  // namespace mindspore
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/base/conv_common_base.h"
+#include "nnacl/base/minimal_filtering_generator.h"
+#include "nnacl/fp32/conv_winograd_fp32.h"
+#include "nnacl/fp32/winograd_utils.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#include "src/runtime/kernel/cpu/fp32/winograd_unit_selector_fp32.h"
+
+namespace mindspore {
+using kernel::WinogradUnitSelector;
+
+class TestWinogradUnitSelectorFp32 : public mindspore::CommonTest {
+ public:
+  TestWinogradUnitSelectorFp32() {}
+#ifdef ENABLE_AVX
+  void SetUp() override { IntelX86CpuInfoInit(); }
+#endif
+
+  // same padding, stride 1, nhwc.
+  static ConvParameter MakeConvParam(int kernel, int in_channel, int out_channel, int height, int width,
+                                     int thread_num) {
+    ConvParameter param;
+    memset(&param, 0, sizeof(ConvParameter));
+    param.kernel_h_ = kernel;
+    param.kernel_w_ = kernel;
+    param.stride_h_ = 1;
+    param.stride_w_ = 1;
+    param.dilation_h_ = 1;
+    param.dilation_w_ = 1;
+    param.pad_u_ = kernel / C2NUM;
+    param.pad_d_ = kernel / C2NUM;
+    param.pad_l_ = kernel / C2NUM;
+    param.pad_r_ = kernel / C2NUM;
+    param.input_batch_ = 1;
+    param.output_batch_ = 1;
+    param.input_h_ = height;
+    param.input_w_ = width;
+    param.output_h_ = height;
+    param.output_w_ = width;
+    param.input_channel_ = in_channel;
+    param.output_channel_ = out_channel;
+    param.thread_num_ = thread_num;
+    param.op_parameter_.thread_num_ = thread_num;
+    param.act_type_ = ActType_No;
+    param.out_format_ = Format_NHWC;
+    return param;
+  }
+
+  // runs ConvWinogardFp32 with the given output unit and compares it with a direct convolution.
+  static void CheckWinogradUnit(int kernel, int output_unit) {
+    const int in_channel = 13;
+    const int out_channel = 21;
+    const int height = 17;
+    const int width = 19;
+    const int oc_block = C16NUM;
+    ConvParameter param = MakeConvParam(kernel, in_channel, out_channel, height, width, 1);
+    int input_unit = output_unit + kernel - 1;
+    param.input_unit_ = input_unit;
+    param.output_unit_ = output_unit;
+
+    std::mt19937 gen(kernel * output_unit);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    std::vector<float> input(height * width * in_channel);
+    std::vector<float> weight(out_channel * kernel * kernel * in_channel);
+    std::vector<float> bias(UP_ROUND(out_channel, oc_block), 0.0f);
+    for (auto &value : input) {
+      value = dis(gen);
+    }
+    for (auto &value : weight) {
+      value = dis(gen);
+    }
+    for (int i = 0; i < out_channel; ++i) {
+      bias[i] = dis(gen);
+    }
+
+    float matrix_a[64];
+    float matrix_at[64];
+    float matrix_b[64];
+    float matrix_bt[64];
+    float matrix_g[64];
+    float matrix_gt[64];
+    float coef = input_unit == C8NUM ? 0.5f : 1.0f;
+    ASSERT_EQ(CookToomFilter(matrix_a, matrix_at, matrix_b, matrix_bt, matrix_g, matrix_gt, coef, output_unit, kernel),
+              NNACL_OK);
+#ifdef ENABLE_AVX
+    const int weight_oc_block = C16NUM;
+#else
+    const int weight_oc_block = C8NUM;
+#endif
+    int unit_square = input_unit * input_unit;
+    std::vector<float> trans_weight(unit_square * in_channel * UP_ROUND(out_channel, weight_oc_block));
+    ASSERT_EQ(WinogradWeightTransform(weight.data(), trans_weight.data(), matrix_g, matrix_gt, weight_oc_block,
+                                      input_unit, kernel, in_channel, out_channel, true),
+              NNACL_OK);
+
+    TransFuncList trans_func = {GetInputTransFunc(input_unit), nullptr, nullptr,
+                                GetOutputTransFunc(input_unit, output_unit, ActType_No)};
+    ASSERT_NE(trans_func.in_func_, nullptr);
+    ASSERT_NE(trans_func.out_func_, nullptr);
+    std::vector<float> trans_input(C12NUM * unit_square * in_channel);
+    std::vector<float> gemm_out(C12NUM * unit_square * UP_ROUND(out_channel, C8NUM));
+    std::vector<float> tmp_data(C8NUM * unit_square);
+    std::vector<float> col_buffer(C12NUM * in_channel);
+    std::vector<float> opt_input_trans(C12NUM * unit_square * UP_ROUND(in_channel, C8NUM));
+    TmpBufferAddress buffer_list[C5NUM] = {trans_input.data(), gemm_out.data(), tmp_data.data(), col_buffer.data(),
+                                           opt_input_trans.data()};
+    std::vector<float> output(height * width * out_channel);
+    ConvWinogardFp32(input.data(), trans_weight.data(), bias.data(), output.data(), buffer_list, 0, &param,
+                     trans_func);
+
+    std::vector<float> expect(height * width * out_channel);
+    for (int h = 0; h < height; ++h) {
+      for (int w = 0; w < width; ++w) {
+        for (int oc = 0; oc < out_channel; ++oc) {
+          double sum = bias[oc];
+          for (int kh = 0; kh < kernel; ++kh) {
+            for (int kw = 0; kw < kernel; ++kw) {
+              int ih = h + kh - param.pad_u_;
+              int iw = w + kw - param.pad_l_;
+              if (ih < 0 || ih >= height || iw < 0 || iw >= width) {
+                continue;
+              }
+              for (int ic = 0; ic < in_channel; ++ic) {
+                sum += static_cast<double>(input[(ih * width + iw) * in_channel + ic]) *
+                       weight[((oc * kernel + kh) * kernel + kw) * in_channel + ic];
+              }
+            }
+          }
+          expect[(h * width + w) * out_channel + oc] = static_cast<float>(sum);
+        }
+      }
+    }
+    ASSERT_EQ(0, CompareOutputData(output.data(), expect.data(), height * width * out_channel, 0.001));
+  }
+};
+
+TEST_F(TestWinogradUnitSelectorFp32, LargeTileTransforms) {
+  CheckWinogradUnit(3, 6);
+  CheckWinogradUnit(3, 4);
+  CheckWinogradUnit(5, 4);
+  CheckWinogradUnit(5, 2);
+}
+
+TEST_F(TestWinogradUnitSelectorFp32, CandidateUnits) {
+  int units[C8NUM];
+  auto param = MakeConvParam(3, 32, 32, 56, 56, 1);
+  ASSERT_EQ(GetWinogradOutputUnits(&param, units, C8NUM), 3);
+  ASSERT_EQ(units[0], 2);
+  ASSERT_EQ(units[1], 4);
+  ASSERT_EQ(units[2], 6);
+  param = MakeConvParam(5, 32, 32, 56, 56, 1);
+  ASSERT_EQ(GetWinogradOutputUnits(&param, units, C8NUM), 2);
+  ASSERT_EQ(units[0], 2);
+  ASSERT_EQ(units[1], 4);
+  param = MakeConvParam(3, 32, 32, 3, 3, 1);
+  ASSERT_EQ(GetWinogradOutputUnits(&param, units, C8NUM), 1);
+  ASSERT_EQ(units[0], 2);
+}
+
+TEST_F(TestWinogradUnitSelectorFp32, SelectIsCached) {
+  auto param = MakeConvParam(3, 32, 32, 28, 28, 2);
+  int units[C8NUM];
+  int unit_num = GetWinogradOutputUnits(&param, units, C8NUM);
+  int output_unit = WinogradUnitSelector::GetInstance()->Select(&param);
+  bool valid = output_unit == 1;
+  for (int i = 0; i < unit_num; ++i) {
+    valid = valid || output_unit == units[i];
+  }
+  ASSERT_EQ(valid, true);
+  ASSERT_EQ(WinogradUnitSelector::GetInstance()->Select(&param), output_unit);
+}
+}  // namespace mindspore
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/fp32_grad/layernorm_grad.h"
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+
+namespace mindspore {
+class TestLayerNormGradFp32 : public mindspore::CommonTest {
+ public:
+  TestLayerNormGradFp32() {}
+#ifdef ENABLE_AVX
+  void SetUp() override { IntelX86CpuInfoInit(); }
+#endif
+
+  static std::vector<float> RandomData(size_t size, float low, float high, std::mt19937 *gen) {
+    std::uniform_real_distribution<float> dis(low, high);
+    std::vector<float> data(size);
+    for (auto &value : data) {
+      value = dis(*gen);
+    }
+    return data;
+  }
+
+  // the layer norm backward formula evaluated in double, gamma index is the flat index modulo param_num.
+  static void CheckLayerNormGrad(int block_num, int block_size, int param_num) {
+    const double eps = 1e-12;
+    int total = block_num * block_size;
+    int param_size = total / param_num;
+    std::mt19937 gen(total + param_num);
+    auto x = RandomData(total, -1.0f, 1.0f, &gen);
+    auto dy = RandomData(total, -1.0f, 1.0f, &gen);
+    auto var = RandomData(block_num, 0.1f, 1.0f, &gen);
+    auto mean = RandomData(block_num, -0.5f, 0.5f, &gen);
+    auto gamma = RandomData(param_num, 0.5f, 1.5f, &gen);
+    std::vector<float> dx(total);
+    std::vector<float> dg(param_num);
+    std::vector<float> db(param_num);
+    ASSERT_EQ(LayerNormGrad(x.data(), dy.data(), var.data(), mean.data(), gamma.data(), param_num, param_size,
+                            block_num, block_size, dx.data(), dg.data(), db.data()),
+              NNACL_OK);
+
+    std::vector<float> expect_dx(total);
+    std::vector<float> expect_dg(param_num, 0.0f);
+    std::vector<float> expect_db(param_num, 0.0f);
+    std::vector<double> dg_sum(param_num, 0.0);
+    std::vector<double> db_sum(param_num, 0.0);
+    for (int i = 0; i < block_num; ++i) {
+      double rstd = 1.0 / std::sqrt(var[i] + eps);
+      double sum_dyg_dxm = 0.0;
+      double sum_dyg = 0.0;
+      double sum_dxm = 0.0;
+      for (int j = 0; j < block_size; ++j) {
+        int index = i * block_size + j;
+        double dxm = x[index] - mean[i];
+        double dyg = static_cast<double>(dy[index]) * gamma[index % param_num];
+        sum_dyg_dxm += dyg * dxm;
+        sum_dyg += dyg;
+        sum_dxm += dxm;
+        dg_sum[index % param_num] += dy[index] * dxm * rstd;
+        db_sum[index % param_num] += dy[index];
+      }
+      for (int j = 0; j < block_size; ++j) {
+        int index = i * block_size + j;
+        double dxm = x[index] - mean[i];
+        double dyg = static_cast<double>(dy[index]) * gamma[index % param_num];
+        double sum1 = -0.5 * rstd * rstd * rstd * sum_dyg_dxm;
+        double dx3 = (-rstd * sum_dyg + sum1 * -2.0 * sum_dxm / block_size) / block_size;
+        expect_dx[index] = static_cast<float>(dyg * rstd + sum1 * 2.0 / block_size * dxm + dx3);
+      }
+    }
+    for (int i = 0; i < param_num; ++i) {
+      expect_dg[i] = static_cast<float>(dg_sum[i]);
+      expect_db[i] = static_cast<float>(db_sum[i]);
+    }
+    ASSERT_EQ(0, CompareOutputData(dx.data(), expect_dx.data(), total, 0.001));
+    ASSERT_EQ(0, CompareOutputData(dg.data(), expect_dg.data(), param_num, 0.001));
+    ASSERT_EQ(0, CompareOutputData(db.data(), expect_db.data(), param_num, 0.001));
+  }
+};
+
+TEST_F(TestLayerNormGradFp32, ParamsPerBlock) {
+  CheckLayerNormGrad(3, 64, 64);
+  CheckLayerNormGrad(4, 37, 37);
+  CheckLayerNormGrad(5, 100, 10);
+  CheckLayerNormGrad(2, 128, 32);
+}
+
+TEST_F(TestLayerNormGradFp32, ParamsAcrossBlocks) {
+  CheckLayerNormGrad(4, 6, 8);
+  CheckLayerNormGrad(2, 8, 16);
+}
+}  // namespace mindspore
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/lite_kernel.h"
+#include "src/runtime/parallel_executor.h"
+
+namespace mindspore {
+namespace {
+constexpr int kElementNum = 16;
+
+// adds a constant to the sum of its inputs, and records the order in which the kernels finish.
+class AddConstKernel : public kernel::LiteKernel {
+ public:
+  AddConstKernel(OpParameter *parameter, const std::vector<lite::Tensor *> &inputs,
+                 const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx, float value,
+                 std::atomic_int *finish_counter)
+      : LiteKernel(parameter, inputs, outputs, ctx), value_(value), finish_counter_(finish_counter) {}
+  ~AddConstKernel() override = default;
+
+  int ReSize() override { return lite::RET_OK; }
+  int Run() override {
+    auto output = static_cast<float *>(out_tensors().front()->data());
+    if (output == nullptr || fail_) {
+      return lite::RET_ERROR;
+    }
+    for (int i = 0; i < kElementNum; ++i) {
+      output[i] = value_;
+      for (auto *input : in_tensors()) {
+        // an input released by another consumer fails the kernel.
+        if (input->data() == nullptr) {
+          return lite::RET_ERROR;
+        }
+        output[i] += static_cast<float *>(input->data())[i];
+      }
+    }
+    finish_order_ = finish_counter_->fetch_add(1);
+    return lite::RET_OK;
+  }
+
+  void set_fail(bool fail) { fail_ = fail; }
+  int finish_order() const { return finish_order_; }
+
+ private:
+  float value_ = 0;
+  std::atomic_int *finish_counter_ = nullptr;
+  bool fail_ = false;
+  int finish_order_ = -1;
+};
+
+// in -> branch0 -> mid0 -> join
+//    -> branch1 -> mid1 ----^
+class ParallelExecutorTest : public mindspore::CommonTest {
+ public:
+  ParallelExecutorTest() = default;
+
+  void SetUp() override {
+    ctx_.thread_num_ = kThreadNum;
+    ASSERT_EQ(ctx_.Init(), lite::RET_OK);
+    for (auto &tensor : tensors_) {
+      tensor = std::make_unique<lite::Tensor>(kNumberTypeFloat32, std::vector<int>{kElementNum}, mindspore::NHWC,
+                                              lite::Category::VAR);
+    }
+    auto in = tensors_[kIn].get();
+    auto mid0 = tensors_[kMid0].get();
+    auto mid1 = tensors_[kMid1].get();
+    auto out = tensors_[kOut].get();
+    mid0->set_init_ref_count(1);
+    mid1->set_init_ref_count(1);
+    out->set_init_ref_count(1);
+    branch0_ = CreateKernel({in}, {mid0}, 1.0f);
+    branch1_ = CreateKernel({in}, {mid1}, 2.0f);
+    join_ = CreateKernel({mid0, mid1}, {out}, 0.0f);
+    branch0_->set_out_kernels({join_.get()});
+    branch1_->set_out_kernels({join_.get()});
+    join_->set_in_kernels({branch0_.get(), branch1_.get()});
+    kernels_ = {branch0_.get(), branch1_.get(), join_.get()};
+  }
+
+  // the subgraph input is produced upstream, which sets its ref count to the number of consumers.
+  void FeedInput() {
+    auto in = tensors_[kIn].get();
+    ASSERT_EQ(in->MallocData(), lite::RET_OK);
+    for (int i = 0; i < kElementNum; ++i) {
+      static_cast<float *>(in->data())[i] = static_cast<float>(i);
+    }
+    in->set_ref_count(kBranchNum);
+    finish_counter_ = 0;
+  }
+
+  AddConstKernel *Kernel(kernel::KernelExec *kernel_exec) {
+    return static_cast<AddConstKernel *>(kernel_exec->kernel());
+  }
+
+ protected:
+  enum TensorIndex { kIn = 0, kMid0, kMid1, kOut, kTensorNum };
+  static constexpr int kThreadNum = 2;
+  static constexpr int kBranchNum = 2;
+
+  std::unique_ptr<kernel::KernelExec> CreateKernel(const std::vector<lite::Tensor *> &inputs,
+                                                   const std::vector<lite::Tensor *> &outputs, float value) {
+    auto parameter = static_cast<OpParameter *>(malloc(sizeof(OpParameter)));
+    EXPECT_NE(parameter, nullptr);
+    (void)memset(parameter, 0, sizeof(OpParameter));
+    parameter->type_ = schema::PrimitiveType_AddFusion;
+    auto kernel = std::make_shared<AddConstKernel>(parameter, inputs, outputs, &ctx_, value, &finish_counter_);
+    return std::make_unique<kernel::KernelExec>(kernel);
+  }
+
+  lite::InnerContext ctx_;
+  std::unique_ptr<lite::Tensor> tensors_[kTensorNum];
+  std::unique_ptr<kernel::KernelExec> branch0_;
+  std::unique_ptr<kernel::KernelExec> branch1_;
+  std::unique_ptr<kernel::KernelExec> join_;
+  std::vector<kernel::KernelExec *> kernels_;
+  std::atomic_int finish_counter_ = {0};
+};
+
+TEST_F(ParallelExecutorTest, RunIndependentBranches) {
+  lite::ParallelExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {tensors_[kIn].get()}, {tensors_[kOut].get()}, &ctx_), lite::RET_OK);
+  ASSERT_EQ(executor.inter_op_parallel_num(), kThreadNum);
+
+  for (int run = 0; run < 3; ++run) {
+    FeedInput();
+    ASSERT_EQ(executor.Run({tensors_[kIn].get()}, {tensors_[kOut].get()}, kernels_), lite::RET_OK);
+    // the join kernel runs after both branches.
+    ASSERT_EQ(Kernel(join_.get())->finish_order(), kBranchNum);
+    auto out = static_cast<float *>(tensors_[kOut]->data());
+    ASSERT_NE(out, nullptr);
+    for (int i = 0; i < kElementNum; ++i) {
+      ASSERT_EQ(out[i], 2.0f * i + 3.0f);
+    }
+    // the subgraph input is released once, after the last consumer.
+    ASSERT_EQ(tensors_[kIn]->ref_count(), 0);
+    ASSERT_EQ(tensors_[kIn]->data(), nullptr);
+    tensors_[kOut]->FreeData();
+  }
+}
+
+TEST_F(ParallelExecutorTest, FailedKernel) {
+  lite::ParallelExecutor executor;
+  ASSERT_EQ(executor.Prepare(kernels_, {tensors_[kIn].get()}, {tensors_[kOut].get()}, &ctx_), lite::RET_OK);
+  FeedInput();
+  Kernel(branch1_.get())->set_fail(true);
+  ASSERT_NE(executor.Run({tensors_[kIn].get()}, {tensors_[kOut].get()}, kernels_), lite::RET_OK);
+  // the successor of the failed kernel never runs.
+  ASSERT_EQ(Kernel(join_.get())->finish_order(), -1);
+
+  // the executor can run again after the failure.
+  Kernel(branch1_.get())->set_fail(false);
+  FeedInput();
+  ASSERT_EQ(executor.Run({tensors_[kIn].get()}, {tensors_[kOut].get()}, kernels_), lite::RET_OK);
+  ASSERT_EQ(Kernel(join_.get())->finish_order(), kBranchNum);
+}
+}  // namespace
+}  // namespace mindspore
@@ -17,8 +17,14 @@
 #include "src/runtime/kernel_exec.h"
 #include "src/runtime/kernel_registry.h"
 #include "src/runtime/runtime_pass.h"
+#include "src/runtime/kernel_exec_util.h"
+#include "src/runtime/pass/layout_assignment.h"
+#include "src/common/version_manager.h"
+#include "nnacl/arithmetic.h"
 #include "nnacl/conv_parameter.h"
+#include "nnacl/format_transpose_parameter.h"
 #include "nnacl/instance_norm_parameter.h"
+#include "nnacl/softmax_parameter.h"
 #include "nnacl/fp32/activation_fp32.h"
 #include "nnacl/transpose.h"
 
@@ -289,4 +295,182 @@ TEST_F(RuntimePass, ConvNormC4Pass1) {
     kernel = nullptr;
   }
 }
+
+namespace {
+const std::vector<int> kLayoutNHWCShape = {1, 4, 4, 8};
+const std::vector<int> kLayoutNCHWShape = {1, 8, 4, 4};
+
+lite::Tensor *NewLayoutTensor(std::vector<lite::Tensor *> *tensors, Format format) {
+  auto tensor = new lite::Tensor(kNumberTypeFloat32, format == NHWC ? kLayoutNHWCShape : kLayoutNCHWShape, format);
+  tensors->push_back(tensor);
+  return tensor;
+}
+
+template <typename T>
+kernel::KernelExec *NewLayoutKernel(const std::vector<lite::Tensor *> &in, const std::vector<lite::Tensor *> &out,
+                                    schema::PrimitiveType type, lite::InnerContext *ctx) {
+  auto param = reinterpret_cast<T *>(malloc(sizeof(T)));
+  if (param == nullptr) {
+    return nullptr;
+  }
+  memset(param, 0, sizeof(T));
+  auto op_param = reinterpret_cast<OpParameter *>(param);
+  op_param->type_ = type;
+  kernel::KernelKey desc{kernel::kCPU, kNumberTypeFloat32, NHWC, type};
+  kernel::KernelExec *kernel = nullptr;
+  lite::KernelRegistry::GetInstance()->GetKernelExec(in, out, ctx, nullptr, desc, op_param, &kernel, nullptr);
+  return kernel;
+}
+
+kernel::KernelExec *NewLayoutTranspose(lite::Tensor *in, lite::Tensor *out, FormatC src_format, FormatC dst_format,
+                                       lite::InnerContext *ctx) {
+  kernel::KernelKey desc{kernel::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_FormatTranspose};
+  return lite::pass::CreateFormatTranspose(in, out, lite::pass::TransInfoPair(src_format, dst_format),
+                                           in->tensor_name() + "_transpose", ctx, desc);
+}
+
+void Link(kernel::KernelExec *in_kernel, kernel::KernelExec *out_kernel) {
+  in_kernel->AddOutKernel(out_kernel);
+  out_kernel->AddInKernel(in_kernel);
+}
+
+kernel::SubGraphKernel *NewLayoutSubGraph(const std::vector<kernel::KernelExec *> &kernels,
+                                          const std::vector<lite::Tensor *> &in,
+                                          const std::vector<lite::Tensor *> &out, lite::InnerContext *ctx) {
+  return kernel::KernelExecUtil::CreateSubGraphKernel(kernels, &in, &out, kernel::kCpuFP32SubGraph, *ctx,
+                                                      lite::SCHEMA_CUR);
+}
+
+void FreeLayoutGraph(kernel::SubGraphKernel *subgraph, std::vector<lite::Tensor *> *tensors) {
+  delete subgraph;
+  for (auto tensor : *tensors) {
+    delete tensor;
+  }
+  tensors->clear();
+}
+}  // namespace
+
+/* in -> transpose(NHWC->NCHW) -> activation -> transpose(NCHW->NHWC) -> out
+ * the activation runs in NHWC, the cancelling transposes are removed. */
+TEST_F(RuntimePass, LayoutAssignmentCancelTransposes) {
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ASSERT_EQ(ctx->Init(), lite::RET_OK);
+  std::vector<lite::Tensor *> tensors;
+  auto in = NewLayoutTensor(&tensors, NHWC);
+  auto act_in = NewLayoutTensor(&tensors, NCHW);
+  auto act_out = NewLayoutTensor(&tensors, NCHW);
+  auto out = NewLayoutTensor(&tensors, NHWC);
+  auto trans0 = NewLayoutTranspose(in, act_in, Format_NHWC, Format_NCHW, ctx.get());
+  ASSERT_NE(trans0, nullptr);
+  auto act = NewLayoutKernel<ActivationParameter>({act_in}, {act_out}, schema::PrimitiveType_Activation, ctx.get());
+  ASSERT_NE(act, nullptr);
+  auto trans1 = NewLayoutTranspose(act_out, out, Format_NCHW, Format_NHWC, ctx.get());
+  ASSERT_NE(trans1, nullptr);
+  Link(trans0, act);
+  Link(act, trans1);
+  auto subgraph = NewLayoutSubGraph({trans0, act, trans1}, {in}, {out}, ctx.get());
+  ASSERT_NE(subgraph, nullptr);
+
+  lite::pass::LayoutAssignment pass(NC4HW4);
+  ASSERT_EQ(pass.Run(subgraph, &tensors), lite::RET_OK);
+  ASSERT_EQ(pass.eliminated_transpose_num(), 2);
+  ASSERT_EQ(subgraph->nodes().size(), 1);
+  ASSERT_EQ(subgraph->nodes().front(), act);
+  ASSERT_EQ(act->in_tensors().front(), in);
+  ASSERT_EQ(act->out_tensors().front(), out);
+  ASSERT_TRUE(act->in_kernels().empty());
+  ASSERT_TRUE(act->out_kernels().empty());
+
+  FreeLayoutGraph(subgraph, &tensors);
+}
+
+/* in0 -> transpose(NHWC->NCHW) -> add -> instance_norm -> out
+ * in1 -> transpose(NHWC->NCHW) ---^
+ * the add runs in NHWC, its two input transposes are removed and one is inserted before instance_norm. */
+TEST_F(RuntimePass, LayoutAssignmentInsertTransposes) {
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ASSERT_EQ(ctx->Init(), lite::RET_OK);
+  std::vector<lite::Tensor *> tensors;
+  auto in0 = NewLayoutTensor(&tensors, NHWC);
+  auto in1 = NewLayoutTensor(&tensors, NHWC);
+  auto add_in0 = NewLayoutTensor(&tensors, NCHW);
+  auto add_in1 = NewLayoutTensor(&tensors, NCHW);
+  auto add_out = NewLayoutTensor(&tensors, NCHW);
+  auto norm_param = new lite::Tensor(kNumberTypeFloat32, {8}, NHWC, lite::Category::CONST_TENSOR);
+  tensors.push_back(norm_param);
+  auto out = NewLayoutTensor(&tensors, NCHW);
+  auto trans0 = NewLayoutTranspose(in0, add_in0, Format_NHWC, Format_NCHW, ctx.get());
+  ASSERT_NE(trans0, nullptr);
+  auto trans1 = NewLayoutTranspose(in1, add_in1, Format_NHWC, Format_NCHW, ctx.get());
+  ASSERT_NE(trans1, nullptr);
+  auto add = NewLayoutKernel<ArithmeticParameter>({add_in0, add_in1}, {add_out}, schema::PrimitiveType_AddFusion,
+                                                  ctx.get());
+  ASSERT_NE(add, nullptr);
+  auto norm = NewLayoutKernel<InstanceNormParameter>({add_out, norm_param}, {out}, schema::PrimitiveType_InstanceNorm,
+                                                     ctx.get());
+  ASSERT_NE(norm, nullptr);
+  Link(trans0, add);
+  Link(trans1, add);
+  Link(add, norm);
+  auto subgraph = NewLayoutSubGraph({trans0, trans1, add, norm}, {in0, in1}, {out}, ctx.get());
+  ASSERT_NE(subgraph, nullptr);
+
+  lite::pass::LayoutAssignment pass(NC4HW4);
+  ASSERT_EQ(pass.Run(subgraph, &tensors), lite::RET_OK);
+  ASSERT_EQ(pass.eliminated_transpose_num(), 1);
+  ASSERT_EQ(subgraph->nodes().size(), 3);
+  ASSERT_EQ(add->in_tensors(), std::vector<lite::Tensor *>({in0, in1}));
+  ASSERT_EQ(add_out->format(), NHWC);
+  ASSERT_EQ(add_out->shape(), kLayoutNHWCShape);
+
+  ASSERT_EQ(norm->in_kernels().size(), 1);
+  auto trans = norm->in_kernels().front();
+  ASSERT_EQ(trans->type(), schema::PrimitiveType_FormatTranspose);
+  auto trans_param = reinterpret_cast<FormatTransposeParameter *>(trans->op_parameter());
+  ASSERT_EQ(trans_param->src_format_, Format_NHWC);
+  ASSERT_EQ(trans_param->dst_format_, Format_NCHW);
+  ASSERT_EQ(trans->in_tensors().front(), add_out);
+  ASSERT_EQ(trans->out_tensors().front(), norm->in_tensors().front());
+  ASSERT_EQ(norm->in_tensors().front()->format(), NCHW);
+  ASSERT_EQ(norm->in_tensors().front()->shape(), kLayoutNCHWShape);
+  ASSERT_EQ(add->out_kernels(), std::vector<kernel::KernelExec *>({trans}));
+  /* the kernels are sorted again after the transposes change. */
+  ASSERT_EQ(subgraph->nodes().back(), norm);
+
+  FreeLayoutGraph(subgraph, &tensors);
+}
+
+/* in -> transpose(NHWC->NCHW) -> softmax -> transpose(NCHW->NHWC) -> out
+ * the axis of softmax can't be changed, the subgraph is kept as it is. */
+TEST_F(RuntimePass, LayoutAssignmentUnsupportedKernel) {
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ASSERT_EQ(ctx->Init(), lite::RET_OK);
+  std::vector<lite::Tensor *> tensors;
+  auto in = NewLayoutTensor(&tensors, NHWC);
+  auto softmax_in = NewLayoutTensor(&tensors, NCHW);
+  auto softmax_out = NewLayoutTensor(&tensors, NCHW);
+  auto out = NewLayoutTensor(&tensors, NHWC);
+  auto trans0 = NewLayoutTranspose(in, softmax_in, Format_NHWC, Format_NCHW, ctx.get());
+  ASSERT_NE(trans0, nullptr);
+  auto softmax =
+    NewLayoutKernel<SoftmaxParameter>({softmax_in}, {softmax_out}, schema::PrimitiveType_Softmax, ctx.get());
+  ASSERT_NE(softmax, nullptr);
+  auto trans1 = NewLayoutTranspose(softmax_out, out, Format_NCHW, Format_NHWC, ctx.get());
+  ASSERT_NE(trans1, nullptr);
+  Link(trans0, softmax);
+  Link(softmax, trans1);
+  auto subgraph = NewLayoutSubGraph({trans0, softmax, trans1}, {in}, {out}, ctx.get());
+  ASSERT_NE(subgraph, nullptr);
+
+  lite::pass::LayoutAssignment pass(NC4HW4);
+  ASSERT_EQ(pass.Run(subgraph, &tensors), lite::RET_OK);
+  ASSERT_EQ(pass.eliminated_transpose_num(), 0);
+  ASSERT_EQ(subgraph->nodes(), std::vector<kernel::KernelExec *>({trans0, softmax, trans1}));
+  ASSERT_EQ(softmax->in_tensors().front(), softmax_in);
+  ASSERT_EQ(softmax->out_tensors().front(), softmax_out);
+  ASSERT_EQ(softmax_out->format(), NCHW);
+  ASSERT_EQ(tensors.size(), 4);
+
+  FreeLayoutGraph(subgraph, &tensors);
+}
 }  // namespace mindspore
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/subgraph_memo.h"
+
+namespace mindspore {
+namespace {
+constexpr int kElementNum = 16;
+constexpr size_t kTensorSize = kElementNum * sizeof(float);
+constexpr size_t kEntrySize = 2 * kTensorSize;
+
+void FillTensor(lite::Tensor *tensor, float value) {
+  ASSERT_EQ(tensor->MallocData(), lite::RET_OK);
+  auto data = static_cast<float *>(tensor->data());
+  for (int i = 0; i < kElementNum; ++i) {
+    data[i] = value;
+  }
+}
+
+// run the memoized "subgraph" computing output = input + 1, return whether the memo is hit.
+bool RunWithMemo(lite::SubGraphMemo *memo, const void *owner, lite::Tensor *input, lite::Tensor *output) {
+  bool hit = false;
+  EXPECT_EQ(memo->Lookup(owner, {input}, {output}, &hit), lite::RET_OK);
+  if (!hit) {
+    FillTensor(output, static_cast<float *>(input->data())[0] + 1.0f);
+    EXPECT_EQ(memo->Insert(owner, {output}), lite::RET_OK);
+  }
+  return hit;
+}
+}  // namespace
+class SubGraphMemoTest : public mindspore::CommonTest {
+ public:
+  SubGraphMemoTest() = default;
+};
+
+TEST_F(SubGraphMemoTest, HitAndMiss) {
+  lite::SubGraphMemo memo(kEntrySize);
+  lite::Tensor input(kNumberTypeFloat32, {kElementNum}, mindspore::NHWC, lite::Category::VAR);
+  lite::Tensor output(kNumberTypeFloat32, {kElementNum}, mindspore::NHWC, lite::Category::VAR);
+  int owner = 0;
+
+  FillTensor(&input, 1.0f);
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+  ASSERT_EQ(memo.cached_size(), kEntrySize);
+
+  // outputs are restored from the memo after released.
+  output.FreeData();
+  ASSERT_TRUE(RunWithMemo(&memo, &owner, &input, &output));
+  ASSERT_NE(output.data(), nullptr);
+  ASSERT_EQ(static_cast<float *>(output.data())[kElementNum - 1], 2.0f);
+
+  // another subgraph with the same inputs doesn't share the entry.
+  int other_owner = 0;
+  ASSERT_FALSE(RunWithMemo(&memo, &other_owner, &input, &output));
+
+  // different inputs miss the memo.
+  static_cast<float *>(input.data())[kElementNum - 1] = 3.0f;
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+  ASSERT_EQ(memo.hit_count(), 1);
+  ASSERT_EQ(memo.miss_count(), 3);
+}
+
+TEST_F(SubGraphMemoTest, EvictLeastRecentlyUsed) {
+  // room for two entries only
+  lite::SubGraphMemo memo(2 * kEntrySize);
+  lite::Tensor input(kNumberTypeFloat32, {kElementNum}, mindspore::NHWC, lite::Category::VAR);
+  lite::Tensor output(kNumberTypeFloat32, {kElementNum}, mindspore::NHWC, lite::Category::VAR);
+  int owner = 0;
+
+  FillTensor(&input, 0.0f);
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+  FillTensor(&input, 1.0f);
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+  FillTensor(&input, 0.0f);
+  ASSERT_TRUE(RunWithMemo(&memo, &owner, &input, &output));
+
+  // the entry of input 1 is evicted by the entry of input 2.
+  FillTensor(&input, 2.0f);
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+  ASSERT_EQ(memo.cached_size(), 2 * kEntrySize);
+  FillTensor(&input, 0.0f);
+  ASSERT_TRUE(RunWithMemo(&memo, &owner, &input, &output));
+  FillTensor(&input, 1.0f);
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+}
+
+TEST_F(SubGraphMemoTest, SkipOversizedEntry) {
+  lite::SubGraphMemo memo(kEntrySize - 1);
+  lite::Tensor input(kNumberTypeFloat32, {kElementNum}, mindspore::NHWC, lite::Category::VAR);
+  lite::Tensor output(kNumberTypeFloat32, {kElementNum}, mindspore::NHWC, lite::Category::VAR);
+  int owner = 0;
+
+  FillTensor(&input, 1.0f);
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+  ASSERT_EQ(memo.cached_size(), 0);
+  ASSERT_FALSE(RunWithMemo(&memo, &owner, &input, &output));
+}
+}  // namespace mindspore
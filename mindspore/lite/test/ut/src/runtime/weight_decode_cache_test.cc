@@ -0,0 +1,141 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <cstring>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/weight_decode_cache.h"
+
+namespace mindspore {
+namespace {
+constexpr int kWeightElementNum = 256;
+constexpr size_t kWeightSize = kWeightElementNum * sizeof(float);
+}  // namespace
+class WeightDecodeCacheTest : public mindspore::CommonTest {
+ public:
+  WeightDecodeCacheTest() = default;
+};
+
+lite::WeightDecodeFunc CreateDecodeFunc(float value, std::atomic_int *decode_num) {
+  return [value, decode_num]() -> void * {
+    auto data = static_cast<float *>(malloc(kWeightSize));
+    for (int i = 0; i < kWeightElementNum; ++i) {
+      data[i] = value;
+    }
+    (*decode_num)++;
+    return data;
+  };
+}
+
+TEST_F(WeightDecodeCacheTest, DecodeAndEvict) {
+  std::atomic_int decode_num = {0};
+  lite::Tensor weight0(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor weight1(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor weight2(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  {
+    // room for two weights only
+    lite::WeightDecodeCache cache(2 * kWeightSize);
+    ASSERT_EQ(cache.Register(&weight0, kWeightSize, CreateDecodeFunc(0.0f, &decode_num)), lite::RET_OK);
+    ASSERT_EQ(cache.Register(&weight1, kWeightSize, CreateDecodeFunc(1.0f, &decode_num)), lite::RET_OK);
+    ASSERT_EQ(cache.Register(&weight2, kWeightSize, CreateDecodeFunc(2.0f, &decode_num)), lite::RET_OK);
+    ASSERT_EQ(weight0.data(), nullptr);
+
+    ASSERT_EQ(cache.Acquire({&weight0}), lite::RET_OK);
+    ASSERT_NE(weight0.data(), nullptr);
+    ASSERT_EQ(static_cast<float *>(weight0.data())[kWeightElementNum - 1], 0.0f);
+    cache.Release({&weight0});
+
+    ASSERT_EQ(cache.Acquire({&weight1, &weight2}), lite::RET_OK);
+    ASSERT_EQ(static_cast<float *>(weight1.data())[0], 1.0f);
+    ASSERT_EQ(static_cast<float *>(weight2.data())[0], 2.0f);
+    // the least recently used weight is evicted.
+    ASSERT_EQ(weight0.data(), nullptr);
+    ASSERT_EQ(cache.cached_size(), 2 * kWeightSize);
+    cache.Release({&weight1, &weight2});
+
+    // cached weight is not decoded again
+    ASSERT_EQ(cache.Acquire({&weight2}), lite::RET_OK);
+    cache.Release({&weight2});
+    ASSERT_EQ(cache.decode_count(), 3);
+    ASSERT_EQ(decode_num, 3);
+  }
+  weight0.set_data(nullptr);
+  weight1.set_data(nullptr);
+  weight2.set_data(nullptr);
+}
+
+TEST_F(WeightDecodeCacheTest, PinnedWeightNotEvicted) {
+  std::atomic_int decode_num = {0};
+  lite::Tensor weight0(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor weight1(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  {
+    lite::WeightDecodeCache cache(kWeightSize);
+    ASSERT_EQ(cache.Register(&weight0, kWeightSize, CreateDecodeFunc(0.0f, &decode_num)), lite::RET_OK);
+    ASSERT_EQ(cache.Register(&weight1, kWeightSize, CreateDecodeFunc(1.0f, &decode_num)), lite::RET_OK);
+    ASSERT_EQ(cache.Acquire({&weight0}), lite::RET_OK);
+    ASSERT_EQ(cache.Acquire({&weight1}), lite::RET_OK);
+    // capacity is exceeded while both weights are in use.
+    ASSERT_NE(weight0.data(), nullptr);
+    ASSERT_NE(weight1.data(), nullptr);
+    cache.Release({&weight0, &weight1});
+  }
+  weight0.set_data(nullptr);
+  weight1.set_data(nullptr);
+}
+
+TEST_F(WeightDecodeCacheTest, PrefetchNextWeight) {
+  std::atomic_int decode_num = {0};
+  lite::Tensor weight0(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor weight1(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  {
+    lite::WeightDecodeCache cache(2 * kWeightSize);
+    ASSERT_EQ(cache.Register(&weight0, kWeightSize, CreateDecodeFunc(0.0f, &decode_num)), lite::RET_OK);
+    ASSERT_EQ(cache.Register(&weight1, kWeightSize, CreateDecodeFunc(1.0f, &decode_num)), lite::RET_OK);
+    cache.SetExecutionOrder({{&weight0}, {&weight1}});
+    ASSERT_EQ(cache.Acquire({&weight0}), lite::RET_OK);
+    cache.Release({&weight0});
+    ASSERT_EQ(cache.Acquire({&weight1}), lite::RET_OK);
+    ASSERT_EQ(static_cast<float *>(weight1.data())[0], 1.0f);
+    cache.Release({&weight1});
+    // weight1 is decoded once, either by the prefetch thread or by Acquire.
+    ASSERT_EQ(decode_num, 2);
+  }
+  weight0.set_data(nullptr);
+  weight1.set_data(nullptr);
+}
+
+TEST_F(WeightDecodeCacheTest, DecodeFailed) {
+  std::atomic_int decode_num = {0};
+  lite::Tensor weight0(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor weight1(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor weight2(kNumberTypeFloat32, {kWeightElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  {
+    lite::WeightDecodeCache cache(kWeightSize);
+    ASSERT_EQ(cache.Register(&weight0, kWeightSize, CreateDecodeFunc(0.0f, &decode_num)), lite::RET_OK);
+    ASSERT_EQ(cache.Register(&weight1, kWeightSize, []() -> void * { return nullptr; }), lite::RET_OK);
+    ASSERT_EQ(cache.Register(&weight2, kWeightSize, CreateDecodeFunc(2.0f, &decode_num)), lite::RET_OK);
+    ASSERT_NE(cache.Acquire({&weight0, &weight1}), lite::RET_OK);
+    ASSERT_EQ(weight1.data(), nullptr);
+    // the weights pinned before the failure are unpinned, so weight0 is evicted for weight2.
+    ASSERT_EQ(cache.Acquire({&weight2}), lite::RET_OK);
+    ASSERT_EQ(weight0.data(), nullptr);
+    ASSERT_EQ(static_cast<float *>(weight2.data())[0], 2.0f);
+    cache.Release({&weight2});
+  }
+  weight0.set_data(nullptr);
+  weight2.set_data(nullptr);
+}
+}  // namespace mindspore
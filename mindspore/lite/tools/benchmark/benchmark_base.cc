@@ -25,6 +25,9 @@
 #include "schema/model_generated.h"
 #include "src/common/common.h"
 #include "src/tensor.h"
+#ifdef ENABLE_AVX
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
 #ifdef ENABLE_ARM64
 #include <linux/perf_event.h>
 #include <sys/ioctl.h>
@@ -429,6 +432,19 @@ int BenchmarkBase::Init() {
   std::cout << "EnableParallel = " << this->flags_->enable_parallel_ << std::endl;
   std::cout << "calibDataPath = " << this->flags_->benchmark_data_file_ << std::endl;
   std::cout << "EnableGLTexture = " << this->flags_->enable_gl_texture_ << std::endl;
+#ifdef ENABLE_AVX
+  // int8 matmul kernels pick the x86 gemm by the cpu features, print it to tell which one is measured.
+  std::string x86_int8_gemm = "AVX2";
+  if (IntelX86CpuInfoInit() == RET_OK) {
+    if (X86_Avx512Vnni_Support()) {
+      x86_int8_gemm = "AVX512_VNNI";
+    } else if (X86_Avx512Bw_Support()) {
+      x86_int8_gemm = "AVX512BW";
+    }
+  }
+  MS_LOG(INFO) << "X86Int8Gemm = " << x86_int8_gemm;
+  std::cout << "X86Int8Gemm = " << x86_int8_gemm << std::endl;
+#endif
   if (this->flags_->loop_count_ < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0";
     std::cerr << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0" << std::endl;
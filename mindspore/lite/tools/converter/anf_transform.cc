@@ -63,6 +63,7 @@
 #include "tools/optimizer/fusion/fullconnected_add_fusion.h"
 #include "tools/optimizer/fusion/add_concat_activation_fusion.h"
 #include "tools/optimizer/fusion/matmul_activation_fusion.h"
+#include "tools/optimizer/fusion/matmul_epilogue_fusion.h"
 #include "tools/optimizer/fusion/activation_fusion.h"
 #include "tools/optimizer/graph/add_tensor_array.h"
 #include "tools/optimizer/graph/redundant_op_remove_pass.h"
@@ -210,6 +211,7 @@ int AnfTransform::RunFusionPass(const FuncGraphPtr &old_graph, const std::shared
                                     std::make_shared<opt::TfBidirectionGruFusion>(),
                                     std::make_shared<opt::TfGeLUFusion>(),
                                     std::make_shared<opt::OnnxGeLUFusion>(),
+                                    std::make_shared<opt::MultiHeadAttentionFusion>(),
                                     std::make_shared<opt::TfliteRelPosMultiHeadAttentionFusion>(),
                                     std::make_shared<opt::GLUFusion>(),
                                     std::make_shared<opt::ConstFoldPass>(param->fmk_type, param->train_model),
@@ -247,6 +249,12 @@ int AnfTransform::RunFusionPass(const FuncGraphPtr &old_graph, const std::shared
     MS_LOG(ERROR) << "mul-reduce-fusion running failed.";
     return RET_ERROR;
   }
+  // runs once every other matmul fusion is done, since those expect the bias to be the last matmul input.
+  auto matmul_epilogue_fusion = std::make_shared<opt::MatMulEpilogueFusion>(param);
+  MS_CHECK_TRUE_MSG(matmul_epilogue_fusion != nullptr, RET_ERROR, "matmul-epilogue-fusion create failed.");
+  if (param->fusion_blacklists.find(matmul_epilogue_fusion->name()) == param->fusion_blacklists.end()) {
+    (void)matmul_epilogue_fusion->Run(old_graph);
+  }
   return RET_OK;
 }
 
@@ -49,6 +49,13 @@ Flags::Flags() {
   AddFlag(&Flags::saveFP16Str, "fp16",
           "Serialize const tensor in Float16 data type, only effective for const tensor in Float32 data type. on | off",
           "off");
+  AddFlag(&Flags::saveBF16Str, "bf16",
+          "Serialize the Float32 const weight of MatMul, FullConnection and Conv2D in BFloat16 data type. on | off",
+          "off");
+  AddFlag(&Flags::sparseWeightStr, "sparseWeight",
+          "Serialize the Float32 const weight of MatMul and FullConnection in a sparse format when its ratio of zeros "
+          "is at least this value, 0 disables it. [0, 1]",
+          "0");
   AddFlag(&Flags::trainModelIn, "trainModel",
           "whether the model is going to be trained on device. "
           "true | false",
@@ -251,6 +258,28 @@ int Flags::InitSaveFP16() {
   return RET_OK;
 }
 
+int Flags::InitSaveBF16() {
+  if (saveBF16Str == "on") {
+    saveBF16 = true;
+  } else if (saveBF16Str == "off") {
+    saveBF16 = false;
+  } else {
+    std::cerr << "Init save_bf16 failed." << std::endl;
+    return RET_INPUT_PARAM_INVALID;
+  }
+  return RET_OK;
+}
+
+int Flags::InitSparseWeight() {
+  double threshold = 0;
+  if (!lite::ConvertDoubleNum(sparseWeightStr, &threshold) || threshold < 0 || threshold > 1) {
+    std::cerr << "Init sparse_weight failed, it should be in [0, 1]." << std::endl;
+    return RET_INPUT_PARAM_INVALID;
+  }
+  sparseWeightThreshold = static_cast<float>(threshold);
+  return RET_OK;
+}
+
 int Flags::InitPreInference() {
   if (this->inferStr == "true") {
     this->infer = true;
@@ -360,6 +389,18 @@ int Flags::Init(int argc, const char **argv) {
     return RET_INPUT_PARAM_INVALID;
   }
 
+  ret = InitSaveBF16();
+  if (ret != RET_OK) {
+    std::cerr << "Init save bf16 failed." << std::endl;
+    return RET_INPUT_PARAM_INVALID;
+  }
+
+  ret = InitSparseWeight();
+  if (ret != RET_OK) {
+    std::cerr << "Init sparse weight failed." << std::endl;
+    return RET_INPUT_PARAM_INVALID;
+  }
+
   ret = InitInputOutputDataType();
   if (ret != RET_OK) {
     std::cerr << "Init input output datatype failed." << std::endl;
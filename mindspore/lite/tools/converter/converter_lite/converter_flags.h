@@ -39,6 +39,8 @@ class Flags : public virtual mindspore::lite::FlagParser {
   int InitEncrypt();
   int InitPreInference();
   int InitSaveFP16();
+  int InitSaveBF16();
+  int InitSparseWeight();
   int InitNoFusion();
   int InitExportMindIR();
   int Init(int argc, const char **argv);
@@ -51,6 +53,10 @@ class Flags : public virtual mindspore::lite::FlagParser {
   std::string weightFile;
   std::string saveFP16Str = "off";
   bool saveFP16 = false;
+  std::string saveBF16Str = "off";
+  bool saveBF16 = false;
+  std::string sparseWeightStr = "0";
+  float sparseWeightThreshold = 0.0f;
   std::string noFusionStr = "false";
   bool disableFusion = false;
   std::string inputDataTypeStr;
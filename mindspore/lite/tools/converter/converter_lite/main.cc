@@ -53,6 +53,8 @@ int main(int argc, const char **argv) {
     mindspore::Converter converter(flags.fmk, flags.modelFile, flags.outputFile, flags.weightFile);
     converter.SetConfigFile(flags.configFile);
     converter.SetWeightFp16(flags.saveFP16);
+    converter.SetWeightBf16(flags.saveBF16);
+    converter.SetSparseWeightThreshold(flags.sparseWeightThreshold);
     converter.SetInputShape(flags.graph_input_shape_map);
     converter.SetInputFormat(flags.graphInputFormat);
     converter.SetInputDataType(flags.inputDataType);
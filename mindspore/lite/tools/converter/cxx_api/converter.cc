@@ -92,6 +92,34 @@ bool Converter::GetWeightFp16() const {
   }
 }
 
+void Converter::SetWeightBf16(bool weight_bf16) {
+  if (data_ != nullptr) {
+    data_->weight_bf16 = weight_bf16;
+  }
+}
+
+bool Converter::GetWeightBf16() const {
+  if (data_ != nullptr) {
+    return data_->weight_bf16;
+  } else {
+    return false;
+  }
+}
+
+void Converter::SetSparseWeightThreshold(float sparse_weight_threshold) {
+  if (data_ != nullptr) {
+    data_->sparse_weight_threshold = sparse_weight_threshold;
+  }
+}
+
+float Converter::GetSparseWeightThreshold() const {
+  if (data_ != nullptr) {
+    return data_->sparse_weight_threshold;
+  } else {
+    return 0.0f;
+  }
+}
+
 void Converter::SetInputShape(const std::map<std::string, std::vector<int64_t>> &input_shape) {
   if (data_ != nullptr) {
     for (auto &it : input_shape) {
@@ -44,6 +44,8 @@ struct ConverterPara {
   std::string config_file;
   std::map<std::string, std::map<std::string, std::string>> config_param;
   bool weight_fp16 = false;
+  bool weight_bf16 = false;
+  float sparse_weight_threshold = 0.0f;
   std::map<std::string, std::vector<int64_t>> input_shape;
   Format input_format = NHWC;
   DataType input_data_type = DataType::kNumberTypeFloat32;
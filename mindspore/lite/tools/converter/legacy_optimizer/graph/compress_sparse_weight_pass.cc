@@ -0,0 +1,94 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/converter/legacy_optimizer/graph/compress_sparse_weight_pass.h"
+#include <cstring>
+#include <set>
+#include <vector>
+#include "tools/converter/converter_context.h"
+#include "src/common/log_adapter.h"
+#include "tools/common/tensor_util.h"
+#include "include/errorcode.h"
+#include "schema/inner/model_generated.h"
+#include "src/common/log_util.h"
+#include "nnacl/op_base.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr size_t kWeightInputIndex = 1;
+constexpr size_t kBitsPerByte = 8;
+const std::set<schema::PrimitiveType> kSparseWeightOps = {schema::PrimitiveType_MatMulFusion,
+                                                          schema::PrimitiveType_FullConnection};
+}  // namespace
+
+STATUS CompressSparseWeightPass::Run(schema::MetaGraphT *graph) {
+  if (sparsity_threshold_ <= 0.0f) {
+    return RET_NO_CHANGE;
+  }
+  CHECK_NULL_RETURN(graph);
+  bool if_changed = false;
+  for (auto &node : graph->nodes) {
+    CHECK_NULL_RETURN(node);
+    if (node->primitive == nullptr || kSparseWeightOps.find(node->primitive->value.type) == kSparseWeightOps.end() ||
+        node->inputIndex.size() <= kWeightInputIndex) {
+      continue;
+    }
+    auto tensor_index = node->inputIndex.at(kWeightInputIndex);
+    MS_CHECK_TRUE_RET(tensor_index < graph->allTensors.size(), RET_ERROR);
+    auto &tensor = graph->allTensors.at(tensor_index);
+    CHECK_NULL_RETURN(tensor);
+    if (tensor->dataType != kNumberTypeFloat32 || tensor->data.empty() || !tensor->quantParams.empty() ||
+        tensor->weightQuantCompressType != schema::WeightQuantCompressType_NONE) {
+      continue;
+    }
+    auto ele_num = lite::GetShapeSize(tensor->dims);
+    if (tensor->data.size() != ele_num * sizeof(float)) {
+      MS_LOG(ERROR) << "Tensor data length error.";
+      ReturnCode::GetSingleReturnCode()->UpdateReturnCode(RET_ERROR);
+      return RET_ERROR;
+    }
+    auto fp32_data = reinterpret_cast<const float *>(tensor->data.data());
+    size_t non_zero_num = 0;
+    for (size_t i = 0; i < ele_num; i++) {
+      non_zero_num += fp32_data[i] != 0.0f ? 1 : 0;
+    }
+    auto sparsity = 1.0f - static_cast<float>(non_zero_num) / ele_num;
+    size_t bitmap_size = UP_DIV(ele_num, kBitsPerByte);
+    size_t new_size = bitmap_size + non_zero_num * sizeof(float);
+    if (sparsity < sparsity_threshold_ || new_size >= tensor->data.size()) {
+      continue;
+    }
+    std::vector<uint8_t> new_data(new_size, 0);
+    auto values = reinterpret_cast<float *>(new_data.data() + bitmap_size);
+    size_t value_index = 0;
+    for (size_t i = 0; i < ele_num; i++) {
+      if (fp32_data[i] != 0.0f) {
+        new_data[i / kBitsPerByte] |= static_cast<uint8_t>(1u << (i % kBitsPerByte));
+        (void)memcpy(values + value_index, fp32_data + i, sizeof(float));
+        value_index++;
+      }
+    }
+    MS_LOG(INFO) << tensor->name << " sparsity: " << sparsity << ", compressed from " << tensor->data.size() << " to "
+                 << new_size << " bytes.";
+    tensor->data.swap(new_data);
+    tensor->weightQuantCompressType = schema::WeightQuantCompressType_FLOAT_SPARSE;
+    if_changed = true;
+  }
+  return if_changed ? RET_OK : RET_NO_CHANGE;
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,41 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_COMPRESS_SPARSE_WEIGHT_PASS_H_
+#define MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_COMPRESS_SPARSE_WEIGHT_PASS_H_
+
+#include "tools/converter/optimizer.h"
+
+namespace mindspore {
+namespace lite {
+// Serialize the const fp32 weights of MatMulFusion and FullConnection whose ratio of zeros is at least the threshold
+// as a bitmap of the non zero elements followed by the non zero values (WeightQuantCompressType FLOAT_SPARSE).
+// The runtime expands them at load time and picks a sparse gemm when it is expected to be faster than the dense one.
+class CompressSparseWeightPass : public GraphPass {
+ public:
+  explicit CompressSparseWeightPass(float sparsity_threshold) : sparsity_threshold_(sparsity_threshold) {}
+
+  ~CompressSparseWeightPass() override = default;
+
+  STATUS Run(schema::MetaGraphT *graph) override;
+
+ private:
+  float sparsity_threshold_ = 0.0f;
+};
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_COMPRESS_SPARSE_WEIGHT_PASS_H_
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/converter/legacy_optimizer/graph/convert_fp32_to_bf16_pass.h"
+#include <set>
+#include <vector>
+#include "tools/converter/converter_context.h"
+#include "src/common/log_adapter.h"
+#include "tools/common/tensor_util.h"
+#include "include/errorcode.h"
+#include "schema/inner/model_generated.h"
+#include "nnacl/base/cast_base.h"
+#include "src/common/log_util.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr size_t kWeightInputIndex = 1;
+constexpr int kBf16ToFp32Multiply = 2;
+const std::set<schema::PrimitiveType> kBf16WeightOps = {schema::PrimitiveType_MatMulFusion,
+                                                        schema::PrimitiveType_FullConnection,
+                                                        schema::PrimitiveType_Conv2DFusion};
+}  // namespace
+
+STATUS ConvertFP32ToBF16Pass::Run(schema::MetaGraphT *graph) {
+  if (!need_convert_) {
+    return RET_NO_CHANGE;
+  }
+  CHECK_NULL_RETURN(graph);
+  bool if_changed = false;
+  for (auto &node : graph->nodes) {
+    CHECK_NULL_RETURN(node);
+    if (node->primitive == nullptr || kBf16WeightOps.find(node->primitive->value.type) == kBf16WeightOps.end() ||
+        node->inputIndex.size() <= kWeightInputIndex) {
+      continue;
+    }
+    auto tensor_index = node->inputIndex.at(kWeightInputIndex);
+    MS_CHECK_TRUE_RET(tensor_index < graph->allTensors.size(), RET_ERROR);
+    auto &tensor = graph->allTensors.at(tensor_index);
+    CHECK_NULL_RETURN(tensor);
+    if (tensor->dataType != kNumberTypeFloat32 || tensor->data.empty() || !tensor->quantParams.empty()) {
+      continue;
+    }
+    auto ele_num = lite::GetShapeSize(tensor->dims);
+    auto &origin_data = tensor->data;
+    if (origin_data.size() != ele_num * sizeof(float)) {
+      MS_LOG(ERROR) << "Tensor data length error.";
+      ReturnCode::GetSingleReturnCode()->UpdateReturnCode(RET_ERROR);
+      return RET_ERROR;
+    }
+    std::vector<uint8_t> new_data(origin_data.size() / kBf16ToFp32Multiply);
+    auto fp32_data = reinterpret_cast<const float *>(origin_data.data());
+    auto bf16_data = reinterpret_cast<uint16_t *>(new_data.data());
+    Float32ToBFloat16(fp32_data, bf16_data, static_cast<int>(ele_num));
+    tensor->data.swap(new_data);
+    tensor->dataType = kNumberTypeBFloat16;
+    if_changed = true;
+  }
+  return if_changed ? RET_OK : RET_NO_CHANGE;
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_CONVERT_FP32_TO_BF16_PASS_H_
+#define MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_CONVERT_FP32_TO_BF16_PASS_H_
+
+#include "tools/converter/optimizer.h"
+
+namespace mindspore {
+namespace lite {
+// Serialize the const fp32 weights of MatMulFusion, FullConnection and Conv2DFusion in bfloat16. Unlike fp16, bf16
+// keeps the fp32 exponent range, so no weight overflows.
+class ConvertFP32ToBF16Pass : public GraphPass {
+ public:
+  explicit ConvertFP32ToBF16Pass(bool save_bf16) : need_convert_(save_bf16) {}
+
+  ~ConvertFP32ToBF16Pass() override = default;
+
+  STATUS Run(schema::MetaGraphT *graph) override;
+
+ private:
+  bool need_convert_ = false;
+};
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_LITE_TOOLS_CONVERTER_LEGACY_OPTIMIZER_GRAPH_CONVERT_FP32_TO_BF16_PASS_H_
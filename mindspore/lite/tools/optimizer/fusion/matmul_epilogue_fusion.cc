@@ -0,0 +1,260 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define USE_DEPRECATED_API
+#include "tools/optimizer/fusion/matmul_epilogue_fusion.h"
+#include <algorithm>
+#include <vector>
+#include "ops/fusion/activation.h"
+#include "ops/fusion/add_fusion.h"
+#include "ops/fusion/layer_norm_fusion.h"
+#include "ops/fusion/mat_mul_fusion.h"
+#include "ops/softmax.h"
+#include "ops/op_utils.h"
+#include "tools/optimizer/common/gllo_utils.h"
+#include "nnacl/matmul_parameter.h"
+#include "nnacl/op_base.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+bool IsConstNode(const AnfNodePtr &node) {
+  return utils::isa<ValueNode>(node) ||
+         (utils::isa<Parameter>(node) && node->cast<ParameterPtr>()->default_param() != nullptr);
+}
+
+// the matmul feeding the given input, if it can take one more epilogue, else nullptr.
+CNodePtr GetFusibleMatMul(const FuncGraphPtr &func_graph, const AnfNodePtr &input) {
+  if (input == nullptr || !utils::isa<CNode>(input) || !CheckPrimitiveType(input, prim::kPrimMatMulFusion)) {
+    return nullptr;
+  }
+  auto matmul_cnode = input->cast<CNodePtr>();
+  if (IsMarkedTrainOp(matmul_cnode) || IsMultiOutputTensors(func_graph, matmul_cnode)) {
+    return nullptr;
+  }
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_cnode->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, nullptr);
+  auto matmul_prim_c = matmul_prim->GetPrim();
+  MS_CHECK_TRUE_RET(matmul_prim_c != nullptr, nullptr);
+  if (IsQuantParameterNode(matmul_prim_c)) {
+    MS_LOG(INFO) << matmul_cnode->fullname_with_scope() << " is quant node";
+    return nullptr;
+  }
+  return matmul_cnode;
+}
+
+int64_t GetEpilogueType(const CNodePtr &matmul_cnode) {
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_cnode->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, -1);
+  return matmul_prim->get_epilogue_type();
+}
+
+// the rank of the matmul output, 0 when it is unknown.
+size_t GetOutputRank(const CNodePtr &matmul_cnode, ShapeVector *shape) {
+  auto abstract = matmul_cnode->abstract();
+  if (abstract == nullptr || FetchShapeFromAbstract(abstract, shape) != lite::RET_OK) {
+    return 0;
+  }
+  return shape->size();
+}
+
+bool IsLastAxis(int64_t axis, size_t rank) { return axis == -1 || axis == static_cast<int64_t>(rank) - 1; }
+
+// a const 1d tensor holding one float per output column.
+bool IsColumnParam(const AnfNodePtr &node, int64_t col) {
+  if (!IsConstNode(node)) {
+    return false;
+  }
+  auto tensor_info = GetTensorInfo(node);
+  if (tensor_info == nullptr || tensor_info->data_type() != kNumberTypeFloat32) {
+    return false;
+  }
+  auto shape = tensor_info->shape();
+  return shape.size() == DIMENSION_1D && shape.front() == col;
+}
+
+bool AppendEpilogue(const FuncGraphPtr &func_graph, const CNodePtr &matmul_cnode, const CNodePtr &fused_cnode,
+                    int64_t epilogue, const std::vector<AnfNodePtr> &inputs) {
+  auto manager = func_graph->manager();
+  MS_CHECK_TRUE_RET(manager != nullptr, false);
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_cnode->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, false);
+  for (auto &input : inputs) {
+    manager->AddEdge(matmul_cnode, input);
+  }
+  matmul_prim->set_epilogue_type(matmul_prim->get_epilogue_type() | epilogue);
+  matmul_cnode->set_abstract(fused_cnode->abstract());
+  return manager->Replace(fused_cnode, matmul_cnode);
+}
+}  // namespace
+
+bool MatMulEpilogueFusion::FuseResidualAdd(const FuncGraphPtr &func_graph, const CNodePtr &add_cnode) const {
+  if (add_cnode->size() != kInputSizeThree) {
+    return false;
+  }
+  auto add_prim = ops::GetOperator<ops::AddFusion>(add_cnode->input(0));
+  MS_CHECK_TRUE_RET(add_prim != nullptr, false);
+  if (add_prim->GetAttr(ops::kActivationType) != nullptr &&
+      add_prim->get_activation_type() != ActivationType::NO_ACTIVATION) {
+    return false;
+  }
+  size_t index = 0;
+  if (!CheckAndGetCnodeIndex(add_cnode, &index, prim::kPrimMatMulFusion)) {
+    return false;
+  }
+  auto matmul_cnode = GetFusibleMatMul(func_graph, add_cnode->input(index));
+  // the residual goes first, so it can only be fused into a bare matmul.
+  if (matmul_cnode == nullptr || GetEpilogueType(matmul_cnode) != MatmulEpilogue_None) {
+    return false;
+  }
+  // a const addend is a bias, which MatMulAddFusion takes care of.
+  auto residual = add_cnode->input(kInputSizeThree - index);
+  if (IsConstNode(residual) || residual->abstract() == nullptr) {
+    return false;
+  }
+  ShapeVector out_shape;
+  ShapeVector residual_shape;
+  if (GetOutputRank(matmul_cnode, &out_shape) < DIMENSION_2D ||
+      FetchShapeFromAbstract(residual->abstract(), &residual_shape) != lite::RET_OK || residual_shape != out_shape ||
+      std::any_of(out_shape.begin(), out_shape.end(), [](int64_t dim) { return dim < 0; })) {
+    return false;
+  }
+  return AppendEpilogue(func_graph, matmul_cnode, add_cnode, MatmulEpilogue_ResidualAdd, {residual});
+}
+
+bool MatMulEpilogueFusion::FuseGelu(const FuncGraphPtr &func_graph, const CNodePtr &act_cnode) const {
+  if (act_cnode->size() != kInputSizeTwo) {
+    return false;
+  }
+  auto act_prim = ops::GetOperator<ops::Activation>(act_cnode->input(0));
+  MS_CHECK_TRUE_RET(act_prim != nullptr, false);
+  if (act_prim->GetAttr(ops::kActivationType) == nullptr || act_prim->get_activation_type() != ActivationType::GELU) {
+    return false;
+  }
+  auto matmul_cnode = GetFusibleMatMul(func_graph, act_cnode->input(1));
+  if (matmul_cnode == nullptr) {
+    return false;
+  }
+  auto epilogue = GetEpilogueType(matmul_cnode);
+  if (epilogue < 0 || (epilogue & (MatmulEpilogue_Gelu | MatmulEpilogue_LayerNorm | MatmulEpilogue_Softmax)) != 0) {
+    return false;
+  }
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_cnode->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, false);
+  matmul_prim->set_approximate(act_prim->get_approximate());
+  return AppendEpilogue(func_graph, matmul_cnode, act_cnode, MatmulEpilogue_Gelu, {});
+}
+
+bool MatMulEpilogueFusion::FuseLayerNorm(const FuncGraphPtr &func_graph, const CNodePtr &norm_cnode) const {
+  if (norm_cnode->size() != kInputSizeFour) {
+    return false;
+  }
+  auto norm_prim = ops::GetOperator<ops::LayerNormFusion>(norm_cnode->input(0));
+  MS_CHECK_TRUE_RET(norm_prim != nullptr, false);
+  if (norm_prim->GetAttr(ops::kBeginNormAxis) == nullptr || norm_prim->GetAttr(ops::kBeginParamsAxis) == nullptr ||
+      norm_prim->GetAttr(ops::kEpsilon) == nullptr ||
+      (norm_prim->GetAttr(ops::kElementwiseAffine) != nullptr && !norm_prim->get_elementwise_affine())) {
+    return false;
+  }
+  auto matmul_cnode = GetFusibleMatMul(func_graph, norm_cnode->input(1));
+  if (matmul_cnode == nullptr) {
+    return false;
+  }
+  auto epilogue = GetEpilogueType(matmul_cnode);
+  if (epilogue < 0 || (epilogue & (MatmulEpilogue_LayerNorm | MatmulEpilogue_Softmax)) != 0) {
+    return false;
+  }
+  ShapeVector out_shape;
+  auto rank = GetOutputRank(matmul_cnode, &out_shape);
+  if (rank < DIMENSION_2D || out_shape.back() <= 0 || !IsLastAxis(norm_prim->get_begin_norm_axis(), rank) ||
+      !IsLastAxis(norm_prim->get_begin_params_axis(), rank)) {
+    return false;
+  }
+  auto gamma = norm_cnode->input(kInputIndexTwo);
+  auto beta = norm_cnode->input(kInputIndexThree);
+  if (!IsColumnParam(gamma, out_shape.back()) || !IsColumnParam(beta, out_shape.back())) {
+    return false;
+  }
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_cnode->input(0));
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, false);
+  matmul_prim->set_epsilon(norm_prim->get_epsilon());
+  return AppendEpilogue(func_graph, matmul_cnode, norm_cnode, MatmulEpilogue_LayerNorm, {gamma, beta});
+}
+
+bool MatMulEpilogueFusion::FuseSoftmax(const FuncGraphPtr &func_graph, const CNodePtr &softmax_cnode) const {
+  if (softmax_cnode->size() != kInputSizeTwo) {
+    return false;
+  }
+  auto softmax_prim = ops::GetOperator<ops::Softmax>(softmax_cnode->input(0));
+  MS_CHECK_TRUE_RET(softmax_prim != nullptr, false);
+  if (softmax_prim->GetAttr(ops::kAxis) == nullptr) {
+    return false;
+  }
+  auto axis = softmax_prim->get_axis();
+  auto matmul_cnode = GetFusibleMatMul(func_graph, softmax_cnode->input(1));
+  if (matmul_cnode == nullptr) {
+    return false;
+  }
+  auto epilogue = GetEpilogueType(matmul_cnode);
+  if (epilogue < 0 || (epilogue & (MatmulEpilogue_LayerNorm | MatmulEpilogue_Softmax)) != 0) {
+    return false;
+  }
+  ShapeVector out_shape;
+  auto rank = GetOutputRank(matmul_cnode, &out_shape);
+  if (rank < DIMENSION_2D || axis.size() != 1 || !IsLastAxis(axis.front(), rank)) {
+    return false;
+  }
+  return AppendEpilogue(func_graph, matmul_cnode, softmax_cnode, MatmulEpilogue_Softmax, {});
+}
+
+bool MatMulEpilogueFusion::Run(const FuncGraphPtr &func_graph) {
+  MS_ASSERT(func_graph != nullptr);
+  // only the fp32 cpu matmul implements the epilogues, the quantized and nvgpu graphs keep the original ops, and so do
+  // the graphs generated into code by micro, whose matmul coders read the third input as bias only.
+  if (param_->commonQuantParam.quant_type == schema::QuantType_QUANT_ALL ||
+      param_->commonQuantParam.quant_type == schema::QuantType_QUANT_DYNAMIC ||
+      param_->fullQuantParam.target_device == lite::quant::NVGPU || param_->microParam.enable_micro) {
+    return false;
+  }
+  auto node_list = TopoSort(func_graph->get_return());
+  for (auto &node : node_list) {
+    MS_CHECK_TRUE_RET(node != nullptr, false);
+    if (!utils::isa<CNode>(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    if (IsMarkedTrainOp(cnode)) {
+      continue;
+    }
+    bool fused = false;
+    if (CheckPrimitiveType(node, prim::kPrimAddFusion)) {
+      fused = FuseResidualAdd(func_graph, cnode);
+    } else if (CheckPrimitiveType(node, prim::kPrimActivation)) {
+      fused = FuseGelu(func_graph, cnode);
+    } else if (CheckPrimitiveType(node, prim::kPrimLayerNormFusion)) {
+      fused = FuseLayerNorm(func_graph, cnode);
+    } else if (CheckPrimitiveType(node, prim::kPrimSoftmax)) {
+      fused = FuseSoftmax(func_graph, cnode);
+    }
+    if (fused) {
+      MS_LOG(INFO) << cnode->fullname_with_scope() << " is fused into the matmul epilogue.";
+    }
+  }
+  return false;
+}
+}  // namespace opt
+}  // namespace mindspore
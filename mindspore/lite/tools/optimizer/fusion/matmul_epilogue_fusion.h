@@ -0,0 +1,47 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_LITE_TOOLS_OPTIMIZER_FUSION_MATMUL_EPILOGUE_FUSION_H_
+#define MINDSPORE_LITE_TOOLS_OPTIMIZER_FUSION_MATMUL_EPILOGUE_FUSION_H_
+
+#include <memory>
+#include "backend/common/optimizer/optimizer.h"
+#include "tools/converter/cxx_api/converter_para.h"
+
+namespace mindspore {
+namespace opt {
+// Folds the ops following a MatMulFusion into its epilogue: a residual AddFusion of the output shape, a GELU
+// activation, then a LayerNormFusion or a Softmax over the last axis. The residual, gamma and beta are appended
+// to the matmul inputs after the bias.
+class MatMulEpilogueFusion : public Pass {
+ public:
+  explicit MatMulEpilogueFusion(const std::shared_ptr<ConverterPara> &param)
+      : Pass("MatMulEpilogueFusion"), param_(param) {}
+  ~MatMulEpilogueFusion() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+
+ private:
+  bool FuseResidualAdd(const FuncGraphPtr &func_graph, const CNodePtr &add_cnode) const;
+  bool FuseGelu(const FuncGraphPtr &func_graph, const CNodePtr &act_cnode) const;
+  bool FuseLayerNorm(const FuncGraphPtr &func_graph, const CNodePtr &norm_cnode) const;
+  bool FuseSoftmax(const FuncGraphPtr &func_graph, const CNodePtr &softmax_cnode) const;
+
+  const std::shared_ptr<ConverterPara> param_;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_TOOLS_OPTIMIZER_FUSION_MATMUL_EPILOGUE_FUSION_H_
@@ -16,35 +16,88 @@
 
 #define USE_DEPRECATED_API
 #include "tools/optimizer/fusion/multi_head_attention_fusion.h"
+#include <algorithm>
 #include <functional>
 #include <utility>
+#include <vector>
 #include "tools/optimizer/common/gllo_utils.h"
+#include "ops/fusion/mat_mul_fusion.h"
+#include "ops/op_utils.h"
 #include "nnacl/op_base.h"
 
 namespace mindspore::opt {
 namespace {
 const auto &p1 = std::placeholders::_1;
 const size_t kWeightShapeSize = 2;
+const std::vector<int> kHeadPerm = {0, 2, 1, 3};
+const std::vector<int> kTransposedHeadPerm = {0, 2, 3, 1};
+// the attention kernel adds (1 - mask) * -10000 to the scores.
+constexpr float kMaskSubValue = 1.0f;
+constexpr float kMaskMulValue = -10000.0f;
+
+STATUS GetScaleParameterData(const EquivPtr &equiv, const VarPtr &scale_var, float *scale) {
+  MS_ASSERT(equiv != nullptr && scale != nullptr);
+  auto scale_node = utils::cast<AnfNodePtr>((*equiv)[scale_var]);
+  MS_CHECK_TRUE_RET(scale_node != nullptr, RET_ERROR);
+  auto scale_tensor = GetTensorInfo(scale_node);
+  if (scale_tensor == nullptr || scale_tensor->data_type() != kNumberTypeFloat32 || scale_tensor->DataSize() != 1) {
+    MS_LOG(DEBUG) << "scale param is not a float scalar";
+    return RET_ERROR;
+  }
+  *scale = *reinterpret_cast<float *>(scale_tensor->data_c());
+  return RET_OK;
+}
+
+// the attention kernel projects with [in, out] weights, so the matmuls can't transpose a or fuse an activation.
+bool CheckMatMul(const EquivPtr &equiv, const VarPtr &matmul_var, bool transpose_b) {
+  auto matmul_node = utils::cast<AnfNodePtr>((*equiv)[matmul_var]);
+  MS_CHECK_TRUE_RET(matmul_node != nullptr, false);
+  auto matmul_prim = ops::GetOperator<ops::MatMulFusion>(matmul_node);
+  MS_CHECK_TRUE_RET(matmul_prim != nullptr, false);
+  bool matmul_transpose_a = matmul_prim->GetAttr(ops::kTransposeA) != nullptr && matmul_prim->get_transpose_a();
+  bool matmul_transpose_b = matmul_prim->GetAttr(ops::kTransposeB) != nullptr && matmul_prim->get_transpose_b();
+  bool has_activation = matmul_prim->GetAttr(ops::kActivationType) != nullptr &&
+                        matmul_prim->get_activation_type() != ActivationType::NO_ACTIVATION;
+  return !matmul_transpose_a && matmul_transpose_b == transpose_b && !has_activation;
+}
+
+bool CheckPerm(const EquivPtr &equiv, const VarPtr &perm_var, const std::vector<int> &perm) {
+  auto perm_node = utils::cast<AnfNodePtr>((*equiv)[perm_var]);
+  MS_CHECK_TRUE_RET(perm_node != nullptr, false);
+  auto perm_tensor = GetTensorInfo(perm_node);
+  if (perm_tensor == nullptr || perm_tensor->data_type() != kNumberTypeInt32 ||
+      perm_tensor->DataSize() != perm.size()) {
+    return false;
+  }
+  auto perm_data = reinterpret_cast<int *>(perm_tensor->data_c());
+  return std::equal(perm.begin(), perm.end(), perm_data);
+}
+
+bool CheckConstValue(const EquivPtr &equiv, const VarPtr &const_var, float value) {
+  auto const_node = utils::cast<AnfNodePtr>((*equiv)[const_var]);
+  MS_CHECK_TRUE_RET(const_node != nullptr, false);
+  auto const_tensor = GetTensorInfo(const_node);
+  if (const_tensor == nullptr || const_tensor->data_type() != kNumberTypeFloat32 || const_tensor->DataSize() == 0) {
+    return false;
+  }
+  auto const_data = reinterpret_cast<float *>(const_tensor->data_c());
+  return std::all_of(const_data, const_data + const_tensor->DataSize(), [value](float data) { return data == value; });
+}
 }  // namespace
 
 namespace {
-VectorRef DefineEmbedding(const BaseRef &input, const BaseRef &weight, const BaseRef &bias) {
-  auto is_matmul = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
-  MS_CHECK_TRUE_RET(is_matmul != nullptr, {});
-  auto dense = VectorRef({is_matmul, input, weight, bias});
+VectorRef DefineEmbedding(const BaseRef &input, const BaseRef &weight, const BaseRef &bias,
+                          const BaseRef &reshape_shape, const BaseRef &matmul, const BaseRef &perm) {
+  auto dense = VectorRef({matmul, input, weight, bias});
   auto is_reshape = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimReshape));
   MS_CHECK_TRUE_RET(is_reshape != nullptr, {});
-  auto is_var = std::make_shared<Var>();
-  MS_CHECK_TRUE_RET(is_var != nullptr, {});
-  auto reshape = VectorRef({is_reshape, dense, is_var});
+  auto reshape = VectorRef({is_reshape, dense, reshape_shape});
   auto is_transpose = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimTranspose));
   MS_CHECK_TRUE_RET(is_transpose != nullptr, {});
-  auto is_param = std::make_shared<CondVar>(IsParamNode);
-  MS_CHECK_TRUE_RET(is_param != nullptr, {});
-  return VectorRef({is_transpose, reshape, is_param});
+  return VectorRef({is_transpose, reshape, perm});
 }
 
-VectorRef DefineMask(const BaseRef &mask_input) {
+VectorRef DefineMask(const BaseRef &mask_input, const BaseRef &sub_value, const BaseRef &mul_value) {
   auto is_expand_dims = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimExpandDims));
   MS_CHECK_TRUE_RET(is_expand_dims != nullptr, {});
   auto is_param1 = std::make_shared<CondVar>(IsParamNode);
@@ -52,33 +105,27 @@ VectorRef DefineMask(const BaseRef &mask_input) {
   auto expand_dims = VectorRef({is_expand_dims, mask_input, is_param1});
   auto is_sub = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimSubFusion));
   MS_CHECK_TRUE_RET(is_sub != nullptr, {});
-  auto is_param2 = std::make_shared<CondVar>(IsParamNode);
-  MS_CHECK_TRUE_RET(is_param2 != nullptr, {});
-  auto sub = VectorRef({is_sub, is_param2, expand_dims});
+  auto sub = VectorRef({is_sub, sub_value, expand_dims});
   auto is_mul = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMulFusion));
   MS_CHECK_TRUE_RET(is_mul != nullptr, {});
-  auto is_param3 = std::make_shared<CondVar>(IsParamNode);
-  MS_CHECK_TRUE_RET(is_param3 != nullptr, {});
-  return VectorRef({is_mul, sub, is_param3});
+  return VectorRef({is_mul, sub, mul_value});
 }
 }  // namespace
 
 VectorRef MultiHeadAttentionFusion::DefineMPWithMaskPattern() const {
-  auto q_embedding = DefineEmbedding(input_q_, weight_q_, bias_q_);
+  auto is_var = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(is_var != nullptr, {});
+  auto q_embedding = DefineEmbedding(input_q_, weight_q_, bias_q_, is_var, matmul_q_, perm_q_);
   MS_CHECK_TRUE_RET(!q_embedding.empty(), {});
-  auto k_embedding = DefineEmbedding(input_k_, weight_k_, bias_k_);
+  auto k_embedding = DefineEmbedding(input_k_, weight_k_, bias_k_, reshape_k_, matmul_k_, perm_k_);
   MS_CHECK_TRUE_RET(!k_embedding.empty(), {});
-  auto v_embedding = DefineEmbedding(input_v_, weight_v_, bias_v_);
+  auto v_embedding = DefineEmbedding(input_v_, weight_v_, bias_v_, reshape_v_, matmul_v_, perm_v_);
   MS_CHECK_TRUE_RET(!v_embedding.empty(), {});
-  auto is_matmul1 = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
-  MS_CHECK_TRUE_RET(is_matmul1 != nullptr, {});
-  auto q2k = VectorRef({is_matmul1, q_embedding, k_embedding});
+  auto q2k = VectorRef({matmul_qk_, q_embedding, k_embedding});
   auto is_mul = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMulFusion));
   MS_CHECK_TRUE_RET(is_mul != nullptr, {});
-  auto is_param1 = std::make_shared<CondVar>(IsParamNode);
-  MS_CHECK_TRUE_RET(is_param1 != nullptr, {});
-  auto q2k_normed = VectorRef({is_mul, q2k, is_param1});
-  auto mask = DefineMask(mask_);
+  auto q2k_normed = VectorRef({is_mul, q2k, scale_});
+  auto mask = DefineMask(mask_, mask_sub_value_, mask_mul_value_);
   MS_CHECK_TRUE_RET(!mask.empty(), {});
   auto is_add = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimAddFusion));
   MS_CHECK_TRUE_RET(is_add != nullptr, {});
@@ -86,22 +133,16 @@ VectorRef MultiHeadAttentionFusion::DefineMPWithMaskPattern() const {
   auto is_softmax = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimSoftmax));
   MS_CHECK_TRUE_RET(is_softmax != nullptr, {});
   auto softmax = VectorRef({is_softmax, q2k_normed_masked});
-  auto is_matmul2 = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
-  MS_CHECK_TRUE_RET(is_matmul2 != nullptr, {});
-  auto softmax2v = VectorRef({is_matmul2, softmax, v_embedding});
+  auto softmax2v = VectorRef({matmul_sv_, softmax, v_embedding});
   auto is_transpose = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimTranspose));
   MS_CHECK_TRUE_RET(is_transpose != nullptr, {});
-  auto is_param2 = std::make_shared<CondVar>(IsParamNode);
-  MS_CHECK_TRUE_RET(is_param2 != nullptr, {});
-  auto softmax2v_transposed = VectorRef({is_transpose, softmax2v, is_param2});
+  auto softmax2v_transposed = VectorRef({is_transpose, softmax2v, perm_o_});
   auto is_reshape = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimReshape));
   MS_CHECK_TRUE_RET(is_reshape != nullptr, {});
-  auto is_var = std::make_shared<Var>();
-  MS_CHECK_TRUE_RET(is_var != nullptr, {});
-  auto softmax2v_transposed_reshaped = VectorRef({is_reshape, softmax2v_transposed, is_var});
-  auto is_matmul3 = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
-  MS_CHECK_TRUE_RET(is_matmul3 != nullptr, {});
-  return VectorRef({is_matmul3, softmax2v_transposed_reshaped, weight_o_, bias_o_});
+  auto is_var2 = std::make_shared<Var>();
+  MS_CHECK_TRUE_RET(is_var2 != nullptr, {});
+  auto softmax2v_transposed_reshaped = VectorRef({is_reshape, softmax2v_transposed, is_var2});
+  return VectorRef({matmul_o_, softmax2v_transposed_reshaped, weight_o_, bias_o_});
 }
 
 namespace {
@@ -197,6 +238,17 @@ bool MultiHeadAttentionFusion::Init() const {
   MS_CHECK_TRUE_RET(reshape_k_ != nullptr, false);
   reshape_v_ = std::make_shared<Var>();
   MS_CHECK_TRUE_RET(reshape_v_ != nullptr, false);
+  scale_ = std::make_shared<CondVar>(IsParamNode);
+  MS_CHECK_TRUE_RET(scale_ != nullptr, false);
+
+  for (auto matmul : {&matmul_q_, &matmul_k_, &matmul_v_, &matmul_o_, &matmul_qk_, &matmul_sv_}) {
+    *matmul = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimMatMulFusion));
+    MS_CHECK_TRUE_RET(*matmul != nullptr, false);
+  }
+  for (auto param : {&perm_q_, &perm_k_, &perm_v_, &perm_o_, &mask_sub_value_, &mask_mul_value_}) {
+    *param = std::make_shared<CondVar>(IsParamNode);
+    MS_CHECK_TRUE_RET(*param != nullptr, false);
+  }
   return true;
 }
 
@@ -207,9 +259,7 @@ VectorRef MultiHeadAttentionFusion::DefineMPWithoutMaskPattern() const {
   MS_CHECK_TRUE_RET(!query.empty(), {});
   auto is_div = std::make_shared<CondVar>(std::bind(IsOpType, p1, prim::kPrimDivFusion));
   MS_CHECK_TRUE_RET(is_div != nullptr, {});
-  auto is_param2 = std::make_shared<CondVar>(IsParamNode);
-  MS_CHECK_TRUE_RET(is_param2 != nullptr, {});
-  auto query_div = VectorRef({is_div, query, is_param2});
+  auto query_div = VectorRef({is_div, query, scale_});
 
   auto key = DefineProcessInputPattern(input_k_, weight_k_, bias_k_, reshape_k_);
   MS_CHECK_TRUE_RET(!key.empty(), {});
@@ -246,6 +296,10 @@ AnfNodePtr MultiHeadAttentionFusion::Process(const std::string &pattern_name, co
   if (func_graph == nullptr || node == nullptr || equiv == nullptr) {
     return nullptr;
   }
+  if (!CheckPattern(pattern_name, equiv)) {
+    MS_LOG(INFO) << node->fullname_with_scope() << " doesn't compute the attention of the fused kernel, not fused.";
+    return nullptr;
+  }
   if (pattern_name == kMPAWithoutMaskPatternName) {
     return CreateMultiHeadAttentionNode(func_graph, equiv, node->fullname_with_scope());
   } else if (pattern_name == kMPAWithMaskPatternName) {
@@ -255,6 +309,32 @@ AnfNodePtr MultiHeadAttentionFusion::Process(const std::string &pattern_name, co
   }
 }
 
+bool MultiHeadAttentionFusion::CheckPattern(const std::string &pattern_name, const EquivPtr &equiv) const {
+  MS_ASSERT(equiv != nullptr);
+  if (pattern_name != kMPAWithMaskPatternName) {
+    // q, k and v are reshaped without a transpose in this pattern, so their heads are not the column slices of the
+    // projections that the kernel attends over.
+    return false;
+  }
+  if (!CheckMatMul(equiv, matmul_q_, false) || !CheckMatMul(equiv, matmul_k_, false) ||
+      !CheckMatMul(equiv, matmul_v_, false) || !CheckMatMul(equiv, matmul_o_, false) ||
+      !CheckMatMul(equiv, matmul_sv_, false)) {
+    return false;
+  }
+  if (!CheckPerm(equiv, perm_q_, kHeadPerm) || !CheckPerm(equiv, perm_v_, kHeadPerm) ||
+      !CheckPerm(equiv, perm_o_, kHeadPerm)) {
+    return false;
+  }
+  // k is transposed for q * k by the perm of k or by the matmul.
+  bool k_transposed = CheckPerm(equiv, perm_k_, kTransposedHeadPerm) && CheckMatMul(equiv, matmul_qk_, false);
+  bool qk_transposed = CheckPerm(equiv, perm_k_, kHeadPerm) && CheckMatMul(equiv, matmul_qk_, true);
+  if (!k_transposed && !qk_transposed) {
+    return false;
+  }
+  return CheckConstValue(equiv, mask_sub_value_, kMaskSubValue) &&
+         CheckConstValue(equiv, mask_mul_value_, kMaskMulValue);
+}
+
 CNodePtr MultiHeadAttentionFusion::CreateMultiHeadAttentionNode(const FuncGraphPtr &func_graph, const EquivPtr &equiv,
                                                                 const std::string &base_name) const {
   MS_ASSERT(func_graph != nullptr);
@@ -264,6 +344,13 @@ CNodePtr MultiHeadAttentionFusion::CreateMultiHeadAttentionNode(const FuncGraphP
     MS_LOG(ERROR) << "Build attention primitive failed.";
     return nullptr;
   }
+  // q is divided by the scale param before q * k.
+  float scale = 0.0f;
+  if (GetScaleParameterData(equiv, scale_, &scale) != RET_OK || scale == 0.0f) {
+    MS_LOG(ERROR) << "Get attention scale failed.";
+    return nullptr;
+  }
+  attention_prim->set_scale(1.0f / scale);
   auto attention_prim_c = attention_prim->GetPrim();
   MS_CHECK_TRUE_RET(attention_prim_c != nullptr, nullptr);
   auto value_node = NewValueNode(attention_prim_c);
@@ -349,6 +436,7 @@ std::shared_ptr<ops::Attention> MultiHeadAttentionFusion::BuildAttentionPrim(con
     MS_LOG(ERROR) << "Shape k or shape v is invalid.";
     return nullptr;
   }
+  attention_prim->Init(shape_k.at(shape_k.size() - kWeightShapeSize), shape_k.at(shape_k.size() - 1));
   return attention_prim;
 }
 
@@ -357,11 +445,18 @@ CNodePtr MultiHeadAttentionFusion::CreateMaskedMultiHeadAttentionNode(const Func
                                                                       const string &base_name) const {
   MS_ASSERT(func_graph != nullptr);
   MS_ASSERT(equiv != nullptr);
-  auto attention_prim = std::make_shared<ops::Attention>();
+  auto attention_prim = BuildAttentionPrim(equiv);
   if (attention_prim == nullptr) {
     MS_LOG(ERROR) << "Build attention primitive failed.";
     return nullptr;
   }
+  // q * k is multiplied by the scale param before the mask is added.
+  float scale = 0.0f;
+  if (GetScaleParameterData(equiv, scale_, &scale) != RET_OK) {
+    MS_LOG(ERROR) << "Get attention scale failed.";
+    return nullptr;
+  }
+  attention_prim->set_scale(scale);
   auto attention_prim_c = attention_prim->GetPrim();
   MS_CHECK_TRUE_RET(attention_prim_c != nullptr, nullptr);
   auto value_node = NewValueNode(attention_prim_c);
@@ -44,6 +44,10 @@ class MultiHeadAttentionFusion : public MultiplePatternProcessPass {
   // create multi-head-attention without mask
   virtual std::shared_ptr<ops::Attention> BuildAttentionPrim(const EquivPtr &equiv) const;
 
+  // check the matched graph computes what the attention kernel does: [in, out] weights, heads split by the
+  // transposes and the mask added as (1 - mask) * -10000.
+  bool CheckPattern(const std::string &pattern_name, const EquivPtr &equiv) const;
+
  private:
   // define patterns
   VectorRef DefineMPWithMaskPattern() const;
@@ -78,6 +82,20 @@ class MultiHeadAttentionFusion : public MultiplePatternProcessPass {
 
   mutable VarPtr reshape_k_{nullptr};
   mutable VarPtr reshape_v_{nullptr};
+  mutable VarPtr scale_{nullptr};
+
+  mutable VarPtr matmul_q_{nullptr};
+  mutable VarPtr matmul_k_{nullptr};
+  mutable VarPtr matmul_v_{nullptr};
+  mutable VarPtr matmul_o_{nullptr};
+  mutable VarPtr matmul_qk_{nullptr};
+  mutable VarPtr matmul_sv_{nullptr};
+  mutable VarPtr perm_q_{nullptr};
+  mutable VarPtr perm_k_{nullptr};
+  mutable VarPtr perm_v_{nullptr};
+  mutable VarPtr perm_o_{nullptr};
+  mutable VarPtr mask_sub_value_{nullptr};
+  mutable VarPtr mask_mul_value_{nullptr};
 };
 
 }  // namespace opt
@@ -1014,6 +1014,8 @@ def set_ps_context(**kwargs):
                                    supports Server disaster recovery currently. Default: ''.
         scheduler_manage_port (int): Scheduler manage port used to scale out/in. Default: 11202.
         enable_ssl (bool): Set PS SSL mode enabled or disabled. Default: False.
+        rpc_event_loop_num (int): The number of event loop threads of the rpc servers, the connections are sharded
+                                  among them. Default: 1.
         client_password (str): Password to decrypt the secret key stored in the client certificate. Default: ''.
         server_password (str): Password to decrypt the secret key stored in the server certificate. Default: ''.
 
@@ -85,6 +85,7 @@ _set_ps_context_func_map = {
     "equip_crl_path": ps_context().set_equip_crl_path,
     "replay_attack_time_diff": ps_context().set_replay_attack_time_diff,
     "enable_ssl": ps_context().set_enable_ssl,
+    "rpc_event_loop_num": ps_context().set_rpc_event_loop_num,
     "client_password": ps_context().set_client_password,
     "server_password": ps_context().set_server_password,
     "scheduler_manage_port": ps_context().set_scheduler_manage_port,
@@ -143,6 +144,7 @@ _get_ps_context_func_map = {
     "equip_crl_path": ps_context().equip_crl_path,
     "replay_attack_time_diff": ps_context().replay_attack_time_diff,
     "enable_ssl": ps_context().enable_ssl,
+    "rpc_event_loop_num": ps_context().rpc_event_loop_num,
     "client_password": ps_context().client_password,
     "server_password": ps_context().server_password,
     "scheduler_manage_port": ps_context().scheduler_manage_port,
@@ -166,7 +168,7 @@ _get_ps_context_func_map = {
 _check_positive_int_keys = ["server_num", "scheduler_port", "fl_server_port",
                             "start_fl_job_threshold", "start_fl_job_time_window", "update_model_time_window",
                             "fl_iteration_num", "client_epoch_num", "client_batch_size", "cipher_time_window",
-                            "reconstruct_secrets_threshold"]
+                            "reconstruct_secrets_threshold", "rpc_event_loop_num"]
 
 _check_non_negative_int_keys = ["worker_num"]
 
@@ -217,6 +219,8 @@ def _set_ps_context(**kwargs):
         config_file_path (string): Configuration file path used by recovery. Default: ''.
         scheduler_manage_port (int): scheduler manage port used to scale out/in. Default: 11202.
         enable_ssl (bool): Set PS SSL mode enabled or disabled. Default: False.
+        rpc_event_loop_num (int): The number of event loop threads of the rpc servers, the connections are sharded
+                                  among them. Default: 1.
         client_password (str): Password to decrypt the secret key stored in the client certificate. Default: ''.
         server_password (str): Password to decrypt the secret key stored in the server certificate. Default: ''.
 
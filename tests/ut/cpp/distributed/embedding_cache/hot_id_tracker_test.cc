@@ -0,0 +1,139 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+
+#include <vector>
+
+#include "distributed/embedding_cache/hot_id_tracker.h"
+#include "distributed/embedding_cache/embedding_hash_map.h"
+
+namespace mindspore {
+namespace distributed {
+class TestHotIdTracker : public UT::Common {
+ public:
+  TestHotIdTracker() = default;
+  virtual ~TestHotIdTracker() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: hot id replication of embedding cache.
+/// Description: record batches in which a few ids are accessed much more often than the others, then change the hot
+/// ids.
+/// Expectation: the most frequently accessed ids are selected at every rebalance interval, and the counts decay so the
+/// new hot ids replace the old ones.
+TEST_F(TestHotIdTracker, test_select_hot_ids) {
+  EXPECT_ANY_THROW(HotIdTracker(0, 1));
+  EXPECT_ANY_THROW(HotIdTracker(1, 0));
+
+  HotIdTracker tracker(2, 3);
+  std::vector<int> batch = {1, 1, 1, 2, 2, 3, 4, 5};
+  EXPECT_FALSE(tracker.Record(batch.data(), batch.size()));
+  EXPECT_FALSE(tracker.Record(batch.data(), batch.size()));
+  EXPECT_TRUE(tracker.Record(batch.data(), batch.size()));
+  EXPECT_EQ(tracker.hot_ids().size(), 2);
+  EXPECT_TRUE(tracker.IsHot(1));
+  EXPECT_TRUE(tracker.IsHot(2));
+  EXPECT_FALSE(tracker.IsHot(3));
+  EXPECT_DOUBLE_EQ(tracker.hot_access_ratio(), 0);
+
+  // Ids 6 and 7 become hot, and the hot access ratio of the last interval is counted with ids 1 and 2.
+  std::vector<int> new_batch = {6, 6, 6, 6, 7, 7, 7, 7, 1, 2};
+  for (size_t i = 0; i < 3; ++i) {
+    (void)tracker.Record(new_batch.data(), new_batch.size());
+  }
+  EXPECT_TRUE(tracker.IsHot(6));
+  EXPECT_TRUE(tracker.IsHot(7));
+  EXPECT_FALSE(tracker.IsHot(1));
+  EXPECT_DOUBLE_EQ(tracker.hot_access_ratio(), 0.2);
+
+  // The ids accessed only once are never hot, and their counts are dropped after decay.
+  HotIdTracker cold_tracker(4, 1);
+  std::vector<int> cold_batch = {10, 11, 12};
+  EXPECT_TRUE(cold_tracker.Record(cold_batch.data(), cold_batch.size()));
+  EXPECT_TRUE(cold_tracker.hot_ids().empty());
+  EXPECT_EQ(cold_tracker.tracked_id_num(), 0);
+}
+
+/// Feature: hot id replication of embedding cache.
+/// Description: pin a hot id in a full embedding hash map and insert other ids which need swapping.
+/// Expectation: the pinned id is never swapped out, and it can be swapped out after it is unpinned.
+TEST_F(TestHotIdTracker, test_pin_ids_in_hash_map) {
+  // The first and the last elements are reserved for the ids out of the local range.
+  const size_t capacity = 6;
+  const int id_num = 4;
+  EmbeddingHashMap hash_map(0, capacity);
+  std::vector<int> swap_out_index(capacity);
+  std::vector<int> swap_out_ids(capacity);
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  size_t step = 1;
+  for (int id = 0; id < id_num; ++id) {
+    EXPECT_NE(hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), step, 0, &swap_out_size,
+                                 &need_wait_graph),
+              INVALID_INDEX_VALUE);
+  }
+  EXPECT_EQ(swap_out_size, 0);
+
+  EXPECT_ANY_THROW(hash_map.PinIds({0, 1, 2, 3}));
+  hash_map.PinIds({0, 100});
+  EXPECT_EQ(hash_map.pinned_count(), 1);
+
+  // Insert the new ids after the graph runs the previous steps, so all the elements are expired except the pinned.
+  for (int id = 10; id < 16; ++id) {
+    hash_map.Reset();
+    ++step;
+    swap_out_size = 0;
+    EXPECT_NE(hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), step, step, &swap_out_size,
+                                 &need_wait_graph),
+              INVALID_INDEX_VALUE);
+    EXPECT_EQ(swap_out_size, 1);
+    EXPECT_NE(swap_out_ids[0], 0);
+  }
+  EXPECT_EQ(hash_map.hash_id_to_index().count(0), 1);
+
+  // The hot id 100 is pinned when it is inserted.
+  hash_map.Reset();
+  ++step;
+  swap_out_size = 0;
+  (void)hash_map.ParseData(100, swap_out_index.data(), swap_out_ids.data(), step, step, &swap_out_size,
+                           &need_wait_graph);
+  EXPECT_EQ(hash_map.pinned_count(), 2);
+
+  // The unpinned id 0 is swapped out as a normal expired element.
+  hash_map.PinIds({100});
+  EXPECT_EQ(hash_map.pinned_count(), 1);
+  bool swapped_out = false;
+  for (int id = 20; id < 24 && !swapped_out; ++id) {
+    hash_map.Reset();
+    ++step;
+    swap_out_size = 0;
+    (void)hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), step, step, &swap_out_size,
+                             &need_wait_graph);
+    ASSERT_EQ(swap_out_size, 1);
+    EXPECT_NE(swap_out_ids[0], 100);
+    swapped_out = swap_out_ids[0] == 0;
+  }
+  EXPECT_TRUE(swapped_out);
+  EXPECT_EQ(hash_map.hash_id_to_index().count(100), 1);
+  // The evictions of the unpinned elements keep the count of the pinned ones.
+  EXPECT_EQ(hash_map.pinned_count(), 1);
+  EXPECT_EQ(hash_map.pinned_ids().count(100), 1);
+}
+}  // namespace distributed
+}  // namespace mindspore
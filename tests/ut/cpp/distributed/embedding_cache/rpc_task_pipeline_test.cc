@@ -0,0 +1,161 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "distributed/embedding_cache/rpc_task_pipeline.h"
+
+namespace mindspore {
+namespace distributed {
+namespace {
+constexpr auto kBlockCheckTime = std::chrono::milliseconds(100);
+}  // namespace
+
+class TestRpcTaskPipeline : public UT::Common {
+ public:
+  TestRpcTaskPipeline() = default;
+  virtual ~TestRpcTaskPipeline() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: rpc task pipeline of embedding cache.
+/// Description: submit tasks with different run time to the pipeline, and wait for some of them.
+/// Expectation: the tasks run in the submitted order, and a task is finished after it is waited.
+TEST_F(TestRpcTaskPipeline, test_run_in_order) {
+  RpcTaskPipeline pipeline;
+  pipeline.Start(2);
+  EXPECT_EQ(pipeline.depth(), 2);
+  const size_t task_num = 10;
+  std::vector<size_t> run_order;
+  std::atomic<size_t> finished_num{0};
+  for (size_t i = 0; i < task_num; ++i) {
+    size_t task_id = 0;
+    EXPECT_TRUE(pipeline.SubmitTask(
+      [i, &run_order, &finished_num]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds((task_num - i) % 3));
+        run_order.push_back(i);
+        ++finished_num;
+        return true;
+      },
+      &task_id));
+    EXPECT_EQ(task_id, i + 1);
+  }
+  EXPECT_TRUE(pipeline.WaitTask(task_num / 2));
+  EXPECT_GE(finished_num.load(), task_num / 2);
+  EXPECT_TRUE(pipeline.WaitAllTasks());
+  ASSERT_EQ(run_order.size(), task_num);
+  for (size_t i = 0; i < task_num; ++i) {
+    EXPECT_EQ(run_order[i], i);
+  }
+  pipeline.Stop();
+}
+
+/// Feature: rpc task pipeline of embedding cache.
+/// Description: fill the pipeline with the tasks which don't finish, and submit one more task.
+/// Expectation: the submission blocks until a task in flight finishes.
+TEST_F(TestRpcTaskPipeline, test_block_at_depth) {
+  RpcTaskPipeline pipeline;
+  pipeline.Start(2);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  auto blocked_task = [released]() {
+    released.wait();
+    return true;
+  };
+  EXPECT_TRUE(pipeline.SubmitTask(blocked_task));
+  EXPECT_TRUE(pipeline.SubmitTask(blocked_task));
+
+  std::atomic<bool> submitted{false};
+  auto submit = std::async(std::launch::async, [&pipeline, &submitted]() {
+    bool ret = pipeline.SubmitTask([]() { return true; });
+    submitted = true;
+    return ret;
+  });
+  EXPECT_EQ(submit.wait_for(kBlockCheckTime), std::future_status::timeout);
+  EXPECT_FALSE(submitted.load());
+
+  release.set_value();
+  EXPECT_TRUE(submit.get());
+  EXPECT_TRUE(pipeline.WaitAllTasks());
+  pipeline.Stop();
+}
+
+/// Feature: rpc task pipeline of embedding cache.
+/// Description: a task fails while a waiter is blocked on a task behind it.
+/// Expectation: the waiter gets the failure, the tasks behind the failed one are dropped and no more task is accepted.
+TEST_F(TestRpcTaskPipeline, test_failed_task) {
+  RpcTaskPipeline pipeline;
+  pipeline.Start(4);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  EXPECT_TRUE(pipeline.SubmitTask([]() { return true; }));
+  EXPECT_TRUE(pipeline.SubmitTask([released]() {
+    released.wait();
+    return false;
+  }));
+  std::atomic<bool> dropped_task_run{false};
+  size_t task_id = 0;
+  EXPECT_TRUE(pipeline.SubmitTask(
+    [&dropped_task_run]() {
+      dropped_task_run = true;
+      return true;
+    },
+    &task_id));
+
+  auto wait = std::async(std::launch::async, [&pipeline, task_id]() { return pipeline.WaitTask(task_id); });
+  EXPECT_EQ(wait.wait_for(kBlockCheckTime), std::future_status::timeout);
+  release.set_value();
+  EXPECT_FALSE(wait.get());
+  EXPECT_FALSE(pipeline.WaitAllTasks());
+  EXPECT_FALSE(pipeline.SubmitTask([]() { return true; }));
+  pipeline.Stop();
+  EXPECT_FALSE(dropped_task_run.load());
+}
+
+/// Feature: rpc task pipeline of embedding cache.
+/// Description: submit tasks to the pipeline with a depth of 0.
+/// Expectation: the tasks run in place, and the failure is kept for the waiters.
+TEST_F(TestRpcTaskPipeline, test_run_in_place) {
+  RpcTaskPipeline pipeline;
+  pipeline.Start(0);
+  auto caller = std::this_thread::get_id();
+  bool in_place = false;
+  size_t task_id = 0;
+  EXPECT_TRUE(pipeline.SubmitTask(
+    [caller, &in_place]() {
+      in_place = std::this_thread::get_id() == caller;
+      return true;
+    },
+    &task_id));
+  EXPECT_TRUE(in_place);
+  EXPECT_EQ(task_id, 1);
+  EXPECT_TRUE(pipeline.WaitTask(task_id));
+
+  EXPECT_FALSE(pipeline.SubmitTask([]() { return false; }, &task_id));
+  EXPECT_EQ(task_id, 2);
+  EXPECT_FALSE(pipeline.WaitAllTasks());
+  pipeline.Stop();
+}
+}  // namespace distributed
+}  // namespace mindspore
@@ -20,9 +20,11 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <fstream>
 
 #include "distributed/persistent/data.h"
 #include "utils/file_utils.h"
+#include "utils/system/sha256.h"
 
 namespace mindspore {
 namespace distributed {
@@ -98,6 +100,146 @@ TEST_F(TestPersistStorage, test_embedding_storage) {
     EXPECT_EQ(data[i], embdding_table_data->at(i));
   }
 }
+/// Feature: incremental persistent storage of embedding table.
+/// Description: Take snapshots of the dirty rows, modify the table before persisting the snapshots, merge the delta
+/// files into the block files, and restore the table from a new storage after the last delta file is broken.
+/// Expectation: The restored table contains the rows in the snapshots, and the broken delta file is discarded.
+TEST_F(TestPersistStorage, test_incremental_embedding_storage) {
+  const int vocab = 100;
+  const int emb_dim = 4;
+  auto embedding_shape = std::make_shared<std::vector<int>>(std::vector<int>{vocab, emb_dim});
+  auto data_ptr = std::make_shared<std::vector<float>>(vocab * emb_dim, 0);
+  PersistentData<float> embedding_table(data_ptr, embedding_shape);
+
+  std::string storage_file_path = "./incremental_storage";
+  if (!distributed::storage::FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    distributed::storage::FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto ret = FileUtils::GetRealPath(storage_file_path.c_str());
+  ASSERT_TRUE(ret.has_value());
+  std::map<std::string, std::string> config_map;
+  config_map[distributed::storage::kFileStoragePath] = ret.value();
+  // Every block file contains 10 rows, and the delta files are merged once there are 3 of them.
+  config_map[distributed::storage::kMaxBlockLength] = std::to_string(10 * emb_dim * sizeof(float));
+  config_map[distributed::storage::kMaxDeltaNum] = "3";
+  embedding_table.Initialize(config_map);
+  EXPECT_NO_THROW(embedding_table.Persist(distributed::storage::DirtyInfo()));
+
+  // The expected table after restoring.
+  std::vector<float> expected(vocab * emb_dim, 0);
+  auto update_row = [&](int row, float value, bool persisted) {
+    for (int i = 0; i < emb_dim; ++i) {
+      embedding_table.data()[row * emb_dim + i] = value;
+      if (persisted) {
+        expected[row * emb_dim + i] = value;
+      }
+    }
+  };
+  for (int step = 1; step <= 4; ++step) {
+    distributed::storage::DirtyInfo dirty_info = {step * 20, 3, step * 20, 3 + step};
+    for (const auto &row : dirty_info) {
+      update_row(row, step, true);
+    }
+    auto snapshot = embedding_table.TakeSnapshot(dirty_info);
+    EXPECT_EQ(3, snapshot->rows.size());
+    // The modification after taking snapshot is not persisted.
+    update_row(step * 20, -1, false);
+    EXPECT_NO_THROW(embedding_table.PersistSnapshot(snapshot));
+    update_row(step * 20, step, false);
+  }
+
+  // The first 3 delta files have been merged into block files, and the last one is broken.
+  std::string last_delta_meta = ret.value() + "/" + distributed::storage::kDeltaMetaFilePrefix + "3.json";
+  EXPECT_TRUE(distributed::storage::FileIOUtils::IsFileOrDirExist(last_delta_meta));
+  {
+    std::ofstream broken_file(last_delta_meta);
+    broken_file << "{\"row_num\":";
+  }
+  auto first_delta_meta = ret.value() + "/" + distributed::storage::kDeltaMetaFilePrefix + "2.json";
+  EXPECT_FALSE(distributed::storage::FileIOUtils::IsFileOrDirExist(first_delta_meta));
+
+  auto restored_ptr = std::make_shared<std::vector<float>>(vocab * emb_dim, 0);
+  PersistentData<float> restored_table(restored_ptr, embedding_shape);
+  restored_table.Initialize(config_map);
+  EXPECT_NO_THROW(restored_table.Restore());
+  for (int row = 0; row < vocab; ++row) {
+    // The rows of the last step are in the broken delta file.
+    float value = (row == 80 || row == 7) ? 0 : (row == 3 ? 3 : expected[row * emb_dim]);
+    for (int i = 0; i < emb_dim; ++i) {
+      EXPECT_EQ(value, restored_ptr->at(row * emb_dim + i)) << "row " << row;
+    }
+  }
+  EXPECT_FALSE(distributed::storage::FileIOUtils::IsFileOrDirExist(last_delta_meta));
+
+  // The incremental persisting goes on after restoring.
+  update_row(7, 7, true);
+  EXPECT_NO_THROW(restored_table.PersistSnapshot(embedding_table.TakeSnapshot({7})));
+  PersistentData<float> final_table(std::make_shared<std::vector<float>>(vocab * emb_dim, 0), embedding_shape);
+  final_table.Initialize(config_map);
+  EXPECT_NO_THROW(final_table.Restore());
+  EXPECT_EQ(7, final_table.data()[7 * emb_dim]);
+  EXPECT_EQ(3, final_table.data()[3 * emb_dim]);
+  EXPECT_EQ(3, final_table.data()[60 * emb_dim]);
+}
+
+/// Feature: crash safety of merging the delta files into the block files.
+/// Description: Leave the block file and its meta in the states between the steps of replacing the block file, and
+/// restore the table with the delta files which are not removed yet.
+/// Expectation: Both the old and the new block file are accepted with the pending hash sequence, and a block file
+/// matching neither hash sequence is rejected.
+TEST_F(TestPersistStorage, test_merge_delta_files_crash_safety) {
+  const int vocab = 20;
+  const int emb_dim = 4;
+  auto embedding_shape = std::make_shared<std::vector<int>>(std::vector<int>{vocab, emb_dim});
+  PersistentData<float> embedding_table(std::make_shared<std::vector<float>>(vocab * emb_dim, 0), embedding_shape);
+
+  std::string storage_file_path = "./merge_crash_storage";
+  if (!distributed::storage::FileIOUtils::IsFileOrDirExist(storage_file_path)) {
+    distributed::storage::FileIOUtils::CreateDir(storage_file_path);
+  }
+  auto ret = FileUtils::GetRealPath(storage_file_path.c_str());
+  ASSERT_TRUE(ret.has_value());
+  std::map<std::string, std::string> config_map;
+  config_map[distributed::storage::kFileStoragePath] = ret.value();
+  config_map[distributed::storage::kMaxBlockLength] = std::to_string(10 * emb_dim * sizeof(float));
+  embedding_table.Initialize(config_map);
+  EXPECT_NO_THROW(embedding_table.Persist(distributed::storage::DirtyInfo()));
+  for (int i = 0; i < emb_dim; ++i) {
+    embedding_table.data()[3 * emb_dim + i] = 3;
+  }
+  EXPECT_NO_THROW(embedding_table.PersistSnapshot(embedding_table.TakeSnapshot({3})));
+
+  // The new block file merging the delta file, and the block meta with its pending hash sequence.
+  std::string block_file = ret.value() + "/" + distributed::storage::kBlockFilePrefix + "0";
+  std::string new_block_file = ret.value() + "/" + distributed::storage::kTmpFilePrefix +
+                               distributed::storage::kBlockFilePrefix + "0";
+  ASSERT_TRUE(distributed::storage::FileIOUtils::Write(
+    new_block_file, {std::make_pair(embedding_table.data(), 10 * emb_dim * sizeof(float))}));
+  distributed::storage::BlockMeta block_meta(ret.value() + "/" + distributed::storage::kBlockMetaFilePrefix + "0" +
+                                             distributed::storage::kJsonSuffix);
+  ASSERT_TRUE(block_meta.Initialize());
+  block_meta.Insert(distributed::storage::kPendingHashSeq, system::sha256::GetHashFromFile(new_block_file), true);
+
+  auto check_restore = [&]() {
+    PersistentData<float> restored_table(std::make_shared<std::vector<float>>(vocab * emb_dim, 0), embedding_shape);
+    restored_table.Initialize(config_map);
+    EXPECT_NO_THROW(restored_table.Restore());
+    for (int row = 0; row < vocab; ++row) {
+      EXPECT_EQ(row == 3 ? 3 : 0, restored_table.data()[row * emb_dim]) << "row " << row;
+    }
+  };
+  // The process exits before renaming the new block file.
+  check_restore();
+  // The process exits after renaming the new block file.
+  ASSERT_EQ(0, rename(new_block_file.c_str(), block_file.c_str()));
+  check_restore();
+
+  float broken_data = 1;
+  ASSERT_TRUE(distributed::storage::FileIOUtils::Write(block_file, {std::make_pair(&broken_data, sizeof(float))}));
+  PersistentData<float> broken_table(std::make_shared<std::vector<float>>(vocab * emb_dim, 0), embedding_shape);
+  broken_table.Initialize(config_map);
+  EXPECT_ANY_THROW(broken_table.Restore());
+}
 }  // namespace persistent
 }  // namespace distributed
 }  // namespace mindspore
@@ -17,9 +17,11 @@
 #include <sys/resource.h>
 #include <sys/types.h>
 #include <dirent.h>
+#include <algorithm>
 #include <atomic>
 #include <string>
 #include <thread>
+#include <vector>
 #include <csignal>
 
 #include <gtest/gtest.h>
@@ -328,6 +330,164 @@ TEST_F(TCPTest, SendLargeMessages) {
   server->Finalize();
 }
 
+/// Feature: test send gather messages.
+/// Description: send messages whose bodies are gathered from copied and external buffers, and receive the bodies into
+/// buffers allocated by the server.
+/// Expectation: the bodies are received intact and the external buffers are released after being sent.
+TEST_F(TCPTest, SendGatherMessages) {
+  Init();
+
+  class RecvBufferMessage : public MessageBase {
+   public:
+    explicit RecvBufferMessage(size_t size) : buffer_(size) {
+      data = buffer_.data();
+      this->size = size;
+    }
+    ~RecvBufferMessage() override = default;
+
+   private:
+    std::vector<char> buffer_;
+  };
+
+  const std::string header = "header";
+  std::vector<size_t> data_sizes = {1024, 64 << 10, 4 << 20};
+  std::atomic<size_t> matched_num(0);
+  std::atomic<size_t> allocated_num(0);
+
+  // Start the tcp server.
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize();
+  ASSERT_TRUE(ret);
+
+  server->SetMessageAllocator([&allocated_num](size_t body_size) -> MessageBase * {
+    ++allocated_num;
+    return new RecvBufferMessage(body_size);
+  });
+  server->SetMessageHandler([&](MessageBase *const message) -> MessageBase *const {
+    auto data = static_cast<const char *>(message->data);
+    bool matched = message->body.empty() && message->size > header.size() &&
+                   std::string(data, header.size()) == header &&
+                   std::all_of(data + header.size(), data + message->size, [](char c) { return c == 'G'; });
+    if (matched) {
+      ++matched_num;
+    }
+    delete message;
+    IncrDataMsgNum(1);
+    return NULL_MSG;
+  });
+
+  // Start the tcp client.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+
+  auto ip = server->GetIP();
+  auto port = server->GetPort();
+  auto server_url = ip + ":" + std::to_string(port);
+  client->Connect(server_url);
+
+  // Send the messages, the data is split into two external pieces.
+  std::vector<std::string> datas;
+  for (size_t data_size : data_sizes) {
+    datas.emplace_back(data_size, 'G');
+  }
+  std::atomic<size_t> released_num(0);
+  for (const auto &data : datas) {
+    auto message = std::make_unique<GatherMessage>();
+    message->name = "testname";
+    message->from = AID("client", client_url);
+    message->to = AID("server", server_url);
+    message->Append(header.data(), header.size());
+    size_t half = data.size() / 2;
+    message->AppendExternal(data.data(), half);
+    message->AppendExternal(data.data() + half, data.size() - half, [&released_num]() { ++released_num; });
+    EXPECT_EQ(message->body_size(), header.size() + data.size());
+    client->SendAsync(std::move(message));
+  }
+
+  // Wait timeout: 15s
+  WaitForDataMsg(data_sizes.size(), 15);
+
+  // Check result
+  EXPECT_EQ(data_sizes.size(), GetDataMsgNum());
+  EXPECT_EQ(data_sizes.size(), matched_num.load());
+  EXPECT_EQ(data_sizes.size(), allocated_num.load());
+  EXPECT_EQ(data_sizes.size(), released_num.load());
+
+  // Destroy
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
+/// Feature: test the tcp server with multiple event loops.
+/// Description: start a tcp server whose connections are sharded among 4 event loops and send messages from 16 clients.
+/// Expectation: all the messages are received and the connections are handled by more than one event loop.
+TEST_F(TCPTest, SendMessagesToShardedServer) {
+  const size_t event_loop_num = 4;
+  const size_t client_num = 16;
+  const size_t msg_num_per_client = 10;
+  std::atomic<size_t> recv_msg_num(0);
+
+  // Start the tcp server.
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>(false, event_loop_num);
+  bool ret = server->Initialize();
+  ASSERT_TRUE(ret);
+  server->SetMessageHandler([&recv_msg_num](MessageBase *const message) -> MessageBase *const {
+    delete message;
+    ++recv_msg_num;
+    return NULL_MSG;
+  });
+  auto server_url = server->GetIP() + ":" + std::to_string(server->GetPort());
+
+  // Start the tcp clients and send the messages.
+  std::vector<std::unique_ptr<TCPClient>> clients;
+  for (size_t i = 0; i < client_num; ++i) {
+    auto client = std::make_unique<TCPClient>();
+    ASSERT_TRUE(client->Initialize());
+    ASSERT_TRUE(client->Connect(server_url));
+    clients.push_back(std::move(client));
+  }
+  auto client_url = "127.0.0.1:1234";
+  for (size_t i = 0; i < msg_num_per_client; ++i) {
+    for (auto &client : clients) {
+      client->SendAsync(CreateMessage(server_url, client_url));
+    }
+  }
+
+  // Wait timeout: 15s
+  size_t expected_msg_num = client_num * msg_num_per_client;
+  size_t retry = 150;
+  while (recv_msg_num.load() < expected_msg_num && retry-- > 0) {
+    usleep(100000);
+  }
+  EXPECT_EQ(expected_msg_num, recv_msg_num.load());
+
+  // Check the metrics, every event loop monitors its task queue fd and the first one monitors the server socket too.
+  std::vector<EventLoopMetrics> recv_metrics;
+  std::vector<EventLoopMetrics> send_metrics;
+  server->GetEventLoopMetrics(&recv_metrics, &send_metrics);
+  ASSERT_EQ(event_loop_num, recv_metrics.size());
+  ASSERT_EQ(event_loop_num, send_metrics.size());
+  size_t conn_num = 0;
+  size_t busy_loop_num = 0;
+  for (size_t i = 0; i < event_loop_num; ++i) {
+    size_t loop_conn_num = recv_metrics[i].fd_num - (i == 0 ? 2 : 1);
+    conn_num += loop_conn_num;
+    busy_loop_num += loop_conn_num > 0 ? 1 : 0;
+  }
+  EXPECT_EQ(client_num, conn_num);
+  EXPECT_GT(busy_loop_num, 1);
+
+  // Destroy
+  for (auto &client : clients) {
+    client->Disconnect(server_url);
+    client->Finalize();
+  }
+  server->Finalize();
+}
+
 /// Feature: test delete invalid tcp connection used in connection pool in tcp client when some socket error happened.
 /// Description: start a socket server and tcp client pair and stop the tcp server.
 /// Expectation: the connection from the tcp client to the tcp server will be deleted automatically.
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <unordered_map>
 #include <vector>
 #include "common/common_test.h"
 #define private public
@@ -75,5 +76,43 @@ TEST_F(UniqueCpuKernelTest, compute_test) {
   EXPECT_TRUE(y_ == expect_y);
   EXPECT_TRUE(idx_ == expect_idx);
 }
+
+// large unsorted inputs are deduplicated by hash partitions, keys keep their first occurrence order.
+TEST_F(UniqueCpuKernelTest, hash_partition_test) {
+  const size_t input_size = 200000;
+  unique_->input_size_ = input_size;
+  unique_->sorted_ = false;
+  x_.resize(input_size);
+  for (size_t i = 0; i < input_size; ++i) {
+    x_[i] = static_cast<float>((i * 7919) % 4099) - 2000.0f;
+  }
+  y_.assign(input_size, 0);
+  idx_.assign(input_size, 0);
+  std::vector<int64_t> workspace0(input_size);
+  std::vector<int64_t> workspace1(input_size);
+  std::vector<int64_t> workspace2(input_size);
+  inputs_.push_back(CreateKernelAddress(x_.data()));
+  outputs_.push_back(CreateKernelAddress(y_.data()));
+  outputs_.push_back(CreateKernelAddress(idx_.data()));
+  workspace_.push_back(CreateKernelAddress(workspace0.data()));
+  workspace_.push_back(CreateKernelAddress(workspace1.data()));
+  workspace_.push_back(CreateKernelAddress(workspace2.data()));
+  unique_->LaunchKernel<float, int>(inputs_, workspace_, outputs_);
+
+  std::vector<float> expect_y;
+  std::vector<int> expect_idx(input_size);
+  std::unordered_map<float, int> first;
+  for (size_t i = 0; i < input_size; ++i) {
+    auto it = first.emplace(x_[i], static_cast<int>(expect_y.size()));
+    if (it.second) {
+      expect_y.push_back(x_[i]);
+    }
+    expect_idx[i] = it.first->second;
+  }
+  EXPECT_EQ(unique_->output_size_, expect_y.size());
+  y_.resize(unique_->output_size_);
+  EXPECT_TRUE(y_ == expect_y);
+  EXPECT_TRUE(idx_ == expect_idx);
+}
 }  // namespace kernel
 }  // namespace mindspore
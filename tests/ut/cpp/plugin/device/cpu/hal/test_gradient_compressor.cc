@@ -0,0 +1,190 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "plugin/device/cpu/hal/hardware/gradient_compressor.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestGradientCompressor : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  std::vector<float> RandomGradients(size_t count) {
+    std::mt19937 gen(0);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::vector<float> grads(count);
+    for (auto &grad : grads) {
+      grad = dist(gen);
+    }
+    return grads;
+  }
+};
+
+/// Feature: gradient compression of cpu collective communication.
+/// Description: create the compressors by the type names.
+/// Expectation: no compressor is created for none, and an exception is thrown for the invalid type.
+TEST_F(TestGradientCompressor, CreateCompressor) {
+  EXPECT_EQ(nullptr, GradientCompressor::Create(""));
+  EXPECT_EQ(nullptr, GradientCompressor::Create(kGradientCompressionNone));
+  EXPECT_NE(nullptr, GradientCompressor::Create(kGradientCompressionFp16));
+  EXPECT_NE(nullptr, GradientCompressor::Create(kGradientCompressionBf16));
+  EXPECT_NE(nullptr, GradientCompressor::Create(kGradientCompressionTopK, 0.1));
+  EXPECT_NE(nullptr, GradientCompressor::Create(kGradientCompressionOneBit));
+  EXPECT_ANY_THROW(GradientCompressor::Create("int4"));
+  EXPECT_ANY_THROW(GradientCompressor::Create(kGradientCompressionTopK, 0));
+}
+
+/// Feature: gradient compression of cpu collective communication.
+/// Description: compress the gradients to fp16 and bf16, and decompress them.
+/// Expectation: the data size is halved and the relative error is within the precision of the type.
+TEST_F(TestGradientCompressor, CastCompression) {
+  const size_t count = 1000;
+  auto grads = RandomGradients(count);
+  std::vector<std::pair<std::string, float>> types = {{kGradientCompressionFp16, 1e-3},
+                                                      {kGradientCompressionBf16, 1e-2}};
+  for (const auto &type : types) {
+    auto compressor = GradientCompressor::Create(type.first);
+    ASSERT_TRUE(compressor->elementwise());
+    ASSERT_EQ(count * sizeof(float) / 2, compressor->CompressedSize(count));
+    std::vector<uint8_t> compressed(compressor->CompressedSize(count));
+    ASSERT_TRUE(compressor->Compress(grads.data(), count, compressed.data(), compressed.size()));
+
+    std::vector<float> output(count, 1.0);
+    ASSERT_TRUE(compressor->Decompress(compressed.data(), compressed.size(), count, output.data()));
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(grads[i], output[i], std::fabs(grads[i]) * type.second) << type.first;
+    }
+    ASSERT_TRUE(compressor->DecompressAdd(compressed.data(), compressed.size(), count, output.data()));
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_NEAR(2 * grads[i], output[i], std::fabs(grads[i]) * 2 * type.second) << type.first;
+    }
+    // The size of the compressed data is checked.
+    EXPECT_FALSE(compressor->Decompress(compressed.data(), compressed.size() - 1, count, output.data()));
+  }
+}
+
+/// Feature: gradient compression of cpu collective communication.
+/// Description: compress the gradients by top-k sparsification.
+/// Expectation: only the elements with the largest magnitudes are kept.
+TEST_F(TestGradientCompressor, TopKCompression) {
+  const size_t count = 100;
+  std::vector<float> grads(count, 0.5);
+  grads[3] = -10;
+  grads[42] = 20;
+  grads[97] = 5;
+  auto compressor = GradientCompressor::Create(kGradientCompressionTopK, 0.03);
+  ASSERT_FALSE(compressor->elementwise());
+  std::vector<uint8_t> compressed(compressor->CompressedSize(count));
+  ASSERT_EQ(3 * (sizeof(uint32_t) + sizeof(float)), compressed.size());
+  ASSERT_TRUE(compressor->Compress(grads.data(), count, compressed.data(), compressed.size()));
+
+  std::vector<float> output(count);
+  ASSERT_TRUE(compressor->Decompress(compressed.data(), compressed.size(), count, output.data()));
+  for (size_t i = 0; i < count; ++i) {
+    float expected = (i == 3 || i == 42 || i == 97) ? grads[i] : 0;
+    EXPECT_EQ(expected, output[i]);
+  }
+}
+
+/// Feature: gradient compression of cpu collective communication.
+/// Description: compress the same gradients repeatedly with error feedback by top-k and 1-bit compression.
+/// Expectation: the average of the decompressed gradients is close to the gradients.
+TEST_F(TestGradientCompressor, ErrorFeedback) {
+  const size_t count = 1000;
+  const size_t steps = 500;
+  auto grads = RandomGradients(count);
+  for (const auto &type : {kGradientCompressionTopK, kGradientCompressionOneBit}) {
+    auto compressor = GradientCompressor::Create(type, 0.05);
+    std::vector<uint8_t> compressed(compressor->CompressedSize(count));
+    std::vector<float> sum(count);
+    for (size_t step = 0; step < steps; ++step) {
+      ASSERT_TRUE(
+        compressor->CompressWithErrorFeedback("grads", grads.data(), count, compressed.data(), compressed.size()));
+      ASSERT_TRUE(compressor->DecompressAdd(compressed.data(), compressed.size(), count, sum.data()));
+    }
+    float error = 0;
+    float norm = 0;
+    for (size_t i = 0; i < count; ++i) {
+      error += (sum[i] / steps - grads[i]) * (sum[i] / steps - grads[i]);
+      norm += grads[i] * grads[i];
+    }
+    EXPECT_LT(std::sqrt(error / norm), 0.05) << type;
+  }
+}
+
+/// Feature: gradient compression of cpu collective communication.
+/// Description: compress the gradients of different names in the same buffer and from several threads with error
+/// feedback, and change the element number of them.
+/// Expectation: the compression error is kept per name, and dropped when the element number changes.
+TEST_F(TestGradientCompressor, ErrorFeedbackByName) {
+  const size_t count = 100;
+  std::vector<float> grads(count, 0.5);
+  grads[0] = 10;
+  auto compressor = GradientCompressor::Create(kGradientCompressionTopK, 0.01);
+  std::vector<uint8_t> compressed(compressor->CompressedSize(count));
+  std::vector<float> output(count);
+
+  // The first compression drops the small elements of both names, although they are in the same buffer.
+  for (const auto &name : {"grads_a", "grads_b"}) {
+    ASSERT_TRUE(compressor->CompressWithErrorFeedback(name, grads.data(), count, compressed.data(), compressed.size()));
+    ASSERT_TRUE(compressor->Decompress(compressed.data(), compressed.size(), count, output.data()));
+    EXPECT_EQ(10, output[0]);
+    EXPECT_EQ(0, output[1]);
+  }
+  // The error of 'grads_a' is fed back, the element 1 is 0.5 + 0.5 now and still less than 10.
+  grads[0] = 0;
+  ASSERT_TRUE(compressor->CompressWithErrorFeedback("grads_a", grads.data(), count, compressed.data(),
+                                                    compressed.size()));
+  ASSERT_TRUE(compressor->Decompress(compressed.data(), compressed.size(), count, output.data()));
+  EXPECT_EQ(1, *std::max_element(output.begin(), output.end()));
+
+  // The error of 'grads_b' is dropped as the element number changes.
+  const size_t new_count = count / 2;
+  std::vector<uint8_t> new_compressed(compressor->CompressedSize(new_count));
+  ASSERT_TRUE(compressor->CompressWithErrorFeedback("grads_b", grads.data(), new_count, new_compressed.data(),
+                                                    new_compressed.size()));
+  ASSERT_TRUE(compressor->Decompress(new_compressed.data(), new_compressed.size(), new_count, output.data()));
+  EXPECT_EQ(0.5, *std::max_element(output.begin(), output.begin() + new_count));
+
+  // The gradients of different names are compressed concurrently.
+  const size_t thread_num = 4;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&compressor, &grads, i]() {
+      std::vector<uint8_t> thread_compressed(compressor->CompressedSize(count));
+      for (size_t step = 0; step < 100; ++step) {
+        EXPECT_TRUE(compressor->CompressWithErrorFeedback("grads_" + std::to_string(i), grads.data(), count,
+                                                          thread_compressed.data(), thread_compressed.size()));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,276 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <gtest/gtest.h>
+#include "distributed/cluster/topology/compute_graph_node.h"
+#include "distributed/cluster/topology/meta_server_node.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_topo.h"
+#include "plugin/device/cpu/hal/hardware/ms_collective_ops_impl.h"
+#include "utils/ms_utils.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using distributed::cluster::topology::ComputeGraphNode;
+using distributed::cluster::topology::MetaServerNode;
+using distributed::cluster::topology::TopoState;
+
+class TestMSCollectiveOpsImpl : public UT::Common {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  // Build the cluster of 'node_num' ranks in this process.
+  void InitCluster(size_t node_num, const std::string &port) {
+    common::SetEnv(distributed::cluster::topology::kEnvMetaServerHost, "127.0.0.1");
+    common::SetEnv(distributed::cluster::topology::kEnvMetaServerPort, port.c_str());
+    msn_ = std::make_shared<MetaServerNode>("meta_server_node", "scheduler", node_num);
+    ASSERT_TRUE(msn_->Initialize());
+    for (size_t i = 0; i < node_num; ++i) {
+      auto cgn = std::make_shared<ComputeGraphNode>("compute_graph_node_" + std::to_string(i + 1), "worker");
+      ASSERT_TRUE(cgn->Initialize());
+      cgns_.push_back(cgn);
+    }
+    size_t retry = 30;
+    while ((msn_->GetAliveNodeNum() != node_num || msn_->TopologyState() != TopoState::kInitialized) &&
+           (retry-- > 0)) {
+      sleep(1);
+    }
+    ASSERT_EQ(TopoState::kInitialized, msn_->TopologyState());
+
+    for (size_t i = 0; i < node_num; ++i) {
+      auto node = std::make_shared<TopologyNode>(node_num, cgns_[i]);
+      (void)node->Initialize();
+      topo_nodes_.push_back(node);
+    }
+    for (size_t i = 0; i < node_num; ++i) {
+      ASSERT_TRUE(topo_nodes_[i]->Initialized());
+      ops_.push_back(std::make_shared<MSCollectiveOpsImpl>(topo_nodes_[i]));
+    }
+  }
+
+  void FinalizeCluster() {
+    ops_.clear();
+    for (auto &node : topo_nodes_) {
+      (void)node->Finalize();
+    }
+    for (auto &cgn : cgns_) {
+      (void)cgn->Finalize();
+    }
+    size_t retry = 30;
+    while ((msn_->GetAliveNodeNum() > 0 || msn_->TopologyState() != TopoState::kFinished) && retry-- > 0) {
+      sleep(1);
+    }
+    (void)msn_->Finalize();
+    topo_nodes_.clear();
+    cgns_.clear();
+    msn_ = nullptr;
+  }
+
+  // Run the function on every rank concurrently, and return whether all of them succeed.
+  bool RunOnAllRanks(const std::function<bool(size_t)> &func) {
+    std::vector<std::thread> threads;
+    std::vector<char> results(ops_.size(), 0);
+    for (size_t i = 0; i < ops_.size(); ++i) {
+      threads.emplace_back([&func, &results, i]() { results[i] = func(i) ? 1 : 0; });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    return std::all_of(results.begin(), results.end(), [](char result) { return result != 0; });
+  }
+
+  // Check the AllReduce results of every algorithm in the cluster.
+  void CheckAllReduce() {
+    const std::vector<AllReduceAlgo> algos = {AllReduceAlgo::kRing, AllReduceAlgo::kRecursiveDoubling,
+                                              AllReduceAlgo::kHalvingDoubling, AllReduceAlgo::kHierarchical,
+                                              AllReduceAlgo::kAuto};
+    const std::vector<size_t> counts = {1, 3, 17, 1000, 70000};
+    size_t rank_size = ops_.size();
+    for (auto algo : algos) {
+      for (auto count : counts) {
+        std::vector<std::vector<int>> buffs(rank_size);
+        auto ret = RunOnAllRanks([&](size_t rank) {
+          ops_[rank]->set_allreduce_algo(algo);
+          std::vector<int> input(count);
+          for (size_t i = 0; i < count; ++i) {
+            input[i] = SizeToInt(rank * count + i);
+          }
+          buffs[rank].resize(count);
+          return ops_[rank]->AllReduce<int>("test", input.data(), buffs[rank].data(), count);
+        });
+        ASSERT_TRUE(ret) << "algorithm: " << static_cast<int>(algo) << ", count: " << count;
+        for (size_t rank = 0; rank < rank_size; ++rank) {
+          for (size_t i = 0; i < count; ++i) {
+            int expected = SizeToInt(count * rank_size * (rank_size - 1) / 2 + rank_size * i);
+            ASSERT_EQ(expected, buffs[rank][i]) << "algorithm: " << static_cast<int>(algo) << ", count: " << count;
+          }
+        }
+      }
+    }
+  }
+
+  std::shared_ptr<MetaServerNode> msn_;
+  std::vector<std::shared_ptr<ComputeGraphNode>> cgns_;
+  std::vector<std::shared_ptr<TopologyNode>> topo_nodes_;
+  std::vector<std::shared_ptr<MSCollectiveOpsImpl>> ops_;
+};
+
+/// Feature: cpu collective AllReduce algorithms.
+/// Description: run every AllReduce algorithm among 5 ranks, the number of which is not a power of two.
+/// Expectation: every rank gets the sum of the data of all the ranks.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceWithNonPowerOfTwoRanks) {
+  InitCluster(5, "8091");
+  CheckAllReduce();
+  FinalizeCluster();
+}
+
+/// Feature: cpu collective AllReduce algorithms.
+/// Description: run every AllReduce algorithm among 4 ranks.
+/// Expectation: every rank gets the sum of the data of all the ranks.
+TEST_F(TestMSCollectiveOpsImpl, AllReduceWithPowerOfTwoRanks) {
+  InitCluster(4, "8092");
+  CheckAllReduce();
+  FinalizeCluster();
+}
+
+/// Feature: cpu collective ReduceScatter and AllToAll.
+/// Description: run ReduceScatter and AllToAll among 3 ranks.
+/// Expectation: every rank gets the sum of its own chunk and the chunks sent to it.
+TEST_F(TestMSCollectiveOpsImpl, ReduceScatterAndAllToAll) {
+  InitCluster(3, "8093");
+  size_t rank_size = ops_.size();
+  const size_t count = 1001;
+
+  std::vector<std::vector<float>> outputs(rank_size);
+  auto ret = RunOnAllRanks([&](size_t rank) {
+    std::vector<float> input(count * rank_size);
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<float>(rank + i);
+    }
+    outputs[rank].resize(count);
+    return ops_[rank]->ReduceScatter<float>(input.data(), outputs[rank].data(), count);
+  });
+  ASSERT_TRUE(ret);
+  for (size_t rank = 0; rank < rank_size; ++rank) {
+    for (size_t i = 0; i < count; ++i) {
+      float expected = static_cast<float>(rank_size * (rank * count + i) + rank_size * (rank_size - 1) / 2);
+      ASSERT_FLOAT_EQ(expected, outputs[rank][i]);
+    }
+  }
+
+  // The i-th element of the j-th chunk sent by rank r is 'r * 10000 + j * 100 + i'.
+  const size_t chunk_count = 7;
+  ret = RunOnAllRanks([&](size_t rank) {
+    std::vector<int> input(chunk_count * rank_size);
+    for (size_t j = 0; j < rank_size; ++j) {
+      for (size_t i = 0; i < chunk_count; ++i) {
+        input[j * chunk_count + i] = SizeToInt(rank * 10000 + j * 100 + i);
+      }
+    }
+    std::vector<int> output(chunk_count * rank_size);
+    if (!ops_[rank]->AllToAll<int>(input.data(), output.data(), chunk_count)) {
+      return false;
+    }
+    for (size_t j = 0; j < rank_size; ++j) {
+      for (size_t i = 0; i < chunk_count; ++i) {
+        if (output[j * chunk_count + i] != SizeToInt(j * 10000 + rank * 100 + i)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  });
+  ASSERT_TRUE(ret);
+  FinalizeCluster();
+}
+
+/// Feature: cpu collective AllReduce benchmark.
+/// Description: run AllReduce of every algorithm among 8 processes on the loopback and print the time cost.
+/// Expectation: the time cost of every algorithm and data size is printed.
+TEST_F(TestMSCollectiveOpsImpl, DISABLED_AllReduceBenchmark) {
+  const size_t rank_size = 8;
+  const size_t repeat = 10;
+  const std::vector<size_t> sizes = {1 << 10, 16 << 10, 256 << 10, 4 << 20, 32 << 20};
+  const std::vector<AllReduceAlgo> algos = {AllReduceAlgo::kRing, AllReduceAlgo::kRecursiveDoubling,
+                                            AllReduceAlgo::kHalvingDoubling, AllReduceAlgo::kAuto};
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerHost, "127.0.0.1");
+  common::SetEnv(distributed::cluster::topology::kEnvMetaServerPort, "8094");
+  MetaServerNode msn("meta_server_node", "scheduler", rank_size);
+  ASSERT_TRUE(msn.Initialize());
+
+  std::vector<pid_t> pids;
+  for (size_t rank = 0; rank < rank_size; ++rank) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid > 0) {
+      pids.push_back(pid);
+      continue;
+    }
+    auto cgn = std::make_shared<ComputeGraphNode>("compute_graph_node_" + std::to_string(rank + 1), "worker");
+    if (!cgn->Initialize()) {
+      _exit(1);
+    }
+    size_t retry = 30;
+    while (!cgn->Initialized() && retry-- > 0) {
+      sleep(1);
+    }
+    auto node = std::make_shared<TopologyNode>(rank_size, cgn);
+    (void)node->Initialize();
+    if (!node->Initialized()) {
+      _exit(1);
+    }
+    MSCollectiveOpsImpl ops(node);
+    for (auto size : sizes) {
+      std::vector<float> buff(size / sizeof(float), 1.0);
+      for (auto algo : algos) {
+        ops.set_allreduce_algo(algo);
+        // Warm up the connections.
+        (void)ops.AllReduce<float>("benchmark", buff.data(), buff.data(), buff.size());
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < repeat; ++i) {
+          if (!ops.AllReduce<float>("benchmark", buff.data(), buff.data(), buff.size())) {
+            _exit(1);
+          }
+        }
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        if (node->rank_id() == 0) {
+          std::cout << "AllReduce algorithm " << static_cast<int>(algo) << ", size " << size << " bytes, "
+                    << (cost.count() / repeat) << " us" << std::endl;
+        }
+      }
+    }
+    (void)node->Finalize();
+    (void)cgn->Finalize();
+    _exit(0);
+  }
+
+  for (auto pid : pids) {
+    int status = 0;
+    (void)waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  msn.Finalize();
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
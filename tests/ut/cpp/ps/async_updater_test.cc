@@ -0,0 +1,302 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <thread>
+#include "common/common_test.h"
+#include "ps/async_updater.h"
+
+namespace mindspore {
+namespace ps {
+class TestAsyncUpdater : public UT::Common {
+ public:
+  TestAsyncUpdater() = default;
+  virtual ~TestAsyncUpdater() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+  static GradUpdatePtr MakeUpdate(uint32_t worker_rank, float value) {
+    auto update = std::make_shared<GradUpdate>();
+    update->worker_rank = worker_rank;
+    update->values = {value};
+    update->lengths = {1};
+    return update;
+  }
+
+  // Wait until the condition is true, and return false if it times out.
+  static bool WaitFor(const std::function<bool()> &condition) {
+    for (size_t i = 0; i < 10000; ++i) {
+      if (condition()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+};
+
+/// Feature: bounded staleness of parameter server.
+/// Description: advance the clocks of two workers with the staleness threshold 0 and 2.
+/// Expectation: a worker can not push when it is more than the threshold steps ahead of the slowest one, and can not
+/// pull until the updates older than the threshold are applied.
+TEST_F(TestAsyncUpdater, StalenessController) {
+  const Key key = 7;
+  StalenessController sync_controller(2, 0);
+  EXPECT_TRUE(sync_controller.ReadyForPush(key, 0));
+  EXPECT_EQ(0, sync_controller.Push(key, 0));
+  EXPECT_FALSE(sync_controller.ReadyForPush(key, 0));
+  EXPECT_FALSE(sync_controller.ReadyForPull(key, 0));
+  EXPECT_TRUE(sync_controller.ReadyForPush(key, 1));
+  EXPECT_EQ(0, sync_controller.Push(key, 1));
+  sync_controller.Applied(key, 0);
+  EXPECT_FALSE(sync_controller.ReadyForPull(key, 0));
+  sync_controller.Applied(key, 1);
+  EXPECT_TRUE(sync_controller.ReadyForPull(key, 0));
+  EXPECT_TRUE(sync_controller.ReadyForPush(key, 0));
+  EXPECT_ANY_THROW(sync_controller.ReadyForPush(key, 2));
+
+  StalenessController controller(2, 2);
+  for (size_t step = 0; step < 3; ++step) {
+    EXPECT_TRUE(controller.ReadyForPush(key, 0));
+    EXPECT_EQ(step, controller.Push(key, 0));
+    controller.Applied(key, 0);
+  }
+  // Worker 0 is 3 steps ahead of worker 1 now.
+  EXPECT_FALSE(controller.ReadyForPush(key, 0));
+  EXPECT_FALSE(controller.ReadyForPull(key, 0));
+  EXPECT_TRUE(controller.ReadyForPull(key, 1));
+  EXPECT_EQ(0, controller.Push(key, 1));
+  EXPECT_TRUE(controller.ReadyForPush(key, 0));
+  EXPECT_FALSE(controller.ReadyForPull(key, 0));
+  controller.Applied(key, 1);
+  EXPECT_TRUE(controller.ReadyForPull(key, 0));
+  EXPECT_EQ(2, controller.max_staleness());
+  EXPECT_DOUBLE_EQ(0.75, controller.average_staleness());
+}
+
+/// Feature: bounded staleness of parameter server.
+/// Description: push the items into the update queue by multiple threads and pop them by one thread.
+/// Expectation: every item is popped once, and the items of one producer are popped in order.
+TEST_F(TestAsyncUpdater, UpdateQueue) {
+  const size_t producer_num = 4;
+  const size_t item_num = 10000;
+  UpdateQueue<std::pair<size_t, size_t>> queue;
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < producer_num; ++i) {
+    producers.emplace_back([&queue, i]() {
+      for (size_t j = 0; j < item_num; ++j) {
+        queue.Push(std::make_pair(i, j));
+      }
+    });
+  }
+  std::vector<size_t> next(producer_num, 0);
+  size_t popped = 0;
+  std::pair<size_t, size_t> item;
+  while (popped < producer_num * item_num) {
+    if (!queue.Pop(&item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(next[item.first], item.second);
+    next[item.first]++;
+    popped++;
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.Pop(&item));
+}
+
+/// Feature: bounded staleness of parameter server.
+/// Description: push the gradients of several keys by multiple workers concurrently and apply them asynchronously.
+/// Expectation: all the gradients are applied in batches of at most the worker number, and the queues are drained.
+TEST_F(TestAsyncUpdater, ApplyUpdates) {
+  const size_t worker_num = 4;
+  const size_t key_num = 5;
+  const size_t step_num = 200;
+  std::map<Key, float> sums;
+  std::map<Key, size_t> max_batch_sizes;
+  std::mutex sums_mutex;
+  AsyncUpdater updater(worker_num, 1, 3, [&](const Key &key, const std::vector<GradUpdatePtr> &updates) {
+    std::unique_lock<std::mutex> lock(sums_mutex);
+    for (const auto &update : updates) {
+      sums[key] += update->values[0];
+    }
+    max_batch_sizes[key] = std::max(max_batch_sizes[key], updates.size());
+  });
+  updater.Start();
+
+  std::vector<std::thread> workers;
+  for (uint32_t rank = 0; rank < worker_num; ++rank) {
+    workers.emplace_back([&updater, rank]() {
+      for (size_t step = 0; step < step_num; ++step) {
+        for (Key key = 0; key < key_num; ++key) {
+          ASSERT_TRUE(WaitFor([&]() { return updater.ReadyForPull(key, rank); }));
+          ASSERT_TRUE(WaitFor([&]() { return updater.ReadyForPush(key, rank); }));
+          updater.Push(key, MakeUpdate(rank, static_cast<float>(rank + 1)));
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  updater.Stop();
+
+  EXPECT_EQ(0, updater.queue_depth());
+  EXPECT_GT(updater.max_queue_depth(), 0);
+  EXPECT_LE(updater.max_staleness(), 1);
+  for (Key key = 0; key < key_num; ++key) {
+    EXPECT_FLOAT_EQ(static_cast<float>(step_num * worker_num * (worker_num + 1) / 2), sums[key]);
+    EXPECT_LE(max_batch_sizes[key], worker_num);
+  }
+}
+
+/// Feature: sharded update of the large dense weights.
+/// Description: split the addresses of an ApplyMomentum with a workspace and an output of the weight size, and update
+/// the shards in parallel threads which write their workspaces and outputs.
+/// Expectation: the weight-sized addresses are split into disjoint shards, the scalars are shared, and the sharded
+/// update equals the update of the whole weight.
+TEST_F(TestAsyncUpdater, SplitElementWiseOptimizer) {
+  const size_t elem_num = 1003;
+  const size_t shard_num = 4;
+  std::vector<float> weight(elem_num, 1.0f);
+  std::vector<float> accum(elem_num, 0.5f);
+  std::vector<float> grad(elem_num);
+  for (size_t i = 0; i < elem_num; ++i) {
+    grad[i] = static_cast<float>(i) * 0.01f;
+  }
+  float lr = 0.1f;
+  float moment = 0.9f;
+  std::vector<float> workspace(elem_num, 0.0f);
+  std::vector<float> output(elem_num, 0.0f);
+  auto make_address = [](float *addr, size_t num) {
+    return std::make_shared<kernel::Address>(addr, num * sizeof(float));
+  };
+  std::vector<kernel::AddressPtr> inputs = {make_address(weight.data(), elem_num), make_address(accum.data(), elem_num),
+                                            make_address(&lr, 1), make_address(grad.data(), elem_num),
+                                            make_address(&moment, 1)};
+  std::vector<kernel::AddressPtr> workspaces = {make_address(workspace.data(), elem_num)};
+  std::vector<kernel::AddressPtr> outputs = {make_address(output.data(), elem_num)};
+
+  // The element-wise momentum, which writes the accumulation to the workspace and the weight to the output.
+  auto apply_momentum = [](const OptimizerShard &shard) {
+    auto w = static_cast<float *>(shard.inputs[0]->addr);
+    auto a = static_cast<float *>(shard.inputs[1]->addr);
+    auto g = static_cast<float *>(shard.inputs[3]->addr);
+    float learning_rate = *static_cast<float *>(shard.inputs[2]->addr);
+    float momentum = *static_cast<float *>(shard.inputs[4]->addr);
+    auto ws = static_cast<float *>(shard.workspaces[0]->addr);
+    auto out = static_cast<float *>(shard.outputs[0]->addr);
+    size_t num = shard.inputs[0]->size / sizeof(float);
+    for (size_t i = 0; i < num; ++i) {
+      a[i] = a[i] * momentum + g[i];
+      w[i] -= a[i] * learning_rate;
+      ws[i] = a[i];
+      out[i] = w[i];
+    }
+  };
+  std::vector<float> expect_weight = weight;
+  std::vector<float> expect_accum = accum;
+  for (size_t i = 0; i < elem_num; ++i) {
+    expect_accum[i] = expect_accum[i] * moment + grad[i];
+    expect_weight[i] -= expect_accum[i] * lr;
+  }
+
+  EXPECT_ANY_THROW(SplitElementWiseOptimizer({}, workspaces, outputs, shard_num));
+  auto shards = SplitElementWiseOptimizer(inputs, workspaces, outputs, shard_num);
+  ASSERT_EQ(shards.size(), shard_num);
+  size_t begin = 0;
+  for (const auto &shard : shards) {
+    ASSERT_EQ(shard.inputs.size(), inputs.size());
+    ASSERT_EQ(shard.workspaces.size(), workspaces.size());
+    ASSERT_EQ(shard.outputs.size(), outputs.size());
+    EXPECT_EQ(shard.inputs[0]->addr, weight.data() + begin);
+    EXPECT_EQ(shard.workspaces[0]->addr, workspace.data() + begin);
+    EXPECT_EQ(shard.outputs[0]->addr, output.data() + begin);
+    EXPECT_EQ(shard.inputs[2], inputs[2]);
+    EXPECT_EQ(shard.inputs[4], inputs[4]);
+    begin += shard.inputs[0]->size / sizeof(float);
+  }
+  EXPECT_EQ(begin, elem_num);
+
+  std::vector<std::thread> threads;
+  for (const auto &shard : shards) {
+    threads.emplace_back([&apply_momentum, &shard]() { apply_momentum(shard); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < elem_num; ++i) {
+    EXPECT_FLOAT_EQ(weight[i], expect_weight[i]);
+    EXPECT_FLOAT_EQ(output[i], expect_weight[i]);
+    EXPECT_FLOAT_EQ(workspace[i], expect_accum[i]);
+  }
+}
+
+/// Feature: bounded staleness of parameter server.
+/// Description: simulate the workers of which one straggles randomly, and run them with different staleness thresholds.
+/// Expectation: the time cost of every staleness threshold is printed, and the larger threshold tolerates stragglers.
+TEST_F(TestAsyncUpdater, DISABLED_StragglerBenchmark) {
+  const size_t worker_num = 8;
+  const size_t key_num = 4;
+  const size_t step_num = 100;
+  const auto compute_time = std::chrono::microseconds(2000);
+  const int straggle_factor = 5;
+  const double straggle_probability = 0.05;
+  for (size_t staleness : {0, 1, 2, 4, 8}) {
+    AsyncUpdater updater(worker_num, staleness, key_num, [](const Key &, const std::vector<GradUpdatePtr> &) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    });
+    updater.Start();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (uint32_t rank = 0; rank < worker_num; ++rank) {
+      workers.emplace_back([&, rank]() {
+        std::mt19937 gen(rank);
+        std::bernoulli_distribution straggle(straggle_probability);
+        for (size_t step = 0; step < step_num; ++step) {
+          for (Key key = 0; key < key_num; ++key) {
+            while (!updater.ReadyForPull(key, rank)) {
+              std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+          }
+          std::this_thread::sleep_for(straggle(gen) ? compute_time * straggle_factor : compute_time);
+          for (Key key = 0; key < key_num; ++key) {
+            while (!updater.ReadyForPush(key, rank)) {
+              std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            updater.Push(key, MakeUpdate(rank, 1));
+          }
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    updater.Stop();
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "Staleness threshold " << staleness << ": " << cost.count() << " ms for " << step_num
+              << " steps, max staleness " << updater.max_staleness() << ", average staleness "
+              << updater.average_staleness() << ", max queue depth " << updater.max_queue_depth() << std::endl;
+  }
+}
+}  // namespace ps
+}  // namespace mindspore